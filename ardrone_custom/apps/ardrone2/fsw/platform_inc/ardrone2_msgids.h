@@ -55,6 +55,13 @@
 #define ARDRONE2_TO_NAVDATA_MID	            0x0823  
 #define ARDRONE2_NAVDATA_SELECT_MID         0x0824
 
+/* One message per navdata option, ARDRONE2_NAVDATA_OPT_MID(tag) for each
+ * NavData_Tag_t below ARDRONE2_NAVDATA_NUM_TAGS.  Options are only asked
+ * from the drone while something subscribes to their message. */
+#define ARDRONE2_NAVDATA_OPT_BASE_MID       0x0840
+#define ARDRONE2_NAVDATA_OPT_LAST_MID       0x085B
+#define ARDRONE2_NAVDATA_OPT_MID(tag)       (ARDRONE2_NAVDATA_OPT_BASE_MID + (tag))
+
 #endif /* _ardrone2_msgids_h_ */
 
 /************************/
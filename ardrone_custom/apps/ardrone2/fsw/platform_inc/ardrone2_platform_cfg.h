@@ -58,6 +58,34 @@
 #define ARDRONE2_AT_PORT   					    5556
 #define ARDRONE2_WATCHDOG_PERIOD				1000000
 
+/* The AT command task pends on its pipe and wakes up on this period to
+ * stroke the drone's com watchdog and drift towards level */
+#define ARDRONE2_AT_CMD_TICK_MSEC				30
+
+/* Command to socket latency histogram in housekeeping.  Bin 0 counts
+ * latencies below ARDRONE2_AT_LATENCY_BIN0_USEC, each next bin doubles
+ * the bound, and the last bin takes everything above. */
+#define ARDRONE2_AT_LATENCY_BINS				8
+#define ARDRONE2_AT_LATENCY_BIN0_USEC			50
+
+/* Ask the drone for the navdata options that other apps subscribe to.  This
+ * turns on SB subscription reporting, a global SB setting that stays on for
+ * every app.  When FALSE, only ARDRONE2_NAVDATA_SELECT_OPTIONS and those
+ * turned on by ARDRONE2_MOD_NAVDATA_OPT_CC are asked for, and the latter are
+ * sent as ARDRONE2_NAVDATA_OPT_MID messages. */
+#define ARDRONE2_NAVDATA_SUB_REPORTING			FALSE
+
+/* How often to ask again for navdata options that are subscribed to but
+ * that the drone does not send */
+#define ARDRONE2_NAVDATA_OPT_RETRY_MSEC			1000
+
+/* Navdata flight recorder: every datagram received goes into a ring file of
+ * this many bytes, oldest overwritten first.  0 turns the recorder off.
+ * ARDRONE2_NAVDATA_REC_CC starts and stops recording. */
+#define ARDRONE2_NAVDATA_REC_FILE				"/ram/ardrone2_navdata.rec"
+#define ARDRONE2_NAVDATA_REC_SIZE				(4 * 1024 * 1024)
+#define ARDRONE2_NAVDATA_REC_AT_START			TRUE
+
 //#define ARDrone2_NAVDATA_DEBUG
 
 /*
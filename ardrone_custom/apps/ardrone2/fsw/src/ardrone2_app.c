@@ -70,6 +70,8 @@
 
 #include "cfe.h"
 #include "osapi.h"
+#include "cfe_sb_msg.h"
+#include "cfe_msgids.h"
 
 #include "ardrone2_app.h"
 
@@ -259,6 +261,8 @@ int32 ARDrone2_InitApp()
         goto ARDrone2_InitApp_Exit_Tag;
     }
 
+    ARDrone2_InitSubReporting();
+
     /* Init Mutex for ATCmd protection */
     ReturnCode = OS_MutSemCreate(&g_ARDrone2_AppData.AtCmdChildTaskMutexId,
     		"ARD2_ChldCmd_Mut", 0);
@@ -597,6 +601,45 @@ int32 ARDrone2_InitPipe()
         goto ARDrone2_InitPipe_Exit_Tag;
     }
 
+    /* Init subscription report pipe */
+    g_ARDrone2_AppData.usSubPipeDepth = ARDRONE2_SUB_PIPE_DEPTH;
+    memset((void*)g_ARDrone2_AppData.cSubPipeName, '\0', 
+           sizeof(g_ARDrone2_AppData.cSubPipeName));
+    strncpy(g_ARDrone2_AppData.cSubPipeName, "ARDrone2_SUB_PIPE", 
+            OS_MAX_API_NAME-1);
+
+    iStatus = CFE_SB_CreatePipe(&g_ARDrone2_AppData.SubPipeId,
+                                 g_ARDrone2_AppData.usSubPipeDepth,
+                                 g_ARDrone2_AppData.cSubPipeName);
+    if (iStatus == CFE_SUCCESS)
+    {
+        iStatus = CFE_SB_Subscribe(CFE_SB_ONESUB_TLM_MID, 
+                                   g_ARDrone2_AppData.SubPipeId);
+        if(iStatus != CFE_SUCCESS)
+        {
+            CFE_ES_WriteToSysLog("ARDrone2 - SUB Pipe failed to subscribe to "
+                                 "CFE_SB_ONESUB_TLM_MID. (%ld)\n",
+                                 iStatus);
+            goto ARDrone2_InitPipe_Exit_Tag;
+        }
+
+        iStatus = CFE_SB_Subscribe(CFE_SB_ALLSUBS_TLM_MID, 
+                                   g_ARDrone2_AppData.SubPipeId);
+        if(iStatus != CFE_SUCCESS)
+        {
+            CFE_ES_WriteToSysLog("ARDrone2 - SUB Pipe failed to subscribe to "
+                                 "CFE_SB_ALLSUBS_TLM_MID. (%ld)\n",
+                                 iStatus);
+            goto ARDrone2_InitPipe_Exit_Tag;
+        }
+    }
+    else
+    {
+        CFE_ES_WriteToSysLog("ARDrone2 - Failed to create SUB pipe "
+                             "(%ld)\n", iStatus);
+        goto ARDrone2_InitPipe_Exit_Tag;
+    }
+
 ARDrone2_InitPipe_Exit_Tag:
     return (iStatus);
 }
@@ -649,20 +692,23 @@ int32 ARDrone2_InitData()
 			sizeof(g_ARDrone2_AppData.NavDataDemoMsg),
 			TRUE);
 
-    memset((void*)&g_ARDrone2_AppData.NavDataSelectMsg, 0x00, 
-           sizeof(g_ARDrone2_AppData.NavDataSelectMsg));
-	CFE_SB_InitMsg(&g_ARDrone2_AppData.NavDataSelectMsg,
-			ARDRONE2_NAVDATA_SELECT_MID,
-			sizeof(g_ARDrone2_AppData.NavDataSelectMsg),
-			TRUE);
-    
-    /* Init Mutex for NavData protection */
-    iStatus = OS_MutSemCreate(&g_ARDrone2_AppData.NavDataMutexId, 
-                              "ARD2_NavData_Mut", 0);
+    memset((void*)&g_ARDrone2_AppData.NavDataFrame, 0x00, 
+           sizeof(g_ARDrone2_AppData.NavDataFrame));
+
+    ARDrone2_MsgTripleInit(&g_ARDrone2_AppData.NavDataSelect);
+
+    g_ARDrone2_AppData.AtCmdRequests = 0;
 
-    /* Init Mutex for Cmd Sequence protection */
-    iStatus = OS_MutSemCreate(&g_ARDrone2_AppData.CmdSeqMutexId, 
-                              "ARD2_CmdSeq_Mut", 0);
+    memset((void*)g_ARDrone2_AppData.NavDataOptSubs, 0x00, 
+           sizeof(g_ARDrone2_AppData.NavDataOptSubs));
+    g_ARDrone2_AppData.NavDataOptSubscribed = 0;
+    g_ARDrone2_AppData.NavDataOptCmdOn  = 0;
+    g_ARDrone2_AppData.NavDataOptCmdOff = 0;
+
+    g_ARDrone2_AppData.NavDataRec.hdr = NULL;
+    g_ARDrone2_AppData.NavDataRec.fd  = -1;
+    g_ARDrone2_AppData.NavDataRecording = ARDRONE2_NAVDATA_REC_AT_START;
+    g_ARDrone2_AppData.NavDataOptWanted = ARDRONE2_NAVDATA_SELECT_OPTIONS;
 
     return (iStatus);
 }
@@ -868,6 +914,228 @@ void ARDrone2_ProcessNewCmds()
             g_ARDrone2_AppData.uiRunStatus = CFE_ES_APP_ERROR;
         }
     }
+
+    ARDrone2_ProcessSubReports();
+}
+
+/*=====================================================================================
+** Name: ARDrone2_InitSubReporting
+**
+** Purpose: To ask SB for the subscriptions to the navdata option messages
+**
+** Arguments:
+**    None
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    CFE_EVS_SendEvent
+**    CFE_SB_InitMsg
+**    CFE_SB_SetCmdCode
+**    CFE_SB_SendMsg
+**
+** Called By:
+**    ARDrone2_InitApp
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    Only done when ARDRONE2_NAVDATA_SUB_REPORTING is TRUE.  Subscription
+**    reporting is a global SB setting, it stays enabled for other apps too.
+**    Reports land on the SUB pipe and are handled by
+**    ARDrone2_ProcessSubReports.
+**=====================================================================================*/
+void ARDrone2_InitSubReporting()
+{
+    CFE_SB_CmdHdr_t SbCmd;
+
+    if (ARDRONE2_NAVDATA_SUB_REPORTING != TRUE)
+    {
+        return;
+    }
+
+    CFE_EVS_SendEvent(INF_EID, CFE_EVS_INFORMATION,
+                      "ARDrone2 - Enabling SB subscription reporting for all apps");
+
+    /* Report the subscriptions made from now on... */
+    CFE_SB_InitMsg(&SbCmd, CFE_SB_CMD_MID, sizeof(SbCmd), TRUE);
+    CFE_SB_SetCmdCode((CFE_SB_Msg_t*)&SbCmd, CFE_SB_ENABLE_SUB_REPORTING_CC);
+    CFE_SB_SendMsg((CFE_SB_Msg_t*)&SbCmd);
+
+    /* ...and those made so far */
+    CFE_SB_InitMsg(&SbCmd, CFE_SB_CMD_MID, sizeof(SbCmd), TRUE);
+    CFE_SB_SetCmdCode((CFE_SB_Msg_t*)&SbCmd, CFE_SB_SEND_PREV_SUBS_CC);
+    CFE_SB_SendMsg((CFE_SB_Msg_t*)&SbCmd);
+}
+
+/*=====================================================================================
+** Name: ARDrone2_ProcessSubReports
+**
+** Purpose: To count the subscriptions to each navdata option message
+**
+** Arguments:
+**    None
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    CFE_SB_RcvMsg
+**    ARDrone2_UpdateNavDataOptWanted
+**
+** Called By:
+**    ARDrone2_ProcessNewCmds
+**
+** Global Outputs/Writes:
+**    g_ARDrone2_AppData.NavDataOptSubs
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    The full list sent for CFE_SB_SEND_PREV_SUBS_CC replaces the counts once
+**    its last segment is in.  Single reports adjust them in between.
+**=====================================================================================*/
+void ARDrone2_ProcessSubReports()
+{
+    int32 iStatus = CFE_SUCCESS;
+    CFE_SB_Msg_t*   MsgPtr=NULL;
+    CFE_SB_SubRprtMsg_t *pOneSub;
+    CFE_SB_PrevSubMsg_t *pAllSubs;
+    uint16 *pCount;
+    uint32 i;
+    uint32 tag;
+
+    while (1)
+    {
+        iStatus = CFE_SB_RcvMsg(&MsgPtr, g_ARDrone2_AppData.SubPipeId, 
+                                CFE_SB_POLL);
+        if (iStatus != CFE_SUCCESS)
+        {
+            break;
+        }
+
+        switch (CFE_SB_GetMsgId(MsgPtr))
+        {
+            case CFE_SB_ONESUB_TLM_MID:
+                pOneSub = (CFE_SB_SubRprtMsg_t *) MsgPtr;
+                if (pOneSub->Payload.MsgId < ARDRONE2_NAVDATA_OPT_BASE_MID ||
+                    pOneSub->Payload.MsgId > ARDRONE2_NAVDATA_OPT_LAST_MID)
+                {
+                    break;
+                }
+
+                pCount = &g_ARDrone2_AppData.NavDataOptSubs[
+                             pOneSub->Payload.MsgId - ARDRONE2_NAVDATA_OPT_BASE_MID];
+                if (pOneSub->Payload.SubType == CFE_SB_SUBSCRIPTION)
+                {
+                    (*pCount)++;
+                }
+                else if (*pCount > 0)
+                {
+                    (*pCount)--;
+                }
+                break;
+
+            case CFE_SB_ALLSUBS_TLM_MID:
+                pAllSubs = (CFE_SB_PrevSubMsg_t *) MsgPtr;
+                if (pAllSubs->Payload.PktSegment == 1)
+                {
+                    memset((void*)g_ARDrone2_AppData.NavDataOptSubsScan, 0x00, 
+                           sizeof(g_ARDrone2_AppData.NavDataOptSubsScan));
+                }
+
+                for (i = 0; i < pAllSubs->Payload.Entries && i < CFE_SB_SUB_ENTRIES_PER_PKT; i++)
+                {
+                    if (pAllSubs->Payload.Entry[i].MsgId >= ARDRONE2_NAVDATA_OPT_BASE_MID &&
+                        pAllSubs->Payload.Entry[i].MsgId <= ARDRONE2_NAVDATA_OPT_LAST_MID)
+                    {
+                        g_ARDrone2_AppData.NavDataOptSubsScan[
+                            pAllSubs->Payload.Entry[i].MsgId - ARDRONE2_NAVDATA_OPT_BASE_MID]++;
+                    }
+                }
+
+                if (pAllSubs->Payload.PktSegment >= pAllSubs->Payload.TotalSegments)
+                {
+                    memcpy((void*)g_ARDrone2_AppData.NavDataOptSubs, 
+                           (void*)g_ARDrone2_AppData.NavDataOptSubsScan,
+                           sizeof(g_ARDrone2_AppData.NavDataOptSubs));
+                }
+                break;
+
+            default:
+                break;
+        }
+    }
+
+    /* The demo option has its own message */
+    for (tag = 0; tag < ARDRONE2_NAVDATA_NUM_TAGS; tag++)
+    {
+        if (ARDrone2_NavDataOptionSize(tag) == 0)
+        {
+            g_ARDrone2_AppData.NavDataOptSubs[tag] = 0;
+        }
+    }
+
+    ARDrone2_UpdateNavDataOptWanted();
+}
+
+/*=====================================================================================
+** Name: ARDrone2_UpdateNavDataOptWanted
+**
+** Purpose: To ask the drone for the navdata options that are subscribed to or
+**          commanded on
+**
+** Arguments:
+**    None
+**
+** Returns:
+**    None
+**
+** Routines Called:
+**    ARDrone2_RequestATCmd
+**
+** Called By:
+**    ARDrone2_ProcessSubReports
+**    ARDrone2_modNavDataOpt
+**
+** Global Outputs/Writes:
+**    g_ARDrone2_AppData.NavDataOptSubscribed
+**    g_ARDrone2_AppData.NavDataOptWanted
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    The AT command task sends general:navdata_options.  The telemetry task
+**    asks again if the drone does not send what is wanted.  Options commanded
+**    off are not asked for even when subscribed to.
+**=====================================================================================*/
+void ARDrone2_UpdateNavDataOptWanted()
+{
+    uint32 subscribed = 0;
+    uint32 wanted;
+    uint32 tag;
+
+    for (tag = 0; tag < ARDRONE2_NAVDATA_NUM_TAGS; tag++)
+    {
+        if (g_ARDrone2_AppData.NavDataOptSubs[tag] > 0)
+        {
+            subscribed |= (1 << tag);
+        }
+    }
+
+    /* Without subscription reports, send the options commanded on */
+    if (ARDRONE2_NAVDATA_SUB_REPORTING != TRUE)
+    {
+        subscribed = g_ARDrone2_AppData.NavDataOptCmdOn;
+    }
+
+    __atomic_store_n(&g_ARDrone2_AppData.NavDataOptSubscribed, subscribed, __ATOMIC_RELAXED);
+
+    wanted = (subscribed | ARDRONE2_NAVDATA_SELECT_OPTIONS |
+              g_ARDrone2_AppData.NavDataOptCmdOn) & ~g_ARDrone2_AppData.NavDataOptCmdOff;
+    if (wanted != g_ARDrone2_AppData.NavDataOptWanted)
+    {
+        CFE_EVS_SendEvent(INF_EID, CFE_EVS_INFORMATION,
+                          "ARDrone2 - Navdata options now 0x%08X", (unsigned int)wanted);
+
+        __atomic_store_n(&g_ARDrone2_AppData.NavDataOptWanted, wanted, __ATOMIC_RELAXED);
+        ARDrone2_RequestATCmd(ARDRONE2_AT_REQ_NAVDATA_OPTIONS);
+    }
 }
 
 /*=====================================================================================
@@ -916,6 +1184,10 @@ void ARDrone2_ProcessNewAppCmds(CFE_SB_Msg_t *MsgPtr)
             case ARDRONE2_RESET_COUNTERS_CC:
                 g_ARDrone2_AppData.HkTlm.usCmdCnt = 0;
                 g_ARDrone2_AppData.HkTlm.usCmdErrCnt = 0;
+                memset(g_ARDrone2_AppData.HkTlm.uiAtCmdLatencyHist, 0x00,
+                       sizeof(g_ARDrone2_AppData.HkTlm.uiAtCmdLatencyHist));
+                g_ARDrone2_AppData.HkTlm.uiAtCmdLatencyMaxUsec = 0;
+                g_ARDrone2_AppData.HkTlm.uiAtTickOverruns = 0;
                 break;
 
             default:
@@ -1002,18 +1274,21 @@ void ARDrone2_ReportHousekeeping()
 int32  ARDrone2_SendOutData(void)
 {
 	int32 iStatus = CFE_SUCCESS;
+	ARDrone2_NavData_Select_Msg_t *SelectPtr;
+	CFE_SB_ZeroCopyHandle_t        SelectHandle;
+
+    /* Take the latest select message.  It is stale until the telemetry
+     * task publishes the next one. */
+    SelectPtr = (ARDrone2_NavData_Select_Msg_t *)
+        ARDrone2_MsgTripleTake(&g_ARDrone2_AppData.NavDataSelect, &SelectHandle);
 
-    iStatus = OS_MutSemTake(g_ARDrone2_AppData.NavDataMutexId);
     /* Send if not stale */
-    if (g_ARDrone2_AppData.NavDataStale == FALSE)
+    if (SelectPtr != NULL)
     {
     	/* Send out the TO Nav Data Select */
-        CFE_SB_TimeStampMsg((CFE_SB_Msg_t*)&g_ARDrone2_AppData.NavDataSelectMsg);
-
-        CFE_SB_SetMsgId((CFE_SB_Msg_t*)&g_ARDrone2_AppData.NavDataSelectMsg,
-        		ARDRONE2_NAVDATA_SELECT_MID);
+        CFE_SB_TimeStampMsg((CFE_SB_Msg_t*)SelectPtr);
 
-    	iStatus = CFE_SB_SendMsg((CFE_SB_Msg_t *) &g_ARDrone2_AppData.NavDataSelectMsg);
+    	iStatus = CFE_SB_ZeroCopySend((CFE_SB_Msg_t *)SelectPtr, SelectHandle);
 
     	/* The software bus return code was bad */
     	if (iStatus != CFE_SUCCESS) {
@@ -1025,9 +1300,6 @@ int32  ARDrone2_SendOutData(void)
     				"ARDrone2: SendOutData SendMsg - Software Bus return was bad");
     	}
     }
-    /* Set to stale until next data received */
-    g_ARDrone2_AppData.NavDataStale = TRUE;
-    iStatus = OS_MutSemGive(g_ARDrone2_AppData.NavDataMutexId);
 
 	return iStatus;
 }
@@ -58,6 +58,8 @@
 #include "ardrone2_cmds.h"
 #include "ardrone2_msgs.h"
 #include "ardrone2_telem.h"
+#include "ardrone2_snapshot.h"
+#include "ardrone2_recorder.h"
 #include "ardrone2_navdata.h"
 
 /*
@@ -67,6 +69,7 @@
 #define ARDRONE2_CMD_PIPE_DEPTH  	10
 #define ARDRONE2_AT_CMD_PIPE_DEPTH  20
 #define ARDRONE2_TLM_PIPE_DEPTH  	10
+#define ARDRONE2_SUB_PIPE_DEPTH  	32  /* A CFE_SB_SEND_PREV_SUBS_CC reply comes as a burst of segments */
 
 #define ARDRONE2_AT_CMD_PIPE_MAX_PLAT_CMDS       20
 #define ARDRONE2_AT_CMD_PIPE_MAX_ROTWING_CMDS    4
@@ -115,6 +118,11 @@ typedef struct
     uint16           usATCmdPipeDepth;
     char             cATCmdPipeName[OS_MAX_API_NAME];
     
+    /* CFE subscription report pipe */
+    CFE_SB_PipeId_t  SubPipeId;
+    uint16           usSubPipeDepth;
+    char             cSubPipeName[OS_MAX_API_NAME];
+
     /* CFE telemetry pipe */
     CFE_SB_PipeId_t  TlmPipeId;
     uint16           usTlmPipeDepth;
@@ -129,19 +137,45 @@ typedef struct
 	CFE_TIME_SysTime_t		TimeStamp;
 	CFE_TIME_SysTime_t		TimeSinceLastSample;
 
-    uint32                  NavDataMutexId;
-    uint32                  CmdSeqMutexId;
-    
+    /* ARDRONE2_AT_REQ_* bits set by other tasks, sent by the AT command task */
+    volatile uint32         AtCmdRequests;
+
     uint32                  AtCmdChildTaskMutexId;
     uint32                  AtTelemChildTaskMutexId;
 
     uint32                          lastNavDataOptions;
-    boolean                         NavDataStale;
-	
+
+    /* Subscriptions to each ARDRONE2_NAVDATA_OPT_MID, from the SB subscription
+     * reports.  Only used by the main task. */
+    uint16                          NavDataOptSubs[ARDRONE2_NAVDATA_NUM_TAGS];
+    uint16                          NavDataOptSubsScan[ARDRONE2_NAVDATA_NUM_TAGS];
+
+    /* Options with at least one subscriber (those commanded on without
+     * ARDRONE2_NAVDATA_SUB_REPORTING), published by the telemetry task,
+     * and the options asked from the drone: these and ARDRONE2_NAVDATA_SELECT_OPTIONS.
+     * Written by the main task, read by the other two. */
+    volatile uint32                 NavDataOptSubscribed;
+    volatile uint32                 NavDataOptWanted;
+
+    /* Options turned on and off by ARDRONE2_MOD_NAVDATA_OPT_CC, applied on top
+     * of the ones above.  Only used by the main task. */
+    uint32                          NavDataOptCmdOn;
+    uint32                          NavDataOptCmdOff;
+
     ARDrone2_NavData_Demo_Msg_t		NavDataDemoMsg;
-    ARDrone2_NavData_Msg_t          NavDataMsg;
-    NavData_Unpacked_t              NavDataUnpacked;
-    ARDrone2_NavData_Select_Msg_t   NavDataSelectMsg;
+
+    /* Navdata is received in place into NavDataFrame and indexed there.
+     * Only used by the telemetry task. */
+    NavData_Frame_t                 NavDataFrame;
+
+    /* Select messages built by the telemetry task in SB zero copy buffers,
+     * taken by ARDrone2_SendOutData. */
+    ARDrone2_MsgTriple_t            NavDataSelect;
+
+    /* Navdata flight recorder, only used by the telemetry task.  Recording
+     * is switched by ARDRONE2_NAVDATA_REC_CC. */
+    ARDrone2_Rec_t                  NavDataRec;
+    volatile boolean                NavDataRecording;
 
 } AppData_t;
 
@@ -175,6 +209,9 @@ int32 	ARDrone2_RcvMsg(int32 iBlocking);
 
 void  	ARDrone2_ProcessNewCmds(void);
 void  	ARDrone2_ProcessNewAppCmds(CFE_SB_Msg_t*);
+void  	ARDrone2_InitSubReporting(void);
+void  	ARDrone2_ProcessSubReports(void);
+void  	ARDrone2_UpdateNavDataOptWanted(void);
 
 void  	ARDrone2_ReportHousekeeping(void);
 int32  	ARDrone2_SendOutData(void);
@@ -0,0 +1,322 @@
+/*=======================================================================================
+** File Name:  ardrone2_atcmd.c
+**
+** Title:  Function Definitions for the ARDRONE2 AT command encoder
+**
+** Purpose:  Encode AT commands and batch them into datagrams.
+**
+** Functions Defined:
+**    ARDrone2_ATCmdBegin()
+**    ARDrone2_ATCmdArgInt()
+**    ARDrone2_ATCmdArgFloat()
+**    ARDrone2_ATCmdArgStr()
+**    ARDrone2_ATCmdEnd()
+**    ARDrone2_ATCmdRaw()
+**    ARDrone2_ATBatchReset()
+**    ARDrone2_ATBatchFits()
+**    ARDrone2_ATBatchAppend()
+**    ARDrone2_ATSeqReset()
+**    ARDrone2_ATSeqAdd()
+**    ARDrone2_ATStepStr()
+**    ARDrone2_ATStepInt()
+**    ARDrone2_ATSeqNextUsec()
+**    ARDrone2_ATSeqPop()
+**    ARDrone2_ATStepEncode()
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    See ardrone2_atcmd.h
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**
+**=====================================================================================*/
+
+/*
+** Include Files
+*/
+#include <string.h>
+
+#include "ardrone2_atcmd.h"
+
+/*
+** Local Function Prototypes
+*/
+static void ARDrone2_ATCmdPut(ARDrone2_ATCmd_t *cmd, const char *str, uint32 length);
+static void ARDrone2_ATCmdPutInt(ARDrone2_ATCmd_t *cmd, int32 value);
+
+
+static void ARDrone2_ATCmdPut(ARDrone2_ATCmd_t *cmd, const char *str, uint32 length)
+{
+    if (cmd->len + length > sizeof(cmd->data))
+    {
+        cmd->overflow = TRUE;
+        return;
+    }
+
+    memcpy(&cmd->data[cmd->len], str, length);
+    cmd->len += length;
+}
+
+
+/* Decimal, most significant digit first, without the C locale */
+static void ARDrone2_ATCmdPutInt(ARDrone2_ATCmd_t *cmd, int32 value)
+{
+    char   digits[11];
+    uint32 magnitude;
+    uint32 i = sizeof(digits);
+
+    magnitude = (value < 0) ? (uint32) 0 - (uint32) value : (uint32) value;
+
+    do
+    {
+        digits[--i] = (char) ('0' + magnitude % 10);
+        magnitude /= 10;
+    } while (magnitude != 0);
+
+    if (value < 0)
+    {
+        ARDrone2_ATCmdPut(cmd, "-", 1);
+    }
+
+    ARDrone2_ATCmdPut(cmd, &digits[i], sizeof(digits) - i);
+}
+
+
+/*!
+ * @brief  Start a command, "AT*<name>=<seq>"
+ */
+void ARDrone2_ATCmdBegin(ARDrone2_ATCmd_t *cmd, const char *name, int32 seq)
+{
+    cmd->len      = 0;
+    cmd->overflow = FALSE;
+
+    ARDrone2_ATCmdPut(cmd, "AT*", 3);
+    ARDrone2_ATCmdPut(cmd, name, strlen(name));
+    ARDrone2_ATCmdPut(cmd, "=", 1);
+    ARDrone2_ATCmdPutInt(cmd, seq);
+}
+
+
+void ARDrone2_ATCmdArgInt(ARDrone2_ATCmd_t *cmd, int32 value)
+{
+    ARDrone2_ATCmdPut(cmd, ",", 1);
+    ARDrone2_ATCmdPutInt(cmd, value);
+}
+
+
+/*!
+ * @brief  Add a float argument, sent as the integer with the same bits
+ */
+void ARDrone2_ATCmdArgFloat(ARDrone2_ATCmd_t *cmd, float value)
+{
+    int32 bits;
+
+    memcpy(&bits, &value, sizeof(bits));
+    ARDrone2_ATCmdArgInt(cmd, bits);
+}
+
+
+/*!
+ * @brief  Add a quoted string argument
+ */
+void ARDrone2_ATCmdArgStr(ARDrone2_ATCmd_t *cmd, const char *str)
+{
+    ARDrone2_ATCmdPut(cmd, ",\"", 2);
+    ARDrone2_ATCmdPut(cmd, str, strlen(str));
+    ARDrone2_ATCmdPut(cmd, "\"", 1);
+}
+
+
+void ARDrone2_ATCmdEnd(ARDrone2_ATCmd_t *cmd)
+{
+    ARDrone2_ATCmdPut(cmd, "\r", 1);
+}
+
+
+/*!
+ * @brief  Use a command string already encoded by the caller
+ */
+void ARDrone2_ATCmdRaw(ARDrone2_ATCmd_t *cmd, const char *str, uint32 length)
+{
+    cmd->len      = 0;
+    cmd->overflow = FALSE;
+
+    ARDrone2_ATCmdPut(cmd, str, length);
+}
+
+
+void ARDrone2_ATBatchReset(ARDrone2_ATBatch_t *batch)
+{
+    batch->len   = 0;
+    batch->count = 0;
+}
+
+
+/*!
+ * @return TRUE if the command can be appended without flushing first
+ */
+boolean ARDrone2_ATBatchFits(ARDrone2_ATBatch_t *batch, ARDrone2_ATCmd_t *cmd)
+{
+    return (batch->len + cmd->len <= sizeof(batch->data)) ? TRUE : FALSE;
+}
+
+
+/*!
+ * @brief  Append a command to the datagram
+ * @note   The caller flushes first if ARDrone2_ATBatchFits is FALSE.
+ *         Commands that overflowed while being built are dropped.
+ */
+void ARDrone2_ATBatchAppend(ARDrone2_ATBatch_t *batch, ARDrone2_ATCmd_t *cmd)
+{
+    if (cmd->overflow == TRUE || cmd->len == 0 ||
+        ARDrone2_ATBatchFits(batch, cmd) == FALSE)
+    {
+        return;
+    }
+
+    memcpy(&batch->data[batch->len], cmd->data, cmd->len);
+    batch->len += cmd->len;
+    batch->count++;
+}
+
+
+void ARDrone2_ATSeqReset(ARDrone2_ATSeq_t *seq)
+{
+    seq->head     = 0;
+    seq->count    = 0;
+    seq->nextUsec = 0;
+}
+
+
+/*!
+ * @brief  Queue a step at the end of the sequence
+ * @param  name     AT command name without "AT*", or "" to only wait
+ * @param  gapMsec  Wait between this step and the next one
+ * @return The step, to add arguments to, or NULL if the sequence is full
+ */
+ARDrone2_ATStep_t *ARDrone2_ATSeqAdd(ARDrone2_ATSeq_t *seq, const char *name, uint32 gapMsec)
+{
+    ARDrone2_ATStep_t *step;
+
+    if (seq->count >= ARDRONE2_AT_SEQ_DEPTH)
+    {
+        return NULL;
+    }
+
+    step = &seq->step[(seq->head + seq->count) % ARDRONE2_AT_SEQ_DEPTH];
+    seq->count++;
+
+    strncpy(step->name, name, sizeof(step->name) - 1);
+    step->name[sizeof(step->name) - 1] = '\0';
+    step->nstr    = 0;
+    step->nint    = 0;
+    step->gapMsec = gapMsec;
+
+    return step;
+}
+
+
+/*!
+ * @brief  Add a string argument.  Too long or too many arguments are dropped,
+ *         and ARDrone2_ATStepEncode then refuses the step.
+ */
+void ARDrone2_ATStepStr(ARDrone2_ATStep_t *step, const char *str)
+{
+    if (step->nstr < ARDRONE2_AT_STEP_MAX_STR && strlen(str) < ARDRONE2_AT_STEP_STR_LEN)
+    {
+        strcpy(step->str[step->nstr], str);
+        step->nstr++;
+    }
+    else
+    {
+        step->nstr = ARDRONE2_AT_STEP_MAX_STR + 1;
+    }
+}
+
+
+void ARDrone2_ATStepInt(ARDrone2_ATStep_t *step, int32 value)
+{
+    if (step->nint < ARDRONE2_AT_STEP_MAX_INT)
+    {
+        step->arg[step->nint] = value;
+    }
+
+    step->nint++;
+}
+
+
+/*!
+ * @brief  When the next step comes due
+ * @return FALSE if the sequence is empty
+ */
+boolean ARDrone2_ATSeqNextUsec(ARDrone2_ATSeq_t *seq, uint64 *deadline)
+{
+    if (seq->count == 0)
+    {
+        return FALSE;
+    }
+
+    *deadline = seq->nextUsec;
+    return TRUE;
+}
+
+
+/*!
+ * @brief  Take the head step off the sequence if it is due
+ * @return The step, valid until the next call to ARDrone2_ATSeqAdd, or NULL
+ *         if there is nothing due yet
+ */
+ARDrone2_ATStep_t *ARDrone2_ATSeqPop(ARDrone2_ATSeq_t *seq, uint64 now)
+{
+    ARDrone2_ATStep_t *step;
+
+    if (seq->count == 0 || now < seq->nextUsec)
+    {
+        return NULL;
+    }
+
+    step = &seq->step[seq->head];
+    seq->head = (seq->head + 1) % ARDRONE2_AT_SEQ_DEPTH;
+    seq->count--;
+
+    seq->nextUsec = now + (uint64) step->gapMsec * 1000;
+
+    return step;
+}
+
+
+/*!
+ * @brief  Build the AT command of a step
+ * @return FALSE if the step only waits, or had bad arguments
+ */
+boolean ARDrone2_ATStepEncode(ARDrone2_ATStep_t *step, ARDrone2_ATCmd_t *cmd, int32 seqNum)
+{
+    uint32 i;
+
+    if (step->name[0] == '\0' ||
+        step->nstr > ARDRONE2_AT_STEP_MAX_STR || step->nint > ARDRONE2_AT_STEP_MAX_INT)
+    {
+        return FALSE;
+    }
+
+    ARDrone2_ATCmdBegin(cmd, step->name, seqNum);
+
+    for (i = 0; i < step->nstr; i++)
+    {
+        ARDrone2_ATCmdArgStr(cmd, step->str[i]);
+    }
+
+    for (i = 0; i < step->nint; i++)
+    {
+        ARDrone2_ATCmdArgInt(cmd, step->arg[i]);
+    }
+
+    ARDrone2_ATCmdEnd(cmd);
+
+    return (cmd->overflow == TRUE) ? FALSE : TRUE;
+}
+
+/*=======================================================================================
+** End of file ardrone2_atcmd.c
+**=====================================================================================*/
@@ -0,0 +1,115 @@
+/*=======================================================================================
+** File Name:  ardrone2_atcmd.h
+**
+** Title:  Header File for the ARDRONE2 AT command encoder
+**
+**
+** Purpose:  Build AT command strings without sprintf, and batch them so the
+**           commands issued in one cycle of the AT command task leave in a
+**           single UDP datagram.
+**
+**           A command is built in an ARDrone2_ATCmd_t:
+**               ARDrone2_ATCmdBegin(&cmd, "PCMD", seq);
+**               ARDrone2_ATCmdArgInt(&cmd, opt);
+**               ARDrone2_ATCmdArgFloat(&cmd, roll);
+**               ARDrone2_ATCmdEnd(&cmd);
+**           which gives "AT*PCMD=<seq>,<opt>,<roll>\r", then appended to an
+**           ARDrone2_ATBatch_t.
+**
+**           Commands that must be spaced out, like configuration sequences,
+**           are queued as steps in an ARDrone2_ATSeq_t instead.  Each step
+**           holds the command name and arguments, and how long to wait
+**           before the next step; it is encoded when it comes due, so it
+**           gets its sequence number then.
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    Floats are sent as the decimal value of their IEEE-754 bit pattern, as
+**    the AT protocol requires, so no float formatting is needed.
+**    A command that does not fit in ARDRONE2_AT_CMD_MAX_LEN is dropped.
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**
+**=====================================================================================*/
+
+#ifndef _ARDRONE2_ATCMD_H_
+#define _ARDRONE2_ATCMD_H_
+
+#include "common_types.h"
+#include "ardrone2_platform_cfg.h"
+
+/*
+** Local Defines
+*/
+#define ARDRONE2_AT_CMD_MAX_LEN      320   /* Longest command: AT*CONFIG with two 64 char strings, or a 256 char custom command */
+
+#define ARDRONE2_AT_SEQ_DEPTH        16    /* Steps waiting in an ARDrone2_ATSeq_t */
+#define ARDRONE2_AT_STEP_NAME_LEN    12
+#define ARDRONE2_AT_STEP_STR_LEN     64
+#define ARDRONE2_AT_STEP_MAX_STR     3     /* AT*CONFIG_IDS has three */
+#define ARDRONE2_AT_STEP_MAX_INT     4     /* AT*MISC has four */
+
+/*
+** Local Structure Declarations
+*/
+typedef struct
+{
+    uint32      len;
+    boolean     overflow;       /*!< Set if anything did not fit, the command is then dropped */
+    char        data[ARDRONE2_AT_CMD_MAX_LEN];
+} ARDrone2_ATCmd_t;
+
+typedef struct
+{
+    uint32      len;
+    uint32      count;          /*!< Commands in the datagram */
+    char        data[ARDRONE2_MAX_AT_BUFFER_SIZE];
+} ARDrone2_ATBatch_t;
+
+/* String arguments are sent before integer ones */
+typedef struct
+{
+    char        name[ARDRONE2_AT_STEP_NAME_LEN];    /*!< Empty for a step that only waits */
+    uint32      nstr;
+    char        str[ARDRONE2_AT_STEP_MAX_STR][ARDRONE2_AT_STEP_STR_LEN];
+    uint32      nint;
+    int32       arg[ARDRONE2_AT_STEP_MAX_INT];
+    uint32      gapMsec;        /*!< Wait before the next step */
+} ARDrone2_ATStep_t;
+
+typedef struct
+{
+    ARDrone2_ATStep_t   step[ARDRONE2_AT_SEQ_DEPTH];
+    uint32              head;
+    uint32              count;
+    uint64              nextUsec;   /*!< Earliest monotonic time for the head step */
+} ARDrone2_ATSeq_t;
+
+/*
+** Local Function Prototypes
+*/
+void    ARDrone2_ATCmdBegin(ARDrone2_ATCmd_t *cmd, const char *name, int32 seq);
+void    ARDrone2_ATCmdArgInt(ARDrone2_ATCmd_t *cmd, int32 value);
+void    ARDrone2_ATCmdArgFloat(ARDrone2_ATCmd_t *cmd, float value);
+void    ARDrone2_ATCmdArgStr(ARDrone2_ATCmd_t *cmd, const char *str);
+void    ARDrone2_ATCmdEnd(ARDrone2_ATCmd_t *cmd);
+void    ARDrone2_ATCmdRaw(ARDrone2_ATCmd_t *cmd, const char *str, uint32 length);
+
+void    ARDrone2_ATBatchReset(ARDrone2_ATBatch_t *batch);
+boolean ARDrone2_ATBatchFits(ARDrone2_ATBatch_t *batch, ARDrone2_ATCmd_t *cmd);
+void    ARDrone2_ATBatchAppend(ARDrone2_ATBatch_t *batch, ARDrone2_ATCmd_t *cmd);
+
+void               ARDrone2_ATSeqReset(ARDrone2_ATSeq_t *seq);
+ARDrone2_ATStep_t *ARDrone2_ATSeqAdd(ARDrone2_ATSeq_t *seq, const char *name, uint32 gapMsec);
+void               ARDrone2_ATStepStr(ARDrone2_ATStep_t *step, const char *str);
+void               ARDrone2_ATStepInt(ARDrone2_ATStep_t *step, int32 value);
+boolean            ARDrone2_ATSeqNextUsec(ARDrone2_ATSeq_t *seq, uint64 *deadline);
+ARDrone2_ATStep_t *ARDrone2_ATSeqPop(ARDrone2_ATSeq_t *seq, uint64 now);
+boolean            ARDrone2_ATStepEncode(ARDrone2_ATStep_t *step, ARDrone2_ATCmd_t *cmd, int32 seqNum);
+
+#endif /* _ARDRONE2_ATCMD_H_ */
+
+/*=======================================================================================
+** End of file ardrone2_atcmd.h
+**=====================================================================================*/
@@ -48,12 +48,14 @@
 #include "ardrone2_app.h"
 #include "ardrone2_cmds.h"
 #include "ardrone2_telem.h"
+#include "ardrone2_atcmd.h"
+#include "ardrone2_timing.h"
 
 /*
 ** Local Defines
 */
 int  ARDrone2_InitATCmdSockets(void);
-void ARDrone2_RcvATCmds(void);
+void ARDrone2_RcvATCmds(int32 timeout);
 void ARDrone2_RotWingGenericCmds(CFE_SB_Msg_t*);
 void ARDrone2_PlatformSpecificCmds(CFE_SB_Msg_t*);
 void ARDrone2_customATCmd(int, char *);
@@ -75,7 +77,11 @@ void ARDrone2_move_mag(int, float, float, float, float, float, float);
 void ARDrone2_magCal(void);
 void ARDrone2_LEDAnimate(int, int, float);
 void ARDrone2_moveAnimate(int, int);
-void ARDrone2_SendATCommand(char *command_string);
+void ARDrone2_QueueATCmd(ARDrone2_ATCmd_t *cmd);
+void ARDrone2_FlushATCmds(void);
+void ARDrone2_ServiceATRequests(void);
+ARDrone2_ATStep_t *ARDrone2_AddATStep(const char *name, uint32 gapMsec);
+void ARDrone2_RunATSeq(uint64 now);
 void ARDrone2_cmdComWdg(void);
 void ARDrone2_resetCmdSeq(void);
 int ARDrone2_incrAtCmdSeq(void);
@@ -83,6 +89,8 @@ void ARDrone2_ATCmdCleanupCallback(void);
 void ARDrone2_Drift_Towards_Level();
 float ARDrone2_Reduce_Angle(float);
 int ARDrone2_Update_Attitude_Flag(void);
+void ARDrone2_RecordATCmdLatency(uint64 latency);
+void ARDrone2_AddConfigIdsStep(void);
 
 /*
 ** Local Structure Declarations
@@ -161,21 +169,38 @@ const char *g_ARDrone2_configCtrlCmds[] =
 */
 struct sockaddr_in  CmdSocketAddress;
 struct sockaddr_in  CmdARDroneAddress;
-int                 CmdSequence;
+volatile int32      CmdSequence;
 int                 ATCmdSocketID;
 ARDrone2_attitude	CurAttitude;
 
+/* Time the command being processed was taken off the pipe, for the
+ * latency histogram.  Only valid while AtCmdPending is TRUE. */
+uint64              AtCmdRcvUsec;
+boolean             AtCmdPending;
 
-void delay(unsigned int mseconds)
-{
-	clock_t goal = mseconds + clock();
-	while (goal > clock());
-}
+/* Commands issued in the current cycle of the AT command task, sent as
+ * one datagram by ARDrone2_FlushATCmds.  Only used by that task. */
+ARDrone2_ATBatch_t  AtCmdBatch;
+
+/* Configuration steps that must be spaced out, sent on their deadlines by
+ * ARDrone2_RunATSeq instead of blocking the task.  Only used by that task. */
+ARDrone2_ATSeq_t    AtCmdSeq;
+
+/* Session, profile and application IDs sent in AT*CONFIG_IDS ahead of each
+ * AT*CONFIG, once ARDrone2_configIds has set them.  Only used by the AT
+ * command task. */
+char                AtCmdConfigIds[3][ARDRONE2_AT_STEP_STR_LEN];
+boolean             AtCmdConfigIdsSet;
 
 
 /* Main function of task */
 void ARDrone2_ATCmdMain(void)
 {
+    ARDrone2_Period_t Tick;
+    uint64 NowUsec;
+    uint64 WakeUsec;
+    uint64 SeqUsec;
+
     /* Register this child task */
     if (CFE_ES_RegisterChildTask() != CFE_SUCCESS)
     {
@@ -200,12 +225,45 @@ void ARDrone2_ATCmdMain(void)
 
     OS_printf("ARDrone2: ATCmd task entering main loop.\n");
 
-	/* Loop and check for a new AT cmd every 30ms */
+    /* Pend on the pipe until the next tick or configuration step, so
+     * commands are forwarded as soon as they arrive while the watchdog and
+     * drift keep their period */
+    ARDrone2_PeriodInit(&Tick, ARDRONE2_AT_CMD_TICK_MSEC * 1000,
+                        ARDrone2_TimeNowUsec());
     while (g_ARDrone2_AppData.ATCommandTaskShouldRun) 
     {
-        ARDrone2_RcvATCmds();
-        OS_TaskDelay(30);
-    	ARDrone2_Drift_Towards_Level();
+        NowUsec = ARDrone2_TimeNowUsec();
+        ARDrone2_ServiceATRequests();
+
+        switch (ARDrone2_PeriodPoll(&Tick, NowUsec))
+        {
+            case 0:
+                break;
+
+            default:
+                /* A whole period was missed.  The missed ticks are not
+                 * fired back to back. */
+                g_ARDrone2_AppData.HkTlm.uiAtTickOverruns++;
+                /* Fall through */
+
+            case 1:
+                ARDrone2_cmdComWdg();
+                ARDrone2_Drift_Towards_Level();
+                break;
+        }
+
+        ARDrone2_RunATSeq(NowUsec);
+
+        /* Everything issued so far this cycle goes out in one datagram */
+        ARDrone2_FlushATCmds();
+
+        WakeUsec = Tick.nextUsec;
+        if (ARDrone2_ATSeqNextUsec(&AtCmdSeq, &SeqUsec) == TRUE && SeqUsec < WakeUsec)
+        {
+            WakeUsec = SeqUsec;
+        }
+
+        ARDrone2_RcvATCmds(ARDrone2_TimeMsecUntil(WakeUsec, NowUsec));
     }
 
     OS_printf("ARDrone2: ATCmd exiting main loop.\n");
@@ -233,6 +291,9 @@ int ARDrone2_InitATCmdSockets(void)
     
     /* Reset Cmd sequence */
     ARDrone2_resetCmdSeq();
+    ARDrone2_ATBatchReset(&AtCmdBatch);
+    ARDrone2_ATSeqReset(&AtCmdSeq);
+    AtCmdConfigIdsSet = FALSE;
 
 	/* Create sockets */
     if ( (ATCmdSocketID = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP)) < 0)
@@ -274,6 +335,7 @@ end_of_function:
 ** Purpose: To Receive and process AT commands 
 **
 ** Arguments:
+**      [in] timeout  Milliseconds to pend on the AT Cmd pipe
 **
 ** Returns:
 **    None
@@ -301,17 +363,20 @@ end_of_function:
 ** History:  Date Written  2013-10-15
 **           Unit Tested   yyyy-mm-dd
 **=====================================================================================*/
-void ARDrone2_RcvATCmds(void)
+void ARDrone2_RcvATCmds(int32 timeout)
 {
     int32 iStatus = CFE_SUCCESS;
     CFE_SB_Msg_t*   CmdMsgPtr=NULL;
     CFE_SB_MsgId_t  CmdMsgId;
 
     iStatus = CFE_SB_RcvMsg(&CmdMsgPtr, g_ARDrone2_AppData.ATCmdPipeId,
-                            CFE_SB_POLL);
+                            timeout);
     
     if (iStatus == CFE_SUCCESS)
     {
+        AtCmdRcvUsec = ARDrone2_TimeNowUsec();
+        AtCmdPending = TRUE;
+
         CmdMsgId = CFE_SB_GetMsgId(CmdMsgPtr);
         switch (CmdMsgId)
         {
@@ -332,11 +397,15 @@ void ARDrone2_RcvATCmds(void)
                                   "ARDrone2 - Recvd invalid CMD msgId (0x%08X)", CmdMsgId);
                 break;
         }
+
+        ARDrone2_FlushATCmds();
+
+        /* Commands that only update CurAttitude go out on the next tick */
+        AtCmdPending = FALSE;
     }
-    else if (iStatus == CFE_SB_NO_MESSAGE)
+    else if (iStatus == CFE_SB_TIME_OUT || iStatus == CFE_SB_NO_MESSAGE)
     {
-        /* stroke the watchdog */
-        ARDrone2_cmdComWdg();
+        /* Time for the next tick, the watchdog is stroked there */
     }
     else
     {
@@ -648,6 +717,19 @@ void ARDrone2_PlatformSpecificCmds(CFE_SB_Msg_t* MsgPtr)
                 ARDrone2_magCal();
                 break;
             }
+
+            case ARDRONE2_NAVDATA_REC_CC:
+            {
+                g_ARDrone2_AppData.HkTlm.usCmdCnt++;
+                ARDrone2_navdata_rec_cmd_t * pCmdMsg =
+                    (ARDrone2_navdata_rec_cmd_t *) MsgPtr;
+                CFE_EVS_SendEvent(CMD_INF_EID,CFE_EVS_INFORMATION,
+                            "Navdata Recorder Command (%d)", pCmdMsg->enableFlag);
+                __atomic_store_n(&g_ARDrone2_AppData.NavDataRecording,
+                                 (pCmdMsg->enableFlag != 0) ? TRUE : FALSE,
+                                 __ATOMIC_RELAXED);
+                break;
+            }
             
             default:
                 g_ARDrone2_AppData.HkTlm.usCmdErrCnt++;
@@ -663,19 +745,25 @@ void ARDrone2_PlatformSpecificCmds(CFE_SB_Msg_t* MsgPtr)
  * @brief  Send a config AT command
  * @param  cmd_in  pointer to command message
  * @param  param   pointer to command parameter
+ * @note   The drone takes one config at a time, so configs are queued on the
+ *         AT command sequence and sent ARDRONE2_AT_CONFIG_GAP_MSEC apart.
+ *         Once the config IDs are set, each one goes right after its
+ *         AT*CONFIG_IDS, in the same datagram.
  * @return Void.
  * */
 void ARDrone2_configATCmd(char *cmd_in, char *param)
 {
-    int seq = 0;
-    char cmd[100];
-
-    memset(cmd, 0x0, sizeof(cmd));
-    seq = ARDrone2_incrAtCmdSeq();
-    sprintf(cmd, "AT*CONFIG=%d,\"%s\",\"%s\"\r", seq, cmd_in, param);
-    ARDrone2_SendATCommand(cmd);
-    OS_printf("Sending AT*CONFIG command:%s, %s\n", cmd_in,param);
-    OS_TaskDelay(30);
+    ARDrone2_ATStep_t *step;
+
+    ARDrone2_AddConfigIdsStep();
+
+    step = ARDrone2_AddATStep("CONFIG", ARDRONE2_AT_CONFIG_GAP_MSEC);
+    if (step != NULL)
+    {
+        ARDrone2_ATStepStr(step, cmd_in);
+        ARDrone2_ATStepStr(step, param);
+        OS_printf("Queued AT*CONFIG command:%s, %s\n", cmd_in,param);
+    }
 }
 
 
@@ -687,10 +775,10 @@ void ARDrone2_configATCmd(char *cmd_in, char *param)
  */
 void ARDrone2_customATCmd(int length, char *cmd_in)
 {
-    char cmd[256];
-    memset(cmd, 0x0, sizeof(cmd));
-    memcpy(cmd, cmd_in, length);
-    ARDrone2_SendATCommand(cmd);
+    ARDrone2_ATCmd_t cmd;
+
+    ARDrone2_ATCmdRaw(&cmd, cmd_in, length);
+    ARDrone2_QueueATCmd(&cmd);
 }
 
 
@@ -701,26 +789,32 @@ void ARDrone2_customATCmd(int length, char *cmd_in)
  */
 void ARDrone2_cmdSetControl(ARDrone2_ControlMode_t controlMode)
 {
-    int seq = 0;
-    char cmd[100];
-    memset(cmd, 0x0, sizeof(cmd));
-    seq = ARDrone2_incrAtCmdSeq();
+    ARDrone2_ATCmd_t cmd;
+
     OS_printf("Setting control.\n");
-    sprintf(cmd, "AT*CTRL=%d,%d,0\r", seq, controlMode);
-    ARDrone2_SendATCommand(cmd);
+    ARDrone2_ATCmdBegin(&cmd, "CTRL", ARDrone2_incrAtCmdSeq());
+    ARDrone2_ATCmdArgInt(&cmd, controlMode);
+    ARDrone2_ATCmdArgInt(&cmd, 0);
+    ARDrone2_ATCmdEnd(&cmd);
+    ARDrone2_QueueATCmd(&cmd);
 }
 
 
 /*!
  * @brief Set configuration IDs
+ * @note   The drone only applies these, and the configs after them, when
+ *         they come with AT*CONFIG_IDS giving the same IDs.
  * @return Void.
  */
 void ARDrone2_configIds(void)
 {
+    strcpy(AtCmdConfigIds[0], "1");
+    strcpy(AtCmdConfigIds[1], "1");
+    strcpy(AtCmdConfigIds[2], "1");
+    AtCmdConfigIdsSet = TRUE;
+
     ARDrone2_configATCmd("custom:session_id", "1");
-    OS_TaskDelay(30);
     ARDrone2_configATCmd("custom:profile_id", "1");
-    OS_TaskDelay(30);
     ARDrone2_configATCmd("custom:application_id", "1");
 }
 
@@ -733,24 +827,46 @@ void ARDrone2_configIds(void)
  */
 void ARDrone2_modNavDataOpt(NavData_Tag_t optionTag, int flag)
 {
-    char cmd_param[11];
-    
-    OS_MutSemTake(g_ARDrone2_AppData.NavDataMutexId);
+    uint32 option;
+
+    if (optionTag >= ARDRONE2_NAVDATA_NUM_TAGS)
+    {
+        CFE_EVS_SendEvent(CMD_ERR_EID, CFE_EVS_ERROR,
+                          "MOD NAVDATA OPT - Invalid option tag %d", (int) optionTag);
+        return;
+    }
+
+    option = 1 << (int) optionTag;
+
+    /* Kept apart from the options last received, which the telemetry task
+     * overwrites, so the command holds when the options are asked again */
     if (flag == TRUE)
     {
-        /* Perform bitwize OR to turn on bit */
-        g_ARDrone2_AppData.lastNavDataOptions |= 1 << (int) optionTag;
+        g_ARDrone2_AppData.NavDataOptCmdOn  |= option;
+        g_ARDrone2_AppData.NavDataOptCmdOff &= ~option;
     }
     else
     {
-        /* Perform bitwise XAND to turn off bit */
-        g_ARDrone2_AppData.lastNavDataOptions &= ~(1 << (int) optionTag);
+        g_ARDrone2_AppData.NavDataOptCmdOff |= option;
+        g_ARDrone2_AppData.NavDataOptCmdOn  &= ~option;
     }
-    
-    sprintf(cmd_param, "%lu", g_ARDrone2_AppData.lastNavDataOptions);
+
+    ARDrone2_UpdateNavDataOptWanted();
+}
+
+
+/*!
+ * @brief Set the navData options the drone sends
+ * @param options - mask of NavData_Tag_t bits
+ * @return Void.
+ */
+void ARDrone2_setNavDataOpts(uint32 options)
+{
+    char cmd_param[11];
+
+    sprintf(cmd_param, "%lu", (unsigned long) options);
 
     ARDrone2_configATCmd("general:navdata_options", cmd_param);
-    OS_MutSemGive(g_ARDrone2_AppData.NavDataMutexId);
 }
 
 /*!
@@ -760,8 +876,7 @@ void ARDrone2_modNavDataOpt(NavData_Tag_t optionTag, int flag)
  */
 void ARDrone2_setFlatTrim(void)
 {
-    char cmd[100];
-    int seq;
+    ARDrone2_ATStep_t *step;
 
     // Reset desired movements to zero
     CurAttitude.isTilted 	= 1;
@@ -771,24 +886,23 @@ void ARDrone2_setFlatTrim(void)
     CurAttitude.ySpeed		= 0;
 
     /* Unknown setting, but needed apparently */
-    memset(cmd, 0x0, sizeof(cmd));
-    seq = ARDrone2_incrAtCmdSeq();
-    sprintf(cmd, "AT*PMODE=%d,%d\r", seq, 2);
-    ARDrone2_SendATCommand(cmd);
-
-    OS_TaskDelay(30);
+    step = ARDrone2_AddATStep("PMODE", ARDRONE2_AT_CONFIG_GAP_MSEC);
+    if (step != NULL)
+    {
+        ARDrone2_ATStepInt(step, 2);
+    }
 
     /* Set limits ? */
-    memset(cmd, 0x0, sizeof(cmd));
-    seq = ARDrone2_incrAtCmdSeq();
-    sprintf(cmd, "AT*MISC=%d,%d,%d,%d,%d\r", seq, 2, 20, 2000, 3000);
-    ARDrone2_SendATCommand(cmd);
-
-    OS_TaskDelay(30);
-    memset(cmd, 0x0, sizeof(cmd));
-    seq = ARDrone2_incrAtCmdSeq();
-    sprintf(cmd, "AT*FTRIM=%d\r", seq);
-    ARDrone2_SendATCommand(cmd);
+    step = ARDrone2_AddATStep("MISC", ARDRONE2_AT_CONFIG_GAP_MSEC);
+    if (step != NULL)
+    {
+        ARDrone2_ATStepInt(step, 2);
+        ARDrone2_ATStepInt(step, 20);
+        ARDrone2_ATStepInt(step, 2000);
+        ARDrone2_ATStepInt(step, 3000);
+    }
+
+    ARDrone2_AddATStep("FTRIM", 0);
 }
 
 /*!
@@ -797,9 +911,7 @@ void ARDrone2_setFlatTrim(void)
  */
 void ARDrone2_takeOff(void)
 {
-    int seq = 0;
-    char cmd[100];
-    memset(cmd, 0x0, sizeof(cmd));
+    ARDrone2_ATCmd_t cmd;
 
     /* Bits 18, 20, 22, 24 and 28 set to 1 */
     int arg2 = 0x11540000;
@@ -807,9 +919,10 @@ void ARDrone2_takeOff(void)
     /* For take-off, set bit 9 to 1 */
     arg2 |= 0x200;
 
-    seq = ARDrone2_incrAtCmdSeq();
-    sprintf(cmd, "AT*REF=%d,%d\r", seq, arg2);
-    ARDrone2_SendATCommand(cmd);
+    ARDrone2_ATCmdBegin(&cmd, "REF", ARDrone2_incrAtCmdSeq());
+    ARDrone2_ATCmdArgInt(&cmd, arg2);
+    ARDrone2_ATCmdEnd(&cmd);
+    ARDrone2_QueueATCmd(&cmd);
 }
 
 
@@ -819,16 +932,15 @@ void ARDrone2_takeOff(void)
  */
 void ARDrone2_land(void)
 {
-    char cmd[100];
-    memset(cmd, 0x0, sizeof(cmd));
-    int seq;
+    ARDrone2_ATCmd_t cmd;
 
     /* Bits 18, 20, 22, 24 and 28 set to 1.  Bit 9 is 0 */
     int arg2 = 0x11540000;
 
-    seq = ARDrone2_incrAtCmdSeq();
-    sprintf(cmd, "AT*REF=%d,%d\r", seq, arg2);
-    ARDrone2_SendATCommand(cmd);
+    ARDrone2_ATCmdBegin(&cmd, "REF", ARDrone2_incrAtCmdSeq());
+    ARDrone2_ATCmdArgInt(&cmd, arg2);
+    ARDrone2_ATCmdEnd(&cmd);
+    ARDrone2_QueueATCmd(&cmd);
 }
 
 /*!
@@ -838,10 +950,7 @@ void ARDrone2_land(void)
  */
 void ARDrone2_eStop(void)
 {
-    int seq = ARDrone2_incrAtCmdSeq();
-    
-    char cmd[100];
-    memset(cmd, 0x0, sizeof(cmd));
+    ARDrone2_ATCmd_t cmd;
 
     /* Bits 18, 20, 22, 24 and 28 set to 1 */
     int arg2 = 0x11540000;
@@ -849,8 +958,10 @@ void ARDrone2_eStop(void)
     /* For emergency stop / reset, set bit 8 to 1 */
     arg2 |= 0x100;  
 
-    sprintf(cmd, "AT*REF=%d,%d\r", seq, arg2);
-    ARDrone2_SendATCommand(cmd);
+    ARDrone2_ATCmdBegin(&cmd, "REF", ARDrone2_incrAtCmdSeq());
+    ARDrone2_ATCmdArgInt(&cmd, arg2);
+    ARDrone2_ATCmdEnd(&cmd);
+    ARDrone2_QueueATCmd(&cmd);
 }
 
 /*!
@@ -1034,20 +1145,21 @@ void ARDrone2_climb(float vSpeed)
  */
 void ARDrone2_move(int opt, float roll, float pitch, float vSpeed, float ySpeed)
 {
-    char cmd[100];
-    int seq = 0;
-    memset(cmd, 0x0, sizeof(cmd));
-
-    seq = ARDrone2_incrAtCmdSeq();
+    ARDrone2_ATCmd_t cmd;
 
     OS_printf("Sending moving command: Opt=%d, roll=%f, Pitch=%f, "
               "vSpeedr=%f, ySpeed=%f\n", opt, roll, pitch, vSpeed, ySpeed);
 
-    sprintf(cmd, "AT*PCMD=%d,%d,%d,%d,%d,%d\r", seq, opt, 
-            *(int*) &roll, *(int*) &pitch, *(int*) &vSpeed, *(int*) &ySpeed);
+    ARDrone2_ATCmdBegin(&cmd, "PCMD", ARDrone2_incrAtCmdSeq());
+    ARDrone2_ATCmdArgInt(&cmd, opt);
+    ARDrone2_ATCmdArgFloat(&cmd, roll);
+    ARDrone2_ATCmdArgFloat(&cmd, pitch);
+    ARDrone2_ATCmdArgFloat(&cmd, vSpeed);
+    ARDrone2_ATCmdArgFloat(&cmd, ySpeed);
+    ARDrone2_ATCmdEnd(&cmd);
 
-    OS_printf("PCMD command: %s\n", cmd);
-    ARDrone2_SendATCommand(cmd);
+    OS_printf("PCMD command: %.*s\n", (int) cmd.len, cmd.data);
+    ARDrone2_QueueATCmd(&cmd);
 }
 
 
@@ -1073,18 +1185,18 @@ void ARDrone2_Drift_Towards_Level()
 
 		int opt = 1;
 
-		char cmd[100];
-		int seq = 0;
-		memset(cmd, 0x0, sizeof(cmd));
+		ARDrone2_ATCmd_t cmd;
 
-		seq = ARDrone2_incrAtCmdSeq();
+		ARDrone2_ATCmdBegin(&cmd, "PCMD", ARDrone2_incrAtCmdSeq());
+		ARDrone2_ATCmdArgInt(&cmd, opt);
+		ARDrone2_ATCmdArgFloat(&cmd, CurAttitude.roll);
+		ARDrone2_ATCmdArgFloat(&cmd, CurAttitude.pitch);
+		ARDrone2_ATCmdArgFloat(&cmd, CurAttitude.vSpeed);
+		ARDrone2_ATCmdArgFloat(&cmd, CurAttitude.ySpeed);
+		ARDrone2_ATCmdEnd(&cmd);
 
-		sprintf(cmd, "AT*PCMD=%d,%d,%d,%d,%d,%d\r", seq, opt,
-				*(int*) &CurAttitude.roll, *(int*) &CurAttitude.pitch,
-				*(int*) &CurAttitude.vSpeed, *(int*) &CurAttitude.ySpeed);
-
-		OS_printf("PCMD command: %s\n", cmd);
-		ARDrone2_SendATCommand(cmd);
+		OS_printf("PCMD command: %.*s\n", (int) cmd.len, cmd.data);
+		ARDrone2_QueueATCmd(&cmd);
 
 		// Reduce the attitude angles for the next iteration
 		CurAttitude.roll 		= ARDrone2_Reduce_Angle(CurAttitude.roll);
@@ -1183,18 +1295,20 @@ void ARDrone2_yawAbs(float yawAngle, float yawAcu)
 void ARDrone2_move_mag(int opt, float roll, float pitch, float vSpeed, 
                        float ySpeed, float yaw, float yawAcu)
 {
-    char cmd[100];
-    int seq = 0;
-    memset(cmd, 0x0, sizeof(cmd));
-
-    seq = ARDrone2_incrAtCmdSeq();
-
-    sprintf(cmd, "AT*PCMD_MAG=%d,%d,%d,%d,%d,%d,%d,%d\r", seq, opt, 
-            *(int*) &roll, *(int*) &pitch, *(int*) &vSpeed, *(int*) &ySpeed,
-            *(int*) &yaw, *(int*) &yawAcu);
-
-    OS_printf("Sending moving command: %s\n", cmd);
-    ARDrone2_SendATCommand(cmd);
+    ARDrone2_ATCmd_t cmd;
+
+    ARDrone2_ATCmdBegin(&cmd, "PCMD_MAG", ARDrone2_incrAtCmdSeq());
+    ARDrone2_ATCmdArgInt(&cmd, opt);
+    ARDrone2_ATCmdArgFloat(&cmd, roll);
+    ARDrone2_ATCmdArgFloat(&cmd, pitch);
+    ARDrone2_ATCmdArgFloat(&cmd, vSpeed);
+    ARDrone2_ATCmdArgFloat(&cmd, ySpeed);
+    ARDrone2_ATCmdArgFloat(&cmd, yaw);
+    ARDrone2_ATCmdArgFloat(&cmd, yawAcu);
+    ARDrone2_ATCmdEnd(&cmd);
+
+    OS_printf("Sending moving command: %.*s\n", (int) cmd.len, cmd.data);
+    ARDrone2_QueueATCmd(&cmd);
 }
 
 /*!
@@ -1204,8 +1318,7 @@ void ARDrone2_move_mag(int opt, float roll, float pitch, float vSpeed,
  */
 void ARDrone2_magCal(void) 
 {
-    char cmd[100];
-    int seq;
+    ARDrone2_ATStep_t *step;
     int magDeviceID = 0; /* magnetometer is 0 */
 
     /*
@@ -1214,12 +1327,14 @@ void ARDrone2_magCal(void)
      */
     ARDrone2_hover();
 
-    OS_TaskDelay(30);
+    /* Let the hover settle before starting the calibration */
+    ARDrone2_AddATStep("", ARDRONE2_AT_CONFIG_GAP_MSEC);
 
-    memset(cmd, 0x0, sizeof(cmd));
-    seq = ARDrone2_incrAtCmdSeq();
-    sprintf(cmd, "AT*CALIB=%d,%d\r", seq, magDeviceID);
-    ARDrone2_SendATCommand(cmd);
+    step = ARDrone2_AddATStep("CALIB", 0);
+    if (step != NULL)
+    {
+        ARDrone2_ATStepInt(step, magDeviceID);
+    }
 }
 
 
@@ -1232,13 +1347,14 @@ void ARDrone2_magCal(void)
  */
 void ARDrone2_LEDAnimate(int animation, int duration, float freq)
 {
-    int seq = ARDrone2_incrAtCmdSeq();
-
-    char cmd[100];
-    memset(cmd, 0x0, sizeof(cmd));
-
-    sprintf(cmd, "AT*LED=%d,%d,%d,%d\r", seq, animation, *(int*) &freq, duration);
-    ARDrone2_SendATCommand(cmd);
+    ARDrone2_ATCmd_t cmd;
+
+    ARDrone2_ATCmdBegin(&cmd, "LED", ARDrone2_incrAtCmdSeq());
+    ARDrone2_ATCmdArgInt(&cmd, animation);
+    ARDrone2_ATCmdArgFloat(&cmd, freq);
+    ARDrone2_ATCmdArgInt(&cmd, duration);
+    ARDrone2_ATCmdEnd(&cmd);
+    ARDrone2_QueueATCmd(&cmd);
 }
 
 /*!
@@ -1249,29 +1365,204 @@ void ARDrone2_LEDAnimate(int animation, int duration, float freq)
  */
 void ARDrone2_moveAnimate(int animation, int duration)
 {
-    int seq = ARDrone2_incrAtCmdSeq();
-    
-    char cmd[100];
-    memset(cmd, 0x0, sizeof(cmd));
+    ARDrone2_ATCmd_t cmd;
 
-    sprintf(cmd, "AT*ANIM=%d,%d,%d\r", seq, animation, duration); 
-    ARDrone2_SendATCommand(cmd);
+    ARDrone2_ATCmdBegin(&cmd, "ANIM", ARDrone2_incrAtCmdSeq());
+    ARDrone2_ATCmdArgInt(&cmd, animation);
+    ARDrone2_ATCmdArgInt(&cmd, duration);
+    ARDrone2_ATCmdEnd(&cmd);
+    ARDrone2_QueueATCmd(&cmd);
 }
 
 
 // PRIVATE FUNCTIONS:
 
 /*!
- * @brief  Send AT command directly to ARDrone
- * @param  command_string  pointer to actual command sent to ARDrone
+ * @brief  Add an AT command to the datagram of the current cycle
+ * @param  cmd  command built with the ARDrone2_ATCmd functions
+ * @note   Private function.  Sends the datagram first if the command does
+ *         not fit in it.
+ * @return Void.
+ */
+void ARDrone2_QueueATCmd(ARDrone2_ATCmd_t *cmd)
+{
+	if (ARDrone2_ATBatchFits(&AtCmdBatch, cmd) == FALSE)
+	{
+		ARDrone2_FlushATCmds();
+	}
+
+	ARDrone2_ATBatchAppend(&AtCmdBatch, cmd);
+}
+
+/*!
+ * @brief  Send the AT commands queued so far in one datagram
  * @note   Private function
  * @return Void.
  */
-void ARDrone2_SendATCommand(char *command_string)
+void ARDrone2_FlushATCmds(void)
 {
+	if (AtCmdBatch.len == 0)
+	{
+		return;
+	}
+
 	sendto(ATCmdSocketID,
-           command_string, strlen(command_string), 0,
+           AtCmdBatch.data, AtCmdBatch.len, 0,
 		   (struct sockaddr *) &CmdARDroneAddress, sizeof(CmdARDroneAddress) );
+
+	ARDrone2_ATBatchReset(&AtCmdBatch);
+
+	/* First datagram sent for the command just received */
+	if (AtCmdPending == TRUE)
+	{
+		AtCmdPending = FALSE;
+		ARDrone2_RecordATCmdLatency(ARDrone2_TimeNowUsec() - AtCmdRcvUsec);
+	}
+}
+
+/*!
+ * @brief  Ask the AT command task to send a command on behalf of another task
+ * @param  request  ARDRONE2_AT_REQ_* bits
+ * @note   The AT command socket and datagram are only used by the AT command
+ *         task.  Requests are picked up the next time it wakes up.
+ * @return Void.
+ */
+void ARDrone2_RequestATCmd(uint32 request)
+{
+	__atomic_or_fetch(&g_ARDrone2_AppData.AtCmdRequests, request, __ATOMIC_RELAXED);
+}
+
+/*!
+ * @brief  Send the commands requested by other tasks
+ * @note   Private function
+ * @return Void.
+ */
+void ARDrone2_ServiceATRequests(void)
+{
+	uint32 request;
+	uint64 deadline;
+
+	/* Leave requests pending while a configuration sequence runs, so a
+	 * request repeated on every navdata packet is not queued many times */
+	if (ARDrone2_ATSeqNextUsec(&AtCmdSeq, &deadline) == TRUE)
+	{
+		return;
+	}
+
+	request = __atomic_exchange_n(&g_ARDrone2_AppData.AtCmdRequests, 0, __ATOMIC_RELAXED);
+
+	if (request & ARDRONE2_AT_REQ_NAVDATA_DEMO)
+	{
+		ARDrone2_configATCmd("general:navdata_demo", "TRUE");
+	}
+
+	if (request & ARDRONE2_AT_REQ_ACK_CONTROL)
+	{
+		ARDrone2_cmdSetControl(ACK_CONTROL_MODE);
+	}
+
+	if (request & ARDRONE2_AT_REQ_NAVDATA_OPTIONS)
+	{
+		ARDrone2_setNavDataOpts(__atomic_load_n(&g_ARDrone2_AppData.NavDataOptWanted,
+		                                        __ATOMIC_RELAXED));
+	}
+}
+
+/*!
+ * @brief  Queue a step on the AT command sequence
+ * @param  name     AT command name without "AT*", or "" to only wait
+ * @param  gapMsec  Wait between this step and the next one
+ * @note   Private function
+ * @return The step, to add arguments to, or NULL if the sequence is full
+ */
+ARDrone2_ATStep_t *ARDrone2_AddATStep(const char *name, uint32 gapMsec)
+{
+	ARDrone2_ATStep_t *step;
+
+	step = ARDrone2_ATSeqAdd(&AtCmdSeq, name, gapMsec);
+	if (step == NULL)
+	{
+		CFE_EVS_SendEvent(CMD_ERR_EID, CFE_EVS_ERROR,
+		                  "ARDrone2: AT command sequence full, AT*%s dropped", name);
+	}
+
+	return step;
+}
+
+/*!
+ * @brief  Queue AT*CONFIG_IDS with the config IDs, if they are set
+ * @note   Private function.  No gap follows, so the AT*CONFIG queued next
+ *         is sent with it.
+ * @return Void.
+ */
+void ARDrone2_AddConfigIdsStep(void)
+{
+	ARDrone2_ATStep_t *step;
+
+	if (AtCmdConfigIdsSet == FALSE)
+	{
+		return;
+	}
+
+	step = ARDrone2_AddATStep("CONFIG_IDS", 0);
+	if (step != NULL)
+	{
+		ARDrone2_ATStepStr(step, AtCmdConfigIds[0]);
+		ARDrone2_ATStepStr(step, AtCmdConfigIds[1]);
+		ARDrone2_ATStepStr(step, AtCmdConfigIds[2]);
+	}
+}
+
+/*!
+ * @brief  Send the steps of the AT command sequence that are due
+ * @param  now  monotonic time, in microseconds
+ * @note   Private function
+ * @return Void.
+ */
+void ARDrone2_RunATSeq(uint64 now)
+{
+	ARDrone2_ATStep_t *step;
+	ARDrone2_ATCmd_t   cmd;
+
+	while ((step = ARDrone2_ATSeqPop(&AtCmdSeq, now)) != NULL)
+	{
+		if (step->name[0] == '\0')
+		{
+			/* Only waits */
+		}
+		else if (ARDrone2_ATStepEncode(step, &cmd, ARDrone2_incrAtCmdSeq()) == TRUE)
+		{
+			ARDrone2_QueueATCmd(&cmd);
+		}
+		else
+		{
+			CFE_EVS_SendEvent(CMD_ERR_EID, CFE_EVS_ERROR,
+			                  "ARDrone2: Bad arguments for AT*%s, dropped", step->name);
+		}
+	}
+}
+
+/*!
+ * @brief  Add a command to socket latency to the housekeeping histogram
+ * @param  latency  microseconds from taking the command off the pipe to sendto
+ * @return Void.
+ */
+void ARDrone2_RecordATCmdLatency(uint64 latency)
+{
+	uint32 bin = 0;
+
+	while (bin < ARDRONE2_AT_LATENCY_BINS - 1 &&
+	       latency >= ((uint64) ARDRONE2_AT_LATENCY_BIN0_USEC << bin))
+	{
+		bin++;
+	}
+
+	g_ARDrone2_AppData.HkTlm.uiAtCmdLatencyHist[bin]++;
+
+	if (latency > g_ARDrone2_AppData.HkTlm.uiAtCmdLatencyMaxUsec)
+	{
+		g_ARDrone2_AppData.HkTlm.uiAtCmdLatencyMaxUsec = (uint32) latency;
+	}
 }
 
 /*!
@@ -1280,13 +1571,11 @@ void ARDrone2_SendATCommand(char *command_string)
  */
 void ARDrone2_cmdComWdg(void)
 {
-    int seq = 0;
-    char cmd[100];
-    memset(cmd, 0x0, sizeof(cmd));
-    seq = ARDrone2_incrAtCmdSeq();
-	
-    sprintf(cmd, "AT*COMWDG=%u\r", seq);
-    ARDrone2_SendATCommand(cmd);
+    ARDrone2_ATCmd_t cmd;
+
+    ARDrone2_ATCmdBegin(&cmd, "COMWDG", ARDrone2_incrAtCmdSeq());
+    ARDrone2_ATCmdEnd(&cmd);
+    ARDrone2_QueueATCmd(&cmd);
 }
 
 /*!
@@ -1295,9 +1584,7 @@ void ARDrone2_cmdComWdg(void)
  */
 void ARDrone2_resetCmdSeq(void)
 {
-    OS_MutSemTake(g_ARDrone2_AppData.CmdSeqMutexId);
-    CmdSequence = ARDRONE2_NAVDATA_SEQUENCE_DEFAULT-1;
-    OS_MutSemGive(g_ARDrone2_AppData.CmdSeqMutexId);
+    __atomic_store_n(&CmdSequence, ARDRONE2_NAVDATA_SEQUENCE_DEFAULT-1, __ATOMIC_RELAXED);
 }
 
 
@@ -1307,14 +1594,7 @@ void ARDrone2_resetCmdSeq(void)
  */
 int ARDrone2_incrAtCmdSeq(void)
 {
-   int seq;
-
-   OS_MutSemTake(g_ARDrone2_AppData.CmdSeqMutexId);
-   CmdSequence++;
-   seq = CmdSequence;
-   OS_MutSemGive(g_ARDrone2_AppData.CmdSeqMutexId);
-
-   return seq;
+   return __atomic_add_fetch(&CmdSequence, 1, __ATOMIC_RELAXED);
 }
 
 /*=======================================================================================
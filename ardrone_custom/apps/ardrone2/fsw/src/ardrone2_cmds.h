@@ -77,10 +77,19 @@
 #define ARDRONE2_MOD_NAVDATA_OPT_CC     110
 #define ARDRONE2_YAW_ABS_CC             111  // yaw based on absolute magnetometer
 #define ARDRONE2_MAG_CAL                112  // in-flight calibrate magnetometer
+#define ARDRONE2_NAVDATA_REC_CC         113  // start/stop the navdata flight recorder
 
 // Amount that the drone drifts back towards being level
 #define ARDRONE2_DRIFT_AMOUNT           0.05
 
+// Wait between the steps of a configuration sequence
+#define ARDRONE2_AT_CONFIG_GAP_MSEC     30
+
+// Commands other tasks ask the AT command task to send, see ARDrone2_RequestATCmd
+#define ARDRONE2_AT_REQ_NAVDATA_DEMO    0x00000001  // AT*CONFIG general:navdata_demo TRUE
+#define ARDRONE2_AT_REQ_ACK_CONTROL     0x00000002  // AT*CTRL ACK_CONTROL_MODE
+#define ARDRONE2_AT_REQ_NAVDATA_OPTIONS 0x00000004  // AT*CONFIG general:navdata_options NavDataOptWanted
+
 typedef enum
 {
   NO_CONTROL_MODE = 0,          /**< Doing nothing */
@@ -173,6 +182,12 @@ typedef struct
     int             setFlag;    /**< (--) 1:true, 0:false */
 } ARDrone2_navdata_opt_cmd_t;
 
+typedef struct
+{
+    CFE_SB_CmdHdr_t cmdHdr;
+    int             enableFlag; /**< (--) 1:record, 0:stop */
+} ARDrone2_navdata_rec_cmd_t;
+
 
 typedef enum
 {
@@ -244,9 +259,11 @@ typedef enum
 
 
 /* cFS App function prototypes */
-void delay(unsigned int);
 void ARDrone2_ATCmdMain(void);
 void ARDrone2_configATCmd(char *, char *);
+void ARDrone2_configIds(void);
 void ARDrone2_cmdSetControl(ARDrone2_ControlMode_t controlMode);
+void ARDrone2_RequestATCmd(uint32 request);
+void ARDrone2_setNavDataOpts(uint32 options);
 
 #endif /* ARDRONE2_CMDS_H_ */
@@ -52,6 +52,9 @@ typedef struct
     uint8		TlmHeader[CFE_SB_TLM_HDR_SIZE];
     uint8		usCmdCnt;
     uint8		usCmdErrCnt;
+    uint32		uiAtCmdLatencyHist[ARDRONE2_AT_LATENCY_BINS];	/* AT commands sent, per receipt to sendto latency bin */
+    uint32		uiAtCmdLatencyMaxUsec;
+    uint32		uiAtTickOverruns;								/* Watchdog/drift ticks started a full period late */
 }   OS_PACK ARDrone2_HK_Tlm_t  ;
 
 typedef enum 
@@ -192,6 +195,16 @@ typedef struct
     NavData_Magneto_t           mag;
 } ARDrone2_NavData_Select_Msg_t;
 
+/* Sent on ARDRONE2_NAVDATA_OPT_MID(tag).  The payload is the option as laid
+ * out in NavData_Unpacked_t, e.g. NavData_Euler_Angles_t for the euler angles,
+ * so the message is ARDrone2_NavDataOptionSize(tag) bytes longer than the
+ * header. */
+typedef struct
+{
+    CFE_SB_TlmHdr_t             TlmHeader;
+    NavDataHeader_t             header;
+} ARDrone2_NavData_Opt_Msg_t;
+
 
 typedef struct
 {
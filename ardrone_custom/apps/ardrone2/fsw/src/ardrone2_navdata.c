@@ -25,9 +25,13 @@
 **
 ** Functions Defined:
 ** ARDrone2_NavdataPackOption()
-** ARDrone2_NavdataUnpackOption()
+** ARDrone2_NavDataComputeCksScalar()
 ** ARDrone2_NavDataComputeCks()
-** ARDrone2_NavDataSearchOption()
+** ARDrone2_NavDataBuildIndex()
+** ARDrone2_NavDataGetOption()
+** ARDrone2_NavDataOptionSize()
+** ARDrone2_NavDataCopyOption()
+** ARDrone2_NavDataUnpackAll()
 ** ARDrone2_GetMaskFromState()
 ** ARDrone2_ResetUpdateCounters()
 **
@@ -47,14 +51,24 @@
 /*
 ** Include Files
 */
+#include <stddef.h>
 #include <string.h>
 #include "ardrone2_app.h"
 #include "ardrone2_navdata.h"
 
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#define NAVDATA_CKS_SSE2
+#elif defined(__ARM_NEON) || defined(__ARM_NEON__)
+#include <arm_neon.h>
+#define NAVDATA_CKS_NEON
+#endif
+
 /*
 ** Local Defines
 */
-
+#define NAVDATA_OPTION_DESC(field) \
+	{ offsetof(NavData_Unpacked_t, field), sizeof(((NavData_Unpacked_t*) 0)->field), ARDrone2_NavDataCopyOption }
 
 /*
 ** Local Structure Declarations
@@ -72,6 +86,41 @@ extern AppData_t g_ARDrone2_AppData;
 /*
 ** Local Variables
 */
+static void ARDrone2_NavDataUnpackDemo( NavDataHeader_t* dest, uint32 dest_size, NavData_Option_t* option );
+
+/* Where each option tag is unpacked.  The demo option is not part of
+ * NavData_Unpacked_t, it goes straight into the demo telemetry message. */
+static const NavData_OptionDesc_t ARDrone2_NavDataOptionTbl[ARDRONE2_NAVDATA_NUM_TAGS] =
+{
+	[ARDRONE2_NAVDATA_DEMO_TAG]             = { 0, 0, ARDrone2_NavDataUnpackDemo },
+	[ARDRONE2_NAVDATA_TIME_TAG]             = NAVDATA_OPTION_DESC(time),
+	[ARDRONE2_NAVDATA_RAW_MEASURES_TAG]     = NAVDATA_OPTION_DESC(raw_measures),
+	[ARDRONE2_NAVDATA_PHYS_MEASURES_TAG]    = NAVDATA_OPTION_DESC(phys_measures),
+	[ARDRONE2_NAVDATA_GYROS_OFFSETS_TAG]    = NAVDATA_OPTION_DESC(gyros_offsets),
+	[ARDRONE2_NAVDATA_EULER_ANGLES_TAG]     = NAVDATA_OPTION_DESC(euler_angles),
+	[ARDRONE2_NAVDATA_REFERENCES_TAG]       = NAVDATA_OPTION_DESC(references),
+	[ARDRONE2_NAVDATA_TRIMS_TAG]            = NAVDATA_OPTION_DESC(trims),
+	[ARDRONE2_NAVDATA_RC_REFERENCES_TAG]    = NAVDATA_OPTION_DESC(rc_references),
+	[ARDRONE2_NAVDATA_PWM_TAG]              = NAVDATA_OPTION_DESC(pwm),
+	[ARDRONE2_NAVDATA_ALTITUDE_TAG]         = NAVDATA_OPTION_DESC(altitude),
+	[ARDRONE2_NAVDATA_VISION_RAW_TAG]       = NAVDATA_OPTION_DESC(vision_raw),
+	[ARDRONE2_NAVDATA_VISION_OF_TAG]        = NAVDATA_OPTION_DESC(vision_of),
+	[ARDRONE2_NAVDATA_VISION_TAG]           = NAVDATA_OPTION_DESC(vision),
+	[ARDRONE2_NAVDATA_VISION_PERF_TAG]      = NAVDATA_OPTION_DESC(vision_perf),
+	[ARDRONE2_NAVDATA_TRACKERS_SEND_TAG]    = NAVDATA_OPTION_DESC(trackers_send),
+	[ARDRONE2_NAVDATA_VISION_DETECT_TAG]    = NAVDATA_OPTION_DESC(vision_detect),
+	[ARDRONE2_NAVDATA_WATCHDOG_TAG]         = NAVDATA_OPTION_DESC(watchdog),
+	[ARDRONE2_NAVDATA_ADC_DATA_FRAME_TAG]   = NAVDATA_OPTION_DESC(adc_data_frame),
+	[ARDRONE2_NAVDATA_VIDEO_STREAM_TAG]     = NAVDATA_OPTION_DESC(video_stream),
+	[ARDRONE2_NAVDATA_GAMES_TAG]            = NAVDATA_OPTION_DESC(games),
+	[ARDRONE2_NAVDATA_PRESSURE_RAW_TAG]     = NAVDATA_OPTION_DESC(pressure_raw),
+	[ARDRONE2_NAVDATA_MAGNETO_TAG]          = NAVDATA_OPTION_DESC(magneto),
+	[ARDRONE2_NAVDATA_WIND_TAG]             = NAVDATA_OPTION_DESC(wind_speed),
+	[ARDRONE2_NAVDATA_KALMAN_PRESSURE_TAG]  = NAVDATA_OPTION_DESC(kalman_pressure),
+	[ARDRONE2_NAVDATA_HDVIDEO_STREAM_TAG]   = NAVDATA_OPTION_DESC(hdvideo_stream),
+	[ARDRONE2_NAVDATA_WIFI_TAG]             = NAVDATA_OPTION_DESC(wifi),
+	[ARDRONE2_NAVDATA_ZIMMU_3000_TAG]       = NAVDATA_OPTION_DESC(zimmu_3000)
+};
 
 /*
 ** Local Function Definitions
@@ -90,358 +139,237 @@ uint8* ARDrone2_NavdataPackOption( uint8* navdata_ptr, uint8* data, uint32 size
 }
 
 
-NavData_Option_t * ARDrone2_NavdataUnpackOption(NavData_Option_t* navdata_ptr, 
-                                                NavDataHeader_t* unpack_ptr, 
-                                                uint32 unpack_opt_size)
+/*!
+ * @brief  Navdata checksum, one byte at a time
+ * @note   Reference for the vector kernels, and what they use on short tails.
+ * @return Sum of the size bytes at nv, taken as unsigned
+ */
+uint32 ARDrone2_NavDataComputeCksScalar( const uint8* nv, uint32 size )
 {
-    unpack_ptr->update_count++;
-    uint32 srcSize = navdata_ptr->size - 4;
-    uint32 destSize = unpack_opt_size - sizeof(NavDataHeader_t);
-
-    uint32 minSize = (srcSize < destSize ? srcSize : destSize);
+	uint32 i;
+	uint32 cks = 0;
 
-    char * destPtr = (char *)unpack_ptr + sizeof(NavDataHeader_t);
-    char * srcPtr = (char *)navdata_ptr + 4;
+	for( i = 0; i < size; i++ )
+	{
+		cks += nv[i];
+	}
 
-    memcpy(destPtr, srcPtr, minSize);
-    
-    char * nextOptPtr = (char *)navdata_ptr + navdata_ptr->size;
-    return ((NavData_Option_t *) nextOptPtr);
+	return cks;
 }
 
-uint32 ARDrone2_NavDataComputeCks( int8* nv, int32 size )
+
+/*!
+ * @brief  Navdata checksum, 16 bytes at a time where SSE2 or NEON is available
+ * @return Same value as ARDrone2_NavDataComputeCksScalar
+ */
+uint32 ARDrone2_NavDataComputeCks( const uint8* nv, uint32 size )
 {
-	int32 i;
+	uint32 i = 0;
 	uint32 cks;
-	uint32 temp;
 
-	cks = 0;
+#if defined(NAVDATA_CKS_SSE2)
+	__m128i zero = _mm_setzero_si128();
+	__m128i acc0 = zero;
+	__m128i acc1 = zero;
 
-	for( i = 0; i < size; i++ )
+	/* psadbw against zero adds 8 bytes into each 64 bit lane */
+	for( ; i + 32 <= size; i += 32 )
 	{
-		temp = nv[i];                                              
-		cks += temp;
+		acc0 = _mm_add_epi64(acc0, _mm_sad_epu8(_mm_loadu_si128((const __m128i*) &nv[i]), zero));
+		acc1 = _mm_add_epi64(acc1, _mm_sad_epu8(_mm_loadu_si128((const __m128i*) &nv[i + 16]), zero));
+	}
+	for( ; i + 16 <= size; i += 16 )
+	{
+		acc0 = _mm_add_epi64(acc0, _mm_sad_epu8(_mm_loadu_si128((const __m128i*) &nv[i]), zero));
 	}
 
-	return cks;
-};
+	acc0 = _mm_add_epi64(acc0, acc1);
+	cks  = (uint32) _mm_cvtsi128_si32(acc0) + (uint32) _mm_cvtsi128_si32(_mm_srli_si128(acc0, 8));
+#elif defined(NAVDATA_CKS_NEON)
+	uint32x4_t acc = vdupq_n_u32(0);
+	uint64x2_t total;
 
-NavData_Option_t* ARDrone2_NavDataSearchOption( NavData_Option_t* navdata_options_ptr, NavData_Tag_t tag )
+	/* Pairwise widen to 16 bits, then accumulate into 32 bit lanes */
+	for( ; i + 16 <= size; i += 16 )
+	{
+		acc = vpadalq_u16(acc, vpaddlq_u8(vld1q_u8(&nv[i])));
+	}
+
+	total = vpaddlq_u32(acc);
+	cks   = (uint32) (vgetq_lane_u64(total, 0) + vgetq_lane_u64(total, 1));
+#else
+	cks = 0;
+#endif
+
+	return cks + ARDrone2_NavDataComputeCksScalar(&nv[i], size - i);
+}
+
+
+/*!
+ * @brief  Walk the options of a received packet once and record where each one is
+ * @note   The checksum is accumulated over each option as it is walked, so the
+ *         packet is only read once.  It covers every byte before the checksum
+ *         option, as computed by the drone.
+ * @param  index    index to fill in
+ * @param  navdata  received packet
+ * @param  length   number of bytes received
+ * @return TRUE if the option list is well formed, ends with a checksum option
+ *         and the checksum matches
+ */
+boolean ARDrone2_NavDataBuildIndex( NavData_Index_t* index, NavData_t* navdata, int32 length )
 {
-  uint8* ptr;
+	uint8*  base = (uint8*) navdata;
+	uint32  offset = (uint32) ((uint8*) &navdata->options[0] - base);
+	NavData_Option_t* option_ptr;
+
+	index->present    = 0;
+	index->cks_offset = 0;
+	index->length     = (uint16) length;
+	index->cks        = ARDrone2_NavDataComputeCks(base, offset);
+	index->cks_remote = 0;
+
+	while( offset + sizeof(NavData_Option_t) <= (uint32) length )
+	{
+		option_ptr = (NavData_Option_t*) (base + offset);
+
+		if( option_ptr->size < sizeof(NavData_Option_t) ||
+		    offset + option_ptr->size > (uint32) length )
+		{
+			return FALSE;
+		}
 
-  while( navdata_options_ptr->tag != tag )
-  {
-    ptr  = (uint8*) navdata_options_ptr;
-    ptr += navdata_options_ptr->size;
+		if( option_ptr->tag == ARDRONE2_NAVDATA_CKS_TAG )
+		{
+			if( option_ptr->size < sizeof(NavData_Option_t) + sizeof(index->cks_remote) )
+			{
+				return FALSE;
+			}
+
+			memcpy(&index->cks_remote, &option_ptr->data[0], sizeof(index->cks_remote));
+			index->cks_offset = (uint16) offset;
+
+			return index->cks == index->cks_remote ? TRUE : FALSE;
+		}
 
-    navdata_options_ptr = (NavData_Option_t*) ptr;
-  }
+		if( option_ptr->tag < ARDRONE2_NAVDATA_NUM_TAGS )
+		{
+			index->present |= 1 << option_ptr->tag;
+			index->offset[option_ptr->tag] = (uint16) offset;
+		}
+
+		index->cks += ARDrone2_NavDataComputeCks(base + offset, option_ptr->size);
+		offset += option_ptr->size;
+	}
 
-  return navdata_options_ptr;
+	return FALSE;
 }
 
 
-boolean ARDrone2_NavDataUnpackAll(NavData_Unpacked_t* navdata_unpacked, NavData_t* navdata, uint32* cks)
+/*!
+ * @brief  Look up an option in a packet already indexed by ARDrone2_NavDataBuildIndex
+ * @return Pointer to the option inside the packet, or NULL if it was not sent
+ */
+NavData_Option_t* ARDrone2_NavDataGetOption( NavData_Index_t* index, NavData_t* navdata, NavData_Tag_t tag )
 {
-	boolean success = TRUE;
-	NavData_Cks_t navdata_cks;
-	navdata_cks.cks = 0;
+	if( tag >= ARDRONE2_NAVDATA_NUM_TAGS || (index->present & (1 << tag)) == 0 )
+	{
+		return NULL;
+	}
+
+	return (NavData_Option_t*) ((uint8*) navdata + index->offset[tag]);
+}
+
 
-	NavData_Option_t* navdata_option_ptr;
+/*!
+ * @brief  Size of an option once unpacked, header included
+ * @return 0 for the demo option, which is not unpacked with the others, or an unknown tag
+ */
+uint32 ARDrone2_NavDataOptionSize( NavData_Tag_t tag )
+{
+	if( tag >= ARDRONE2_NAVDATA_NUM_TAGS )
+	{
+		return 0;
+	}
+
+	return ARDrone2_NavDataOptionTbl[tag].dest_size;
+}
 
-	navdata_option_ptr = (NavData_Option_t*) &navdata->options[0];
 
-	navdata_unpacked->nd_seq   			= navdata->sequence;
-	navdata_unpacked->ardrone_state   	= navdata->ardrone_state;
-	navdata_unpacked->vision_defined  	= navdata->vision_defined;
+/*!
+ * @brief  Copy the payload of a received option into its unpacked structure
+ * @note   Bytes the drone did not send are zeroed.  The header is left to the caller.
+ */
+void ARDrone2_NavDataCopyOption( NavDataHeader_t* dest, uint32 dest_size, NavData_Option_t* option )
+{
+	uint8* dest_ptr  = (uint8*) dest + sizeof(NavDataHeader_t);
+	uint32 dest_len  = dest_size - sizeof(NavDataHeader_t);
+	uint32 src_len   = 0;
 
-	while( navdata_option_ptr != 0 )
+	if( option != NULL )
 	{
-		// Check if we have a valid option
-		if( navdata_option_ptr->size == 0 )
+		src_len = option->size - sizeof(NavData_Option_t);
+		if( src_len > dest_len )
 		{
-			/* TODO:  Replace this with an error event. */
-			//PRINT("One option (%d) is not a valid option because its size is zero\n", navdata_option_ptr->tag);
-			navdata_option_ptr = 0;
-			success = FALSE;
+			src_len = dest_len;
 		}
-		else
+		memcpy(dest_ptr, &option->data[0], src_len);
+	}
+
+	memset(dest_ptr + src_len, 0, dest_len - src_len);
+}
+
+
+/*!
+ * @brief  Copy the demo option into the demo telemetry message
+ */
+static void ARDrone2_NavDataUnpackDemo( NavDataHeader_t* dest, uint32 dest_size, NavData_Option_t* option )
+{
+	uint32 dstSize = sizeof(g_ARDrone2_AppData.NavDataDemoMsg.payload);
+	uint32 srcSize = option->size - sizeof(NavData_Option_t);
+
+	memcpy(&g_ARDrone2_AppData.NavDataDemoMsg.payload, &option->data[0], (dstSize < srcSize ? dstSize : srcSize));
+}
+
+
+/*!
+ * @brief  Unpack the requested options of an indexed packet
+ * @param  navdata_unpacked  structure receiving the options
+ * @param  frame             packet already indexed by ARDrone2_NavDataBuildIndex
+ * @param  requested         mask of the option tags to unpack, others are skipped
+ * @return TRUE if the packet ended with a checksum option
+ */
+boolean ARDrone2_NavDataUnpackAll( NavData_Unpacked_t* navdata_unpacked, NavData_Frame_t* frame, uint32 requested )
+{
+	const NavData_OptionDesc_t* desc;
+	NavDataHeader_t* dest;
+	uint32 pending = frame->index.present & requested;
+	uint32 tag;
+
+	navdata_unpacked->nd_seq   			= frame->navdata.sequence;
+	navdata_unpacked->ardrone_state   	= frame->navdata.ardrone_state;
+	navdata_unpacked->vision_defined  	= frame->navdata.vision_defined;
+	navdata_unpacked->last_navdata_refresh = pending;
+
+	for( tag = 0; pending != 0; tag++, pending >>= 1 )
+	{
+		if( (pending & 1) == 0 )
 		{
-			if( navdata_option_ptr->tag <= ARDRONE2_NAVDATA_NUM_TAGS)
-			{
-			   #ifdef DEBUG_NAVDATA_C
-    	  	 	OS_printf("[%d]",navdata_option_ptr->tag);
-			   #endif
-    	  	 	navdata_unpacked->last_navdata_refresh |= 1 << (navdata_option_ptr->tag);
-			}
+			continue;
+		}
 
-			switch( navdata_option_ptr->tag )
-			{
-				case ARDRONE2_NAVDATA_DEMO_TAG:
-				{
-					uint32 dstSize = sizeof(g_ARDrone2_AppData.NavDataDemoMsg.payload);
-					uint32 srcSize = navdata_option_ptr->size;
-					uint32 minSize = (dstSize < srcSize ? dstSize : srcSize);
-                    
-					memcpy(&g_ARDrone2_AppData.NavDataDemoMsg.payload, &navdata_option_ptr->data[0], minSize);
-					
-                    /*For some unknown reason, the message received is 500bytes 
-                      instead of 292, so lets just jump to 500... */
-                    //char *addr = (char *) navdata;
-                    //addr +=500;
-                    //navdata_option_ptr = (NavData_Option_t *) addr;
-                    
-                    char *addr = (char *)navdata_option_ptr;
-                    navdata_option_ptr = (NavData_Option_t *)(addr + srcSize);
-
-                    //addr += 500;
-                    //navdata_option_ptr = navdata_option_ptr + srcSize;
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_TIME_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->time ,
-                    sizeof(navdata_unpacked->time) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_RAW_MEASURES_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->raw_measures ,
-                    sizeof(navdata_unpacked->raw_measures) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_PHYS_MEASURES_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->phys_measures ,
-                    sizeof(navdata_unpacked->phys_measures) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_GYROS_OFFSETS_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->gyros_offsets ,
-                    sizeof(navdata_unpacked->gyros_offsets) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_EULER_ANGLES_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->euler_angles ,
-                    sizeof(navdata_unpacked->euler_angles) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_REFERENCES_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->references ,
-                    sizeof(navdata_unpacked->references) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_TRIMS_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->trims,
-                    sizeof(navdata_unpacked->trims));
-                    break;
-				}
-
-				case ARDRONE2_NAVDATA_RC_REFERENCES_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->rc_references ,
-                    sizeof(navdata_unpacked->rc_references) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_PWM_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->pwm ,
-                    sizeof(navdata_unpacked->pwm) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_ALTITUDE_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->altitude ,
-                    sizeof(navdata_unpacked->altitude) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_VISION_RAW_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->vision_raw ,
-                    sizeof(navdata_unpacked->vision_raw) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_VISION_OF_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->vision_of ,
-                    sizeof(navdata_unpacked->vision_of) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_VISION_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->vision ,
-                    sizeof(navdata_unpacked->vision) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_VISION_PERF_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->vision_perf ,
-                    sizeof(navdata_unpacked->vision_perf) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_TRACKERS_SEND_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->trackers_send ,
-                    sizeof(navdata_unpacked->trackers_send) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_VISION_DETECT_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->vision_detect ,
-                    sizeof(navdata_unpacked->vision_detect) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_WATCHDOG_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->watchdog ,
-                    sizeof(navdata_unpacked->watchdog) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_ADC_DATA_FRAME_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->adc_data_frame ,
-                    sizeof(navdata_unpacked->adc_data_frame) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_VIDEO_STREAM_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->video_stream ,
-                    sizeof(navdata_unpacked->video_stream) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_GAMES_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->games ,
-                    sizeof(navdata_unpacked->games) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_PRESSURE_RAW_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->pressure_raw ,
-                    sizeof(navdata_unpacked->pressure_raw) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_MAGNETO_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->magneto ,
-                    sizeof(navdata_unpacked->magneto) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_WIND_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->wind_speed ,
-                    sizeof(navdata_unpacked->wind_speed) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_KALMAN_PRESSURE_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->kalman_pressure ,
-                    sizeof(navdata_unpacked->kalman_pressure) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_HDVIDEO_STREAM_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->hdvideo_stream ,
-                    sizeof(navdata_unpacked->hdvideo_stream) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_WIFI_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->wifi ,
-                    sizeof(navdata_unpacked->wifi) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_ZIMMU_3000_TAG:
-				{
-					navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    (NavDataHeader_t *) &navdata_unpacked->zimmu_3000 ,
-                    sizeof(navdata_unpacked->zimmu_3000) );
-					break;
-				}
-
-				case ARDRONE2_NAVDATA_CKS_TAG:
-				{
-					//navdata_option_ptr = ARDrone2_NavdataUnpackOption( navdata_option_ptr,
-                    //(NavDataHeader_t *) &navdata_unpacked->demo ,
-                    //sizeof(navdata_unpacked->demo) );
-					*cks = navdata_cks.cks;
-					navdata_option_ptr = 0; // End of structure
-					break;
-				}
-
-				default:
-				{
-					// TODO:  Replace the following with an error event.
-					//PRINT("Tag %d is an unknown navdata option tag\n", (int) navdata_option_ptr->tag);
-					navdata_option_ptr = (NavData_Option_t*)(((uint32)navdata_option_ptr) + navdata_option_ptr->size);
-					break;
-				}
-			}
+		desc = &ARDrone2_NavDataOptionTbl[tag];
+		dest = (NavDataHeader_t*) ((uint8*) navdata_unpacked + desc->dest_offset);
+
+		desc->unpack(dest, desc->dest_size,
+		             (NavData_Option_t*) &frame->buffer[frame->index.offset[tag]]);
+
+		if( desc->dest_size != 0 )
+		{
+			dest->update_count++;
 		}
 	}
 
-   #ifdef DEBUG_NAVDATA_C
-	printf("\n");
-   #endif
-
-	return success;
+	return frame->index.cks_offset != 0 ? TRUE : FALSE;
 }
 
 
@@ -454,33 +382,15 @@ boolean ARDrone2_GetMaskFromState( uint32 state, uint32 mask )
 
 void ARDrone2_ResetUpdateCounters(NavData_Unpacked_t* navdata_unpacked)
 {
-//	navdata_unpacked->demo.header.update_count = 0;
-	navdata_unpacked->time.header.update_count = 0;
-	navdata_unpacked->raw_measures.header.update_count = 0;
-	navdata_unpacked->phys_measures.header.update_count = 0;
-	navdata_unpacked->gyros_offsets.header.update_count = 0;
-	navdata_unpacked->euler_angles.header.update_count = 0;
-	navdata_unpacked->references.header.update_count = 0;
-	navdata_unpacked->trims.header.update_count = 0;
-	navdata_unpacked->rc_references.header.update_count = 0;
-	navdata_unpacked->pwm.header.update_count = 0;
-	navdata_unpacked->altitude.header.update_count = 0;
-	navdata_unpacked->vision_raw.header.update_count = 0;
-	navdata_unpacked->vision_of.header.update_count = 0;
-	navdata_unpacked->vision.header.update_count = 0;
-	navdata_unpacked->vision_perf.header.update_count = 0;
-	navdata_unpacked->trackers_send.header.update_count = 0;
-	navdata_unpacked->vision_detect.header.update_count = 0;
-	navdata_unpacked->watchdog.header.update_count = 0;
-	navdata_unpacked->adc_data_frame.header.update_count = 0;
-	navdata_unpacked->video_stream.header.update_count = 0;
-	navdata_unpacked->games.header.update_count = 0;
-	navdata_unpacked->pressure_raw.header.update_count = 0;
-	navdata_unpacked->magneto.header.update_count = 0;
-	navdata_unpacked->wind_speed.header.update_count = 0;
-	navdata_unpacked->kalman_pressure.header.update_count = 0;
-	navdata_unpacked->hdvideo_stream.header.update_count = 0;
-	navdata_unpacked->wifi.header.update_count = 0;
-	navdata_unpacked->zimmu_3000.header.update_count = 0;
-}
+	uint32 tag;
+	NavDataHeader_t* dest;
 
+	for( tag = 0; tag < ARDRONE2_NAVDATA_NUM_TAGS; tag++ )
+	{
+		if( ARDrone2_NavDataOptionTbl[tag].dest_size != 0 )
+		{
+			dest = (NavDataHeader_t*) ((uint8*) navdata_unpacked + ARDrone2_NavDataOptionTbl[tag].dest_offset);
+			dest->update_count = 0;
+		}
+	}
+}
@@ -212,6 +212,11 @@ typedef enum _navdata_tag_t
 	ARDRONE2_NAVDATA_CKS_TAG = 0xFFFF
 } NavData_Tag_t;
 
+/* Options the app itself needs, for the demo and select messages */
+#define ARDRONE2_NAVDATA_SELECT_OPTIONS		((1 << ARDRONE2_NAVDATA_DEMO_TAG) | \
+											 (1 << ARDRONE2_NAVDATA_TIME_TAG) | \
+											 (1 << ARDRONE2_NAVDATA_MAGNETO_TAG))
+
 #define ARDRONE2_OPTION_HEADER_SIZE = sizeof(uint16) + sizeof(uint16);
 
 
@@ -724,12 +729,65 @@ typedef struct
 } NavData_t;
 
 
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Location of each option inside a received navdata packet
+ *
+ * Built in a single pass over the raw datagram so options can be read in
+ * place, without unpacking the whole packet first.
+ */
+typedef struct
+{
+	uint32		present;        							/*!< Mask of the option tags found in the packet */
+	uint16		offset[ARDRONE2_NAVDATA_NUM_TAGS];			/*!< Byte offset of each option from the start of the packet */
+	uint16		cks_offset;       							/*!< Byte offset of the checksum option, 0 if not found */
+	uint16		length;           							/*!< Number of bytes received */
+	uint32		cks;              							/*!< Checksum computed over the bytes before the checksum option */
+	uint32		cks_remote;       							/*!< Checksum sent by the drone */
+} NavData_Index_t;
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Received navdata packet and its option index
+ */
+typedef struct
+{
+	NavData_Index_t	index;
+	union
+	{
+		NavData_t	navdata;
+		int8		buffer[ARDRONE2_MAX_NAV_BUFFER_SIZE];
+	};
+} NavData_Frame_t;
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Copies the payload of one received option into its destination
+ */
+typedef void (*NavData_UnpackFunc_t)( NavDataHeader_t* dest, uint32 dest_size, NavData_Option_t* option );
+
+
+/*----------------------------------------------------------------------------*/
+/**
+ * @brief Describes where a navdata option is unpacked, indexed by option tag
+ */
+typedef struct
+{
+	uint32					dest_offset;	/*!< Offset of the option in NavData_Unpacked_t */
+	uint32					dest_size;		/*!< Size of the option in NavData_Unpacked_t, 0 if it is not kept there */
+	NavData_UnpackFunc_t	unpack;			/*!< Function copying the option out of the packet */
+} NavData_OptionDesc_t;
 
 
-NavData_Option_t* 		ARDrone2_NavDataNextOption( NavData_Option_t* navdata_options_ptr );
-uint32					ARDrone2_NavDataComputeCks( int8* nv, int32 size );
-boolean					ARDrone2_NavDataUnpackAll(NavData_Unpacked_t* navdata_unpacked, NavData_t* navdata, uint32* cks);
-NavData_Option_t* 		ARDrone2_NavDataSearchOption( NavData_Option_t* navdata_options_ptr, NavData_Tag_t tag );
+uint32					ARDrone2_NavDataOptionSize( NavData_Tag_t tag );
+uint32					ARDrone2_NavDataComputeCksScalar( const uint8* nv, uint32 size );
+uint32					ARDrone2_NavDataComputeCks( const uint8* nv, uint32 size );
+boolean					ARDrone2_NavDataUnpackAll( NavData_Unpacked_t* navdata_unpacked, NavData_Frame_t* frame, uint32 requested );
+boolean					ARDrone2_NavDataBuildIndex( NavData_Index_t* index, NavData_t* navdata, int32 length );
+NavData_Option_t* 		ARDrone2_NavDataGetOption( NavData_Index_t* index, NavData_t* navdata, NavData_Tag_t tag );
+void					ARDrone2_NavDataCopyOption( NavDataHeader_t* dest, uint32 dest_size, NavData_Option_t* option );
 boolean					ARDrone2_GetMaskFromState( uint32 state, uint32 mask );
 void 					ARDrone2_ResetUpdateCounters(NavData_Unpacked_t* navdata_unpacked);
 
@@ -0,0 +1,312 @@
+/*=======================================================================================
+** File Name:  ardrone2_recorder.c
+**
+** Title:  Function Definitions for the ARDRONE2 navdata flight recorder
+**
+** Purpose:  Append raw navdata datagrams to a ring file mapped in memory, and
+**           read them back.
+**
+** Functions Defined:
+**    ARDrone2_RecOpen()
+**    ARDrone2_RecOpenRead()
+**    ARDrone2_RecClose()
+**    ARDrone2_RecAppend()
+**    ARDrone2_RecIterBegin()
+**    ARDrone2_RecIterNext()
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    See ardrone2_recorder.h
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**
+**=====================================================================================*/
+
+/*
+** Include Files
+*/
+#include <fcntl.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+
+#include "ardrone2_recorder.h"
+
+/*
+** Local Function Prototypes
+*/
+static int32 ARDrone2_RecMap(ARDrone2_Rec_t *rec, int prot);
+static void  ARDrone2_RecDropOldest(ARDrone2_Rec_t *rec);
+
+
+static int32 ARDrone2_RecMap(ARDrone2_Rec_t *rec, int prot)
+{
+    void *map;
+
+    map = mmap(NULL, rec->mapSize, prot, MAP_SHARED, rec->fd, 0);
+    if (map == MAP_FAILED)
+    {
+        close(rec->fd);
+        rec->fd = -1;
+        return -1;
+    }
+
+    rec->hdr  = (ARDrone2_RecHdr_t *) map;
+    rec->ring = (uint8 *) map + sizeof(ARDrone2_RecHdr_t);
+
+    return 0;
+}
+
+
+/*!
+ * @brief  Open a ring file for recording, creating it if needed
+ * @param  size  Bytes in the ring, rounded down to 8
+ * @note   A file left by an earlier run with the same size is appended to.
+ *         Anything else is started over.
+ * @return 0, or -1 if the file could not be created or mapped
+ */
+int32 ARDrone2_RecOpen(ARDrone2_Rec_t *rec, const char *path, uint32 size)
+{
+    ARDrone2_RecHdr_t *hdr;
+
+    size &= ~7;
+
+    rec->hdr     = NULL;
+    rec->mapSize = sizeof(ARDrone2_RecHdr_t) + size;
+    rec->fd      = open(path, O_RDWR | O_CREAT, 0644);
+    if (rec->fd < 0)
+    {
+        return -1;
+    }
+
+    /* Allocate every block now, so appending never waits on the file system */
+    if (posix_fallocate(rec->fd, 0, rec->mapSize) != 0 ||
+        ARDrone2_RecMap(rec, PROT_READ | PROT_WRITE) != 0)
+    {
+        if (rec->fd >= 0)
+        {
+            close(rec->fd);
+            rec->fd = -1;
+        }
+        return -1;
+    }
+
+    hdr = rec->hdr;
+    if (hdr->magic != ARDRONE2_REC_MAGIC || hdr->version != ARDRONE2_REC_VERSION ||
+        hdr->size != size || hdr->head >= size || hdr->tail >= size)
+    {
+        memset(hdr, 0x00, sizeof(*hdr));
+        hdr->magic   = ARDRONE2_REC_MAGIC;
+        hdr->version = ARDRONE2_REC_VERSION;
+        hdr->size    = size;
+    }
+
+    return 0;
+}
+
+
+/*!
+ * @brief  Open a capture to read it
+ * @return 0, or -1 if the file is missing or not a capture
+ */
+int32 ARDrone2_RecOpenRead(ARDrone2_Rec_t *rec, const char *path)
+{
+    struct stat st;
+
+    rec->hdr = NULL;
+    rec->fd  = open(path, O_RDONLY);
+    if (rec->fd < 0)
+    {
+        return -1;
+    }
+
+    if (fstat(rec->fd, &st) != 0 || st.st_size < (off_t) sizeof(ARDrone2_RecHdr_t))
+    {
+        close(rec->fd);
+        rec->fd = -1;
+        return -1;
+    }
+
+    rec->mapSize = (uint32) st.st_size;
+    if (ARDrone2_RecMap(rec, PROT_READ) != 0)
+    {
+        return -1;
+    }
+
+    if (rec->hdr->magic != ARDRONE2_REC_MAGIC || rec->hdr->version != ARDRONE2_REC_VERSION ||
+        rec->hdr->size > rec->mapSize - sizeof(ARDrone2_RecHdr_t))
+    {
+        ARDrone2_RecClose(rec);
+        return -1;
+    }
+
+    return 0;
+}
+
+
+void ARDrone2_RecClose(ARDrone2_Rec_t *rec)
+{
+    if (rec->hdr != NULL)
+    {
+        msync(rec->hdr, rec->mapSize, MS_ASYNC);
+        munmap(rec->hdr, rec->mapSize);
+        rec->hdr  = NULL;
+        rec->ring = NULL;
+    }
+
+    if (rec->fd >= 0)
+    {
+        close(rec->fd);
+        rec->fd = -1;
+    }
+}
+
+
+/* Free the oldest record, or skip the unused end of the ring */
+static void ARDrone2_RecDropOldest(ARDrone2_Rec_t *rec)
+{
+    ARDrone2_RecHdr_t   *hdr   = rec->hdr;
+    ARDrone2_RecEntry_t *entry = (ARDrone2_RecEntry_t *) &rec->ring[hdr->tail];
+
+    if (entry->length == ARDRONE2_REC_WRAP)
+    {
+        hdr->tail = 0;
+        return;
+    }
+
+    hdr->tail += ARDRONE2_REC_ALIGN(sizeof(ARDrone2_RecEntry_t) + entry->length);
+    if (hdr->tail >= hdr->size)
+    {
+        hdr->tail = 0;
+    }
+
+    hdr->count--;
+    hdr->overwritten++;
+}
+
+
+/*!
+ * @brief  Append a datagram, overwriting the oldest ones if needed
+ * @return FALSE if the recorder is not open or the datagram is larger than the ring
+ */
+boolean ARDrone2_RecAppend(ARDrone2_Rec_t *rec, const void *data, uint32 length,
+                           uint32 seconds, uint32 subseconds, uint32 latency_usec)
+{
+    ARDrone2_RecHdr_t   *hdr = rec->hdr;
+    ARDrone2_RecEntry_t *entry;
+    uint32 span;
+
+    if (hdr == NULL)
+    {
+        return FALSE;
+    }
+
+    span = ARDRONE2_REC_ALIGN(sizeof(ARDrone2_RecEntry_t) + length);
+    if (span > hdr->size)
+    {
+        return FALSE;
+    }
+
+    for (;;)
+    {
+        if (hdr->count == 0)
+        {
+            hdr->head = 0;
+            hdr->tail = 0;
+        }
+
+        if (hdr->count == 0 || hdr->head > hdr->tail)
+        {
+            /* Free from head to the end of the ring */
+            if (span <= hdr->size - hdr->head)
+            {
+                break;
+            }
+
+            ((ARDrone2_RecEntry_t *) &rec->ring[hdr->head])->length = ARDRONE2_REC_WRAP;
+            hdr->head = 0;
+        }
+        else if (span <= hdr->tail - hdr->head)
+        {
+            /* Free from head to tail */
+            break;
+        }
+        else
+        {
+            ARDrone2_RecDropOldest(rec);
+        }
+    }
+
+    entry = (ARDrone2_RecEntry_t *) &rec->ring[hdr->head];
+    entry->length       = length;
+    entry->seconds      = seconds;
+    entry->subseconds   = subseconds;
+    entry->latency_usec = latency_usec;
+    memcpy(entry + 1, data, length);
+
+    hdr->head += span;
+    if (hdr->head >= hdr->size)
+    {
+        hdr->head = 0;
+    }
+
+    hdr->count++;
+    hdr->total++;
+
+    return TRUE;
+}
+
+
+/*!
+ * @brief  Start reading records, oldest first
+ */
+void ARDrone2_RecIterBegin(ARDrone2_Rec_t *rec, ARDrone2_RecIter_t *iter)
+{
+    iter->pos  = rec->hdr->tail;
+    iter->left = rec->hdr->count;
+}
+
+
+/*!
+ * @return The next record, its datagram following it, or NULL after the
+ *         newest one or on a damaged file
+ */
+ARDrone2_RecEntry_t *ARDrone2_RecIterNext(ARDrone2_Rec_t *rec, ARDrone2_RecIter_t *iter)
+{
+    ARDrone2_RecEntry_t *entry;
+    uint32 size = rec->hdr->size;
+
+    /* Only the length word of a wrap entry fits in the last 8 bytes of the ring */
+    if (iter->left == 0 || iter->pos + sizeof(uint32) > size)
+    {
+        return NULL;
+    }
+
+    entry = (ARDrone2_RecEntry_t *) &rec->ring[iter->pos];
+    if (entry->length == ARDRONE2_REC_WRAP)
+    {
+        iter->pos = 0;
+        entry = (ARDrone2_RecEntry_t *) &rec->ring[0];
+    }
+
+    if (entry->length == ARDRONE2_REC_WRAP ||
+        iter->pos + sizeof(ARDrone2_RecEntry_t) + entry->length > size)
+    {
+        return NULL;
+    }
+
+    iter->pos += ARDRONE2_REC_ALIGN(sizeof(ARDrone2_RecEntry_t) + entry->length);
+    if (iter->pos >= size)
+    {
+        iter->pos = 0;
+    }
+    iter->left--;
+
+    return entry;
+}
+
+/*=======================================================================================
+** End of file ardrone2_recorder.c
+**=====================================================================================*/
@@ -0,0 +1,95 @@
+/*=======================================================================================
+** File Name:  ardrone2_recorder.h
+**
+** Title:  Header File for the ARDRONE2 navdata flight recorder
+**
+**
+** Purpose:  Keep every raw navdata datagram received, at full rate, in a ring
+**           file mapped in memory, for post-flight analysis and replay.
+**
+**           The file is a ARDrone2_RecHdr_t followed by the ring.  Each record
+**           is an ARDrone2_RecEntry_t followed by the datagram, padded to 8
+**           bytes.  When a record does not fit before the end of the ring, an
+**           entry with length ARDRONE2_REC_WRAP marks the rest as unused and
+**           the record goes at the start.  The oldest records are overwritten
+**           once the ring is full.
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    One writer, the telemetry task.  The file is preallocated at open, so
+**    appending never touches the file system.  No cFE calls, so tools can
+**    read captures with the same code.
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**
+**=====================================================================================*/
+
+#ifndef _ARDRONE2_RECORDER_H_
+#define _ARDRONE2_RECORDER_H_
+
+#include "common_types.h"
+
+/*
+** Local Defines
+*/
+#define ARDRONE2_REC_MAGIC      0x4152564E  /* "ARVN" */
+#define ARDRONE2_REC_VERSION    1
+#define ARDRONE2_REC_WRAP       0xFFFFFFFF  /* Entry length marking the end of the used ring */
+#define ARDRONE2_REC_ALIGN(n)   (((n) + 7) & ~7)
+
+/*
+** Local Structure Declarations
+*/
+typedef struct
+{
+    uint32      magic;
+    uint32      version;
+    uint32      size;           /*!< Bytes in the ring, after this header */
+    uint32      head;           /*!< Ring offset of the next record */
+    uint32      tail;           /*!< Ring offset of the oldest record */
+    uint32      count;          /*!< Records in the ring */
+    uint32      total;          /*!< Records ever appended */
+    uint32      overwritten;    /*!< Records lost to the ring wrapping */
+    uint32      spare[8];
+} ARDrone2_RecHdr_t;
+
+typedef struct
+{
+    uint32      length;         /*!< Datagram bytes, or ARDRONE2_REC_WRAP */
+    uint32      seconds;        /*!< CFE time of receipt */
+    uint32      subseconds;
+    uint32      latency_usec;   /*!< From the kernel receiving the datagram to it being recorded */
+} ARDrone2_RecEntry_t;
+
+typedef struct
+{
+    ARDrone2_RecHdr_t   *hdr;
+    uint8               *ring;
+    uint32              mapSize;
+    int                 fd;
+} ARDrone2_Rec_t;
+
+typedef struct
+{
+    uint32      pos;
+    uint32      left;
+} ARDrone2_RecIter_t;
+
+/*
+** Local Function Prototypes
+*/
+int32   ARDrone2_RecOpen(ARDrone2_Rec_t *rec, const char *path, uint32 size);
+int32   ARDrone2_RecOpenRead(ARDrone2_Rec_t *rec, const char *path);
+void    ARDrone2_RecClose(ARDrone2_Rec_t *rec);
+boolean ARDrone2_RecAppend(ARDrone2_Rec_t *rec, const void *data, uint32 length,
+                           uint32 seconds, uint32 subseconds, uint32 latency_usec);
+
+void                 ARDrone2_RecIterBegin(ARDrone2_Rec_t *rec, ARDrone2_RecIter_t *iter);
+ARDrone2_RecEntry_t *ARDrone2_RecIterNext(ARDrone2_Rec_t *rec, ARDrone2_RecIter_t *iter);
+
+#endif /* _ARDRONE2_RECORDER_H_ */
+
+/*=======================================================================================
+** End of file ardrone2_recorder.h
+**=====================================================================================*/
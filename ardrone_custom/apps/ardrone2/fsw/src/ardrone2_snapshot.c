@@ -0,0 +1,126 @@
+/*=======================================================================================
+** File Name:  ardrone2_snapshot.c
+**
+** Title:  Function Definitions for ARDRONE2 lock-free snapshots
+**
+** Purpose:  Triple buffer used between the telemetry task and the main
+**           ARDrone2 task.
+**
+** Functions Defined:
+**    ARDrone2_MsgTripleInit()
+**    ARDrone2_MsgTripleBack()
+**    ARDrone2_MsgTriplePublish()
+**    ARDrone2_MsgTripleTake()
+**    ARDrone2_MsgTripleRelease()
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    See ardrone2_snapshot.h
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**
+**=====================================================================================*/
+
+/*
+** Include Files
+*/
+#include <string.h>
+
+#include "ardrone2_snapshot.h"
+
+
+void ARDrone2_MsgTripleInit(ARDrone2_MsgTriple_t *triple)
+{
+    memset(triple->slot, 0x00, sizeof(triple->slot));
+    triple->back  = 0;
+    triple->front = 1;
+    __atomic_store_n(&triple->middle, 2, __ATOMIC_RELEASE);
+}
+
+
+/*!
+ * @brief  Slot the writer fills next
+ * @note   Its message is NULL if the reader sent it, and must then be allocated
+ *         again.  Otherwise it holds a message that was never taken, which can
+ *         be overwritten.
+ */
+ARDrone2_MsgSlot_t *ARDrone2_MsgTripleBack(ARDrone2_MsgTriple_t *triple)
+{
+    return &triple->slot[triple->back];
+}
+
+
+/*!
+ * @brief  Make the back slot the latest message, and take over the previous one
+ */
+void ARDrone2_MsgTriplePublish(ARDrone2_MsgTriple_t *triple)
+{
+    uint32 old;
+
+    old = __atomic_exchange_n(&triple->middle,
+                              triple->back | ARDRONE2_MSG_TRIPLE_FRESH,
+                              __ATOMIC_ACQ_REL);
+
+    triple->back = old & ARDRONE2_MSG_TRIPLE_IDX_MASK;
+}
+
+
+/*!
+ * @brief  Take the latest message published by the writer
+ * @return The message, now owned by the caller, or NULL if nothing was
+ *         published since the last call
+ */
+CFE_SB_Msg_t *ARDrone2_MsgTripleTake(ARDrone2_MsgTriple_t *triple,
+                                     CFE_SB_ZeroCopyHandle_t *handle)
+{
+    ARDrone2_MsgSlot_t *slot;
+    CFE_SB_Msg_t       *msg;
+    uint32 old;
+
+    if ((__atomic_load_n(&triple->middle, __ATOMIC_ACQUIRE) & ARDRONE2_MSG_TRIPLE_FRESH) == 0)
+    {
+        return NULL;
+    }
+
+    old = __atomic_exchange_n(&triple->middle, triple->front, __ATOMIC_ACQ_REL);
+    triple->front = old & ARDRONE2_MSG_TRIPLE_IDX_MASK;
+
+    slot = &triple->slot[triple->front];
+    msg  = slot->ptr;
+    *handle   = slot->handle;
+    slot->ptr = NULL;
+
+    return msg;
+}
+
+
+/*!
+ * @brief  Release the messages the reader has not taken, when the writer stops
+ * @note   Called by the writer.  The published message is taken back first, so
+ *         the reader cannot take it meanwhile.  The front slot holds no message:
+ *         the reader sends what it takes.
+ */
+void ARDrone2_MsgTripleRelease(ARDrone2_MsgTriple_t *triple)
+{
+    ARDrone2_MsgSlot_t *slot;
+    uint32 old;
+    uint32 i;
+
+    old = __atomic_exchange_n(&triple->middle, triple->back, __ATOMIC_ACQ_REL);
+    triple->back = old & ARDRONE2_MSG_TRIPLE_IDX_MASK;
+
+    for (i = 0; i < 3; i++)
+    {
+        slot = &triple->slot[i];
+        if (i != triple->front && slot->ptr != NULL)
+        {
+            CFE_SB_ZeroCopyReleasePtr(slot->ptr, slot->handle);
+            slot->ptr = NULL;
+        }
+    }
+}
+
+/*=======================================================================================
+** End of file ardrone2_snapshot.c
+**=====================================================================================*/
@@ -0,0 +1,66 @@
+/*=======================================================================================
+** File Name:  ardrone2_snapshot.h
+**
+** Title:  Header File for ARDRONE2 lock-free snapshots
+**
+**
+** Purpose:  Share navdata from the telemetry task, which is the only writer, with
+**           the other ARDrone2 tasks without a mutex.
+**
+**           ARDrone2_MsgTriple_t hands SB zero copy messages from the writer to a
+**           single reader through three slots.  The writer fills its back slot and
+**           publishes it; the reader takes the latest published message, if any.
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    Exactly one writer and one reader per ARDrone2_MsgTriple_t.
+**    Relies on the GCC __atomic builtins.
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**
+**=====================================================================================*/
+
+#ifndef _ARDRONE2_SNAPSHOT_H_
+#define _ARDRONE2_SNAPSHOT_H_
+
+#include "cfe.h"
+
+/*
+** Local Defines
+*/
+#define ARDRONE2_MSG_TRIPLE_FRESH      0x80000000  /* Set in middle when the reader has not taken it */
+#define ARDRONE2_MSG_TRIPLE_IDX_MASK   0x00000003
+
+/*
+** Local Structure Declarations
+*/
+typedef struct
+{
+    CFE_SB_Msg_t                *ptr;       /*!< NULL once taken by the reader */
+    CFE_SB_ZeroCopyHandle_t     handle;
+} ARDrone2_MsgSlot_t;
+
+typedef struct
+{
+    ARDrone2_MsgSlot_t  slot[3];
+    volatile uint32     middle;     /*!< Published slot, with ARDRONE2_MSG_TRIPLE_FRESH */
+    uint32              back;       /*!< Slot owned by the writer */
+    uint32              front;      /*!< Slot owned by the reader */
+} ARDrone2_MsgTriple_t;
+
+/*
+** Local Function Prototypes
+*/
+void                ARDrone2_MsgTripleInit(ARDrone2_MsgTriple_t *triple);
+ARDrone2_MsgSlot_t *ARDrone2_MsgTripleBack(ARDrone2_MsgTriple_t *triple);
+void                ARDrone2_MsgTriplePublish(ARDrone2_MsgTriple_t *triple);
+CFE_SB_Msg_t       *ARDrone2_MsgTripleTake(ARDrone2_MsgTriple_t *triple,
+                                           CFE_SB_ZeroCopyHandle_t *handle);
+void                ARDrone2_MsgTripleRelease(ARDrone2_MsgTriple_t *triple);
+
+#endif /* _ARDRONE2_SNAPSHOT_H_ */
+
+/*=======================================================================================
+** End of file ardrone2_snapshot.h
+**=====================================================================================*/
@@ -26,6 +26,8 @@
 **
 ** Functions Defined:
 **    ARDrone2_ReadTelem()
+**    ARDrone2_PublishSelect()
+**    ARDrone2_RecordNavData()
 **    ARDrone2_TlmCleanupCallback()
 **
 ** Limitations, Assumptions, External Events, and Notes:
@@ -41,6 +43,7 @@
 #include <errno.h>
 #include <string.h>
 #include <stdio.h>
+#include <time.h>
 #include <sys/socket.h>
 #include <netinet/in.h>
 
@@ -48,6 +51,7 @@
 #include "network_includes.h"
 #include "ardrone2_app.h"
 #include "ardrone2_telem.h"
+#include "ardrone2_timing.h"
 
 /* Extern variables */
 extern AppData_t  g_ARDrone2_AppData;
@@ -61,9 +65,9 @@ typedef enum
 } TelemState_t;
 
 /* Local variables */
-int8        tempBuffer[ARDRONE2_MAX_NAV_BUFFER_SIZE];
-NavData_t   *pNavData;
 uint32		navSequence;
+uint32		navUpdateCount[ARDRONE2_NAVDATA_NUM_TAGS];
+uint64		navOptRequestUsec;
 struct sockaddr_in 		addrNav;
 TelemState_t state;
 int NavSocketID;
@@ -71,6 +75,11 @@ int NavSocketID;
 /* Local functions */
 int32 ARDrone2_ReadTelem(void);
 void ARDrone2_TlmCleanupCallback(void);
+void ARDrone2_PublishSelect(NavData_Frame_t *frame);
+void ARDrone2_PublishOptions(NavData_Frame_t *frame);
+void ARDrone2_CheckNavDataOptions(NavData_Frame_t *frame);
+void ARDrone2_OpenNavDataRec(void);
+void ARDrone2_RecordNavData(NavData_Frame_t *frame, int32 len, struct msghdr *msg);
 
 /* Main function */
 void ARDrone2_TlmMain(void)
@@ -84,15 +93,10 @@ void ARDrone2_TlmMain(void)
 
 	OS_printf("ARDrone2: Telemetry task started.\n");
 
-    pNavData = (NavData_t *) &tempBuffer[0];
     navSequence = ARDRONE2_NAVDATA_SEQUENCE_DEFAULT-1;
+    memset(navUpdateCount, 0, sizeof(navUpdateCount));
     state = INITIAL;
 
-    /* Initiate NavData as stale until one is received. */
-    OS_MutSemTake(g_ARDrone2_AppData.NavDataMutexId);
-    g_ARDrone2_AppData.NavDataStale = TRUE;
-    OS_MutSemGive(g_ARDrone2_AppData.NavDataMutexId);
-
     /* Create socket */
     NavSocketID = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
     if(NavSocketID < 0)
@@ -118,6 +122,12 @@ void ARDrone2_TlmMain(void)
 		goto end_of_function;
 	}
 
+	/* Have the kernel stamp each datagram, for the recorder latency */
+	int timestampOn = 1;
+	setsockopt(NavSocketID, SOL_SOCKET, SO_TIMESTAMPNS, &timestampOn, sizeof(timestampOn));
+
+	ARDrone2_OpenNavDataRec();
+
 	OS_printf("ARDrone2: Telem Task Resetting connection.\n");
 	ARDrone2_ResetTlmConnection();
 
@@ -149,25 +159,36 @@ void ARDrone2_TlmCleanupCallback(void)
 		close(NavSocketID);
 		NavSocketID = 0;
 	}
+
+	ARDrone2_RecClose(&g_ARDrone2_AppData.NavDataRec);
+
+	ARDrone2_MsgTripleRelease(&g_ARDrone2_AppData.NavDataSelect);
 }
 
 
 int32 ARDrone2_ReadTelem(void)
 {
-    uint32 addr_len = 0;
 	int32 len = 0;
-	uint32 navdata_cks = 0;
-	uint32 cks = 0;
-	int32 size = 0;
 	int32 status = 0;
-
-	addr_len = sizeof(addrNav);
-
-    /* Receive data */
-    len = recvfrom(NavSocketID,
-                   pNavData,
-                   ARDRONE2_MAX_NAV_BUFFER_SIZE, 0, 
-                   (struct sockaddr *) &addrNav, (socklen_t*)&addr_len);
+	NavData_Frame_t *frame = &g_ARDrone2_AppData.NavDataFrame;
+	NavData_t *pNavData = &frame->navdata;
+	struct iovec iov;
+	struct msghdr msg;
+	uint64 control[8];
+
+	iov.iov_base = frame->buffer;
+	iov.iov_len  = ARDRONE2_MAX_NAV_BUFFER_SIZE;
+
+	memset(&msg, 0, sizeof(msg));
+	msg.msg_name       = &addrNav;
+	msg.msg_namelen    = sizeof(addrNav);
+	msg.msg_iov        = &iov;
+	msg.msg_iovlen     = 1;
+	msg.msg_control    = control;
+	msg.msg_controllen = sizeof(control);
+
+    /* Receive data straight into the frame */
+    len = recvmsg(NavSocketID, &msg, 0);
     if (len < 0)
 	{
     	/* IF the socket is non-zero this failure is unexpected */
@@ -181,71 +202,59 @@ int32 ARDrone2_ReadTelem(void)
     	 * so don't do anything else. */
 		goto end_of_function;
 	}
-	else
+
+	/* Recorded as received, whatever the checks below make of it */
+	ARDrone2_RecordNavData(frame, len, &msg);
+
+	if (len >= (int32) sizeof(NavData_t) - (int32) sizeof(NavData_Option_t))
 	{
 		if( pNavData->header == NAVDATA_HEADER )
 		{
 			if( ARDrone2_GetMaskFromState(pNavData->ardrone_state, ARDRONE2_NAVDATA_BOOTSTRAP) == TRUE)
 			{
 				OS_printf("ARDrone2:  Activating NavData Demo.\n");
-				ARDrone2_configATCmd("general:navdata_demo", "TRUE");
+				ARDrone2_RequestATCmd(ARDRONE2_AT_REQ_NAVDATA_DEMO);
 			}
 
 			if( ARDrone2_GetMaskFromState(pNavData->ardrone_state, ARDRONE2_COMMAND_MASK) == TRUE)
 			{
 				OS_printf("ARDRONE2_COMMAND_MASK == TRUE\n");
-				ARDrone2_cmdSetControl(ACK_CONTROL_MODE);
+				ARDrone2_RequestATCmd(ARDRONE2_AT_REQ_ACK_CONTROL);
 			}
 
-			if( pNavData->sequence > navSequence )
-			{
-                /* Lock the mutex */
-                OS_MutSemTake(g_ARDrone2_AppData.NavDataMutexId);
-                g_ARDrone2_AppData.NavDataStale = FALSE;
-                
-                memcpy(&g_ARDrone2_AppData.NavDataMsg.buffer[0],
-                       &tempBuffer[0], ARDRONE2_MAX_NAV_BUFFER_SIZE);
-
-				ARDrone2_NavDataUnpackAll(&g_ARDrone2_AppData.NavDataUnpacked, 
-                                          pNavData, &navdata_cks);
-                cks = ARDrone2_NavDataComputeCks(&g_ARDrone2_AppData.NavDataMsg.buffer[0], 
-                                                 size - sizeof(NavData_Cks_t) );
-                g_ARDrone2_AppData.lastNavDataOptions = 
-                    g_ARDrone2_AppData.NavDataUnpacked.last_navdata_refresh;
-
-                //FIXME: This is temporary.  Need a better solution.  Too many memcpy 
-                /* Send out Select message */
-                memcpy(&g_ARDrone2_AppData.NavDataSelectMsg.demo, 
-                       &g_ARDrone2_AppData.NavDataDemoMsg.payload,
-                       sizeof(g_ARDrone2_AppData.NavDataDemoMsg.payload));
-                memcpy(&g_ARDrone2_AppData.NavDataSelectMsg.time,
-                       &g_ARDrone2_AppData.NavDataUnpacked.time,
-                       sizeof(g_ARDrone2_AppData.NavDataUnpacked.time));
-                memcpy(&g_ARDrone2_AppData.NavDataSelectMsg.mag,
-                       &g_ARDrone2_AppData.NavDataUnpacked.magneto,
-                       sizeof(g_ARDrone2_AppData.NavDataUnpacked.magneto));
-
-                /* Select message is sent out in the main application source SendOutData function */
-
-                /* Unlock mutex */
-                OS_MutSemGive(g_ARDrone2_AppData.NavDataMutexId);
-                
-                //TODO: Send out individual packets based on option mask 
-
-				if( cks != navdata_cks )
-				{
-					CFE_EVS_SendEvent(TELEM_CHECKSUM_ERR_EID, CFE_EVS_ERROR,
-							"ARDrone2:  [Navdata] Checksum failed : %d (distant) / %d (local)\n",
-							(int)navdata_cks, (int)cks);
-				}
-			}
-			else
+			if( pNavData->sequence <= navSequence )
 			{
 				CFE_EVS_SendEvent(TELEM_SEQUENCE_ERR_EID, CFE_EVS_ERROR,
 						"ARDrone2:  [Navdata] Sequence pb : %d (distant) / %d (local)\n",
 						(int)pNavData->sequence, (int)navSequence);
+				navSequence = pNavData->sequence;
+			}
+			else if( ARDrone2_NavDataBuildIndex(&frame->index, pNavData, len) == FALSE )
+			{
+				/* Corrupt packets are dropped here, before anything is
+				 * copied out of them or published to the other tasks */
+				CFE_EVS_SendEvent(TELEM_CHECKSUM_ERR_EID, CFE_EVS_ERROR,
+						"ARDrone2:  [Navdata] Checksum failed : %d (distant) / %d (local)\n",
+						(int)frame->index.cks_remote, (int)frame->index.cks);
+			}
+			else
+			{
+				/* Build the select message straight from the received packet */
+				ARDrone2_PublishSelect(frame);
+
+				__atomic_store_n(&g_ARDrone2_AppData.lastNavDataOptions,
+				                 frame->index.present, __ATOMIC_RELAXED);
+
+				/* Hand over the select message, getting back either the one
+				 * ARDrone2_SendOutData already sent or one it never took */
+				ARDrone2_MsgTriplePublish(&g_ARDrone2_AppData.NavDataSelect);
+
+				/* The subscribed options go out right away, each in its own message */
+				ARDrone2_PublishOptions(frame);
+				ARDrone2_CheckNavDataOptions(frame);
+
+				navSequence = pNavData->sequence;
 			}
-			navSequence = pNavData->sequence;
 		}
 	}
 
@@ -255,6 +264,241 @@ end_of_function:
 }
 
 
+/*!
+ * @brief  Open the flight recorder file, or leave the recorder closed
+ * @note   Failing to open it is reported but does not stop telemetry.
+ * @return Void.
+ */
+void ARDrone2_OpenNavDataRec(void)
+{
+	char localPath[OS_MAX_LOCAL_PATH_LEN];
+
+	if (ARDRONE2_NAVDATA_REC_SIZE == 0)
+	{
+		return;
+	}
+
+	if (OS_TranslatePath(ARDRONE2_NAVDATA_REC_FILE, localPath) != OS_FS_SUCCESS ||
+		ARDrone2_RecOpen(&g_ARDrone2_AppData.NavDataRec, localPath,
+		                 ARDRONE2_NAVDATA_REC_SIZE) != 0)
+	{
+		CFE_EVS_SendEvent(ARDRONE2_INIT_ERR_EID, CFE_EVS_ERROR,
+		                  "ARDrone2: Navdata recorder %s not opened.  errno: %d",
+		                  ARDRONE2_NAVDATA_REC_FILE, errno);
+		return;
+	}
+
+	CFE_EVS_SendEvent(INIT_INF_EID, CFE_EVS_INFORMATION,
+	                  "ARDrone2: Navdata recorder %s, %u records kept",
+	                  ARDRONE2_NAVDATA_REC_FILE,
+	                  (unsigned int)g_ARDrone2_AppData.NavDataRec.hdr->count);
+}
+
+
+/*!
+ * @brief  Append a received datagram to the flight recorder
+ * @note   The latency is from the kernel timestamp of the datagram to now,
+ *         so it covers the time the datagram waited on the socket.
+ * @return Void.
+ */
+void ARDrone2_RecordNavData(NavData_Frame_t *frame, int32 len, struct msghdr *msg)
+{
+	struct cmsghdr *cmsg;
+	struct timespec now;
+	struct timespec rcvd;
+	CFE_TIME_SysTime_t time;
+	uint32 latency = 0;
+
+	if (__atomic_load_n(&g_ARDrone2_AppData.NavDataRecording, __ATOMIC_RELAXED) == FALSE ||
+		g_ARDrone2_AppData.NavDataRec.hdr == NULL)
+	{
+		return;
+	}
+
+	for (cmsg = CMSG_FIRSTHDR(msg); cmsg != NULL; cmsg = CMSG_NXTHDR(msg, cmsg))
+	{
+		if (cmsg->cmsg_level == SOL_SOCKET && cmsg->cmsg_type == SCM_TIMESTAMPNS)
+		{
+			memcpy(&rcvd, CMSG_DATA(cmsg), sizeof(rcvd));
+			clock_gettime(CLOCK_REALTIME, &now);
+			int64 usec = ((int64)now.tv_sec - rcvd.tv_sec) * 1000000 +
+			             (now.tv_nsec - rcvd.tv_nsec) / 1000;
+			latency = (usec > 0) ? (uint32)usec : 0;
+			break;
+		}
+	}
+
+	time = CFE_TIME_GetTime();
+	ARDrone2_RecAppend(&g_ARDrone2_AppData.NavDataRec, frame->buffer, (uint32)len,
+	                   time.Seconds, time.Subseconds, latency);
+}
+
+
+/*!
+ * @brief  Copy an option of a received packet into the select message
+ * @note   Like the demo option, the payload is copied by size: only the bytes
+ *         after the header, zero filled if the option is missing or short,
+ *         since the slot may hold an earlier packet.
+ * @return Void.
+ */
+static void ARDrone2_PublishSelectOption(uint8 *dest, uint32 dest_size, NavData_Option_t *option)
+{
+	uint32 dstSize = dest_size - sizeof(NavDataHeader_t);
+	uint32 srcSize = 0;
+
+	if (option != NULL)
+	{
+		srcSize = option->size - sizeof(NavData_Option_t);
+		if (srcSize > dstSize)
+		{
+			srcSize = dstSize;
+		}
+		memcpy(dest + sizeof(NavDataHeader_t), &option->data[0], srcSize);
+	}
+
+	memset(dest + sizeof(NavDataHeader_t) + srcSize, 0, dstSize - srcSize);
+}
+
+
+/*!
+ * @brief  Fill the select message from a received packet
+ * @note   The message is written directly in the SB zero copy buffer of the
+ *         back slot of NavDataSelect, so each option is copied once, from the
+ *         packet to the message that goes on the bus.
+ * @return Void.
+ */
+void ARDrone2_PublishSelect(NavData_Frame_t *frame)
+{
+	ARDrone2_MsgSlot_t *slot = ARDrone2_MsgTripleBack(&g_ARDrone2_AppData.NavDataSelect);
+	ARDrone2_NavData_Select_Msg_t *pSelectWork;
+	NavData_Option_t *option;
+	uint32 dstSize = sizeof(pSelectWork->demo);
+	uint32 srcSize = 0;
+	uint32 tag;
+
+	for (tag = 0; tag < ARDRONE2_NAVDATA_NUM_TAGS; tag++)
+	{
+		if (frame->index.present & (1 << tag))
+		{
+			navUpdateCount[tag]++;
+		}
+	}
+
+	if (slot->ptr == NULL)
+	{
+		slot->ptr = CFE_SB_ZeroCopyGetPtr(sizeof(ARDrone2_NavData_Select_Msg_t), &slot->handle);
+		if (slot->ptr == NULL)
+		{
+			return;
+		}
+
+		CFE_SB_InitMsg(slot->ptr, ARDRONE2_NAVDATA_SELECT_MID,
+				sizeof(ARDrone2_NavData_Select_Msg_t), TRUE);
+	}
+
+	pSelectWork = (ARDrone2_NavData_Select_Msg_t *) slot->ptr;
+
+	option = ARDrone2_NavDataGetOption(&frame->index, &frame->navdata, ARDRONE2_NAVDATA_DEMO_TAG);
+	if (option != NULL)
+	{
+		srcSize = option->size - sizeof(NavData_Option_t);
+		if (srcSize > dstSize)
+		{
+			srcSize = dstSize;
+		}
+		memcpy(&pSelectWork->demo, &option->data[0], srcSize);
+	}
+
+	/* The slot held an earlier packet, so clear what this one did not fill */
+	memset((uint8 *) &pSelectWork->demo + srcSize, 0, dstSize - srcSize);
+
+	/* The options are copied past their headers, which are packed */
+	option = ARDrone2_NavDataGetOption(&frame->index, &frame->navdata, ARDRONE2_NAVDATA_TIME_TAG);
+	ARDrone2_PublishSelectOption((uint8 *) &pSelectWork->time, sizeof(pSelectWork->time), option);
+	pSelectWork->time.header.update_count = navUpdateCount[ARDRONE2_NAVDATA_TIME_TAG];
+
+	option = ARDrone2_NavDataGetOption(&frame->index, &frame->navdata, ARDRONE2_NAVDATA_MAGNETO_TAG);
+	ARDrone2_PublishSelectOption((uint8 *) &pSelectWork->mag, sizeof(pSelectWork->mag), option);
+	pSelectWork->mag.header.update_count = navUpdateCount[ARDRONE2_NAVDATA_MAGNETO_TAG];
+}
+
+
+
+/*!
+ * @brief  Send the subscribed options of a received packet, one message each
+ * @note   Each option is copied once, from the packet into an SB zero copy
+ *         buffer.  See ARDrone2_NavData_Opt_Msg_t.
+ * @return Void.
+ */
+void ARDrone2_PublishOptions(NavData_Frame_t *frame)
+{
+	ARDrone2_NavData_Opt_Msg_t *pOptMsg;
+	CFE_SB_ZeroCopyHandle_t handle;
+	uint32 publish;
+	uint32 size;
+	uint32 tag;
+
+	publish = frame->index.present &
+	          __atomic_load_n(&g_ARDrone2_AppData.NavDataOptSubscribed, __ATOMIC_RELAXED);
+
+	for (tag = 0; publish != 0; tag++, publish >>= 1)
+	{
+		size = ARDrone2_NavDataOptionSize(tag);
+		if ((publish & 1) == 0 || size == 0)
+		{
+			continue;
+		}
+
+		pOptMsg = (ARDrone2_NavData_Opt_Msg_t *)
+			CFE_SB_ZeroCopyGetPtr(sizeof(CFE_SB_TlmHdr_t) + size, &handle);
+		if (pOptMsg == NULL)
+		{
+			return;
+		}
+
+		CFE_SB_InitMsg(pOptMsg, ARDRONE2_NAVDATA_OPT_MID(tag),
+				sizeof(CFE_SB_TlmHdr_t) + size, FALSE);
+
+		ARDrone2_NavDataCopyOption(&pOptMsg->header, size,
+				ARDrone2_NavDataGetOption(&frame->index, &frame->navdata, tag));
+		pOptMsg->header.update_count   = navUpdateCount[tag];
+		pOptMsg->header.previous_count = navUpdateCount[tag] - 1;
+
+		CFE_SB_TimeStampMsg((CFE_SB_Msg_t *) pOptMsg);
+		if (CFE_SB_ZeroCopySend((CFE_SB_Msg_t *) pOptMsg, handle) != CFE_SUCCESS)
+		{
+			CFE_EVS_SendEvent(MSG_SEND_ERR_EID, CFE_EVS_ERROR,
+					"ARDrone2: Failed to send navdata option %u", (unsigned int) tag);
+		}
+	}
+}
+
+
+/*!
+ * @brief  Ask the drone again for options it does not send
+ * @note   At most every ARDRONE2_NAVDATA_OPT_RETRY_MSEC, since the drone may
+ *         not support every option.
+ * @return Void.
+ */
+void ARDrone2_CheckNavDataOptions(NavData_Frame_t *frame)
+{
+	uint32 wanted;
+	uint64 now;
+
+	wanted = __atomic_load_n(&g_ARDrone2_AppData.NavDataOptWanted, __ATOMIC_RELAXED);
+	if ((frame->index.present & wanted) == wanted)
+	{
+		return;
+	}
+
+	now = ARDrone2_TimeNowUsec();
+	if (now - navOptRequestUsec >= (uint64) ARDRONE2_NAVDATA_OPT_RETRY_MSEC * 1000)
+	{
+		navOptRequestUsec = now;
+		ARDrone2_RequestATCmd(ARDRONE2_AT_REQ_NAVDATA_OPTIONS);
+	}
+}
+
 
 void ARDrone2_ResetTlmConnection(void)
 {
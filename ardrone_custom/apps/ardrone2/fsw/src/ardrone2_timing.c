@@ -0,0 +1,98 @@
+/*=======================================================================================
+** File Name:  ardrone2_timing.c
+**
+** Title:  Function Definitions for ARDRONE2 timing
+**
+** Purpose:  Monotonic clock and periodic deadlines.
+**
+** Functions Defined:
+**    ARDrone2_TimeNowUsec()
+**    ARDrone2_TimeMsecUntil()
+**    ARDrone2_PeriodInit()
+**    ARDrone2_PeriodPoll()
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    See ardrone2_timing.h
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**
+**=====================================================================================*/
+
+/*
+** Include Files
+*/
+#include <time.h>
+
+#include "ardrone2_timing.h"
+
+
+/*!
+ * @return Microseconds of CLOCK_MONOTONIC, since an arbitrary point
+ */
+uint64 ARDrone2_TimeNowUsec(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return (uint64) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+
+/*!
+ * @brief  Milliseconds left until deadline, for APIs that take a timeout
+ * @return Rounded up, so waiting that long never wakes up early.  0 if the
+ *         deadline has passed.
+ */
+int32 ARDrone2_TimeMsecUntil(uint64 deadline, uint64 now)
+{
+    if (deadline <= now)
+    {
+        return 0;
+    }
+
+    return (int32) ((deadline - now + 999) / 1000);
+}
+
+
+void ARDrone2_PeriodInit(ARDrone2_Period_t *period, uint64 periodUsec, uint64 now)
+{
+    period->periodUsec = periodUsec;
+    period->nextUsec   = now + periodUsec;
+}
+
+
+/*!
+ * @brief  Check whether the period expired, and if so move to the next one
+ * @return 0 if the period has not expired yet, 1 if it has, or the number of
+ *         periods that went by if more than one was missed.  Missed periods
+ *         are not made up: the next one starts from now.
+ */
+uint32 ARDrone2_PeriodPoll(ARDrone2_Period_t *period, uint64 now)
+{
+    uint32 elapsed;
+
+    if (now < period->nextUsec)
+    {
+        return 0;
+    }
+
+    elapsed = (uint32) ((now - period->nextUsec) / period->periodUsec) + 1;
+
+    if (elapsed == 1)
+    {
+        period->nextUsec += period->periodUsec;
+    }
+    else
+    {
+        period->nextUsec = now + period->periodUsec;
+    }
+
+    return elapsed;
+}
+
+/*=======================================================================================
+** End of file ardrone2_timing.c
+**=====================================================================================*/
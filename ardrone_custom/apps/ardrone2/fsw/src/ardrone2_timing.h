@@ -0,0 +1,51 @@
+/*=======================================================================================
+** File Name:  ardrone2_timing.h
+**
+** Title:  Header File for ARDRONE2 timing
+**
+**
+** Purpose:  Monotonic clock and periodic deadlines for the ARDrone2 tasks.
+**
+**           All times are microseconds of CLOCK_MONOTONIC, so they are wall
+**           time that is never stepped by time corrections.  Deadlines are
+**           absolute so a late wake-up does not push back the following ones.
+**           Tasks wait for them by pending with ARDrone2_TimeMsecUntil as the
+**           timeout, instead of spinning.
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    An ARDrone2_Period_t is owned by a single task.
+**
+** Modification History:
+**   Date | Author | Description
+**   ---------------------------
+**
+**=====================================================================================*/
+
+#ifndef _ARDRONE2_TIMING_H_
+#define _ARDRONE2_TIMING_H_
+
+#include "common_types.h"
+
+/*
+** Local Structure Declarations
+*/
+typedef struct
+{
+    uint64      nextUsec;       /*!< Absolute time the period next expires */
+    uint64      periodUsec;
+} ARDrone2_Period_t;
+
+/*
+** Local Function Prototypes
+*/
+uint64  ARDrone2_TimeNowUsec(void);
+int32   ARDrone2_TimeMsecUntil(uint64 deadline, uint64 now);
+
+void    ARDrone2_PeriodInit(ARDrone2_Period_t *period, uint64 periodUsec, uint64 now);
+uint32  ARDrone2_PeriodPoll(ARDrone2_Period_t *period, uint64 now);
+
+#endif /* _ARDRONE2_TIMING_H_ */
+
+/*=======================================================================================
+** End of file ardrone2_timing.h
+**=====================================================================================*/
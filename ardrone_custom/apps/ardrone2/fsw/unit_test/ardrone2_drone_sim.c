@@ -0,0 +1,652 @@
+/*=======================================================================================
+** File Name:  ardrone2_drone_sim.c
+**
+** Title:  ARDrone2 stand-in for the navdata and AT command ports
+**
+** Purpose:  Answer the ARDrone2 app in place of the drone, so the whole navdata and
+**           AT command path can be run and measured on a workstation, and loaded
+**           well past what the drone sends.
+**
+**           - A datagram on the navdata port, such as the reset message sent by
+**             ARDrone2_ResetTlmConnection, makes its sender the navdata client.
+**           - Navdata goes to the client at a fixed rate.  Like the drone, it starts
+**             in bootstrap mode with no options, switches to the demo option on
+**             general:navdata_demo TRUE, and sends the options selected by
+**             general:navdata_options.  -o forces a set of options instead.
+**           - AT commands are parsed.  Sequence numbers that are skipped count as
+**             lost, ones that go back count as out of order.
+**           - AT*CONFIG raises the command mask in the navdata state, and
+**             AT*CTRL=<seq>,5 clears it, as on the drone.  The time between the
+**             two is the command round trip latency.  -k raises the mask
+**             periodically, to measure that latency steadily under load.
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    The option payloads are zeroed, so the unpacked telemetry is all zero.
+**    Options that do not fit in ARDRONE2_MAX_NAV_BUFFER_SIZE are left out, as
+**    the app could not receive them.
+**
+**    ARDRONE2_WIFI_IP is the loopback address on linux builds, so the app talks
+**    to this process when both run on the same machine.
+**
+**    Usage:  ardrone2_drone_sim.bin [-r rate_hz] [-o option_mask] [-k probe_msec]
+**                                   [-t seconds] [-i report_sec]
+**            -r   navdata packets per second, 15 for demo mode, 200 for full
+**                 navdata on the drone, anything higher to load the app
+**            -o   send these options (bit per tag) whatever the app configures
+**            -k   raise the command mask this often, 0 (the default) never
+**            -t   run this long, 0 (the default) until interrupted
+**            -i   print statistics this often, 1 second by default
+**
+**=====================================================================================*/
+
+#include <errno.h>
+#include <poll.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+#include <time.h>
+#include <unistd.h>
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+#include "ardrone2_app.h"
+#include "ardrone2_navdata.h"
+
+#define SIM_DEFAULT_RATE_HZ     200
+#define SIM_AT_BUFFER_SIZE      4096
+#define SIM_ALL_OPTIONS         ((1U << ARDRONE2_NAVDATA_NUM_TAGS) - 1)
+
+typedef struct
+{
+	uint32 count;
+	uint64 sumUsec;
+	uint64 minUsec;
+	uint64 maxUsec;
+} SimLatency_t;
+
+typedef struct
+{
+	/* Navdata, written by the streaming thread */
+	uint32 navSent;
+	uint64 navBytes;
+	uint32 navSendErrors;
+	uint32 navLate;             /* Periods missed because the thread ran late */
+
+	/* AT commands, written by the main thread */
+	uint32 atDatagrams;
+	uint32 atCommands;
+	uint32 atLost;
+	uint32 atOutOfOrder;
+	uint32 atBad;
+} SimStats_t;
+
+/* Normally defined by ardrone2_app.c, needed by ardrone2_navdata.c */
+AppData_t g_ARDrone2_AppData;
+
+static volatile int        SimRunning = 1;
+static int                 NavSocket;
+static int                 AtSocket;
+
+/* Shared between the threads through atomics */
+static struct sockaddr_in  NavClient;
+static volatile uint32     NavClientSet;
+static volatile uint32     NavState;
+static volatile uint32     NavOptions;
+static uint32              ForcedOptions;
+static boolean             OptionsForced;
+
+static uint32              RateHz = SIM_DEFAULT_RATE_HZ;
+static SimStats_t          Stats;
+
+/* Main thread only */
+static uint64              AckRaisedUsec;
+static SimLatency_t        AckTotal;
+static SimLatency_t        AckInterval;
+static uint64              GapTotalUsec;        /* Longest time without an AT datagram */
+static uint64              GapIntervalUsec;
+static int32               AtLastSeq;
+static uint64              AtLastUsec;
+
+
+static uint64 SimNowUsec(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return (uint64) ts.tv_sec * 1000000 + ts.tv_nsec / 1000;
+}
+
+
+static void SimStop(int sig)
+{
+	(void) sig;
+	SimRunning = 0;
+}
+
+
+/* Size each option has on the wire */
+static uint32 SimOptionSize(uint32 tag)
+{
+	if( tag == ARDRONE2_NAVDATA_DEMO_TAG )
+	{
+		return sizeof(ARDrone2_NavData_Demo_t) + sizeof(NavData_Option_t);
+	}
+
+	return ARDrone2_NavDataOptionSize(tag) - sizeof(NavDataHeader_t) + sizeof(NavData_Option_t);
+}
+
+
+/* Lay out a packet with the options in mask that fit, returns its length */
+static int32 SimBuildPacket(uint8* buffer, uint32 state, uint32 sequence, uint32 mask)
+{
+	NavData_t*        navdata = (NavData_t*) buffer;
+	NavData_Option_t* option;
+	uint32 offset;
+	uint32 cks;
+	uint32 tag;
+
+	navdata->header         = NAVDATA_HEADER;
+	navdata->ardrone_state  = state;
+	navdata->sequence       = sequence;
+	navdata->vision_defined = 0;
+
+	offset = (uint32) ((uint8*) &navdata->options[0] - buffer);
+
+	for( tag = 0; tag < ARDRONE2_NAVDATA_NUM_TAGS && (state & ARDRONE2_NAVDATA_BOOTSTRAP) == 0; tag++ )
+	{
+		uint32 size = SimOptionSize(tag);
+
+		if( (mask & (1U << tag)) == 0 ||
+		    offset + size + sizeof(NavData_Option_t) + sizeof(cks) > ARDRONE2_MAX_NAV_BUFFER_SIZE )
+		{
+			continue;
+		}
+
+		option = (NavData_Option_t*) &buffer[offset];
+		option->tag  = tag;
+		option->size = size;
+		memset(&option->data[0], 0, size - sizeof(NavData_Option_t));
+
+		offset += size;
+	}
+
+	cks = ARDrone2_NavDataComputeCks(buffer, offset);
+
+	option = (NavData_Option_t*) &buffer[offset];
+	option->tag  = ARDRONE2_NAVDATA_CKS_TAG;
+	option->size = sizeof(NavData_Option_t) + sizeof(cks);
+	memcpy(&option->data[0], &cks, sizeof(cks));
+
+	return offset + option->size;
+}
+
+
+/* Send navdata to the client every period, on absolute deadlines */
+static void* SimNavThread(void* arg)
+{
+	static uint8 buffer[ARDRONE2_MAX_NAV_BUFFER_SIZE];
+	struct timespec ts;
+	uint64 period = 1000000000ULL / RateHz;
+	uint64 next;
+	uint64 now;
+	uint32 sequence = 0;
+	int32  length;
+
+	(void) arg;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+	next = (uint64) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+
+	while( SimRunning )
+	{
+		next += period;
+		ts.tv_sec  = next / 1000000000ULL;
+		ts.tv_nsec = next % 1000000000ULL;
+		while( clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL) == EINTR && SimRunning )
+		{
+		}
+
+		/* Do not send a burst to catch up after a stall */
+		clock_gettime(CLOCK_MONOTONIC, &ts);
+		now = (uint64) ts.tv_sec * 1000000000ULL + ts.tv_nsec;
+		if( now > next + period )
+		{
+			__atomic_add_fetch(&Stats.navLate, (now - next) / period, __ATOMIC_RELAXED);
+			next = now;
+		}
+
+		if( __atomic_load_n(&NavClientSet, __ATOMIC_ACQUIRE) == 0 )
+		{
+			continue;
+		}
+
+		length = SimBuildPacket(buffer,
+		                        __atomic_load_n(&NavState, __ATOMIC_RELAXED),
+		                        ++sequence,
+		                        OptionsForced ? ForcedOptions :
+		                                        __atomic_load_n(&NavOptions, __ATOMIC_RELAXED));
+
+		if( sendto(NavSocket, buffer, length, 0,
+		           (struct sockaddr*) &NavClient, sizeof(NavClient)) < 0 )
+		{
+			__atomic_add_fetch(&Stats.navSendErrors, 1, __ATOMIC_RELAXED);
+			continue;
+		}
+
+		__atomic_add_fetch(&Stats.navSent, 1, __ATOMIC_RELAXED);
+		__atomic_add_fetch(&Stats.navBytes, length, __ATOMIC_RELAXED);
+	}
+
+	return NULL;
+}
+
+
+/* Raise the command mask and start timing the acknowledge */
+static void SimRaiseCommandMask(uint64 now)
+{
+	if( (__atomic_fetch_or(&NavState, ARDRONE2_COMMAND_MASK, __ATOMIC_RELAXED) &
+	     ARDRONE2_COMMAND_MASK) == 0 )
+	{
+		AckRaisedUsec = now;
+	}
+}
+
+
+static void SimLatencyAdd(SimLatency_t* lat, uint64 usec)
+{
+	if( lat->count == 0 || usec < lat->minUsec )
+	{
+		lat->minUsec = usec;
+	}
+	if( usec > lat->maxUsec )
+	{
+		lat->maxUsec = usec;
+	}
+	lat->sumUsec += usec;
+	lat->count++;
+}
+
+
+static void SimAckCommandMask(uint64 now)
+{
+	if( (__atomic_fetch_and(&NavState, ~(uint32) ARDRONE2_COMMAND_MASK, __ATOMIC_RELAXED) &
+	     ARDRONE2_COMMAND_MASK) == 0 )
+	{
+		return;
+	}
+
+	SimLatencyAdd(&AckTotal, now - AckRaisedUsec);
+	SimLatencyAdd(&AckInterval, now - AckRaisedUsec);
+}
+
+
+/* Act on AT*CONFIG="<key>","<value>" the way the drone does */
+static void SimConfig(const char* key, const char* value, uint64 now)
+{
+	if( strcasecmp(key, "general:navdata_demo") == 0 )
+	{
+		uint32 state = __atomic_load_n(&NavState, __ATOMIC_RELAXED);
+
+		state &= ~(uint32) ARDRONE2_NAVDATA_BOOTSTRAP;
+		if( strcmp(value, "TRUE") == 0 )
+		{
+			state |= ARDRONE2_NAVDATA_DEMO_MASK;
+			__atomic_store_n(&NavOptions, 1U << ARDRONE2_NAVDATA_DEMO_TAG, __ATOMIC_RELAXED);
+		}
+		else
+		{
+			state &= ~(uint32) ARDRONE2_NAVDATA_DEMO_MASK;
+			__atomic_store_n(&NavOptions, SIM_ALL_OPTIONS, __ATOMIC_RELAXED);
+		}
+		__atomic_store_n(&NavState, state, __ATOMIC_RELAXED);
+	}
+	else if( strcasecmp(key, "general:navdata_options") == 0 )
+	{
+		__atomic_store_n(&NavOptions, (uint32) strtoul(value, NULL, 0), __ATOMIC_RELAXED);
+	}
+
+	SimRaiseCommandMask(now);
+}
+
+
+/* Copy the next quoted argument of an AT command, returns where parsing goes on */
+static const char* SimQuoted(const char* p, char* out, uint32 size)
+{
+	uint32 n = 0;
+
+	p = strchr(p, '"');
+	if( p == NULL )
+	{
+		out[0] = '\0';
+		return NULL;
+	}
+
+	for( p++; *p != '\0' && *p != '"'; p++ )
+	{
+		if( n + 1 < size )
+		{
+			out[n++] = *p;
+		}
+	}
+	out[n] = '\0';
+
+	return (*p == '"') ? p + 1 : NULL;
+}
+
+
+/* One AT command, without its trailing carriage return */
+static void SimParseCommand(char* cmd, uint64 now)
+{
+	char   key[64];
+	char   value[64];
+	char*  name;
+	char*  args;
+	char*  end;
+	int32  seq;
+
+	if( strncmp(cmd, "AT*", 3) != 0 || (args = strchr(cmd, '=')) == NULL )
+	{
+		Stats.atBad++;
+		return;
+	}
+
+	name  = cmd + 3;
+	*args = '\0';
+	args++;
+
+	seq = (int32) strtol(args, &end, 10);
+	if( end == args )
+	{
+		Stats.atBad++;
+		return;
+	}
+
+	/* The app starts over from 1 when it resets its sequence */
+	if( seq == 1 || AtLastSeq == 0 || seq == AtLastSeq + 1 )
+	{
+		AtLastSeq = seq;
+	}
+	else if( seq > AtLastSeq )
+	{
+		Stats.atLost += seq - AtLastSeq - 1;
+		AtLastSeq = seq;
+	}
+	else
+	{
+		Stats.atOutOfOrder++;
+	}
+
+	Stats.atCommands++;
+
+	if( strcmp(name, "CONFIG") == 0 )
+	{
+		const char* p = SimQuoted(end, key, sizeof(key));
+
+		if( p != NULL && SimQuoted(p, value, sizeof(value)) != NULL )
+		{
+			SimConfig(key, value, now);
+		}
+	}
+	else if( strcmp(name, "CTRL") == 0 && *end == ',' &&
+	         strtol(end + 1, NULL, 10) == ACK_CONTROL_MODE )
+	{
+		SimAckCommandMask(now);
+	}
+}
+
+
+static void SimReceiveAT(void)
+{
+	char   buffer[SIM_AT_BUFFER_SIZE + 1];
+	char*  cmd;
+	char*  cr;
+	uint64 now;
+	ssize_t len;
+
+	len = recv(AtSocket, buffer, SIM_AT_BUFFER_SIZE, MSG_DONTWAIT);
+	if( len <= 0 )
+	{
+		return;
+	}
+
+	now = SimNowUsec();
+	buffer[len] = '\0';
+
+	if( AtLastUsec != 0 && now - AtLastUsec > GapTotalUsec )
+	{
+		GapTotalUsec = now - AtLastUsec;
+	}
+	if( AtLastUsec != 0 && now - AtLastUsec > GapIntervalUsec )
+	{
+		GapIntervalUsec = now - AtLastUsec;
+	}
+	AtLastUsec = now;
+	Stats.atDatagrams++;
+
+	/* A datagram carries one or more commands, each ended by \r */
+	for( cmd = buffer; *cmd != '\0'; cmd = cr + 1 )
+	{
+		cr = strchr(cmd, '\r');
+		if( cr == NULL )
+		{
+			Stats.atBad++;
+			break;
+		}
+
+		*cr = '\0';
+		SimParseCommand(cmd, now);
+	}
+}
+
+
+/* Any datagram on the navdata port (re)starts the stream to its sender */
+static void SimReceiveNav(void)
+{
+	struct sockaddr_in from;
+	socklen_t fromLen = sizeof(from);
+	char buffer[64];
+
+	if( recvfrom(NavSocket, buffer, sizeof(buffer), MSG_DONTWAIT,
+	             (struct sockaddr*) &from, &fromLen) < 0 )
+	{
+		return;
+	}
+
+	if( __atomic_load_n(&NavClientSet, __ATOMIC_ACQUIRE) == 0 )
+	{
+		NavClient = from;
+		__atomic_store_n(&NavClientSet, 1, __ATOMIC_RELEASE);
+		printf("navdata client %s:%u\n", inet_ntoa(from.sin_addr), ntohs(from.sin_port));
+	}
+}
+
+
+/* Rates since last, and the extremes of the interval or of the whole run */
+static void SimReport(SimStats_t* last, double seconds, boolean total)
+{
+	SimStats_t now;
+	SimLatency_t* ack = total ? &AckTotal : &AckInterval;
+
+	now = Stats;
+	now.navSent       = __atomic_load_n(&Stats.navSent, __ATOMIC_RELAXED);
+	now.navBytes      = __atomic_load_n(&Stats.navBytes, __ATOMIC_RELAXED);
+	now.navSendErrors = __atomic_load_n(&Stats.navSendErrors, __ATOMIC_RELAXED);
+	now.navLate       = __atomic_load_n(&Stats.navLate, __ATOMIC_RELAXED);
+
+	printf("%s nav %7.0f pkt/s %7.2f MB/s late %u err %u | "
+	       "AT %6.0f dgram/s %6.0f cmd/s lost %u ooo %u bad %u gap %.1f ms | "
+	       "ack %u avg %.2f min %.2f max %.2f ms\n",
+	       total ? "total" : "     ",
+	       (now.navSent - last->navSent) / seconds,
+	       (now.navBytes - last->navBytes) / seconds / 1e6,
+	       now.navLate - last->navLate,
+	       now.navSendErrors - last->navSendErrors,
+	       (now.atDatagrams - last->atDatagrams) / seconds,
+	       (now.atCommands - last->atCommands) / seconds,
+	       now.atLost - last->atLost,
+	       now.atOutOfOrder - last->atOutOfOrder,
+	       now.atBad - last->atBad,
+	       (total ? GapTotalUsec : GapIntervalUsec) / 1e3,
+	       ack->count,
+	       (ack->count > 0) ? ack->sumUsec / 1e3 / ack->count : 0.0,
+	       ack->minUsec / 1e3, ack->maxUsec / 1e3);
+	fflush(stdout);
+
+	if( total == FALSE )
+	{
+		*last = now;
+		memset(&AckInterval, 0, sizeof(AckInterval));
+		GapIntervalUsec = 0;
+	}
+}
+
+
+static int SimBind(uint16 port)
+{
+	struct sockaddr_in addr;
+	int fd;
+
+	fd = socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+	if( fd < 0 )
+	{
+		return -1;
+	}
+
+	memset(&addr, 0, sizeof(addr));
+	addr.sin_family      = AF_INET;
+	addr.sin_port        = htons(port);
+	addr.sin_addr.s_addr = inet_addr(ARDRONE2_WIFI_IP);
+
+	if( bind(fd, (struct sockaddr*) &addr, sizeof(addr)) < 0 )
+	{
+		close(fd);
+		return -1;
+	}
+
+	return fd;
+}
+
+
+int main(int argc, char* argv[])
+{
+	struct pollfd fds[2];
+	pthread_t navThread;
+	SimStats_t first;
+	SimStats_t last;
+	uint64 start;
+	uint64 now;
+	uint64 nextReport;
+	uint64 nextProbe;
+	uint32 probeMsec = 0;
+	uint32 runSec = 0;
+	uint32 reportSec = 1;
+	int opt;
+
+	while( (opt = getopt(argc, argv, "r:o:k:t:i:")) != -1 )
+	{
+		switch( opt )
+		{
+			case 'r': RateHz        = strtoul(optarg, NULL, 0); break;
+			case 'o': ForcedOptions = strtoul(optarg, NULL, 0);
+			          OptionsForced = TRUE;                     break;
+			case 'k': probeMsec     = strtoul(optarg, NULL, 0); break;
+			case 't': runSec        = strtoul(optarg, NULL, 0); break;
+			case 'i': reportSec     = strtoul(optarg, NULL, 0); break;
+			default:
+				fprintf(stderr, "Usage: %s [-r rate_hz] [-o option_mask] [-k probe_msec] "
+				        "[-t seconds] [-i report_sec]\n", argv[0]);
+				return 1;
+		}
+	}
+
+	if( RateHz == 0 || reportSec == 0 )
+	{
+		fprintf(stderr, "rate and report period must not be 0\n");
+		return 1;
+	}
+
+	NavSocket = SimBind(ARDRONE2_NAV_DATA_PORT);
+	AtSocket  = SimBind(ARDRONE2_AT_PORT);
+	if( NavSocket < 0 || AtSocket < 0 )
+	{
+		fprintf(stderr, "cannot bind %s:%u and %u: %s\n", ARDRONE2_WIFI_IP,
+		        ARDRONE2_NAV_DATA_PORT, ARDRONE2_AT_PORT, strerror(errno));
+		return 1;
+	}
+
+	signal(SIGINT, SimStop);
+	signal(SIGTERM, SimStop);
+
+	NavState   = ARDRONE2_NAVDATA_BOOTSTRAP;
+	NavOptions = 0;
+
+	printf("drone sim on %s, navdata %u Hz%s, waiting for the app\n",
+	       ARDRONE2_WIFI_IP, RateHz, OptionsForced ? ", options forced" : "");
+
+	if( pthread_create(&navThread, NULL, SimNavThread, NULL) != 0 )
+	{
+		fprintf(stderr, "cannot start the navdata thread\n");
+		return 1;
+	}
+
+	memset(&first, 0, sizeof(first));
+	memset(&last, 0, sizeof(last));
+
+	fds[0].fd     = NavSocket;
+	fds[0].events = POLLIN;
+	fds[1].fd     = AtSocket;
+	fds[1].events = POLLIN;
+
+	start      = SimNowUsec();
+	nextReport = start + (uint64) reportSec * 1000000;
+	nextProbe  = start + (uint64) probeMsec * 1000;
+
+	while( SimRunning )
+	{
+		if( poll(fds, 2, 10) > 0 )
+		{
+			if( fds[0].revents & POLLIN )
+			{
+				SimReceiveNav();
+			}
+			if( fds[1].revents & POLLIN )
+			{
+				SimReceiveAT();
+			}
+		}
+
+		now = SimNowUsec();
+
+		if( probeMsec != 0 && now >= nextProbe &&
+		    __atomic_load_n(&NavClientSet, __ATOMIC_RELAXED) != 0 )
+		{
+			SimRaiseCommandMask(now);
+			nextProbe = now + (uint64) probeMsec * 1000;
+		}
+
+		if( now >= nextReport )
+		{
+			SimReport(&last, (now - nextReport) / 1e6 + reportSec, FALSE);
+			nextReport = now + (uint64) reportSec * 1000000;
+		}
+
+		if( runSec != 0 && now - start >= (uint64) runSec * 1000000 )
+		{
+			SimRunning = 0;
+		}
+	}
+
+	pthread_join(navThread, NULL);
+
+	SimReport(&first, (SimNowUsec() - start) / 1e6, TRUE);
+
+	close(NavSocket);
+	close(AtSocket);
+
+	return 0;
+}
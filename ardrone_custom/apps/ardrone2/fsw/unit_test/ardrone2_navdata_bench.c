@@ -0,0 +1,233 @@
+/*=======================================================================================
+** File Name:  ardrone2_navdata_bench.c
+**
+** Title:  NavData decoder micro benchmark
+**
+** Purpose:  Measure how many navdata packets per second ARDrone2_NavDataBuildIndex and
+**           ARDrone2_NavDataUnpackAll can decode, for a demo only packet (what the
+**           drone sends with general:navdata_demo set) and for a packet carrying
+**           every option.  Also compares the scalar and vector checksum kernels on
+**           500 byte and 4 KB frames.
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    The packets are built here with the same layout as the ones captured from
+**    the drone: header, state, sequence, vision flag, options, then checksum.
+**    Each option carries as many bytes as its unpacked structure holds, up to
+**    ARDRONE2_MAX_NAV_BUFFER_SIZE.
+**
+**    Usage:  ardrone2_navdata_bench.bin [iterations]
+**
+**=====================================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ardrone2_app.h"
+#include "ardrone2_navdata.h"
+
+#define BENCH_DEFAULT_ITERATIONS   1000000
+#define BENCH_CKS_MAX_SIZE         4096
+
+/* Normally defined by ardrone2_app.c, the demo option is unpacked into it */
+AppData_t g_ARDrone2_AppData;
+
+static NavData_Unpacked_t  Unpacked;
+static NavData_Frame_t     Frame;
+
+
+/* Size each option has on the wire */
+static uint16 BenchOptionSize(uint32 tag)
+{
+	static const uint16 UnpackedSize[ARDRONE2_NAVDATA_NUM_TAGS] =
+	{
+		[ARDRONE2_NAVDATA_DEMO_TAG]             = sizeof(ARDrone2_NavData_Demo_t) + sizeof(NavDataHeader_t),
+		[ARDRONE2_NAVDATA_TIME_TAG]             = sizeof(NavData_Time_t),
+		[ARDRONE2_NAVDATA_RAW_MEASURES_TAG]     = sizeof(NavData_Raw_Measures_t),
+		[ARDRONE2_NAVDATA_PHYS_MEASURES_TAG]    = sizeof(NavData_Phys_Measures_t),
+		[ARDRONE2_NAVDATA_GYROS_OFFSETS_TAG]    = sizeof(NavData_Gyros_Offsets_t),
+		[ARDRONE2_NAVDATA_EULER_ANGLES_TAG]     = sizeof(NavData_Euler_Angles_t),
+		[ARDRONE2_NAVDATA_REFERENCES_TAG]       = sizeof(NavData_References_t),
+		[ARDRONE2_NAVDATA_TRIMS_TAG]            = sizeof(NavData_Trims_t),
+		[ARDRONE2_NAVDATA_RC_REFERENCES_TAG]    = sizeof(NavData_RC_References_t),
+		[ARDRONE2_NAVDATA_PWM_TAG]              = sizeof(NavData_PWM_t),
+		[ARDRONE2_NAVDATA_ALTITUDE_TAG]         = sizeof(NavData_Altitude_t),
+		[ARDRONE2_NAVDATA_VISION_RAW_TAG]       = sizeof(NavData_Vision_Raw_t),
+		[ARDRONE2_NAVDATA_VISION_OF_TAG]        = sizeof(NavData_Vision_OF_t),
+		[ARDRONE2_NAVDATA_VISION_TAG]           = sizeof(NavData_Vision_t),
+		[ARDRONE2_NAVDATA_VISION_PERF_TAG]      = sizeof(NavData_Vision_Perf_t),
+		[ARDRONE2_NAVDATA_TRACKERS_SEND_TAG]    = sizeof(NavData_Trackers_Send_t),
+		[ARDRONE2_NAVDATA_VISION_DETECT_TAG]    = sizeof(NavData_Vision_Detect_t),
+		[ARDRONE2_NAVDATA_WATCHDOG_TAG]         = sizeof(NavData_Watchdog_t),
+		[ARDRONE2_NAVDATA_ADC_DATA_FRAME_TAG]   = sizeof(NavData_ADC_Data_Frame_t),
+		[ARDRONE2_NAVDATA_VIDEO_STREAM_TAG]     = sizeof(NavData_Video_Stream_t),
+		[ARDRONE2_NAVDATA_GAMES_TAG]            = sizeof(NavData_Games_t),
+		[ARDRONE2_NAVDATA_PRESSURE_RAW_TAG]     = sizeof(NavData_Pressure_Raw_t),
+		[ARDRONE2_NAVDATA_MAGNETO_TAG]          = sizeof(NavData_Magneto_t),
+		[ARDRONE2_NAVDATA_WIND_TAG]             = sizeof(NavData_Wind_Speed_t),
+		[ARDRONE2_NAVDATA_KALMAN_PRESSURE_TAG]  = sizeof(NavData_Kalman_Pressure_t),
+		[ARDRONE2_NAVDATA_HDVIDEO_STREAM_TAG]   = sizeof(NavData_HDVideo_Stream_t),
+		[ARDRONE2_NAVDATA_WIFI_TAG]             = sizeof(NavData_Wifi_t),
+		[ARDRONE2_NAVDATA_ZIMMU_3000_TAG]       = sizeof(NavData_Zimmu_3000_t)
+	};
+
+	return UnpackedSize[tag] - sizeof(NavDataHeader_t) + sizeof(NavData_Option_t);
+}
+
+
+/* Lay out a packet with the options in mask, returns its length */
+static int32 BenchBuildPacket(int8* buffer, uint32 mask)
+{
+	NavData_t*        navdata = (NavData_t*) buffer;
+	NavData_Option_t* option;
+	uint32 offset;
+	uint32 cks;
+	uint32 tag;
+	uint32 i;
+
+	memset(buffer, 0, ARDRONE2_MAX_NAV_BUFFER_SIZE);
+
+	navdata->header         = NAVDATA_HEADER;
+	navdata->ardrone_state  = ARDRONE2_NAVDATA_DEMO_MASK;
+	navdata->sequence       = 1;
+	navdata->vision_defined = 0;
+
+	offset = (uint32) ((int8*) &navdata->options[0] - buffer);
+
+	for( tag = 0; tag < ARDRONE2_NAVDATA_NUM_TAGS; tag++ )
+	{
+		uint16 size = BenchOptionSize(tag);
+
+		if( (mask & (1 << tag)) == 0 ||
+		    offset + size + sizeof(NavData_Cks_t) > ARDRONE2_MAX_NAV_BUFFER_SIZE )
+		{
+			continue;
+		}
+
+		option = (NavData_Option_t*) &buffer[offset];
+		option->tag  = tag;
+		option->size = size;
+		for( i = 0; i < size - sizeof(NavData_Option_t); i++ )
+		{
+			option->data[i] = (uint8) (tag + i);
+		}
+
+		offset += size;
+	}
+
+	cks = ARDrone2_NavDataComputeCks((uint8*) buffer, offset);
+
+	option = (NavData_Option_t*) &buffer[offset];
+	option->tag  = ARDRONE2_NAVDATA_CKS_TAG;
+	option->size = sizeof(NavData_Option_t) + sizeof(cks);
+	memcpy(&option->data[0], &cks, sizeof(cks));
+
+	return offset + option->size;
+}
+
+
+static double BenchElapsed(struct timespec* start, struct timespec* end)
+{
+	return (end->tv_sec - start->tv_sec) + (end->tv_nsec - start->tv_nsec) / 1e9;
+}
+
+
+static void BenchRun(const char* name, uint32 packet_mask, uint32 requested, uint32 iterations)
+{
+	static int8 packet[ARDRONE2_MAX_NAV_BUFFER_SIZE];
+	struct timespec start;
+	struct timespec end;
+	int32  length;
+	uint32 i;
+	uint32 failures = 0;
+	double elapsed;
+
+	length = BenchBuildPacket(packet, packet_mask);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for( i = 0; i < iterations; i++ )
+	{
+		/* Stands for the recvfrom into the frame */
+		memcpy(Frame.buffer, packet, length);
+
+		if( ARDrone2_NavDataBuildIndex(&Frame.index, &Frame.navdata, length) == FALSE ||
+		    ARDrone2_NavDataUnpackAll(&Unpacked, &Frame, requested) == FALSE )
+		{
+			failures++;
+		}
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	elapsed = BenchElapsed(&start, &end);
+
+	printf("%-28s %5d bytes  %10.0f packets/sec  %7.1f ns/packet  failures %u\n",
+	       name, (int) length, iterations / elapsed, elapsed * 1e9 / iterations, failures);
+}
+
+
+typedef uint32 (*BenchCksFunc_t)(const uint8* nv, uint32 size);
+
+static void BenchCks(const char* name, BenchCksFunc_t cks_func, uint32 size, uint32 iterations)
+{
+	static uint8 frame[BENCH_CKS_MAX_SIZE];
+	struct timespec start;
+	struct timespec end;
+	volatile uint32 cks;
+	boolean match;
+	uint32 i;
+	double elapsed;
+
+	for( i = 0; i < size; i++ )
+	{
+		frame[i] = (uint8) (i * 7 + 0x80);
+	}
+
+	/* Check against the scalar kernel, aligned and not */
+	match = cks_func(frame, size) == ARDrone2_NavDataComputeCksScalar(frame, size) &&
+	        cks_func(frame + 1, size - 1) == ARDrone2_NavDataComputeCksScalar(frame + 1, size - 1);
+
+	clock_gettime(CLOCK_MONOTONIC, &start);
+	for( i = 0; i < iterations; i++ )
+	{
+		/* Keep the compiler from hoisting the sum out of the loop */
+		frame[0] = (uint8) i;
+		cks = cks_func(frame, size);
+	}
+	clock_gettime(CLOCK_MONOTONIC, &end);
+
+	(void) cks;
+	elapsed = BenchElapsed(&start, &end);
+
+	printf("%-28s %5u bytes  %10.0f frames/sec   %7.2f GB/s      %s\n",
+	       name, size, iterations / elapsed, (double) size * iterations / elapsed / 1e9,
+	       match ? "ok" : "MISMATCH");
+}
+
+
+int main(int argc, char* argv[])
+{
+	uint32 iterations = BENCH_DEFAULT_ITERATIONS;
+	uint32 all_options = (1 << ARDRONE2_NAVDATA_NUM_TAGS) - 1;
+	uint32 demo_only = 1 << ARDRONE2_NAVDATA_DEMO_TAG;
+
+	if( argc > 1 )
+	{
+		iterations = strtoul(argv[1], NULL, 0);
+	}
+
+	printf("NavData decoder, %u iterations\n", iterations);
+
+	BenchRun("demo only",                    demo_only,   all_options, iterations);
+	BenchRun("full options",                 all_options, all_options, iterations);
+	BenchRun("full options, demo requested", all_options, demo_only,   iterations);
+
+	printf("\nNavData checksum, %u iterations\n", iterations);
+
+	BenchCks("scalar",                       ARDrone2_NavDataComputeCksScalar, 500,                iterations);
+	BenchCks("vector",                       ARDrone2_NavDataComputeCks,       500,                iterations);
+	BenchCks("scalar",                       ARDrone2_NavDataComputeCksScalar, BENCH_CKS_MAX_SIZE, iterations);
+	BenchCks("vector",                       ARDrone2_NavDataComputeCks,       BENCH_CKS_MAX_SIZE, iterations);
+
+	return 0;
+}
@@ -0,0 +1,164 @@
+/*=======================================================================================
+** File Name:  ardrone2_navdata_replay.c
+**
+** Title:  NavData flight recorder replay
+**
+** Purpose:  Feed a capture made by the navdata flight recorder back through
+**           ARDrone2_NavDataBuildIndex and ARDrone2_NavDataUnpackAll, either at the
+**           pace it was recorded or as fast as possible, to reproduce a flight
+**           off the drone or to benchmark the decoder on real traffic.
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    The capture is read in place from the file, oldest record first.  Pacing
+**    follows the CFE times the records were taken at.
+**
+**    Usage:  ardrone2_navdata_replay.bin <capture> [speed]
+**            speed 1 is real time (the default), 0 is as fast as possible,
+**            anything else is that many times real time.
+**
+**=====================================================================================*/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "ardrone2_app.h"
+#include "ardrone2_navdata.h"
+#include "ardrone2_recorder.h"
+
+/* Normally defined by ardrone2_app.c, the demo option is unpacked into it */
+AppData_t g_ARDrone2_AppData;
+
+static NavData_Unpacked_t  Unpacked;
+static NavData_Frame_t     Frame;
+
+
+static double ReplayNow(void)
+{
+	struct timespec ts;
+
+	clock_gettime(CLOCK_MONOTONIC, &ts);
+
+	return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+
+/* CFE time of a record, in seconds */
+static double ReplayRecTime(ARDrone2_RecEntry_t* entry)
+{
+	return entry->seconds + entry->subseconds / 4294967296.0;
+}
+
+
+static void ReplaySleepUntil(double deadline)
+{
+	struct timespec ts;
+
+	ts.tv_sec  = (time_t) deadline;
+	ts.tv_nsec = (long) ((deadline - ts.tv_sec) * 1e9);
+
+	clock_nanosleep(CLOCK_MONOTONIC, TIMER_ABSTIME, &ts, NULL);
+}
+
+
+int main(int argc, char* argv[])
+{
+	ARDrone2_Rec_t       rec;
+	ARDrone2_RecIter_t   iter;
+	ARDrone2_RecEntry_t* entry;
+	double speed = 1.0;
+	double start;
+	double elapsed;
+	double firstTime = 0.0;
+	double latencySum = 0.0;
+	uint32 latencyMax = 0;
+	uint32 packets = 0;
+	uint32 bad = 0;
+	uint32 truncated = 0;
+	uint64 bytes = 0;
+	int    status;
+
+	if( argc < 2 )
+	{
+		fprintf(stderr, "Usage: %s <capture> [speed]\n", argv[0]);
+		return 1;
+	}
+
+	if( argc > 2 )
+	{
+		speed = strtod(argv[2], NULL);
+	}
+
+	if( ARDrone2_RecOpenRead(&rec, argv[1]) != 0 )
+	{
+		fprintf(stderr, "%s: not a navdata capture\n", argv[1]);
+		return 1;
+	}
+
+	printf("%s: %u records, %u recorded, %u overwritten\n", argv[1],
+	       rec.hdr->count, rec.hdr->total, rec.hdr->overwritten);
+
+	start = ReplayNow();
+
+	ARDrone2_RecIterBegin(&rec, &iter);
+	while( (entry = ARDrone2_RecIterNext(&rec, &iter)) != NULL )
+	{
+		uint32 length = entry->length;
+
+		if( packets == 0 )
+		{
+			firstTime = ReplayRecTime(entry);
+		}
+		else if( speed > 0.0 )
+		{
+			ReplaySleepUntil(start + (ReplayRecTime(entry) - firstTime) / speed);
+		}
+
+		if( length > ARDRONE2_MAX_NAV_BUFFER_SIZE )
+		{
+			length = ARDRONE2_MAX_NAV_BUFFER_SIZE;
+			truncated++;
+		}
+
+		/* Stands for the recvmsg into the frame */
+		memcpy(Frame.buffer, entry + 1, length);
+
+		if( length < sizeof(NavData_t) - sizeof(NavData_Option_t) ||
+		    Frame.navdata.header != NAVDATA_HEADER ||
+		    ARDrone2_NavDataBuildIndex(&Frame.index, &Frame.navdata, length) == FALSE ||
+		    ARDrone2_NavDataUnpackAll(&Unpacked, &Frame, 0xFFFFFFFF) == FALSE )
+		{
+			bad++;
+		}
+
+		latencySum += entry->latency_usec;
+		if( entry->latency_usec > latencyMax )
+		{
+			latencyMax = entry->latency_usec;
+		}
+
+		bytes += entry->length;
+		packets++;
+	}
+
+	elapsed = ReplayNow() - start;
+
+	status = (bad == 0) ? 0 : 2;
+	if( packets != rec.hdr->count )
+	{
+		printf("capture damaged after record %u\n", packets);
+		status = 2;
+	}
+
+	printf("%u packets, %u bad, %u truncated, %.3f s\n", packets, bad, truncated, elapsed);
+	if( packets > 0 && elapsed > 0.0 )
+	{
+		printf("%.0f packets/sec  %.2f MB/s\n", packets / elapsed, bytes / elapsed / 1e6);
+		printf("receive latency: mean %.1f us, max %u us\n", latencySum / packets, latencyMax);
+	}
+
+	ARDrone2_RecClose(&rec);
+
+	return status;
+}
@@ -0,0 +1,131 @@
+/*=======================================================================================
+** File Name:  ardrone2_recorder_test.c
+**
+** Title:  Test for the ARDrone2 navdata flight recorder ring
+**
+** Purpose:  Append records to a small ring so that it wraps, and check that
+**           reading it back gives every record still in the ring, oldest first.
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    The ring is 48 bytes.  A 24 byte record and a 16 byte record leave the
+**    head 8 bytes from the end, where only the length word of the wrap entry
+**    fits, so the next record goes at the start of the ring.
+**
+**    Usage:  ardrone2_recorder_test.bin [file]
+**    Returns 0 if no error was found.
+**
+**=====================================================================================*/
+
+#include <stdio.h>
+#include <string.h>
+#include <unistd.h>
+
+#include "ardrone2_recorder.h"
+
+#define TEST_DEFAULT_FILE    "/tmp/ardrone2_recorder_test.rec"
+#define TEST_RING_SIZE       48
+
+static ARDrone2_Rec_t Rec;
+static uint32         Errors;
+
+
+/* Appends a record of length bytes, its seconds telling which one it is */
+static void TestAppend(uint32 id, uint32 length)
+{
+	uint8 data[8];
+
+	memset(data, (int) id, sizeof(data));
+
+	if( !ARDrone2_RecAppend(&Rec, data, length, id, 0, 0) )
+	{
+		printf("Append of record %u failed\n", id);
+		Errors++;
+	}
+}
+
+
+/* Reads the ring back and checks it holds the expected records, in order */
+static void TestReplay(const char* what, const uint32* expect, uint32 count)
+{
+	ARDrone2_RecIter_t   iter;
+	ARDrone2_RecEntry_t* entry;
+	uint32 i = 0;
+
+	ARDrone2_RecIterBegin(&Rec, &iter);
+
+	while( (entry = ARDrone2_RecIterNext(&Rec, &iter)) != NULL )
+	{
+		if( i >= count || entry->seconds != expect[i] )
+		{
+			printf("%s: record %u is %u\n", what, i, entry->seconds);
+			Errors++;
+		}
+		i++;
+	}
+
+	if( i != count || Rec.hdr->count != count )
+	{
+		printf("%s: %u records read, %u in the ring, %u expected\n",
+		       what, i, Rec.hdr->count, count);
+		Errors++;
+	}
+}
+
+
+int main(int argc, char* argv[])
+{
+	const char* path = TEST_DEFAULT_FILE;
+	static const uint32 AtEnd[]     = { 1, 2 };
+	static const uint32 Wrapped[]   = { 2, 3 };
+	static const uint32 TailWrap[]  = { 3, 4 };
+
+	if( argc > 1 )
+	{
+		path = argv[1];
+	}
+
+	unlink(path);
+	if( ARDrone2_RecOpen(&Rec, path, TEST_RING_SIZE) != 0 )
+	{
+		printf("Cannot open %s\nFAILED\n", path);
+		return 1;
+	}
+
+	/* Records 1 and 2 fill the ring up to 8 bytes from the end */
+	TestAppend(1, 8);
+	TestAppend(2, 0);
+	TestReplay("Head 8 bytes from the end", AtEnd, 2);
+
+	/* Record 3 wraps to the start, over record 1 */
+	TestAppend(3, 0);
+	TestReplay("Head wrapped", Wrapped, 2);
+
+	/* Record 4 overwrites record 2, leaving the tail on the wrap entry */
+	TestAppend(4, 0);
+	TestReplay("Tail on the wrap entry", TailWrap, 2);
+
+	ARDrone2_RecClose(&Rec);
+
+	/* A capture reads back the same */
+	if( ARDrone2_RecOpenRead(&Rec, path) != 0 )
+	{
+		printf("Cannot read %s\n", path);
+		Errors++;
+	}
+	else
+	{
+		TestReplay("Capture", TailWrap, 2);
+		ARDrone2_RecClose(&Rec);
+	}
+
+	unlink(path);
+
+	if( Errors != 0 )
+	{
+		printf("FAILED\n");
+		return 1;
+	}
+
+	printf("PASSED\n");
+	return 0;
+}
@@ -0,0 +1,206 @@
+/*=======================================================================================
+** File Name:  ardrone2_snapshot_stress.c
+**
+** Title:  Stress test for the ARDrone2 lock-free snapshots
+**
+** Purpose:  Run one writer thread against one reader thread and check that
+**           ARDrone2_MsgTriple_t only hands over whole messages, in order,
+**           without losing or duplicating a buffer.
+**
+** Limitations, Assumptions, External Events, and Notes:
+**    The writer fills every word of a message with its update count, so a
+**    torn message shows up as two different words.  Zero copy buffers are
+**    stood in for by malloc, and "sending" one frees it.  The writer releases
+**    what is left with ARDrone2_MsgTripleRelease while the reader still runs.
+**
+**    Usage:  ardrone2_snapshot_stress.bin [updates]
+**    Returns 0 if no error was found.
+**
+**=====================================================================================*/
+
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "ardrone2_snapshot.h"
+
+#define STRESS_DEFAULT_UPDATES    2000000
+#define STRESS_MSG_WORDS          64
+
+typedef struct
+{
+	CFE_SB_Msg_t	Hdr;
+	uint32			seq;
+	uint32			words[STRESS_MSG_WORDS];
+} StressMsg_t;
+
+static ARDrone2_MsgTriple_t  Triple;
+
+static uint32          Updates = STRESS_DEFAULT_UPDATES;
+static volatile uint32 ReaderStarted;
+static volatile uint32 WriterDone;
+
+static uint32 Allocated;
+static uint32 Freed;
+static uint32 Released;
+static uint32 BadMsgs;
+static uint32 MsgsTaken;
+
+
+/* Stands in for the SB, for ARDrone2_MsgTripleRelease */
+int32 CFE_SB_ZeroCopyReleasePtr(CFE_SB_Msg_t* Ptr2Release, CFE_SB_ZeroCopyHandle_t BufferHandle)
+{
+	free(Ptr2Release);
+	Released++;
+
+	return CFE_SUCCESS;
+}
+
+
+static void StressFill(uint32* words, uint32 count, uint32 value)
+{
+	uint32 i;
+
+	for( i = 0; i < count; i++ )
+	{
+		words[i] = value;
+	}
+}
+
+
+static void* StressWriter(void* arg)
+{
+	ARDrone2_MsgSlot_t* slot;
+	StressMsg_t* msg;
+	uint32 i;
+
+	/* Without the reader running, the writer would be done before it starts */
+	while( __atomic_load_n(&ReaderStarted, __ATOMIC_ACQUIRE) == 0 )
+	{
+	}
+
+	for( i = 1; i <= Updates; i++ )
+	{
+		slot = ARDrone2_MsgTripleBack(&Triple);
+		if( slot->ptr == NULL )
+		{
+			slot->ptr = (CFE_SB_Msg_t*) malloc(sizeof(StressMsg_t));
+			Allocated++;
+		}
+
+		msg = (StressMsg_t*) slot->ptr;
+		msg->seq = i;
+		StressFill(msg->words, STRESS_MSG_WORDS, i);
+
+		ARDrone2_MsgTriplePublish(&Triple);
+
+		/* Let the reader in on a single CPU too */
+		if( (i & 0xFF) == 0 )
+		{
+			sched_yield();
+		}
+	}
+
+	ARDrone2_MsgTripleRelease(&Triple);
+
+	__atomic_store_n(&WriterDone, 1, __ATOMIC_RELEASE);
+
+	return NULL;
+}
+
+
+static void StressTakeMsg(uint32* last_seq)
+{
+	CFE_SB_ZeroCopyHandle_t handle;
+	StressMsg_t* msg;
+	uint32 i;
+
+	msg = (StressMsg_t*) ARDrone2_MsgTripleTake(&Triple, &handle);
+	if( msg == NULL )
+	{
+		return;
+	}
+
+	if( msg->seq <= *last_seq )
+	{
+		BadMsgs++;
+	}
+
+	for( i = 0; i < STRESS_MSG_WORDS; i++ )
+	{
+		if( msg->words[i] != msg->seq )
+		{
+			BadMsgs++;
+			break;
+		}
+	}
+
+	*last_seq = msg->seq;
+	MsgsTaken++;
+
+	free(msg);
+	__atomic_add_fetch(&Freed, 1, __ATOMIC_RELAXED);
+}
+
+
+static void* StressMsgReader(void* arg)
+{
+	uint32 last_seq = 0;
+
+	__atomic_store_n(&ReaderStarted, 1, __ATOMIC_RELEASE);
+
+	while( __atomic_load_n(&WriterDone, __ATOMIC_ACQUIRE) == 0 )
+	{
+		StressTakeMsg(&last_seq);
+	}
+
+	/* Take whatever the writer published last */
+	StressTakeMsg(&last_seq);
+
+	return NULL;
+}
+
+
+int main(int argc, char* argv[])
+{
+	pthread_t writer;
+	pthread_t msg_reader;
+	uint32 outstanding = 0;
+	long i;
+
+	if( argc > 1 )
+	{
+		Updates = strtoul(argv[1], NULL, 0);
+	}
+
+	ARDrone2_MsgTripleInit(&Triple);
+
+	pthread_create(&msg_reader, NULL, StressMsgReader, NULL);
+	pthread_create(&writer, NULL, StressWriter, NULL);
+
+	pthread_join(writer, NULL);
+	pthread_join(msg_reader, NULL);
+
+	/* Buffers ARDrone2_MsgTripleRelease missed */
+	for( i = 0; i < 3; i++ )
+	{
+		if( Triple.slot[i].ptr != NULL )
+		{
+			outstanding++;
+			free(Triple.slot[i].ptr);
+		}
+	}
+
+	printf("Triple buffer: %u updates, %u messages taken, %u bad, %u allocated, %u sent, %u released, %u left in slots\n",
+	       Updates, MsgsTaken, BadMsgs, Allocated, Freed, Released, outstanding);
+
+	if( BadMsgs != 0 || outstanding != 0 || Allocated != Freed + Released )
+	{
+		printf("FAILED\n");
+		return 1;
+	}
+
+	printf("PASSED\n");
+	return 0;
+}
@@ -59,6 +59,22 @@
 #define HK_PIPE_DEPTH       40
 
 
+/**
+**  \hkcfg Messages Taken per Receive
+**
+**  \par Description:
+**       Dictates the most messages hk takes from its command pipe in one
+**       call to CFE_SB_RcvMsgBatch.  Housekeeping packets arriving in a
+**       burst are then combined with one receive rather than one each.
+**
+**  \par Limits
+**		 The minimum size of this paramater is 1
+**       The maximum size dictated by cFE platform configuration 
+**		 parameter  CFE_SB_MAX_RCV_BATCH
+*/
+#define HK_RCV_BATCH        16
+
+
 /**
 **  \hkcfg Discard Incomplete Combo Packets 
 **
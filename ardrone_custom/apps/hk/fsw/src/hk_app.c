@@ -83,7 +83,10 @@ HK_AppData_t        HK_AppData;
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 void HK_AppMain(void)
 {
-   int32 Status;
+   int32           Status;
+   CFE_SB_MsgPtr_t MsgPtrs[HK_RCV_BATCH];
+   uint32          Count;
+   uint32          i;
 
    /*
    ** Register the Application with Executive Services
@@ -114,9 +117,11 @@ void HK_AppMain(void)
       CFE_ES_PerfLogExit(HK_APPMAIN_PERF_ID);
 
       /*
-      ** Pend on the arrival of the next Software Bus message.
+      ** Pend on the arrival of the next Software Bus message, and take
+      ** any that arrived with it.
       */
-      Status = CFE_SB_RcvMsg(&HK_AppData.MsgPtr,HK_AppData.CmdPipe,CFE_SB_PEND_FOREVER);
+      Status = CFE_SB_RcvMsgBatch(MsgPtrs,HK_RCV_BATCH,&Count,HK_AppData.CmdPipe,
+                                  CFE_SB_PEND_FOREVER);
 
       if(Status != CFE_SUCCESS)
       {
@@ -137,7 +142,11 @@ void HK_AppMain(void)
 
 
         /* Perform Message Processing */
-        HK_AppPipe(HK_AppData.MsgPtr);
+        for (i = 0; i < Count; i++)
+        {
+            HK_AppData.MsgPtr = MsgPtrs[i];
+            HK_AppPipe(HK_AppData.MsgPtr);
+        }
       }
    } /* end while */
 
@@ -469,7 +478,7 @@ void HK_HousekeepingCmd (CFE_SB_MsgPtr_t MessagePtr)
     HK_AppData.HkPacket.ErrCounter          = HK_AppData.ErrCounter;
     HK_AppData.HkPacket.MissingDataCtr      = HK_AppData.MissingDataCtr;
     HK_AppData.HkPacket.CombinedPacketsSent = HK_AppData.CombinedPacketsSent;
-    HK_AppData.HkPacket.MemPoolHandle       = HK_AppData.MemPoolHandle;
+    HK_AppData.HkPacket.MemPoolHandle       = (uint32) HK_AppData.MemPoolHandle;
 
     /* Send housekeeping telemetry packet...        */
     CFE_SB_TimeStampMsg((CFE_SB_Msg_t *) &HK_AppData.HkPacket);
@@ -86,7 +86,7 @@ typedef struct
     uint16					MissingDataCtr;/**< \brief Number of times missing data was detected */
     uint16					CombinedPacketsSent;/**< \brief Count of combined output msgs sent */    
 
-    uint32                  MemPoolHandle;/**< \brief HK mempool handle for output pkts */
+    CFE_ES_MemHandle_t      MemPoolHandle;/**< \brief HK mempool handle for output pkts */
     uint32                  RunStatus;/**< \brief HK App run status */
         
     CFE_TBL_Handle_t        CopyTableHandle;/**< \brief Copy Table handle */
@@ -94,6 +94,8 @@ typedef struct
 
     hk_copy_table_entry_t   *CopyTablePtr;/**< \brief Ptr to copy table entry */
     hk_runtime_tbl_entry_t  *RuntimeTablePtr;/**< \brief Ptr to run-time table entry */
+
+    HK_CopyIndex_t          CopyIndex;/**< \brief Copy table index by input and output MsgId */
         
     uint8                   MemPoolBuffer [HK_NUM_BYTES_IN_MEM_POOL];/**< \brief HK mempool buffer */
 
@@ -47,8 +47,32 @@
 #include "hk_app.h"
 #include "hk_events.h"
 #include <string.h>
+#include <stdlib.h>
                              
 
+/*************************************************************************
+** Local function prototypes
+**************************************************************************/
+static void               HK_BuildCopyIndex (hk_copy_table_entry_t * CpyTblPtr,
+                                             hk_runtime_tbl_entry_t * RtTblPtr);
+static int                HK_CompareBits (const void * A, const void * B);
+static int                HK_CompareRuns (const void * A, const void * B);
+static HK_InputIndex_t  * HK_FindInput (CFE_SB_MsgId_t InputMid);
+static HK_OutputIndex_t * HK_FindOutput (CFE_SB_MsgId_t OutputMid);
+static void               HK_SetPresentBits (uint32 FirstBit, uint32 NumBits);
+static void               HK_ClearPresentBits (uint32 FirstBit, uint32 NumBits);
+static int32              HK_FindMissingBit (uint32 FirstBit, uint32 NumBits);
+static void               HK_SyncDataPresent (void);
+
+
+/*************************************************************************
+** Local data
+**************************************************************************/
+
+/* Copy table being indexed, for the qsort compare functions */
+static hk_copy_table_entry_t  * HK_SortTable;
+
+
 /*************************************************************************
 ** Function definitions
 **************************************************************************/
@@ -62,51 +86,69 @@ void HK_ProcessIncomingHkData (CFE_SB_MsgPtr_t MessagePtr)
 {
     hk_copy_table_entry_t         * StartOfCopyTable;
     hk_copy_table_entry_t         * CpyTblEntry;
-    hk_runtime_tbl_entry_t        * StartOfRtTable;
-    hk_runtime_tbl_entry_t        * RtTblEntry;
+    HK_CopyIndex_t                * Index;
+    HK_InputIndex_t               * Input;
+    HK_CopyRun_t                  * Run;
     uint16                          Loop;
+    uint32                          Bit;
     CFE_SB_MsgId_t                  MessageID;
     uint8                         * DestPtr;
     uint8                         * SrcPtr;
-    int32                           MessageLength;
+    int32                           MessageLength = 0;
     int32                           MessageErrors;
     int32                           LastByteAccessed;
 
 
     StartOfCopyTable = (hk_copy_table_entry_t *)  HK_AppData.CopyTablePtr;
-    StartOfRtTable   = (hk_runtime_tbl_entry_t *) HK_AppData.RuntimeTablePtr;
+    Index            = & HK_AppData.CopyIndex;
     MessageID        = CFE_SB_GetMsgId (MessagePtr);
     MessageErrors    = 0;
     
-    /* Spin thru the entire table looking for matches */
-    for (Loop=0; Loop < HK_COPY_TABLE_ENTRIES; Loop++)
+    /* Only the copy runs built for this input MID need to be looked at */
+    Input = HK_FindInput (MessageID);
+    if (Input != NULL)
     {
-        CpyTblEntry = & StartOfCopyTable [Loop];
-        RtTblEntry  = & StartOfRtTable [Loop];
-        
-        /* Does the inputMID for this table entry match what we're looking for */       
-        if (MessageID == CpyTblEntry->InputMid)
+        MessageLength = CFE_SB_GetTotalMsgLength(MessagePtr);
+
+        for (Loop = 0; Loop < Input->NumRuns; Loop++)
         {
+            Run = & Index->Runs [Input->FirstRun + Loop];
+
             /* Ensure that we don't reference past the end of the input packet */
-            MessageLength    = CFE_SB_GetTotalMsgLength(MessagePtr);
-            LastByteAccessed = CpyTblEntry->InputOffset + CpyTblEntry->NumBytes;
+            LastByteAccessed = Run->InputOffset + Run->NumBytes;
             if (MessageLength >= LastByteAccessed)
             {
-                /* We have a match.  Build the Source and Destination addresses
-                   and move the data */
-                DestPtr = ( (uint8 *) RtTblEntry->OutputPktAddr) + CpyTblEntry->OutputOffset;
-                SrcPtr  = ( (uint8 *) MessagePtr) + CpyTblEntry->InputOffset;
+                SrcPtr = ( (uint8 *) MessagePtr) + Run->InputOffset;
 
-                CFE_PSP_MemCpy (DestPtr, SrcPtr, CpyTblEntry->NumBytes);
-                
-                /* Set the data present field to indicate the data is there */
-                RtTblEntry->DataPresent = HK_DATA_PRESENT;
+                CFE_PSP_MemCpy (Run->DestPtr, SrcPtr, Run->NumBytes);
 
+                /* Set the data present bits to indicate the data is there */
+                HK_SetPresentBits (Run->FirstBit, Run->NumEntries);
             }
             else
             {
-                /* Error: copy data is past the end of the input packet */
-                MessageErrors++;
+                /* Some of the run is past the end of the input packet, so 
+                   copy what there is of it one table entry at a time */
+                for (Bit = Run->FirstBit; Bit < (uint32) (Run->FirstBit + Run->NumEntries); Bit++)
+                {
+                    CpyTblEntry = & StartOfCopyTable [Index->BitEntry [Bit]];
+
+                    LastByteAccessed = CpyTblEntry->InputOffset + CpyTblEntry->NumBytes;
+                    if (MessageLength >= LastByteAccessed)
+                    {
+                        DestPtr = Run->DestPtr + (CpyTblEntry->InputOffset - Run->InputOffset);
+                        SrcPtr  = ( (uint8 *) MessagePtr) + CpyTblEntry->InputOffset;
+
+                        CFE_PSP_MemCpy (DestPtr, SrcPtr, CpyTblEntry->NumBytes);
+
+                        HK_SetPresentBits (Bit, 1);
+                    }
+                    else
+                    {
+                        /* Error: copy data is past the end of the input packet */
+                        MessageErrors++;
+                    }
+                }
             }
         }
     }
@@ -280,6 +322,9 @@ void HK_ProcessNewCopyTable (hk_copy_table_entry_t * CpyTblPtr,
         }
     }
 
+    /* Index the table by input and output MID for the per-packet functions */
+    HK_BuildCopyIndex (StartOfCopyTable, StartOfRtTable);
+
 }   /* end HK_ProcessNewCopyTable */
 
 
@@ -341,7 +386,7 @@ void HK_TearDownOldCopyTable (hk_copy_table_entry_t * CpyTblPtr,
             {
                 CFE_EVS_SendEvent (HK_MEM_POOL_FREE_FAILED_EID, CFE_EVS_ERROR,
                                    "HK TearDown: ES_putPoolBuf Err pkt:0x%08X ret 0x%04X, hdl 0x%08x",
-                                   SavedPktAddr, Result,HK_AppData.MemPoolHandle);
+                                   SavedPktAddr, Result,(uint32) HK_AppData.MemPoolHandle);
             }
         }
 
@@ -368,6 +413,12 @@ void HK_TearDownOldCopyTable (hk_copy_table_entry_t * CpyTblPtr,
 
     }
 
+    /* The packets the index points at are gone */
+    HK_AppData.CopyIndex.NumInputs  = 0;
+    HK_AppData.CopyIndex.NumOutputs = 0;
+    HK_AppData.CopyIndex.NumRuns    = 0;
+    HK_AppData.CopyIndex.NumBits    = 0;
+
 }   /* end HK_TearDownOldCopyTable */
 
 
@@ -380,59 +431,37 @@ void HK_TearDownOldCopyTable (hk_copy_table_entry_t * CpyTblPtr,
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 void HK_SendCombinedHkPacket (CFE_SB_MsgId_t WhichMidToSend)
 {
-    boolean                         PacketFound = FALSE;
-    hk_copy_table_entry_t         * StartOfCopyTable;
-    hk_copy_table_entry_t         * CpyTblEntry;
-    hk_runtime_tbl_entry_t        * StartOfRtTable;
-    hk_runtime_tbl_entry_t        * RtTblEntry;
-    int32                           Loop;
-    CFE_SB_MsgId_t                  ThisEntrysOutMid;
+    HK_OutputIndex_t              * Output;
     CFE_SB_MsgId_t                  InputMidMissing;
 
-    StartOfCopyTable = (hk_copy_table_entry_t *) HK_AppData.CopyTablePtr;
-    StartOfRtTable  = (hk_runtime_tbl_entry_t *)  HK_AppData.RuntimeTablePtr;
+    /* Each combined packet is in the index once, at most */
+    Output = HK_FindOutput (WhichMidToSend);
 
-    /* Look thru each item in this Table, but only send this packet once, at most */
-    for (Loop = 0; ( (Loop < HK_COPY_TABLE_ENTRIES) && (PacketFound == FALSE) ); Loop++)
+    if (Output != NULL)
     {
-        CpyTblEntry = & StartOfCopyTable [Loop];
-        RtTblEntry  = & StartOfRtTable [Loop];
-
-        /* Empty table entries are defined by NULL's in this field */
-        if (RtTblEntry->OutputPktAddr != NULL)
+        if(HK_CheckForMissingData(WhichMidToSend,&InputMidMissing)==HK_MISSING_DATA_DETECTED)
         {
-            ThisEntrysOutMid = CFE_SB_GetMsgId (RtTblEntry->OutputPktAddr);
-            if (ThisEntrysOutMid == WhichMidToSend)
-            {
-                if(HK_CheckForMissingData(ThisEntrysOutMid,&InputMidMissing)==HK_MISSING_DATA_DETECTED)
-                {
-                    HK_AppData.MissingDataCtr++;
-                    
-                    CFE_EVS_SendEvent (HK_OUTPKT_MISSING_DATA_EID, CFE_EVS_DEBUG,
-                       "Combined Packet 0x%04X missing data from Input Pkt 0x%04X", 
-                       ThisEntrysOutMid,InputMidMissing);
-                    
-                }
+            HK_AppData.MissingDataCtr++;
+            
+            CFE_EVS_SendEvent (HK_OUTPKT_MISSING_DATA_EID, CFE_EVS_DEBUG,
+               "Combined Packet 0x%04X missing data from Input Pkt 0x%04X", 
+               WhichMidToSend,InputMidMissing);
+            
+        }
 #if HK_DISCARD_INCOMPLETE_COMBO == 1
-                else /* This clause is only exclusive if discarding incomplete packets */
+        else /* This clause is only exclusive if discarding incomplete packets */
 #endif
-                { 
-                    /* Send the combined housekeeping telemetry packet...        */
-                    CFE_SB_TimeStampMsg ( (CFE_SB_Msg_t *) RtTblEntry->OutputPktAddr);
-                    CFE_SB_SendMsg      ( (CFE_SB_Msg_t *) RtTblEntry->OutputPktAddr);
-                
-                    HK_AppData.CombinedPacketsSent ++ ;
-                }
-
-                HK_SetFlagsToNotPresent(ThisEntrysOutMid);               
-                
-                PacketFound = TRUE;
-                
-            }
+        { 
+            /* Send the combined housekeeping telemetry packet...        */
+            CFE_SB_TimeStampMsg ( (CFE_SB_Msg_t *) Output->OutputPktAddr);
+            CFE_SB_SendMsg      ( (CFE_SB_Msg_t *) Output->OutputPktAddr);
+        
+            HK_AppData.CombinedPacketsSent ++ ;
         }
-    }
 
-    if (PacketFound == FALSE)
+        HK_SetFlagsToNotPresent(WhichMidToSend);               
+    }
+    else
     {
         CFE_EVS_SendEvent (HK_UNKNOWN_COMBINED_PACKET_EID, CFE_EVS_INFORMATION,
                          "Combined HK Packet 0x%04X is not found in current HK Copy Table", 
@@ -513,6 +542,9 @@ void HK_CheckStatusOfTables (void)
     
     if (Status == CFE_TBL_INFO_DUMP_PENDING)
     {
+        /* The data present flags are kept in the index, bring the table up to date */
+        HK_SyncDataPresent ();
+
         /* Dump the specified Table, cfe tbl manager makes copy */
         CFE_TBL_DumpToBuffer(HK_AppData.RuntimeTableHandle);       
 
@@ -536,35 +568,24 @@ void HK_CheckStatusOfTables (void)
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 int32 HK_CheckForMissingData(CFE_SB_MsgId_t OutPktToCheck, CFE_SB_MsgId_t *MissingInputMid)
 {
-    int32                         Loop = 0;
+    int32                         Bit;
     int32                         Status = HK_NO_MISSING_DATA;
     hk_copy_table_entry_t       * StartOfCopyTable;
-    hk_copy_table_entry_t       * CpyTblEntry;
-    hk_runtime_tbl_entry_t      * StartOfRtTable;
-    hk_runtime_tbl_entry_t      * RtTblEntry;
+    HK_OutputIndex_t            * Output;
 
     StartOfCopyTable = (hk_copy_table_entry_t *) HK_AppData.CopyTablePtr;
-    StartOfRtTable  = (hk_runtime_tbl_entry_t *)  HK_AppData.RuntimeTablePtr;
 
-    /* Loop thru each item in the runtime table until end is reached or 
-     * data-not-present detected */
-    do
+    /* Look for a data-not-present bit among the ones owned by this packet */
+    Output = HK_FindOutput (OutPktToCheck);
+    if (Output != NULL)
     {
-        CpyTblEntry = &StartOfCopyTable[Loop];
-        RtTblEntry  = &StartOfRtTable[Loop];
-
-        /* Empty table entries are defined by NULL's in this field */
-        if ((RtTblEntry->OutputPktAddr != NULL)&&
-           (CpyTblEntry->OutputMid==OutPktToCheck)&&
-           (RtTblEntry->DataPresent==HK_DATA_NOT_PRESENT))           
-        {           
-            *MissingInputMid = CpyTblEntry->InputMid;
+        Bit = HK_FindMissingBit (Output->FirstBit, Output->NumBits);
+        if (Bit >= 0)
+        {
+            *MissingInputMid = StartOfCopyTable[HK_AppData.CopyIndex.BitEntry[Bit]].InputMid;
             Status = HK_MISSING_DATA_DETECTED;          
         }
-        
-        Loop++;
-        
-    }while((Loop < HK_COPY_TABLE_ENTRIES)&&(Status == HK_NO_MISSING_DATA));
+    }
     
     return Status;
     
@@ -578,31 +599,390 @@ int32 HK_CheckForMissingData(CFE_SB_MsgId_t OutPktToCheck, CFE_SB_MsgId_t *Missi
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 void HK_SetFlagsToNotPresent(CFE_SB_MsgId_t OutPkt)
 {
-    int32                           Loop;
-    hk_copy_table_entry_t         * StartOfCopyTable;
+    HK_OutputIndex_t              * Output;
+
+    Output = HK_FindOutput (OutPkt);
+    if (Output != NULL)
+    {
+        HK_ClearPresentBits (Output->FirstBit, Output->NumBits);
+    }
+        
+}/* end HK_SetFlagsToNotPresent */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HK build the copy table index                                   */
+/*                                                                 */
+/* Every table entry with an output packet gets a data present bit.*/
+/* The bits are sorted by output MID, so each output packet owns a */
+/* range of them, then by input MID and offset, so entries that    */
+/* follow on from each other in both packets sit next to each      */
+/* other and are merged into one copy run.  The runs are then      */
+/* sorted by input MID to group them under the input index.        */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HK_BuildCopyIndex (hk_copy_table_entry_t * CpyTblPtr,
+                               hk_runtime_tbl_entry_t * RtTblPtr)
+{
+    HK_CopyIndex_t                * Index;
     hk_copy_table_entry_t         * CpyTblEntry;
+    hk_copy_table_entry_t         * RunCpyEntry;
+    HK_OutputIndex_t              * Output = NULL;
+    HK_CopyRun_t                  * Run;
+    uint8                         * DestPtr;
+    uint32                          Loop;
+    uint32                          Bit;
+
+    Index = & HK_AppData.CopyIndex;
+    Index->NumInputs  = 0;
+    Index->NumOutputs = 0;
+    Index->NumRuns    = 0;
+    Index->NumBits    = 0;
+    CFE_PSP_MemSet (Index->Present, 0, sizeof (Index->Present));
+
+    HK_SortTable = CpyTblPtr;
+
+    for (Loop = 0; Loop < HK_COPY_TABLE_ENTRIES; Loop++)
+    {
+        if (RtTblPtr [Loop].OutputPktAddr != NULL)
+        {
+            Index->BitEntry [Index->NumBits++] = Loop;
+        }
+    }
+
+    qsort (Index->BitEntry, Index->NumBits, sizeof (Index->BitEntry [0]), HK_CompareBits);
+
+    for (Bit = 0; Bit < Index->NumBits; Bit++)
+    {
+        CpyTblEntry = & CpyTblPtr [Index->BitEntry [Bit]];
+
+        if ( (Output == NULL) || (Output->OutputMid != CpyTblEntry->OutputMid) )
+        {
+            Output = & Index->Outputs [Index->NumOutputs++];
+            Output->OutputPktAddr = RtTblPtr [Index->BitEntry [Bit]].OutputPktAddr;
+            Output->OutputMid     = CpyTblEntry->OutputMid;
+            Output->FirstBit      = Bit;
+            Output->NumBits       = 0;
+        }
+
+        Output->NumBits++;
+
+        /* Entries with no input never get data, but still count as missing */
+        if (CpyTblEntry->InputMid == HK_UNDEFINED_ENTRY)
+        {
+            continue;
+        }
+
+        DestPtr = ( (uint8 *) Output->OutputPktAddr) + CpyTblEntry->OutputOffset;
+
+        /* Extend the last run if this entry carries straight on from it */
+        if (Index->NumRuns > 0)
+        {
+            Run         = & Index->Runs [Index->NumRuns - 1];
+            RunCpyEntry = & CpyTblPtr [Index->BitEntry [Run->FirstBit]];
+
+            if ( (RunCpyEntry->InputMid == CpyTblEntry->InputMid) &&
+                 (Run->FirstBit >= Output->FirstBit) &&
+                 ((uint32) (Run->FirstBit + Run->NumEntries) == Bit) &&
+                 (Run->InputOffset + Run->NumBytes == CpyTblEntry->InputOffset) &&
+                 (Run->DestPtr + Run->NumBytes == DestPtr) )
+            {
+                Run->NumEntries++;
+                Run->NumBytes += CpyTblEntry->NumBytes;
+                continue;
+            }
+        }
+
+        Run = & Index->Runs [Index->NumRuns++];
+        Run->DestPtr     = DestPtr;
+        Run->InputOffset = CpyTblEntry->InputOffset;
+        Run->FirstBit    = Bit;
+        Run->NumEntries  = 1;
+        Run->Spare       = 0;
+        Run->NumBytes    = CpyTblEntry->NumBytes;
+    }
+
+    qsort (Index->Runs, Index->NumRuns, sizeof (Index->Runs [0]), HK_CompareRuns);
+
+    for (Loop = 0; Loop < Index->NumRuns; Loop++)
+    {
+        CpyTblEntry = & CpyTblPtr [Index->BitEntry [Index->Runs [Loop].FirstBit]];
+
+        if ( (Index->NumInputs == 0) ||
+             (Index->Inputs [Index->NumInputs - 1].InputMid != CpyTblEntry->InputMid) )
+        {
+            Index->Inputs [Index->NumInputs].InputMid = CpyTblEntry->InputMid;
+            Index->Inputs [Index->NumInputs].FirstRun = Loop;
+            Index->Inputs [Index->NumInputs].NumRuns  = 0;
+            Index->NumInputs++;
+        }
+
+        Index->Inputs [Index->NumInputs - 1].NumRuns++;
+    }
+
+}   /* end HK_BuildCopyIndex */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HK order data present bits: output MID, input MID, input        */
+/* offset, output offset, table entry                              */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int HK_CompareBits (const void * A, const void * B)
+{
+    uint16                          EntryA = * (const uint16 *) A;
+    uint16                          EntryB = * (const uint16 *) B;
+    hk_copy_table_entry_t         * CpyA = & HK_SortTable [EntryA];
+    hk_copy_table_entry_t         * CpyB = & HK_SortTable [EntryB];
+
+    if (CpyA->OutputMid != CpyB->OutputMid)
+    {
+        return (CpyA->OutputMid < CpyB->OutputMid) ? -1 : 1;
+    }
+
+    if (CpyA->InputMid != CpyB->InputMid)
+    {
+        return (CpyA->InputMid < CpyB->InputMid) ? -1 : 1;
+    }
+
+    if (CpyA->InputOffset != CpyB->InputOffset)
+    {
+        return (CpyA->InputOffset < CpyB->InputOffset) ? -1 : 1;
+    }
+
+    if (CpyA->OutputOffset != CpyB->OutputOffset)
+    {
+        return (CpyA->OutputOffset < CpyB->OutputOffset) ? -1 : 1;
+    }
+
+    return (EntryA < EntryB) ? -1 : (EntryA > EntryB);
+
+}   /* end HK_CompareBits */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HK order copy runs: input MID, first data present bit           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int HK_CompareRuns (const void * A, const void * B)
+{
+    const HK_CopyRun_t            * RunA = (const HK_CopyRun_t *) A;
+    const HK_CopyRun_t            * RunB = (const HK_CopyRun_t *) B;
+    CFE_SB_MsgId_t                  MidA;
+    CFE_SB_MsgId_t                  MidB;
+
+    MidA = HK_SortTable [HK_AppData.CopyIndex.BitEntry [RunA->FirstBit]].InputMid;
+    MidB = HK_SortTable [HK_AppData.CopyIndex.BitEntry [RunB->FirstBit]].InputMid;
+
+    if (MidA != MidB)
+    {
+        return (MidA < MidB) ? -1 : 1;
+    }
+
+    return (RunA->FirstBit < RunB->FirstBit) ? -1 : (RunA->FirstBit > RunB->FirstBit);
+
+}   /* end HK_CompareRuns */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HK find an input MID in the copy table index                    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static HK_InputIndex_t * HK_FindInput (CFE_SB_MsgId_t InputMid)
+{
+    HK_InputIndex_t               * Inputs = HK_AppData.CopyIndex.Inputs;
+    uint32                          Low = 0;
+    uint32                          High = HK_AppData.CopyIndex.NumInputs;
+    uint32                          Mid;
+
+    while (Low < High)
+    {
+        Mid = (Low + High) / 2;
+
+        if (Inputs [Mid].InputMid < InputMid)
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        }
+    }
+
+    if ( (Low < HK_AppData.CopyIndex.NumInputs) && (Inputs [Low].InputMid == InputMid) )
+    {
+        return & Inputs [Low];
+    }
+
+    return NULL;
+
+}   /* end HK_FindInput */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HK find an output MID in the copy table index                   */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static HK_OutputIndex_t * HK_FindOutput (CFE_SB_MsgId_t OutputMid)
+{
+    HK_OutputIndex_t              * Outputs = HK_AppData.CopyIndex.Outputs;
+    uint32                          Low = 0;
+    uint32                          High = HK_AppData.CopyIndex.NumOutputs;
+    uint32                          Mid;
+
+    while (Low < High)
+    {
+        Mid = (Low + High) / 2;
+
+        if (Outputs [Mid].OutputMid < OutputMid)
+        {
+            Low = Mid + 1;
+        }
+        else
+        {
+            High = Mid;
+        }
+    }
+
+    if ( (Low < HK_AppData.CopyIndex.NumOutputs) && (Outputs [Low].OutputMid == OutputMid) )
+    {
+        return & Outputs [Low];
+    }
+
+    return NULL;
+
+}   /* end HK_FindOutput */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HK mask of the bits of a range that fall in its first word      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+#define HK_PRESENT_MASK(FirstBit, NumBits) \
+    ( ( ((NumBits) >= 32) ? 0xFFFFFFFFU : ((1U << (NumBits)) - 1) ) << ((FirstBit) % 32) )
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HK set a range of data present bits                             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HK_SetPresentBits (uint32 FirstBit, uint32 NumBits)
+{
+    uint32                          Count;
+
+    while (NumBits > 0)
+    {
+        Count = 32 - (FirstBit % 32);
+        if (Count > NumBits)
+        {
+            Count = NumBits;
+        }
+
+        HK_AppData.CopyIndex.Present [FirstBit / 32] |= HK_PRESENT_MASK (FirstBit, Count);
+
+        FirstBit += Count;
+        NumBits  -= Count;
+    }
+
+}   /* end HK_SetPresentBits */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HK clear a range of data present bits                           */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HK_ClearPresentBits (uint32 FirstBit, uint32 NumBits)
+{
+    uint32                          Count;
+
+    while (NumBits > 0)
+    {
+        Count = 32 - (FirstBit % 32);
+        if (Count > NumBits)
+        {
+            Count = NumBits;
+        }
+
+        HK_AppData.CopyIndex.Present [FirstBit / 32] &= ~HK_PRESENT_MASK (FirstBit, Count);
+
+        FirstBit += Count;
+        NumBits  -= Count;
+    }
+
+}   /* end HK_ClearPresentBits */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HK find the first clear bit in a range of data present bits,    */
+/* -1 if they are all set                                          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static int32 HK_FindMissingBit (uint32 FirstBit, uint32 NumBits)
+{
+    uint32                          Count;
+    uint32                          Missing;
+
+    while (NumBits > 0)
+    {
+        Count = 32 - (FirstBit % 32);
+        if (Count > NumBits)
+        {
+            Count = NumBits;
+        }
+
+        Missing = ~HK_AppData.CopyIndex.Present [FirstBit / 32] & HK_PRESENT_MASK (FirstBit, Count);
+        if (Missing != 0)
+        {
+            return (FirstBit & ~31U) + __builtin_ctz (Missing);
+        }
+
+        FirstBit += Count;
+        NumBits  -= Count;
+    }
+
+    return -1;
+
+}   /* end HK_FindMissingBit */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* HK copy the data present bits to the run-time table             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void HK_SyncDataPresent (void)
+{
+    HK_CopyIndex_t                * Index;
     hk_runtime_tbl_entry_t        * StartOfRtTable;
-    hk_runtime_tbl_entry_t        * RtTblEntry;
+    uint32                          Loop;
+    uint32                          Bit;
 
-    StartOfCopyTable = (hk_copy_table_entry_t *) HK_AppData.CopyTablePtr;
-    StartOfRtTable  = (hk_runtime_tbl_entry_t *)  HK_AppData.RuntimeTablePtr;
+    Index          = & HK_AppData.CopyIndex;
+    StartOfRtTable = (hk_runtime_tbl_entry_t *) HK_AppData.RuntimeTablePtr;
 
-    /* Look thru each item in the runtime table until end is reached */ 
-    for(Loop = 0;Loop < HK_COPY_TABLE_ENTRIES; Loop++)
+    for (Loop = 0; Loop < HK_COPY_TABLE_ENTRIES; Loop++)
     {
-        CpyTblEntry = &StartOfCopyTable[Loop];
-        RtTblEntry  = &StartOfRtTable[Loop];
-
-        /* Empty table entries are defined by NULL's in this field */
-        if ((RtTblEntry->OutputPktAddr != NULL)&&
-           (CpyTblEntry->OutputMid==OutPkt))           
-        {           
-            RtTblEntry->DataPresent = HK_DATA_NOT_PRESENT;          
+        StartOfRtTable [Loop].DataPresent = HK_DATA_NOT_PRESENT;
+    }
+
+    for (Bit = 0; Bit < Index->NumBits; Bit++)
+    {
+        if (Index->Present [Bit / 32] & (1U << (Bit % 32)))
+        {
+            StartOfRtTable [Index->BitEntry [Bit]].DataPresent = HK_DATA_PRESENT;
         }
-                
     }
-        
-}/* end HK_SetFlagsToNotPresent */
+
+}   /* end HK_SyncDataPresent */
 
 
 /************************/
@@ -43,6 +43,7 @@
 *************************************************************************/
 #include "cfe.h"
 #include "hk_tbldefs.h"
+#include "hk_platform_cfg.h"
 
 
 /*************************************************************************
@@ -59,6 +60,72 @@
 
 #define HK_UNDEFINED_ENTRY              0     /**< \brief Undefined table field entry */
 
+#define HK_PRESENT_WORDS    ((HK_COPY_TABLE_ENTRIES + 31) / 32) /**< \brief Words in the data present bitmap */
+
+
+/*************************************************************************
+** Type definitions
+**************************************************************************/
+
+/**  \brief HK Copy Run
+**
+**   One or more copy table entries with the same input and output packet
+**   whose bytes follow on from each other in both, moved with one copy.
+*/
+typedef struct
+{
+    uint8             * DestPtr;     /**< \brief Where the run starts in the output pkt */
+    uint16              InputOffset; /**< \brief ByteOffset into the input pkt where the run starts */
+    uint16              FirstBit;    /**< \brief Data present bit of the first entry in the run */
+    uint16              NumEntries;  /**< \brief Number of copy table entries in the run */
+    uint16              Spare;       /**< \brief Spare for alignment */
+    uint32              NumBytes;    /**< \brief Number of data bytes in the run */
+} HK_CopyRun_t;
+
+
+/**  \brief HK Input Packet Index Entry
+*/
+typedef struct
+{
+    CFE_SB_MsgId_t      InputMid;    /**< \brief MsgId of the input packet */
+    uint16              FirstRun;    /**< \brief Index of the first copy run for this input */
+    uint16              NumRuns;     /**< \brief Number of copy runs for this input */
+} HK_InputIndex_t;
+
+
+/**  \brief HK Output Packet Index Entry
+*/
+typedef struct
+{
+    CFE_SB_MsgPtr_t     OutputPktAddr; /**< \brief Addr of output packet */
+    CFE_SB_MsgId_t      OutputMid;   /**< \brief MsgId of the output packet */
+    uint16              FirstBit;    /**< \brief First data present bit owned by this output */
+    uint16              NumBits;     /**< \brief Number of copy table entries in this output */
+} HK_OutputIndex_t;
+
+
+/**  \brief HK Copy Table Index
+**
+**   Built from the copy table by #HK_ProcessNewCopyTable so that an input
+**   or combined output packet only costs the copy table entries that name
+**   it.  Inputs and Outputs are sorted by MsgId.  Each output packet owns a
+**   range of bits in Present, one per copy table entry, in the same order
+**   as its copy runs.
+*/
+typedef struct
+{
+    uint16              NumInputs;   /**< \brief Number of input packets in Inputs */
+    uint16              NumOutputs;  /**< \brief Number of output packets in Outputs */
+    uint16              NumRuns;     /**< \brief Number of copy runs in Runs */
+    uint16              NumBits;     /**< \brief Number of data present bits in use */
+
+    HK_InputIndex_t     Inputs [HK_COPY_TABLE_ENTRIES];  /**< \brief Input packets */
+    HK_OutputIndex_t    Outputs [HK_COPY_TABLE_ENTRIES]; /**< \brief Combined output packets */
+    HK_CopyRun_t        Runs [HK_COPY_TABLE_ENTRIES];    /**< \brief Copy runs, grouped by input */
+    uint16              BitEntry [HK_COPY_TABLE_ENTRIES];/**< \brief Copy table entry of each bit */
+    uint32              Present [HK_PRESENT_WORDS];      /**< \brief Data present bitmap */
+} HK_CopyIndex_t;
+
 
 
 /************************************************************************
@@ -70,9 +137,9 @@
 ** \brief Process incoming housekeeping data message
 **
 ** \par Description
-**        This routine examines each entry in the table and determines whether
-**        its field comprises a legal entry.  If so, a portion of the input 
-**        packet is copied to the appropriate combined output packet.
+**        This routine looks the input message up in the copy table index
+**        and copies each of its copy runs from the input packet to the
+**        appropriate combined output packet.
 **
 ** \par Assumptions, External Events, and Notes:
 **        Currently the combined telemetry packets are not initialized after 
@@ -116,7 +183,8 @@ int32 HK_ValidateHkCopyTable (void * TblPtr);
 **
 ** \par Description
 **        Upon the arrival of a new HK Copy Table, this routine will
-**        handle whatever is necessary to make this new data functional.       
+**        handle whatever is necessary to make this new data functional,
+**        including building the copy table index (#HK_CopyIndex_t).
 **
 ** \par Assumptions, External Events, and Notes:
 **          None
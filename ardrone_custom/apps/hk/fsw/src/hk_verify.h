@@ -54,6 +54,14 @@
     #error HK_PIPE_DEPTH cannot be greater than CFE_SB_MAX_PIPE_DEPTH!
 #endif
 
+#ifndef HK_RCV_BATCH
+    #error HK_RCV_BATCH must be defined!
+#elif (HK_RCV_BATCH  <  1)
+    #error HK_RCV_BATCH cannot be less than 1!
+#elif (HK_RCV_BATCH  >  CFE_SB_MAX_RCV_BATCH)
+    #error HK_RCV_BATCH cannot be greater than CFE_SB_MAX_RCV_BATCH!
+#endif
+
 #ifndef HK_COPY_TABLE_ENTRIES
     #error HK_COPY_TABLE_ENTRIES must be defined!
 #elif (HK_COPY_TABLE_ENTRIES  <  1)
@@ -134,6 +134,18 @@
 #define CFE_SB_MAX_PIPE_DEPTH           256
 
 
+/**
+**  \cfesbcfg Maximum Messages in a Batch Receive
+**
+**  \par Description:
+**       The most messages one call to #CFE_SB_RcvMsgBatch can return.
+**
+**  \par Limits
+**       This parameter has a lower limit of 1 and an upper limit of 65535.
+*/
+#define CFE_SB_MAX_RCV_BATCH            32
+
+
 /**
 **  \cfesbcfg Highest Valid Message Id
 **
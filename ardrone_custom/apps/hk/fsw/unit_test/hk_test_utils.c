@@ -0,0 +1,74 @@
+ /*************************************************************************
+ ** File:
+ **   hk_test_utils.c
+ **
+ ** Purpose:
+ **   This file contains the UT-Assert unit test utilities for the CFS
+ **   Housekeeping (HK) application.
+ **
+ ** Notes:
+ **   Combined output packets come out of a test memory pool handed out by
+ **   the CFE_ES_GetPoolBuf hook, so their contents can be checked.
+ **
+ *************************************************************************/
+
+#include "hk_test_utils.h"
+
+hk_copy_table_entry_t   HK_Test_CopyTable [HK_COPY_TABLE_ENTRIES];
+hk_runtime_tbl_entry_t  HK_Test_RuntimeTable [HK_COPY_TABLE_ENTRIES];
+
+static uint32           HK_Test_Pool [HK_NUM_BYTES_IN_MEM_POOL / 4];
+static uint32           HK_Test_PoolUsed;
+
+/*
+ * Function Definitions
+ */
+
+static int32 HK_Test_GetPoolBufHook(uint32 **BufPtr, CFE_ES_MemHandle_t HandlePtr, uint32 Size)
+{
+    uint32 Words = (Size + 3) / 4;
+
+    if (HK_Test_PoolUsed + Words > sizeof(HK_Test_Pool) / 4)
+    {
+        return CFE_ES_ERR_MEM_BLOCK_SIZE;
+    }
+
+    *BufPtr = &HK_Test_Pool[HK_Test_PoolUsed];
+    HK_Test_PoolUsed += Words;
+
+    return Size;
+} /* end HK_Test_GetPoolBufHook */
+
+void HK_Test_Setup(void)
+{
+    /* initialize test environment to default state for every test */
+
+    CFE_PSP_MemSet(&HK_AppData, 0, sizeof(HK_AppData_t));
+    CFE_PSP_MemSet(HK_Test_CopyTable, 0, sizeof(HK_Test_CopyTable));
+    CFE_PSP_MemSet(HK_Test_RuntimeTable, 0, sizeof(HK_Test_RuntimeTable));
+    CFE_PSP_MemSet(HK_Test_Pool, 0, sizeof(HK_Test_Pool));
+    HK_Test_PoolUsed = 0;
+
+    HK_AppData.CopyTablePtr    = HK_Test_CopyTable;
+    HK_AppData.RuntimeTablePtr = HK_Test_RuntimeTable;
+
+    Ut_CFE_EVS_Reset();
+    Ut_CFE_FS_Reset();
+    Ut_CFE_TIME_Reset();
+    Ut_CFE_TBL_Reset();
+    Ut_CFE_SB_Reset();
+    Ut_CFE_ES_Reset();
+    Ut_OSAPI_Reset();
+    Ut_OSFILEAPI_Reset();
+
+    Ut_CFE_ES_SetFunctionHook(UT_CFE_ES_GETPOOLBUF_INDEX, &HK_Test_GetPoolBufHook);
+} /* end HK_Test_Setup */
+
+void HK_Test_TearDown(void)
+{
+    /* cleanup test environment */
+} /* end HK_Test_TearDown */
+
+/************************/
+/*  End of File Comment */
+/************************/
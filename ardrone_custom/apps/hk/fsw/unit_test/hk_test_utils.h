@@ -0,0 +1,54 @@
+ /*************************************************************************
+ ** File:
+ **   hk_test_utils.h
+ **
+ ** Purpose:
+ **   This file contains the function prototypes and global variables for the
+ **   UT-Assert unit test utilities for the CFS Housekeeping (HK) application.
+ **
+ ** Notes:
+ **
+ *************************************************************************/
+
+#ifndef _hk_test_utils_h_
+#define _hk_test_utils_h_
+
+/*
+ * Includes
+ */
+
+#include "hk_app.h"
+#include "hk_utils.h"
+#include "hk_events.h"
+#include "ut_cfe_evs_hooks.h"
+#include "ut_cfe_sb_hooks.h"
+#include "ut_cfe_time_stubs.h"
+#include "ut_cfe_psp_memutils_stubs.h"
+#include "ut_cfe_tbl_stubs.h"
+#include "ut_cfe_tbl_hooks.h"
+#include "ut_cfe_fs_stubs.h"
+#include "ut_osapi_stubs.h"
+#include "ut_osfileapi_stubs.h"
+#include "ut_cfe_sb_stubs.h"
+#include "ut_cfe_es_stubs.h"
+#include "ut_cfe_evs_stubs.h"
+
+/*
+ * Global Data
+ */
+
+extern hk_copy_table_entry_t   HK_Test_CopyTable [HK_COPY_TABLE_ENTRIES];
+extern hk_runtime_tbl_entry_t  HK_Test_RuntimeTable [HK_COPY_TABLE_ENTRIES];
+
+/*
+ * Function Definitions
+ */
+
+void HK_Test_Setup(void);
+void HK_Test_TearDown(void);
+
+#endif /* _hk_test_utils_h_ */
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -0,0 +1,25 @@
+ /*************************************************************************
+ ** File:
+ **   hk_testrunner.c
+ **
+ ** Purpose:
+ **   This file contains the UT-Assert unit test runner for the CFS
+ **   Housekeeping (HK) application
+ **
+ ** Notes:
+ **
+ *************************************************************************/
+
+#include "uttest.h"
+#include "hk_utils_test.h"
+
+int main(void)
+{
+    HK_Utils_Test_AddTestCases();
+
+    return(UtTest_Run());
+} /* end main */
+
+/************************/
+/*  End of File Comment */
+/************************/
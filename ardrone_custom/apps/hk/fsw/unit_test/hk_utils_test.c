@@ -0,0 +1,263 @@
+ /*************************************************************************
+ ** File:
+ **   hk_utils_test.c
+ **
+ ** Purpose:
+ **   This file contains the unit tests for the copy table index of
+ **   hk_utils.c
+ **
+ ** Notes:
+ **   Every test loads the same copy table:
+ **
+ **     entry  input   offset  output  offset  bytes
+ **       0    0x0900    12    0x0A00    12      4
+ **       1    0x0900    16    0x0A00    16      4   follows on from 0
+ **       2    0x0901    12    0x0A00    20      2
+ **       3    0x0900    24    0x0A00    30      2
+ **       4    0x0902    12      -                   input only
+ **       5      -             0x0A01    12      4   output only
+ **       6    0x0900    20    0x0A01    16      4
+ **
+ *************************************************************************/
+
+#include "hk_utils_test.h"
+#include "hk_test_utils.h"
+
+#define HK_TEST_INPUT_A         0x0900
+#define HK_TEST_INPUT_B         0x0901
+#define HK_TEST_INPUT_ONLY      0x0902
+#define HK_TEST_OUTPUT_X        0x0A00
+#define HK_TEST_OUTPUT_Y        0x0A01
+#define HK_TEST_UNKNOWN_OUTPUT  0x0A05
+#define HK_TEST_INPUT_SIZE      32
+
+/*
+ * Loads the copy table described above
+ */
+static void HK_Utils_Test_LoadTable(void)
+{
+    static const hk_copy_table_entry_t Entries [] =
+    {
+        { HK_TEST_INPUT_A,    12, HK_TEST_OUTPUT_X, 12, 4 },
+        { HK_TEST_INPUT_A,    16, HK_TEST_OUTPUT_X, 16, 4 },
+        { HK_TEST_INPUT_B,    12, HK_TEST_OUTPUT_X, 20, 2 },
+        { HK_TEST_INPUT_A,    24, HK_TEST_OUTPUT_X, 30, 2 },
+        { HK_TEST_INPUT_ONLY, 12, 0,                 0, 0 },
+        { 0,                   0, HK_TEST_OUTPUT_Y, 12, 4 },
+        { HK_TEST_INPUT_A,    20, HK_TEST_OUTPUT_Y, 16, 4 }
+    };
+
+    CFE_PSP_MemCpy(HK_Test_CopyTable, (void *) Entries, sizeof(Entries));
+
+    HK_ProcessNewCopyTable(HK_Test_CopyTable, HK_Test_RuntimeTable);
+} /* end HK_Utils_Test_LoadTable */
+
+/*
+ * Feeds HK an input packet of the given length whose bytes count up from
+ * the end of the header
+ */
+static void HK_Utils_Test_SendInput(CFE_SB_MsgId_t InputMid, uint16 Length, uint8 *Packet)
+{
+    uint16 i;
+
+    CFE_SB_InitMsg(Packet, InputMid, Length, TRUE);
+
+    for (i = CFE_SB_TLM_HDR_SIZE; i < Length; i++)
+    {
+        Packet[i] = (uint8) (i + 1);
+    }
+
+    HK_ProcessIncomingHkData((CFE_SB_MsgPtr_t) Packet);
+} /* end HK_Utils_Test_SendInput */
+
+void HK_ProcessNewCopyTable_Test_Index(void)
+{
+    HK_CopyIndex_t *Index = &HK_AppData.CopyIndex;
+
+    /* Execute the function being tested */
+    HK_Utils_Test_LoadTable();
+
+    /* Verify results */
+    UtAssert_True (Index->NumOutputs == 2, "Index->NumOutputs == 2");
+    UtAssert_True (Index->Outputs[0].OutputMid == HK_TEST_OUTPUT_X, "Index->Outputs[0].OutputMid == HK_TEST_OUTPUT_X");
+    UtAssert_True (Index->Outputs[0].NumBits == 4, "Index->Outputs[0].NumBits == 4");
+    UtAssert_True (Index->Outputs[1].OutputMid == HK_TEST_OUTPUT_Y, "Index->Outputs[1].OutputMid == HK_TEST_OUTPUT_Y");
+    UtAssert_True (Index->Outputs[1].NumBits == 2, "Index->Outputs[1].NumBits == 2");
+    UtAssert_True (Index->NumBits == 6, "Index->NumBits == 6");
+
+    /* Entries 0 and 1 follow on from each other and share a run */
+    UtAssert_True (Index->NumInputs == 2, "Index->NumInputs == 2");
+    UtAssert_True (Index->Inputs[0].InputMid == HK_TEST_INPUT_A, "Index->Inputs[0].InputMid == HK_TEST_INPUT_A");
+    UtAssert_True (Index->Inputs[0].NumRuns == 3, "Index->Inputs[0].NumRuns == 3");
+    UtAssert_True (Index->Inputs[1].InputMid == HK_TEST_INPUT_B, "Index->Inputs[1].InputMid == HK_TEST_INPUT_B");
+    UtAssert_True (Index->Inputs[1].NumRuns == 1, "Index->Inputs[1].NumRuns == 1");
+    UtAssert_True (Index->NumRuns == 4, "Index->NumRuns == 4");
+    UtAssert_True (Index->Runs[Index->Inputs[0].FirstRun].NumEntries == 2, "First run of input A has 2 entries");
+    UtAssert_True (Index->Runs[Index->Inputs[0].FirstRun].NumBytes == 8, "First run of input A has 8 bytes");
+
+    /* The input only entry is subscribed to but has nothing to copy */
+    UtAssert_True (HK_Test_RuntimeTable[4].OutputPktAddr == NULL, "HK_Test_RuntimeTable[4].OutputPktAddr == NULL");
+    UtAssert_True (HK_Test_RuntimeTable[4].InputMidSubscribed == HK_INPUTMID_SUBSCRIBED,
+                   "HK_Test_RuntimeTable[4].InputMidSubscribed == HK_INPUTMID_SUBSCRIBED");
+
+    UtAssert_True (Ut_CFE_EVS_GetEventQueueDepth() == 0, "Ut_CFE_EVS_GetEventQueueDepth() == 0");
+
+} /* end HK_ProcessNewCopyTable_Test_Index */
+
+void HK_ProcessIncomingHkData_Test_CopyRuns(void)
+{
+    uint8          Packet [HK_TEST_INPUT_SIZE];
+    uint8        * OutputX;
+    uint8        * OutputY;
+    CFE_SB_MsgId_t MissingMid = 0;
+
+    HK_Utils_Test_LoadTable();
+    OutputX = (uint8 *) HK_Test_RuntimeTable[0].OutputPktAddr;
+    OutputY = (uint8 *) HK_Test_RuntimeTable[5].OutputPktAddr;
+
+    /* Execute the function being tested */
+    HK_Utils_Test_SendInput(HK_TEST_INPUT_A, HK_TEST_INPUT_SIZE, Packet);
+
+    /* Verify results */
+    UtAssert_True (memcmp(&OutputX[12], &Packet[12], 8) == 0, "Entries 0 and 1 copied");
+    UtAssert_True (memcmp(&OutputX[30], &Packet[24], 2) == 0, "Entry 3 copied");
+    UtAssert_True (memcmp(&OutputY[16], &Packet[20], 4) == 0, "Entry 6 copied");
+    UtAssert_True (OutputX[20] == 0 && OutputX[21] == 0, "Entry 2 not copied");
+
+    UtAssert_True (HK_CheckForMissingData(HK_TEST_OUTPUT_X, &MissingMid) == HK_MISSING_DATA_DETECTED,
+                   "HK_CheckForMissingData(HK_TEST_OUTPUT_X) == HK_MISSING_DATA_DETECTED");
+    UtAssert_True (MissingMid == HK_TEST_INPUT_B, "MissingMid == HK_TEST_INPUT_B");
+
+    HK_Utils_Test_SendInput(HK_TEST_INPUT_B, HK_TEST_INPUT_SIZE, Packet);
+
+    UtAssert_True (memcmp(&OutputX[20], &Packet[12], 2) == 0, "Entry 2 copied");
+    UtAssert_True (HK_CheckForMissingData(HK_TEST_OUTPUT_X, &MissingMid) == HK_NO_MISSING_DATA,
+                   "HK_CheckForMissingData(HK_TEST_OUTPUT_X) == HK_NO_MISSING_DATA");
+
+    /* The output only entry never gets data */
+    UtAssert_True (HK_CheckForMissingData(HK_TEST_OUTPUT_Y, &MissingMid) == HK_MISSING_DATA_DETECTED,
+                   "HK_CheckForMissingData(HK_TEST_OUTPUT_Y) == HK_MISSING_DATA_DETECTED");
+    UtAssert_True (MissingMid == 0, "MissingMid == 0");
+
+    UtAssert_True (Ut_CFE_EVS_GetEventQueueDepth() == 0, "Ut_CFE_EVS_GetEventQueueDepth() == 0");
+
+} /* end HK_ProcessIncomingHkData_Test_CopyRuns */
+
+void HK_ProcessIncomingHkData_Test_InputOnly(void)
+{
+    uint8    Packet [HK_TEST_INPUT_SIZE];
+    uint32   Word;
+    boolean  Clear = TRUE;
+
+    HK_Utils_Test_LoadTable();
+
+    /* Execute the function being tested */
+    HK_Utils_Test_SendInput(HK_TEST_INPUT_ONLY, HK_TEST_INPUT_SIZE, Packet);
+
+    /* Verify results */
+    for (Word = 0; Word < HK_PRESENT_WORDS; Word++)
+    {
+        if (HK_AppData.CopyIndex.Present[Word] != 0)
+        {
+            Clear = FALSE;
+        }
+    }
+
+    UtAssert_True (Clear, "No data present bits set");
+    UtAssert_True (Ut_CFE_EVS_GetEventQueueDepth() == 0, "Ut_CFE_EVS_GetEventQueueDepth() == 0");
+
+} /* end HK_ProcessIncomingHkData_Test_InputOnly */
+
+void HK_ProcessIncomingHkData_Test_ShortPacket(void)
+{
+    uint8          Packet [HK_TEST_INPUT_SIZE];
+    uint8        * OutputX;
+    CFE_SB_MsgId_t MissingMid = 0;
+
+    HK_Utils_Test_LoadTable();
+    OutputX = (uint8 *) HK_Test_RuntimeTable[0].OutputPktAddr;
+
+    /* Execute the function being tested: only entry 0 fits */
+    HK_Utils_Test_SendInput(HK_TEST_INPUT_A, 18, Packet);
+
+    /* Verify results */
+    UtAssert_True (memcmp(&OutputX[12], &Packet[12], 4) == 0, "Entry 0 copied");
+    UtAssert_True (OutputX[16] == 0 && OutputX[19] == 0, "Entry 1 not copied");
+
+    UtAssert_EventSent(HK_ACCESSING_PAST_PACKET_END_EID, CFE_EVS_ERROR,
+                       "HK table definition exceeds packet length. MID:0x0900, Length:18, Count:3",
+                       "HK table definition exceeds packet length. MID:0x0900, Length:18, Count:3");
+    UtAssert_True (Ut_CFE_EVS_GetEventQueueDepth() == 1, "Ut_CFE_EVS_GetEventQueueDepth() == 1");
+
+    UtAssert_True (HK_CheckForMissingData(HK_TEST_OUTPUT_X, &MissingMid) == HK_MISSING_DATA_DETECTED,
+                   "HK_CheckForMissingData(HK_TEST_OUTPUT_X) == HK_MISSING_DATA_DETECTED");
+    UtAssert_True (MissingMid == HK_TEST_INPUT_A, "MissingMid == HK_TEST_INPUT_A");
+
+} /* end HK_ProcessIncomingHkData_Test_ShortPacket */
+
+void HK_SendCombinedHkPacket_Test(void)
+{
+    uint8          Packet [HK_TEST_INPUT_SIZE];
+    CFE_SB_MsgId_t MissingMid = 0;
+
+    HK_Utils_Test_LoadTable();
+    HK_Utils_Test_SendInput(HK_TEST_INPUT_A, HK_TEST_INPUT_SIZE, Packet);
+    HK_Utils_Test_SendInput(HK_TEST_INPUT_B, HK_TEST_INPUT_SIZE, Packet);
+
+    /* Execute the function being tested */
+    HK_SendCombinedHkPacket(HK_TEST_OUTPUT_X);
+
+    /* Verify results */
+    UtAssert_PacketSent(HK_TEST_OUTPUT_X, "Combined packet 0x0A00 sent");
+    UtAssert_True (HK_AppData.CombinedPacketsSent == 1, "HK_AppData.CombinedPacketsSent == 1");
+    UtAssert_True (HK_AppData.MissingDataCtr == 0, "HK_AppData.MissingDataCtr == 0");
+
+    /* Sending the packet clears its data present bits */
+    UtAssert_True (HK_CheckForMissingData(HK_TEST_OUTPUT_X, &MissingMid) == HK_MISSING_DATA_DETECTED,
+                   "HK_CheckForMissingData(HK_TEST_OUTPUT_X) == HK_MISSING_DATA_DETECTED");
+
+    HK_SendCombinedHkPacket(HK_TEST_OUTPUT_Y);
+
+    UtAssert_True (HK_AppData.MissingDataCtr == 1, "HK_AppData.MissingDataCtr == 1");
+    UtAssert_EventSent(HK_OUTPKT_MISSING_DATA_EID, CFE_EVS_DEBUG,
+                       "Combined Packet 0x0A01 missing data from Input Pkt 0x0000",
+                       "Combined Packet 0x0A01 missing data from Input Pkt 0x0000");
+
+    HK_SendCombinedHkPacket(HK_TEST_UNKNOWN_OUTPUT);
+
+    UtAssert_EventSent(HK_UNKNOWN_COMBINED_PACKET_EID, CFE_EVS_INFORMATION,
+                       "Combined HK Packet 0x0A05 is not found in current HK Copy Table",
+                       "Combined HK Packet 0x0A05 is not found in current HK Copy Table");
+
+} /* end HK_SendCombinedHkPacket_Test */
+
+void HK_TearDownOldCopyTable_Test(void)
+{
+    HK_Utils_Test_LoadTable();
+
+    /* Execute the function being tested */
+    HK_TearDownOldCopyTable(HK_Test_CopyTable, HK_Test_RuntimeTable);
+
+    /* Verify results */
+    UtAssert_True (HK_AppData.CopyIndex.NumInputs == 0, "HK_AppData.CopyIndex.NumInputs == 0");
+    UtAssert_True (HK_AppData.CopyIndex.NumOutputs == 0, "HK_AppData.CopyIndex.NumOutputs == 0");
+    UtAssert_True (HK_AppData.CopyIndex.NumRuns == 0, "HK_AppData.CopyIndex.NumRuns == 0");
+    UtAssert_True (HK_Test_RuntimeTable[0].OutputPktAddr == NULL, "HK_Test_RuntimeTable[0].OutputPktAddr == NULL");
+    UtAssert_True (HK_Test_RuntimeTable[4].InputMidSubscribed == HK_INPUTMID_NOT_SUBSCRIBED,
+                   "HK_Test_RuntimeTable[4].InputMidSubscribed == HK_INPUTMID_NOT_SUBSCRIBED");
+
+} /* end HK_TearDownOldCopyTable_Test */
+
+void HK_Utils_Test_AddTestCases(void)
+{
+    UtTest_Add(HK_ProcessNewCopyTable_Test_Index, HK_Test_Setup, HK_Test_TearDown, "HK_ProcessNewCopyTable_Test_Index");
+    UtTest_Add(HK_ProcessIncomingHkData_Test_CopyRuns, HK_Test_Setup, HK_Test_TearDown, "HK_ProcessIncomingHkData_Test_CopyRuns");
+    UtTest_Add(HK_ProcessIncomingHkData_Test_InputOnly, HK_Test_Setup, HK_Test_TearDown, "HK_ProcessIncomingHkData_Test_InputOnly");
+    UtTest_Add(HK_ProcessIncomingHkData_Test_ShortPacket, HK_Test_Setup, HK_Test_TearDown, "HK_ProcessIncomingHkData_Test_ShortPacket");
+    UtTest_Add(HK_SendCombinedHkPacket_Test, HK_Test_Setup, HK_Test_TearDown, "HK_SendCombinedHkPacket_Test");
+    UtTest_Add(HK_TearDownOldCopyTable_Test, HK_Test_Setup, HK_Test_TearDown, "HK_TearDownOldCopyTable_Test");
+} /* end HK_Utils_Test_AddTestCases */
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -0,0 +1,20 @@
+ /*************************************************************************
+ ** File:
+ **   hk_utils_test.h
+ **
+ ** Purpose:
+ **   This file contains the function prototypes for the unit tests for
+ **   hk_utils.c
+ **
+ ** Notes:
+ **
+ *************************************************************************/
+
+#include "utassert.h"
+#include "uttest.h"
+
+void HK_Utils_Test_AddTestCases(void);
+
+/************************/
+/*  End of File Comment */
+/************************/
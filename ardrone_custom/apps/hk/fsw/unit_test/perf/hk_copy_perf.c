@@ -0,0 +1,472 @@
+/*
+** File:
+**   hk_copy_perf.c
+**
+** Purpose:
+**   Housekeeping copy table bench.  Builds a full copy table of
+**   HK_COPY_TABLE_ENTRIES entries, 16 per input packet and 64 per combined
+**   packet, then feeds HK every input packet and asks for every combined
+**   packet, over and over, timing each side:
+**
+**   - scan, what HK did before the copy table index, going through the
+**     whole table for every input packet and every combined packet
+**   - index, HK_ProcessIncomingHkData and HK_SendCombinedHkPacket
+**
+**   The entries of an input packet come in pairs that follow on from each
+**   other in both packets, so the index copies them in 8 runs of 2.  The
+**   bench checks that both fill the combined packets the same way.
+**
+** Notes:
+**   Built by the cFE perf bench Makefile on the real HK copy code, SB, ES
+**   memory pool and OSAL, see cfe-core/unit-test/perf/perf_stubs.c, once
+**   per table size (hk_copy_perf_128, _512 and _2048).
+**   The combined packets go to a pipe the bench drains between rounds.
+**
+**   Usage: hk_copy_perf_<entries> [input packets per run]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cfe.h"
+#include "private/cfe_private.h"
+#include "cfe_sb_priv.h"
+#include "hk_app.h"
+#include "hk_utils.h"
+#include "hk_events.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define HK_COPY_PERF_PER_INPUT      16
+#define HK_COPY_PERF_PER_OUTPUT     64
+#define HK_COPY_PERF_BYTES          4
+#define HK_COPY_PERF_INPUT_SIZE     128
+#define HK_COPY_PERF_INPUT_MID      0x0900
+#define HK_COPY_PERF_OUTPUT_MID     0x0A00
+#define HK_COPY_PERF_INPUTS         (HK_COPY_TABLE_ENTRIES / HK_COPY_PERF_PER_INPUT)
+#define HK_COPY_PERF_OUTPUTS        ((HK_COPY_TABLE_ENTRIES + HK_COPY_PERF_PER_OUTPUT - 1) / \
+                                     HK_COPY_PERF_PER_OUTPUT)
+#define HK_COPY_PERF_STACK_SIZE     16384
+#define HK_COPY_PERF_PRIORITY       100
+
+/*
+** HK global data, hk_app.c is not part of the bench
+*/
+HK_AppData_t HK_AppData;
+
+/*
+** Bench state, shared with the task
+*/
+typedef struct
+{
+    volatile uint32         Running;
+    uint32                  Inputs;
+    boolean                 Scan;
+    boolean                 Same;
+    double                  InputSeconds;
+    double                  OutputSeconds;
+    uint32                  InputsDone;
+    uint32                  OutputsDone;
+} HK_CopyPerf_t;
+
+static HK_CopyPerf_t HK_CopyPerf;
+
+static CFE_SB_PipeId_t        HK_CopyPerfPipe;
+
+static hk_copy_table_entry_t  HK_CopyPerfTable [HK_COPY_TABLE_ENTRIES];
+static hk_runtime_tbl_entry_t HK_CopyPerfRtTable [HK_COPY_TABLE_ENTRIES];
+static uint32                 HK_CopyPerfInput [HK_COPY_PERF_INPUTS][HK_COPY_PERF_INPUT_SIZE / 4];
+
+
+/*
+** Table Services, as much as the HK copy code uses
+*/
+int32 CFE_TBL_GetStatus(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+int32 CFE_TBL_Validate(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+int32 CFE_TBL_ReleaseAddress(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+int32 CFE_TBL_Update(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+int32 CFE_TBL_GetAddress(void **TblPtr, CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+int32 CFE_TBL_DumpToBuffer(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+
+/*
+** The copy table scans HK used before the index, on the run-time table
+** data present flags
+*/
+static void HK_ScanIncomingHkData(CFE_SB_MsgPtr_t MessagePtr)
+{
+    hk_copy_table_entry_t  *CpyTblEntry;
+    hk_runtime_tbl_entry_t *RtTblEntry;
+    CFE_SB_MsgId_t          MessageID = CFE_SB_GetMsgId(MessagePtr);
+    int32                   MessageLength = 0;
+    int32                   MessageErrors = 0;
+    uint16                  Loop;
+
+    for (Loop = 0; Loop < HK_COPY_TABLE_ENTRIES; Loop++)
+    {
+        CpyTblEntry = &HK_AppData.CopyTablePtr[Loop];
+        RtTblEntry = &HK_AppData.RuntimeTablePtr[Loop];
+
+        if (MessageID == CpyTblEntry->InputMid)
+        {
+            MessageLength = CFE_SB_GetTotalMsgLength(MessagePtr);
+            if (MessageLength >= CpyTblEntry->InputOffset + CpyTblEntry->NumBytes)
+            {
+                CFE_PSP_MemCpy((uint8 *) RtTblEntry->OutputPktAddr + CpyTblEntry->OutputOffset,
+                               (uint8 *) MessagePtr + CpyTblEntry->InputOffset,
+                               CpyTblEntry->NumBytes);
+                RtTblEntry->DataPresent = HK_DATA_PRESENT;
+            }
+            else
+            {
+                MessageErrors++;
+            }
+        }
+    }
+
+    if (MessageErrors != 0)
+    {
+        CFE_EVS_SendEvent(HK_ACCESSING_PAST_PACKET_END_EID, CFE_EVS_ERROR,
+                          "HK table definition exceeds packet length. MID:0x%04X, Length:%d, Count:%d",
+                          MessageID, MessageLength, MessageErrors);
+    }
+}
+
+static int32 HK_ScanCheckForMissingData(CFE_SB_MsgId_t OutPkt, CFE_SB_MsgId_t *MissingInputMid)
+{
+    int32 Loop;
+
+    for (Loop = 0; Loop < HK_COPY_TABLE_ENTRIES; Loop++)
+    {
+        if (HK_AppData.RuntimeTablePtr[Loop].OutputPktAddr != NULL &&
+            HK_AppData.CopyTablePtr[Loop].OutputMid == OutPkt &&
+            HK_AppData.RuntimeTablePtr[Loop].DataPresent == HK_DATA_NOT_PRESENT)
+        {
+            *MissingInputMid = HK_AppData.CopyTablePtr[Loop].InputMid;
+            return HK_MISSING_DATA_DETECTED;
+        }
+    }
+
+    return HK_NO_MISSING_DATA;
+}
+
+static void HK_ScanSetFlagsToNotPresent(CFE_SB_MsgId_t OutPkt)
+{
+    int32 Loop;
+
+    for (Loop = 0; Loop < HK_COPY_TABLE_ENTRIES; Loop++)
+    {
+        if (HK_AppData.RuntimeTablePtr[Loop].OutputPktAddr != NULL &&
+            HK_AppData.CopyTablePtr[Loop].OutputMid == OutPkt)
+        {
+            HK_AppData.RuntimeTablePtr[Loop].DataPresent = HK_DATA_NOT_PRESENT;
+        }
+    }
+}
+
+static void HK_ScanSendCombinedHkPacket(CFE_SB_MsgId_t WhichMidToSend)
+{
+    hk_runtime_tbl_entry_t *RtTblEntry;
+    CFE_SB_MsgId_t          InputMidMissing;
+    int32                   Loop;
+
+    for (Loop = 0; Loop < HK_COPY_TABLE_ENTRIES; Loop++)
+    {
+        RtTblEntry = &HK_AppData.RuntimeTablePtr[Loop];
+
+        if (RtTblEntry->OutputPktAddr != NULL &&
+            CFE_SB_GetMsgId(RtTblEntry->OutputPktAddr) == WhichMidToSend)
+        {
+            if (HK_ScanCheckForMissingData(WhichMidToSend, &InputMidMissing) == HK_MISSING_DATA_DETECTED)
+            {
+                HK_AppData.MissingDataCtr++;
+                CFE_EVS_SendEvent(HK_OUTPKT_MISSING_DATA_EID, CFE_EVS_DEBUG,
+                                  "Combined Packet 0x%04X missing data from Input Pkt 0x%04X",
+                                  WhichMidToSend, InputMidMissing);
+            }
+
+            CFE_SB_TimeStampMsg(RtTblEntry->OutputPktAddr);
+            CFE_SB_SendMsg(RtTblEntry->OutputPktAddr);
+            HK_AppData.CombinedPacketsSent++;
+
+            HK_ScanSetFlagsToNotPresent(WhichMidToSend);
+            return;
+        }
+    }
+
+    CFE_EVS_SendEvent(HK_UNKNOWN_COMBINED_PACKET_EID, CFE_EVS_INFORMATION,
+                      "Combined HK Packet 0x%04X is not found in current HK Copy Table",
+                      WhichMidToSend);
+}
+
+
+/* Fills in the copy table and the input packets */
+static void HK_CopyPerfBuildTable(void)
+{
+    hk_copy_table_entry_t *Entry;
+    uint32                 Input;
+    uint32                 Slot;
+    uint32                 Pos;
+    uint32                 i;
+    uint32                 j;
+
+    for (i = 0; i < HK_COPY_TABLE_ENTRIES; i++)
+    {
+        Input = i / HK_COPY_PERF_PER_INPUT;
+        Slot = i % HK_COPY_PERF_PER_INPUT;
+        Pos = (Input / HK_COPY_PERF_OUTPUTS) * HK_COPY_PERF_PER_INPUT + Slot;
+
+        Entry = &HK_CopyPerfTable[i];
+        Entry->InputMid = HK_COPY_PERF_INPUT_MID + Input;
+        Entry->InputOffset = CFE_SB_TLM_HDR_SIZE + (Slot / 2) * 3 * HK_COPY_PERF_BYTES +
+                             (Slot % 2) * HK_COPY_PERF_BYTES;
+        Entry->OutputMid = HK_COPY_PERF_OUTPUT_MID + (Input % HK_COPY_PERF_OUTPUTS);
+        Entry->OutputOffset = CFE_SB_TLM_HDR_SIZE + Pos * HK_COPY_PERF_BYTES;
+        Entry->NumBytes = HK_COPY_PERF_BYTES;
+    }
+
+    for (i = 0; i < HK_COPY_PERF_INPUTS; i++)
+    {
+        CFE_SB_InitMsg(HK_CopyPerfInput[i], HK_COPY_PERF_INPUT_MID + i,
+                       HK_COPY_PERF_INPUT_SIZE, TRUE);
+
+        for (j = CFE_SB_TLM_HDR_SIZE / 4; j < HK_COPY_PERF_INPUT_SIZE / 4; j++)
+        {
+            HK_CopyPerfInput[i][j] = (i << 16) | j;
+        }
+    }
+}
+
+
+/* Feeds HK one round of input packets and asks for one round of combined packets */
+static void HK_CopyPerfRound(boolean Scan, double *InputSeconds, double *OutputSeconds)
+{
+    CFE_SB_MsgPtr_t MsgPtr;
+    double          Start;
+    uint32          i;
+
+    Start = Perf_Now();
+
+    for (i = 0; i < HK_COPY_PERF_INPUTS; i++)
+    {
+        if (Scan)
+        {
+            HK_ScanIncomingHkData((CFE_SB_MsgPtr_t) HK_CopyPerfInput[i]);
+        }
+        else
+        {
+            HK_ProcessIncomingHkData((CFE_SB_MsgPtr_t) HK_CopyPerfInput[i]);
+        }
+    }
+
+    *InputSeconds += Perf_Now() - Start;
+    Start = Perf_Now();
+
+    for (i = 0; i < HK_COPY_PERF_OUTPUTS; i++)
+    {
+        if (Scan)
+        {
+            HK_ScanSendCombinedHkPacket(HK_COPY_PERF_OUTPUT_MID + i);
+        }
+        else
+        {
+            HK_SendCombinedHkPacket(HK_COPY_PERF_OUTPUT_MID + i);
+        }
+    }
+
+    *OutputSeconds += Perf_Now() - Start;
+
+    while (CFE_SB_RcvMsg(&MsgPtr, HK_CopyPerfPipe, CFE_SB_POLL) == CFE_SUCCESS)
+    {
+    }
+}
+
+
+/* Clears the combined packet data */
+static void HK_CopyPerfClearOutputs(void)
+{
+    HK_CopyIndex_t *Index = &HK_AppData.CopyIndex;
+    uint32          Size;
+    uint32          i;
+
+    for (i = 0; i < Index->NumOutputs; i++)
+    {
+        Size = CFE_SB_GetTotalMsgLength(Index->Outputs[i].OutputPktAddr);
+        memset((uint8 *) Index->Outputs[i].OutputPktAddr + CFE_SB_TLM_HDR_SIZE, 0,
+               Size - CFE_SB_TLM_HDR_SIZE);
+    }
+}
+
+
+/* Checks that a round of scan and a round of index leave the same combined packets */
+static boolean HK_CopyPerfSame(void)
+{
+    static uint8    Expect[HK_NUM_BYTES_IN_MEM_POOL];
+    HK_CopyIndex_t *Index = &HK_AppData.CopyIndex;
+    double          Unused = 0;
+    uint32          Size;
+    uint32          Offset = 0;
+    uint32          i;
+
+    HK_CopyPerfClearOutputs();
+    HK_CopyPerfRound(TRUE, &Unused, &Unused);
+
+    for (i = 0; i < Index->NumOutputs; i++)
+    {
+        Size = CFE_SB_GetTotalMsgLength(Index->Outputs[i].OutputPktAddr) - CFE_SB_TLM_HDR_SIZE;
+        memcpy(&Expect[Offset], (uint8 *) Index->Outputs[i].OutputPktAddr + CFE_SB_TLM_HDR_SIZE, Size);
+        Offset += Size;
+    }
+
+    HK_CopyPerfClearOutputs();
+    HK_CopyPerfRound(FALSE, &Unused, &Unused);
+
+    for (Offset = 0, i = 0; i < Index->NumOutputs; i++)
+    {
+        Size = CFE_SB_GetTotalMsgLength(Index->Outputs[i].OutputPktAddr) - CFE_SB_TLM_HDR_SIZE;
+        if (memcmp(&Expect[Offset], (uint8 *) Index->Outputs[i].OutputPktAddr + CFE_SB_TLM_HDR_SIZE,
+                   Size) != 0)
+        {
+            return FALSE;
+        }
+        Offset += Size;
+    }
+
+    return TRUE;
+}
+
+
+/* Runs rounds until HK_CopyPerf.Inputs input packets have gone through */
+static void HK_CopyPerfTask(void)
+{
+    OS_TaskRegister();
+    CFE_SB_RegisterSender();
+
+    HK_CopyPerf.Same = HK_CopyPerfSame();
+
+    while (HK_CopyPerf.InputsDone < HK_CopyPerf.Inputs)
+    {
+        HK_CopyPerfRound(HK_CopyPerf.Scan, &HK_CopyPerf.InputSeconds, &HK_CopyPerf.OutputSeconds);
+        HK_CopyPerf.InputsDone += HK_COPY_PERF_INPUTS;
+        HK_CopyPerf.OutputsDone += HK_COPY_PERF_OUTPUTS;
+    }
+
+    Perf_TaskDone(&HK_CopyPerf.Running);
+}
+
+
+static void HK_CopyPerfRun(boolean Scan, uint32 Inputs)
+{
+    uint32 TaskId;
+    int32  Status;
+
+    memset(&HK_CopyPerf, 0, sizeof(HK_CopyPerf));
+    HK_CopyPerf.Scan = Scan;
+    HK_CopyPerf.Inputs = Inputs;
+    HK_CopyPerf.Running = 1;
+
+    Status = OS_TaskCreate(&TaskId, "HK_COPY_PERF", HK_CopyPerfTask, NULL,
+                           HK_COPY_PERF_STACK_SIZE, HK_COPY_PERF_PRIORITY, 0);
+    if (Status != OS_SUCCESS)
+    {
+        fprintf(stderr, "cannot create task HK_COPY_PERF, error %d\n", (int) Status);
+        exit(1);
+    }
+
+    Perf_WaitTasks(&HK_CopyPerf.Running);
+
+    if (!HK_CopyPerf.Same)
+    {
+        fprintf(stderr, "scan and index combined packets differ\n");
+        exit(1);
+    }
+
+    printf("%-6s %8u %12.1f %14.1f\n", Scan ? "scan" : "index", (unsigned int) HK_COPY_TABLE_ENTRIES,
+           HK_CopyPerf.InputSeconds * 1e9 / HK_CopyPerf.InputsDone,
+           HK_CopyPerf.OutputSeconds * 1e9 / HK_CopyPerf.OutputsDone);
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32 Inputs = 200000;
+    uint32 i;
+
+    if (argc > 1)
+    {
+        Inputs = strtoul(argv[1], NULL, 0);
+    }
+
+    if (OS_API_Init() != OS_SUCCESS || CFE_SB_EarlyInit() != CFE_SUCCESS ||
+        CFE_SB_CreatePipe(&HK_AppData.CmdPipe, HK_PIPE_DEPTH, HK_PIPE_NAME) != CFE_SUCCESS ||
+        CFE_ES_PoolCreate(&HK_AppData.MemPoolHandle, HK_AppData.MemPoolBuffer,
+                          sizeof(HK_AppData.MemPoolBuffer)) != CFE_SUCCESS)
+    {
+        fprintf(stderr, "initialization failed\n");
+        return 1;
+    }
+
+    HK_CopyPerfBuildTable();
+    HK_AppData.CopyTablePtr = HK_CopyPerfTable;
+    HK_AppData.RuntimeTablePtr = HK_CopyPerfRtTable;
+    HK_ProcessNewCopyTable(HK_AppData.CopyTablePtr, HK_AppData.RuntimeTablePtr);
+
+    if (CFE_SB_CreatePipe(&HK_CopyPerfPipe, HK_COPY_PERF_OUTPUTS, "HK_PERF_OUT") != CFE_SUCCESS)
+    {
+        fprintf(stderr, "cannot set up pipe HK_PERF_OUT\n");
+        return 1;
+    }
+
+    for (i = 0; i < HK_COPY_PERF_OUTPUTS; i++)
+    {
+        CFE_SB_Subscribe(HK_COPY_PERF_OUTPUT_MID + i, HK_CopyPerfPipe);
+    }
+
+    printf("HK copy table, %u entries, %u input packets, %u combined packets, %u copy runs\n",
+           (unsigned int) HK_COPY_TABLE_ENTRIES, (unsigned int) HK_AppData.CopyIndex.NumInputs,
+           (unsigned int) HK_AppData.CopyIndex.NumOutputs, (unsigned int) HK_AppData.CopyIndex.NumRuns);
+
+    if (HK_AppData.CopyIndex.NumOutputs != HK_COPY_PERF_OUTPUTS)
+    {
+        fprintf(stderr, "cannot build the combined packets\n");
+        return 1;
+    }
+
+    printf("engine  entries     ns/input    ns/combined\n");
+    HK_CopyPerfRun(TRUE, Inputs);
+    HK_CopyPerfRun(FALSE, Inputs);
+
+    printf("%u events, %u system log messages\n",
+           (unsigned int) Perf_EventCount, (unsigned int) Perf_SysLogCount);
+
+    return 0;
+}
@@ -0,0 +1,32 @@
+/*
+** File:
+**   hk_platform_cfg.h
+**
+** Purpose:
+**   HK platform configuration for hk_copy_perf, found ahead of the HK
+**   platform_inc copy.  The copy table size comes from the bench build,
+**   HK_PERF_ENTRIES, and the memory pool is big enough for the combined
+**   packets of the largest bench table.
+*/
+#ifndef _hk_platform_cfg_h_
+#define _hk_platform_cfg_h_
+
+#define HK_PIPE_DEPTH                   40
+
+#define HK_RCV_BATCH                    16
+
+#define HK_DISCARD_INCOMPLETE_COMBO     0
+
+#define HK_COPY_TABLE_ENTRIES           HK_PERF_ENTRIES
+
+#define HK_NUM_BYTES_IN_MEM_POOL        (32 * 1024)
+
+#define HK_COPY_TABLE_NAME              "CopyTable"
+
+#define HK_RUNTIME_TABLE_NAME           "RuntimeTable"
+
+#define HK_COPY_TABLE_FILENAME          "/cf/apps/hk_cpy_tbl.tbl"
+
+#define HK_MISSION_REV                  0
+
+#endif /* _hk_platform_cfg_h_ */
@@ -192,8 +192,27 @@ typedef struct
          in this table holds the command number of the command that will execute
          first, the second entry has the number of the 2nd cmd, etc.. */
          
-    int32                   AtsCmdIndexBuffer[SC_NUMBER_OF_ATS][SC_MAX_ATS_CMDS]; 
-  
+    int32                   AtsCmdIndexBuffer[SC_NUMBER_OF_ATS][SC_MAX_ATS_CMDS];
+
+    SC_AbsTimeTag_t         AtsSortTime[SC_MAX_ATS_CMDS];
+    /**< \brief Execution time of each ATS command, by command index, read
+         once per build of an ATS time index table */
+
+    uint16                  AtsSortBuffer[SC_MAX_ATS_CMDS];   /**< \brief Work space for sorting ATS commands by time */
+    uint16                  AtsAppendBuffer[SC_MAX_ATS_CMDS]; /**< \brief Appended ATS commands in time order */
+    uint8                   AtsAppendFlag[SC_MAX_ATS_CMDS];
+    /**< \brief Set by #SC_ProcessAppend for each appended command index,
+         cleared when the command is merged into the ATS time index table */
+
+    uint16                  RtsSchedule[SC_NUMBER_OF_RTS + 1];
+    /**< \brief Executing RTS indexes as a binary min-heap on next command
+         time and then RTS number, from entry 1, see #SC_ScheduleRts */
+
+    uint16                  RtsSchedulePos[SC_NUMBER_OF_RTS];
+    /**< \brief Position of each RTS in RtsSchedule, 0 if not executing */
+
+    uint16                  RtsScheduleCount; /**< \brief Number of RTS in RtsSchedule */
+
     uint8                   NextProcNumber;   /**< \brief the next command processor number */
     SC_AbsTimeTag_t         NextCmdTime[2];   /**< \brief The overall next command time  0 - ATP, 1- RTP*/
     SC_AbsTimeTag_t         CurrentTime;      /**< \brief this is the current time for SC */
@@ -69,6 +69,7 @@
 #include "cfe.h"
 #include "sc_app.h"
 #include "sc_atsrq.h"
+#include "sc_state.h"
 #include "sc_utils.h"
 #include "sc_events.h"
 
@@ -121,24 +122,69 @@ boolean SC_ParseRts (uint16 Buffer []);
 void SC_BuildTimeIndexTable (uint16 AtsIndex);
 
 /************************************************************************/
-/** \brief Inserts an item in a sorted list
+/** \brief Merges appended commands into the time index buffer for the ATS
  **  
  **  \par Description
- **            This function will insert a new element into the list of
- **            ATS commands sorted by execution time.       
+ **            This routine updates the ATS Time Index Table after an Append
+ **            ATS table has been added to the ATS.  The appended commands,
+ **            flagged in #SC_AppData_t::AtsAppendFlag, are taken out of the
+ **            existing time ordered list in case they replaced a command,
+ **            sorted by time and merged back in.  The result is the same
+ **            as rebuilding the table with #SC_BuildTimeIndexTable.
  **       
  **  \par Assumptions, External Events, and Notes:
  **        None
  **
- **  \param [in]    AtsIndex        ATS array index selection
+ **  \param [in]    AtsIndex        ATS array index
+ **
+ **
+ *************************************************************************/
+void SC_MergeTimeIndexTable (uint16 AtsIndex);
+
+/************************************************************************/
+/** \brief Sorts a list of ATS commands by execution time
+ **  
+ **  \par Description
+ **            This function sorts a list of ATS command indexes by the
+ **            execution times in #SC_AppData_t::AtsSortTime, commands with
+ **            the same time in command number order, using a bottom up
+ **            merge sort.       
+ **       
+ **  \par Assumptions, External Events, and Notes:
+ **        None
+ **
+ **  \param [in]    List            List of ATS command indexes to sort
  **
- **  \param [in]    NewCmdIndex     ATS command index for new list element
+ **  \param [in]    Scratch         Work space as long as the list
  ** 
- **  \param [in]    ListLength      Number of elements currently in list
+ **  \param [in]    ListLength      Number of elements in list
+ **
+ **
+ *************************************************************************/
+void SC_SortTimeIndex (uint16 *List, uint16 *Scratch, int32 ListLength);
+
+/************************************************************************/
+/** \brief Tests whether one ATS command executes before another
+ **  
+ **  \par Description
+ **            Compares the execution times of two ATS commands in
+ **            #SC_AppData_t::AtsSortTime.  Commands with the same execution
+ **            time are ordered by command number.       
+ **       
+ **  \par Assumptions, External Events, and Notes:
+ **        None
+ **
+ **  \param [in]    CmdIndexA       ATS command index (cmd num - 1)
+ **
+ **  \param [in]    CmdIndexB       ATS command index (cmd num - 1)
  **
+ **  \returns
+ **  \retstmt Returns TRUE if command A executes before command B  \endcode
+ **  \retstmt Returns FALSE otherwise \endcode
+ **  \endreturns
  **
  *************************************************************************/
-void SC_Insert (uint16 AtsIndex, int32 NewCmdIndex, int32 ListLength);
+boolean SC_CmdExecutesBefore (uint16 CmdIndexA, uint16 CmdIndexB);
 
 /************************************************************************/
 /** \brief Initializes ATS tables before a load starts
@@ -342,100 +388,241 @@ void SC_LoadAts (uint16 AtsIndex)
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 void SC_BuildTimeIndexTable (uint16 AtsIndex)
 {
+    SC_AtsEntryHeader_t *Entry;         /* ATS table entry pointer */
     int32 i;
+    int32 EntryIndex;                   /* ATS entry location in table */
     int32 ListLength;
 
-    /* initialize sorted list contents */
-    for (i = 0; i < SC_MAX_ATS_CMDS; i++)
-    {
-        SC_AppData.AtsTimeIndexBuffer[AtsIndex][i] = SC_ERROR;
-    }
-    
     /* initialize sorted list length */
     ListLength = 0;
 
-    /* create time sorted list */
+    /* list the in-use command entries, reading each execution time once */
     for (i = 0; i < SC_MAX_ATS_CMDS; i++)
     {
-        /* add in-use command entries to time sorted list */
-        if (SC_AppData.AtsCmdIndexBuffer[AtsIndex][i] != SC_ERROR)
+        EntryIndex = SC_AppData.AtsCmdIndexBuffer[AtsIndex][i];
+
+        if (EntryIndex != SC_ERROR)
         { 
-            SC_Insert(AtsIndex, i, ListLength);
+            Entry = (SC_AtsEntryHeader_t *) &SC_OperData.AtsTblAddr[AtsIndex][EntryIndex];
+            SC_AppData.AtsSortTime[i] = SC_GetAtsEntryTime(Entry);
+
+            SC_AppData.AtsTimeIndexBuffer[AtsIndex][ListLength] = i;
             ListLength++;   
         }
     }
 
+    /* create time sorted list */
+    SC_SortTimeIndex(SC_AppData.AtsTimeIndexBuffer[AtsIndex], SC_AppData.AtsSortBuffer, ListLength);
+
+    /* initialize the rest of the sorted list contents */
+    for (i = ListLength; i < SC_MAX_ATS_CMDS; i++)
+    {
+        SC_AppData.AtsTimeIndexBuffer[AtsIndex][i] = SC_ERROR;
+    }
+
 } /* end SC_BuildTimeIndexTable */
 
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                 */
-/*  Inserts and element into a sorted list                         */
+/* Merges appended commands into the time table for the ATS buffer */
 /*                                                                 */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
-void SC_Insert (uint16 AtsIndex, int32 NewCmdIndex, int32 ListLength)
+void SC_MergeTimeIndexTable (uint16 AtsIndex)
 {
     SC_AtsEntryHeader_t *Entry;         /* ATS table entry pointer */
-    SC_AbsTimeTag_t      NewCmdTime=0;    /* new command execution time */
-    SC_AbsTimeTag_t      ListCmdTime;   /* list entry execution time */
-    int32                CmdIndex;      /* ATS command index (cmd num - 1) */
-    int32                EntryIndex;    /* ATS entry location in table */
-    int32                TimeBufIndex;  /* this must be signed */        
-
-    /* get execution time for new list entry */
-    if (ListLength > 0)
+    uint16 *TimeIndex;                  /* time sorted list for this ATS */
+    uint16  CmdIndex;                   /* ATS command index (cmd num - 1) */
+    int32   i;
+    int32   EntryIndex;                 /* ATS entry location in table */
+    int32   OldLength;                  /* commands kept from the existing list */
+    int32   AppendLength;               /* commands appended */
+    int32   ListLength;
+
+    TimeIndex = SC_AppData.AtsTimeIndexBuffer[AtsIndex];
+
+    /* 
+    ** Keep the existing list entries that were not appended over, reading
+    ** their execution times 
+    */
+    OldLength = 0;
+
+    for (i = 0; (i < SC_MAX_ATS_CMDS) && (TimeIndex[i] != (uint16) SC_ERROR); i++)
     {
-        /* first get the entry index in the selected ATS table for the new command */
-        EntryIndex = SC_AppData.AtsCmdIndexBuffer[AtsIndex][NewCmdIndex];
-        /* then get a pointer to the ATS entry */
-        Entry = (SC_AtsEntryHeader_t *) &SC_OperData.AtsTblAddr[AtsIndex][EntryIndex];
-        /* then get the execution time from the ATS entry for the new command */
-        NewCmdTime = SC_GetAtsEntryTime(Entry);
+        CmdIndex = TimeIndex[i];
+
+        if (!SC_AppData.AtsAppendFlag[CmdIndex])
+        {
+            EntryIndex = SC_AppData.AtsCmdIndexBuffer[AtsIndex][CmdIndex];
+            Entry = (SC_AtsEntryHeader_t *) &SC_OperData.AtsTblAddr[AtsIndex][EntryIndex];
+            SC_AppData.AtsSortTime[CmdIndex] = SC_GetAtsEntryTime(Entry);
+
+            TimeIndex[OldLength] = CmdIndex;
+            OldLength++;
+        }
     }
 
-    /* start at last element in the sorted by time list */
-    TimeBufIndex = ListLength - 1;
+    /* list the appended commands once each, clearing their flags */
+    AppendLength = 0;
 
-    while (TimeBufIndex >= 0)
+    for (i = 0; i < SC_MAX_ATS_CMDS; i++)
     {
-        /* first get the cmd index for this list entry */
-        CmdIndex = SC_AppData.AtsTimeIndexBuffer[AtsIndex][TimeBufIndex];
-        /* then get the entry index from the ATS table */
-        EntryIndex = SC_AppData.AtsCmdIndexBuffer[AtsIndex][CmdIndex];
-        /* then get a pointer to the ATS entry data */
-        Entry = (SC_AtsEntryHeader_t *) &SC_OperData.AtsTblAddr[AtsIndex][EntryIndex];
-        /* then get cmd execution time from the ATS entry */
-        ListCmdTime = SC_GetAtsEntryTime(Entry);
-
-        /* compare time for this list entry to time for new cmd */
-        if (SC_CompareAbsTime(ListCmdTime, NewCmdTime))
+        if (SC_AppData.AtsAppendFlag[i])
         {
-            /* new cmd will execute before this list entry */
+            SC_AppData.AtsAppendFlag[i] = FALSE;
 
-            /* move this list entry to make room for new cmd */
-            SC_AppData.AtsTimeIndexBuffer[AtsIndex][TimeBufIndex + 1] =
-               SC_AppData.AtsTimeIndexBuffer[AtsIndex][TimeBufIndex];
+            EntryIndex = SC_AppData.AtsCmdIndexBuffer[AtsIndex][i];
+            Entry = (SC_AtsEntryHeader_t *) &SC_OperData.AtsTblAddr[AtsIndex][EntryIndex];
+            SC_AppData.AtsSortTime[i] = SC_GetAtsEntryTime(Entry);
 
-            /* back up to previous list entry (ok if -1) */
-            TimeBufIndex--;
+            SC_AppData.AtsAppendBuffer[AppendLength] = i;
+            AppendLength++;
+        }
+    }
+
+    SC_SortTimeIndex(SC_AppData.AtsAppendBuffer, SC_AppData.AtsSortBuffer, AppendLength);
+
+    /*
+    ** Merge the two lists from the back, so the existing list can be 
+    ** merged into in place
+    */
+    ListLength = OldLength + AppendLength;
+
+    for (i = ListLength - 1; AppendLength > 0; i--)
+    {
+        if ((OldLength > 0) &&
+            SC_CmdExecutesBefore(SC_AppData.AtsAppendBuffer[AppendLength - 1], TimeIndex[OldLength - 1]))
+        {
+            TimeIndex[i] = TimeIndex[OldLength - 1];
+            OldLength--;
         }
         else
         {
-            /* new cmd will execute at same time or after this list entry */
+            TimeIndex[i] = SC_AppData.AtsAppendBuffer[AppendLength - 1];
+            AppendLength--;
+        }
+    }
+
+    /* initialize the rest of the sorted list contents */
+    for (i = ListLength; i < SC_MAX_ATS_CMDS; i++)
+    {
+        TimeIndex[i] = SC_ERROR;
+    }
+
+} /* end SC_MergeTimeIndexTable */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/*  Sorts a list of ATS commands by execution time                 */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void SC_SortTimeIndex (uint16 *List, uint16 *Scratch, int32 ListLength)
+{
+    uint16 *From;                       /* runs to be merged */
+    uint16 *To;                         /* merged runs */
+    uint16 *Swap;
+    int32   Width;                      /* length of the runs being merged */
+    int32   Start;
+    int32   Middle;
+    int32   End;
+    int32   Left;
+    int32   Right;
+    int32   i;
+
+    /* ATS loads are usually in time order already, and need no merging */
+    for (i = 1; i < ListLength; i++)
+    {
+        if (SC_CmdExecutesBefore(List[i], List[i - 1]))
+        {
             break;
         }
     }
 
-    /*
-    ** TimeBufIndex is now one slot before the target slot...
-    **   if new cmd time is earlier than all other entries
-    **     then TimeBufIndex is -1 and all others have been moved
-    **   else only entries with later times have been moved
-    ** In either case, there is an empty slot next to TimeBufIndex
-    */    
-    SC_AppData.AtsTimeIndexBuffer[AtsIndex][TimeBufIndex + 1] = NewCmdIndex;
+    if (i >= ListLength)
+    {
+        return;
+    }
+
+    From = List;
+    To   = Scratch;
+
+    /* merge pairs of sorted runs of Width commands into runs of 2 * Width */
+    for (Width = 1; Width < ListLength; Width *= 2)
+    {
+        for (Start = 0; Start < ListLength; Start += 2 * Width)
+        {
+            Middle = Start + Width;
+            End    = Start + 2 * Width;
+
+            if (Middle > ListLength)
+            {
+                Middle = ListLength;
+            }
+
+            if (End > ListLength)
+            {
+                End = ListLength;
+            }
+
+            Left  = Start;
+            Right = Middle;
 
-} /* end SC_Insert */
+            for (i = Start; i < End; i++)
+            {
+                /* take from the right run only if it executes strictly first */
+                if ((Right < End) &&
+                    ((Left >= Middle) || SC_CmdExecutesBefore(From[Right], From[Left])))
+                {
+                    To[i] = From[Right];
+                    Right++;
+                }
+                else
+                {
+                    To[i] = From[Left];
+                    Left++;
+                }
+            }
+        }
+
+        Swap = From;
+        From = To;
+        To   = Swap;
+    }
+
+    /* the sorted list ends up in the scratch buffer after an odd number of passes */
+    if (From != List)
+    {
+        CFE_PSP_MemCpy(List, From, ListLength * sizeof(uint16));
+    }
+
+} /* end SC_SortTimeIndex */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/*  Tests whether one ATS command executes before another          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+boolean SC_CmdExecutesBefore (uint16 CmdIndexA, uint16 CmdIndexB)
+{
+    SC_AbsTimeTag_t TimeA = SC_AppData.AtsSortTime[CmdIndexA];
+    SC_AbsTimeTag_t TimeB = SC_AppData.AtsSortTime[CmdIndexB];
+
+    if (SC_CompareAbsTime(TimeB, TimeA))
+    {
+        return TRUE;
+    }
+
+    if (SC_CompareAbsTime(TimeA, TimeB))
+    {
+        return FALSE;
+    }
+
+    /* same execution time, the lower command number goes first */
+    return (CmdIndexA < CmdIndexB);
+
+} /* end SC_CmdExecutesBefore */
 
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -469,6 +656,9 @@ void SC_InitAtsTables (uint16 AtsIndex)
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 void SC_LoadRts (uint16 RtsIndex)
 {    
+    /* New RTS table data stops the RTS if it was executing */
+    SC_UnscheduleRts(RtsIndex);
+
     /* Clear out the RTS info table */
     SC_OperData.RtsInfoTblAddr[RtsIndex].RtsStatus = SC_LOADED;
     SC_OperData.RtsInfoTblAddr[RtsIndex].UseCtr = 0;
@@ -776,6 +966,9 @@ void SC_ProcessAppend (uint16 AtsIndex)
             SC_OperData.AtsInfoTblAddr[AtsIndex].NumberOfCommands++;
         }
 
+        /* flag the command to be merged into the time sorted list */
+        SC_AppData.AtsAppendFlag[CmdIndex] = TRUE;
+
         /* update array of pointers to ats entries */
         SC_AppData.AtsCmdIndexBuffer[AtsIndex][CmdIndex] = EntryIndex;
         SC_OperData.AtsCmdStatusTblAddr[AtsIndex][CmdIndex] = SC_LOADED;
@@ -787,8 +980,8 @@ void SC_ProcessAppend (uint16 AtsIndex)
         EntryIndex += (SC_ATS_HDR_NOPKT_WORDS + CommandWords);
     }
 
-    /* rebuild time sorted list of commands */
-    SC_BuildTimeIndexTable(AtsIndex);
+    /* merge the appended commands into the time sorted list */
+    SC_MergeTimeIndexTable(AtsIndex);
 
     /* did we just append to an ats that was executing? */
     if ((SC_OperData.AtsCtrlBlckAddr->AtpState == SC_EXECUTING) &&
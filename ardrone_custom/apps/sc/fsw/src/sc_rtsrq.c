@@ -53,6 +53,7 @@
 #include "cfe.h"
 #include "sc_app.h"
 #include "sc_rtsrq.h"
+#include "sc_state.h"
 #include "sc_utils.h"
 #include "sc_events.h"
 #include "sc_msgids.h"
@@ -121,6 +122,7 @@ void SC_StartRtsCmd (CFE_SB_MsgPtr_t CmdPacket)
                          */
                         SC_OperData.RtsInfoTblAddr[RtsIndex].NextCommandTime  = 
                             SC_ComputeAbsTime(RtsEntryPtr->TimeTag);
+                        SC_ScheduleRts(RtsIndex);
 
                         
                         /*
@@ -246,6 +248,7 @@ void SC_StartRtsGrpCmd (CFE_SB_MsgPtr_t CmdPacket)
                     /* get absolute time for 1st cmd in the RTS */
                     SC_OperData.RtsInfoTblAddr[RtsIndex].NextCommandTime  = 
                        SC_ComputeAbsTime(((SC_RtsEntryHeader_t *) SC_OperData.RtsTblAddr[RtsIndex])->TimeTag);
+                    SC_ScheduleRts(RtsIndex);
 
                     /* maintain counters associated with starting RTS */
                     SC_OperData.RtsCtrlBlckAddr->NumRtsActive++;
@@ -594,6 +597,7 @@ void SC_KillRts (uint16 RtsIndex)
          */
         SC_OperData.RtsInfoTblAddr[RtsIndex].RtsStatus = SC_LOADED;
         SC_OperData.RtsInfoTblAddr[RtsIndex].NextCommandTime = SC_MAX_TIME;
+        SC_UnscheduleRts(RtsIndex);
         
         /*
          ** Note: the rest of the fields are left alone
@@ -65,42 +65,25 @@
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 void SC_GetNextRtsTime (void)
 {
-    
-    int16               i;          /* loop counter MUST be SIGNED !*/
     uint16              NextRts;    /* the next rts to schedule */
-    SC_AbsTimeTag_t     NextTime;   /* the next time for the RTS */
 
-    NextRts = 0xFFFF;
-    NextTime = SC_MAX_TIME;
-        
     /*
-     ** Go through the table backwards to account for the RTS priority 
-     ** Lower number RTS's get higher priority
+     ** The RTS schedule keeps the executing RTS that runs next at
+     ** the top, accounting for the RTS priority
      */
-    for (i = SC_NUMBER_OF_RTS - 1; i >= 0; i--)
-    {
-        if (SC_OperData.RtsInfoTblAddr[i].RtsStatus == SC_EXECUTING)
-        {   
-            if (SC_OperData.RtsInfoTblAddr[i].NextCommandTime <= NextTime)
-            {       
-                NextTime = SC_OperData.RtsInfoTblAddr[i].NextCommandTime;
-                NextRts = i;   
-            } /* end if */ 
-        } /* end if */ 
-    } /* end for */
-    
-    if (NextRts == 0xFFFF)
+    if (SC_AppData.RtsScheduleCount == 0)
     {
         SC_OperData.RtsCtrlBlckAddr -> RtsNumber = SC_INVALID_RTS_NUMBER;
         SC_AppData.NextCmdTime[SC_RTP] = SC_MAX_TIME;
     }
     else
     {
+        NextRts = SC_AppData.RtsSchedule[1];
+
         SC_OperData.RtsCtrlBlckAddr -> RtsNumber = NextRts + 1;
-        SC_AppData.NextCmdTime[SC_RTP] = NextTime;
+        SC_AppData.NextCmdTime[SC_RTP] = SC_OperData.RtsInfoTblAddr[NextRts].NextCommandTime;
     } /* end if */
     
-    
 } /* end SC_GetNextRtsTime */
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -241,6 +224,7 @@ void SC_GetNextRtsCommand(void)
                              */
                             SC_OperData.RtsInfoTblAddr[RtsNum].NextCommandTime = 
                             SC_ComputeAbsTime(RtsEntryPtr->TimeTag);
+                            SC_ScheduleRts(RtsNum);
                             
                             /*
                              ** Update the appropriate RTS info table current command pointer
@@ -394,6 +378,132 @@ void SC_GetNextAtsCommand(void)
     
 } /* end SC_GetNextAtsCommand */
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Puts an executing RTS in its place in the RTS schedule          */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void SC_ScheduleRts (uint16 RtsIndex)
+{
+    uint16 Position;
+
+    Position = SC_AppData.RtsSchedulePos[RtsIndex];
+
+    if (Position == 0)
+    {
+        /* add the RTS at the bottom of the schedule */
+        SC_AppData.RtsScheduleCount++;
+        Position = SC_AppData.RtsScheduleCount;
+
+        SC_AppData.RtsSchedule[Position] = RtsIndex;
+        SC_AppData.RtsSchedulePos[RtsIndex] = Position;
+    }
+
+    SC_SiftRtsSchedule(Position);
+
+} /* end SC_ScheduleRts */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Takes an RTS out of the RTS schedule                            */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void SC_UnscheduleRts (uint16 RtsIndex)
+{
+    uint16 Position;
+    uint16 LastRts;
+
+    Position = SC_AppData.RtsSchedulePos[RtsIndex];
+
+    if (Position != 0)
+    {
+        SC_AppData.RtsSchedulePos[RtsIndex] = 0;
+
+        /* fill the hole with the RTS from the bottom of the schedule */
+        LastRts = SC_AppData.RtsSchedule[SC_AppData.RtsScheduleCount];
+        SC_AppData.RtsScheduleCount--;
+
+        if (LastRts != RtsIndex)
+        {
+            SC_AppData.RtsSchedule[Position] = LastRts;
+            SC_AppData.RtsSchedulePos[LastRts] = Position;
+
+            SC_SiftRtsSchedule(Position);
+        }
+    }
+
+} /* end SC_UnscheduleRts */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Moves an RTS schedule entry up or down to its place             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void SC_SiftRtsSchedule (uint16 Position)
+{
+    uint16 *Schedule = SC_AppData.RtsSchedule;
+    uint16  RtsIndex;
+    uint16  Parent;
+    uint16  Child;
+
+    RtsIndex = Schedule[Position];
+
+    /* move up past any RTS that runs after this one */
+    while (Position > 1)
+    {
+        Parent = Position / 2;
+
+        if (!SC_RtsRunsBefore(RtsIndex, Schedule[Parent]))
+        {
+            break;
+        }
+
+        Schedule[Position] = Schedule[Parent];
+        SC_AppData.RtsSchedulePos[Schedule[Position]] = Position;
+        Position = Parent;
+    }
+
+    /* move down past any RTS that runs before this one */
+    while ((Position * 2) <= SC_AppData.RtsScheduleCount)
+    {
+        Child = Position * 2;
+
+        if ((Child < SC_AppData.RtsScheduleCount) &&
+            SC_RtsRunsBefore(Schedule[Child + 1], Schedule[Child]))
+        {
+            Child++;
+        }
+
+        if (!SC_RtsRunsBefore(Schedule[Child], RtsIndex))
+        {
+            break;
+        }
+
+        Schedule[Position] = Schedule[Child];
+        SC_AppData.RtsSchedulePos[Schedule[Position]] = Position;
+        Position = Child;
+    }
+
+    Schedule[Position] = RtsIndex;
+    SC_AppData.RtsSchedulePos[RtsIndex] = Position;
+
+} /* end SC_SiftRtsSchedule */
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* Tests whether one executing RTS runs before another             */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+boolean SC_RtsRunsBefore (uint16 RtsIndexA, uint16 RtsIndexB)
+{
+    SC_AbsTimeTag_t TimeA = SC_OperData.RtsInfoTblAddr[RtsIndexA].NextCommandTime;
+    SC_AbsTimeTag_t TimeB = SC_OperData.RtsInfoTblAddr[RtsIndexB].NextCommandTime;
+
+    /* Lower number RTS's get higher priority */
+    return ((TimeA < TimeB) || ((TimeA == TimeB) && (RtsIndexA < RtsIndexB)));
+
+} /* end SC_RtsRunsBefore */
+
 
 /************************/
 /*  End of File Comment */
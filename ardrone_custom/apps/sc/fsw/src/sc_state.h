@@ -39,9 +39,9 @@
 /** \brief Gets the next time for an RTS command to run
  **  
  **  \par Description
- **         This function searches the RTS info table to find
- **         the next RTS that needs to run based on the time that the
- **         rts needs to run and it's priority.       
+ **         This function takes the next RTS that needs to run, based on
+ **         the time that the rts needs to run and it's priority, from
+ **         the top of the RTS schedule (#SC_ScheduleRts).       
  **       
  **       
  **       
@@ -100,6 +100,77 @@ void SC_GetNextRtsCommand (void);
  *************************************************************************/
 void SC_GetNextAtsCommand (void);
 
+/************************************************************************/
+/** \brief Puts an executing RTS in its place in the RTS schedule
+ **  
+ **  \par Description
+ **         The RTS schedule is a binary min-heap of the executing RTS,
+ **         ordered by next command time and then by RTS number, so
+ **         #SC_GetNextRtsTime finds the next RTS to run at the top.
+ **         This routine adds the RTS to the schedule, or moves it if it
+ **         is already there, and must be called whenever an executing
+ **         RTS gets a new next command time.
+ **       
+ **  \par Assumptions, External Events, and Notes:
+ **        The RTS status must be #SC_EXECUTING
+ **
+ **  \param [in]    RtsIndex        RTS array index
+ **
+ *************************************************************************/
+void SC_ScheduleRts (uint16 RtsIndex);
+
+/************************************************************************/
+/** \brief Takes an RTS out of the RTS schedule
+ **  
+ **  \par Description
+ **         This routine is called when an RTS stops executing.  It does
+ **         nothing if the RTS is not in the schedule.
+ **       
+ **  \par Assumptions, External Events, and Notes:
+ **        None
+ **
+ **  \param [in]    RtsIndex        RTS array index
+ **
+ *************************************************************************/
+void SC_UnscheduleRts (uint16 RtsIndex);
+
+/************************************************************************/
+/** \brief Moves an RTS schedule entry up or down to its place
+ **  
+ **  \par Description
+ **         Restores the RTS schedule order after the entry at the given
+ **         heap position has been added, changed or replaced.
+ **       
+ **  \par Assumptions, External Events, and Notes:
+ **        None
+ **
+ **  \param [in]    Position        RTS schedule position, 1 is the top
+ **
+ *************************************************************************/
+void SC_SiftRtsSchedule (uint16 Position);
+
+/************************************************************************/
+/** \brief Tests whether one executing RTS runs before another
+ **  
+ **  \par Description
+ **         The RTS with the earlier next command time runs first. At the
+ **         same time the lower numbered RTS has priority.
+ **       
+ **  \par Assumptions, External Events, and Notes:
+ **        None
+ **
+ **  \param [in]    RtsIndexA       RTS array index
+ **
+ **  \param [in]    RtsIndexB       RTS array index
+ **
+ **  \returns
+ **  \retstmt Returns TRUE if RTS A runs before RTS B  \endcode
+ **  \retstmt Returns FALSE otherwise \endcode
+ **  \endreturns
+ **
+ *************************************************************************/
+boolean SC_RtsRunsBefore (uint16 RtsIndexA, uint16 RtsIndexB);
+
 
 
 #endif /* _sc_state_ */
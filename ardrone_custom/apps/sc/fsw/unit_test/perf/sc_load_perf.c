@@ -0,0 +1,429 @@
+/*
+** File:
+**   sc_load_perf.c
+**
+** Purpose:
+**   Stored Command ATS load bench.  Fills an ATS with SC_MAX_ATS_CMDS of
+**   the smallest commands, with execution times in order, in reverse order
+**   and at random, and times building the ATS time index table:
+**
+**   - insert, what SC did before, inserting one command at a time into
+**     the sorted list and reading the execution times again on each pass
+**   - sort, SC_BuildTimeIndexTable
+**
+**   then appends 1 in 16 commands to a loaded ATS, half of them replacing
+**   commands already loaded, and times putting them in the table by a
+**   full rebuild against SC_MergeTimeIndexTable.  The bench checks that
+**   every way builds the same table, and that SC_LoadAts and
+**   SC_ProcessAppend do too.
+**
+** Notes:
+**   Built by the cFE perf bench Makefile on the real SC load code, see
+**   cfe-core/unit-test/perf/perf_stubs.c, once per ATS size
+**   (sc_load_perf_1000, _2000, _4000 and _8000), with its own SC platform
+**   configuration, sc_platform_cfg.h next to this file.  An ATS holds at
+**   most 9362 commands, the 65535 word buffer over 7 word entries.  The
+**   CFE_TIME_Compare and CFE_TIME_Add stand-ins are copies of the real ones.
+**
+**   Usage: sc_load_perf_<cmds> [seconds per measurement]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cfe.h"
+#include "sc_app.h"
+#include "sc_loads.h"
+#include "sc_utils.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define SC_LOAD_PERF_MID            0x18A9
+#define SC_LOAD_PERF_CMD_SIZE       SC_PACKET_MIN_SIZE
+#define SC_LOAD_PERF_ENTRY_WORDS    (SC_ATS_HDR_NOPKT_WORDS + (SC_LOAD_PERF_CMD_SIZE / 2))
+#define SC_LOAD_PERF_APPENDS        (SC_MAX_ATS_CMDS / 16)
+#define SC_LOAD_PERF_BASE_TIME      1000000000
+#define SC_LOAD_PERF_ATS            0
+#define SC_LOAD_PERF_NEGATIVE       0x80000000  /* CFE_TIME_NEGATIVE */
+
+/*
+** SC load code the bench calls, sc_loads.c keeps the prototypes
+*/
+void SC_BuildTimeIndexTable(uint16 AtsIndex);
+void SC_MergeTimeIndexTable(uint16 AtsIndex);
+
+/*
+** SC global data, sc_app.c is not part of the bench
+*/
+SC_AppData_t  SC_AppData;
+SC_OperData_t SC_OperData;
+
+/*
+** The SC tables the load code works on
+*/
+static uint16               SC_LoadPerfAts [SC_ATS_BUFF_SIZE];
+static uint16               SC_LoadPerfAppendTbl [SC_APPEND_BUFF_SIZE];
+static uint8                SC_LoadPerfCmdStatus [SC_MAX_ATS_CMDS];
+static SC_AtsInfoTable_t    SC_LoadPerfAtsInfo [SC_NUMBER_OF_ATS];
+static SC_AtpControlBlock_t SC_LoadPerfAtpCtrl;
+
+/* Time index tables to check against */
+static uint16 SC_LoadPerfExpect [SC_MAX_ATS_CMDS];
+static uint16 SC_LoadPerfLoaded [SC_MAX_ATS_CMDS];
+
+static uint32 SC_LoadPerfSeed = 1;
+
+static double SC_LoadPerfSeconds = 0.2;
+
+
+/*
+** Table and Time Services and the rest of SC, as much as the SC load
+** code uses
+*/
+int32 CFE_TBL_Modified(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+boolean SC_BeginAts(uint16 AtsIndex, uint16 TimeOffset)
+{
+    return TRUE;
+}
+
+void SC_UnscheduleRts(uint16 RtsIndex)
+{
+}
+
+CFE_TIME_Compare_t CFE_TIME_Compare(CFE_TIME_SysTime_t TimeA, CFE_TIME_SysTime_t TimeB)
+{
+    if (TimeA.Seconds > TimeB.Seconds)
+    {
+        return ((TimeA.Seconds - TimeB.Seconds) > SC_LOAD_PERF_NEGATIVE) ? CFE_TIME_A_LT_B : CFE_TIME_A_GT_B;
+    }
+
+    if (TimeA.Seconds < TimeB.Seconds)
+    {
+        return ((TimeB.Seconds - TimeA.Seconds) > SC_LOAD_PERF_NEGATIVE) ? CFE_TIME_A_GT_B : CFE_TIME_A_LT_B;
+    }
+
+    if (TimeA.Subseconds > TimeB.Subseconds)
+    {
+        return CFE_TIME_A_GT_B;
+    }
+
+    if (TimeA.Subseconds < TimeB.Subseconds)
+    {
+        return CFE_TIME_A_LT_B;
+    }
+
+    return CFE_TIME_EQUAL;
+}
+
+CFE_TIME_SysTime_t CFE_TIME_Add(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2)
+{
+    CFE_TIME_SysTime_t Result;
+
+    Result.Subseconds = Time1.Subseconds + Time2.Subseconds;
+    Result.Seconds = Time1.Seconds + Time2.Seconds;
+
+    if (Result.Subseconds < Time1.Subseconds)
+    {
+        Result.Seconds++;
+    }
+
+    return Result;
+}
+
+
+/*
+** The time index table build SC used before the sort, one insertion per
+** command, reading the list entry times from the ATS on every compare
+*/
+static void SC_LoadPerfInsert(uint16 AtsIndex, int32 NewCmdIndex, int32 ListLength)
+{
+    SC_AtsEntryHeader_t *Entry;
+    SC_AbsTimeTag_t      NewCmdTime = 0;
+    SC_AbsTimeTag_t      ListCmdTime;
+    int32                CmdIndex;
+    int32                EntryIndex;
+    int32                TimeBufIndex;
+
+    if (ListLength > 0)
+    {
+        EntryIndex = SC_AppData.AtsCmdIndexBuffer[AtsIndex][NewCmdIndex];
+        Entry = (SC_AtsEntryHeader_t *) &SC_OperData.AtsTblAddr[AtsIndex][EntryIndex];
+        NewCmdTime = SC_GetAtsEntryTime(Entry);
+    }
+
+    TimeBufIndex = ListLength - 1;
+
+    while (TimeBufIndex >= 0)
+    {
+        CmdIndex = SC_AppData.AtsTimeIndexBuffer[AtsIndex][TimeBufIndex];
+        EntryIndex = SC_AppData.AtsCmdIndexBuffer[AtsIndex][CmdIndex];
+        Entry = (SC_AtsEntryHeader_t *) &SC_OperData.AtsTblAddr[AtsIndex][EntryIndex];
+        ListCmdTime = SC_GetAtsEntryTime(Entry);
+
+        if (SC_CompareAbsTime(ListCmdTime, NewCmdTime))
+        {
+            SC_AppData.AtsTimeIndexBuffer[AtsIndex][TimeBufIndex + 1] =
+               SC_AppData.AtsTimeIndexBuffer[AtsIndex][TimeBufIndex];
+            TimeBufIndex--;
+        }
+        else
+        {
+            break;
+        }
+    }
+
+    SC_AppData.AtsTimeIndexBuffer[AtsIndex][TimeBufIndex + 1] = NewCmdIndex;
+}
+
+static void SC_LoadPerfInsertBuild(uint16 AtsIndex)
+{
+    int32 i;
+    int32 ListLength = 0;
+
+    for (i = 0; i < SC_MAX_ATS_CMDS; i++)
+    {
+        SC_AppData.AtsTimeIndexBuffer[AtsIndex][i] = SC_ERROR;
+    }
+
+    for (i = 0; i < SC_MAX_ATS_CMDS; i++)
+    {
+        if (SC_AppData.AtsCmdIndexBuffer[AtsIndex][i] != SC_ERROR)
+        {
+            SC_LoadPerfInsert(AtsIndex, i, ListLength);
+            ListLength++;
+        }
+    }
+}
+
+
+static uint32 SC_LoadPerfRandom(void)
+{
+    SC_LoadPerfSeed = SC_LoadPerfSeed * 1103515245 + 12345;
+    return SC_LoadPerfSeed >> 8;
+}
+
+
+/* Writes one ATS entry, returns its length in words */
+static uint32 SC_LoadPerfEntry(uint16 *Buffer, uint16 CmdNumber, SC_AbsTimeTag_t Time)
+{
+    SC_AtsEntryHeader_t *Entry = (SC_AtsEntryHeader_t *) Buffer;
+
+    Entry->CmdNumber = CmdNumber;
+    memcpy(&Entry->TimeTag1, &Time, sizeof(Time));
+    CFE_SB_InitMsg(Entry->CmdHeader, SC_LOAD_PERF_MID, SC_LOAD_PERF_CMD_SIZE, TRUE);
+
+    return SC_LOAD_PERF_ENTRY_WORDS;
+}
+
+
+/* Execution time of command i of the ATS in the given order */
+static SC_AbsTimeTag_t SC_LoadPerfTime(const char *Order, uint32 i)
+{
+    if (strcmp(Order, "ordered") == 0)
+    {
+        return SC_LOAD_PERF_BASE_TIME + i;
+    }
+
+    if (strcmp(Order, "reverse") == 0)
+    {
+        return SC_LOAD_PERF_BASE_TIME + SC_MAX_ATS_CMDS - i;
+    }
+
+    /* random, with some commands at the same time */
+    return SC_LOAD_PERF_BASE_TIME + SC_LoadPerfRandom() % (SC_MAX_ATS_CMDS * 4);
+}
+
+
+/* Fills the ATS buffer with Cmds commands, cmd numbers 1 to Cmds */
+static void SC_LoadPerfFillAts(const char *Order, uint32 Cmds)
+{
+    uint32 Words = 0;
+    uint32 i;
+
+    memset(SC_LoadPerfAts, 0, sizeof(SC_LoadPerfAts));
+
+    for (i = 0; i < Cmds; i++)
+    {
+        Words += SC_LoadPerfEntry(&SC_LoadPerfAts[Words], i + 1, SC_LoadPerfTime(Order, i));
+    }
+}
+
+
+/* Runs Build until SC_LoadPerfSeconds have gone by, returns the time per build */
+static double SC_LoadPerfTimeBuild(void (*Build)(uint16))
+{
+    double Seconds = 0;
+    double Start;
+    uint32 Builds = 0;
+
+    while (Seconds < SC_LoadPerfSeconds || Builds < 3)
+    {
+        Start = Perf_Now();
+        Build(SC_LOAD_PERF_ATS);
+        Seconds += Perf_Now() - Start;
+        Builds++;
+    }
+
+    return Seconds / Builds;
+}
+
+
+static void SC_LoadPerfCheck(const uint16 *Expect, const char *What)
+{
+    if (memcmp(Expect, SC_AppData.AtsTimeIndexBuffer[SC_LOAD_PERF_ATS],
+               sizeof(SC_LoadPerfExpect)) != 0)
+    {
+        fprintf(stderr, "%s builds a different time index table\n", What);
+        exit(1);
+    }
+}
+
+
+/* Loads a full ATS and times the two time index table builds */
+static void SC_LoadPerfLoad(const char *Order)
+{
+    double Insert;
+    double Sort;
+
+    SC_LoadPerfFillAts(Order, SC_MAX_ATS_CMDS);
+    SC_LoadAts(SC_LOAD_PERF_ATS);
+
+    if (SC_OperData.AtsInfoTblAddr[SC_LOAD_PERF_ATS].NumberOfCommands != SC_MAX_ATS_CMDS)
+    {
+        fprintf(stderr, "cannot load the ATS\n");
+        exit(1);
+    }
+
+    memcpy(SC_LoadPerfLoaded, SC_AppData.AtsTimeIndexBuffer[SC_LOAD_PERF_ATS], sizeof(SC_LoadPerfLoaded));
+
+    Insert = SC_LoadPerfTimeBuild(SC_LoadPerfInsertBuild);
+    memcpy(SC_LoadPerfExpect, SC_AppData.AtsTimeIndexBuffer[SC_LOAD_PERF_ATS], sizeof(SC_LoadPerfExpect));
+    SC_LoadPerfCheck(SC_LoadPerfLoaded, "SC_LoadAts");
+
+    Sort = SC_LoadPerfTimeBuild(SC_BuildTimeIndexTable);
+    SC_LoadPerfCheck(SC_LoadPerfExpect, "SC_BuildTimeIndexTable");
+
+    printf("%-8s %-8s %8u %12.1f %12.1f\n", "load", Order, (unsigned int) SC_MAX_ATS_CMDS,
+           Insert * 1e6, Sort * 1e6);
+}
+
+
+/* Sets up the ATS the way SC_ProcessAppend leaves it before the time index is built */
+static void SC_LoadPerfAppendFlags(uint16 AtsIndex)
+{
+    int32 i;
+
+    memcpy(SC_AppData.AtsTimeIndexBuffer[AtsIndex], SC_LoadPerfLoaded, sizeof(SC_LoadPerfLoaded));
+
+    for (i = SC_MAX_ATS_CMDS - SC_LOAD_PERF_APPENDS; i < SC_MAX_ATS_CMDS; i++)
+    {
+        SC_AppData.AtsAppendFlag[i] = TRUE;
+    }
+
+    for (i = 0; i < SC_LOAD_PERF_APPENDS / 2; i++)
+    {
+        SC_AppData.AtsAppendFlag[i * 7] = TRUE;
+    }
+}
+
+static void SC_LoadPerfAppendBuild(uint16 AtsIndex)
+{
+    SC_LoadPerfAppendFlags(AtsIndex);
+    SC_LoadPerfInsertBuild(AtsIndex);
+    memset(SC_AppData.AtsAppendFlag, 0, sizeof(SC_AppData.AtsAppendFlag));
+}
+
+static void SC_LoadPerfAppendMerge(uint16 AtsIndex)
+{
+    SC_LoadPerfAppendFlags(AtsIndex);
+    SC_MergeTimeIndexTable(AtsIndex);
+}
+
+
+/*
+** Loads an ATS of all but the last 1 in 16 commands, appends those and
+** half as many again replacing every 7th command, and times the rebuild
+** against the merge
+*/
+static void SC_LoadPerfAppend(void)
+{
+    uint32 Loaded = SC_MAX_ATS_CMDS - SC_LOAD_PERF_APPENDS;
+    uint32 Words = 0;
+    uint32 Entries = 0;
+    double Insert;
+    double Merge;
+    uint32 i;
+
+    SC_LoadPerfFillAts("random", Loaded);
+    SC_LoadAts(SC_LOAD_PERF_ATS);
+    memcpy(SC_LoadPerfLoaded, SC_AppData.AtsTimeIndexBuffer[SC_LOAD_PERF_ATS], sizeof(SC_LoadPerfLoaded));
+
+    for (i = Loaded; i < SC_MAX_ATS_CMDS; i++, Entries++)
+    {
+        Words += SC_LoadPerfEntry(&SC_LoadPerfAppendTbl[Words], i + 1, SC_LoadPerfTime("random", i));
+    }
+
+    for (i = 0; i < SC_LOAD_PERF_APPENDS / 2; i++, Entries++)
+    {
+        Words += SC_LoadPerfEntry(&SC_LoadPerfAppendTbl[Words], i * 7 + 1, SC_LoadPerfTime("random", i));
+    }
+
+    SC_AppData.AppendWordCount = Words;
+    SC_AppData.AppendEntryCount = Entries;
+    SC_ProcessAppend(SC_LOAD_PERF_ATS);
+
+    if (SC_OperData.AtsInfoTblAddr[SC_LOAD_PERF_ATS].NumberOfCommands != SC_MAX_ATS_CMDS)
+    {
+        fprintf(stderr, "cannot append to the ATS\n");
+        exit(1);
+    }
+
+    memcpy(SC_LoadPerfExpect, SC_AppData.AtsTimeIndexBuffer[SC_LOAD_PERF_ATS], sizeof(SC_LoadPerfExpect));
+
+    Insert = SC_LoadPerfTimeBuild(SC_LoadPerfAppendBuild);
+    SC_LoadPerfCheck(SC_LoadPerfExpect, "SC_ProcessAppend");
+
+    Merge = SC_LoadPerfTimeBuild(SC_LoadPerfAppendMerge);
+    SC_LoadPerfCheck(SC_LoadPerfExpect, "SC_MergeTimeIndexTable");
+
+    printf("%-8s %-8s %8u %12.1f %12.1f\n", "append", "random", (unsigned int) Entries,
+           Insert * 1e6, Merge * 1e6);
+}
+
+
+int main(int argc, char *argv[])
+{
+    if (argc > 1)
+    {
+        SC_LoadPerfSeconds = strtod(argv[1], NULL);
+    }
+
+    SC_OperData.AtsTblAddr[SC_LOAD_PERF_ATS] = SC_LoadPerfAts;
+    SC_OperData.AtsCmdStatusTblAddr[SC_LOAD_PERF_ATS] = SC_LoadPerfCmdStatus;
+    SC_OperData.AtsInfoTblAddr = SC_LoadPerfAtsInfo;
+    SC_OperData.AtsCtrlBlckAddr = &SC_LoadPerfAtpCtrl;
+    SC_OperData.AppendTblAddr = SC_LoadPerfAppendTbl;
+
+    printf("SC ATS time index table, %u commands of %u words\n",
+           (unsigned int) SC_MAX_ATS_CMDS, (unsigned int) SC_LOAD_PERF_ENTRY_WORDS);
+    printf("table    times        cmds    us/insert   us/sort or merge\n");
+    SC_LoadPerfLoad("ordered");
+    SC_LoadPerfLoad("reverse");
+    SC_LoadPerfLoad("random");
+    SC_LoadPerfAppend();
+
+    printf("%u events, %u system log messages\n",
+           (unsigned int) Perf_EventCount, (unsigned int) Perf_SysLogCount);
+
+    return 0;
+}
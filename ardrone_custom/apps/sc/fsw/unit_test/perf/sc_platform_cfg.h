@@ -0,0 +1,79 @@
+/*
+** File:
+**   sc_platform_cfg.h
+**
+** Purpose:
+**   SC platform configuration for sc_load_perf and sc_rts_perf, found
+**   ahead of the SC platform_inc copy.  The number of ATS commands,
+**   SC_PERF_CMDS, or of RTS, SC_PERF_RTS, comes from the bench build, and
+**   the ATS buffer is as big as SC allows, room for 9362 of the smallest
+**   commands.  sc_rts_perf gives SC its clock through CFE_TIME_GetTAI.
+*/
+#ifndef _sc_platform_cfg_
+#define _sc_platform_cfg_
+
+#define SC_MAX_CMDS_PER_SEC             8
+
+#ifdef SC_PERF_RTS
+#define SC_NUMBER_OF_RTS                SC_PERF_RTS
+#else
+#define SC_NUMBER_OF_RTS                64
+#endif
+
+#define SC_ATS_BUFF_SIZE                65535
+
+#define SC_APPEND_BUFF_SIZE             (SC_ATS_BUFF_SIZE / 2)
+
+#define SC_RTS_BUFF_SIZE                150
+
+#ifdef SC_PERF_CMDS
+#define SC_MAX_ATS_CMDS                 SC_PERF_CMDS
+#else
+#define SC_MAX_ATS_CMDS                 1000
+#endif
+
+#define SC_LAST_RTS_WITH_EVENTS         20
+
+#define SC_PACKET_MIN_SIZE              8
+
+#define SC_PACKET_MAX_SIZE              250
+
+#define SC_PIPE_DEPTH                   12
+
+#define SC_ATS_FILE_NAME                "/cf/apps/sc_ats"
+
+#define SC_APPEND_FILE_NAME             "/cf/apps/sc_append.tbl"
+
+#define SC_RTS_FILE_NAME                "/cf/apps/sc_rts"
+
+#define SC_ATS_TABLE_NAME               "ATS_TBL"
+
+#define SC_APPEND_TABLE_NAME            "APPEND_TBL"
+
+#define SC_RTS_TABLE_NAME               "RTS_TBL"
+
+#define SC_RTSINFO_TABLE_NAME           "RTSINF_TBL"
+
+#define SC_RTP_CTRL_TABLE_NAME          "RTPCTR_TBL"
+
+#define SC_ATSINFO_TABLE_NAME           "ATSINF_TBL"
+
+#define SC_APPENDINFO_TABLE_NAME        "APPINF_TBL"
+
+#define SC_ATS_CTRL_TABLE_NAME          "ATPCTR_TBL"
+
+#define SC_ATS_CMD_STAT_TABLE_NAME      "ATSCMD_TBL"
+
+#define SC_CONT_ON_FAILURE_START        TRUE
+
+#ifdef SC_PERF_RTS
+#define SC_TIME_TO_USE                  SC_USE_TAI
+#else
+#define SC_TIME_TO_USE                  SC_USE_CFE_TIME
+#endif
+
+#define SC_ENABLE_GROUP_COMMANDS        TRUE
+
+#define SC_MISSION_REV                  0
+
+#endif /* _sc_platform_cfg_ */
@@ -0,0 +1,448 @@
+/*
+** File:
+**   sc_rts_perf.c
+**
+** Purpose:
+**   Stored Command RTS scheduling bench.  Starts all SC_NUMBER_OF_RTS
+**   RTS at once, each a full buffer of commands spaced so that
+**   SC_MAX_CMDS_PER_SEC of them come due every second, then sends SC 1Hz
+**   wakeups and times each one:
+**
+**   - scan, what SC did before the RTS schedule, going through the whole
+**     RTS info table every time it picks the next command
+**   - schedule, SC_ProcessRequest with the RTS schedule heap
+**
+**   The bench checks that both send the RTS commands in the same order.
+**
+** Notes:
+**   Built by the cFE perf bench Makefile on the real SC code, less
+**   sc_app.c, see cfe-core/unit-test/perf/perf_stubs.c, once per number
+**   of RTS (sc_rts_perf_64, _256, _1024 and _4096), with the SC platform
+**   configuration next to this file.  SC reads the time with
+**   CFE_TIME_GetTAI there, which the bench answers with a clock it moves
+**   one second per wakeup.  The RTS commands go to a CFE_SB_SendMsg
+**   stand-in that notes which RTS sent them.
+**
+**   Usage: sc_rts_perf_<rts> [seconds per measurement]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cfe.h"
+#include "sc_app.h"
+#include "sc_cmds.h"
+#include "sc_atsrq.h"
+#include "sc_rtsrq.h"
+#include "sc_loads.h"
+#include "sc_state.h"
+#include "sc_utils.h"
+#include "sc_msgids.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define SC_RTS_PERF_MID             0x18FF
+#define SC_RTS_PERF_CMD_SIZE        SC_PACKET_MIN_SIZE
+#define SC_RTS_PERF_ENTRY_WORDS     ((sizeof(SC_RelTimeTag_t) + SC_RTS_PERF_CMD_SIZE) / 2)
+#define SC_RTS_PERF_PERIOD          ((SC_NUMBER_OF_RTS + SC_MAX_CMDS_PER_SEC - 1) / SC_MAX_CMDS_PER_SEC)
+#define SC_RTS_PERF_WAKEUPS         (SC_RTS_PERF_PERIOD * 20)
+#define SC_RTS_PERF_START_TIME      1000000000
+#define SC_RTS_PERF_NEGATIVE        0x80000000  /* CFE_TIME_NEGATIVE */
+
+/*
+** SC global data, sc_app.c is not part of the bench
+*/
+SC_AppData_t  SC_AppData;
+SC_OperData_t SC_OperData;
+
+/*
+** The SC tables the RTS code works on
+*/
+static uint16               SC_RtsPerfRts [SC_NUMBER_OF_RTS][SC_RTS_BUFF_SIZE];
+static SC_RtsInfoEntry_t    SC_RtsPerfRtsInfo [SC_NUMBER_OF_RTS];
+static SC_RtpControlBlock_t SC_RtsPerfRtpCtrl;
+static SC_AtpControlBlock_t SC_RtsPerfAtpCtrl;
+static SC_AtsInfoTable_t    SC_RtsPerfAtsInfo [SC_NUMBER_OF_ATS];
+
+/*
+** Bench state
+*/
+typedef struct
+{
+    uint32  Clock;          /* seconds, moved on by each wakeup */
+    uint32  Sends;          /* RTS commands sent */
+    uint32  Order;          /* hash of the RTS numbers in send order */
+    double  Seconds;
+    double  MaxSeconds;
+    uint32  Wakeups;
+} SC_RtsPerf_t;
+
+static SC_RtsPerf_t SC_RtsPerf;
+
+static double SC_RtsPerfMeasure = 0.2;
+
+
+/*
+** Software Bus, Table and Time Services, as much as SC uses
+*/
+int32 CFE_SB_SendMsg(CFE_SB_Msg_t *MsgPtr)
+{
+    SC_RtsPerf.Sends++;
+    SC_RtsPerf.Order = (SC_RtsPerf.Order ^ SC_OperData.RtsCtrlBlckAddr->RtsNumber) * 16777619;
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_TBL_GetAddress(void **TblPtr, CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+int32 CFE_TBL_ReleaseAddress(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+int32 CFE_TBL_Manage(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+int32 CFE_TBL_Modified(CFE_TBL_Handle_t TblHandle)
+{
+    return CFE_SUCCESS;
+}
+
+CFE_TIME_SysTime_t CFE_TIME_GetTAI(void)
+{
+    CFE_TIME_SysTime_t Time;
+
+    Time.Seconds = SC_RtsPerf.Clock;
+    Time.Subseconds = 0;
+
+    return Time;
+}
+
+CFE_TIME_SysTime_t CFE_TIME_GetUTC(void)
+{
+    return CFE_TIME_GetTAI();
+}
+
+void CFE_TIME_Print(char *PrintBuffer, CFE_TIME_SysTime_t TimeToPrint)
+{
+    sprintf(PrintBuffer, "%u", (unsigned int) TimeToPrint.Seconds);
+}
+
+CFE_TIME_Compare_t CFE_TIME_Compare(CFE_TIME_SysTime_t TimeA, CFE_TIME_SysTime_t TimeB)
+{
+    if (TimeA.Seconds > TimeB.Seconds)
+    {
+        return ((TimeA.Seconds - TimeB.Seconds) > SC_RTS_PERF_NEGATIVE) ? CFE_TIME_A_LT_B : CFE_TIME_A_GT_B;
+    }
+
+    if (TimeA.Seconds < TimeB.Seconds)
+    {
+        return ((TimeB.Seconds - TimeA.Seconds) > SC_RTS_PERF_NEGATIVE) ? CFE_TIME_A_GT_B : CFE_TIME_A_LT_B;
+    }
+
+    if (TimeA.Subseconds > TimeB.Subseconds)
+    {
+        return CFE_TIME_A_GT_B;
+    }
+
+    if (TimeA.Subseconds < TimeB.Subseconds)
+    {
+        return CFE_TIME_A_LT_B;
+    }
+
+    return CFE_TIME_EQUAL;
+}
+
+CFE_TIME_SysTime_t CFE_TIME_Add(CFE_TIME_SysTime_t Time1, CFE_TIME_SysTime_t Time2)
+{
+    CFE_TIME_SysTime_t Result;
+
+    Result.Subseconds = Time1.Subseconds + Time2.Subseconds;
+    Result.Seconds = Time1.Seconds + Time2.Seconds;
+
+    if (Result.Subseconds < Time1.Subseconds)
+    {
+        Result.Seconds++;
+    }
+
+    return Result;
+}
+
+
+/*
+** The next RTS search SC used before the RTS schedule, and the 1Hz
+** wakeup of SC_ProcessRequest calling it
+*/
+static void SC_ScanNextRtsTime(void)
+{
+    int16           i;
+    uint16          NextRts = 0xFFFF;
+    SC_AbsTimeTag_t NextTime = SC_MAX_TIME;
+
+    for (i = SC_NUMBER_OF_RTS - 1; i >= 0; i--)
+    {
+        if (SC_OperData.RtsInfoTblAddr[i].RtsStatus == SC_EXECUTING)
+        {
+            if (SC_OperData.RtsInfoTblAddr[i].NextCommandTime <= NextTime)
+            {
+                NextTime = SC_OperData.RtsInfoTblAddr[i].NextCommandTime;
+                NextRts = i;
+            }
+        }
+    }
+
+    if (NextRts == 0xFFFF)
+    {
+        SC_OperData.RtsCtrlBlckAddr->RtsNumber = SC_INVALID_RTS_NUMBER;
+        SC_AppData.NextCmdTime[SC_RTP] = SC_MAX_TIME;
+    }
+    else
+    {
+        SC_OperData.RtsCtrlBlckAddr->RtsNumber = NextRts + 1;
+        SC_AppData.NextCmdTime[SC_RTP] = NextTime;
+    }
+}
+
+static void SC_ScanUpdateNextTime(void)
+{
+    SC_ScanNextRtsTime();
+
+    SC_AppData.NextProcNumber = SC_NONE;
+
+    if (SC_OperData.AtsCtrlBlckAddr->AtpState == SC_EXECUTING)
+    {
+        SC_AppData.NextProcNumber = SC_ATP;
+    }
+
+    if (SC_OperData.RtsCtrlBlckAddr->RtsNumber > 0 &&
+        SC_OperData.RtsCtrlBlckAddr->RtsNumber <= SC_NUMBER_OF_RTS)
+    {
+        if (SC_AppData.NextCmdTime[SC_RTP] < SC_AppData.NextCmdTime[SC_ATP])
+        {
+            SC_AppData.NextProcNumber = SC_RTP;
+        }
+    }
+}
+
+static void SC_ScanWakeup(void)
+{
+    boolean IsThereAnotherCommandToExecute;
+
+    SC_GetCurrentTime();
+
+    do
+    {
+        if (SC_OperData.AtsCtrlBlckAddr->SwitchPendFlag == TRUE)
+        {
+            SC_ServiceSwitchPend();
+        }
+
+        if (SC_AppData.NextProcNumber == SC_ATP)
+        {
+            SC_ProcessAtpCmd();
+        }
+        else if (SC_AppData.NextProcNumber == SC_RTP)
+        {
+            SC_ProcessRtpCommand();
+        }
+
+        SC_ScanUpdateNextTime();
+
+        if ((SC_AppData.NextProcNumber == SC_NONE) ||
+            (SC_AppData.NextCmdTime[SC_AppData.NextProcNumber] > SC_AppData.CurrentTime))
+        {
+            SC_OperData.NumCmdsSec = 0;
+            IsThereAnotherCommandToExecute = FALSE;
+        }
+        else if (SC_OperData.NumCmdsSec >= SC_MAX_CMDS_PER_SEC)
+        {
+            SC_OperData.NumCmdsSec = 0;
+            IsThereAnotherCommandToExecute = FALSE;
+        }
+        else
+        {
+            IsThereAnotherCommandToExecute = TRUE;
+        }
+    } while (IsThereAnotherCommandToExecute);
+}
+
+
+/*
+** Fills in every RTS.  RTS i first runs (i / SC_MAX_CMDS_PER_SEC) + 1
+** seconds after it starts and then every SC_RTS_PERF_PERIOD seconds,
+** until its buffer runs out.
+*/
+static void SC_RtsPerfBuildRts(void)
+{
+    SC_RtsEntryHeader_t *Entry;
+    uint32               Words;
+    uint32               i;
+
+    for (i = 0; i < SC_NUMBER_OF_RTS; i++)
+    {
+        for (Words = 0; Words + SC_RTS_PERF_ENTRY_WORDS <= SC_RTS_BUFF_SIZE; Words += SC_RTS_PERF_ENTRY_WORDS)
+        {
+            Entry = (SC_RtsEntryHeader_t *) &SC_RtsPerfRts[i][Words];
+            Entry->TimeTag = (Words == 0) ? (i / SC_MAX_CMDS_PER_SEC) + 1 : SC_RTS_PERF_PERIOD;
+            CFE_SB_InitMsg(Entry->CmdHeader, SC_RTS_PERF_MID, SC_RTS_PERF_CMD_SIZE, TRUE);
+            CFE_SB_GenerateChecksum((CFE_SB_MsgPtr_t) Entry->CmdHeader);
+        }
+    }
+}
+
+
+/* Resets SC, loads, enables and starts every RTS */
+static void SC_RtsPerfStart(void)
+{
+    SC_RtsCmd_t StartCmd;
+    uint32      i;
+
+    memset(&SC_AppData, 0, sizeof(SC_AppData));
+    memset(SC_RtsPerfRtsInfo, 0, sizeof(SC_RtsPerfRtsInfo));
+    memset(&SC_RtsPerfRtpCtrl, 0, sizeof(SC_RtsPerfRtpCtrl));
+    memset(&SC_RtsPerfAtpCtrl, 0, sizeof(SC_RtsPerfAtpCtrl));
+
+    SC_AppData.NextProcNumber = SC_NONE;
+    SC_AppData.NextCmdTime[SC_ATP] = SC_MAX_TIME;
+    SC_AppData.NextCmdTime[SC_RTP] = SC_MAX_TIME;
+    SC_OperData.NumCmdsSec = 0;
+
+    SC_RtsPerf.Clock = SC_RTS_PERF_START_TIME;
+    SC_GetCurrentTime();
+
+    CFE_SB_InitMsg(&StartCmd, SC_CMD_MID, sizeof(StartCmd), TRUE);
+    CFE_SB_SetCmdCode((CFE_SB_MsgPtr_t) &StartCmd, SC_START_RTS_CC);
+
+    for (i = 0; i < SC_NUMBER_OF_RTS; i++)
+    {
+        SC_LoadRts(i);
+        SC_OperData.RtsInfoTblAddr[i].DisabledFlag = FALSE;
+
+        StartCmd.RtsId = i + 1;
+        SC_StartRtsCmd((CFE_SB_MsgPtr_t) &StartCmd);
+    }
+
+    if (SC_OperData.RtsCtrlBlckAddr->NumRtsActive != SC_NUMBER_OF_RTS)
+    {
+        fprintf(stderr, "cannot start the RTS\n");
+        exit(1);
+    }
+}
+
+
+/* Sends SC_RTS_PERF_WAKEUPS wakeups, timing each one */
+static void SC_RtsPerfWakeups(boolean Scan)
+{
+    CFE_SB_CmdHdr_t Wakeup;
+    double          Start;
+    double          Seconds;
+    uint32          i;
+
+    CFE_SB_InitMsg(&Wakeup, SC_1HZ_WAKEUP_MID, sizeof(Wakeup), TRUE);
+
+    SC_RtsPerfStart();
+
+    for (i = 0; i < SC_RTS_PERF_WAKEUPS; i++)
+    {
+        SC_RtsPerf.Clock++;
+
+        Start = Perf_Now();
+
+        if (Scan)
+        {
+            SC_ScanWakeup();
+        }
+        else
+        {
+            SC_ProcessRequest((CFE_SB_MsgPtr_t) &Wakeup);
+        }
+
+        Seconds = Perf_Now() - Start;
+
+        SC_RtsPerf.Seconds += Seconds;
+        SC_RtsPerf.Wakeups++;
+
+        if (Seconds > SC_RtsPerf.MaxSeconds)
+        {
+            SC_RtsPerf.MaxSeconds = Seconds;
+        }
+    }
+}
+
+
+/* Runs rounds of wakeups until SC_RtsPerfMeasure seconds have gone by */
+static void SC_RtsPerfRun(boolean Scan, uint32 *Order)
+{
+    uint32 Sends;
+
+    memset(&SC_RtsPerf, 0, sizeof(SC_RtsPerf));
+
+    SC_RtsPerfWakeups(Scan);
+    Sends = SC_RtsPerf.Sends;
+
+    if (*Order == 0)
+    {
+        *Order = SC_RtsPerf.Order;
+    }
+    else if (*Order != SC_RtsPerf.Order)
+    {
+        fprintf(stderr, "scan and schedule send the RTS commands in a different order\n");
+        exit(1);
+    }
+
+    while (SC_RtsPerf.Seconds < SC_RtsPerfMeasure)
+    {
+        SC_RtsPerfWakeups(Scan);
+    }
+
+    printf("%-9s %6u %10u %14.2f %14.2f\n", Scan ? "scan" : "schedule",
+           (unsigned int) SC_NUMBER_OF_RTS, (unsigned int) Sends,
+           SC_RtsPerf.Seconds * 1e6 / SC_RtsPerf.Wakeups, SC_RtsPerf.MaxSeconds * 1e6);
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32 Order = 0;
+    uint32 i;
+
+    if (argc > 1)
+    {
+        SC_RtsPerfMeasure = strtod(argv[1], NULL);
+    }
+
+    for (i = 0; i < SC_NUMBER_OF_RTS; i++)
+    {
+        SC_OperData.RtsTblAddr[i] = SC_RtsPerfRts[i];
+    }
+
+    SC_OperData.RtsInfoTblAddr = SC_RtsPerfRtsInfo;
+    SC_OperData.RtsCtrlBlckAddr = &SC_RtsPerfRtpCtrl;
+    SC_OperData.AtsCtrlBlckAddr = &SC_RtsPerfAtpCtrl;
+    SC_OperData.AtsInfoTblAddr = SC_RtsPerfAtsInfo;
+
+    SC_RtsPerfBuildRts();
+
+    printf("SC RTS scheduling, %u RTS executing, %u commands due per 1Hz wakeup, %u wakeups\n",
+           (unsigned int) SC_NUMBER_OF_RTS, (unsigned int) SC_MAX_CMDS_PER_SEC,
+           (unsigned int) SC_RTS_PERF_WAKEUPS);
+    printf("engine       rts  cmds sent   us/wakeup  max us/wakeup\n");
+    SC_RtsPerfRun(TRUE, &Order);
+    SC_RtsPerfRun(FALSE, &Order);
+
+    printf("%u events, %u system log messages\n",
+           (unsigned int) Perf_EventCount, (unsigned int) Perf_SysLogCount);
+
+    return 0;
+}
@@ -0,0 +1,196 @@
+ /*************************************************************************
+ ** File:
+ **   sc_loads_test.c
+ **
+ ** Purpose:
+ **   This file contains the unit tests for the ATS time index table of
+ **   sc_loads.c
+ **
+ ** Notes:
+ **   The ATS time index table lists the ATS command indexes (command
+ **   number - 1) in execution order.  Commands with the same execution
+ **   time run in command number order, however they were loaded.
+ **
+ *************************************************************************/
+
+#include "sc_loads_test.h"
+#include "sc_test_utils.h"
+
+#define SC_TEST_ATS             0
+#define SC_TEST_ENTRY_WORDS     (SC_ATS_HDR_NOPKT_WORDS + (SC_TEST_CMD_SIZE / 2))
+
+/*
+ * Loads ATS A with the given commands, in the given order
+ */
+static void SC_Loads_Test_LoadAts(const uint16 *CmdNumbers, const SC_AbsTimeTag_t *Times, uint16 Count)
+{
+    uint16 Words = 0;
+    uint16 i;
+
+    for (i = 0; i < Count; i++)
+    {
+        Words += SC_Test_AtsEntry(&SC_Test_AtsTbl[SC_TEST_ATS][Words], CmdNumbers[i], Times[i]);
+    }
+
+    SC_LoadAts(SC_TEST_ATS);
+} /* end SC_Loads_Test_LoadAts */
+
+/*
+ * Appends the given commands to ATS A through the Append ATS table
+ */
+static void SC_Loads_Test_Append(const uint16 *CmdNumbers, const SC_AbsTimeTag_t *Times, uint16 Count)
+{
+    uint16 Words = 0;
+    uint16 i;
+
+    for (i = 0; i < Count; i++)
+    {
+        Words += SC_Test_AtsEntry(&SC_Test_AppendTbl[Words], CmdNumbers[i], Times[i]);
+    }
+
+    SC_UpdateAppend();
+    SC_ProcessAppend(SC_TEST_ATS);
+} /* end SC_Loads_Test_Append */
+
+/*
+ * Tests whether the ATS A time index table holds the expected command
+ * indexes, and nothing after them
+ */
+static boolean SC_Loads_Test_CheckIndex(const uint16 *Expect, uint16 Count)
+{
+    uint16 *TimeIndex = SC_AppData.AtsTimeIndexBuffer[SC_TEST_ATS];
+    uint16  i;
+
+    for (i = 0; i < Count; i++)
+    {
+        if (TimeIndex[i] != Expect[i])
+        {
+            return FALSE;
+        }
+    }
+
+    return (TimeIndex[Count] == (uint16) SC_ERROR);
+} /* end SC_Loads_Test_CheckIndex */
+
+void SC_LoadAts_Test_Ordered(void)
+{
+    uint16          CmdNumbers [] = { 1, 2, 3, 4 };
+    SC_AbsTimeTag_t Times [] = { 100, 110, 120, 130 };
+    uint16          Expect [] = { 0, 1, 2, 3 };
+
+    /* Execute the function being tested */
+    SC_Loads_Test_LoadAts(CmdNumbers, Times, 4);
+
+    /* Verify results */
+    UtAssert_True (SC_Loads_Test_CheckIndex(Expect, 4), "Time index is 0, 1, 2, 3");
+    UtAssert_True (SC_OperData.AtsInfoTblAddr[SC_TEST_ATS].NumberOfCommands == 4,
+                   "SC_OperData.AtsInfoTblAddr[SC_TEST_ATS].NumberOfCommands == 4");
+    UtAssert_True (SC_OperData.AtsInfoTblAddr[SC_TEST_ATS].AtsSize == 4 * SC_TEST_ENTRY_WORDS,
+                   "SC_OperData.AtsInfoTblAddr[SC_TEST_ATS].AtsSize == 4 * SC_TEST_ENTRY_WORDS");
+
+} /* end SC_LoadAts_Test_Ordered */
+
+void SC_LoadAts_Test_Reverse(void)
+{
+    uint16          CmdNumbers [] = { 1, 2, 3, 4, 5 };
+    SC_AbsTimeTag_t Times [] = { 150, 140, 130, 120, 110 };
+    uint16          Expect [] = { 4, 3, 2, 1, 0 };
+
+    /* Execute the function being tested */
+    SC_Loads_Test_LoadAts(CmdNumbers, Times, 5);
+
+    /* Verify results */
+    UtAssert_True (SC_Loads_Test_CheckIndex(Expect, 5), "Time index is 4, 3, 2, 1, 0");
+    UtAssert_True (SC_OperData.AtsInfoTblAddr[SC_TEST_ATS].NumberOfCommands == 5,
+                   "SC_OperData.AtsInfoTblAddr[SC_TEST_ATS].NumberOfCommands == 5");
+
+} /* end SC_LoadAts_Test_Reverse */
+
+void SC_LoadAts_Test_EqualTimes(void)
+{
+    uint16          CmdNumbers [] = { 4, 2, 3, 1, 5 };
+    SC_AbsTimeTag_t Times [] = { 200, 100, 100, 200, 100 };
+    uint16          Expect [] = { 1, 2, 4, 0, 3 };
+
+    /* Execute the function being tested */
+    SC_Loads_Test_LoadAts(CmdNumbers, Times, 5);
+
+    /* Verify results */
+    UtAssert_True (SC_Loads_Test_CheckIndex(Expect, 5), "Time index is 1, 2, 4, 0, 3");
+
+} /* end SC_LoadAts_Test_EqualTimes */
+
+void SC_ProcessAppend_Test_Merge(void)
+{
+    uint16          CmdNumbers [] = { 2, 3, 4, 5 };
+    SC_AbsTimeTag_t Times [] = { 100, 110, 120, 130 };
+    uint16          AppendNumbers [] = { 1, 6, 7 };
+    SC_AbsTimeTag_t AppendTimes [] = { 110, 90, 110 };
+    uint16          Expect [] = { 5, 1, 0, 2, 6, 3, 4 };
+    uint16          i;
+    boolean         FlagsClear = TRUE;
+
+    SC_Loads_Test_LoadAts(CmdNumbers, Times, 4);
+
+    /* Execute the function being tested */
+    SC_Loads_Test_Append(AppendNumbers, AppendTimes, 3);
+
+    /* Verify results */
+    UtAssert_True (SC_Loads_Test_CheckIndex(Expect, 7), "Time index is 5, 1, 0, 2, 6, 3, 4");
+    UtAssert_True (SC_OperData.AtsInfoTblAddr[SC_TEST_ATS].NumberOfCommands == 7,
+                   "SC_OperData.AtsInfoTblAddr[SC_TEST_ATS].NumberOfCommands == 7");
+    UtAssert_True (SC_OperData.AtsInfoTblAddr[SC_TEST_ATS].AtsSize == 7 * SC_TEST_ENTRY_WORDS,
+                   "SC_OperData.AtsInfoTblAddr[SC_TEST_ATS].AtsSize == 7 * SC_TEST_ENTRY_WORDS");
+    UtAssert_True (SC_OperData.AtsCmdStatusTblAddr[SC_TEST_ATS][0] == SC_LOADED,
+                   "SC_OperData.AtsCmdStatusTblAddr[SC_TEST_ATS][0] == SC_LOADED");
+
+    for (i = 0; i < SC_MAX_ATS_CMDS; i++)
+    {
+        if (SC_AppData.AtsAppendFlag[i])
+        {
+            FlagsClear = FALSE;
+        }
+    }
+
+    UtAssert_True (FlagsClear, "Append flags cleared");
+
+    UtAssert_EventSent(SC_UPDATE_APPEND_EID, CFE_EVS_INFORMATION,
+                       "Update Append ATS Table: load count = 1, command count = 3, byte count = 42",
+                       "Update Append ATS Table: load count = 1, command count = 3, byte count = 42");
+
+} /* end SC_ProcessAppend_Test_Merge */
+
+void SC_ProcessAppend_Test_Replace(void)
+{
+    uint16          CmdNumbers [] = { 1, 2, 3, 4 };
+    SC_AbsTimeTag_t Times [] = { 100, 110, 120, 130 };
+    uint16          AppendNumbers [] = { 2, 3, 6 };
+    SC_AbsTimeTag_t AppendTimes [] = { 125, 100, 110 };
+    uint16          Expect [] = { 0, 2, 5, 1, 3 };
+
+    SC_Loads_Test_LoadAts(CmdNumbers, Times, 4);
+
+    /* Execute the function being tested: 2 and 3 replace loaded commands */
+    SC_Loads_Test_Append(AppendNumbers, AppendTimes, 3);
+
+    /* Verify results */
+    UtAssert_True (SC_Loads_Test_CheckIndex(Expect, 5), "Time index is 0, 2, 5, 1, 3");
+    UtAssert_True (SC_OperData.AtsInfoTblAddr[SC_TEST_ATS].NumberOfCommands == 5,
+                   "SC_OperData.AtsInfoTblAddr[SC_TEST_ATS].NumberOfCommands == 5");
+    UtAssert_True (SC_AppData.AtsCmdIndexBuffer[SC_TEST_ATS][1] == 4 * SC_TEST_ENTRY_WORDS,
+                   "Command 2 points at its appended entry");
+
+} /* end SC_ProcessAppend_Test_Replace */
+
+void SC_Loads_Test_AddTestCases(void)
+{
+    UtTest_Add(SC_LoadAts_Test_Ordered, SC_Test_Setup, SC_Test_TearDown, "SC_LoadAts_Test_Ordered");
+    UtTest_Add(SC_LoadAts_Test_Reverse, SC_Test_Setup, SC_Test_TearDown, "SC_LoadAts_Test_Reverse");
+    UtTest_Add(SC_LoadAts_Test_EqualTimes, SC_Test_Setup, SC_Test_TearDown, "SC_LoadAts_Test_EqualTimes");
+    UtTest_Add(SC_ProcessAppend_Test_Merge, SC_Test_Setup, SC_Test_TearDown, "SC_ProcessAppend_Test_Merge");
+    UtTest_Add(SC_ProcessAppend_Test_Replace, SC_Test_Setup, SC_Test_TearDown, "SC_ProcessAppend_Test_Replace");
+} /* end SC_Loads_Test_AddTestCases */
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -0,0 +1,20 @@
+ /*************************************************************************
+ ** File:
+ **   sc_loads_test.h
+ **
+ ** Purpose:
+ **   This file contains the function prototypes for the unit tests for
+ **   sc_loads.c
+ **
+ ** Notes:
+ **
+ *************************************************************************/
+
+#include "utassert.h"
+#include "uttest.h"
+
+void SC_Loads_Test_AddTestCases(void);
+
+/************************/
+/*  End of File Comment */
+/************************/
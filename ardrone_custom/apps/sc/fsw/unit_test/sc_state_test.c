@@ -0,0 +1,275 @@
+ /*************************************************************************
+ ** File:
+ **   sc_state_test.c
+ **
+ ** Purpose:
+ **   This file contains the unit tests for the RTS schedule of sc_state.c,
+ **   as RTS are started, killed and loaded
+ **
+ ** Notes:
+ **   Most tests start the same six RTS at time 1000:
+ **
+ **     RTS   first cmd   second cmd
+ **      1      +30          +60
+ **      2      +10          +60
+ **      3      +20          +60
+ **      4      +10          +60
+ **      5       +5          +50
+ **      6      +40           -
+ **
+ **   RTS 2 and 4 come due together, and RTS 2 goes first.
+ **
+ *************************************************************************/
+
+#include "sc_state_test.h"
+#include "sc_test_utils.h"
+#include "sc_msgids.h"
+#include "sc_rtsrq.h"
+#include "sc_state.h"
+
+#define SC_TEST_CURRENT_TIME    1000
+#define SC_TEST_NUM_RTS         6
+
+/*
+ * Loads an RTS with one or two commands, a Second time tag of 0 leaves
+ * the second one out
+ */
+static void SC_State_Test_LoadRts(uint16 RtsIndex, SC_RelTimeTag_t First, SC_RelTimeTag_t Second)
+{
+    uint16 Words;
+
+    Words = SC_Test_RtsEntry(SC_Test_RtsTbl[RtsIndex], First);
+
+    if (Second != 0)
+    {
+        SC_Test_RtsEntry(&SC_Test_RtsTbl[RtsIndex][Words], Second);
+    }
+
+    SC_LoadRts(RtsIndex);
+    SC_OperData.RtsInfoTblAddr[RtsIndex].DisabledFlag = FALSE;
+} /* end SC_State_Test_LoadRts */
+
+/*
+ * Sends SC a Start RTS command
+ */
+static void SC_State_Test_StartRts(uint16 RtsNumber)
+{
+    SC_RtsCmd_t CmdPacket;
+
+    CFE_SB_InitMsg(&CmdPacket, SC_CMD_MID, sizeof(SC_RtsCmd_t), TRUE);
+    CFE_SB_SetCmdCode((CFE_SB_MsgPtr_t) &CmdPacket, SC_START_RTS_CC);
+    CmdPacket.RtsId = RtsNumber;
+
+    SC_StartRtsCmd((CFE_SB_MsgPtr_t) &CmdPacket);
+} /* end SC_State_Test_StartRts */
+
+/*
+ * Loads and starts the RTS described above
+ */
+static void SC_State_Test_StartAll(void)
+{
+    static const SC_RelTimeTag_t First [SC_TEST_NUM_RTS]  = { 30, 10, 20, 10, 5, 40 };
+    static const SC_RelTimeTag_t Second [SC_TEST_NUM_RTS] = { 60, 60, 60, 60, 50, 0 };
+    uint16 i;
+
+    SC_AppData.CurrentTime = SC_TEST_CURRENT_TIME;
+
+    for (i = 0; i < SC_TEST_NUM_RTS; i++)
+    {
+        SC_State_Test_LoadRts(i, First[i], Second[i]);
+        SC_State_Test_StartRts(i + 1);
+    }
+} /* end SC_State_Test_StartAll */
+
+/*
+ * Tests whether the RTS schedule is a heap, with every RTS position
+ * recorded, and holds exactly the executing RTS
+ */
+static boolean SC_State_Test_CheckSchedule(void)
+{
+    uint16 *Schedule = SC_AppData.RtsSchedule;
+    uint16  Scheduled = 0;
+    uint16  Executing = 0;
+    uint16  i;
+
+    for (i = 1; i <= SC_AppData.RtsScheduleCount; i++)
+    {
+        if (SC_AppData.RtsSchedulePos[Schedule[i]] != i)
+        {
+            return FALSE;
+        }
+
+        if ((i > 1) && SC_RtsRunsBefore(Schedule[i], Schedule[i / 2]))
+        {
+            return FALSE;
+        }
+    }
+
+    for (i = 0; i < SC_NUMBER_OF_RTS; i++)
+    {
+        if (SC_AppData.RtsSchedulePos[i] != 0)
+        {
+            Scheduled++;
+        }
+
+        if (SC_OperData.RtsInfoTblAddr[i].RtsStatus == SC_EXECUTING)
+        {
+            Executing++;
+        }
+    }
+
+    return ((Scheduled == SC_AppData.RtsScheduleCount) && (Executing == SC_AppData.RtsScheduleCount));
+} /* end SC_State_Test_CheckSchedule */
+
+void SC_StartRtsCmd_Test_Schedule(void)
+{
+    /* Execute the function being tested */
+    SC_State_Test_StartAll();
+    SC_GetNextRtsTime();
+
+    /* Verify results */
+    UtAssert_True (SC_AppData.RtsScheduleCount == 6, "SC_AppData.RtsScheduleCount == 6");
+    UtAssert_True (SC_State_Test_CheckSchedule(), "RTS schedule is valid");
+    UtAssert_True (SC_OperData.RtsCtrlBlckAddr->NumRtsActive == 6, "SC_OperData.RtsCtrlBlckAddr->NumRtsActive == 6");
+    UtAssert_True (SC_OperData.RtsCtrlBlckAddr->RtsNumber == 5, "SC_OperData.RtsCtrlBlckAddr->RtsNumber == 5");
+    UtAssert_True (SC_AppData.NextCmdTime[SC_RTP] == 1005, "SC_AppData.NextCmdTime[SC_RTP] == 1005");
+
+    UtAssert_EventSent(SC_RTS_START_INF_EID, CFE_EVS_INFORMATION, "RTS Number 006 Started", "RTS Number 006 Started");
+
+} /* end SC_StartRtsCmd_Test_Schedule */
+
+void SC_StartRtsCmd_Test_AlreadyExecuting(void)
+{
+    SC_State_Test_StartAll();
+
+    /* Execute the function being tested */
+    SC_State_Test_StartRts(2);
+
+    /* Verify results */
+    UtAssert_True (SC_AppData.RtsScheduleCount == 6, "SC_AppData.RtsScheduleCount == 6");
+    UtAssert_True (SC_State_Test_CheckSchedule(), "RTS schedule is valid");
+
+    UtAssert_EventSent(SC_STARTRTS_CMD_NOT_LDED_ERR_EID, CFE_EVS_ERROR,
+                       "Start RTS 002 Rejected: RTS Not Loaded or In Use, Status: 5",
+                       "Start RTS 002 Rejected: RTS Not Loaded or In Use, Status: 5");
+
+} /* end SC_StartRtsCmd_Test_AlreadyExecuting */
+
+void SC_KillRts_Test_Unschedule(void)
+{
+    uint16 i;
+
+    SC_State_Test_StartAll();
+
+    /* Execute the function being tested */
+    SC_KillRts(4);
+    SC_GetNextRtsTime();
+
+    /* Verify results */
+    UtAssert_True (SC_AppData.RtsScheduleCount == 5, "SC_AppData.RtsScheduleCount == 5");
+    UtAssert_True (SC_AppData.RtsSchedulePos[4] == 0, "SC_AppData.RtsSchedulePos[4] == 0");
+    UtAssert_True (SC_OperData.RtsInfoTblAddr[4].RtsStatus == SC_LOADED, "SC_OperData.RtsInfoTblAddr[4].RtsStatus == SC_LOADED");
+    UtAssert_True (SC_State_Test_CheckSchedule(), "RTS schedule is valid");
+    UtAssert_True (SC_OperData.RtsCtrlBlckAddr->RtsNumber == 2, "SC_OperData.RtsCtrlBlckAddr->RtsNumber == 2");
+    UtAssert_True (SC_AppData.NextCmdTime[SC_RTP] == 1010, "SC_AppData.NextCmdTime[SC_RTP] == 1010");
+
+    SC_KillRts(1);
+    SC_GetNextRtsTime();
+
+    UtAssert_True (SC_State_Test_CheckSchedule(), "RTS schedule is valid");
+    UtAssert_True (SC_OperData.RtsCtrlBlckAddr->RtsNumber == 4, "SC_OperData.RtsCtrlBlckAddr->RtsNumber == 4");
+
+    /* Killing an RTS that is not executing leaves the schedule alone */
+    SC_KillRts(1);
+
+    UtAssert_True (SC_AppData.RtsScheduleCount == 4, "SC_AppData.RtsScheduleCount == 4");
+    UtAssert_True (SC_OperData.RtsCtrlBlckAddr->NumRtsActive == 4, "SC_OperData.RtsCtrlBlckAddr->NumRtsActive == 4");
+
+    for (i = 0; i < SC_TEST_NUM_RTS; i++)
+    {
+        SC_KillRts(i);
+    }
+
+    SC_GetNextRtsTime();
+
+    UtAssert_True (SC_AppData.RtsScheduleCount == 0, "SC_AppData.RtsScheduleCount == 0");
+    UtAssert_True (SC_OperData.RtsCtrlBlckAddr->RtsNumber == SC_INVALID_RTS_NUMBER,
+                   "SC_OperData.RtsCtrlBlckAddr->RtsNumber == SC_INVALID_RTS_NUMBER");
+    UtAssert_True (SC_AppData.NextCmdTime[SC_RTP] == SC_MAX_TIME, "SC_AppData.NextCmdTime[SC_RTP] == SC_MAX_TIME");
+
+} /* end SC_KillRts_Test_Unschedule */
+
+void SC_LoadRts_Test_Unschedule(void)
+{
+    SC_State_Test_StartAll();
+
+    /* Execute the function being tested: new table data for RTS 5 */
+    SC_LoadRts(4);
+    SC_GetNextRtsTime();
+
+    /* Verify results */
+    UtAssert_True (SC_AppData.RtsScheduleCount == 5, "SC_AppData.RtsScheduleCount == 5");
+    UtAssert_True (SC_AppData.RtsSchedulePos[4] == 0, "SC_AppData.RtsSchedulePos[4] == 0");
+    UtAssert_True (SC_OperData.RtsInfoTblAddr[4].RtsStatus == SC_LOADED, "SC_OperData.RtsInfoTblAddr[4].RtsStatus == SC_LOADED");
+    UtAssert_True (SC_OperData.RtsInfoTblAddr[4].DisabledFlag == TRUE, "SC_OperData.RtsInfoTblAddr[4].DisabledFlag == TRUE");
+    UtAssert_True (SC_State_Test_CheckSchedule(), "RTS schedule is valid");
+    UtAssert_True (SC_OperData.RtsCtrlBlckAddr->RtsNumber == 2, "SC_OperData.RtsCtrlBlckAddr->RtsNumber == 2");
+
+    /* Loading an RTS that is not executing leaves the schedule alone */
+    SC_LoadRts(4);
+
+    UtAssert_True (SC_AppData.RtsScheduleCount == 5, "SC_AppData.RtsScheduleCount == 5");
+    UtAssert_True (SC_State_Test_CheckSchedule(), "RTS schedule is valid");
+
+} /* end SC_LoadRts_Test_Unschedule */
+
+void SC_GetNextRtsCommand_Test_Reschedule(void)
+{
+    SC_State_Test_StartAll();
+    SC_GetNextRtsTime();
+
+    /* Execute the function being tested: RTS 5 moves on to its second command */
+    SC_GetNextRtsCommand();
+    SC_GetNextRtsTime();
+
+    /* Verify results */
+    UtAssert_True (SC_OperData.RtsInfoTblAddr[4].NextCommandTime == 1050,
+                   "SC_OperData.RtsInfoTblAddr[4].NextCommandTime == 1050");
+    UtAssert_True (SC_AppData.RtsScheduleCount == 6, "SC_AppData.RtsScheduleCount == 6");
+    UtAssert_True (SC_State_Test_CheckSchedule(), "RTS schedule is valid");
+    UtAssert_True (SC_OperData.RtsCtrlBlckAddr->RtsNumber == 2, "SC_OperData.RtsCtrlBlckAddr->RtsNumber == 2");
+
+} /* end SC_GetNextRtsCommand_Test_Reschedule */
+
+void SC_GetNextRtsCommand_Test_Complete(void)
+{
+    SC_State_Test_StartAll();
+    SC_OperData.RtsCtrlBlckAddr->RtsNumber = 6;
+
+    /* Execute the function being tested: RTS 6 has no second command */
+    SC_GetNextRtsCommand();
+    SC_GetNextRtsTime();
+
+    /* Verify results */
+    UtAssert_True (SC_AppData.RtsScheduleCount == 5, "SC_AppData.RtsScheduleCount == 5");
+    UtAssert_True (SC_AppData.RtsSchedulePos[5] == 0, "SC_AppData.RtsSchedulePos[5] == 0");
+    UtAssert_True (SC_State_Test_CheckSchedule(), "RTS schedule is valid");
+    UtAssert_True (SC_OperData.RtsCtrlBlckAddr->RtsNumber == 5, "SC_OperData.RtsCtrlBlckAddr->RtsNumber == 5");
+
+    UtAssert_EventSent(SC_RTS_COMPL_INF_EID, CFE_EVS_INFORMATION, "RTS 006 Execution Completed", "RTS 006 Execution Completed");
+
+} /* end SC_GetNextRtsCommand_Test_Complete */
+
+void SC_State_Test_AddTestCases(void)
+{
+    UtTest_Add(SC_StartRtsCmd_Test_Schedule, SC_Test_Setup, SC_Test_TearDown, "SC_StartRtsCmd_Test_Schedule");
+    UtTest_Add(SC_StartRtsCmd_Test_AlreadyExecuting, SC_Test_Setup, SC_Test_TearDown, "SC_StartRtsCmd_Test_AlreadyExecuting");
+    UtTest_Add(SC_KillRts_Test_Unschedule, SC_Test_Setup, SC_Test_TearDown, "SC_KillRts_Test_Unschedule");
+    UtTest_Add(SC_LoadRts_Test_Unschedule, SC_Test_Setup, SC_Test_TearDown, "SC_LoadRts_Test_Unschedule");
+    UtTest_Add(SC_GetNextRtsCommand_Test_Reschedule, SC_Test_Setup, SC_Test_TearDown, "SC_GetNextRtsCommand_Test_Reschedule");
+    UtTest_Add(SC_GetNextRtsCommand_Test_Complete, SC_Test_Setup, SC_Test_TearDown, "SC_GetNextRtsCommand_Test_Complete");
+} /* end SC_State_Test_AddTestCases */
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -0,0 +1,20 @@
+ /*************************************************************************
+ ** File:
+ **   sc_state_test.h
+ **
+ ** Purpose:
+ **   This file contains the function prototypes for the unit tests for
+ **   the RTS schedule of sc_state.c
+ **
+ ** Notes:
+ **
+ *************************************************************************/
+
+#include "utassert.h"
+#include "uttest.h"
+
+void SC_State_Test_AddTestCases(void);
+
+/************************/
+/*  End of File Comment */
+/************************/
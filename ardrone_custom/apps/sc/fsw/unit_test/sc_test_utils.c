@@ -0,0 +1,114 @@
+ /*************************************************************************
+ ** File:
+ **   sc_test_utils.c
+ **
+ ** Purpose:
+ **   This file contains the UT-Assert unit test utilities for the CFS
+ **   Stored Command (SC) application.
+ **
+ ** Notes:
+ **   SC works on the table addresses in SC_OperData, which the tests point
+ **   at the buffers here instead of getting them from cFE TBL.
+ **
+ *************************************************************************/
+
+#include "sc_test_utils.h"
+
+uint16               SC_Test_AtsTbl [SC_NUMBER_OF_ATS][SC_ATS_BUFF_SIZE];
+uint16               SC_Test_AppendTbl [SC_APPEND_BUFF_SIZE];
+uint16               SC_Test_RtsTbl [SC_NUMBER_OF_RTS][SC_RTS_BUFF_SIZE];
+
+static uint8                SC_Test_AtsCmdStatus [SC_NUMBER_OF_ATS][SC_MAX_ATS_CMDS];
+static SC_AtsInfoTable_t    SC_Test_AtsInfo [SC_NUMBER_OF_ATS];
+static SC_AtsInfoTable_t    SC_Test_AppendInfo;
+static SC_AtpControlBlock_t SC_Test_AtpCtrl;
+static SC_RtsInfoEntry_t    SC_Test_RtsInfo [SC_NUMBER_OF_RTS];
+static SC_RtpControlBlock_t SC_Test_RtpCtrl;
+
+/*
+ * Function Definitions
+ */
+
+void SC_Test_Setup(void)
+{
+    uint16 i;
+
+    /* initialize test environment to default state for every test */
+
+    CFE_PSP_MemSet(&SC_AppData, 0, sizeof(SC_AppData_t));
+    CFE_PSP_MemSet(&SC_OperData, 0, sizeof(SC_OperData_t));
+    CFE_PSP_MemSet(SC_Test_AtsTbl, 0, sizeof(SC_Test_AtsTbl));
+    CFE_PSP_MemSet(SC_Test_AppendTbl, 0, sizeof(SC_Test_AppendTbl));
+    CFE_PSP_MemSet(SC_Test_RtsTbl, 0, sizeof(SC_Test_RtsTbl));
+    CFE_PSP_MemSet(SC_Test_AtsCmdStatus, 0, sizeof(SC_Test_AtsCmdStatus));
+    CFE_PSP_MemSet(SC_Test_AtsInfo, 0, sizeof(SC_Test_AtsInfo));
+    CFE_PSP_MemSet(&SC_Test_AppendInfo, 0, sizeof(SC_Test_AppendInfo));
+    CFE_PSP_MemSet(&SC_Test_AtpCtrl, 0, sizeof(SC_Test_AtpCtrl));
+    CFE_PSP_MemSet(SC_Test_RtsInfo, 0, sizeof(SC_Test_RtsInfo));
+    CFE_PSP_MemSet(&SC_Test_RtpCtrl, 0, sizeof(SC_Test_RtpCtrl));
+
+    for (i = 0; i < SC_NUMBER_OF_ATS; i++)
+    {
+        SC_OperData.AtsTblAddr[i]          = SC_Test_AtsTbl[i];
+        SC_OperData.AtsCmdStatusTblAddr[i] = SC_Test_AtsCmdStatus[i];
+    }
+
+    for (i = 0; i < SC_NUMBER_OF_RTS; i++)
+    {
+        SC_OperData.RtsTblAddr[i] = SC_Test_RtsTbl[i];
+    }
+
+    SC_OperData.AppendTblAddr     = SC_Test_AppendTbl;
+    SC_OperData.AtsInfoTblAddr    = SC_Test_AtsInfo;
+    SC_OperData.AppendInfoTblAddr = &SC_Test_AppendInfo;
+    SC_OperData.AtsCtrlBlckAddr   = &SC_Test_AtpCtrl;
+    SC_OperData.RtsInfoTblAddr    = SC_Test_RtsInfo;
+    SC_OperData.RtsCtrlBlckAddr   = &SC_Test_RtpCtrl;
+
+    SC_OperData.AtsCtrlBlckAddr->AtpState = SC_IDLE;
+
+    Ut_CFE_EVS_Reset();
+    Ut_CFE_FS_Reset();
+    Ut_CFE_TIME_Reset();
+    Ut_CFE_TBL_Reset();
+    Ut_CFE_SB_Reset();
+    Ut_CFE_ES_Reset();
+    Ut_OSAPI_Reset();
+    Ut_OSFILEAPI_Reset();
+} /* end SC_Test_Setup */
+
+void SC_Test_TearDown(void)
+{
+    /* cleanup test environment */
+} /* end SC_Test_TearDown */
+
+/*
+ * Writes an ATS entry with the smallest command, returns its length in words
+ */
+uint16 SC_Test_AtsEntry(uint16 *Buffer, uint16 CmdNumber, SC_AbsTimeTag_t Time)
+{
+    SC_AtsEntryHeader_t *Entry = (SC_AtsEntryHeader_t *) Buffer;
+
+    Entry->CmdNumber = CmdNumber;
+    CFE_PSP_MemCpy(&Entry->TimeTag1, &Time, sizeof(SC_AbsTimeTag_t));
+    CFE_SB_InitMsg(Entry->CmdHeader, SC_TEST_CMD_MID, SC_TEST_CMD_SIZE, TRUE);
+
+    return (SC_ATS_HDR_NOPKT_WORDS + (SC_TEST_CMD_SIZE / 2));
+} /* end SC_Test_AtsEntry */
+
+/*
+ * Writes an RTS entry with the smallest command, returns its length in words
+ */
+uint16 SC_Test_RtsEntry(uint16 *Buffer, SC_RelTimeTag_t TimeTag)
+{
+    SC_RtsEntryHeader_t *Entry = (SC_RtsEntryHeader_t *) Buffer;
+
+    Entry->TimeTag = TimeTag;
+    CFE_SB_InitMsg(Entry->CmdHeader, SC_TEST_CMD_MID, SC_TEST_CMD_SIZE, TRUE);
+
+    return ((SC_RTS_HEADER_SIZE + SC_TEST_CMD_SIZE + 1) / SC_BYTES_IN_WORD);
+} /* end SC_Test_RtsEntry */
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -0,0 +1,69 @@
+ /*************************************************************************
+ ** File:
+ **   sc_test_utils.h
+ **
+ ** Purpose:
+ **   This file contains the function prototypes and global variables for the
+ **   UT-Assert unit test utilities for the CFS Stored Command (SC)
+ **   application.
+ **
+ ** Notes:
+ **
+ *************************************************************************/
+
+#ifndef _sc_test_utils_h_
+#define _sc_test_utils_h_
+
+/*
+ * Includes
+ */
+
+#include "sc_app.h"
+#include "sc_loads.h"
+#include "sc_utils.h"
+#include "sc_events.h"
+#include "sc_msgdefs.h"
+#include "sc_tbldefs.h"
+#include "ut_cfe_evs_hooks.h"
+#include "ut_cfe_sb_hooks.h"
+#include "ut_cfe_time_stubs.h"
+#include "ut_cfe_psp_memutils_stubs.h"
+#include "ut_cfe_tbl_stubs.h"
+#include "ut_cfe_tbl_hooks.h"
+#include "ut_cfe_fs_stubs.h"
+#include "ut_osapi_stubs.h"
+#include "ut_osfileapi_stubs.h"
+#include "ut_cfe_sb_stubs.h"
+#include "ut_cfe_es_stubs.h"
+#include "ut_cfe_evs_stubs.h"
+
+/*
+ * Defines
+ */
+
+#define SC_TEST_CMD_MID         0x18A9
+#define SC_TEST_CMD_SIZE        SC_PACKET_MIN_SIZE
+
+/*
+ * Global Data
+ */
+
+extern uint16               SC_Test_AtsTbl [SC_NUMBER_OF_ATS][SC_ATS_BUFF_SIZE];
+extern uint16               SC_Test_AppendTbl [SC_APPEND_BUFF_SIZE];
+extern uint16               SC_Test_RtsTbl [SC_NUMBER_OF_RTS][SC_RTS_BUFF_SIZE];
+
+/*
+ * Function Definitions
+ */
+
+void SC_Test_Setup(void);
+void SC_Test_TearDown(void);
+
+uint16 SC_Test_AtsEntry(uint16 *Buffer, uint16 CmdNumber, SC_AbsTimeTag_t Time);
+uint16 SC_Test_RtsEntry(uint16 *Buffer, SC_RelTimeTag_t TimeTag);
+
+#endif /* _sc_test_utils_h_ */
+
+/************************/
+/*  End of File Comment */
+/************************/
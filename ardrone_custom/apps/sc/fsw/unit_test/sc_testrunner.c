@@ -0,0 +1,27 @@
+ /*************************************************************************
+ ** File:
+ **   sc_testrunner.c
+ **
+ ** Purpose:
+ **   This file contains the UT-Assert unit test runner for the CFS
+ **   Stored Command (SC) application
+ **
+ ** Notes:
+ **
+ *************************************************************************/
+
+#include "uttest.h"
+#include "sc_loads_test.h"
+#include "sc_state_test.h"
+
+int main(void)
+{
+    SC_Loads_Test_AddTestCases();
+    SC_State_Test_AddTestCases();
+
+    return(UtTest_Run());
+} /* end main */
+
+/************************/
+/*  End of File Comment */
+/************************/
@@ -0,0 +1,119 @@
+##############################################################################
+## File:
+##   ut_assert.mak
+##
+## Purpose:
+##   Makefile for building the CFS Stored Command (SC) UT-Assert unit tests,
+##   alongside the UTF unit test built by Makefile.  Run from this directory
+##   after sourcing the mission setvars.sh:
+##
+##     make -f ut_assert.mak
+##     make -f ut_assert.mak run
+##
+##   The compiler options come from the PSP, as for the flight build, and the
+##   cFE platform configuration from the mission build (PLATFORM_INC).
+##
+##############################################################################
+
+#
+# Mission build to take the cFE platform configuration and PSP from
+#
+PLATFORM_INC ?= $(CFS_MISSION)/build/linux/inc
+
+include $(CFS_MISSION)/build/linux/cfe/cfe-config.mak
+include $(CFE_PSP_SRC)/$(PSP)/make/compiler-opts.mak
+
+UT_ASSERT = $(CFE_TOOLS)/ut_assert
+
+#
+# Source file path definitions
+#
+VPATH := .
+VPATH += $(CFS_APP_SRC)/sc/fsw/src
+VPATH += $(UT_ASSERT)/src
+
+#
+# Header file path definitions
+#
+INCLUDES := -I.
+INCLUDES += -I$(CFS_APP_SRC)/sc/fsw/src
+INCLUDES += -I$(CFS_APP_SRC)/sc/fsw/platform_inc
+INCLUDES += -I$(CFS_APP_SRC)/sc/fsw/mission_inc
+INCLUDES += -I$(UT_ASSERT)/inc
+INCLUDES += -I$(PLATFORM_INC)
+INCLUDES += -I$(CFS_MISSION_INC)
+INCLUDES += -I$(OSAL_SRC)/inc
+INCLUDES += -I$(CFE_PSP_SRC)/inc
+INCLUDES += -I$(CFE_PSP_SRC)/$(PSP)/inc
+INCLUDES += -I$(CFE_CORE_SRC)/inc
+INCLUDES += -I$(CFE_CORE_SRC)/time
+INCLUDES += -I$(CFE_CORE_SRC)/sb
+INCLUDES += -I$(CFE_CORE_SRC)/es
+INCLUDES += -I$(CFE_CORE_SRC)/evs
+INCLUDES += -I$(CFE_CORE_SRC)/fs
+INCLUDES += -I$(CFE_CORE_SRC)/tbl
+
+#
+# SC object files
+#
+FLIGHT_OBJS := sc_app.o
+FLIGHT_OBJS += sc_atsrq.o
+FLIGHT_OBJS += sc_cmds.o
+FLIGHT_OBJS += sc_loads.o
+FLIGHT_OBJS += sc_rtsrq.o
+FLIGHT_OBJS += sc_state.o
+FLIGHT_OBJS += sc_utils.o
+
+#
+# UT-Assert object files
+#
+UT_OBJS := ut_osapi_stubs.o
+UT_OBJS += ut_osfileapi_stubs.o
+UT_OBJS += ut_cfe_sb_stubs.o
+UT_OBJS += ut_cfe_es_stubs.o
+UT_OBJS += ut_cfe_evs_stubs.o
+UT_OBJS += ut_cfe_time_stubs.o
+UT_OBJS += ut_cfe_fs_stubs.o
+UT_OBJS += ut_cfe_psp_memutils_stubs.o
+UT_OBJS += ut_cfe_tbl_stubs.o
+UT_OBJS += ut_cfe_sb_hooks.o
+UT_OBJS += ut_cfe_es_hooks.o
+UT_OBJS += ut_cfe_evs_hooks.o
+UT_OBJS += ut_cfe_tbl_hooks.o
+UT_OBJS += ut_cfe_time_hooks.o
+UT_OBJS += utassert.o
+UT_OBJS += utlist.o
+UT_OBJS += uttest.o
+UT_OBJS += uttools.o
+
+#
+# SC unit test object files
+#
+TEST_OBJS := sc_testrunner.o
+TEST_OBJS += sc_test_utils.o
+TEST_OBJS += sc_loads_test.o
+TEST_OBJS += sc_state_test.o
+
+UT_TEST_RUNNER = sc_testrunner.bin
+
+#
+# Rules to make the specified targets
+#
+%.o: %.c
+	$(COMPILER) -c $(COPTS) -g $(INCLUDES) -o $@ $<
+
+all: $(UT_TEST_RUNNER)
+
+$(UT_TEST_RUNNER): $(TEST_OBJS) $(UT_OBJS) $(FLIGHT_OBJS)
+	$(COMPILER) $(ARCH_OPTS) $^ -o $@
+
+run: $(UT_TEST_RUNNER)
+	./$(UT_TEST_RUNNER)
+
+clean:
+	rm -f $(TEST_OBJS) $(UT_OBJS) $(FLIGHT_OBJS) $(UT_TEST_RUNNER)
+
+#
+###########################################################################
+#
+# end of file
@@ -60,6 +60,7 @@ static TO_subsciption_t  TO_SubTable[] =
             {CFE_SB_STATS_TLM_MID,  {0,0},  4},
             {CFE_TBL_REG_TLM_MID,   {0,0},  4},
             {CFE_EVS_EVENT_MSG_MID, {0,0},  32},
+            {CFE_EVS_DEFERRED_EVENT_MSG_MID,{0,0},  32},
             {CFE_ES_SHELL_TLM_MID,  {0,0},  32},
             {CFE_ES_APP_TLM_MID,    {0,0},   4},
             {CFE_ES_MEMSTATS_TLM_MID,{0,0},  4},
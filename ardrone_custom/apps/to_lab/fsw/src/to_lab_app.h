@@ -43,6 +43,7 @@
 //#define TO_TASK_MSEC             500          /* run at 2 Hz */
 #define TO_TASK_MSEC             100          /* run at 10 Hz */
 #define TO_UNUSED                  0
+#define TO_TLM_BATCH              16          /* packets taken per receive */
 
 #define cfgTLM_PORT 5011
 #define TO_LAB_VERSION_NUM "5.1.0"
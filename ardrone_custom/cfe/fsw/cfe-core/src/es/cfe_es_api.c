@@ -733,6 +733,14 @@ int32 CFE_ES_RegisterApp(void)
    
    CFE_ES_UnlockSharedData(__func__,__LINE__);
 
+   /*
+   ** Let SB look up the name it reports as sender once, outside the lock
+   */
+   if (Result == CFE_SUCCESS)
+   {
+       CFE_SB_RegisterSender();
+   }
+
    return(Result);
   
 
@@ -1129,6 +1137,14 @@ int32 CFE_ES_RegisterChildTask(void)
 
    CFE_ES_UnlockSharedData(__func__,__LINE__);
 
+   /*
+   ** Let SB look up the name it reports as sender once, outside the lock
+   */
+   if (ReturnCode == CFE_SUCCESS)
+   {
+       CFE_SB_RegisterSender();
+   }
+
    return(ReturnCode);
 
 } /* End of CFE_ES_RegisterChildTask() */
@@ -82,6 +82,10 @@ int32 CFE_ES_SysLogDump(const char *Filename);
 */
 int32 CFE_ES_PerfLogClear(void);
 void CFE_ES_PerfLogDump(void); 
+void CFE_ES_PerfLogTally(void);
+void CFE_ES_PerfStreamer(void);
+void CFE_ES_PerfStreamDrain(void);
+void CFE_ES_PerfLatencyReport(CFE_ES_PerfLatency_t *Report);
 
 /*
 ** Exception and Reset Log API
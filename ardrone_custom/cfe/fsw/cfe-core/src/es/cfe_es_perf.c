@@ -88,6 +88,7 @@
 */
 CFE_ES_PerfData_t      *Perf;
 CFE_ES_PerfLogDump_t    CFE_ES_PerfLogDumpStatus;
+CFE_ES_PerfStream_t     CFE_ES_PerfStreamStatus;
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /* Name: CFE_ES_SetupPerfVariables                                               */
@@ -111,6 +112,7 @@ void CFE_ES_SetupPerfVariables(uint32 ResetType)
         uint8  Endian;
     } EndianCheck = { .Word = 0x0100 };
 
+    const uint32 LatencyMarkers[CFE_ES_PERF_LATENCY_SLOTS] = CFE_ES_PERF_LATENCY_MARKERS_INIT;
 
     uint32      i;
 
@@ -126,6 +128,14 @@ void CFE_ES_SetupPerfVariables(uint32 ResetType)
        ** collection so the ground can dump the data
        */
        Perf->MetaData.State = CFE_ES_PERF_IDLE;
+
+       /*
+       ** A task may have been adding an entry when the reset hit
+       */
+       for (i=0; i < CFE_ES_PERF_DATA_RINGS; i++)
+       {
+          Perf->Ring[i].Owner = 0;
+       }
     }
     else
     {
@@ -151,11 +161,28 @@ void CFE_ES_SetupPerfVariables(uint32 ResetType)
           Perf->MetaData.TriggerMask[i] = CFE_ES_PERF_TRIGMASK_INIT;
        }
 
+       Perf->Generation = 0;
+       Perf->LostCount = 0;
+       memset(Perf->Ring, 0, sizeof(Perf->Ring));
+
     }
 
     CFE_ES_PerfLogDumpStatus.DataToWrite = 0;
     CFE_ES_PerfLogDumpStatus.ChildID = 0;
     CFE_ES_PerfLogDumpStatus.DataFileName[0] = '\0';
+
+    /* measurements of the latency markers start with the first stream */
+    CFE_ES_PerfStreamStatus.Running = 0;
+    CFE_ES_PerfStreamStatus.ChildID = 0;
+    CFE_ES_PerfStreamStatus.LostCount = 0;
+    CFE_ES_PerfStreamStatus.PacketCount = 0;
+
+    for (i=0; i < CFE_ES_PERF_LATENCY_SLOTS; i++)
+    {
+       CFE_ES_PerfStreamStatus.Latency[i].Marker = LatencyMarkers[i];
+       CFE_ES_PerfStreamStatus.Latency[i].Measured = CFE_ES_PERF_NO_MARKER;
+       CFE_ES_PerfStreamStatus.Latency[i].Count = 0;
+    }
 }
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
@@ -167,6 +194,7 @@ void CFE_ES_PerfStartDataCmd(CFE_SB_MsgPtr_t msg){
 
    uint16 ExpectedLength = sizeof(CFE_ES_PerfStartCmd_t);
    CFE_ES_PerfStartCmd_Payload_t *CmdPtr = (CFE_ES_PerfStartCmd_Payload_t *)&msg->Byte[CFE_SB_CMD_HDR_SIZE];
+   int32 Stat = CFE_SUCCESS;
 
    /*
     ** Verify command packet length.
@@ -181,26 +209,56 @@ void CFE_ES_PerfStartDataCmd(CFE_SB_MsgPtr_t msg){
           if ((CmdPtr->TriggerMode >= CFE_ES_PERF_TRIGGER_START) && (CmdPtr->TriggerMode < CFE_ES_PERF_MAX_MODES))
           {
 
-             CFE_ES_TaskData.CmdCounter++;
-
              Perf->MetaData.Mode = CmdPtr->TriggerMode;
              Perf->MetaData.TriggerCount = 0;
              Perf->MetaData.DataStart = 0;
              Perf->MetaData.DataEnd = 0;
              Perf->MetaData.DataCount = 0;
              Perf->MetaData.InvalidMarkerReported = FALSE;
-             Perf->MetaData.State = CFE_ES_PERF_WAITING_FOR_TRIGGER; /* this must be done last */
-
-             CFE_EVS_SendEvent(CFE_ES_PERF_STARTCMD_EID, CFE_EVS_DEBUG,
-                                 "Start collecting performance data cmd received, trigger mode = %d", 
-                              (int)CmdPtr->TriggerMode);
+             Perf->LostCount = 0;
+
+             /* rings still holding an older generation are emptied by their next entry */
+             __atomic_add_fetch(&Perf->Generation, 1, __ATOMIC_RELEASE);
+
+             /* this must be done last */
+             __atomic_store_n(&Perf->MetaData.State, CFE_ES_PERF_WAITING_FOR_TRIGGER, __ATOMIC_SEQ_CST);
+
+             /* a streaming child task still finishing an earlier stream carries on with this one */
+             if ((CmdPtr->TriggerMode == CFE_ES_PERF_STREAM) &&
+                 (__atomic_exchange_n(&CFE_ES_PerfStreamStatus.Running, 1, __ATOMIC_SEQ_CST) == 0))
+             {
+                Stat = CFE_ES_CreateChildTask(&CFE_ES_PerfStreamStatus.ChildID,
+                                              CFE_ES_PERF_STREAM_CHILD_NAME,
+                                              CFE_ES_PerfStreamer,
+                                              CFE_ES_PERF_CHILD_STACK_PTR,
+                                              CFE_ES_PERF_CHILD_STACK_SIZE,
+                                              CFE_ES_PERF_CHILD_PRIORITY,
+                                              CFE_ES_PERF_CHILD_FLAGS);
+             }
+
+             if (Stat == CFE_SUCCESS)
+             {
+                CFE_ES_TaskData.CmdCounter++;
+                CFE_EVS_SendEvent(CFE_ES_PERF_STARTCMD_EID, CFE_EVS_DEBUG,
+                                    "Start collecting performance data cmd received, trigger mode = %d", 
+                                 (int)CmdPtr->TriggerMode);
+             }
+             else
+             {
+                __atomic_store_n(&Perf->MetaData.State, CFE_ES_PERF_IDLE, __ATOMIC_SEQ_CST);
+                __atomic_store_n(&CFE_ES_PerfStreamStatus.Running, 0, __ATOMIC_SEQ_CST);
+                CFE_ES_TaskData.ErrCounter++;
+                CFE_EVS_SendEvent(CFE_ES_PERF_STREAM_ERR_EID, CFE_EVS_ERROR,
+                                 "Cannot stream performance data,Error creating child task RC=0x%08X",
+                                 (unsigned int)Stat);
+             }/* end if */
           }
           else
           {
              CFE_ES_TaskData.ErrCounter++;
              CFE_EVS_SendEvent(CFE_ES_PERF_STARTCMD_TRIG_ERR_EID, CFE_EVS_ERROR,
                   "Cannot start collecting performance data, trigger mode (%d) out of range (%d to %d)", 
-               (int)CmdPtr->TriggerMode, (int)CFE_ES_PERF_TRIGGER_START, (int)CFE_ES_PERF_TRIGGER_END);
+               (int)CmdPtr->TriggerMode, (int)CFE_ES_PERF_TRIGGER_START, (int)(CFE_ES_PERF_MAX_MODES - 1));
           }/* end if */
        }
        else
@@ -234,7 +292,8 @@ void CFE_ES_PerfStopDataCmd(CFE_SB_MsgPtr_t Msg){
       /* Ensure there is no file write in progress before proceeding */
       if(CFE_ES_PerfLogDumpStatus.DataToWrite == 0)
       {
-          Perf->MetaData.State = CFE_ES_PERF_IDLE;
+          __atomic_store_n(&Perf->MetaData.State, CFE_ES_PERF_IDLE, __ATOMIC_SEQ_CST);
+          CFE_ES_PerfLogTally();
 
           /* Copy out the string, using default if unspecified */
           CFE_SB_MessageStringGet(CFE_ES_PerfLogDumpStatus.DataFileName, CmdPtr->DataFileName,
@@ -297,6 +356,118 @@ void CFE_ES_PerfStopDataCmd(CFE_SB_MsgPtr_t Msg){
 } /* End of CFE_ES_PerfStopDataCmd() */
 
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/* Name: CFE_ES_PerfLogTally                                                     */
+/*                                                                               */
+/* Purpose: Fill in the data and trigger counts of the metadata from the rings.  */
+/*                                                                               */
+/* Assumptions and Notes:                                                        */
+/*                                                                               */
+/*  DataStart and DataEnd describe the rings merged into one buffer, which is    */
+/*  how CFE_ES_PerfLogDump writes them.  Rings left over from an earlier         */
+/*  collection count as empty.                                                   */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void CFE_ES_PerfLogTally(void)
+{
+    uint32      Generation;
+    uint32      DataCount = 0;
+    uint32      TriggerCount = 0;
+    uint32      i;
+
+    Generation = __atomic_load_n(&Perf->Generation, __ATOMIC_ACQUIRE);
+
+    for (i=0; i < CFE_ES_PERF_DATA_RINGS; i++) {
+
+        if (Perf->Ring[i].Generation == Generation) {
+            DataCount += Perf->Ring[i].Count;
+            TriggerCount += Perf->Ring[i].TriggerCount;
+        }
+    }
+
+    Perf->MetaData.TriggerCount = TriggerCount;
+    Perf->MetaData.DataStart = 0;
+    Perf->MetaData.DataEnd = DataCount % CFE_ES_PERF_DATA_BUFFER_SIZE;
+    Perf->MetaData.DataCount = DataCount;
+
+}/* end CFE_ES_PerfLogTally */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/* Name: CFE_ES_PerfStartMerge                                                   */
+/*                                                                               */
+/* Purpose: Point the dump at the oldest entry of each ring.                     */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void CFE_ES_PerfStartMerge(void)
+{
+    CFE_ES_PerfRing_t  *Ring;
+    uint32              i;
+
+    for (i=0; i < CFE_ES_PERF_DATA_RINGS; i++) {
+
+        Ring = &Perf->Ring[i];
+
+        if (Ring->Generation == Perf->Generation) {
+            CFE_ES_PerfLogDumpStatus.RingLeft[i] = Ring->Count;
+            CFE_ES_PerfLogDumpStatus.RingPos[i] = (Ring->Next + CFE_ES_PERF_RING_SIZE - Ring->Count) %
+                                                  CFE_ES_PERF_RING_SIZE;
+        }
+        else {
+            CFE_ES_PerfLogDumpStatus.RingLeft[i] = 0;
+            CFE_ES_PerfLogDumpStatus.RingPos[i] = 0;
+        }
+    }
+
+}/* end CFE_ES_PerfStartMerge */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/* Name: CFE_ES_PerfNextEntry                                                    */
+/*                                                                               */
+/* Purpose: Take the earliest entry not yet written from any ring.               */
+/*                                                                               */
+/* Assumptions and Notes:                                                        */
+/*                                                                               */
+/*  Each ring is in time order already, since its owner reads the timebase       */
+/*  while holding the ring, so the earliest entry is the head of some ring.      */
+/*  Equal times go to the lower ring.  The caller must not ask for more than     */
+/*  the DataCount set by CFE_ES_PerfLogTally.                                    */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static CFE_ES_PerfDataEntry_t *CFE_ES_PerfNextEntry(void)
+{
+    CFE_ES_PerfDataEntry_t *Entry;
+    CFE_ES_PerfDataEntry_t *Best = NULL;
+    uint32                  BestRing = 0;
+    uint32                  i;
+
+    for (i=0; i < CFE_ES_PERF_DATA_RINGS; i++) {
+
+        if (CFE_ES_PerfLogDumpStatus.RingLeft[i] != 0) {
+
+            Entry = &Perf->DataBuffer[(i * CFE_ES_PERF_RING_SIZE) + CFE_ES_PerfLogDumpStatus.RingPos[i]];
+
+            if ((Best == NULL) ||
+                (Entry->TimerUpper32 < Best->TimerUpper32) ||
+                ((Entry->TimerUpper32 == Best->TimerUpper32) && (Entry->TimerLower32 < Best->TimerLower32))) {
+                Best = Entry;
+                BestRing = i;
+            }
+        }
+    }
+
+    CFE_ES_PerfLogDumpStatus.RingLeft[BestRing]--;
+    CFE_ES_PerfLogDumpStatus.RingPos[BestRing]++;
+    if (CFE_ES_PerfLogDumpStatus.RingPos[BestRing] >= CFE_ES_PERF_RING_SIZE) {
+        CFE_ES_PerfLogDumpStatus.RingPos[BestRing] = 0;
+    }
+
+    return Best;
+
+}/* end CFE_ES_PerfNextEntry */
+
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*  Function:  CFE_ES_PerfLogDump()                                              */
 /*                                                                               */
@@ -309,13 +480,25 @@ void CFE_ES_PerfStopDataCmd(CFE_SB_MsgPtr_t Msg){
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 void CFE_ES_PerfLogDump(void){
 
-    int32               WriteStat;
-    uint32              i;
-    uint32              FileSize;
-    CFE_FS_Header_t     FileHdr;
+    int32                   WriteStat;
+    uint32                  i;
+    uint32                  FileSize;
+    CFE_FS_Header_t         FileHdr;
+    CFE_ES_PerfDataEntry_t *Entry;
 
     CFE_ES_RegisterChildTask();
 
+    /* let a task that was adding an entry when collection stopped finish it */
+    for(i=0; i < CFE_ES_PERF_DATA_RINGS; i++){
+      while(__atomic_load_n(&Perf->Ring[i].Owner, __ATOMIC_SEQ_CST) != 0){
+        OS_TaskDelay(1);
+      }/* end while */
+    }/* end for */
+
+    /* the metadata describes the rings merged into one buffer in time order */
+    CFE_ES_PerfLogTally();
+    CFE_ES_PerfStartMerge();
+
 
     /* Zero cFE header, then fill in fields */
     CFE_FS_InitHeader(&FileHdr, CFE_ES_PERF_LOG_DESC, CFE_FS_ES_PERFDATA_SUBTYPE);
@@ -351,7 +534,8 @@ void CFE_ES_PerfLogDump(void){
 
     /* write the collected data to the file */
     for(i=0; i < Perf->MetaData.DataCount; i++){
-      WriteStat = OS_write (CFE_ES_PerfLogDumpStatus.DataFileDescriptor, &Perf->DataBuffer[i], sizeof(CFE_ES_PerfDataEntry_t));
+      Entry = CFE_ES_PerfNextEntry();
+      WriteStat = OS_write (CFE_ES_PerfLogDumpStatus.DataFileDescriptor, Entry, sizeof(CFE_ES_PerfDataEntry_t));
       if(WriteStat != sizeof(CFE_ES_PerfDataEntry_t))
       {
         CFE_ES_FileWriteByteCntErr(&CFE_ES_PerfLogDumpStatus.DataFileName[0],
@@ -374,14 +558,418 @@ void CFE_ES_PerfLogDump(void){
     OS_close(CFE_ES_PerfLogDumpStatus.DataFileDescriptor);
 
     CFE_EVS_SendEvent(CFE_ES_PERF_DATAWRITTEN_EID,CFE_EVS_DEBUG,
-                      "%s written:Size=%d,EntryCount=%d",
+                      "%s written:Size=%d,EntryCount=%d,Lost=%d",
                        &CFE_ES_PerfLogDumpStatus.DataFileName[0],(int)FileSize,
-                       (int)Perf->MetaData.DataCount);
+                       (int)Perf->MetaData.DataCount,(int)Perf->LostCount);
 
     CFE_ES_ExitChildTask();
 
 }/* end CFE_ES_PerfLogDump */
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/* Name: CFE_ES_PerfStreaming                                                    */
+/*                                                                               */
+/* Purpose: Tell whether data is being collected in streaming mode.              */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static boolean CFE_ES_PerfStreaming(void)
+{
+    return (__atomic_load_n(&Perf->MetaData.State, __ATOMIC_SEQ_CST) != CFE_ES_PERF_IDLE) &&
+           (Perf->MetaData.Mode == CFE_ES_PERF_STREAM);
+
+}/* end CFE_ES_PerfStreaming */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*  Function:  CFE_ES_PerfStreamer()                                             */
+/*                                                                               */
+/*  Purpose:                                                                     */
+/*    Send the performance data in stream packets while collecting in            */
+/*    streaming mode                                                             */
+/*                                                                               */
+/*  Arguments:                                                                   */
+/*    None                                                                       */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void CFE_ES_PerfStreamer(void){
+
+    boolean     Streaming = TRUE;
+    uint32      i;
+
+    CFE_ES_RegisterChildTask();
+
+    while(Streaming){
+
+      OS_TaskDelay(CFE_ES_PERF_STREAM_MS_DELAY);
+      Streaming = CFE_ES_PerfStreaming();
+
+      /* the last pass also sends what tasks were adding when collection stopped */
+      if(!Streaming){
+        for(i=0; i < CFE_ES_PERF_DATA_RINGS; i++){
+          while(__atomic_load_n(&Perf->Ring[i].Owner, __ATOMIC_SEQ_CST) != 0){
+            OS_TaskDelay(1);
+          }/* end while */
+        }/* end for */
+      }/* end if */
+
+      CFE_ES_PerfStreamDrain();
+
+      if(!Streaming){
+        __atomic_store_n(&CFE_ES_PerfStreamStatus.Running, 0, __ATOMIC_SEQ_CST);
+
+        /* a start in streaming mode since the check may have found this task still running */
+        Streaming = CFE_ES_PerfStreaming() &&
+                    (__atomic_exchange_n(&CFE_ES_PerfStreamStatus.Running, 1, __ATOMIC_SEQ_CST) == 0);
+      }/* end if */
+
+    }/* end while */
+
+    CFE_ES_ExitChildTask();
+
+}/* end CFE_ES_PerfStreamer */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/* Name: CFE_ES_PerfLatencyClear                                                 */
+/*                                                                               */
+/* Purpose: Start the measurements of a latency slot over for the given marker.  */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void CFE_ES_PerfLatencyClear(CFE_ES_PerfLatencySlot_t *Slot, uint32 Marker)
+{
+    Slot->Open = FALSE;
+    Slot->Count = 0;
+    Slot->MinTime = 0;
+    Slot->MaxTime = 0;
+    Slot->TotalTime = 0;
+    memset(Slot->Histogram, 0, sizeof(Slot->Histogram));
+    Slot->Measured = Marker;
+
+}/* end CFE_ES_PerfLatencyClear */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/* Name: CFE_ES_PerfLatencyBucket                                                */
+/*                                                                               */
+/* Purpose: Find the histogram bucket of a latency in microseconds.              */
+/*                                                                               */
+/* Assumptions and Notes:                                                        */
+/*                                                                               */
+/*  Buckets 0 to 3 hold 0 to 3 us.  From there each power of 2 is split in 4, so */
+/*  a bucket is at most a quarter wider than the latencies it holds.             */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint32 CFE_ES_PerfLatencyBucket(uint32 Time)
+{
+    uint32 Power;
+    uint32 Bucket;
+
+    if (Time < 4) {
+        return Time;
+    }
+
+    Power = 31 - __builtin_clz(Time);
+    Bucket = ((Power - 1) * 4) + ((Time >> (Power - 2)) & 3);
+
+    return (Bucket < CFE_ES_PERF_LATENCY_BUCKETS) ? Bucket : (CFE_ES_PERF_LATENCY_BUCKETS - 1);
+
+}/* end CFE_ES_PerfLatencyBucket */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/* Name: CFE_ES_PerfLatencyBucketTop                                             */
+/*                                                                               */
+/* Purpose: Find the longest latency in microseconds a histogram bucket holds.   */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static uint32 CFE_ES_PerfLatencyBucketTop(uint32 Bucket)
+{
+    if (Bucket < 4) {
+        return Bucket;
+    }
+
+    return ((5 + (Bucket % 4)) << ((Bucket / 4) - 1)) - 1;
+
+}/* end CFE_ES_PerfLatencyBucketTop */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/* Name: CFE_ES_PerfLatencyAdd                                                   */
+/*                                                                               */
+/* Purpose: Measure the latency of a streamed entry for the slots measuring its  */
+/*          marker.                                                              */
+/*                                                                               */
+/* Assumptions and Notes:                                                        */
+/*                                                                               */
+/*  An exit is paired with the last entry of its marker streamed before it.      */
+/*  An exit with no entry waiting, or timed before it, is not measured.          */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static void CFE_ES_PerfLatencyAdd(const CFE_ES_PerfStreamEntry_t *Entry)
+{
+    CFE_ES_PerfLatencySlot_t   *Slot;
+    uint32                      Marker;
+    uint32                      Time;
+    uint64                      Rollover;
+    uint64                      TicksPerSecond;
+    uint64                      Start;
+    uint64                      End;
+    uint64                      Ticks;
+    uint32                      i;
+
+    Marker = Entry->Data & ~((uint32)1 << CFE_ES_PERF_EXIT_BIT);
+
+    for (i=0; i < CFE_ES_PERF_LATENCY_SLOTS; i++) {
+
+        Slot = &CFE_ES_PerfStreamStatus.Latency[i];
+
+        if (Slot->Measured != Marker) {
+            continue;
+        }
+
+        if (Entry->Data == Marker) {
+            Slot->Open = TRUE;
+            Slot->OpenUpper32 = Entry->TimerUpper32;
+            Slot->OpenLower32 = Entry->TimerLower32;
+            continue;
+        }
+
+        if (!Slot->Open) {
+            continue;
+        }
+        Slot->Open = FALSE;
+
+        /* a rollover of 0 is the full 32 bits */
+        Rollover = Perf->MetaData.TimerLow32Rollover;
+        if (Rollover == 0) {
+            Rollover = (uint64)1 << 32;
+        }
+
+        Start = ((uint64)Slot->OpenUpper32 * Rollover) + Slot->OpenLower32;
+        End = ((uint64)Entry->TimerUpper32 * Rollover) + Entry->TimerLower32;
+        TicksPerSecond = Perf->MetaData.TimerTicksPerSecond;
+
+        if ((End < Start) || (TicksPerSecond == 0)) {
+            continue;
+        }
+
+        Ticks = End - Start;
+        Ticks = ((Ticks / TicksPerSecond) * 1000000) + (((Ticks % TicksPerSecond) * 1000000) / TicksPerSecond);
+        Time = (Ticks > 0xFFFFFFFF) ? 0xFFFFFFFF : (uint32)Ticks;
+
+        if ((Slot->Count == 0) || (Time < Slot->MinTime)) {
+            Slot->MinTime = Time;
+        }
+        if (Time > Slot->MaxTime) {
+            Slot->MaxTime = Time;
+        }
+        Slot->TotalTime += Time;
+        Slot->Histogram[CFE_ES_PerfLatencyBucket(Time)]++;
+        Slot->Count++;
+    }
+
+}/* end CFE_ES_PerfLatencyAdd */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/* Name: CFE_ES_PerfStreamDrain                                                  */
+/*                                                                               */
+/* Purpose: Send the entries added to the rings since the last time in stream    */
+/*          packets, and measure the latency of the markers in them.             */
+/*                                                                               */
+/* Assumptions and Notes:                                                        */
+/*                                                                               */
+/*  No lock is taken.  Each ring publishes how many entries it has had added in  */
+/*  Added, once the entry is written.  The entries are copied into the packet    */
+/*  and Added is read again, so entries the owner overwrote during the copy,     */
+/*  the one it may still be writing included, are dropped and counted as lost    */
+/*  along with entries overwritten before the copy.  Entries added after this    */
+/*  starts on a ring wait for the next call.                                     */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void CFE_ES_PerfStreamDrain(void)
+{
+    CFE_ES_PerfStreamPacket_Payload_t  *Payload = &CFE_ES_PerfStreamStatus.Packet.Payload;
+    CFE_ES_PerfRing_t                  *Ring;
+    uint32                              Generation;
+    uint32                              Target;
+    uint32                              Added;
+    uint32                              First;
+    uint32                              Count;
+    uint32                              Skip;
+    uint32                              Pos;
+    uint32                              i;
+    uint32                              j;
+
+    /* a new collection starts the stream over */
+    Generation = __atomic_load_n(&Perf->Generation, __ATOMIC_ACQUIRE);
+    if (Generation != CFE_ES_PerfStreamStatus.Generation) {
+
+        CFE_ES_PerfStreamStatus.Generation = Generation;
+        CFE_ES_PerfStreamStatus.LostCount = 0;
+        memset(CFE_ES_PerfStreamStatus.Sent, 0, sizeof(CFE_ES_PerfStreamStatus.Sent));
+        memset(CFE_ES_PerfStreamStatus.SentPos, 0, sizeof(CFE_ES_PerfStreamStatus.SentPos));
+        memset(CFE_ES_PerfStreamStatus.Lost, 0, sizeof(CFE_ES_PerfStreamStatus.Lost));
+
+        for (i=0; i < CFE_ES_PERF_LATENCY_SLOTS; i++) {
+            CFE_ES_PerfLatencyClear(&CFE_ES_PerfStreamStatus.Latency[i], CFE_ES_PerfStreamStatus.Latency[i].Marker);
+        }
+    }
+
+    for (i=0; i < CFE_ES_PERF_LATENCY_SLOTS; i++) {
+        if (CFE_ES_PerfStreamStatus.Latency[i].Measured != CFE_ES_PerfStreamStatus.Latency[i].Marker) {
+            CFE_ES_PerfLatencyClear(&CFE_ES_PerfStreamStatus.Latency[i], CFE_ES_PerfStreamStatus.Latency[i].Marker);
+        }
+    }
+
+    for (i=0; i < CFE_ES_PERF_DATA_RINGS; i++) {
+
+        Ring = &Perf->Ring[i];
+
+        if (__atomic_load_n(&Ring->Generation, __ATOMIC_ACQUIRE) != Generation) {
+            continue;
+        }
+
+        Target = __atomic_load_n(&Ring->Added, __ATOMIC_ACQUIRE);
+
+        while (CFE_ES_PerfStreamStatus.Sent[i] != Target) {
+
+            /* entries already overwritten */
+            Count = Target - CFE_ES_PerfStreamStatus.Sent[i];
+            if (Count > CFE_ES_PERF_RING_SIZE) {
+                Skip = Count - CFE_ES_PERF_RING_SIZE;
+                CFE_ES_PerfStreamStatus.Sent[i] += Skip;
+                CFE_ES_PerfStreamStatus.SentPos[i] = (CFE_ES_PerfStreamStatus.SentPos[i] + (Skip % CFE_ES_PERF_RING_SIZE)) %
+                                                     CFE_ES_PERF_RING_SIZE;
+                CFE_ES_PerfStreamStatus.Lost[i] += Skip;
+                CFE_ES_PerfStreamStatus.LostCount += Skip;
+                Count = CFE_ES_PERF_RING_SIZE;
+            }
+
+            if (Count > CFE_ES_PERF_STREAM_PKT_ENTRIES) {
+                Count = CFE_ES_PERF_STREAM_PKT_ENTRIES;
+            }
+
+            First = CFE_ES_PerfStreamStatus.Sent[i];
+            Pos = CFE_ES_PerfStreamStatus.SentPos[i];
+
+            for (j=0; j < Count; j++) {
+                memcpy(&Payload->Entry[j], &Perf->DataBuffer[(i * CFE_ES_PERF_RING_SIZE) + Pos],
+                       sizeof(CFE_ES_PerfStreamEntry_t));
+                Pos++;
+                if (Pos >= CFE_ES_PERF_RING_SIZE) {
+                    Pos = 0;
+                }
+            }
+
+            /* entries overwritten during the copy */
+            __atomic_thread_fence(__ATOMIC_ACQUIRE);
+            if (__atomic_load_n(&Ring->Generation, __ATOMIC_RELAXED) != Generation) {
+                return;
+            }
+
+            Added = __atomic_load_n(&Ring->Added, __ATOMIC_RELAXED);
+            Skip = 0;
+            if ((Added - First) >= CFE_ES_PERF_RING_SIZE) {
+                Skip = (Added - First) - CFE_ES_PERF_RING_SIZE + 1;
+                if (Skip > Count) {
+                    Skip = Count;
+                }
+                memmove(&Payload->Entry[0], &Payload->Entry[Skip], (Count - Skip) * sizeof(CFE_ES_PerfStreamEntry_t));
+                CFE_ES_PerfStreamStatus.Lost[i] += Skip;
+                CFE_ES_PerfStreamStatus.LostCount += Skip;
+            }
+
+            CFE_ES_PerfStreamStatus.Sent[i] = First + Count;
+            CFE_ES_PerfStreamStatus.SentPos[i] = Pos;
+            Count -= Skip;
+
+            if (Count > 0) {
+
+                for (j=0; j < Count; j++) {
+                    CFE_ES_PerfLatencyAdd(&Payload->Entry[j]);
+                }
+
+                Payload->Generation = Generation;
+                Payload->Ring = i;
+                Payload->FirstEntry = First + Skip;
+                Payload->Lost = CFE_ES_PerfStreamStatus.Lost[i];
+                Payload->EntryCount = Count;
+
+                CFE_SB_SetTotalMsgLength((CFE_SB_Msg_t *) &CFE_ES_PerfStreamStatus.Packet,
+                                         sizeof(CFE_ES_PerfStreamPacket_t) - sizeof(Payload->Entry) +
+                                         (Count * sizeof(CFE_ES_PerfStreamEntry_t)));
+                CFE_SB_TimeStampMsg((CFE_SB_Msg_t *) &CFE_ES_PerfStreamStatus.Packet);
+                CFE_SB_SendMsg((CFE_SB_Msg_t *) &CFE_ES_PerfStreamStatus.Packet);
+                CFE_ES_PerfStreamStatus.PacketCount++;
+            }
+        }
+    }
+
+}/* end CFE_ES_PerfStreamDrain */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/* Name: CFE_ES_PerfLatencyReport                                                */
+/*                                                                               */
+/* Purpose: Fill in the latency of each latency slot for housekeeping.           */
+/*                                                                               */
+/* Assumptions and Notes:                                                        */
+/*                                                                               */
+/*  The 99th percentile is the top of the histogram bucket it falls in, capped   */
+/*  at the longest latency.  Called from the ES main task while the streaming    */
+/*  child task may be adding to the measurements, so a report can be a sample    */
+/*  or so behind in places.                                                      */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void CFE_ES_PerfLatencyReport(CFE_ES_PerfLatency_t *Report)
+{
+    CFE_ES_PerfLatencySlot_t   *Slot;
+    uint32                      Count;
+    uint32                      Target;
+    uint32                      Seen;
+    uint32                      Bucket;
+    uint32                      i;
+
+    for (i=0; i < CFE_ES_PERF_LATENCY_SLOTS; i++) {
+
+        Slot = &CFE_ES_PerfStreamStatus.Latency[i];
+        Count = Slot->Count;
+
+        Report[i].Marker = Slot->Marker;
+
+        if ((Slot->Marker == CFE_ES_PERF_NO_MARKER) || (Slot->Measured != Slot->Marker) || (Count == 0)) {
+            Report[i].Count = 0;
+            Report[i].MinTime = 0;
+            Report[i].MaxTime = 0;
+            Report[i].MeanTime = 0;
+            Report[i].P99Time = 0;
+            continue;
+        }
+
+        Report[i].Count = Count;
+        Report[i].MinTime = Slot->MinTime;
+        Report[i].MaxTime = Slot->MaxTime;
+        Report[i].MeanTime = (uint32)(Slot->TotalTime / Count);
+
+        Target = (uint32)((((uint64)Count * 99) + 99) / 100);
+        Seen = 0;
+        for (Bucket=0; Bucket < (CFE_ES_PERF_LATENCY_BUCKETS - 1); Bucket++) {
+            Seen += Slot->Histogram[Bucket];
+            if (Seen >= Target) {
+                break;
+            }
+        }
+
+        Report[i].P99Time = CFE_ES_PerfLatencyBucketTop(Bucket);
+        if ((Bucket == (CFE_ES_PERF_LATENCY_BUCKETS - 1)) || (Report[i].P99Time > Slot->MaxTime)) {
+            Report[i].P99Time = Slot->MaxTime;
+        }
+    }
+
+}/* end CFE_ES_PerfLatencyReport */
+
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                               */
 /* CFE_ES_PerfSetFilterMaskCmd() --                                              */
@@ -455,6 +1043,84 @@ void CFE_ES_PerfSetTriggerMaskCmd(CFE_SB_MsgPtr_t msg){
     }
 } /* End of CFE_ES_PerfSetTriggerMaskCmd() */
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                               */
+/* CFE_ES_PerfSetLatMarkerCmd() --                                               */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+void CFE_ES_PerfSetLatMarkerCmd(CFE_SB_MsgPtr_t msg){
+
+   uint16 ExpectedLength = sizeof(CFE_ES_PerfSetLatMarkerCmd_t);
+   CFE_ES_PerfSetLatMarkerCmd_Payload_t *cmd = (CFE_ES_PerfSetLatMarkerCmd_Payload_t *) &msg->Byte[CFE_SB_CMD_HDR_SIZE];
+
+   /*
+    ** Verify command packet length.
+    */
+    if (CFE_ES_VerifyCmdLength(msg, ExpectedLength))
+    {
+
+       if((cmd->LatencySlot < CFE_ES_PERF_LATENCY_SLOTS) &&
+          ((cmd->Marker < CFE_ES_PERF_MAX_IDS) || (cmd->Marker == CFE_ES_PERF_NO_MARKER))){
+
+            /* the streaming child task starts the measurements over */
+            CFE_ES_PerfStreamStatus.Latency[cmd->LatencySlot].Marker = cmd->Marker;
+            CFE_ES_PerfStreamStatus.Latency[cmd->LatencySlot].Measured = CFE_ES_PERF_NO_MARKER;
+
+            CFE_EVS_SendEvent(CFE_ES_PERF_LATMRKCMD_EID, CFE_EVS_DEBUG,
+                      "Set Performance Latency Marker Cmd rcvd, slot %d, marker %u",
+                   (int)cmd->LatencySlot,(unsigned int)cmd->Marker);
+
+            CFE_ES_TaskData.CmdCounter++;
+
+       }else{
+           CFE_EVS_SendEvent(CFE_ES_PERF_LATMRKERR_EID, CFE_EVS_ERROR,
+                      "Performance Latency Marker Cmd Error,Slot(%d) or marker(%u) out of range(%d,%d)",
+                   (int)cmd->LatencySlot,(unsigned int)cmd->Marker,
+                   (int)CFE_ES_PERF_LATENCY_SLOTS,(int)CFE_ES_PERF_MAX_IDS);
+
+            CFE_ES_TaskData.ErrCounter++;
+       }
+    }
+} /* End of CFE_ES_PerfSetLatMarkerCmd() */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/* Name: CFE_ES_PerfClaimRing                                                    */
+/*                                                                               */
+/* Purpose: Take a ring to add an entry to, starting with the one for the        */
+/*          calling task.                                                        */
+/*                                                                               */
+/* Assumptions and Notes:                                                        */
+/*                                                                               */
+/*  A ring another task is adding to is skipped rather than waited for, so a     */
+/*  task preempted while holding its ring never holds up another.  Returns NULL  */
+/*  if every ring is busy.                                                       */
+/*                                                                               */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+static CFE_ES_PerfRing_t *CFE_ES_PerfClaimRing(void)
+{
+    CFE_ES_PerfRing_t  *Ring;
+    uint32              Slot;
+    uint32              Free;
+    uint32              i;
+
+    OS_ConvertToArrayIndex(OS_TaskGetId(), &Slot);
+
+    for (i=0; i < CFE_ES_PERF_DATA_RINGS; i++) {
+
+        Ring = &Perf->Ring[(Slot + i) % CFE_ES_PERF_DATA_RINGS];
+        Free = 0;
+
+        if (__atomic_compare_exchange_n(&Ring->Owner, &Free, 1, FALSE,
+                                        __ATOMIC_SEQ_CST, __ATOMIC_RELAXED)) {
+            return Ring;
+        }
+    }
+
+    return NULL;
+
+}/* end CFE_ES_PerfClaimRing */
+
 
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /* Name: CFE_ES_PerfLogAdd                                                       */
@@ -463,11 +1129,16 @@ void CFE_ES_PerfSetTriggerMaskCmd(CFE_SB_MsgPtr_t msg){
 /*                                                                               */
 /* Assumptions and Notes:                                                        */
 /*                                                                               */
-/*  This function implements a circular buffer using an array.                   */
-/*      DataStart points to first stored entry                                   */
-/*      DataEnd points to next available entry                                   */
-/*      if DataStart == DataEnd then the buffer is either empty or full          */
-/*      depending on the value of the DataCount                                  */
+/*  The data buffer is split into CFE_ES_PERF_DATA_RINGS circular buffers, see   */
+/*  CFE_ES_PerfRing_t.  The entry goes in the ring taken by                      */
+/*  CFE_ES_PerfClaimRing, overwriting the oldest entry of that ring once it is   */
+/*  full.  No lock is taken, and tasks on different rings share no data that     */
+/*  changes per entry.                                                           */
+/*                                                                               */
+/*  The trigger modes are kept per ring.  Collection stops once one ring holds   */
+/*  a full ring (START) or half a ring (CENTER) of entries added after the       */
+/*  trigger, or at the trigger (END).  So in START mode no ring overwrites an    */
+/*  entry from after the trigger.  In STREAM mode collection does not stop.      */
 /*                                                                               */
 /*  Time is stored as 2 32 bit integers, (TimerLower32, TimerUpper32):           */
 /*      TimerLower32 is the curent value of the hardware timer register.         */
@@ -476,12 +1147,16 @@ void CFE_ES_PerfSetTriggerMaskCmd(CFE_SB_MsgPtr_t msg){
 /*  Time is stored as a absolute time instead of a relative time between log     */
 /*  entries. This will yield better accuracy since storing relative time between */
 /*  entries will accumulate (rounding/sampling) errors over time.  It also is    */
-/*  faster since the time does not need to be calculated.                        */
+/*  faster since the time does not need to be calculated.  It is also what       */
+/*  CFE_ES_PerfLogDump merges the rings on.                                      */
 /*                                                                               */
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 void CFE_ES_PerfLogAdd(uint32 Marker, uint32 EntryExit)
 {
-    int32         IntFlags;
+    CFE_ES_PerfRing_t      *Ring;
+    CFE_ES_PerfDataEntry_t *Entry;
+    uint32                  State;
+    uint32                  Generation;
 
     if (Perf->MetaData.State != CFE_ES_PERF_IDLE) {
 
@@ -503,59 +1178,79 @@ void CFE_ES_PerfLogAdd(uint32 Marker, uint32 EntryExit)
         /* is this id filtered */
         if (CFE_ES_TEST_LONG_MASK(Perf->MetaData.FilterMask, Marker)) {
 
-           /* disable interrupts to guarentee exclusive access to the data structures */
-            IntFlags = OS_IntLock();
-
-            Perf->DataBuffer[Perf->MetaData.DataEnd].Data = (Marker | (EntryExit << CFE_ES_PERF_EXIT_BIT));
-            CFE_PSP_Get_Timebase((uint32*)&Perf->DataBuffer[Perf->MetaData.DataEnd].TimerUpper32,(uint32*)&Perf->DataBuffer[Perf->MetaData.DataEnd].TimerLower32);
-
-            Perf->MetaData.DataEnd++;
-            if (Perf->MetaData.DataEnd >= CFE_ES_PERF_DATA_BUFFER_SIZE) {
-                Perf->MetaData.DataEnd = 0;
+            Ring = CFE_ES_PerfClaimRing();
+            if (Ring == NULL) {
+                __atomic_add_fetch(&Perf->LostCount, 1, __ATOMIC_RELAXED);
+                return;
             }
 
-            /* we have filled up the buffer */
-            Perf->MetaData.DataCount++;
-            if (Perf->MetaData.DataCount > CFE_ES_PERF_DATA_BUFFER_SIZE) {
-
-                Perf->MetaData.DataCount = CFE_ES_PERF_DATA_BUFFER_SIZE;
-
-                /* after the buffer fills up start and end point to the same entry since we
-                   are now overwriting old data */
-                Perf->MetaData.DataStart = Perf->MetaData.DataEnd;
-            }
+            /*
+            ** Check the state again now the ring is held, once CFE_ES_PerfLogDump
+            ** sees the ring free no entry goes in after collection stopped
+            */
+            State = __atomic_load_n(&Perf->MetaData.State, __ATOMIC_SEQ_CST);
 
             /* waiting for trigger */
-            if (Perf->MetaData.State == CFE_ES_PERF_WAITING_FOR_TRIGGER) {
+            if (State == CFE_ES_PERF_WAITING_FOR_TRIGGER) {
 
                 if (CFE_ES_TEST_LONG_MASK(Perf->MetaData.TriggerMask, Marker)) {
-                    Perf->MetaData.State = CFE_ES_PERF_TRIGGERED;
+                    __atomic_compare_exchange_n(&Perf->MetaData.State, &State, CFE_ES_PERF_TRIGGERED, FALSE,
+                                                __ATOMIC_SEQ_CST, __ATOMIC_SEQ_CST);
+                    State = __atomic_load_n(&Perf->MetaData.State, __ATOMIC_SEQ_CST);
                 }
             }
-            /* triggered */
-            if (Perf->MetaData.State == CFE_ES_PERF_TRIGGERED) {
 
-                Perf->MetaData.TriggerCount++;
-                if (Perf->MetaData.Mode == CFE_ES_PERF_TRIGGER_START) {
+            if (State != CFE_ES_PERF_IDLE) {
 
-                    if (Perf->MetaData.TriggerCount >= CFE_ES_PERF_DATA_BUFFER_SIZE) {
-                        Perf->MetaData.State = CFE_ES_PERF_IDLE;
-                    }
+                /* the first entry of a new collection empties the ring */
+                Generation = __atomic_load_n(&Perf->Generation, __ATOMIC_ACQUIRE);
+                if (Ring->Generation != Generation) {
+                    Ring->Next = 0;
+                    Ring->Count = 0;
+                    Ring->TriggerCount = 0;
+                    Ring->Added = 0;
+                    __atomic_store_n(&Ring->Generation, Generation, __ATOMIC_RELEASE);
                 }
-                else if (Perf->MetaData.Mode == CFE_ES_PERF_TRIGGER_CENTER) {
 
-                    if (Perf->MetaData.TriggerCount >= CFE_ES_PERF_DATA_BUFFER_SIZE / 2) {
-                        Perf->MetaData.State = CFE_ES_PERF_IDLE;
-                    }
+                Entry = &Perf->DataBuffer[((Ring - Perf->Ring) * CFE_ES_PERF_RING_SIZE) + Ring->Next];
+                Entry->Data = (Marker | (EntryExit << CFE_ES_PERF_EXIT_BIT));
+                CFE_PSP_Get_Timebase((uint32*)&Entry->TimerUpper32,(uint32*)&Entry->TimerLower32);
+
+                Ring->Next++;
+                if (Ring->Next >= CFE_ES_PERF_RING_SIZE) {
+                    Ring->Next = 0;
                 }
-                else if (Perf->MetaData.Mode == CFE_ES_PERF_TRIGGER_END) {
+                if (Ring->Count < CFE_ES_PERF_RING_SIZE) {
+                    Ring->Count++;
+                }
+
+                /* the entry is complete for CFE_ES_PerfStreamDrain */
+                __atomic_store_n(&Ring->Added, Ring->Added + 1, __ATOMIC_RELEASE);
+
+                /* triggered */
+                if (State == CFE_ES_PERF_TRIGGERED) {
 
-                    Perf->MetaData.State = CFE_ES_PERF_IDLE;
+                    Ring->TriggerCount++;
+                    if (Perf->MetaData.Mode == CFE_ES_PERF_TRIGGER_START) {
+
+                        if (Ring->TriggerCount >= CFE_ES_PERF_RING_SIZE) {
+                            __atomic_store_n(&Perf->MetaData.State, CFE_ES_PERF_IDLE, __ATOMIC_SEQ_CST);
+                        }
+                    }
+                    else if (Perf->MetaData.Mode == CFE_ES_PERF_TRIGGER_CENTER) {
+
+                        if (Ring->TriggerCount >= CFE_ES_PERF_RING_SIZE / 2) {
+                            __atomic_store_n(&Perf->MetaData.State, CFE_ES_PERF_IDLE, __ATOMIC_SEQ_CST);
+                        }
+                    }
+                    else if (Perf->MetaData.Mode == CFE_ES_PERF_TRIGGER_END) {
+
+                        __atomic_store_n(&Perf->MetaData.State, CFE_ES_PERF_IDLE, __ATOMIC_SEQ_CST);
+                    }
                 }
             }
 
-            /* enable interrupts */
-            OS_IntUnlock(IntFlags);
+            __atomic_store_n(&Ring->Owner, 0, __ATOMIC_RELEASE);
         }
     }
 }/* end CFE_ES_PerfLogAdd */
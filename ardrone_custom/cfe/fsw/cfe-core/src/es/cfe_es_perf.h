@@ -77,6 +77,13 @@
 #define CFE_ES_PERF_CHILD_NAME           "ES_PerfFileWriter"
 #define CFE_ES_PERF_CHILD_STACK_PTR      0
 #define CFE_ES_PERF_CHILD_FLAGS          0
+#define CFE_ES_PERF_STREAM_CHILD_NAME    "ES_PerfStreamer"
+
+/*
+** Latency histogram buckets, 4 to each power of 2 of microseconds.  The last
+** bucket also holds everything longer, from 114688 us on.
+*/
+#define CFE_ES_PERF_LATENCY_BUCKETS      64
 
 
 enum CFE_ES_PerfState_t {
@@ -90,6 +97,7 @@ enum CFE_ES_PerfMode_t {
     CFE_ES_PERF_TRIGGER_START = 0,
     CFE_ES_PERF_TRIGGER_CENTER,
     CFE_ES_PERF_TRIGGER_END,
+    CFE_ES_PERF_STREAM,
     CFE_ES_PERF_MAX_MODES
 };
 
@@ -98,9 +106,43 @@ typedef struct {
     uint32                         ChildID;
     char                           DataFileName[OS_MAX_PATH_LEN];
     int32                          DataFileDescriptor;
+    uint32                         RingPos[CFE_ES_PERF_DATA_RINGS];   /* next entry of each ring to write */
+    uint32                         RingLeft[CFE_ES_PERF_DATA_RINGS];  /* entries of each ring left to write */
 } CFE_ES_PerfLogDump_t;
 
 extern CFE_ES_PerfLogDump_t    CFE_ES_PerfLogDumpStatus;
 
+/*
+** Marker is set by command, the rest belongs to the streaming child task,
+** which starts the measurements over whenever Measured differs from Marker.
+*/
+typedef struct {
+    uint32                         Marker;
+    uint32                         Measured;      /* marker the measurements are of */
+    boolean                        Open;          /* an entry waits for its exit */
+    uint32                         OpenUpper32;   /* time of that entry */
+    uint32                         OpenLower32;
+    uint32                         Count;
+    uint32                         MinTime;       /* microseconds */
+    uint32                         MaxTime;
+    uint64                         TotalTime;
+    uint32                         Histogram[CFE_ES_PERF_LATENCY_BUCKETS];
+} CFE_ES_PerfLatencySlot_t;
+
+typedef struct {
+    uint32                         Running;       /* nonzero while the streaming child task runs */
+    uint32                         ChildID;
+    uint32                         Generation;    /* collection being streamed */
+    uint32                         Sent[CFE_ES_PERF_DATA_RINGS];     /* entries of each ring sent or lost */
+    uint32                         SentPos[CFE_ES_PERF_DATA_RINGS];  /* where the next of them is in the ring */
+    uint32                         Lost[CFE_ES_PERF_DATA_RINGS];     /* entries overwritten before being sent */
+    uint32                         LostCount;
+    uint32                         PacketCount;
+    CFE_ES_PerfLatencySlot_t       Latency[CFE_ES_PERF_LATENCY_SLOTS];
+    CFE_ES_PerfStreamPacket_t      Packet;
+} CFE_ES_PerfStream_t;
+
+extern CFE_ES_PerfStream_t     CFE_ES_PerfStreamStatus;
+
 #endif /* _cfe_es_perf_ */
 
@@ -362,6 +362,12 @@ int32 CFE_ES_TaskInit(void)
     CFE_SB_InitMsg(&CFE_ES_TaskData.MemStatsPacket, CFE_ES_MEMSTATS_TLM_MID, 
                    sizeof(CFE_ES_PoolStatsTlm_t), TRUE);
 
+    /*
+    ** Initialize performance data stream packet
+    */
+    CFE_SB_InitMsg(&CFE_ES_PerfStreamStatus.Packet, CFE_ES_PERF_STREAM_TLM_MID,
+                   sizeof(CFE_ES_PerfStreamPacket_t), TRUE);
+
     /*
     ** Create Software Bus message pipe
     */
@@ -588,6 +594,10 @@ void CFE_ES_TaskPipe(CFE_SB_MsgPtr_t Msg)
                     CFE_ES_PerfSetTriggerMaskCmd(Msg);
                     break;
 
+                case CFE_ES_PERF_SETLATMARKER_CC:
+                    CFE_ES_PerfSetLatMarkerCmd(Msg);
+                    break;
+
                 case CFE_ES_RESET_PR_COUNT_CC:
                     CFE_ES_ResetPRCountCmd(Msg);
                     break;
@@ -666,6 +676,7 @@ void CFE_ES_HousekeepingCmd(CFE_SB_MsgPtr_t Msg)
     CFE_ES_TaskData.HkPacket.Payload.MaxProcessorResets = CFE_ES_ResetDataPtr->ResetVars.MaxProcessorResetCount;
     CFE_ES_TaskData.HkPacket.Payload.BootSource = CFE_ES_ResetDataPtr->ResetVars.BootSource;
 
+    CFE_ES_PerfLogTally();
     CFE_ES_TaskData.HkPacket.Payload.PerfState = CFE_ES_ResetDataPtr->Perf.MetaData.State;
     CFE_ES_TaskData.HkPacket.Payload.PerfMode = CFE_ES_ResetDataPtr->Perf.MetaData.Mode;
     CFE_ES_TaskData.HkPacket.Payload.PerfTriggerCount = CFE_ES_ResetDataPtr->Perf.MetaData.TriggerCount;
@@ -673,6 +684,9 @@ void CFE_ES_HousekeepingCmd(CFE_SB_MsgPtr_t Msg)
     CFE_ES_TaskData.HkPacket.Payload.PerfDataEnd = CFE_ES_ResetDataPtr->Perf.MetaData.DataEnd;
     CFE_ES_TaskData.HkPacket.Payload.PerfDataCount = CFE_ES_ResetDataPtr->Perf.MetaData.DataCount;
     CFE_ES_TaskData.HkPacket.Payload.PerfDataToWrite = CFE_ES_PerfLogDumpStatus.DataToWrite;
+    CFE_ES_TaskData.HkPacket.Payload.PerfStreamPackets = CFE_ES_PerfStreamStatus.PacketCount;
+    CFE_ES_TaskData.HkPacket.Payload.PerfStreamLost = CFE_ES_PerfStreamStatus.LostCount;
+    CFE_ES_PerfLatencyReport(CFE_ES_TaskData.HkPacket.Payload.PerfLatency);
 
     /*
      * Fill out the perf trigger/filter mask objects
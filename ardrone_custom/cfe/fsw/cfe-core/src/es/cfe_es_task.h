@@ -189,6 +189,7 @@ void CFE_ES_PerfStartDataCmd(CFE_SB_MsgPtr_t Msg);
 void CFE_ES_PerfStopDataCmd(CFE_SB_MsgPtr_t Msg);
 void CFE_ES_PerfSetFilterMaskCmd(CFE_SB_MsgPtr_t Msg);
 void CFE_ES_PerfSetTriggerMaskCmd(CFE_SB_MsgPtr_t Msg);
+void CFE_ES_PerfSetLatMarkerCmd(CFE_SB_MsgPtr_t Msg);
 void CFE_ES_TlmPoolStatsCmd(CFE_SB_MsgPtr_t Msg);
 void CFE_ES_DumpCDSRegCmd( const CFE_SB_Msg_t *MessagePtr );
 boolean CFE_ES_ValidateHandle(CFE_ES_MemHandle_t  Handle);
@@ -212,6 +212,36 @@
     #error CFE_ES_PERF_DATA_BUFFER_SIZE cannot be greater than 1048576 entries!
 #endif
 
+/* 
+** Performance data rings
+*/
+#if CFE_ES_PERF_DATA_RINGS  <  1
+    #error CFE_ES_PERF_DATA_RINGS cannot be less than 1!
+#elif CFE_ES_PERF_DATA_RINGS  >  64
+    #error CFE_ES_PERF_DATA_RINGS cannot be greater than 64!
+#endif
+
+#if CFE_ES_PERF_STREAM_MS_DELAY  <  1
+    #error CFE_ES_PERF_STREAM_MS_DELAY cannot be less than 1!
+#elif CFE_ES_PERF_STREAM_MS_DELAY  >  10000
+    #error CFE_ES_PERF_STREAM_MS_DELAY cannot be greater than 10000!
+#endif
+
+/*
+** The stream packet has 12 bytes per entry after at most 40 of headers and counts
+*/
+#if CFE_ES_PERF_STREAM_PKT_ENTRIES  <  1
+    #error CFE_ES_PERF_STREAM_PKT_ENTRIES cannot be less than 1!
+#elif ((CFE_ES_PERF_STREAM_PKT_ENTRIES * 12) + 40)  >  CFE_SB_MAX_SB_MSG_SIZE
+    #error CFE_ES_PERF_STREAM_PKT_ENTRIES is too many entries for CFE_SB_MAX_SB_MSG_SIZE!
+#endif
+
+#if CFE_ES_PERF_LATENCY_SLOTS  <  1
+    #error CFE_ES_PERF_LATENCY_SLOTS cannot be less than 1!
+#elif CFE_ES_PERF_LATENCY_SLOTS  >  16
+    #error CFE_ES_PERF_LATENCY_SLOTS cannot be greater than 16!
+#endif
+
 /* 
 ** Maximum number of Registered CDS blocks
 */
@@ -109,6 +109,9 @@ int32 CFE_EVS_Register (void *Filters, uint16 NumEventFilters, uint16 FilterSche
       if (CFE_EVS_GlobalData.AppData[AppID].RegisterFlag == TRUE)
       {
          CFE_PSP_MemSet(&CFE_EVS_GlobalData.AppData[AppID], 0, sizeof(EVS_AppData_t));
+
+         /* Its format strings may not outlive the app */
+         EVS_RemoveSpecs(AppID);
       }
 
       /* Verify filter arguments */
@@ -159,6 +162,9 @@ int32 CFE_EVS_Register (void *Filters, uint16 NumEventFilters, uint16 FilterSche
             AppDataPtr->BinFilters[i].Mask    = 0;
             AppDataPtr->BinFilters[i].Count   = 0;
          }
+
+         /* Index the filters by event ID for EVS_IsFiltered */
+         EVS_IndexFilters(AppDataPtr);
       }
    }
 
@@ -191,6 +197,9 @@ int32 CFE_EVS_Unregister(void)
       if (CFE_EVS_GlobalData.AppData[AppID].RegisterFlag == TRUE)
       {
          CFE_PSP_MemSet(&CFE_EVS_GlobalData.AppData[AppID], 0, sizeof(EVS_AppData_t));
+
+         /* Its format strings may not outlive the app */
+         EVS_RemoveSpecs(AppID);
       }
    }
 
@@ -216,6 +225,7 @@ int32 CFE_EVS_SendEvent (uint16 EventID, uint16 EventType, const char *Spec, ...
    int32              Status = CFE_SUCCESS;
    uint32             AppID = CFE_EVS_UNDEF_APPID;
    CFE_TIME_SysTime_t Time;
+   uint32             SpecHash;
    va_list            Ptr;
 
    /* Query and verify the caller's AppID */
@@ -230,30 +240,41 @@ int32 CFE_EVS_SendEvent (uint16 EventID, uint16 EventType, const char *Spec, ...
       }
       else if (EVS_IsFiltered(AppID, EventID, EventType) == FALSE)
       {
-         /* Initialize EVS event packet */
-         CFE_SB_InitMsg(&EVS_Packet, CFE_EVS_EVENT_MSG_MID, sizeof(CFE_EVS_Packet_t), TRUE);
-         EVS_Packet.Payload.PacketID.EventID   = EventID;
-         EVS_Packet.Payload.PacketID.EventType = EventType;
-
-         /* vsnprintf() returns the total expanded length of the formatted string */
-         /* vsnprintf() copies and zero terminates portion that fits in the buffer */
-         va_start(Ptr, Spec);
-         ExpandedLength = vsnprintf((char *)EVS_Packet.Payload.Message, sizeof(EVS_Packet.Payload.Message), Spec, Ptr);
-         va_end(Ptr);
-
-         /* Were any characters truncated in the buffer? */
-         if (ExpandedLength >= sizeof(EVS_Packet.Payload.Message))
+         if ((CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageFormatMode == CFE_EVS_DEFERRED_FORMAT) &&
+             (EVS_DeferSpec(AppID, Spec, &SpecHash) == TRUE))
          {
-            /* Mark character before zero terminator to indicate truncation */
-            EVS_Packet.Payload.Message[sizeof(EVS_Packet.Payload.Message) - 2] = CFE_EVS_MSG_TRUNCATED;
-            CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageTruncCounter++;
+            /* Pack the arguments, formatting is left to whoever needs the text */
+            va_start(Ptr, Spec);
+            EVS_SendDeferredPacket(AppID, CFE_TIME_GetTime(), EventID, EventType, SpecHash, Spec, Ptr);
+            va_end(Ptr);
          }
+         else
+         {
+            /* Initialize EVS event packet */
+            CFE_SB_InitMsg(&EVS_Packet, CFE_EVS_EVENT_MSG_MID, sizeof(CFE_EVS_Packet_t), TRUE);
+            EVS_Packet.Payload.PacketID.EventID   = EventID;
+            EVS_Packet.Payload.PacketID.EventType = EventType;
+
+            /* vsnprintf() returns the total expanded length of the formatted string */
+            /* vsnprintf() copies and zero terminates portion that fits in the buffer */
+            va_start(Ptr, Spec);
+            ExpandedLength = vsnprintf((char *)EVS_Packet.Payload.Message, sizeof(EVS_Packet.Payload.Message), Spec, Ptr);
+            va_end(Ptr);
+
+            /* Were any characters truncated in the buffer? */
+            if (ExpandedLength >= sizeof(EVS_Packet.Payload.Message))
+            {
+               /* Mark character before zero terminator to indicate truncation */
+               EVS_Packet.Payload.Message[sizeof(EVS_Packet.Payload.Message) - 2] = CFE_EVS_MSG_TRUNCATED;
+               CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageTruncCounter++;
+            }
 
-         /* Get current spacecraft time */
-         Time = CFE_TIME_GetTime();
+            /* Get current spacecraft time */
+            Time = CFE_TIME_GetTime();
 
-         /* Send the event packet */
-         EVS_SendPacket(AppID, Time, &EVS_Packet);
+            /* Send the event packet */
+            EVS_SendPacket(AppID, Time, &EVS_Packet);
+         }
       }
    }
 
@@ -279,6 +300,7 @@ int32 CFE_EVS_SendEventWithAppID (uint16 EventID, uint16 EventType, uint32 AppID
    int32              ExpandedLength;
    int32              Status = CFE_SUCCESS;
    CFE_TIME_SysTime_t Time;
+   uint32             SpecHash;
    va_list            Ptr;
 
    if (AppID >= CFE_ES_MAX_APPLICATIONS)
@@ -292,30 +314,41 @@ int32 CFE_EVS_SendEventWithAppID (uint16 EventID, uint16 EventType, uint32 AppID
    }
    else if (EVS_IsFiltered(AppID, EventID, EventType) == FALSE)
    {
-      /* Initialize EVS event packet */
-      CFE_SB_InitMsg(&EVS_Packet, CFE_EVS_EVENT_MSG_MID, sizeof(CFE_EVS_Packet_t), TRUE);
-      EVS_Packet.Payload.PacketID.EventID   = EventID;
-      EVS_Packet.Payload.PacketID.EventType = EventType;
-
-      /* vsnprintf() returns the total expanded length of the formatted string */
-      /* vsnprintf() copies and zero terminates portion that fits in the buffer */
-      va_start(Ptr, Spec);
-      ExpandedLength = vsnprintf((char *)EVS_Packet.Payload.Message, sizeof(EVS_Packet.Payload.Message), Spec, Ptr);
-      va_end(Ptr);
-
-      /* Were any characters truncated in the buffer? */
-      if (ExpandedLength >= sizeof(EVS_Packet.Payload.Message))
+      if ((CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageFormatMode == CFE_EVS_DEFERRED_FORMAT) &&
+          (EVS_DeferSpec(AppID, Spec, &SpecHash) == TRUE))
       {
-         /* Mark character before zero terminator to indicate truncation */
-         EVS_Packet.Payload.Message[sizeof(EVS_Packet.Payload.Message) - 2] = CFE_EVS_MSG_TRUNCATED;
-         CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageTruncCounter++;
+         /* Pack the arguments, formatting is left to whoever needs the text */
+         va_start(Ptr, Spec);
+         EVS_SendDeferredPacket(AppID, CFE_TIME_GetTime(), EventID, EventType, SpecHash, Spec, Ptr);
+         va_end(Ptr);
       }
+      else
+      {
+         /* Initialize EVS event packet */
+         CFE_SB_InitMsg(&EVS_Packet, CFE_EVS_EVENT_MSG_MID, sizeof(CFE_EVS_Packet_t), TRUE);
+         EVS_Packet.Payload.PacketID.EventID   = EventID;
+         EVS_Packet.Payload.PacketID.EventType = EventType;
+
+         /* vsnprintf() returns the total expanded length of the formatted string */
+         /* vsnprintf() copies and zero terminates portion that fits in the buffer */
+         va_start(Ptr, Spec);
+         ExpandedLength = vsnprintf((char *)EVS_Packet.Payload.Message, sizeof(EVS_Packet.Payload.Message), Spec, Ptr);
+         va_end(Ptr);
+
+         /* Were any characters truncated in the buffer? */
+         if (ExpandedLength >= sizeof(EVS_Packet.Payload.Message))
+         {
+            /* Mark character before zero terminator to indicate truncation */
+            EVS_Packet.Payload.Message[sizeof(EVS_Packet.Payload.Message) - 2] = CFE_EVS_MSG_TRUNCATED;
+            CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageTruncCounter++;
+         }
 
-      /* Get current spacecraft time */
-      Time = CFE_TIME_GetTime();
+         /* Get current spacecraft time */
+         Time = CFE_TIME_GetTime();
 
-      /* Send the event packet */
-      EVS_SendPacket(AppID, Time, &EVS_Packet);
+         /* Send the event packet */
+         EVS_SendPacket(AppID, Time, &EVS_Packet);
+      }
    }
 
    return Status;
@@ -339,6 +372,7 @@ int32 CFE_EVS_SendTimedEvent (CFE_TIME_SysTime_t Time, uint16 EventID, uint16 Ev
    int32              ExpandedLength;
    int32              Status = CFE_SUCCESS;
    uint32             AppID = CFE_EVS_UNDEF_APPID;
+   uint32             SpecHash;
    va_list            Ptr;
 
    /* Query and verify the caller's AppID */
@@ -353,27 +387,38 @@ int32 CFE_EVS_SendTimedEvent (CFE_TIME_SysTime_t Time, uint16 EventID, uint16 Ev
       }
       else if (EVS_IsFiltered(AppID, EventID, EventType) == FALSE)
       {
-         /* Initialize EVS event packet */
-         CFE_SB_InitMsg(&EVS_Packet, CFE_EVS_EVENT_MSG_MID, sizeof(CFE_EVS_Packet_t), TRUE);
-         EVS_Packet.Payload.PacketID.EventID   = EventID;
-         EVS_Packet.Payload.PacketID.EventType = EventType;
-
-         /* vsnprintf() returns the total expanded length of the formatted string */
-         /* vsnprintf() copies and zero terminates portion that fits in the buffer */
-         va_start(Ptr, Spec);
-         ExpandedLength = vsnprintf((char *)EVS_Packet.Payload.Message, sizeof(EVS_Packet.Payload.Message), Spec, Ptr);
-         va_end(Ptr);
-
-         /* Were any characters truncated in the buffer? */
-         if (ExpandedLength >= sizeof(EVS_Packet.Payload.Message))
+         if ((CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageFormatMode == CFE_EVS_DEFERRED_FORMAT) &&
+             (EVS_DeferSpec(AppID, Spec, &SpecHash) == TRUE))
          {
-            /* Mark character before zero terminator to indicate truncation */
-            EVS_Packet.Payload.Message[sizeof(EVS_Packet.Payload.Message) - 2] = CFE_EVS_MSG_TRUNCATED;
-            CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageTruncCounter++;
+            /* Pack the arguments, formatting is left to whoever needs the text */
+            va_start(Ptr, Spec);
+            EVS_SendDeferredPacket(AppID, Time, EventID, EventType, SpecHash, Spec, Ptr);
+            va_end(Ptr);
          }
+         else
+         {
+            /* Initialize EVS event packet */
+            CFE_SB_InitMsg(&EVS_Packet, CFE_EVS_EVENT_MSG_MID, sizeof(CFE_EVS_Packet_t), TRUE);
+            EVS_Packet.Payload.PacketID.EventID   = EventID;
+            EVS_Packet.Payload.PacketID.EventType = EventType;
+
+            /* vsnprintf() returns the total expanded length of the formatted string */
+            /* vsnprintf() copies and zero terminates portion that fits in the buffer */
+            va_start(Ptr, Spec);
+            ExpandedLength = vsnprintf((char *)EVS_Packet.Payload.Message, sizeof(EVS_Packet.Payload.Message), Spec, Ptr);
+            va_end(Ptr);
+
+            /* Were any characters truncated in the buffer? */
+            if (ExpandedLength >= sizeof(EVS_Packet.Payload.Message))
+            {
+               /* Mark character before zero terminator to indicate truncation */
+               EVS_Packet.Payload.Message[sizeof(EVS_Packet.Payload.Message) - 2] = CFE_EVS_MSG_TRUNCATED;
+               CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageTruncCounter++;
+            }
 
-         /* Send the event packet */
-         EVS_SendPacket(AppID, Time, &EVS_Packet);
+            /* Send the event packet */
+            EVS_SendPacket(AppID, Time, &EVS_Packet);
+         }
       }
    }
 
@@ -88,6 +88,68 @@
 #include <string.h>
 
 
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_LogStatus
+**
+** Purpose:  This routine sets the event log next entry, count and full flag
+**           from the event log tickets.
+**
+** Assumptions and Notes:
+**  Senders adding entries at the same time may leave the values of an
+**  entry or two ago until the next entry is added.
+*/
+static void EVS_LogStatus (CFE_EVS_Log_t *LogPtr)
+{
+   uint32 Ticket = __atomic_load_n(&LogPtr->Ticket, __ATOMIC_RELAXED);
+   uint32 Count = (Ticket - LogPtr->FirstTicket) >> 1;
+
+   if (Count >= CFE_EVS_LOG_MAX)
+   {
+      LogPtr->LogCount = CFE_EVS_LOG_MAX;
+      LogPtr->LogFullFlag = TRUE;
+   }
+   else
+   {
+      LogPtr->LogCount = (uint16) Count;
+      LogPtr->LogFullFlag = FALSE;
+   }
+
+   LogPtr->Next = (uint16) ((Ticket >> 1) % CFE_EVS_LOG_MAX);
+
+} /* End EVS_LogStatus */
+
+
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_ReadLogEntry
+**
+** Purpose:  This routine copies the event log entry added with the given
+**           ticket.
+**
+** Assumptions and Notes:
+**  Returns FALSE if the entry has not been added yet, or has been added
+**  again since, while it was copied.
+*/
+static boolean EVS_ReadLogEntry (CFE_EVS_Log_t *LogPtr, uint32 Ticket, CFE_EVS_Packet_t *EntryPtr)
+{
+   uint32 Entry = (Ticket >> 1) % CFE_EVS_LOG_MAX;
+
+   if (__atomic_load_n(&LogPtr->EntryTicket[Entry], __ATOMIC_ACQUIRE) != (Ticket + 2))
+   {
+      return FALSE;
+   }
+
+   CFE_PSP_MemCpy(EntryPtr, &LogPtr->LogEntry[Entry], sizeof(CFE_EVS_Packet_t));
+
+   __atomic_thread_fence(__ATOMIC_ACQUIRE);
+   return (__atomic_load_n(&LogPtr->EntryTicket[Entry], __ATOMIC_RELAXED) == (Ticket + 2));
+
+} /* End EVS_ReadLogEntry */
+
+
 /*
 **             Function Prologue
 **
@@ -96,56 +158,74 @@
 ** Purpose:  This routine adds an event packet to the internal event log.
 **
 ** Assumptions and Notes:
+**  Deferred event packets are the size of an event packet and are added
+**  as they are.
 **
+**  Any number of tasks may add entries at once, without a lock.  Each
+**  takes the next ticket, in discard mode only while the log has room,
+**  claims the ticket's entry, copies the event in and marks the entry
+**  added.  The entry is the ticket's as soon as whoever had it a log full
+**  ago is done with it; if it is still being written, or a later ticket
+**  already has it, the log went all the way round meanwhile and the event
+**  is counted as an overflow instead.
 */
 void EVS_AddLog (CFE_EVS_Packet_t *EVS_PktPtr)
 {
+   CFE_EVS_Log_t *LogPtr = CFE_EVS_GlobalData.EVS_LogPtr;
+   uint32         Ticket;
+   uint32         Added;
+   uint32         Entry;
 
    if (CFE_EVS_GlobalData.EVS_TlmPkt.Payload.LogEnabled == TRUE)
    {   
-      /* Serialize access to event log control variables */
-      OS_MutSemTake(CFE_EVS_GlobalData.EVS_SharedDataMutexID);
-
-      if ((CFE_EVS_GlobalData.EVS_LogPtr->LogFullFlag == TRUE) &&
-          (CFE_EVS_GlobalData.EVS_LogPtr->LogMode == CFE_EVS_LOG_DISCARD))
+      if (__atomic_load_n(&LogPtr->LogMode, __ATOMIC_RELAXED) == CFE_EVS_LOG_DISCARD)
       {
-         /* If log is full and in discard mode, just count the event */
-         CFE_EVS_GlobalData.EVS_LogPtr->LogOverflowCounter++;
+         Ticket = __atomic_load_n(&LogPtr->Ticket, __ATOMIC_RELAXED);
+
+         do
+         {
+            if ((int32)(Ticket - __atomic_load_n(&LogPtr->FirstTicket, __ATOMIC_RELAXED)) >=
+                (2 * CFE_EVS_LOG_MAX))
+            {
+               /* If log is full and in discard mode, just count the event */
+               __atomic_fetch_add(&LogPtr->LogOverflowCounter, 1, __ATOMIC_RELAXED);
+               return;
+            }
+         } while (!__atomic_compare_exchange_n(&LogPtr->Ticket, &Ticket, Ticket + 2, TRUE,
+                                               __ATOMIC_RELAXED, __ATOMIC_RELAXED));
       }
       else
       {
-         if (CFE_EVS_GlobalData.EVS_LogPtr->LogFullFlag == TRUE)
+         Ticket = __atomic_fetch_add(&LogPtr->Ticket, 2, __ATOMIC_RELAXED);
+
+         if ((int32)(Ticket - __atomic_load_n(&LogPtr->FirstTicket, __ATOMIC_RELAXED)) >=
+             (2 * CFE_EVS_LOG_MAX))
          {
             /* If log is full and in wrap mode, count it and store it */
-            CFE_EVS_GlobalData.EVS_LogPtr->LogOverflowCounter++;
+            __atomic_fetch_add(&LogPtr->LogOverflowCounter, 1, __ATOMIC_RELAXED);
          }
+      }
 
-         /* Copy the event data to the next available entry in the log */
-         CFE_PSP_MemCpy(&CFE_EVS_GlobalData.EVS_LogPtr->LogEntry[CFE_EVS_GlobalData.EVS_LogPtr->Next],
-                        EVS_PktPtr, sizeof(CFE_EVS_Packet_t));
+      Entry = (Ticket >> 1) % CFE_EVS_LOG_MAX;
+      Added = __atomic_load_n(&LogPtr->EntryTicket[Entry], __ATOMIC_RELAXED);
 
-         CFE_EVS_GlobalData.EVS_LogPtr->Next++;
+      if (((Added & 1) != 0) || ((int32)(Ticket - Added) < 0) ||
+          (!__atomic_compare_exchange_n(&LogPtr->EntryTicket[Entry], &Added, Ticket + 1, FALSE,
+                                        __ATOMIC_RELAXED, __ATOMIC_RELAXED)))
+      {
+         __atomic_fetch_add(&LogPtr->LogOverflowCounter, 1, __ATOMIC_RELAXED);
+      }
+      else
+      {
+         /* Readers see the entry is being written before they see any of it */
+         __atomic_thread_fence(__ATOMIC_RELEASE);
 
-         if (CFE_EVS_GlobalData.EVS_LogPtr->Next >= CFE_EVS_LOG_MAX)
-         {
-            /* This is important, even if we are in discard mode */
-            CFE_EVS_GlobalData.EVS_LogPtr->Next = 0;
-         }
+         CFE_PSP_MemCpy(&LogPtr->LogEntry[Entry], EVS_PktPtr, sizeof(CFE_EVS_Packet_t));
 
-         /* Log count cannot exceed the number of entries in the log */
-         if (CFE_EVS_GlobalData.EVS_LogPtr->LogCount < CFE_EVS_LOG_MAX)
-         {
-            CFE_EVS_GlobalData.EVS_LogPtr->LogCount++;
+         __atomic_store_n(&LogPtr->EntryTicket[Entry], Ticket + 2, __ATOMIC_RELEASE);
 
-            if (CFE_EVS_GlobalData.EVS_LogPtr->LogCount == CFE_EVS_LOG_MAX)
-            {
-               /* The full flag and log count are somewhat redundant */
-               CFE_EVS_GlobalData.EVS_LogPtr->LogFullFlag = TRUE;
-            }
-         }
+         EVS_LogStatus(LogPtr);
       }
-    
-      OS_MutSemGive(CFE_EVS_GlobalData.EVS_SharedDataMutexID);
    }
 
    return;
@@ -161,22 +241,38 @@ void EVS_AddLog (CFE_EVS_Packet_t *EVS_PktPtr)
 ** Purpose:  This routine clears the contents of the internal event log.
 **
 ** Assumptions and Notes:
-**
+**  The log starts over at the next ticket.  The entries are not zeroed, so
+**  an event being added while the log is cleared is either kept whole or
+**  dropped.
 */
 void EVS_ClearLog ( void )
 {
+   CFE_EVS_Log_t *LogPtr = CFE_EVS_GlobalData.EVS_LogPtr;
+   uint32         First;
+   uint32         i;
 
-   /* Serialize access to event log control variables */
+   /* Serialize with writing the log file */
    OS_MutSemTake(CFE_EVS_GlobalData.EVS_SharedDataMutexID);
 
+   First = __atomic_load_n(&LogPtr->Ticket, __ATOMIC_RELAXED);
+
+   if ((First & 1) != 0)
+   {
+      /* Only a reset area that was never cleared has an odd ticket */
+      First++;
+      __atomic_store_n(&LogPtr->Ticket, First, __ATOMIC_RELAXED);
+   }
+
    /* Clears everything but LogMode (overwrite vs discard) */
-   CFE_EVS_GlobalData.EVS_LogPtr->Next = 0;
-   CFE_EVS_GlobalData.EVS_LogPtr->LogCount = 0;
-   CFE_EVS_GlobalData.EVS_LogPtr->LogFullFlag = FALSE;
-   CFE_EVS_GlobalData.EVS_LogPtr->LogOverflowCounter = 0;
+   for (i = 0; i < CFE_EVS_LOG_MAX; i++)
+   {
+      __atomic_store_n(&LogPtr->EntryTicket[i], First, __ATOMIC_RELAXED);
+   }
+
+   __atomic_store_n(&LogPtr->FirstTicket, First, __ATOMIC_RELEASE);
+   LogPtr->LogOverflowCounter = 0;
 
-   CFE_PSP_MemSet(CFE_EVS_GlobalData.EVS_LogPtr->LogEntry, 0,
-                  CFE_EVS_LOG_MAX * sizeof(CFE_EVS_Packet_t));
+   EVS_LogStatus(LogPtr);
 
    OS_MutSemGive(CFE_EVS_GlobalData.EVS_SharedDataMutexID);
 
@@ -185,6 +281,43 @@ void EVS_ClearLog ( void )
 } /* End EVS_ClearLog */
 
 
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_RestoreLog
+**
+** Purpose:  This routine checks the event log kept over a processor reset.
+**
+** Assumptions and Notes:
+**  Returns FALSE if the event log tickets are not valid and the log needs
+**  clearing.  Entries the reset caught being written are dropped.
+*/
+boolean EVS_RestoreLog ( void )
+{
+   CFE_EVS_Log_t *LogPtr = CFE_EVS_GlobalData.EVS_LogPtr;
+   uint32         Tickets = LogPtr->Ticket - LogPtr->FirstTicket;
+   uint32         i;
+
+   if (((LogPtr->FirstTicket & 1) != 0) || ((Tickets & 1) != 0) || ((int32) Tickets < 0))
+   {
+      return FALSE;
+   }
+
+   for (i = 0; i < CFE_EVS_LOG_MAX; i++)
+   {
+      if ((LogPtr->EntryTicket[i] & 1) != 0)
+      {
+         LogPtr->EntryTicket[i] = LogPtr->FirstTicket;
+      }
+   }
+
+   EVS_LogStatus(LogPtr);
+
+   return TRUE;
+
+} /* End EVS_RestoreLog */
+
+
 /*
 **             Function Prologue
 **
@@ -193,21 +326,29 @@ void EVS_ClearLog ( void )
 ** Purpose:  This routine writes the contents of the internal event log to a file
 **
 ** Assumptions and Notes:
-**
+**  Tasks go on adding entries while the file is written.  An entry added
+**  again before it could be copied is left out, as it would have been had
+**  the command come a moment later.
 */
 boolean CFE_EVS_WriteLogFileCmd (CFE_SB_MsgPayloadPtr_t Payload)
 {
    const CFE_EVS_LogFileCmd_Payload_t *CmdPtr = (const CFE_EVS_LogFileCmd_Payload_t *)Payload;
+   CFE_EVS_Log_t  *LogPtr = CFE_EVS_GlobalData.EVS_LogPtr;
    boolean         Result = FALSE;
-   int32           LogIndex;
    int32           BytesWritten;
    int32           LogFileHandle;
+   uint32          Ticket;
+   uint32          Count;
+   uint32          Written = 0;
    uint32          i;
    CFE_FS_Header_t LogFileHdr;
    char            LogFilename[OS_MAX_PATH_LEN];
+   CFE_EVS_Packet_t *EntryPtr;
+   CFE_EVS_Packet_t  Entry;
+   CFE_EVS_Packet_t  TextEntry;
 
 
-   /* Serialize access to event log control variables */
+   /* Serialize with clearing the log */
    OS_MutSemTake(CFE_EVS_GlobalData.EVS_SharedDataMutexID);
 
    /* Copy the commanded filename into local buffer to ensure size limitation and to allow for modification */
@@ -233,33 +374,39 @@ boolean CFE_EVS_WriteLogFileCmd (CFE_SB_MsgPayloadPtr_t Payload)
 
       if (BytesWritten == sizeof(CFE_FS_Header_t))
       {
-         /* Is the log full? -- Doesn't matter if wrap mode is enabled */
-         if (CFE_EVS_GlobalData.EVS_LogPtr->LogCount == CFE_EVS_LOG_MAX)
-         {
-            /* Start with log entry that will be overwritten next (oldest) */
-            LogIndex = CFE_EVS_GlobalData.EVS_LogPtr->Next;
-         }
-         else
+         /* Write the entries added since the log was cleared, oldest first and at
+            most a log full; entries still being written are not in the log yet */
+         Ticket = __atomic_load_n(&LogPtr->Ticket, __ATOMIC_ACQUIRE);
+         Count = (Ticket - LogPtr->FirstTicket) >> 1;
+
+         if (Count > CFE_EVS_LOG_MAX)
          {
-            /* Start with the first entry in the log (oldest) */
-            LogIndex = 0;
+            Count = CFE_EVS_LOG_MAX;
          }
 
-         /* Write all the "in-use" event log entries to the file */
-         for (i = 0; i < CFE_EVS_GlobalData.EVS_LogPtr->LogCount; i++)
+         Ticket -= 2 * Count;
+
+         for (i = 0; i < Count; i++, Ticket += 2)
          {
-            BytesWritten = OS_write(LogFileHandle,
-                                    &CFE_EVS_GlobalData.EVS_LogPtr->LogEntry[LogIndex],
-                                    sizeof(CFE_EVS_Packet_t));
+            if (EVS_ReadLogEntry(LogPtr, Ticket, &Entry) == FALSE)
+            {
+               continue;
+            }
 
-            if (BytesWritten == sizeof(CFE_EVS_Packet_t))
+            EntryPtr = &Entry;
+
+            /* Deferred events are written as text, unless their format string is not known */
+            if ((CFE_SB_GetMsgId((CFE_SB_Msg_t *) EntryPtr) == CFE_EVS_DEFERRED_EVENT_MSG_MID) &&
+                (EVS_FormatDeferredPacket((CFE_EVS_DeferredPacket_t *) EntryPtr, &TextEntry) == TRUE))
             {
-               LogIndex++;
+               EntryPtr = &TextEntry;
+            }
+
+            BytesWritten = OS_write(LogFileHandle, EntryPtr, sizeof(CFE_EVS_Packet_t));
 
-               if (LogIndex >= CFE_EVS_LOG_MAX)
-               {
-                  LogIndex = 0;
-               }
+            if (BytesWritten == sizeof(CFE_EVS_Packet_t))
+            {
+               Written++;
             }
             else
             {
@@ -271,11 +418,11 @@ boolean CFE_EVS_WriteLogFileCmd (CFE_SB_MsgPayloadPtr_t Payload)
          }
 
          /* Process command handler success result */
-         if (i == CFE_EVS_GlobalData.EVS_LogPtr->LogCount)
+         if (i == Count)
          {
             EVS_SendEvent(CFE_EVS_WRLOG_EID, CFE_EVS_DEBUG,
                          "Write Log File Command: %d event log entries written to %s",
-                          (int)CFE_EVS_GlobalData.EVS_LogPtr->LogCount, LogFilename);
+                          (int)Written, LogFilename);
             Result = TRUE;
          }
       }
@@ -307,10 +454,8 @@ boolean CFE_EVS_SetLoggingModeCmd (CFE_SB_MsgPayloadPtr_t Payload)
 
    if ((CmdPtr->Mode == CFE_EVS_LOG_OVERWRITE) || (CmdPtr->Mode == CFE_EVS_LOG_DISCARD))
    {
-      /* Serialize access to event log control variables */
-      OS_MutSemTake(CFE_EVS_GlobalData.EVS_SharedDataMutexID);
-      CFE_EVS_GlobalData.EVS_LogPtr->LogMode = CmdPtr->Mode;
-      OS_MutSemGive(CFE_EVS_GlobalData.EVS_SharedDataMutexID);
+      /* Senders read the mode without a lock */
+      __atomic_store_n(&CFE_EVS_GlobalData.EVS_LogPtr->LogMode, (uint8) CmdPtr->Mode, __ATOMIC_RELAXED);
 
       EVS_SendEvent(CFE_EVS_LOGMODE_EID, CFE_EVS_DEBUG,
                    "Set Log Mode Command: Log Mode = %d", (int)CmdPtr->Mode);
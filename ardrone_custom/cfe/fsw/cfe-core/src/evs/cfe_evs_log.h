@@ -117,6 +117,7 @@
 
 void    EVS_AddLog ( CFE_EVS_Packet_t *EVS_PktPtr );
 void    EVS_ClearLog ( void );
+boolean EVS_RestoreLog ( void );
 boolean CFE_EVS_WriteLogFileCmd (CFE_SB_MsgPayloadPtr_t Payload);
 boolean CFE_EVS_SetLoggingModeCmd (CFE_SB_MsgPayloadPtr_t Payload);                          
 
@@ -227,7 +227,8 @@ int32 CFE_EVS_EarlyInit ( void )
                    (CFE_EVS_GlobalData.EVS_LogPtr->LogMode != CFE_EVS_LOG_DISCARD))  ||
                   ((CFE_EVS_GlobalData.EVS_LogPtr->LogFullFlag != FALSE)   &&
                    (CFE_EVS_GlobalData.EVS_LogPtr->LogFullFlag != TRUE))   ||
-                   (CFE_EVS_GlobalData.EVS_LogPtr->Next >= CFE_EVS_LOG_MAX))
+                   (CFE_EVS_GlobalData.EVS_LogPtr->Next >= CFE_EVS_LOG_MAX) ||
+                   (EVS_RestoreLog() == FALSE))
          {
             CFE_ES_WriteToSysLog("Event Log cleared, n=%d, c=%d, f=%d, m=%d, o=%d\n",
                                   (int)CFE_EVS_GlobalData.EVS_LogPtr->Next,
@@ -278,6 +279,7 @@ int32 CFE_EVS_CleanUpApp(uint32 AppID)
    {
       /* Same cleanup as CFE_EVS_Unregister() */
       CFE_PSP_MemSet(&CFE_EVS_GlobalData.AppData[AppID], 0, sizeof(EVS_AppData_t));
+      EVS_RemoveSpecs(AppID);
    }
     
    return(Status);
@@ -1129,7 +1131,8 @@ boolean CFE_EVS_SetEventFormatModeCmd (const CFE_SB_MsgPayloadPtr_t Payload)
    const CFE_EVS_ModeCmd_Payload_t *CmdPtr = (const CFE_EVS_ModeCmd_Payload_t *)Payload;
    boolean Status = TRUE;
 
-   if((CmdPtr->Mode == CFE_EVS_SHORT_FORMAT) || (CmdPtr->Mode == CFE_EVS_LONG_FORMAT))
+   if((CmdPtr->Mode == CFE_EVS_SHORT_FORMAT) || (CmdPtr->Mode == CFE_EVS_LONG_FORMAT) ||
+      (CmdPtr->Mode == CFE_EVS_DEFERRED_FORMAT))
    {
       CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageFormatMode = CmdPtr->Mode;
 
@@ -1697,6 +1700,8 @@ boolean CFE_EVS_AddEventFilterCmd (const CFE_SB_MsgPayloadPtr_t Payload)
                FilterPtr->Mask = CmdPtr->Mask;
                FilterPtr->Count = 0;
 
+               EVS_IndexFilters(AppDataPtr);
+
                EVS_SendEvent(CFE_EVS_ADDFILTER_EID, CFE_EVS_DEBUG,
                                  "Add Filter Command Received with AppName = %s, EventID = 0x%08x, Mask = 0x%04x",
                                  LocalName, CmdPtr->EventID, CmdPtr->Mask);
@@ -1782,6 +1787,8 @@ boolean CFE_EVS_DeleteEventFilterCmd (const CFE_SB_MsgPayloadPtr_t Payload)
          FilterPtr->Mask = CFE_EVS_NO_MASK;
          FilterPtr->Count = 0;
 
+         EVS_IndexFilters(AppDataPtr);
+
          EVS_SendEvent(CFE_EVS_DELFILTER_EID, CFE_EVS_DEBUG,
                            "Delete Filter Command Received with AppName = %s, EventID = 0x%08x",
                            LocalName, CmdPtr->EventID);
@@ -105,6 +105,13 @@
 #define CFE_EVS_UNDEF_APPID             0xFFFFFFFF
 #define CFE_EVS_MAX_PORT_MSG_LENGTH     (CFE_EVS_MAX_MESSAGE_LENGTH+OS_MAX_API_NAME+30)
 
+/* Deferred format string states */
+#define CFE_EVS_SPEC_FREE               0
+#define CFE_EVS_SPEC_FILLING            1
+#define CFE_EVS_SPEC_DEFERRED           2
+#define CFE_EVS_SPEC_TEXT               3
+#define CFE_EVS_SPEC_REMOVED            4
+
 /* Since CFE_EVS_MAX_PORT_MSG_LENGTH is the size of the buffer that is sent to 
  * print out (using OS_printf), we need to check to make sure that the buffer 
  * size the OS uses is big enough. This check has to be made here because it is
@@ -126,6 +133,15 @@ typedef struct
 } EVS_BinFilter_t;
 
 
+typedef struct
+{
+    uint16             Count;                              /* Number of binary filters in use */
+    int16              EventID[CFE_EVS_MAX_EVENT_FILTERS]; /* Event IDs of the filters in use, sorted */
+    uint16             Index[CFE_EVS_MAX_EVENT_FILTERS];   /* Binary filter of each sorted event ID */
+
+} EVS_FilterIndex_t;
+
+
 typedef struct
 {
     EVS_BinFilter_t    BinFilters[CFE_EVS_MAX_EVENT_FILTERS];  /* Array of binary filters */
@@ -134,10 +150,22 @@ typedef struct
     uint8              EventTypesActiveFlag;   /* Application event types active flag */
     uint16             EventCount;             /* Application event counter */
     uint16             RegisterFlag;           /* Application has registered flag */
+    uint32             FilterSequence;         /* Filter index in use is FilterIndex[FilterSequence & 1] */
+    EVS_FilterIndex_t  FilterIndex[2];         /* Index in use, and the one rebuilt next */
 
 } EVS_AppData_t;
 
 
+typedef struct
+{
+   uint32              State;       /* Free, being filled, deferred, sent as text or removed */
+   uint32              Hash;        /* Hash of the format string */
+   uint32              AppID;       /* Application the format string belongs to */
+   const char         *Spec;        /* Format string */
+
+} EVS_DeferredSpec_t;
+
+
 typedef struct {
    char                AppName[OS_MAX_API_NAME];               /* Application name */
    uint8               ActiveFlag;                             /* Application event service active flag */
@@ -153,6 +181,9 @@ typedef struct
 {
    EVS_AppData_t       AppData[CFE_ES_MAX_APPLICATIONS];    /* Application state data and event filters */
 
+   EVS_DeferredSpec_t  DeferredSpec[CFE_EVS_DEFERRED_SPEC_MAX]; /* Format strings of deferred events by hash */
+   EVS_DeferredSpec_t *DeferredSpecCache[CFE_EVS_DEFERRED_SPEC_MAX]; /* The same, by format string address */
+
    CFE_EVS_Log_t      *EVS_LogPtr;    /* Pointer to the EVS log in the ES Reset area*/
                                          /* see cfe_es_global.h */
                                          
@@ -85,6 +85,8 @@
 #include "cfe_evs_utils.h"   /* EVS utility function definitions */
 
 #include <stdio.h>
+#include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 
 #include "cfe_error.h"       /* cFE error code definitions */
@@ -94,12 +96,52 @@
 #include "cfe_sb.h"          /* Software Bus library function definitions */
 #include "cfe_es.h"
 
+/* Deferred event argument types */
+#define EVS_ARG_NONE       0    /* "%%", no argument */
+#define EVS_ARG_INT        1
+#define EVS_ARG_LONG       2
+#define EVS_ARG_LLONG      3
+#define EVS_ARG_INTMAX     4
+#define EVS_ARG_SIZE       5
+#define EVS_ARG_PTRDIFF    6
+#define EVS_ARG_DOUBLE     7
+#define EVS_ARG_LDOUBLE    8
+#define EVS_ARG_STRING     9
+#define EVS_ARG_POINTER    10
+#define EVS_ARG_BAD        11   /* conversion that cannot be deferred */
+
+#define EVS_ARG_SIZE_BYTES 8    /* bytes of each non-string argument */
+#define EVS_CONV_MAX       32   /* longest conversion specification formatted */
+
+/* Local Structure Definitions */
+typedef struct
+{
+   uint32  Length;      /* Characters from the '%' through the conversion character */
+   uint32  Stars;       /* '*' widths and precisions taken from the arguments */
+   uint32  Type;        /* Argument type */
+   boolean Unsigned;    /* Unsigned integer conversion */
+
+} EVS_Conversion_t;
+
+/* Local Data */
+
+/* Enable bit of each event type, zero for invalid event types */
+static const uint8 EVS_EventTypeBit[] =
+{
+   0,
+   CFE_EVS_DEBUG_BIT,         /* CFE_EVS_DEBUG */
+   CFE_EVS_INFORMATION_BIT,   /* CFE_EVS_INFORMATION */
+   CFE_EVS_ERROR_BIT,         /* CFE_EVS_ERROR */
+   CFE_EVS_CRITICAL_BIT       /* CFE_EVS_CRITICAL */
+};
+
 /* Local Function Prototypes */
 void EVS_SendViaPorts (CFE_EVS_Packet_t *EVS_PktPtr);
 void EVS_OutputPort1 (char *Message);
 void EVS_OutputPort2 (char *Message);
 void EVS_OutputPort3 (char *Message);
 void EVS_OutputPort4 (char *Message);
+void EVS_CountSent (uint32 AppID);
 
 /* Function Definitions */
 
@@ -232,66 +274,28 @@ boolean EVS_IsFiltered (uint32 AppID, uint16 EventID, uint16 EventType)
    EVS_BinFilter_t *FilterPtr;
    EVS_AppData_t   *AppDataPtr;
    boolean          Filtered = FALSE;
+   uint8            TypeBit = 0;
    char             AppName[OS_MAX_API_NAME];
 
 
    /* Caller has verified that AppID is good and has registered with EVS */
    AppDataPtr = &CFE_EVS_GlobalData.AppData[AppID];
 
-   if (AppDataPtr->ActiveFlag == FALSE)
+   if (EventType < (sizeof(EVS_EventTypeBit) / sizeof(EVS_EventTypeBit[0])))
    {
-      /* All events are disabled for this application */
-      Filtered = TRUE;
+      TypeBit = EVS_EventTypeBit[EventType];
    }
-   else switch (EventType)
-   {
-      case CFE_EVS_DEBUG:
-
-         if ((AppDataPtr->EventTypesActiveFlag & CFE_EVS_DEBUG_BIT) == 0)
-         {
-            /* Debug events are disabled for this application */
-            Filtered = TRUE;
-         }
-         break;
-
-      case CFE_EVS_INFORMATION:
-
-         if ((AppDataPtr->EventTypesActiveFlag & CFE_EVS_INFORMATION_BIT) == 0)
-         {
-            /* Informational events are disabled for this application */
-            Filtered = TRUE;
-         }
-         break;
-
-      case CFE_EVS_ERROR:
-
-         if ((AppDataPtr->EventTypesActiveFlag & CFE_EVS_ERROR_BIT) == 0)
-         {
-            /* Error events are disabled for this application */
-            Filtered = TRUE;
-         }
-         break;
-
-      case CFE_EVS_CRITICAL:
-
-         if ((AppDataPtr->EventTypesActiveFlag & CFE_EVS_CRITICAL_BIT) == 0)
-         {
-            /* Critical events are disabled for this application */
-            Filtered = TRUE;
-         }
-         break;
 
-      default:
-
-         /* Invalid Event Type */
-         Filtered = TRUE;
-         break;
+   if ((AppDataPtr->ActiveFlag == FALSE) || ((AppDataPtr->EventTypesActiveFlag & TypeBit) == 0))
+   {
+      /* All events, this type of event or an invalid event type are disabled for this application */
+      Filtered = TRUE;
    }
 
    /* Is this type of event enabled for this application? */
    if (Filtered == FALSE)
    {
-      FilterPtr = EVS_FindEventID(EventID, AppDataPtr->BinFilters);
+      FilterPtr = EVS_FindFilter(AppDataPtr, (int16) EventID);
 
       /* Does this event ID have an event filter table entry? */
       if (FilterPtr != NULL)
@@ -353,6 +357,135 @@ EVS_BinFilter_t *EVS_FindEventID (int16 EventID, EVS_BinFilter_t *FilterArray)
 } /* End EVS_FindEventID */
 
 
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_IndexFilters
+**
+** Purpose:  This routine rebuilds the index of the binary filters an application
+**           has in use, sorted by event ID
+**
+** Assumptions and Notes:
+**  Called whenever a filter is added or deleted.  The filters are few and
+**  change rarely, so an insertion sort is enough, and it keeps filters with
+**  the same event ID in table order.
+**
+**  EVS_FindFilter searches the index without a lock, so the index not in
+**  use is rebuilt and then published by bumping FilterSequence.  Rebuilds
+**  are made one at a time under the EVS shared data mutex.
+*/
+void EVS_IndexFilters (EVS_AppData_t *AppDataPtr)
+{
+   EVS_FilterIndex_t *IndexPtr;
+   int16  EventID;
+   uint16 Count = 0;
+   uint32 Sequence;
+   uint32 i;
+   uint32 j;
+
+   OS_MutSemTake(CFE_EVS_GlobalData.EVS_SharedDataMutexID);
+
+   Sequence = AppDataPtr->FilterSequence + 1;
+   IndexPtr = &AppDataPtr->FilterIndex[Sequence & 1];
+
+   for (i = 0; i < CFE_EVS_MAX_EVENT_FILTERS; i++)
+   {
+      EventID = AppDataPtr->BinFilters[i].EventID;
+
+      if (EventID != CFE_EVS_FREE_SLOT)
+      {
+         j = Count;
+
+         while ((j > 0) && (IndexPtr->EventID[j - 1] > EventID))
+         {
+            IndexPtr->EventID[j] = IndexPtr->EventID[j - 1];
+            IndexPtr->Index[j] = IndexPtr->Index[j - 1];
+            j--;
+         }
+
+         IndexPtr->EventID[j] = EventID;
+         IndexPtr->Index[j] = (uint16) i;
+         Count++;
+      }
+   }
+
+   IndexPtr->Count = Count;
+
+   /* The rebuilt index is complete before readers are sent to it */
+   __atomic_store_n(&AppDataPtr->FilterSequence, Sequence, __ATOMIC_RELEASE);
+
+   OS_MutSemGive(CFE_EVS_GlobalData.EVS_SharedDataMutexID);
+
+} /* End EVS_IndexFilters */
+
+
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_FindFilter
+**
+** Purpose:  This routine returns the binary filter an application has for the
+**           given event ID, or NULL if it has none
+**
+** Assumptions and Notes:
+**  A binary search of the sorted event IDs, returning the first filter in
+**  table order when several have the event ID, as EVS_FindEventID does.  The
+**  search halves the range without branching on the comparisons, since the
+**  event IDs sent are too mixed for them to be predicted.
+**
+**  Lock free.  The search is retried only if EVS_IndexFilters published a
+**  new index meanwhile, as it may then be rebuilding the one searched.
+*/
+EVS_BinFilter_t *EVS_FindFilter (EVS_AppData_t *AppDataPtr, int16 EventID)
+{
+   EVS_BinFilter_t         *FilterPtr;
+   const EVS_FilterIndex_t *IndexPtr;
+   uint32                   Sequence;
+   uint32                   Count;
+   uint32                   Base;
+   uint32                   Half;
+   uint16                   Index;
+
+   do
+   {
+      Sequence = __atomic_load_n(&AppDataPtr->FilterSequence, __ATOMIC_ACQUIRE);
+      IndexPtr = &AppDataPtr->FilterIndex[Sequence & 1];
+
+      FilterPtr = (EVS_BinFilter_t *) NULL;
+      Count = IndexPtr->Count;
+      Base = 0;
+
+      if (Count > CFE_EVS_MAX_EVENT_FILTERS)
+      {
+         Count = CFE_EVS_MAX_EVENT_FILTERS;
+      }
+
+      if (Count > 0)
+      {
+         /* Narrow down to the first event ID not below this one, or the last */
+         while (Count > 1)
+         {
+            Half = Count / 2;
+            Base = (IndexPtr->EventID[Base + Half - 1] < EventID) ? (Base + Half) : Base;
+            Count -= Half;
+         }
+
+         Index = IndexPtr->Index[Base];
+         if ((IndexPtr->EventID[Base] == EventID) && (Index < CFE_EVS_MAX_EVENT_FILTERS))
+         {
+            FilterPtr = &AppDataPtr->BinFilters[Index];
+         }
+      }
+
+      __atomic_thread_fence(__ATOMIC_ACQUIRE);
+
+   } while (Sequence != __atomic_load_n(&AppDataPtr->FilterSequence, __ATOMIC_RELAXED));
+
+   return(FilterPtr);
+
+} /* End EVS_FindFilter */
+
+
 /*
 **             Function Prologue
 **
@@ -436,6 +569,27 @@ void EVS_SendPacket (uint32 AppID, CFE_TIME_SysTime_t Time, CFE_EVS_Packet_t *EV
    /* Send event via selected ports */
    EVS_SendViaPorts(EVS_PktPtr);
 
+   /* Increment message send counters */
+   EVS_CountSent(AppID);
+
+   return;
+
+} /* End EVS_SendPacket */
+
+
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_CountSent
+**
+** Purpose:  This routine increments the message send counters for an event
+**           sent by the given application
+**
+** Assumptions and Notes:
+*/
+void EVS_CountSent (uint32 AppID)
+{
+
    /* Increment message send counters (prevent rollover) */
    if (CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageSendCounter < CFE_EVS_MAX_EVENT_SEND_COUNT)
    {
@@ -447,9 +601,7 @@ void EVS_SendPacket (uint32 AppID, CFE_TIME_SysTime_t Time, CFE_EVS_Packet_t *EV
       CFE_EVS_GlobalData.AppData[AppID].EventCount++;
    }
 
-   return;
-
-} /* End EVS_SendPacket */
+} /* End EVS_CountSent */
 
 
 /*
@@ -606,6 +758,7 @@ int32 EVS_SendEvent (uint16 EventID, uint16 EventType, const char *Spec, ... )
    int32              ExpandedLength;
    CFE_EVS_Packet_t   EVS_Packet;
    CFE_TIME_SysTime_t Time;
+   uint32             SpecHash;
    va_list            Ptr;
 
    /*
@@ -616,30 +769,42 @@ int32 EVS_SendEvent (uint16 EventID, uint16 EventType, const char *Spec, ... )
    if (CFE_EVS_GlobalData.EVS_AppID < CFE_ES_MAX_APPLICATIONS &&
            EVS_IsFiltered(CFE_EVS_GlobalData.EVS_AppID, EventID, EventType) == FALSE)
    {
-      /* Initialize EVS event packet */
-      CFE_SB_InitMsg(&EVS_Packet, CFE_EVS_EVENT_MSG_MID, sizeof(CFE_EVS_Packet_t), TRUE);
-      EVS_Packet.Payload.PacketID.EventID   = EventID;
-      EVS_Packet.Payload.PacketID.EventType = EventType;
-
-      /* vsnprintf() returns the total expanded length of the formatted string */
-      /* vsnprintf() copies and zero terminates portion that fits in the buffer */
-      va_start(Ptr, Spec);
-      ExpandedLength = vsnprintf((char *)EVS_Packet.Payload.Message, sizeof(EVS_Packet.Payload.Message), Spec, Ptr);
-      va_end(Ptr);
-
-      /* Were any characters truncated in the buffer? */
-      if (ExpandedLength >= sizeof(EVS_Packet.Payload.Message))
+      if ((CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageFormatMode == CFE_EVS_DEFERRED_FORMAT) &&
+          (EVS_DeferSpec(CFE_EVS_GlobalData.EVS_AppID, Spec, &SpecHash) == TRUE))
       {
-         /* Mark character before zero terminator to indicate truncation */
-         EVS_Packet.Payload.Message[sizeof(EVS_Packet.Payload.Message) - 2] = CFE_EVS_MSG_TRUNCATED;
-         CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageTruncCounter++;
+         /* Pack the arguments, formatting is left to whoever needs the text */
+         va_start(Ptr, Spec);
+         EVS_SendDeferredPacket(CFE_EVS_GlobalData.EVS_AppID, CFE_TIME_GetTime(), EventID, EventType,
+                                SpecHash, Spec, Ptr);
+         va_end(Ptr);
       }
+      else
+      {
+         /* Initialize EVS event packet */
+         CFE_SB_InitMsg(&EVS_Packet, CFE_EVS_EVENT_MSG_MID, sizeof(CFE_EVS_Packet_t), TRUE);
+         EVS_Packet.Payload.PacketID.EventID   = EventID;
+         EVS_Packet.Payload.PacketID.EventType = EventType;
+
+         /* vsnprintf() returns the total expanded length of the formatted string */
+         /* vsnprintf() copies and zero terminates portion that fits in the buffer */
+         va_start(Ptr, Spec);
+         ExpandedLength = vsnprintf((char *)EVS_Packet.Payload.Message, sizeof(EVS_Packet.Payload.Message), Spec, Ptr);
+         va_end(Ptr);
+
+         /* Were any characters truncated in the buffer? */
+         if (ExpandedLength >= sizeof(EVS_Packet.Payload.Message))
+         {
+            /* Mark character before zero terminator to indicate truncation */
+            EVS_Packet.Payload.Message[sizeof(EVS_Packet.Payload.Message) - 2] = CFE_EVS_MSG_TRUNCATED;
+            CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageTruncCounter++;
+         }
 
-      /* Get current spacecraft time */
-      Time = CFE_TIME_GetTime();
+         /* Get current spacecraft time */
+         Time = CFE_TIME_GetTime();
 
-      /* Send the event packet */
-      EVS_SendPacket(CFE_EVS_GlobalData.EVS_AppID, Time, &EVS_Packet);
+         /* Send the event packet */
+         EVS_SendPacket(CFE_EVS_GlobalData.EVS_AppID, Time, &EVS_Packet);
+      }
    }
 
    return(CFE_SUCCESS);
@@ -647,4 +812,871 @@ int32 EVS_SendEvent (uint16 EventID, uint16 EventType, const char *Spec, ... )
 } /* End EVS_SendEvent */
 
 
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_ParseConversion
+**
+** Purpose:  This routine parses the printf conversion specification starting
+**           at the given '%' and returns a pointer to the character after it
+**
+** Assumptions and Notes:
+**
+*/
+static const char *EVS_ParseConversion (const char *Ptr, EVS_Conversion_t *ConvPtr)
+{
+   const char *Start = Ptr;
+   uint32      Modifier = 0;
+
+   ConvPtr->Stars    = 0;
+   ConvPtr->Unsigned = FALSE;
+
+   /* Skip the '%' and any flags */
+   Ptr++;
+   while ((*Ptr == '-') || (*Ptr == '+') || (*Ptr == ' ') || (*Ptr == '#') || (*Ptr == '0'))
+   {
+      Ptr++;
+   }
+
+   /* Field width */
+   if (*Ptr == '*')
+   {
+      ConvPtr->Stars++;
+      Ptr++;
+   }
+   else
+   {
+      while ((*Ptr >= '0') && (*Ptr <= '9'))
+      {
+         Ptr++;
+      }
+   }
+
+   /* Precision */
+   if (*Ptr == '.')
+   {
+      Ptr++;
+      if (*Ptr == '*')
+      {
+         ConvPtr->Stars++;
+         Ptr++;
+      }
+      else
+      {
+         while ((*Ptr >= '0') && (*Ptr <= '9'))
+         {
+            Ptr++;
+         }
+      }
+   }
+
+   /* Length modifier, kept as the argument type it selects for integers */
+   switch (*Ptr)
+   {
+      case 'h':
+         Ptr++;
+         if (*Ptr == 'h')
+         {
+            Ptr++;
+         }
+         Modifier = EVS_ARG_INT;
+         break;
+
+      case 'l':
+         Ptr++;
+         Modifier = EVS_ARG_LONG;
+         if (*Ptr == 'l')
+         {
+            Ptr++;
+            Modifier = EVS_ARG_LLONG;
+         }
+         break;
+
+      case 'q':
+         Ptr++;
+         Modifier = EVS_ARG_LLONG;
+         break;
+
+      case 'j':
+         Ptr++;
+         Modifier = EVS_ARG_INTMAX;
+         break;
+
+      case 'z':
+         Ptr++;
+         Modifier = EVS_ARG_SIZE;
+         break;
+
+      case 't':
+         Ptr++;
+         Modifier = EVS_ARG_PTRDIFF;
+         break;
+
+      case 'L':
+         Ptr++;
+         Modifier = EVS_ARG_LDOUBLE;
+         break;
+
+      default:
+         break;
+   }
+
+   /* Conversion character */
+   switch (*Ptr)
+   {
+      case '%':
+         ConvPtr->Type = EVS_ARG_NONE;
+         break;
+
+      case 'u':
+      case 'o':
+      case 'x':
+      case 'X':
+         ConvPtr->Unsigned = TRUE;
+         /* fall through */
+      case 'd':
+      case 'i':
+         if (Modifier == EVS_ARG_LDOUBLE)
+         {
+            ConvPtr->Type = EVS_ARG_BAD;
+         }
+         else
+         {
+            ConvPtr->Type = (Modifier == 0) ? EVS_ARG_INT : Modifier;
+         }
+         break;
+
+      case 'c':
+         ConvPtr->Type = ((Modifier == 0) || (Modifier == EVS_ARG_LONG)) ? EVS_ARG_INT : EVS_ARG_BAD;
+         break;
+
+      case 'e':
+      case 'E':
+      case 'f':
+      case 'F':
+      case 'g':
+      case 'G':
+      case 'a':
+      case 'A':
+         ConvPtr->Type = (Modifier == EVS_ARG_LDOUBLE) ? EVS_ARG_LDOUBLE : EVS_ARG_DOUBLE;
+         break;
+
+      case 's':
+         ConvPtr->Type = (Modifier == 0) ? EVS_ARG_STRING : EVS_ARG_BAD;
+         break;
+
+      case 'p':
+         ConvPtr->Type = (Modifier == 0) ? EVS_ARG_POINTER : EVS_ARG_BAD;
+         break;
+
+      default:
+         /* "%n", wide strings and unknown or missing conversions */
+         ConvPtr->Type = EVS_ARG_BAD;
+         break;
+   }
+
+   if (*Ptr != '\0')
+   {
+      Ptr++;
+   }
+
+   ConvPtr->Length = Ptr - Start;
+
+   return(Ptr);
+
+} /* End EVS_ParseConversion */
+
+
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_SpecHash
+**
+** Purpose:  This routine returns the 32 bit FNV-1a hash of a format string
+**
+** Assumptions and Notes:
+**
+*/
+static uint32 EVS_SpecHash (const char *Spec)
+{
+   uint32 Hash = 2166136261u;
+
+   while (*Spec != '\0')
+   {
+      Hash ^= (uint8) *Spec++;
+      Hash *= 16777619u;
+   }
+
+   return(Hash);
+
+} /* End EVS_SpecHash */
+
+
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_DeferSpec
+**
+** Purpose:  This routine returns true if events with the given format string
+**           can be sent in the deferred format, and the hash identifying it.
+**           The format string is remembered by its hash the first time.
+**
+** Assumptions and Notes:
+**  Format strings are string constants (see CFE_EVS_SendEvent in cfe_evs.h),
+**  so they are remembered by pointer and the pointer alone identifies them.
+**  Any task may send an event, so a free entry is claimed by compare and swap
+**  and its state published once the entry is filled in.  Events are sent as
+**  text when their format string is still being filled in by another task,
+**  has a conversion that cannot be deferred, has the same hash as another
+**  format string or does not fit in the table.  Entries are found by the
+**  address of their format string first, so most events need no hash.
+**  Entries removed with the application that owned them are filled in again
+**  by the next format string with the same hash.
+*/
+boolean EVS_DeferSpec (uint32 AppID, const char *Spec, uint32 *HashPtr)
+{
+   EVS_DeferredSpec_t **CachePtr;
+   EVS_DeferredSpec_t  *EntryPtr;
+   EVS_Conversion_t     Conv;
+   const char          *Ptr;
+   uint32               Hash;
+   uint32               State;
+   uint32               Expected;
+   uint32               Index;
+   uint32               i;
+
+   /* Entries are filled in once, so one found by address can be used as is */
+   CachePtr = &CFE_EVS_GlobalData.DeferredSpecCache[((cpuaddr) Spec >> 2) % CFE_EVS_DEFERRED_SPEC_MAX];
+   EntryPtr = __atomic_load_n(CachePtr, __ATOMIC_ACQUIRE);
+
+   if ((EntryPtr != NULL) && (EntryPtr->Spec == Spec))
+   {
+      *HashPtr = EntryPtr->Hash;
+      return(EntryPtr->State == CFE_EVS_SPEC_DEFERRED);
+   }
+
+   Hash = EVS_SpecHash(Spec);
+   *HashPtr = Hash;
+   Index = Hash % CFE_EVS_DEFERRED_SPEC_MAX;
+
+   for (i = 0; i < CFE_EVS_DEFERRED_SPEC_MAX; i++)
+   {
+      EntryPtr = &CFE_EVS_GlobalData.DeferredSpec[Index];
+      State = __atomic_load_n(&EntryPtr->State, __ATOMIC_ACQUIRE);
+
+      if ((State == CFE_EVS_SPEC_FREE) ||
+          ((State == CFE_EVS_SPEC_REMOVED) && (EntryPtr->Hash == Hash)))
+      {
+         Expected = State;
+
+         if (__atomic_compare_exchange_n(&EntryPtr->State, &Expected, CFE_EVS_SPEC_FILLING,
+                                         FALSE, __ATOMIC_ACQUIRE, __ATOMIC_ACQUIRE))
+         {
+            EntryPtr->Hash = Hash;
+            EntryPtr->AppID = AppID;
+            EntryPtr->Spec = Spec;
+
+            /* Every conversion must have an argument type that can be packed */
+            State = CFE_EVS_SPEC_DEFERRED;
+            Ptr = Spec;
+            while ((Ptr = strchr(Ptr, '%')) != NULL)
+            {
+               Ptr = EVS_ParseConversion(Ptr, &Conv);
+               if (Conv.Type == EVS_ARG_BAD)
+               {
+                  State = CFE_EVS_SPEC_TEXT;
+                  break;
+               }
+            }
+
+            __atomic_store_n(&EntryPtr->State, State, __ATOMIC_RELEASE);
+            __atomic_store_n(CachePtr, EntryPtr, __ATOMIC_RELEASE);
+
+            return(State == CFE_EVS_SPEC_DEFERRED);
+         }
+
+         /* Another task claimed this entry first */
+         State = Expected;
+      }
+
+      if (State == CFE_EVS_SPEC_FILLING)
+      {
+         return(FALSE);
+      }
+
+      if ((State != CFE_EVS_SPEC_REMOVED) && (EntryPtr->Hash == Hash))
+      {
+         if ((EntryPtr->Spec != Spec) && (strcmp(EntryPtr->Spec, Spec) != 0))
+         {
+            /* Two format strings with the same hash cannot be told apart */
+            return(FALSE);
+         }
+
+         if (EntryPtr->Spec == Spec)
+         {
+            __atomic_store_n(CachePtr, EntryPtr, __ATOMIC_RELEASE);
+         }
+
+         return(State == CFE_EVS_SPEC_DEFERRED);
+      }
+
+      Index++;
+      if (Index >= CFE_EVS_DEFERRED_SPEC_MAX)
+      {
+         Index = 0;
+      }
+   }
+
+   return(FALSE);
+
+} /* End EVS_DeferSpec */
+
+
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_FindSpec
+**
+** Purpose:  This routine returns the format string of deferred events with the
+**           given hash, or NULL if it is not known
+**
+** Assumptions and Notes:
+**  Events in the local event log from before a processor reset have format
+**  strings that are not known until an event with the same format string is
+**  sent again.
+*/
+const char *EVS_FindSpec (uint32 Hash)
+{
+   EVS_DeferredSpec_t *EntryPtr;
+   uint32              State;
+   uint32              Index;
+   uint32              i;
+
+   Index = Hash % CFE_EVS_DEFERRED_SPEC_MAX;
+
+   for (i = 0; i < CFE_EVS_DEFERRED_SPEC_MAX; i++)
+   {
+      EntryPtr = &CFE_EVS_GlobalData.DeferredSpec[Index];
+      State = __atomic_load_n(&EntryPtr->State, __ATOMIC_ACQUIRE);
+
+      if (State == CFE_EVS_SPEC_FREE)
+      {
+         break;
+      }
+
+      if ((State == CFE_EVS_SPEC_DEFERRED) && (EntryPtr->Hash == Hash))
+      {
+         return(EntryPtr->Spec);
+      }
+
+      Index++;
+      if (Index >= CFE_EVS_DEFERRED_SPEC_MAX)
+      {
+         Index = 0;
+      }
+   }
+
+   return((const char *) NULL);
+
+} /* End EVS_FindSpec */
+
+
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_RemoveSpecs
+**
+** Purpose:  This routine removes the format strings of the given application,
+**           whose memory may be used for other format strings once the
+**           application is gone
+**
+** Assumptions and Notes:
+**  Removed entries stay in the table so the entries after them can still be
+**  found by hash.
+*/
+void EVS_RemoveSpecs (uint32 AppID)
+{
+   EVS_DeferredSpec_t *EntryPtr;
+   uint32              Expected;
+   uint32              i;
+
+   for (i = 0; i < CFE_EVS_DEFERRED_SPEC_MAX; i++)
+   {
+      EntryPtr = __atomic_load_n(&CFE_EVS_GlobalData.DeferredSpecCache[i], __ATOMIC_ACQUIRE);
+
+      if ((EntryPtr != NULL) && (EntryPtr->AppID == AppID))
+      {
+         __atomic_store_n(&CFE_EVS_GlobalData.DeferredSpecCache[i], NULL, __ATOMIC_RELEASE);
+      }
+   }
+
+   for (i = 0; i < CFE_EVS_DEFERRED_SPEC_MAX; i++)
+   {
+      EntryPtr = &CFE_EVS_GlobalData.DeferredSpec[i];
+      Expected = __atomic_load_n(&EntryPtr->State, __ATOMIC_ACQUIRE);
+
+      /* Entries being filled in belong to a task that is still running */
+      if (((Expected == CFE_EVS_SPEC_DEFERRED) || (Expected == CFE_EVS_SPEC_TEXT)) &&
+          (EntryPtr->AppID == AppID))
+      {
+         __atomic_compare_exchange_n(&EntryPtr->State, &Expected, CFE_EVS_SPEC_REMOVED,
+                                     FALSE, __ATOMIC_RELEASE, __ATOMIC_RELAXED);
+      }
+   }
+
+} /* End EVS_RemoveSpecs */
+
+
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_PackArgs
+**
+** Purpose:  This routine packs the arguments of a format string into the
+**           argument data of a deferred event packet and returns its length
+**
+** Assumptions and Notes:
+**  The format string has been checked by EVS_DeferSpec.  Arguments that do not
+**  fit are dropped, along with the ones after them, and the packet is marked
+**  truncated.
+*/
+static uint16 EVS_PackArgs (const char *Spec, va_list Ptr, CFE_EVS_DeferredPacket_Payload_t *PayloadPtr)
+{
+   EVS_Conversion_t Conv;
+   uint8           *Data = PayloadPtr->ArgData;
+   uint32           Pos = 0;
+   uint32           Length;
+   uint32           i;
+   int64            Value;
+   double           Real;
+   const char      *String;
+
+   while ((Spec = strchr(Spec, '%')) != NULL)
+   {
+      Spec = EVS_ParseConversion(Spec, &Conv);
+
+      if (Conv.Type == EVS_ARG_NONE)
+      {
+         continue;
+      }
+
+      if ((Pos + (Conv.Stars * EVS_ARG_SIZE_BYTES)) > sizeof(PayloadPtr->ArgData))
+      {
+         PayloadPtr->Flags |= CFE_EVS_DEFERRED_TRUNCATED;
+         break;
+      }
+
+      for (i = 0; i < Conv.Stars; i++)
+      {
+         Value = va_arg(Ptr, int);
+         memcpy(&Data[Pos], &Value, EVS_ARG_SIZE_BYTES);
+         Pos += EVS_ARG_SIZE_BYTES;
+      }
+
+      if (Conv.Type == EVS_ARG_STRING)
+      {
+         String = va_arg(Ptr, const char *);
+         if (String == NULL)
+         {
+            String = "(null)";
+         }
+
+         if (Pos >= sizeof(PayloadPtr->ArgData))
+         {
+            PayloadPtr->Flags |= CFE_EVS_DEFERRED_TRUNCATED;
+            break;
+         }
+
+         Length = strlen(String);
+         if (Length >= (sizeof(PayloadPtr->ArgData) - Pos))
+         {
+            Length = sizeof(PayloadPtr->ArgData) - Pos - 1;
+            PayloadPtr->Flags |= CFE_EVS_DEFERRED_TRUNCATED;
+         }
+
+         memcpy(&Data[Pos], String, Length);
+         Data[Pos + Length] = '\0';
+         Pos += Length + 1;
+
+         if ((PayloadPtr->Flags & CFE_EVS_DEFERRED_TRUNCATED) != 0)
+         {
+            break;
+         }
+
+         continue;
+      }
+
+      if ((Pos + EVS_ARG_SIZE_BYTES) > sizeof(PayloadPtr->ArgData))
+      {
+         PayloadPtr->Flags |= CFE_EVS_DEFERRED_TRUNCATED;
+         break;
+      }
+
+      switch (Conv.Type)
+      {
+         case EVS_ARG_INT:
+            Value = Conv.Unsigned ? (int64) va_arg(Ptr, unsigned int) : (int64) va_arg(Ptr, int);
+            break;
+
+         case EVS_ARG_LONG:
+            Value = Conv.Unsigned ? (int64) va_arg(Ptr, unsigned long) : (int64) va_arg(Ptr, long);
+            break;
+
+         case EVS_ARG_LLONG:
+            Value = (int64) va_arg(Ptr, long long);
+            break;
+
+         case EVS_ARG_INTMAX:
+            Value = (int64) va_arg(Ptr, intmax_t);
+            break;
+
+         case EVS_ARG_SIZE:
+            Value = (int64) va_arg(Ptr, size_t);
+            break;
+
+         case EVS_ARG_PTRDIFF:
+            Value = (int64) va_arg(Ptr, ptrdiff_t);
+            break;
+
+         case EVS_ARG_POINTER:
+            Value = (int64) (cpuaddr) va_arg(Ptr, void *);
+            break;
+
+         case EVS_ARG_LDOUBLE:
+            Real = (double) va_arg(Ptr, long double);
+            memcpy(&Value, &Real, EVS_ARG_SIZE_BYTES);
+            break;
+
+         default:
+            Real = va_arg(Ptr, double);
+            memcpy(&Value, &Real, EVS_ARG_SIZE_BYTES);
+            break;
+      }
+
+      memcpy(&Data[Pos], &Value, EVS_ARG_SIZE_BYTES);
+      Pos += EVS_ARG_SIZE_BYTES;
+   }
+
+   return((uint16) Pos);
+
+} /* End EVS_PackArgs */
+
+
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_FormatArgs
+**
+** Purpose:  This routine formats the packed arguments of a deferred event with
+**           its format string, the way vsnprintf would have when it was sent
+**
+** Assumptions and Notes:
+**  Each conversion is formatted on its own by snprintf, with any '*' width or
+**  precision written into the conversion specification.  Text that does not
+**  fit, or arguments dropped when the event was sent, are marked the way the
+**  text format marks truncation.
+*/
+static void EVS_FormatArgs (const char *Spec, const CFE_EVS_DeferredPacket_Payload_t *PayloadPtr,
+                            char *Buffer, uint32 Size)
+{
+   EVS_Conversion_t Conv;
+   const uint8     *Data = PayloadPtr->ArgData;
+   const char      *Next;
+   char             ConvSpec[EVS_CONV_MAX];
+   uint32           DataLength = PayloadPtr->ArgLength;
+   uint32           In = 0;
+   uint32           Pos = 0;
+   uint32           ConvPos;
+   uint32           Length;
+   uint32           i;
+   int32            Written;
+   int64            Value;
+   double           Real;
+   boolean          Truncated = ((PayloadPtr->Flags & CFE_EVS_DEFERRED_TRUNCATED) != 0);
+   boolean          Stopped = FALSE;
+
+   if (DataLength > sizeof(PayloadPtr->ArgData))
+   {
+      DataLength = sizeof(PayloadPtr->ArgData);
+   }
+
+   while ((*Spec != '\0') && (Stopped == FALSE))
+   {
+      /* Text up to the next conversion */
+      Next = strchr(Spec, '%');
+      Length = (Next == NULL) ? strlen(Spec) : (uint32) (Next - Spec);
+
+      if (Length >= (Size - Pos))
+      {
+         memcpy(&Buffer[Pos], Spec, Size - Pos - 1);
+         Pos = Size - 1;
+         Truncated = TRUE;
+         break;
+      }
+
+      memcpy(&Buffer[Pos], Spec, Length);
+      Pos += Length;
+
+      if (Next == NULL)
+      {
+         break;
+      }
+
+      Spec = EVS_ParseConversion(Next, &Conv);
+
+      if (Conv.Type == EVS_ARG_NONE)
+      {
+         if (Pos >= (Size - 1))
+         {
+            Truncated = TRUE;
+            break;
+         }
+
+         Buffer[Pos++] = '%';
+         continue;
+      }
+
+      /* Copy the conversion specification, with the '*' values written in */
+      ConvPos = 0;
+      for (i = 0; (i < Conv.Length) && (Stopped == FALSE); i++)
+      {
+         if (Next[i] == '*')
+         {
+            if ((In + EVS_ARG_SIZE_BYTES) > DataLength)
+            {
+               Stopped = TRUE;
+               break;
+            }
+
+            memcpy(&Value, &Data[In], EVS_ARG_SIZE_BYTES);
+            In += EVS_ARG_SIZE_BYTES;
+            Written = snprintf(&ConvSpec[ConvPos], sizeof(ConvSpec) - ConvPos, "%d", (int) Value);
+         }
+         else
+         {
+            Written = snprintf(&ConvSpec[ConvPos], sizeof(ConvSpec) - ConvPos, "%c", Next[i]);
+         }
+
+         if ((Written < 0) || (Written >= (int32) (sizeof(ConvSpec) - ConvPos)))
+         {
+            Stopped = TRUE;
+            break;
+         }
+
+         ConvPos += Written;
+      }
+
+      if (Stopped == TRUE)
+      {
+         Truncated = TRUE;
+         break;
+      }
+
+      /* Format the argument as the type the conversion expects */
+      if (Conv.Type == EVS_ARG_STRING)
+      {
+         if ((In >= DataLength) || (memchr(&Data[In], '\0', DataLength - In) == NULL))
+         {
+            Truncated = TRUE;
+            break;
+         }
+
+         Written = snprintf(&Buffer[Pos], Size - Pos, ConvSpec, (const char *) &Data[In]);
+         In += strlen((const char *) &Data[In]) + 1;
+      }
+      else
+      {
+         if ((In + EVS_ARG_SIZE_BYTES) > DataLength)
+         {
+            Truncated = TRUE;
+            break;
+         }
+
+         memcpy(&Value, &Data[In], EVS_ARG_SIZE_BYTES);
+         memcpy(&Real, &Data[In], EVS_ARG_SIZE_BYTES);
+         In += EVS_ARG_SIZE_BYTES;
+
+         switch (Conv.Type)
+         {
+            case EVS_ARG_INT:
+               Written = snprintf(&Buffer[Pos], Size - Pos, ConvSpec, (int) Value);
+               break;
+
+            case EVS_ARG_LONG:
+               Written = snprintf(&Buffer[Pos], Size - Pos, ConvSpec, (long) Value);
+               break;
+
+            case EVS_ARG_LLONG:
+               Written = snprintf(&Buffer[Pos], Size - Pos, ConvSpec, (long long) Value);
+               break;
+
+            case EVS_ARG_INTMAX:
+               Written = snprintf(&Buffer[Pos], Size - Pos, ConvSpec, (intmax_t) Value);
+               break;
+
+            case EVS_ARG_SIZE:
+               Written = snprintf(&Buffer[Pos], Size - Pos, ConvSpec, (size_t) Value);
+               break;
+
+            case EVS_ARG_PTRDIFF:
+               Written = snprintf(&Buffer[Pos], Size - Pos, ConvSpec, (ptrdiff_t) Value);
+               break;
+
+            case EVS_ARG_POINTER:
+               Written = snprintf(&Buffer[Pos], Size - Pos, ConvSpec, (void *) (cpuaddr) Value);
+               break;
+
+            case EVS_ARG_LDOUBLE:
+               Written = snprintf(&Buffer[Pos], Size - Pos, ConvSpec, (long double) Real);
+               break;
+
+            default:
+               Written = snprintf(&Buffer[Pos], Size - Pos, ConvSpec, Real);
+               break;
+         }
+      }
+
+      if (Written < 0)
+      {
+         break;
+      }
+
+      if ((uint32) Written >= (Size - Pos))
+      {
+         Pos = Size - 1;
+         Truncated = TRUE;
+         break;
+      }
+
+      Pos += Written;
+   }
+
+   Buffer[Pos] = '\0';
+
+   if (Truncated == TRUE)
+   {
+      /* Mark the last character that fits to indicate truncation */
+      if (Pos >= (Size - 1))
+      {
+         Buffer[Size - 2] = CFE_EVS_MSG_TRUNCATED;
+      }
+      else
+      {
+         Buffer[Pos++] = CFE_EVS_MSG_TRUNCATED;
+         Buffer[Pos] = '\0';
+      }
+   }
+
+} /* End EVS_FormatArgs */
+
+
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_FormatDeferredPacket
+**
+** Purpose:  This routine formats a deferred event packet into an event packet
+**           with the event text.  It returns false, with a message saying so,
+**           if the format string of the event is not known.
+**
+** Assumptions and Notes:
+*/
+boolean EVS_FormatDeferredPacket (const CFE_EVS_DeferredPacket_t *DeferredPtr, CFE_EVS_Packet_t *EVS_PktPtr)
+{
+   const char *Spec;
+   boolean     Known = TRUE;
+
+   /* Same header, time included, for the event message */
+   CFE_PSP_MemCpy(EVS_PktPtr->TlmHeader, (void *) DeferredPtr->TlmHeader, sizeof(EVS_PktPtr->TlmHeader));
+   CFE_SB_SetMsgId((CFE_SB_Msg_t *) EVS_PktPtr, CFE_EVS_EVENT_MSG_MID);
+   CFE_SB_SetTotalMsgLength((CFE_SB_Msg_t *) EVS_PktPtr, sizeof(CFE_EVS_Packet_t));
+
+   EVS_PktPtr->Payload.PacketID = DeferredPtr->Payload.PacketID;
+   EVS_PktPtr->Payload.Spare1 = 0;
+   EVS_PktPtr->Payload.Spare2 = 0;
+
+   Spec = EVS_FindSpec(DeferredPtr->Payload.SpecHash);
+
+   if (Spec == NULL)
+   {
+      snprintf(EVS_PktPtr->Payload.Message, sizeof(EVS_PktPtr->Payload.Message),
+               "Deferred event format 0x%08X not known", (unsigned int) DeferredPtr->Payload.SpecHash);
+      Known = FALSE;
+   }
+   else
+   {
+      EVS_FormatArgs(Spec, &DeferredPtr->Payload, EVS_PktPtr->Payload.Message, sizeof(EVS_PktPtr->Payload.Message));
+   }
+
+   return(Known);
+
+} /* End EVS_FormatDeferredPacket */
+
+
+/*
+**             Function Prologue
+**
+** Function Name:      EVS_SendDeferredPacket
+**
+** Purpose:  This routine sends an event in the deferred format, its arguments
+**           packed rather than formatted, out the software bus, to the event
+**           log and, formatted, out all enabled output ports
+**
+** Assumptions and Notes:
+**  The caller has checked that the event is not filtered and its format string
+**  can be deferred.  The packet is the size of an event packet, so it is kept
+**  in the event log as it is and formatted when the log is written to a file.
+*/
+void EVS_SendDeferredPacket (uint32 AppID, CFE_TIME_SysTime_t Time, uint16 EventID, uint16 EventType,
+                             uint32 SpecHash, const char *Spec, va_list Ptr)
+{
+   CFE_EVS_DeferredPacket_t EVS_Packet;
+   CFE_EVS_Packet_t         TextPacket;
+
+   /* Initialize deferred event packet */
+   CFE_SB_InitMsg(&EVS_Packet, CFE_EVS_DEFERRED_EVENT_MSG_MID, sizeof(CFE_EVS_DeferredPacket_t), TRUE);
+   EVS_Packet.Payload.PacketID.EventID   = EventID;
+   EVS_Packet.Payload.PacketID.EventType = EventType;
+   EVS_Packet.Payload.SpecHash = SpecHash;
+   EVS_Packet.Payload.Flags = 0;
+   EVS_Packet.Payload.Spare = 0;
+
+   EVS_Packet.Payload.ArgLength = EVS_PackArgs(Spec, Ptr, &EVS_Packet.Payload);
+
+   if ((EVS_Packet.Payload.Flags & CFE_EVS_DEFERRED_TRUNCATED) != 0)
+   {
+      CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageTruncCounter++;
+   }
+
+   /* Obtain task and system information */
+   CFE_ES_GetAppName((char *)EVS_Packet.Payload.PacketID.AppName, AppID,
+           sizeof(EVS_Packet.Payload.PacketID.AppName));
+   EVS_Packet.Payload.PacketID.SpacecraftID = CFE_PSP_GetSpacecraftId();
+   EVS_Packet.Payload.PacketID.ProcessorID  = CFE_PSP_GetProcessorId();
+
+   /* Set the packet timestamp and send only the arguments used */
+   CFE_SB_SetMsgTime((CFE_SB_Msg_t *) &EVS_Packet, Time);
+   CFE_SB_SetTotalMsgLength((CFE_SB_Msg_t *) &EVS_Packet,
+                            offsetof(CFE_EVS_DeferredPacket_t, Payload.ArgData) + EVS_Packet.Payload.ArgLength);
+
+   /* Write event to the event log */
+   EVS_AddLog((CFE_EVS_Packet_t *) &EVS_Packet);
+
+   /* Send event via SoftwareBus */
+   CFE_SB_SendMsg((CFE_SB_Msg_t *) &EVS_Packet);
+
+   /* Format the event only if a port needs the text */
+   if ((CFE_EVS_GlobalData.EVS_TlmPkt.Payload.OutputPort &
+        (CFE_EVS_PORT1_BIT | CFE_EVS_PORT2_BIT | CFE_EVS_PORT3_BIT | CFE_EVS_PORT4_BIT)) != 0)
+   {
+      EVS_FormatDeferredPacket(&EVS_Packet, &TextPacket);
+      EVS_SendViaPorts(&TextPacket);
+   }
+
+   /* Increment message send counters */
+   EVS_CountSent(AppID);
+
+} /* End EVS_SendDeferredPacket */
+
+
 /* End cfe_evs_utils */
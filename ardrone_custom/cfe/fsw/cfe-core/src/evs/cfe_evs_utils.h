@@ -68,6 +68,8 @@
 
 #include "cfe_evs_task.h"        /* EVS internal definitions */
 
+#include <stdarg.h>
+
 /* ==============   Section I: Macro and Constant Type Definitions   =========== */
 
 /* ==============   Section II: Internal Structures ============ */     
@@ -84,6 +86,10 @@ boolean EVS_IsFiltered(uint32 AppID, uint16 EventID, uint16 EventType);
 
 EVS_BinFilter_t *EVS_FindEventID(int16 EventID, EVS_BinFilter_t *FilterArray);
 
+void EVS_IndexFilters(EVS_AppData_t *AppDataPtr);
+
+EVS_BinFilter_t *EVS_FindFilter(EVS_AppData_t *AppDataPtr, int16 EventID);
+
 void EVS_EnableTypes(uint8 BitMask, uint32 AppID);
 
 void EVS_DisableTypes(uint8 BitMask, uint32 AppID);
@@ -92,4 +98,15 @@ void EVS_SendPacket(uint32 AppID, CFE_TIME_SysTime_t Time, CFE_EVS_Packet_t *EVS
 
 int32 EVS_SendEvent (uint16 EventID, uint16 EventType, const char *Spec, ... );
 
+boolean EVS_DeferSpec(uint32 AppID, const char *Spec, uint32 *HashPtr);
+
+const char *EVS_FindSpec(uint32 Hash);
+
+void EVS_RemoveSpecs(uint32 AppID);
+
+void EVS_SendDeferredPacket(uint32 AppID, CFE_TIME_SysTime_t Time, uint16 EventID, uint16 EventType,
+                            uint32 SpecHash, const char *Spec, va_list Ptr);
+
+boolean EVS_FormatDeferredPacket(const CFE_EVS_DeferredPacket_t *DeferredPtr, CFE_EVS_Packet_t *EVS_PktPtr);
+
 #endif  /* _cfe_evs_utils_ */
@@ -65,8 +65,15 @@
     #error CFE_EVS_LOG_MAX cannot be greater than 65535
 #endif
 
-#if( CFE_EVS_DEFAULT_MSG_FORMAT_MODE != CFE_EVS_LONG_FORMAT) && (CFE_EVS_DEFAULT_MSG_FORMAT_MODE != CFE_EVS_SHORT_FORMAT)
-    #error CFE_EVS_DEFAULT_MSG_FORMAT can only be CFE_EVS_LONG_FORMAT or CFE_EVS_SHORT_FORMAT !
+#if( CFE_EVS_DEFAULT_MSG_FORMAT_MODE != CFE_EVS_LONG_FORMAT) && (CFE_EVS_DEFAULT_MSG_FORMAT_MODE != CFE_EVS_SHORT_FORMAT) && \
+   ( CFE_EVS_DEFAULT_MSG_FORMAT_MODE != CFE_EVS_DEFERRED_FORMAT)
+    #error CFE_EVS_DEFAULT_MSG_FORMAT can only be CFE_EVS_LONG_FORMAT, CFE_EVS_SHORT_FORMAT or CFE_EVS_DEFERRED_FORMAT !
+#endif
+
+#if CFE_EVS_DEFERRED_SPEC_MAX < 1
+    #error CFE_EVS_DEFERRED_SPEC_MAX cannot be less than 1!
+#elif CFE_EVS_DEFERRED_SPEC_MAX > 65535
+    #error CFE_EVS_DEFERRED_SPEC_MAX cannot be greater than 65535!
 #endif
 
 #if CFE_EVS_PORT_DEFAULT > 0x0F
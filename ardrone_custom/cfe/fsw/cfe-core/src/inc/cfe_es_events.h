@@ -1553,6 +1553,51 @@
 **/
 #define CFE_ES_BUILD_INF_EID    92
 
+/** \brief <tt> 'Set Performance Latency Marker Cmd rcvd, slot \%d, marker \%u' </tt>
+**  \event <tt> 'Set Performance Latency Marker Cmd rcvd, slot \%d, marker \%u' </tt>
+**
+**  \par Type: DEBUG
+**
+**  \par Cause:
+**
+**  This event message is generated in response to receiving an Executive Services
+**  \link #CFE_ES_PERF_SETLATMARKER_CC Set Performance Analyzer Latency Marker Command \endlink.
+**
+**  The \c 'slot' field identifies the latency slot and the \c 'marker' field the
+**  performance marker it now measures.
+**/
+#define CFE_ES_PERF_LATMRKCMD_EID    93
+
+/** \brief <tt> 'Performance Latency Marker Cmd Error,Slot(\%d) or marker(\%u) out of range(\%d,\%d)' </tt>
+**  \event <tt> 'Performance Latency Marker Cmd Error,Slot(\%d) or marker(\%u) out of range(\%d,\%d)' </tt>
+**
+**  \par Type: ERROR
+**
+**  \par Cause:
+**
+**  This event message is generated when an Executive Services
+**  \link #CFE_ES_PERF_SETLATMARKER_CC Set Performance Analyzer Latency Marker Command \endlink
+**  names a latency slot not below #CFE_ES_PERF_LATENCY_SLOTS, or a marker not below
+**  #CFE_ES_PERF_MAX_IDS that is not #CFE_ES_PERF_NO_MARKER.
+**/
+#define CFE_ES_PERF_LATMRKERR_EID    94
+
+/** \brief <tt> 'Cannot stream performance data,Error creating child task RC=0x\%08X' </tt>
+**  \event <tt> 'Cannot stream performance data,Error creating child task RC=0x\%08X' </tt>
+**
+**  \par Type: ERROR
+**
+**  \par Cause:
+**
+**  This event message is generated when an Executive Services
+**  \link #CFE_ES_PERF_STARTDATA_CC Start Performance Analyzer Command \endlink
+**  in STREAM mode cannot create the child task that sends the stream packets.
+**  Collection is not started.
+**
+**  The \c 'RC' field is the error code returned by #CFE_ES_CreateChildTask.
+**/
+#define CFE_ES_PERF_STREAM_ERR_EID   95
+
 
 
 #endif /* _cfe_es_events_ */
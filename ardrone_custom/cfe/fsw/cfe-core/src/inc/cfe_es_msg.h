@@ -691,6 +691,11 @@
 **  \par Description
 **       This command causes the Performance Analyzer to begin collecting data using the specified trigger mode.
 **
+**       Trigger mode 3 (STREAM) collects without stopping.  A low priority child task
+**       sends the entries added every #CFE_ES_PERF_STREAM_MS_DELAY milliseconds in
+**       #CFE_ES_PerfStreamPacket_t packets, and measures the latency of the markers
+**       set with #CFE_ES_PERF_SETLATMARKER_CC for housekeeping.
+**
 **  \cfecmdmnemonic \ES_STARTLADATA
 **
 **  \par Command Structure
@@ -705,7 +710,7 @@
 **         either WAITING FOR TRIGGER or, if conditions are appropriate fast enough,
 **         TRIGGERED.
 **       - \b \c \ES_PERFMODE - Performance Analyzer Mode will change to the commanded trigger mode (TRIGGER START, 
-**         TRIGGER CENTER, or TRIGGER END).
+**         TRIGGER CENTER, TRIGGER END or STREAM).
 **       - \b \c \ES_PERFTRIGCNT - Performance Trigger Count will go to zero
 **       - \b \c \ES_PERFDATASTART - Data Start Index will go to zero
 **       - \b \c \ES_PERFDATAEND - Data End Index will go to zero
@@ -726,9 +731,12 @@
 **
 **  \par Criticality
 **       This command is not inherently dangerous but may cause a small increase in CPU
-**       utilization as the performance analyzer data is collected.
+**       utilization as the performance analyzer data is collected.  In STREAM mode an
+**       additional low priority child task is spawned, and the stream packets add to
+**       the telemetry sent.
 **
-**  \sa #CFE_ES_PERF_STOPDATA_CC, #CFE_ES_PERF_SETFILTERMASK_CC, #CFE_ES_PERF_SETTRIGMASK_CC
+**  \sa #CFE_ES_PERF_STOPDATA_CC, #CFE_ES_PERF_SETFILTERMASK_CC, #CFE_ES_PERF_SETTRIGMASK_CC,
+**      #CFE_ES_PERF_SETLATMARKER_CC
 */
 #define CFE_ES_PERF_STARTDATA_CC      14  
 
@@ -1141,6 +1149,48 @@
 */
 #define CFE_ES_QUERY_ALL_TASKS_CC     24
 
+/** \cfeescmd Set Performance Analyzer's Latency Marker
+**
+**  \par Description
+**       This command sets the performance marker whose entry to exit latency one of the
+**       #CFE_ES_PERF_LATENCY_SLOTS latency slots measures while the Performance Analyzer
+**       collects in STREAM mode.  Each exit of the marker is paired with its last entry.
+**       The measurements of the slot start over.  A marker of #CFE_ES_PERF_NO_MARKER
+**       leaves the slot unused.
+**
+**  \cfecmdmnemonic \ES_LALATENCYMARKER
+**
+**  \par Command Structure
+**       #CFE_ES_PerfSetLatMarkerCmd_t
+**
+**  \par Command Verification
+**       Successful execution of this command may be verified with 
+**       the following telemetry:
+**       - \b \c \ES_CMDPC - command execution counter will 
+**         increment
+**       - \b \c \ES_PERFLATENCY - the marker of the commanded slot will change
+**         and its counts will go to zero
+**       - The #CFE_ES_PERF_LATMRKCMD_EID debug event message will be 
+**         generated.
+**
+**  \par Error Conditions
+**       This command may fail for the following reason(s):
+**       - The command packet length is incorrect
+**       - The latency slot is out of range
+**       - The marker is out of range
+**
+**       Evidence of failure may be found in the following telemetry:
+**       - \b \c \ES_CMDEC - command error counter will increment
+**       - A command specific error event message is issued for all error 
+**         cases
+**
+**  \par Criticality
+**       This command is not inherently dangerous.
+**
+**  \sa #CFE_ES_PERF_STARTDATA_CC, #CFE_ES_PERF_STOPDATA_CC
+*/
+#define CFE_ES_PERF_SETLATMARKER_CC   25
+
 
 /** \} */
 
@@ -1470,6 +1520,30 @@ typedef struct
     CFE_ES_PerfSetTrigMaskCmd_Payload_t Payload;
 } CFE_ES_PerfSetTrigMaskCmd_t;
 
+/**
+** \brief Marker value that leaves a performance latency slot unused
+**/
+#define CFE_ES_PERF_NO_MARKER   0xFFFFFFFF
+
+/**
+** \brief Set Performance Analyzer Latency Marker Command
+**
+** For command details, see #CFE_ES_PERF_SETLATMARKER_CC
+**
+**/
+typedef struct
+{
+  uint32                LatencySlot;                    /**< \brief Index into array of Latency Slots */
+  uint32                Marker;                         /**< \brief Performance marker to measure, or #CFE_ES_PERF_NO_MARKER */
+
+} CFE_ES_PerfSetLatMarkerCmd_Payload_t;
+
+typedef struct
+{
+    uint8                                CmdHeader[CFE_SB_CMD_HDR_SIZE];    /**< \brief cFE Software Bus Command Message Header */
+    CFE_ES_PerfSetLatMarkerCmd_Payload_t Payload;
+} CFE_ES_PerfSetLatMarkerCmd_t;
+
 /**
 ** \brief Telemeter Memory Pool Statistics Command
 **
@@ -1545,6 +1619,23 @@ typedef struct
 
 /*************************************************************************/
 
+/**
+** \brief Entry to exit latency of one performance marker, in microseconds
+**
+** Measured while the Performance Analyzer collects in STREAM mode, since the
+** collection started or the marker was set.  The 99th percentile is the top
+** of the histogram bucket it falls in, so may be high by up to a quarter.
+**/
+typedef struct
+{
+  uint32                Marker;     /**< \brief Performance marker measured, or #CFE_ES_PERF_NO_MARKER */
+  uint32                Count;      /**< \brief Number of entry to exit pairs measured */
+  uint32                MinTime;    /**< \brief Shortest latency */
+  uint32                MaxTime;    /**< \brief Longest latency */
+  uint32                MeanTime;   /**< \brief Mean latency */
+  uint32                P99Time;    /**< \brief 99th percentile latency */
+} CFE_ES_PerfLatency_t;
+
 /** 
 **  \cfeestlm Executive Services Housekeeping Packet
 **/
@@ -1632,6 +1723,12 @@ typedef struct
                                               \brief Number of free blocks remaining in the OS heap */
   uint32                HeapMaxBlockSize;  /**< \cfetlmmnemonic \ES_HEAPMAXBLK
                                               \brief Number of bytes in the largest free block */
+  uint32                PerfStreamPackets; /**< \cfetlmmnemonic \ES_PERFSTRMPKTS
+                                              \brief Number of Performance Analyzer Stream Packets Sent */
+  uint32                PerfStreamLost;    /**< \cfetlmmnemonic \ES_PERFSTRMLOST
+                                              \brief Number of Performance Analyzer Log Entries Overwritten Before They Were Streamed */
+  CFE_ES_PerfLatency_t  PerfLatency[CFE_ES_PERF_LATENCY_SLOTS]; /**< \cfetlmmnemonic \ES_PERFLATENCY
+                                                                     \brief Latency of the Markers Set in the Performance Analyzer Latency Slots */
 } CFE_ES_HkPacket_Payload_t;
 
 typedef struct
@@ -1641,6 +1738,39 @@ typedef struct
   
 } CFE_ES_HkPacket_t;
 
+/**
+** \brief Performance Analyzer Stream Entry, as kept in the performance log
+**/
+typedef struct
+{
+  uint32                Data;           /**< \brief Marker, with the top bit set for an exit */
+  uint32                TimerUpper32;   /**< \brief Upper 32 bits of the timebase */
+  uint32                TimerLower32;   /**< \brief Lower 32 bits of the timebase */
+} CFE_ES_PerfStreamEntry_t;
+
+/** 
+**  \cfeestlm Performance Analyzer Stream Packet
+**
+**  Sent while the Performance Analyzer collects in STREAM mode.  Each packet holds
+**  entries of one ring, in the order they were added; entries of different rings
+**  are merged on their time.  Only EntryCount entries are sent.
+**/
+typedef struct
+{
+  uint32                    Generation;  /**< \brief Collection the entries belong to, changes with each start */
+  uint32                    Ring;        /**< \brief Ring the entries were added to */
+  uint32                    FirstEntry;  /**< \brief Number of entries added to the ring before the first one sent */
+  uint32                    Lost;        /**< \brief Entries of the ring overwritten before they were sent */
+  uint32                    EntryCount;  /**< \brief Number of entries sent */
+  CFE_ES_PerfStreamEntry_t  Entry[CFE_ES_PERF_STREAM_PKT_ENTRIES];  /**< \brief Entries sent */
+} CFE_ES_PerfStreamPacket_Payload_t;
+
+typedef struct
+{
+    uint8                               TlmHeader[CFE_SB_TLM_HDR_SIZE]; /**< \brief cFE Software Bus Telemetry Message Header */
+    CFE_ES_PerfStreamPacket_Payload_t   Payload;
+} CFE_ES_PerfStreamPacket_t;
+
 /** 
 **  \cfeestlm OS Shell Output Packet
 **/
@@ -253,6 +253,10 @@ int32 CFE_EVS_Unregister( void );
 **                               floating point arithmetic.  Do not use non-printable characters (\\t, \\n, etc.) 
 **                               in the format string; they will mess up the formatting when the events are 
 **                               displayed on the ground system.
+**                               In #CFE_EVS_DEFERRED_FORMAT the format string is looked up by its address 
+**                               and formatted after the call returns, so it must be a string constant that 
+**                               is not changed or freed while the application runs.  Pass variable text 
+**                               through a "%s" conversion rather than as the format string.
 **
 ** \returns
 ** \retcode #CFE_SUCCESS                   \retdesc   \copydoc CFE_SUCCESS                    \endcode
@@ -304,6 +308,10 @@ int32 CFE_EVS_SendEvent (uint16 EventID,
 **                               floating point arithmetic.  Do not use non-printable characters (\\t, \\n, etc.) 
 **                               in the format string; they will mess up the formatting when the events are 
 **                               displayed on the ground system.
+**                               In #CFE_EVS_DEFERRED_FORMAT the format string is looked up by its address 
+**                               and formatted after the call returns, so it must be a string constant that 
+**                               is not changed or freed while the application runs.  Pass variable text 
+**                               through a "%s" conversion rather than as the format string.
 **
 ** \returns
 ** \retcode #CFE_SUCCESS                  \retdesc  \copydoc CFE_SUCCESS                 \endcode
@@ -356,6 +364,10 @@ int32 CFE_EVS_SendEventWithAppID (uint16 EventID,
 **                               floating point arithmetic.  Do not use non-printable characters (\\t, \\n, etc.) 
 **                               in the format string; they will mess up the formatting when the events are 
 **                               displayed on the ground system.
+**                               In #CFE_EVS_DEFERRED_FORMAT the format string is looked up by its address 
+**                               and formatted after the call returns, so it must be a string constant that 
+**                               is not changed or freed while the application runs.  Pass variable text 
+**                               through a "%s" conversion rather than as the format string.
 **
 ** \returns
 ** \retcode #CFE_SUCCESS                   \retdesc   \copydoc CFE_SUCCESS                 \endcode
@@ -261,6 +261,10 @@
 **  definitions.  The short event format is used to accommodate experiences 
 **  with limited telemetry bandwidth.  The long event format includes all event
 **  information included within the short format along with the Event Data.
+**  The deferred event format sends #CFE_EVS_DeferredPacket_t packets instead,
+**  carrying a hash of the event's format string and its raw arguments, and
+**  leaves formatting the Event Data to whoever needs the text: the output
+**  ports, the event log file and the ground.
 **
 **  \cfecmdmnemonic \EVS_SETEVTFMT
 **
@@ -931,6 +935,13 @@
 /* Event Message Format Modes */
 #define CFE_EVS_SHORT_FORMAT            0
 #define CFE_EVS_LONG_FORMAT             1
+#define CFE_EVS_DEFERRED_FORMAT         2
+
+/* Deferred event packet flags */
+#define CFE_EVS_DEFERRED_TRUNCATED      0x01
+
+/* Deferred event argument data, sized so the packet is the size of CFE_EVS_Packet_t */
+#define CFE_EVS_DEFERRED_ARG_LENGTH     (CFE_EVS_MAX_MESSAGE_LENGTH - 6)
 
 /* Event Type bit masks */
 #define CFE_EVS_DEBUG_BIT               0x0001
@@ -1106,7 +1117,7 @@ typedef struct {
    uint8                 CommandErrCounter;                 /**< \cfetlmmnemonic \EVS_CMDEC
                                                                  \brief EVS Command Error Counter */
    uint8                 MessageFormatMode;                 /**< \cfetlmmnemonic \EVS_MSGFMTMODE
-                                                                 \brief Event message format mode (short/long) */
+                                                                 \brief Event message format mode (short/long/deferred) */
    uint8                 MessageTruncCounter;               /**< \cfetlmmnemonic \EVS_MSGTRUNC
                                                                  \brief Event message truncation counter */
    
@@ -1179,6 +1190,37 @@ typedef struct {
 } CFE_EVS_Packet_t;
 
 
+/** 
+**  \cfeevstlm Deferred Format Event Message Telemetry Packet
+**
+**  Sent in place of #CFE_EVS_Packet_t in the #CFE_EVS_DEFERRED_FORMAT mode.
+**  The event's format string is identified by SpecHash, the 32 bit FNV-1a hash
+**  of the string without its terminator.  ArgData holds the arguments in the
+**  order the format string uses them, a '*' width or precision included, in
+**  the processor's byte order: integers, characters and pointers as 8 byte
+**  integers, floating point values as 8 byte doubles and strings as zero
+**  terminated text.  The packet is only as long as the arguments it holds.
+**/
+typedef struct {
+   CFE_EVS_PacketID_t        PacketID;                              /**< \brief Event packet information */
+   uint32                    SpecHash;                              /**< \cfetlmmnemonic \EVS_SPECHASH
+                                                                         \brief Hash of the event format string */
+   uint16                    ArgLength;                             /**< \cfetlmmnemonic \EVS_ARGLENGTH
+                                                                         \brief Bytes of argument data */
+   uint8                     Flags;                                 /**< \cfetlmmnemonic \EVS_DEFFLAGS
+                                                                         \brief Arguments truncated (#CFE_EVS_DEFERRED_TRUNCATED) */
+   uint8                     Spare;                                 /**< \cfetlmmnemonic \EVS_DEFSPARE
+                                                                         \brief Structure padding */
+   uint8                     ArgData[CFE_EVS_DEFERRED_ARG_LENGTH];  /**< \cfetlmmnemonic \EVS_ARGDATA
+                                                                         \brief Event format arguments */
+} CFE_EVS_DeferredPacket_Payload_t;
+
+typedef struct {
+   uint8                            TlmHeader[CFE_SB_TLM_HDR_SIZE];
+   CFE_EVS_DeferredPacket_Payload_t Payload;
+} CFE_EVS_DeferredPacket_t;
+
+
 #define CFE_EVS_HK_TLM_LNGTH  sizeof(CFE_EVS_TlmPkt_t)
 
 
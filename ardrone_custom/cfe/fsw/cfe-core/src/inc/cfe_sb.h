@@ -85,6 +85,8 @@
 #define CFE_SB_SUB_ENTRIES_PER_PKT      20     /**< \brief Configuration parameter used by SBN App */
 #define CFE_SB_SUBSCRIPTION             0      /**< \brief Subtype specifier used in #CFE_SB_SubRprtMsg_t by SBN App */
 #define CFE_SB_UNSUBSCRIPTION           1      /**< \brief Subtype specified used in #CFE_SB_SubRprtMsg_t by SBN App */
+#define CFE_SB_PIPE_QUEUE_OS            0      /**< \brief Option used with #CFE_SB_CreatePipeEx for a pipe on an OS message queue */
+#define CFE_SB_PIPE_QUEUE_RING          1      /**< \brief Option used with #CFE_SB_CreatePipeEx for a pipe on an in-process queue */
 
 /*
 ** Macro Definitions
@@ -208,7 +210,8 @@ typedef struct {
 **          this pipe.
 **
 ** \par Assumptions, External Events, and Notes:
-**          None
+**          The pipe is backed by the kind of queue #CFE_SB_DEFAULT_PIPE_QUEUE
+**          names, see #CFE_SB_CreatePipeEx.
 **
 ** \param[in]  PipeIdPtr    A pointer to a variable of type #CFE_SB_PipeId_t, 
 **                          which will be filled in with the pipe ID information 
@@ -230,12 +233,59 @@ typedef struct {
 ** \retcode #CFE_SB_PIPE_CR_ERR    \retdesc \copydoc CFE_SB_PIPE_CR_ERR   \endcode
 ** \endreturns
 **
-** \sa #CFE_SB_DeletePipe
+** \sa #CFE_SB_DeletePipe, #CFE_SB_CreatePipeEx
 **/
 int32  CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr,
                          uint16  Depth,
                          const char *PipeName);
 
+/*****************************************************************************/
+/** 
+** \brief Creates a new software bus pipe on a chosen kind of queue.
+**
+** \par Description
+**          This routine is the same as #CFE_SB_CreatePipe, but the caller says
+**          what kind of queue the pipe is built on rather than taking the
+**          platform default.
+**
+** \par Assumptions, External Events, and Notes:
+**          #CFE_SB_PIPE_QUEUE_OS puts the pipe on an OS message queue, so every
+**          message sent to it and received from it is a system call.
+**          #CFE_SB_PIPE_QUEUE_RING puts it on a queue in the cFE's own memory,
+**          which only calls on the OS to wake the pipe owner when it is waiting
+**          in #CFE_SB_RcvMsg.  Receive timeouts and pend forever behave the same
+**          on both.  An OSAL without an in-process queue uses its OS queue for
+**          both.
+**
+** \param[in]  PipeIdPtr    A pointer to a variable of type #CFE_SB_PipeId_t, 
+**                          which will be filled in with the pipe ID information 
+**                          by the #CFE_SB_CreatePipeEx routine. 
+**
+** \param[in]  Depth        The maximum number of messages that will be allowed on 
+**                          this pipe at one time. 
+**
+** \param[in]  PipeName     A string to be used to identify this pipe in error messages 
+**                          and routing information telemetry.  The string must be no 
+**                          longer than #OS_MAX_API_NAME.  Longer strings will be truncated. 
+**
+** \param[in]  QueueType    #CFE_SB_PIPE_QUEUE_OS or #CFE_SB_PIPE_QUEUE_RING.
+**
+** \param[out] *PipeIdPtr   The identifier for the created pipe. 
+**
+** \returns
+** \retcode #CFE_SUCCESS           \retdesc \copydoc CFE_SUCCESS          \endcode
+** \retcode #CFE_SB_BAD_ARGUMENT   \retdesc \copydoc CFE_SB_BAD_ARGUMENT  \endcode
+** \retcode #CFE_SB_MAX_PIPES_MET  \retdesc \copydoc CFE_SB_MAX_PIPES_MET \endcode
+** \retcode #CFE_SB_PIPE_CR_ERR    \retdesc \copydoc CFE_SB_PIPE_CR_ERR   \endcode
+** \endreturns
+**
+** \sa #CFE_SB_CreatePipe, #CFE_SB_DeletePipe
+**/
+int32  CFE_SB_CreatePipeEx(CFE_SB_PipeId_t *PipeIdPtr,
+                           uint16  Depth,
+                           const char *PipeName,
+                           uint8   QueueType);
+
 /*****************************************************************************/
 /** 
 ** \brief Delete a software bus pipe.
@@ -542,12 +592,69 @@ int32  CFE_SB_PassMsg(CFE_SB_Msg_t   *MsgPtr);
 ** \retcode #CFE_SB_NO_MESSAGE      \retdesc  \copydoc CFE_SB_NO_MESSAGE    \endcode
 ** \endreturns
 **
-** \sa #CFE_SB_SendMsg, #CFE_SB_ZeroCopySend
+** \sa #CFE_SB_SendMsg, #CFE_SB_ZeroCopySend, #CFE_SB_RcvMsgBatch
 **/
 int32  CFE_SB_RcvMsg(CFE_SB_MsgPtr_t  *BufPtr,
                      CFE_SB_PipeId_t  PipeId,
                      int32            TimeOut);
 
+/*****************************************************************************/
+/** 
+** \brief Receive several messages from a software bus pipe at once
+**
+** \par Description
+**          This routine retrieves up to MaxCount messages from the specified pipe.
+**          If the pipe is empty, this routine will block until either a new 
+**          message comes in or the timeout value is reached, then returns that
+**          message together with any others already in the pipe.  The messages
+**          of the previous receive on the pipe are released together.
+**
+** \par Assumptions, External Events, and Notes:
+**          - Messages are returned in the order they were sent to the pipe.
+**          - MaxCount larger than #CFE_SB_MAX_RCV_BATCH is treated as
+**            #CFE_SB_MAX_RCV_BATCH, the rest of the messages stay in the pipe.
+**          - #CFE_SB_GetLastSenderId reports the sender of the last message of
+**            the batch.
+**          - If an error occurs in this API, *CountPtr is zero and the contents
+**            of BufPtrs are not defined.
+**
+** \param[in]  BufPtrs      An array of at least MaxCount #CFE_SB_MsgPtr_t, each
+**                          set to a message on return.  These should be used as
+**                          read-only pointers, and are valid only until the next call
+**                          to #CFE_SB_RcvMsg or #CFE_SB_RcvMsgBatch for the same pipe.
+**
+** \param[in]  MaxCount     The most messages to return, at least 1.
+**
+** \param[in]  CountPtr     A pointer to a variable that will hold the number of
+**                          messages returned.
+**
+** \param[in]  PipeId       The pipe ID of the pipe containing the messages to be obtained. 
+**
+** \param[in]  TimeOut      The number of milliseconds to wait for a new message if the
+**                          pipe is empty at the time of the call.  This can also be set
+**                          to #CFE_SB_POLL for a non-blocking receive or 
+**                          #CFE_SB_PEND_FOREVER to wait forever for a message to arrive.
+**
+** \param[out] *BufPtrs     Pointers to the messages obtained from the pipe.
+**
+** \param[out] *CountPtr    The number of messages in BufPtrs, 1 to MaxCount on success.
+**
+** \returns
+** \retcode #CFE_SUCCESS            \retdesc  \copydoc CFE_SUCCESS          \endcode
+** \retcode #CFE_SB_BAD_ARGUMENT    \retdesc  \copydoc CFE_SB_BAD_ARGUMENT  \endcode
+** \retcode #CFE_SB_TIME_OUT        \retdesc  \copydoc CFE_SB_TIME_OUT      \endcode
+** \retcode #CFE_SB_PIPE_RD_ERR     \retdesc  \copydoc CFE_SB_PIPE_RD_ERR   \endcode
+** \retcode #CFE_SB_NO_MESSAGE      \retdesc  \copydoc CFE_SB_NO_MESSAGE    \endcode
+** \endreturns
+**
+** \sa #CFE_SB_RcvMsg
+**/
+int32  CFE_SB_RcvMsgBatch(CFE_SB_MsgPtr_t  *BufPtrs,
+                          uint32           MaxCount,
+                          uint32           *CountPtr,
+                          CFE_SB_PipeId_t  PipeId,
+                          int32            TimeOut);
+
 /*****************************************************************************/
 /** 
 ** \brief Retrieve the application Info of the sender for the last message.
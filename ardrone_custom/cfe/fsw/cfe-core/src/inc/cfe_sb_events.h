@@ -80,8 +80,8 @@
 **/
 #define CFE_SB_INIT_EID                 1
 
-/** \brief <tt> 'CreatePipeErr:Bad Input Arg:app=\%s,ptr=0x\%x,depth=\%d,maxdepth=\%d' </tt>
-**  \event <tt> 'CreatePipeErr:Bad Input Arg:app=\%s,ptr=0x\%x,depth=\%d,maxdepth=\%d' </tt>
+/** \brief <tt> 'CreatePipeErr:Bad Input Arg:app=\%s,ptr=0x\%x,depth=\%d,maxdepth=\%d,queue=\%d' </tt>
+**  \event <tt> 'CreatePipeErr:Bad Input Arg:app=\%s,ptr=0x\%x,depth=\%d,maxdepth=\%d,queue=\%d' </tt>
 **
 **  \par Type: ERROR
 **
@@ -89,7 +89,9 @@
 **
 **  This error event message is issued when the #CFE_SB_CreatePipe API receives a bad
 **  argument. In this case, a bad argument is defined by the following:
-**  A NULL PipeIdPtr, PipeDepth = 0 and PipeDepth > cfg param #CFE_SB_MAX_PIPE_DEPTH
+**  A NULL PipeIdPtr, PipeDepth = 0 and PipeDepth > cfg param #CFE_SB_MAX_PIPE_DEPTH,
+**  or a QueueType given to #CFE_SB_CreatePipeEx that is not a #CFE_SB_PIPE_QUEUE_OS
+**  or #CFE_SB_PIPE_QUEUE_RING
 **/
 #define CFE_SB_CR_PIPE_BAD_ARG_EID      2
 
@@ -789,6 +791,19 @@
 **/
 #define CFE_SB_DEL_PIPE_ERR2_EID        54
 
+/** \brief <tt> 'Rcv Batch Err:Bad Input Arg:BufPtrs 0x\%lx,CountPtr 0x\%lx,max \%u,pipe \%d,t/o \%d,app \%s' </tt>
+**  \event <tt> 'Rcv Batch Err:Bad Input Arg:BufPtrs 0x\%lx,CountPtr 0x\%lx,max \%u,pipe \%d,t/o \%d,app \%s' </tt>
+**
+**  \par Type: ERROR
+**
+**  \par Cause:
+**
+**  This error event message is issued when an invalid parameter is passed into the
+**  #CFE_SB_RcvMsgBatch API. Possible problems are a NULL BufPtrs or CountPtr, a
+**  MaxCount of zero or the TimeOut parameter being less than -1.
+**/
+#define CFE_SB_RCV_BATCH_BAD_ARG_EID    55
+
 
 #endif /* _cfe_sb_events_ */
 
@@ -666,6 +666,15 @@ typedef struct {
                                                  \brief cFE Cfg Param \link #CFE_SB_MAX_PIPE_DEPTH \endlink */
     CFE_SB_PipeDepthStats_t PipeDepthStats[CFE_SB_MAX_PIPES];/**< \cfetlmmnemonic \SB_SMPDS
                                                                   \brief Pipe Depth Statistics #CFE_SB_PipeDepthStats_t*/
+
+    uint32              BufCacheHits;/**< \cfetlmmnemonic \SB_SMBCHIT
+                                          \brief Number of SB message buffers reused from the buffer cache */
+    uint32              BufCacheMisses;/**< \cfetlmmnemonic \SB_SMBCMISS
+                                            \brief Number of SB message buffers taken from the memory pool */
+    uint32              BufCacheInUse;/**< \cfetlmmnemonic \SB_SMBCIU
+                                           \brief Number of free SB message buffers held in the buffer cache */
+    uint32              PeakBufCacheInUse;/**< \cfetlmmnemonic \SB_SMPBCIU
+                                               \brief Max number of free SB message buffers held in the buffer cache */
 } CFE_SB_StatMsg_Payload_t;
 
 typedef struct{
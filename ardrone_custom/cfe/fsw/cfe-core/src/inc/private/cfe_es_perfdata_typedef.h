@@ -24,6 +24,7 @@
 #include "cfe_platform_cfg.h"  /* Required for CFE_ES_PERF_MAX_IDS */
 
 #define CFE_ES_PERF_32BIT_WORDS_IN_MASK ((CFE_ES_PERF_MAX_IDS) / 32)
+#define CFE_ES_PERF_RING_SIZE ((CFE_ES_PERF_DATA_BUFFER_SIZE) / (CFE_ES_PERF_DATA_RINGS))
 
 
 typedef struct {
@@ -50,9 +51,27 @@ typedef struct {
     uint32                         TriggerMask[CFE_ES_PERF_32BIT_WORDS_IN_MASK];
 } CFE_ES_PerfMetaData_t;
 
+/*
+** Ring N holds its entries in DataBuffer from N * CFE_ES_PERF_RING_SIZE on.
+** Only the task holding Owner writes the ring.  The ring is padded out to
+** its own cache line so tasks on different rings do not share one.
+*/
+typedef struct {
+    uint32         Owner;          /* nonzero while a task adds an entry */
+    uint32         Generation;     /* collection the entries belong to */
+    uint32         Next;           /* index of the next entry to write */
+    uint32         Count;          /* entries held, up to CFE_ES_PERF_RING_SIZE */
+    uint32         TriggerCount;   /* entries added after the trigger */
+    uint32         Added;          /* entries added, set once each entry is written */
+    uint32         Spare[10];
+} CFE_ES_PerfRing_t;
+
 typedef struct {
     CFE_ES_PerfMetaData_t          MetaData;
     CFE_ES_PerfDataEntry_t         DataBuffer[CFE_ES_PERF_DATA_BUFFER_SIZE];
+    uint32                         Generation;  /* bumped by each start of collection */
+    uint32                         LostCount;   /* entries dropped because every ring was busy */
+    CFE_ES_PerfRing_t              Ring[CFE_ES_PERF_DATA_RINGS];
 } CFE_ES_PerfData_t;
 
 
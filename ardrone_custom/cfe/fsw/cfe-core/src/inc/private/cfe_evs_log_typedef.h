@@ -27,6 +27,10 @@
 /*
 ** \brief  EVS Log type definition. This is declared here so ES can include it
 **  in the reset area structure
+**
+**  Senders add entries without a lock: each takes the next ticket, writes
+**  entry (ticket / 2) % CFE_EVS_LOG_MAX and then marks it added in
+**  EntryTicket.  Next, LogCount and LogFullFlag follow from the tickets.
 */
 typedef struct {
     uint16 Next;                              /**< \brief Index of the next entry in the local event log */
@@ -34,6 +38,9 @@ typedef struct {
     uint8  LogFullFlag;                       /**< \brief Local Event Log full flag */
     uint8  LogMode;                           /**< \brief Local Event Logging mode (overwrite/discard) */
     uint16 LogOverflowCounter;                /**< \brief Local Event Log overflow counter */
+    uint32 Ticket;                            /**< \brief Ticket of the next entry added, counts in twos */
+    uint32 FirstTicket;                       /**< \brief Ticket of the first entry added since the log was cleared */
+    uint32 EntryTicket[CFE_EVS_LOG_MAX];      /**< \brief Ticket of each entry plus one while it is written, plus two once added */
     CFE_EVS_Packet_t LogEntry[CFE_EVS_LOG_MAX];/**< \brief The actual Local Event Log entry */
 
 } CFE_EVS_Log_t;
@@ -220,6 +220,18 @@ extern int32 CFE_TBL_CleanUpApp(uint32 AppId);
 ******************************************************************************/
 extern int32 CFE_SB_CleanUpApp(uint32 AppId);
 
+/*****************************************************************************/
+/**
+** \brief Caches the sender information of the calling task
+**
+** \par Description
+**        This function is called by cFE Executive Services when a task
+**        registers.  It looks up the app.tsk name and processor id that SB
+**        reports as the sender of the task's messages.
+**
+******************************************************************************/
+extern void CFE_SB_RegisterSender(void);
+
 /*****************************************************************************/
 /**
 ** \brief Removes EVS resources associated with specified Application
@@ -143,6 +143,38 @@
 /******************************************************************************
 ** Name:    CFE_SB_CreatePipe
 **
+** Purpose: API to create a pipe for receiving messages, backed by the queue
+**          the platform configuration asks for
+**
+** Assumptions, External Events, and Notes:
+**
+**          Note: Zero is a valid PipeId
+**
+** Inputs:
+**          PipeIdPtr - Ptr to users empty PipeId variable, to be filled by
+**                      this function.
+**          Depth     - The depth of the pipe, synonymous to the max number
+**                      of messages the pipe can hold at any time.
+**          PipeName  - The name of the pipe displayed in event messages
+**
+** Outputs:
+**          PipeId    - The handle of the pipe to be used when receiving
+**                      messages.
+**
+** Return Values:
+**          Status
+**
+******************************************************************************/
+int32  CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16  Depth, const char *PipeName)
+{
+    return CFE_SB_CreatePipeEx(PipeIdPtr, Depth, PipeName, CFE_SB_DEFAULT_PIPE_QUEUE);
+
+}/* end CFE_SB_CreatePipe */
+
+
+/******************************************************************************
+** Name:    CFE_SB_CreatePipeEx
+**
 ** Purpose: API to create a pipe for receiving messages
 **
 ** Assumptions, External Events, and Notes:
@@ -158,6 +190,8 @@
 **          Depth     - The depth of the pipe, synonymous to the max number
 **                      of messages the pipe can hold at any time.
 **          PipeName  - The name of the pipe displayed in event messages
+**          QueueType - CFE_SB_PIPE_QUEUE_OS or CFE_SB_PIPE_QUEUE_RING, the
+**                      kind of OS queue behind the pipe
 **
 ** Outputs:
 **          PipeId    - The handle of the pipe to be used when receiving
@@ -167,7 +201,8 @@
 **          Status
 **
 ******************************************************************************/
-int32  CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16  Depth, const char *PipeName)
+int32  CFE_SB_CreatePipeEx(CFE_SB_PipeId_t *PipeIdPtr, uint16  Depth, const char *PipeName,
+                           uint8 QueueType)
 {
     uint32          AppId = 0xFFFFFFFF;
     uint32          TskId = 0;
@@ -188,12 +223,14 @@ int32  CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16  Depth, const char *
     }/* end if */
 
     /* check input parameters */
-    if((PipeIdPtr == NULL)||(Depth > CFE_SB_MAX_PIPE_DEPTH)||(Depth == 0)){
+    if((PipeIdPtr == NULL)||(Depth > CFE_SB_MAX_PIPE_DEPTH)||(Depth == 0)||
+       ((QueueType != CFE_SB_PIPE_QUEUE_OS)&&(QueueType != CFE_SB_PIPE_QUEUE_RING))){
         CFE_SB.HKTlmMsg.Payload.CreatePipeErrCnt++;
         CFE_SB_UnlockSharedData(__func__,__LINE__);
         CFE_EVS_SendEventWithAppID(CFE_SB_CR_PIPE_BAD_ARG_EID,CFE_EVS_ERROR,CFE_SB.AppId,
-          "CreatePipeErr:Bad Input Arg:app=%s,ptr=0x%lx,depth=%d,maxdepth=%d",
-                CFE_SB_GetAppTskName(TskId,FullName),(unsigned long)PipeIdPtr,Depth,CFE_SB_MAX_PIPE_DEPTH);
+          "CreatePipeErr:Bad Input Arg:app=%s,ptr=0x%lx,depth=%d,maxdepth=%d,queue=%d",
+                CFE_SB_GetAppTskName(TskId,FullName),(unsigned long)PipeIdPtr,Depth,CFE_SB_MAX_PIPE_DEPTH,
+                QueueType);
         return CFE_SB_BAD_ARGUMENT;
     }/*end if*/
 
@@ -210,7 +247,8 @@ int32  CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16  Depth, const char *
     }/* end if */
 
     /* create the queue */
-    Status = OS_QueueCreate(&SysQueueId,PipeName,Depth,sizeof(CFE_SB_BufferD_t *),0);
+    Status = OS_QueueCreate(&SysQueueId,PipeName,Depth,sizeof(CFE_SB_BufferD_t *),
+                            (QueueType == CFE_SB_PIPE_QUEUE_RING) ? OS_QUEUE_RING : 0);
     if (Status != OS_SUCCESS) {
         CFE_SB_UnlockSharedData(__func__,__LINE__);
         CFE_EVS_SendEventWithAppID(CFE_SB_CR_PIPE_ERR_EID,CFE_EVS_ERROR,CFE_SB.AppId,
@@ -237,6 +275,7 @@ int32  CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16  Depth, const char *
     CFE_SB.PipeTbl[PipeTblIdx].SendErrors  = 0;
     CFE_SB.PipeTbl[PipeTblIdx].CurrentBuff = NULL;
     CFE_SB.PipeTbl[PipeTblIdx].ToTrashBuff = NULL;
+    CFE_SB.PipeBatch[PipeTblIdx].Count     = 0;
     strcpy(&CFE_SB.PipeTbl[PipeTblIdx].AppName[0],&AppName[0]);
     strncpy(&CFE_SB.PipeTbl[PipeTblIdx].PipeName[0],PipeName,OS_MAX_API_NAME);
     CFE_SB.PipeTbl[PipeTblIdx].PipeName[OS_MAX_API_NAME-1]='\0';
@@ -271,7 +310,7 @@ int32  CFE_SB_CreatePipe(CFE_SB_PipeId_t *PipeIdPtr, uint16  Depth, const char *
 
     return CFE_SUCCESS;
 
-}/* end CFE_SB_CreatePipe */
+}/* end CFE_SB_CreatePipeEx */
 
 
 /******************************************************************************
@@ -736,6 +775,9 @@ int32  CFE_SB_SubscribeFull(CFE_SB_MsgId_t   MsgId,
 
     CFE_SB.RoutingTbl[Idx].Destinations++;
 
+    /* let senders see the new destination */
+    CFE_SB_PublishRoute(Idx);
+
     CFE_SB.StatTlmMsg.Payload.SubscriptionsInUse++;
     if(CFE_SB.StatTlmMsg.Payload.SubscriptionsInUse > CFE_SB.StatTlmMsg.Payload.PeakSubscriptionsInUse)
     {
@@ -909,6 +951,7 @@ int32 CFE_SB_UnsubscribeFull(CFE_SB_MsgId_t MsgId,CFE_SB_PipeId_t PipeId,
     uint32  MatchFound = FALSE;
     int32   Stat;
     CFE_SB_DestinationD_t   *DestPtr = NULL;
+    CFE_SB_DestinationD_t   *RemovedPtr = NULL;
     char    FullName[(OS_MAX_API_NAME * 2)];
 
 
@@ -972,9 +1015,7 @@ int32 CFE_SB_UnsubscribeFull(CFE_SB_MsgId_t MsgId,CFE_SB_PipeId_t PipeId,
         if(DestPtr->PipeId == PipeId){
             /* match found, remove node from list */
             CFE_SB_RemoveDest(Idx,DestPtr);
-
-            /* return node to memory pool */
-            CFE_SB_PutDestinationBlk(DestPtr);
+            RemovedPtr = DestPtr;
 
             CFE_SB.RoutingTbl[Idx].Destinations--;
             CFE_SB.StatTlmMsg.Payload.SubscriptionsInUse--;
@@ -987,6 +1028,16 @@ int32 CFE_SB_UnsubscribeFull(CFE_SB_MsgId_t MsgId,CFE_SB_PipeId_t PipeId,
 
     }while((MatchFound == FALSE)&&(DestPtr != NULL));
 
+    if(MatchFound == TRUE){
+
+        /* senders may still hold the node until the route is republished */
+        CFE_SB_PublishRoute(Idx);
+
+        /* return node to memory pool */
+        CFE_SB_PutDestinationBlk(RemovedPtr);
+
+    }/* end if */
+
     /* if 'Destinations' was decremented to zero above... */
     if(CFE_SB.RoutingTbl[Idx].Destinations==0){
         CFE_SB.StatTlmMsg.Payload.MsgIdsInUse--;
@@ -1094,6 +1145,47 @@ int32  CFE_SB_PassMsg(CFE_SB_Msg_t    *MsgPtr)
 
 
 
+/******************************************************************************
+** Name:    CFE_SB_SendNoSubsEvent
+**
+** Purpose: Count a message sent with no subscribers and report it, unless
+**          the report would recurse.
+**
+** Assumptions, External Events, and Notes:
+**          Called without the shared data lock.
+**
+** Input Arguments:
+**          MsgId
+**          TskId - task of the sender
+**
+** Output Arguments:
+**          None
+**
+** Return Values:
+**          None
+**
+******************************************************************************/
+static void CFE_SB_SendNoSubsEvent(CFE_SB_MsgId_t MsgId, uint32 TskId)
+{
+    char    FullName[(OS_MAX_API_NAME * 2)];
+
+    CFE_SB_ATOMIC_INC(CFE_SB.HKTlmMsg.Payload.NoSubscribersCnt);
+
+    /* Determine if event can be sent without causing recursive event problem */
+    if(CFE_SB_RequestToSendEvent(TskId,CFE_SB_SEND_NO_SUBS_EID_BIT) == CFE_SB_GRANTED){
+
+       CFE_EVS_SendEventWithAppID(CFE_SB_SEND_NO_SUBS_EID,CFE_EVS_INFORMATION,CFE_SB.AppId,
+          "No subscribers for MsgId 0x%x,sender %s",
+          MsgId,CFE_SB_GetAppTskName(TskId,FullName));
+
+       /* clear the bit so the task may send this event again */
+       CFE_SB_FinishSendEvent(TskId,CFE_SB_SEND_NO_SUBS_EID_BIT);
+    }/* end if */
+
+}/* end CFE_SB_SendNoSubsEvent */
+
+
+
 /******************************************************************************
 ** Name:    CFE_SB_SendMsgFull
 **
@@ -1127,11 +1219,13 @@ int32  CFE_SB_SendMsgFull(CFE_SB_Msg_t    *MsgPtr,
     int32                   Status;
     CFE_SB_DestinationD_t   *DestPtr = NULL;
     CFE_SB_PipeD_t          *PipeDscPtr;
-    CFE_SB_RouteEntry_t     *RtgTblPtr;
+    CFE_SB_RouteSnap_t      *SnapPtr;
     CFE_SB_BufferD_t        *BufDscPtr;
     uint16                  TotalMsgSize;
     uint16                  RtgTblIdx;
+    uint16                  InUse;
     uint32                  TskId = 0;
+    uint32                  ReadToken;
     uint16                  i;
     char                    FullName[(OS_MAX_API_NAME * 2)];
     CFE_SB_EventBuf_t       SBSndErr;
@@ -1143,9 +1237,7 @@ int32  CFE_SB_SendMsgFull(CFE_SB_Msg_t    *MsgPtr,
 
     /* check input parameter */
     if(MsgPtr == NULL){
-        CFE_SB_LockSharedData(__func__,__LINE__);
-        CFE_SB.HKTlmMsg.Payload.MsgSendErrCnt++;
-        CFE_SB_UnlockSharedData(__func__,__LINE__);
+        CFE_SB_ATOMIC_INC(CFE_SB.HKTlmMsg.Payload.MsgSendErrCnt);
         CFE_EVS_SendEventWithAppID(CFE_SB_SEND_BAD_ARG_EID,CFE_EVS_ERROR,CFE_SB.AppId,
             "Send Err:Bad input argument,Arg 0x%lx,App %s",
             (unsigned long)MsgPtr,CFE_SB_GetAppTskName(TskId,FullName));
@@ -1156,14 +1248,12 @@ int32  CFE_SB_SendMsgFull(CFE_SB_Msg_t    *MsgPtr,
 
     /* validate the msgid in the message */
     if(CFE_SB_ValidateMsgId(MsgId) != CFE_SUCCESS){
-        CFE_SB_LockSharedData(__func__,__LINE__);
-        CFE_SB.HKTlmMsg.Payload.MsgSendErrCnt++;
+        CFE_SB_ATOMIC_INC(CFE_SB.HKTlmMsg.Payload.MsgSendErrCnt);
         if (CopyMode == CFE_SB_SEND_ZEROCOPY)
         {
             BufDscPtr = CFE_SB_GetBufferFromCaller(MsgId, MsgPtr);
             CFE_SB_DecrBufUseCnt(BufDscPtr);
         }
-        CFE_SB_UnlockSharedData(__func__,__LINE__);
         CFE_EVS_SendEventWithAppID(CFE_SB_SEND_INV_MSGID_EID,CFE_EVS_ERROR,CFE_SB.AppId,
             "Send Err:Invalid MsgId(0x%x)in msg,App %s",
             MsgId,CFE_SB_GetAppTskName(TskId,FullName));
@@ -1174,48 +1264,36 @@ int32  CFE_SB_SendMsgFull(CFE_SB_Msg_t    *MsgPtr,
 
     /* Verify the size of the pkt is < or = the mission defined max */
     if(TotalMsgSize > CFE_SB_MAX_SB_MSG_SIZE){
-        CFE_SB_LockSharedData(__func__,__LINE__);
-        CFE_SB.HKTlmMsg.Payload.MsgSendErrCnt++;
+        CFE_SB_ATOMIC_INC(CFE_SB.HKTlmMsg.Payload.MsgSendErrCnt);
         if (CopyMode == CFE_SB_SEND_ZEROCOPY)
         {
             BufDscPtr = CFE_SB_GetBufferFromCaller(MsgId, MsgPtr);
             CFE_SB_DecrBufUseCnt(BufDscPtr);
         }
-        CFE_SB_UnlockSharedData(__func__,__LINE__);
         CFE_EVS_SendEventWithAppID(CFE_SB_MSG_TOO_BIG_EID,CFE_EVS_ERROR,CFE_SB.AppId,
             "Send Err:Msg Too Big MsgId=0x%x,app=%s,size=%d,MaxSz=%d",
             MsgId,CFE_SB_GetAppTskName(TskId,FullName),TotalMsgSize,CFE_SB_MAX_SB_MSG_SIZE);
         return CFE_SB_MSG_TOO_BIG;
     }/* end if */
 
-    /* take semaphore to prevent a task switch during this call */
-    CFE_SB_LockSharedData(__func__,__LINE__);
-
+    /*
+    ** The shared data lock is not taken from here on.  Buffers come from a
+    ** pool with its own mutex, the destinations are read from the route
+    ** snapshot and the counters are updated atomically, so senders on
+    ** different tasks do not wait on each other or on subscribers.
+    */
     RtgTblIdx = CFE_SB_GetRoutingTblIdx(MsgId);
 
     /* if there have been no subscriptions for this pkt, */
     /* increment the dropped pkt cnt, send event and return success */
     if(RtgTblIdx == CFE_SB_AVAILABLE){
 
-        CFE_SB.HKTlmMsg.Payload.NoSubscribersCnt++;
-
         if (CopyMode == CFE_SB_SEND_ZEROCOPY){
             BufDscPtr = CFE_SB_GetBufferFromCaller(MsgId, MsgPtr);
             CFE_SB_DecrBufUseCnt(BufDscPtr);
         }
 
-        CFE_SB_UnlockSharedData(__func__,__LINE__);
-
-        /* Determine if event can be sent without causing recursive event problem */
-        if(CFE_SB_RequestToSendEvent(TskId,CFE_SB_SEND_NO_SUBS_EID_BIT) == CFE_SB_GRANTED){
-
-           CFE_EVS_SendEventWithAppID(CFE_SB_SEND_NO_SUBS_EID,CFE_EVS_INFORMATION,CFE_SB.AppId,
-              "No subscribers for MsgId 0x%x,sender %s",
-              MsgId,CFE_SB_GetAppTskName(TskId,FullName));
-
-           /* clear the bit so the task may send this event again */
-           CFE_SB_FinishSendEvent(TskId,CFE_SB_SEND_NO_SUBS_EID_BIT);
-        }/* end if */
+        CFE_SB_SendNoSubsEvent(MsgId, TskId);
 
         return CFE_SUCCESS;
     }/* end if */
@@ -1228,8 +1306,7 @@ int32  CFE_SB_SendMsgFull(CFE_SB_Msg_t    *MsgPtr,
         BufDscPtr = CFE_SB_GetBufferFromPool(MsgId, TotalMsgSize);
     }
     if (BufDscPtr == NULL){
-        CFE_SB.HKTlmMsg.Payload.MsgSendErrCnt++;
-        CFE_SB_UnlockSharedData(__func__,__LINE__);
+        CFE_SB_ATOMIC_INC(CFE_SB.HKTlmMsg.Payload.MsgSendErrCnt);
 
         /* Determine if event can be sent without causing recursive event problem */
         if(CFE_SB_RequestToSendEvent(TskId,CFE_SB_GET_BUF_ERR_EID_BIT) == CFE_SB_GRANTED){
@@ -1251,35 +1328,43 @@ int32  CFE_SB_SendMsgFull(CFE_SB_Msg_t    *MsgPtr,
         CFE_PSP_MemCpy( BufDscPtr->Buffer, MsgPtr, (uint16)TotalMsgSize );
     }
 
-    /* For Tlm packets, increment the seq count if requested */
-    if((CFE_SB_GetPktType(MsgId)==CFE_SB_TLM) &&
-       (TlmCntIncrements==CFE_SB_INCREMENT_TLM)){
-        CFE_SB.RoutingTbl[RtgTblIdx].SeqCnt++;
-        CFE_SB_SetMsgSeqCnt((CFE_SB_Msg_t *)BufDscPtr->Buffer,
-                              CFE_SB.RoutingTbl[RtgTblIdx].SeqCnt);
-    }/* end if */
-
-    /* store the sender information */
+    /* store a copy of the sender information, the task's record is rewritten */
+    /* when its task id is reused                                             */
     if(CFE_SB.SenderReporting != 0)
     {
-       BufDscPtr->Sender.ProcessorId = CFE_PSP_GetProcessorId();
-       strncpy(&BufDscPtr->Sender.AppName[0],CFE_SB_GetAppTskName(TskId,FullName),OS_MAX_API_NAME);
+       BufDscPtr->Sender = *CFE_SB_GetSenderId(TskId);
     }
+    else
+    {
+       BufDscPtr->Sender = CFE_SB.NoSender;
+    }
+
+    ReadToken = CFE_SB_RouteReadBegin(TskId);
+
+    /* the last subscriber may have gone since the routing index was read */
+    RtgTblIdx = CFE_SB_GetRoutingTblIdx(MsgId);
+    SnapPtr = CFE_SB_GetRouteSnap(MsgId);
+    if(SnapPtr == NULL){
+
+        CFE_SB_RouteReadEnd(ReadToken);
+        CFE_SB_DecrBufUseCnt(BufDscPtr);
 
-    RtgTblPtr = &CFE_SB.RoutingTbl[RtgTblIdx];
+        CFE_SB_SendNoSubsEvent(MsgId, TskId);
 
-    /* At this point there must be at least one destination for pkt */
+        return CFE_SUCCESS;
+    }/* end if */
 
-    DestPtr = RtgTblPtr -> ListHeadPtr;
+    /* For Tlm packets, increment the seq count if requested */
+    if((CFE_SB_GetPktType(MsgId)==CFE_SB_TLM) &&
+       (TlmCntIncrements==CFE_SB_INCREMENT_TLM)){
+        CFE_SB_SetMsgSeqCnt((CFE_SB_Msg_t *)BufDscPtr->Buffer,
+                            CFE_SB_ATOMIC_INC(CFE_SB.RoutingTbl[RtgTblIdx].SeqCnt));
+    }/* end if */
 
     /* Send the packet to all destinations  */
-    for (i=0; i < RtgTblPtr -> Destinations; i++) {
+    for (i=0; i < SnapPtr -> Destinations; i++) {
 
-        /* The DestPtr should never be NULL in this loop, this is just extra
-           protection in case of the unforseen */
-        if(DestPtr == NULL){
-          break;
-        }
+        DestPtr = SnapPtr -> Dest[i];
 
         if (DestPtr->Active != CFE_SB_INACTIVE)    /* destination is active */
         {
@@ -1288,62 +1373,74 @@ int32  CFE_SB_SendMsgFull(CFE_SB_Msg_t    *MsgPtr,
 
         /* if Msg limit exceeded, log event, increment counter */
         /* and go to next destination */
-        if(DestPtr->BuffCount >= DestPtr->MsgId2PipeLim){
+        if(CFE_SB_IncrBelowLimit(&DestPtr->BuffCount, DestPtr->MsgId2PipeLim) == FALSE){
 
             SBSndErr.EvtBuf[SBSndErr.EvtsToSnd].PipeId  = DestPtr->PipeId;
             SBSndErr.EvtBuf[SBSndErr.EvtsToSnd].EventId = CFE_SB_MSGID_LIM_ERR_EID;
             SBSndErr.EvtsToSnd++;
-            CFE_SB.HKTlmMsg.Payload.MsgLimErrCnt++;
-            PipeDscPtr->SendErrors++;
+            CFE_SB_ATOMIC_INC(CFE_SB.HKTlmMsg.Payload.MsgLimErrCnt);
+            CFE_SB_ATOMIC_INC(PipeDscPtr->SendErrors);
 
             }else{
         /*
-        ** Write the buffer descriptor to the queue of the pipe.  If the write
-        ** failed, log info and increment the pipe's error counter.
+        ** Count the reference before the write, the receiver may release the
+        ** buffer as soon as it is on the queue.  BuffCount was reserved above.
+        ** Both are given back if the write fails.
         */
+                CFE_SB_ATOMIC_INC(BufDscPtr->UseCount);
+                InUse = 0;
+                if (DestPtr->PipeId < CFE_SB_TLM_PIPEDEPTHSTATS_SIZE)
+                {
+                    InUse = CFE_SB_ATOMIC_INC(CFE_SB.StatTlmMsg.Payload.PipeDepthStats[DestPtr->PipeId].InUse);
+                }
+
                 Status = OS_QueuePut(PipeDscPtr->SysQueueId,(void *)&BufDscPtr,
                                      sizeof(CFE_SB_BufferD_t *),0);
 
         if (Status == OS_SUCCESS) {
-            BufDscPtr->UseCount++;    /* used for releasing buffer  */
-            DestPtr->BuffCount++; /* used for checking MsgId2PipeLimit */
-            DestPtr->DestCnt++;   /* used for statistics */
+            CFE_SB_ATOMIC_INC(DestPtr->DestCnt);   /* used for statistics */
             if (DestPtr->PipeId < CFE_SB_TLM_PIPEDEPTHSTATS_SIZE)
             {
-                CFE_SB_PipeDepthStats_t *StatObj =
-                        &CFE_SB.StatTlmMsg.Payload.PipeDepthStats[DestPtr->PipeId];
-                StatObj->InUse++;
-                if(StatObj->InUse > StatObj->PeakInUse){
-                    StatObj->PeakInUse = StatObj->InUse;
-            }/* end if */
+                CFE_SB_RaisePeak16(&CFE_SB.StatTlmMsg.Payload.PipeDepthStats[DestPtr->PipeId].PeakInUse,
+                                   InUse);
+            }
+
+        }else{
+
+            CFE_SB_DecrNonZero(&BufDscPtr->UseCount);
+            CFE_SB_DecrNonZero(&DestPtr->BuffCount);
+            if (DestPtr->PipeId < CFE_SB_TLM_PIPEDEPTHSTATS_SIZE)
+            {
+                CFE_SB_ATOMIC_DEC(CFE_SB.StatTlmMsg.Payload.PipeDepthStats[DestPtr->PipeId].InUse);
             }
 
-        }else if(Status == OS_QUEUE_FULL) {
+            if(Status == OS_QUEUE_FULL) {
 
             SBSndErr.EvtBuf[SBSndErr.EvtsToSnd].PipeId  = DestPtr->PipeId;
             SBSndErr.EvtBuf[SBSndErr.EvtsToSnd].EventId = CFE_SB_Q_FULL_ERR_EID;
             SBSndErr.EvtsToSnd++;
-            CFE_SB.HKTlmMsg.Payload.PipeOverflowErrCnt++;
-            PipeDscPtr->SendErrors++;
+            CFE_SB_ATOMIC_INC(CFE_SB.HKTlmMsg.Payload.PipeOverflowErrCnt);
+            CFE_SB_ATOMIC_INC(PipeDscPtr->SendErrors);
 
 
-        }else{ /* Unexpected error while writing to queue. */
+            }else{ /* Unexpected error while writing to queue. */
 
             SBSndErr.EvtBuf[SBSndErr.EvtsToSnd].PipeId  = DestPtr->PipeId;
             SBSndErr.EvtBuf[SBSndErr.EvtsToSnd].EventId = CFE_SB_Q_WR_ERR_EID;
             SBSndErr.EvtBuf[SBSndErr.EvtsToSnd].ErrStat = Status;
             SBSndErr.EvtsToSnd++;
-            CFE_SB.HKTlmMsg.Payload.InternalErrCnt++;
-            PipeDscPtr->SendErrors++;
+            CFE_SB_ATOMIC_INC(CFE_SB.HKTlmMsg.Payload.InternalErrCnt);
+            CFE_SB_ATOMIC_INC(PipeDscPtr->SendErrors);
 
+            }/*end if */
                 }/*end if */
             }/*end if */
         }/*end if */
 
-        DestPtr = DestPtr -> Next;
-
     } /* end loop over destinations */
 
+    CFE_SB_RouteReadEnd(ReadToken);
+
     /*
     ** Decrement the buffer UseCount and free buffer if cnt=0. This decrement is done
     ** because the use cnt is initialized to 1 in CFE_SB_GetBufferFromPool.
@@ -1353,9 +1450,6 @@ int32  CFE_SB_SendMsgFull(CFE_SB_Msg_t    *MsgPtr,
     */
     CFE_SB_DecrBufUseCnt(BufDscPtr);
 
-    /* release the semaphore */
-    CFE_SB_UnlockSharedData(__func__,__LINE__);
-
 
     /* send an event for each pipe write error that may have occurred */
     for(i=0;i < SBSndErr.EvtsToSnd; i++)
@@ -1370,7 +1464,7 @@ int32  CFE_SB_SendMsgFull(CFE_SB_Msg_t    *MsgPtr,
 
               CFE_EVS_SendEventWithAppID(CFE_SB_MSGID_LIM_ERR_EID,CFE_EVS_ERROR,CFE_SB.AppId,
                 "Msg Limit Err,MsgId 0x%x,pipe %s,sender %s",
-                (unsigned int)RtgTblPtr->MsgId,
+                (unsigned int)MsgId,
                 CFE_SB_GetPipeName(SBSndErr.EvtBuf[i].PipeId),
                 CFE_SB_GetAppTskName(TskId,FullName));
 
@@ -1388,7 +1482,7 @@ int32  CFE_SB_SendMsgFull(CFE_SB_Msg_t    *MsgPtr,
 
               CFE_EVS_SendEventWithAppID(CFE_SB_Q_FULL_ERR_EID,CFE_EVS_ERROR,CFE_SB.AppId,
                   "Pipe Overflow,MsgId 0x%x,pipe %s,sender %s",
-                  (unsigned int)RtgTblPtr->MsgId,
+                  (unsigned int)MsgId,
                   CFE_SB_GetPipeName(SBSndErr.EvtBuf[i].PipeId),
                   CFE_SB_GetAppTskName(TskId,FullName));
 
@@ -1403,7 +1497,7 @@ int32  CFE_SB_SendMsgFull(CFE_SB_Msg_t    *MsgPtr,
 
               CFE_EVS_SendEventWithAppID(CFE_SB_Q_WR_ERR_EID,CFE_EVS_ERROR,CFE_SB.AppId,
                 "Pipe Write Err,MsgId 0x%x,pipe %s,sender %s,stat 0x%x",
-                (unsigned int)RtgTblPtr->MsgId,
+                (unsigned int)MsgId,
                 CFE_SB_GetPipeName(SBSndErr.EvtBuf[i].PipeId),
                 CFE_SB_GetAppTskName(TskId,FullName),
                 (unsigned int)SBSndErr.EvtBuf[i].ErrStat);
@@ -1453,8 +1547,10 @@ int32  CFE_SB_RcvMsg(CFE_SB_MsgPtr_t    *BufPtr,
     int32                  Status;
     CFE_SB_BufferD_t       *Message;
     CFE_SB_PipeD_t         *PipeDscPtr;
+    CFE_SB_PipeBatch_t     *Batch;
     CFE_SB_DestinationD_t  *DestPtr = NULL;
     uint32                 TskId = 0;
+    uint32                 ReadToken;
     char                   FullName[(OS_MAX_API_NAME * 2)];
 
     /* get task id for events */
@@ -1499,8 +1595,11 @@ int32  CFE_SB_RcvMsg(CFE_SB_MsgPtr_t    *BufPtr,
     */
     Status = CFE_SB_ReadQueue(PipeDscPtr, TskId, TimeOut, &Message);
 
-    /* take semaphore again to protect the remaining code in this call */
-    CFE_SB_LockSharedData(__func__,__LINE__);
+    /*
+    ** The rest of this call does not take the shared data lock, the buffer
+    ** and the counters are released atomically and the destination is
+    ** found in the route snapshot the senders use.
+    */
 
     /* free any pending trash buffer */
     if (PipeDscPtr->ToTrashBuff != NULL) {
@@ -1512,6 +1611,15 @@ int32  CFE_SB_RcvMsg(CFE_SB_MsgPtr_t    *BufPtr,
 
     }/* end if */
 
+    /* and the rest of a batch read with CFE_SB_RcvMsgBatch */
+    Batch = &CFE_SB.PipeBatch[PipeDscPtr->PipeId];
+    if (Batch->Count != 0) {
+
+        CFE_SB_DecrBufUseCnts(Batch->Buff, Batch->Count);
+        Batch->Count = 0;
+
+    }/* end if */
+
     if (Status == CFE_SUCCESS) {
 
         /*
@@ -1525,7 +1633,8 @@ int32  CFE_SB_RcvMsg(CFE_SB_MsgPtr_t    *BufPtr,
         *BufPtr = (CFE_SB_MsgPtr_t) Message->Buffer;
 
         /* get pointer to destination to be used in decrementing msg limit cnt*/
-        DestPtr = CFE_SB_GetDestPtr(PipeDscPtr->CurrentBuff->MsgId, PipeDscPtr->PipeId);
+        ReadToken = CFE_SB_RouteReadBegin(TskId);
+        DestPtr = CFE_SB_GetRouteDest(Message->MsgId, PipeDscPtr->PipeId);
 
         /*
         ** DestPtr would be NULL if the msg is unsubscribed to while it is on
@@ -1535,15 +1644,15 @@ int32  CFE_SB_RcvMsg(CFE_SB_MsgPtr_t    *BufPtr,
         */
         if(DestPtr != NULL){
 
-            if (DestPtr->BuffCount > 0){
-                DestPtr->BuffCount--;
-            }
+            CFE_SB_DecrNonZero(&DestPtr->BuffCount);
 
         }/* end if DestPtr != NULL */
 
+        CFE_SB_RouteReadEnd(ReadToken);
+
         if (PipeDscPtr->PipeId < CFE_SB_TLM_PIPEDEPTHSTATS_SIZE)
         {
-        CFE_SB.StatTlmMsg.Payload.PipeDepthStats[PipeDscPtr->PipeId].InUse--;
+            CFE_SB_DecrNonZero(&CFE_SB.StatTlmMsg.Payload.PipeDepthStats[PipeDscPtr->PipeId].InUse);
         }
 
     }else{
@@ -1553,9 +1662,6 @@ int32  CFE_SB_RcvMsg(CFE_SB_MsgPtr_t    *BufPtr,
 
     }/* end if */
 
-    /* release the semaphore */
-    CFE_SB_UnlockSharedData(__func__,__LINE__);
-
     /*
     ** If status is not CFE_SUCCESS, then no packet was received.  If this was
     ** caused by an unexpected error, then CFE_SB_ReadQueue() will report the
@@ -1566,6 +1672,146 @@ int32  CFE_SB_RcvMsg(CFE_SB_MsgPtr_t    *BufPtr,
 }/* end CFE_SB_RcvMsg */
 
 
+/******************************************************************************
+** Name:    CFE_SB_RcvMsgBatch
+**
+** Purpose: API used to receive up to MaxCount messages from the software bus
+**          in one call.
+**
+** Assumptions, External Events, and Notes:
+**          Only the first message is waited for, the rest are what is already
+**          on the pipe.  The buffers of the previous receive are released
+**          together before the wait, and the route snapshot is entered once
+**          for the whole batch.
+**
+** Date Written:
+**          10/17/2026
+**
+** Input Arguments:
+**          BufPtrs
+**          MaxCount
+**          CountPtr
+**          PipeId
+**          TimeOut - CFE_SB_PEND, CFE_SB_POLL or millisecond timeout
+**
+** Output Arguments:
+**          BufPtrs  - one pointer per message received
+**          CountPtr - number of messages received
+**
+** Return Values:
+**          Status
+**
+******************************************************************************/
+int32  CFE_SB_RcvMsgBatch(CFE_SB_MsgPtr_t    *BufPtrs,
+                          uint32             MaxCount,
+                          uint32             *CountPtr,
+                          CFE_SB_PipeId_t    PipeId,
+                          int32              TimeOut)
+{
+    int32                  Status;
+    CFE_SB_PipeD_t         *PipeDscPtr;
+    CFE_SB_PipeBatch_t     *Batch;
+    CFE_SB_BufferD_t       *Message;
+    CFE_SB_DestinationD_t  *DestPtr;
+    uint32                 Count;
+    uint32                 TskId = 0;
+    uint32                 ReadToken;
+    uint32                 i;
+    char                   FullName[(OS_MAX_API_NAME * 2)];
+
+    /* get task id for events */
+    TskId = OS_TaskGetId();
+
+    if(CountPtr != NULL){
+        *CountPtr = 0;
+    }/* end if */
+
+    /* Check input parameters */
+    if((BufPtrs == NULL)||(CountPtr == NULL)||(MaxCount == 0)||(TimeOut < (-1))){
+        CFE_SB_LockSharedData(__func__,__LINE__);
+        CFE_SB.HKTlmMsg.Payload.MsgReceiveErrCnt++;
+        CFE_SB_UnlockSharedData(__func__,__LINE__);
+        CFE_EVS_SendEventWithAppID(CFE_SB_RCV_BATCH_BAD_ARG_EID,CFE_EVS_ERROR,CFE_SB.AppId,
+            "Rcv Batch Err:Bad Input Arg:BufPtrs 0x%lx,CountPtr 0x%lx,max %u,pipe %d,t/o %d,app %s",
+            (unsigned long)BufPtrs,(unsigned long)CountPtr,(unsigned int)MaxCount,
+            (int)PipeId,(int)TimeOut,CFE_SB_GetAppTskName(TskId,FullName));
+        return CFE_SB_BAD_ARGUMENT;
+    }/* end if */
+
+    PipeDscPtr = CFE_SB_GetPipePtr(PipeId);
+    /* If the pipe does not exist or PipeId is out of range... */
+    if (PipeDscPtr == NULL) {
+        CFE_SB_LockSharedData(__func__,__LINE__);
+        CFE_SB.HKTlmMsg.Payload.MsgReceiveErrCnt++;
+        CFE_SB_UnlockSharedData(__func__,__LINE__);
+        CFE_EVS_SendEventWithAppID(CFE_SB_BAD_PIPEID_EID,CFE_EVS_ERROR,CFE_SB.AppId,
+            "Rcv Err:PipeId %d does not exist,app %s",
+            (int)PipeId,CFE_SB_GetAppTskName(TskId,FullName));
+        return CFE_SB_BAD_ARGUMENT;
+    }/* end if */
+
+    if (MaxCount > CFE_SB_MAX_RCV_BATCH) {
+        MaxCount = CFE_SB_MAX_RCV_BATCH;
+    }/* end if */
+
+    /*
+    ** Release the previous batch, or the message of a CFE_SB_RcvMsg, before
+    ** waiting so the buffers are back in the pool while this task blocks
+    */
+    Batch = &CFE_SB.PipeBatch[PipeDscPtr->PipeId];
+
+    if (PipeDscPtr->CurrentBuff != NULL) {
+        Batch->Buff[Batch->Count++] = PipeDscPtr->CurrentBuff;
+        PipeDscPtr->CurrentBuff = NULL;
+    }/* end if */
+
+    CFE_SB_DecrBufUseCnts(Batch->Buff, Batch->Count);
+    Batch->Count = 0;
+
+    /* Wait for the first message, then take what else is on the pipe */
+    Status = CFE_SB_ReadQueue(PipeDscPtr, TskId, TimeOut, &Batch->Buff[0]);
+    if (Status != CFE_SUCCESS) {
+        return Status;
+    }/* end if */
+
+    Count = 1;
+    while ((Count < MaxCount) &&
+           (CFE_SB_ReadQueue(PipeDscPtr, TskId, CFE_SB_POLL, &Batch->Buff[Count]) == CFE_SUCCESS)) {
+        Count++;
+    }/* end while */
+
+    /* See CFE_SB_RcvMsg, one route snapshot serves the whole batch */
+    ReadToken = CFE_SB_RouteReadBegin(TskId);
+
+    for (i = 0; i < Count; i++) {
+
+        Message = Batch->Buff[i];
+        BufPtrs[i] = (CFE_SB_MsgPtr_t) Message->Buffer;
+
+        DestPtr = CFE_SB_GetRouteDest(Message->MsgId, PipeDscPtr->PipeId);
+        if (DestPtr != NULL) {
+            CFE_SB_DecrNonZero(&DestPtr->BuffCount);
+        }/* end if */
+
+        if (PipeDscPtr->PipeId < CFE_SB_TLM_PIPEDEPTHSTATS_SIZE) {
+            CFE_SB_DecrNonZero(&CFE_SB.StatTlmMsg.Payload.PipeDepthStats[PipeDscPtr->PipeId].InUse);
+        }/* end if */
+
+    }/* end for */
+
+    CFE_SB_RouteReadEnd(ReadToken);
+
+    /* The last message is the pipe's current buffer, as after CFE_SB_RcvMsg */
+    PipeDscPtr->CurrentBuff = Batch->Buff[Count - 1];
+    Batch->Count = Count - 1;
+
+    *CountPtr = Count;
+
+    return CFE_SUCCESS;
+
+}/* end CFE_SB_RcvMsgBatch */
+
+
 /******************************************************************************
 ** Name:    CFE_SB_GetLastSenderId
 **
@@ -1636,7 +1882,11 @@ uint32  CFE_SB_GetLastSenderId(CFE_SB_SenderId_t **Ptr,CFE_SB_PipeId_t  PipeId)
     Ptr2BufDescriptor = CFE_SB.PipeTbl[PipeId].CurrentBuff;
 
     /* Set the receivers pointer to the adr of 'Sender' struct in buf descriptor */
-    *Ptr = (CFE_SB_SenderId_t *) &Ptr2BufDescriptor -> Sender;
+    if(Ptr2BufDescriptor != NULL){
+      *Ptr = &Ptr2BufDescriptor -> Sender;
+    }else{
+      *Ptr = &CFE_SB.NoSender;
+    }/* end if */
 
     CFE_SB_UnlockSharedData(__func__,__LINE__);
 
@@ -1689,42 +1939,23 @@ CFE_SB_Msg_t  *CFE_SB_ZeroCopyGetPtr(uint16 MsgSize,
 
     /* Add the size of a zero copy descriptor to the memory-in-use ctr and */
     /* adjust the high water mark if needed */
-    CFE_SB.StatTlmMsg.Payload.MemInUse+=stat1;
-    if(CFE_SB.StatTlmMsg.Payload.MemInUse > CFE_SB.StatTlmMsg.Payload.PeakMemInUse){
-       CFE_SB.StatTlmMsg.Payload.PeakMemInUse = CFE_SB.StatTlmMsg.Payload.MemInUse;
-    }/* end if */
+    CFE_SB_RaisePeak32(&CFE_SB.StatTlmMsg.Payload.PeakMemInUse,
+                       CFE_SB_ATOMIC_ADD(CFE_SB.StatTlmMsg.Payload.MemInUse, stat1));
 
     /* Allocate a new buffer (from the SB memory pool) to hold the message  */
-    stat1 = CFE_ES_GetPoolBuf((uint32 **)&bd, CFE_SB.Mem.PoolHdl, MsgSize + sizeof(CFE_SB_BufferD_t));
-    if((stat1 < 0)||(bd==NULL)){
+    /* SBBuffersInUse increments on a per-message basis, not for the zcd    */
+    bd = CFE_SB_GetBufferFromPool(CFE_SB_INVALID_MSG_ID, MsgSize);
+    if(bd == NULL){
         /*deallocate the first buffer if the second buffer creation fails*/
         stat1 = CFE_ES_PutPoolBuf(CFE_SB.Mem.PoolHdl, (uint32 *)zcd);
         if(stat1 > 0){
-            CFE_SB.StatTlmMsg.Payload.MemInUse-=stat1;
+            CFE_SB_ATOMIC_SUB(CFE_SB.StatTlmMsg.Payload.MemInUse, stat1);
         }
         CFE_SB_UnlockSharedData(__func__,__LINE__);
         return NULL;
     }
 
-    /* Increment the number of buffers in use by one even though two buffers */
-    /* were allocated. SBBuffersInUse increments on a per-message basis */
-    CFE_SB.StatTlmMsg.Payload.SBBuffersInUse++;
-    if(CFE_SB.StatTlmMsg.Payload.SBBuffersInUse > CFE_SB.StatTlmMsg.Payload.PeakSBBuffersInUse){
-        CFE_SB.StatTlmMsg.Payload.PeakSBBuffersInUse = CFE_SB.StatTlmMsg.Payload.SBBuffersInUse;
-    }/* end if */
-
-    /* Add the size of the actual buffer to the memory-in-use ctr and */
-    /* adjust the high water mark if needed */
-    CFE_SB.StatTlmMsg.Payload.MemInUse+=stat1;
-    if(CFE_SB.StatTlmMsg.Payload.MemInUse > CFE_SB.StatTlmMsg.Payload.PeakMemInUse){
-       CFE_SB.StatTlmMsg.Payload.PeakMemInUse = CFE_SB.StatTlmMsg.Payload.MemInUse;
-    }/* end if */
-
-    /* first set ptr to actual msg buffer the same as ptr to descriptor */
-    address = (uint8 *)bd;
-
-    /* increment actual msg buffer ptr beyond the descriptor */
-    address += sizeof(CFE_SB_BufferD_t);
+    address = (uint8 *)bd->Buffer;
 
     /* Initialize the zero copy descriptor structure. */
     zcd->Size      = MsgSize;
@@ -1746,11 +1977,6 @@ CFE_SB_Msg_t  *CFE_SB_ZeroCopyGetPtr(uint16 MsgSize,
 
     (*BufferHandle) = (CFE_SB_ZeroCopyHandle_t) zcd;
 
-    /* Initialize the buffer descriptor structure. */
-    bd->UseCount  = 1;
-    bd->Size      = MsgSize;
-    bd->Buffer    = (void *)address;
-
     return (CFE_SB_Msg_t *)address;
 
 }/* CFE_SB_ZeroCopyGetPtr */
@@ -1785,7 +2011,6 @@ int32 CFE_SB_ZeroCopyReleasePtr(CFE_SB_Msg_t  *Ptr2Release,
                                 CFE_SB_ZeroCopyHandle_t BufferHandle)
 {
     int32    Status;
-    int32    Stat2;
 
     Status = CFE_SB_ZeroCopyReleaseDesc(Ptr2Release, BufferHandle);
 
@@ -1793,13 +2018,8 @@ int32 CFE_SB_ZeroCopyReleasePtr(CFE_SB_Msg_t  *Ptr2Release,
 
     if(Status == CFE_SUCCESS){
         /* give the buffer back to the buffer pool */
-        Stat2 = CFE_ES_PutPoolBuf(CFE_SB.Mem.PoolHdl,
-                                  (uint32 *) (((uint8 *)Ptr2Release) - sizeof(CFE_SB_BufferD_t)));
-        if(Stat2 > 0){
-             /* Substract the size of the actual buffer from the Memory in use ctr */
-            CFE_SB.StatTlmMsg.Payload.MemInUse-=Stat2;
-            CFE_SB.StatTlmMsg.Payload.SBBuffersInUse--;
-        }/* end if */
+        CFE_SB_ReturnBufferToPool((CFE_SB_BufferD_t *)
+                                  (((uint8 *)Ptr2Release) - sizeof(CFE_SB_BufferD_t)));
     }
 
     CFE_SB_UnlockSharedData(__func__,__LINE__);
@@ -1862,7 +2082,7 @@ int32 CFE_SB_ZeroCopyReleaseDesc(CFE_SB_Msg_t  *Ptr2Release,
     Stat = CFE_ES_PutPoolBuf(CFE_SB.Mem.PoolHdl, (uint32 *)zcd);
     if(Stat > 0){
         /* Substract the size of the actual buffer from the Memory in use ctr */
-        CFE_SB.StatTlmMsg.Payload.MemInUse-=Stat;
+        CFE_SB_ATOMIC_SUB(CFE_SB.StatTlmMsg.Payload.MemInUse, Stat);
     }/* end if */
 
     CFE_SB_UnlockSharedData(__func__,__LINE__);
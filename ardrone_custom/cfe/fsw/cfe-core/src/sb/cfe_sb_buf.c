@@ -87,6 +87,19 @@
 #include "cfe_es.h"
 #include "cfe_error.h"
 
+/*
+** Local function prototypes
+*/
+static uint32 CFE_SB_BufClass(uint32 Size);
+static CFE_SB_BufMagazine_t *CFE_SB_ClaimMagazine(uint32 Slot);
+static void CFE_SB_ReleaseMagazine(CFE_SB_BufMagazine_t *Mag);
+static boolean CFE_SB_DepotPut(CFE_SB_BufDepot_t *Depot, CFE_SB_BufferD_t *bd);
+static CFE_SB_BufferD_t *CFE_SB_DepotGet(CFE_SB_BufDepot_t *Depot);
+static CFE_SB_BufferD_t *CFE_SB_GetPoolBlock(uint32 Class, uint16 Size);
+static int32 CFE_SB_PutPoolBlock(CFE_SB_BufferD_t *bd);
+static void CFE_SB_CacheBuffer(CFE_SB_BufMagazine_t *Mag, CFE_SB_BufferD_t *bd);
+
+
 /******************************************************************************
 **  Function:   CFE_SB_GetBufferFromPool()
 **
@@ -96,6 +109,9 @@
 **    by the SB to dynamically allocate memory to hold the message and a buffer
 **    descriptor associated with the message during the sending of a message.
 **
+**    Buffers that fit a size class are taken from the calling task's
+**    magazine, then from the class depot, and only then from the pool.
+**
 **  Arguments:
 **    msgId        : Message ID
 **    size         : Size of the buffer in bytes.
@@ -106,40 +122,74 @@
 */
 
 CFE_SB_BufferD_t * CFE_SB_GetBufferFromPool(uint16 MsgId, uint16 Size) {
-   int32                stat1;
-   uint8               *address = NULL;
-   CFE_SB_BufferD_t    *bd = NULL;
+   uint32                Class;
+   uint32                Slot;
+   CFE_SB_BufMagazine_t *Mag;
+   CFE_SB_BufferD_t     *bd = NULL;
 
-    /* Allocate a new buffer descriptor from the SB memory pool.*/
-    stat1 = CFE_ES_GetPoolBuf((uint32 **)&bd, CFE_SB.Mem.PoolHdl,  Size + sizeof(CFE_SB_BufferD_t));
-    if(stat1 < 0){
-        return NULL;
-    }
+    Class = CFE_SB_BufClass(Size + sizeof(CFE_SB_BufferD_t));
 
-    /* increment the number of buffers in use and adjust the high water mark if needed */
-    CFE_SB.StatTlmMsg.Payload.SBBuffersInUse++;
-    if(CFE_SB.StatTlmMsg.Payload.SBBuffersInUse > CFE_SB.StatTlmMsg.Payload.PeakSBBuffersInUse){
-        CFE_SB.StatTlmMsg.Payload.PeakSBBuffersInUse = CFE_SB.StatTlmMsg.Payload.SBBuffersInUse;
-    }/* end if */
+    if(Class < CFE_SB_BUF_CLASSES){
+
+        OS_ConvertToArrayIndex(OS_TaskGetId(), &Slot);
+        Mag = CFE_SB_ClaimMagazine(Slot);
+
+        if(Mag != NULL){
+
+            /* refill half an empty magazine from the depot */
+            if(Mag->Count[Class] == 0){
+                while((Mag->Count[Class] < CFE_SB_BUF_MAG_SIZE / 2) &&
+                      ((bd = CFE_SB_DepotGet(&CFE_SB.BufDepot[Class])) != NULL)){
+                    Mag->Buff[Class][Mag->Count[Class]++] = bd;
+                }/* end while */
+            }/* end if */
+
+            if(Mag->Count[Class] != 0){
+                bd = Mag->Buff[Class][--Mag->Count[Class]];
+                Mag->Hits++;
+            }else{
+                Mag->Misses++;
+            }/* end if */
+
+            CFE_SB_ReleaseMagazine(Mag);
+
+        }else{
+
+            bd = CFE_SB_DepotGet(&CFE_SB.BufDepot[Class]);
+            if(bd != NULL){
+                CFE_SB_ATOMIC_INC(CFE_SB.BufSpillHits);
+            }else{
+                CFE_SB_ATOMIC_INC(CFE_SB.BufSpillMisses);
+            }/* end if */
+
+        }/* end if */
 
-    /* Add the size of the actual buffer to the memory-in-use ctr and */
-    /* adjust the high water mark if needed */
-    CFE_SB.StatTlmMsg.Payload.MemInUse+=stat1;
-    if(CFE_SB.StatTlmMsg.Payload.MemInUse > CFE_SB.StatTlmMsg.Payload.PeakMemInUse){
-        CFE_SB.StatTlmMsg.Payload.PeakMemInUse = CFE_SB.StatTlmMsg.Payload.MemInUse;
     }/* end if */
 
-    /* first set ptr to actual msg buffer the same as ptr to descriptor */
-    address = (uint8 *)bd;
+    if(bd == NULL){
 
-    /* increment actual msg buffer ptr beyond the descriptor */
-    address += sizeof(CFE_SB_BufferD_t);
+        bd = CFE_SB_GetPoolBlock(Class, Size);
+
+        /* the pool may be short because free buffers sit in the cache */
+        if((bd == NULL) && (CFE_SB_ReclaimBufCache() != 0)){
+            bd = CFE_SB_GetPoolBlock(Class, Size);
+        }/* end if */
+
+        if(bd == NULL){
+            return NULL;
+        }/* end if */
 
-    /* Initialize the buffer descriptor structure. */
+    }/* end if */
+
+    /* increment the number of buffers in use and adjust the high water mark if needed */
+    CFE_SB_RaisePeak32(&CFE_SB.StatTlmMsg.Payload.PeakSBBuffersInUse,
+                       CFE_SB_ATOMIC_INC(CFE_SB.StatTlmMsg.Payload.SBBuffersInUse));
+
+    /* Initialize the buffer descriptor structure, the msg follows it. */
     bd->MsgId     = MsgId;
     bd->UseCount  = 1;
     bd->Size      = Size;
-    bd->Buffer    = (void *)address;
+    bd->Buffer    = (void *)((uint8 *)bd + sizeof(CFE_SB_BufferD_t));
 
     return bd;
 
@@ -178,9 +228,9 @@ CFE_SB_BufferD_t * CFE_SB_GetBufferFromCaller(uint16 MsgId,
 **  Function:   CFE_SB_ReturnBufferToPool()
 **
 **  Purpose:
-**    This function will return two blocks of memory back to the memory pool.
-**    One block is the memory used to store the actual message, the other block
-**    was used to store the buffer descriptor for the message.
+**    This function will return the block of memory holding the buffer
+**    descriptor and the message back to the memory pool.  Buffers of a size
+**    class are kept in the calling task's magazine for reuse instead.
 **
 **  Arguments:
 **    bd     : Pointer to the buffer descriptor.
@@ -189,14 +239,22 @@ CFE_SB_BufferD_t * CFE_SB_GetBufferFromCaller(uint16 MsgId,
 **    SB status
 */
 int32 CFE_SB_ReturnBufferToPool(CFE_SB_BufferD_t *bd){
-    int32    Stat;
+    uint32                Slot;
+    CFE_SB_BufMagazine_t *Mag;
+
+    if(bd->SizeClass != 0){
+
+        OS_ConvertToArrayIndex(OS_TaskGetId(), &Slot);
+        Mag = CFE_SB_ClaimMagazine(Slot);
+        CFE_SB_CacheBuffer(Mag, bd);
+        CFE_SB_ReleaseMagazine(Mag);
+
+        CFE_SB_ATOMIC_DEC(CFE_SB.StatTlmMsg.Payload.SBBuffersInUse);
+
+    }else if(CFE_SB_PutPoolBlock(bd) > 0){
+
+        CFE_SB_ATOMIC_DEC(CFE_SB.StatTlmMsg.Payload.SBBuffersInUse);
 
-    /* give the buf descriptor back to the buf descriptor pool */
-    Stat = CFE_ES_PutPoolBuf(CFE_SB.Mem.PoolHdl, (uint32 *)bd);
-    if(Stat > 0){
-        CFE_SB.StatTlmMsg.Payload.SBBuffersInUse--;
-        /* Substract the size of a buffer descriptor from the Memory in use ctr */
-        CFE_SB.StatTlmMsg.Payload.MemInUse-=Stat;
     }/* end if */
 
     return CFE_SUCCESS;
@@ -215,7 +273,9 @@ int32 CFE_SB_ReturnBufferToPool(CFE_SB_BufferD_t *bd){
 **
 **  Note:
 **    UseCount is a variable in the CFE_SB_BufferD_t and is used only to
-**    determine when a buffer may be returned to the memory pool.
+**    determine when a buffer may be returned to the memory pool.  Senders
+**    and receivers on different tasks update it without the shared data
+**    lock, only the task taking it to zero frees the buffer.
 **
 **  Arguments:
 **    bd : Pointer to the buffer descriptor.
@@ -226,19 +286,468 @@ int32 CFE_SB_ReturnBufferToPool(CFE_SB_BufferD_t *bd){
 int32 CFE_SB_DecrBufUseCnt(CFE_SB_BufferD_t *bd){
 
     /* range check the UseCount variable */
-    if(bd->UseCount > 0){
+    if(CFE_SB_DecrNonZero(&bd->UseCount) == 1){
+        CFE_SB_ReturnBufferToPool(bd);
+    }/* end if */
+
+    return CFE_SUCCESS;
+
+}/* end CFE_SB_DecrBufUseCnt */
 
-        bd->UseCount--;
 
-        if (bd->UseCount == 0) {
-           CFE_SB_ReturnBufferToPool(bd);
+/******************************************************************************
+**  Function:   CFE_SB_DecrBufUseCnts()
+**
+**  Purpose:
+**    Same as CFE_SB_DecrBufUseCnt for an array of buffers, as left by a batch
+**    receive.  The buffers that reach a UseCount of zero go back to the
+**    magazine or pool and the buffer statistics are adjusted once for all
+**    of them.
+**
+**  Arguments:
+**    bd    : Array of buffer descriptor pointers.
+**    Count : Number of entries in bd.
+**
+**  Return:
+**    None
+*/
+void CFE_SB_DecrBufUseCnts(CFE_SB_BufferD_t **bd, uint32 Count){
+
+    uint32                i;
+    uint32                Slot;
+    uint32                Freed = 0;
+    CFE_SB_BufMagazine_t *Mag;
+
+    OS_ConvertToArrayIndex(OS_TaskGetId(), &Slot);
+    Mag = CFE_SB_ClaimMagazine(Slot);
+
+    for(i = 0; i < Count; i++){
+
+        if(CFE_SB_DecrNonZero(&bd[i]->UseCount) == 1){
+
+            if(bd[i]->SizeClass != 0){
+                CFE_SB_CacheBuffer(Mag, bd[i]);
+                Freed++;
+            }else if(CFE_SB_PutPoolBlock(bd[i]) > 0){
+                Freed++;
+            }/* end if */
+
         }/* end if */
 
-    }
+    }/* end for */
 
-    return CFE_SUCCESS;
+    CFE_SB_ReleaseMagazine(Mag);
 
-}/* end CFE_SB_DecrBufUseCnt */
+    if(Freed != 0){
+        CFE_SB_ATOMIC_SUB(CFE_SB.StatTlmMsg.Payload.SBBuffersInUse, Freed);
+    }/* end if */
+
+}/* end CFE_SB_DecrBufUseCnts */
+
+
+/******************************************************************************
+**  Function:   CFE_SB_InitBufCache()
+**
+**  Purpose:
+**    Empty the magazines and depots of the SB buffer cache, done whenever
+**    the SB buffer pool is created.
+**
+**  Arguments:
+**    None
+**
+**  Return:
+**    None
+*/
+void CFE_SB_InitBufCache(void){
+
+    uint32  i;
+    uint32  j;
+
+    CFE_PSP_MemSet(CFE_SB.BufDepot, 0, sizeof(CFE_SB.BufDepot));
+    CFE_PSP_MemSet(CFE_SB.BufMag, 0, sizeof(CFE_SB.BufMag));
+    CFE_SB.BufSpillHits = 0;
+    CFE_SB.BufSpillMisses = 0;
+
+    for(i = 0; i < CFE_SB_BUF_CLASSES; i++){
+        for(j = 0; j < CFE_SB_BUF_CACHE_DEPTH; j++){
+            CFE_SB.BufDepot[i].Cell[j].Seq = j;
+        }/* end for */
+    }/* end for */
+
+}/* end CFE_SB_InitBufCache */
+
+
+/******************************************************************************
+**  Function:   CFE_SB_ReclaimBufCache()
+**
+**  Purpose:
+**    Give the free buffers held in the depots, and in the magazines of tasks
+**    not using theirs right now, back to the SB buffer pool.  Called when
+**    the pool cannot satisfy an allocation.
+**
+**  Arguments:
+**    None
+**
+**  Return:
+**    Number of buffers given back
+*/
+uint32 CFE_SB_ReclaimBufCache(void){
+
+    uint32                i;
+    uint32                c;
+    uint32                Count = 0;
+    CFE_SB_BufMagazine_t *Mag;
+    CFE_SB_BufferD_t     *bd;
+
+    for(i = 0; i < CFE_SB_BUF_MAGAZINES; i++){
+
+        Mag = CFE_SB_ClaimMagazine(i);
+        if(Mag != NULL){
+            for(c = 0; c < CFE_SB_BUF_CLASSES; c++){
+                while(Mag->Count[c] != 0){
+                    CFE_SB_PutPoolBlock(Mag->Buff[c][--Mag->Count[c]]);
+                    Count++;
+                }/* end while */
+            }/* end for */
+            CFE_SB_ReleaseMagazine(Mag);
+        }/* end if */
+
+    }/* end for */
+
+    for(c = 0; c < CFE_SB_BUF_CLASSES; c++){
+        while((bd = CFE_SB_DepotGet(&CFE_SB.BufDepot[c])) != NULL){
+            CFE_SB_PutPoolBlock(bd);
+            Count++;
+        }/* end while */
+    }/* end for */
+
+    return Count;
+
+}/* end CFE_SB_ReclaimBufCache */
+
+
+/******************************************************************************
+**  Function:   CFE_SB_GetBufCacheStats()
+**
+**  Purpose:
+**    Total the buffer cache counters of all magazines and depots into the
+**    SB statistics packet.
+**
+**  Arguments:
+**    None
+**
+**  Return:
+**    None
+*/
+void CFE_SB_GetBufCacheStats(void){
+
+    uint32  i;
+    uint32  c;
+    uint32  Hits;
+    uint32  Misses;
+    uint32  Held = 0;
+
+    Hits   = __atomic_load_n(&CFE_SB.BufSpillHits, __ATOMIC_RELAXED);
+    Misses = __atomic_load_n(&CFE_SB.BufSpillMisses, __ATOMIC_RELAXED);
+
+    for(i = 0; i < CFE_SB_BUF_MAGAZINES; i++){
+        Hits   += __atomic_load_n(&CFE_SB.BufMag[i].Hits, __ATOMIC_RELAXED);
+        Misses += __atomic_load_n(&CFE_SB.BufMag[i].Misses, __ATOMIC_RELAXED);
+        for(c = 0; c < CFE_SB_BUF_CLASSES; c++){
+            Held += __atomic_load_n(&CFE_SB.BufMag[i].Count[c], __ATOMIC_RELAXED);
+        }/* end for */
+    }/* end for */
+
+    for(c = 0; c < CFE_SB_BUF_CLASSES; c++){
+        Held += __atomic_load_n(&CFE_SB.BufDepot[c].Tail, __ATOMIC_RELAXED) -
+                __atomic_load_n(&CFE_SB.BufDepot[c].Head, __ATOMIC_RELAXED);
+    }/* end for */
+
+    CFE_SB.StatTlmMsg.Payload.BufCacheHits = Hits;
+    CFE_SB.StatTlmMsg.Payload.BufCacheMisses = Misses;
+    CFE_SB.StatTlmMsg.Payload.BufCacheInUse = Held;
+    if(Held > CFE_SB.StatTlmMsg.Payload.PeakBufCacheInUse){
+        CFE_SB.StatTlmMsg.Payload.PeakBufCacheInUse = Held;
+    }/* end if */
+
+}/* end CFE_SB_GetBufCacheStats */
+
+
+/******************************************************************************
+**  Function:   CFE_SB_BufClass()
+**
+**  Purpose:
+**    Find the smallest buffer size class holding Size bytes.
+**
+**  Arguments:
+**    Size : Size of the descriptor and message in bytes.
+**
+**  Return:
+**    The size class, CFE_SB_BUF_CLASSES if the buffer is too big for all.
+*/
+static uint32 CFE_SB_BufClass(uint32 Size){
+
+    uint32  Class = 0;
+
+    while((Class < CFE_SB_BUF_CLASSES) && (Size > CFE_SB_BUF_CLASS_SIZE(Class))){
+        Class++;
+    }/* end while */
+
+    return Class;
+
+}/* end CFE_SB_BufClass */
+
+
+/******************************************************************************
+**  Function:   CFE_SB_ClaimMagazine()
+**
+**  Purpose:
+**    Take the magazine of a task slot.  Fails rather than waits if another
+**    caller has it, the caller then goes to the depot directly.
+**
+**  Arguments:
+**    Slot : Task array index.
+**
+**  Return:
+**    Pointer to the magazine, or NULL if it is busy.
+*/
+static CFE_SB_BufMagazine_t *CFE_SB_ClaimMagazine(uint32 Slot){
+
+    CFE_SB_BufMagazine_t *Mag = &CFE_SB.BufMag[Slot % CFE_SB_BUF_MAGAZINES];
+    uint32                Free = 0;
+
+    if(!__atomic_compare_exchange_n(&Mag->Owner, &Free, 1, FALSE,
+                                    __ATOMIC_ACQUIRE, __ATOMIC_RELAXED)){
+        return NULL;
+    }/* end if */
+
+    return Mag;
+
+}/* end CFE_SB_ClaimMagazine */
+
+
+/******************************************************************************
+**  Function:   CFE_SB_ReleaseMagazine()
+**
+**  Purpose:
+**    Give back a magazine taken by CFE_SB_ClaimMagazine, NULL is ignored.
+**
+**  Arguments:
+**    Mag : Pointer to the magazine.
+**
+**  Return:
+**    None
+*/
+static void CFE_SB_ReleaseMagazine(CFE_SB_BufMagazine_t *Mag){
+
+    if(Mag != NULL){
+        __atomic_store_n(&Mag->Owner, 0, __ATOMIC_RELEASE);
+    }/* end if */
+
+}/* end CFE_SB_ReleaseMagazine */
+
+
+/******************************************************************************
+**  Function:   CFE_SB_DepotPut()
+**
+**  Purpose:
+**    Add a free buffer to a class depot.
+**
+**  Arguments:
+**    Depot : Pointer to the depot.
+**    bd    : Pointer to the buffer descriptor.
+**
+**  Return:
+**    TRUE if added, FALSE if the depot is full.
+*/
+static boolean CFE_SB_DepotPut(CFE_SB_BufDepot_t *Depot, CFE_SB_BufferD_t *bd){
+
+    uint32                 Pos = __atomic_load_n(&Depot->Tail, __ATOMIC_RELAXED);
+    CFE_SB_BufDepotCell_t *Cell;
+    int32                  Dif;
+
+    for(;;){
+        Cell = &Depot->Cell[Pos & (CFE_SB_BUF_CACHE_DEPTH - 1)];
+        Dif  = (int32)(__atomic_load_n(&Cell->Seq, __ATOMIC_ACQUIRE) - Pos);
+
+        if(Dif == 0){
+            if(__atomic_compare_exchange_n(&Depot->Tail, &Pos, Pos + 1, TRUE,
+                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED)){
+                break;
+            }/* end if */
+        }else if(Dif < 0){
+            return FALSE;
+        }else{
+            Pos = __atomic_load_n(&Depot->Tail, __ATOMIC_RELAXED);
+        }/* end if */
+    }/* end for */
+
+    Cell->Buff = bd;
+    __atomic_store_n(&Cell->Seq, Pos + 1, __ATOMIC_RELEASE);
+
+    return TRUE;
+
+}/* end CFE_SB_DepotPut */
+
+
+/******************************************************************************
+**  Function:   CFE_SB_DepotGet()
+**
+**  Purpose:
+**    Take a free buffer from a class depot.
+**
+**  Arguments:
+**    Depot : Pointer to the depot.
+**
+**  Return:
+**    Pointer to the buffer descriptor, or NULL if the depot is empty.
+*/
+static CFE_SB_BufferD_t *CFE_SB_DepotGet(CFE_SB_BufDepot_t *Depot){
+
+    uint32                 Pos = __atomic_load_n(&Depot->Head, __ATOMIC_RELAXED);
+    CFE_SB_BufDepotCell_t *Cell;
+    CFE_SB_BufferD_t      *bd;
+    int32                  Dif;
+
+    for(;;){
+        Cell = &Depot->Cell[Pos & (CFE_SB_BUF_CACHE_DEPTH - 1)];
+        Dif  = (int32)(__atomic_load_n(&Cell->Seq, __ATOMIC_ACQUIRE) - (Pos + 1));
+
+        if(Dif == 0){
+            if(__atomic_compare_exchange_n(&Depot->Head, &Pos, Pos + 1, TRUE,
+                                           __ATOMIC_RELAXED, __ATOMIC_RELAXED)){
+                break;
+            }/* end if */
+        }else if(Dif < 0){
+            return NULL;
+        }else{
+            Pos = __atomic_load_n(&Depot->Head, __ATOMIC_RELAXED);
+        }/* end if */
+    }/* end for */
+
+    bd = Cell->Buff;
+    __atomic_store_n(&Cell->Seq, Pos + CFE_SB_BUF_CACHE_DEPTH, __ATOMIC_RELEASE);
+
+    return bd;
+
+}/* end CFE_SB_DepotGet */
+
+
+/******************************************************************************
+**  Function:   CFE_SB_GetPoolBlock()
+**
+**  Purpose:
+**    Allocate a message buffer from the SB memory pool, a whole class block
+**    with the descriptor at its first cache line boundary or, for a buffer
+**    too big for any class, a block sized to the message.
+**
+**  Arguments:
+**    Class : Size class of the buffer, CFE_SB_BUF_CLASSES if none.
+**    Size  : Size of the message in bytes.
+**
+**  Return:
+**    Pointer to the buffer descriptor, or NULL if the pool is short.
+*/
+static CFE_SB_BufferD_t *CFE_SB_GetPoolBlock(uint32 Class, uint16 Size){
+
+    int32              Stat;
+    uint32            *Block = NULL;
+    CFE_SB_BufferD_t  *bd;
+
+    if(Class < CFE_SB_BUF_CLASSES){
+        Stat = CFE_ES_GetPoolBuf(&Block, CFE_SB.Mem.PoolHdl, CFE_SB_BUF_CLASS_BLOCK(Class));
+        bd = (CFE_SB_BufferD_t *)(((cpuaddr)Block + CFE_SB_CACHE_LINE_SIZE - 1) &
+                                  ~(cpuaddr)(CFE_SB_CACHE_LINE_SIZE - 1));
+    }else{
+        Stat = CFE_ES_GetPoolBuf(&Block, CFE_SB.Mem.PoolHdl, Size + sizeof(CFE_SB_BufferD_t));
+        bd = (CFE_SB_BufferD_t *)Block;
+    }/* end if */
+
+    if((Stat < 0) || (Block == NULL)){
+        return NULL;
+    }/* end if */
+
+    /* Add the size of the block to the memory-in-use ctr and */
+    /* adjust the high water mark if needed */
+    CFE_SB_RaisePeak32(&CFE_SB.StatTlmMsg.Payload.PeakMemInUse,
+                       CFE_SB_ATOMIC_ADD(CFE_SB.StatTlmMsg.Payload.MemInUse, Stat));
+
+    bd->SizeClass = (Class < CFE_SB_BUF_CLASSES) ? (uint16)(Class + 1) : 0;
+    bd->Block     = Block;
+
+    return bd;
+
+}/* end CFE_SB_GetPoolBlock */
+
+
+/******************************************************************************
+**  Function:   CFE_SB_PutPoolBlock()
+**
+**  Purpose:
+**    Give the memory of a message buffer back to the SB memory pool.
+**
+**  Arguments:
+**    bd : Pointer to the buffer descriptor.
+**
+**  Return:
+**    Return of CFE_ES_PutPoolBuf
+*/
+static int32 CFE_SB_PutPoolBlock(CFE_SB_BufferD_t *bd){
+
+    int32   Stat;
+
+    Stat = CFE_ES_PutPoolBuf(CFE_SB.Mem.PoolHdl,
+                             (bd->SizeClass != 0) ? (uint32 *)bd->Block : (uint32 *)bd);
+    if(Stat > 0){
+        /* Substract the size of the block from the Memory in use ctr */
+        CFE_SB_ATOMIC_SUB(CFE_SB.StatTlmMsg.Payload.MemInUse, Stat);
+    }/* end if */
+
+    return Stat;
+
+}/* end CFE_SB_PutPoolBlock */
+
+
+/******************************************************************************
+**  Function:   CFE_SB_CacheBuffer()
+**
+**  Purpose:
+**    Keep a freed class buffer for reuse.  A full magazine moves half its
+**    buffers to the depot first, whatever the depot cannot take goes back
+**    to the pool.
+**
+**  Arguments:
+**    Mag : Pointer to the caller's magazine, NULL if it was busy.
+**    bd  : Pointer to the buffer descriptor.
+**
+**  Return:
+**    None
+*/
+static void CFE_SB_CacheBuffer(CFE_SB_BufMagazine_t *Mag, CFE_SB_BufferD_t *bd){
+
+    uint32              Class = bd->SizeClass - 1;
+    CFE_SB_BufDepot_t  *Depot = &CFE_SB.BufDepot[Class];
+    CFE_SB_BufferD_t   *Spill;
+
+    if(Mag == NULL){
+        if(!CFE_SB_DepotPut(Depot, bd)){
+            CFE_SB_PutPoolBlock(bd);
+        }/* end if */
+        return;
+    }/* end if */
+
+    if(Mag->Count[Class] == CFE_SB_BUF_MAG_SIZE){
+        while(Mag->Count[Class] > CFE_SB_BUF_MAG_SIZE / 2){
+            Spill = Mag->Buff[Class][--Mag->Count[Class]];
+            if(!CFE_SB_DepotPut(Depot, Spill)){
+                CFE_SB_PutPoolBlock(Spill);
+            }/* end if */
+        }/* end while */
+    }/* end if */
+
+    Mag->Buff[Class][Mag->Count[Class]++] = bd;
+
+}/* end CFE_SB_CacheBuffer */
 
 
 
@@ -267,10 +776,8 @@ CFE_SB_DestinationD_t *CFE_SB_GetDestinationBlk(void)
 
     /* Add the size of a destination descriptor to the memory-in-use ctr and */
     /* adjust the high water mark if needed */
-    CFE_SB.StatTlmMsg.Payload.MemInUse+=Stat;
-    if(CFE_SB.StatTlmMsg.Payload.MemInUse > CFE_SB.StatTlmMsg.Payload.PeakMemInUse){
-       CFE_SB.StatTlmMsg.Payload.PeakMemInUse = CFE_SB.StatTlmMsg.Payload.MemInUse;
-    }/* end if */
+    CFE_SB_RaisePeak32(&CFE_SB.StatTlmMsg.Payload.PeakMemInUse,
+                       CFE_SB_ATOMIC_ADD(CFE_SB.StatTlmMsg.Payload.MemInUse, Stat));
 
     return Dest;
 
@@ -301,7 +808,7 @@ int32 CFE_SB_PutDestinationBlk(CFE_SB_DestinationD_t *Dest)
     Stat = CFE_ES_PutPoolBuf(CFE_SB.Mem.PoolHdl, (uint32 *)Dest);
     if(Stat > 0){
         /* Substract the size of the destination block from the Memory in use ctr */
-        CFE_SB.StatTlmMsg.Payload.MemInUse-=Stat;
+        CFE_SB_ATOMIC_SUB(CFE_SB.StatTlmMsg.Payload.MemInUse, Stat);
     }/* end if */
 
     return CFE_SUCCESS;
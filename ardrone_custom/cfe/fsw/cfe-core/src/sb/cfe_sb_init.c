@@ -134,6 +134,10 @@ int32 CFE_SB_EarlyInit (void) {
     /* Initialize the state of sender reporting */
     CFE_SB.SenderReporting = CFE_SB_DEFAULT_REPORT_SENDER;
 
+    /* Sender information is looked up again as tasks register */
+    CFE_PSP_MemSet(CFE_SB.SenderRec, 0, sizeof(CFE_SB.SenderRec));
+    CFE_PSP_MemSet(&CFE_SB.NoSender, 0, sizeof(CFE_SB.NoSender));
+
      /* Initialize memory partition. */
     Stat = CFE_SB_InitBuffers();
     if(Stat != CFE_SUCCESS){
@@ -141,6 +145,9 @@ int32 CFE_SB_EarlyInit (void) {
       return Stat;
     }/* end if */
 
+    /* Empty the buffer cache kept in front of the new pool */
+    CFE_SB_InitBufCache();
+
     /* Initialize the pipe table. */
     CFE_SB_InitPipeTbl();
 
@@ -175,6 +182,9 @@ int32 CFE_SB_EarlyInit (void) {
 **  Notes:
 **    This function MUST be called before any SB API's are called.
 **
+**    The pool has its own mutex, senders allocate and free buffers
+**    without holding the shared data lock.
+**
 **  Return:
 **    none
 */
@@ -187,7 +197,7 @@ int32  CFE_SB_InitBuffers(void) {
                                 CFE_SB_BUF_MEMORY_BYTES, 
                                 CFE_ES_MAX_MEMPOOL_BLOCK_SIZES, 
                                 &CFE_SB_MemPoolDefSize[0],
-                                CFE_ES_NO_MUTEX);
+                                CFE_ES_USE_MUTEX);
     
     if(Stat != CFE_SUCCESS){
         CFE_ES_WriteToSysLog("PoolCreate failed for SB Buffers, gave adr 0x%lx,size %d,stat=0x%x\n",
@@ -223,6 +233,7 @@ void CFE_SB_InitPipeTbl(void){
         CFE_SB.PipeTbl[i].SysQueueId    = CFE_SB_UNUSED_QUEUE;
         CFE_SB.PipeTbl[i].PipeId        = CFE_SB_INVALID_PIPE;
         CFE_SB.PipeTbl[i].CurrentBuff   = NULL;
+        CFE_SB.PipeBatch[i].Count       = 0;
         CFE_PSP_MemSet(&CFE_SB.PipeTbl[i].PipeName[0],0,OS_MAX_API_NAME);
     }/* end for */
 
@@ -285,6 +296,7 @@ void CFE_SB_InitRoutingTbl(void){
         CFE_SB.RoutingTbl[i].SeqCnt = 0;
         CFE_SB.RoutingTbl[i].Destinations = 0;
         CFE_SB.RoutingTbl[i].ListHeadPtr = NULL;
+        CFE_SB.RoutingTbl[i].SnapPtr = NULL;
               
     }/* end for */
 
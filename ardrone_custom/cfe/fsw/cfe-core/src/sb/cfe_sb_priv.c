@@ -121,11 +121,94 @@ int32 CFE_SB_CleanUpApp(uint32 AppId){
   /* Release any zero copy buffers */
   CFE_SB_ZeroCopyReleaseAppId(AppId);
 
+  /* Forget the sender information of the app's tasks, their ids get reused */
+  for(i=0;i<OS_MAX_TASKS;i++){
+    if(CFE_SB.SenderRec[i].AppId == AppId){
+      __atomic_store_n(&CFE_SB.SenderRec[i].Valid, FALSE, __ATOMIC_RELEASE);
+    }/* end if */
+  }/* end for */
+
   return CFE_SUCCESS;
 
 }/* end CFE_SB_CleanUpApp */
 
 
+/******************************************************************************
+**  Function:  CFE_SB_RegisterSender()
+**
+**  Purpose:
+**    Look up the app.tsk name and processor id of the calling task once and
+**    keep them for the sender information of the messages it sends.  Called
+**    by ES when a task registers.
+**
+**  Arguments:
+**    None
+**
+**  Return:
+**    None
+*/
+void CFE_SB_RegisterSender(void){
+
+  uint32 TaskId;
+  uint32 Slot;
+
+  TaskId = OS_TaskGetId();
+  OS_ConvertToArrayIndex(TaskId, &Slot);
+  Slot %= OS_MAX_TASKS;
+
+  __atomic_store_n(&CFE_SB.SenderRec[Slot].Valid, FALSE, __ATOMIC_RELEASE);
+  CFE_SB_GetSenderId(TaskId);
+
+}/* end CFE_SB_RegisterSender */
+
+
+/******************************************************************************
+**  Function:  CFE_SB_GetSenderId()
+**
+**  Purpose:
+**    Return the sender information of a task, filling it in if the task has
+**    not registered since it was created.  Only the task itself calls this
+**    for its TaskId, so the record has a single writer.  The record is
+**    rewritten when the task id is reused, so callers copy it out rather
+**    than keep the pointer.
+**
+**  Arguments:
+**    TaskId - the task id of the sender
+**
+**  Return:
+**    Pointer to the sender information
+*/
+CFE_SB_SenderId_t *CFE_SB_GetSenderId(uint32 TaskId){
+
+  uint32              Slot;
+  CFE_SB_SenderRec_t *Rec;
+  CFE_ES_TaskInfo_t   TaskInfo;
+  char                FullName[(OS_MAX_API_NAME * 2)];
+
+  OS_ConvertToArrayIndex(TaskId, &Slot);
+  Rec = &CFE_SB.SenderRec[Slot % OS_MAX_TASKS];
+
+  if(__atomic_load_n(&Rec->Valid, __ATOMIC_ACQUIRE) && (Rec->TaskId == TaskId)){
+    return &Rec->Sender;
+  }/* end if */
+
+  Rec->AppId = 0xFFFFFFFF;
+  if(CFE_ES_GetTaskInfo(&TaskInfo, TaskId) == CFE_SUCCESS){
+    Rec->AppId = TaskInfo.AppId;
+  }/* end if */
+
+  Rec->TaskId = TaskId;
+  Rec->Sender.ProcessorId = CFE_PSP_GetProcessorId();
+  strncpy(&Rec->Sender.AppName[0],CFE_SB_GetAppTskName(TaskId,FullName),OS_MAX_API_NAME-1);
+  Rec->Sender.AppName[OS_MAX_API_NAME-1] = '\0';
+
+  __atomic_store_n(&Rec->Valid, TRUE, __ATOMIC_RELEASE);
+
+  return &Rec->Sender;
+
+}/* end CFE_SB_GetSenderId */
+
+
 /******************************************************************************
 **  Function:  CFE_SB_GetAvailPipeIdx()
 **
@@ -822,6 +905,219 @@ int32 CFE_SB_RemoveDest(uint16 RtgTblIdx, CFE_SB_DestinationD_t *NodeToRemove){
 }/* CFE_SB_RemoveDest */
 
 
+/******************************************************************************
+**  Function:  CFE_SB_RouteSync()
+**
+**  Purpose:
+**      Wait until every task that was inside a route snapshot when this was
+**      called has left it.  Tasks entering after the call are not waited on,
+**      they count against the other epoch.  After CFE_SB_ROUTE_SYNC_SPINS
+**      yields it sleeps a tick at a time, since a yield does not let a lower
+**      priority reader run under a fixed priority scheduler.
+**
+**  Arguments:
+**      None
+**
+**  Return:
+**      None
+*/
+static void CFE_SB_RouteSync(void){
+
+    uint32 OldEpoch;
+    uint32 Spins = 0;
+    uint32 i;
+
+    OldEpoch = __atomic_fetch_add(&CFE_SB.RouteEpoch, 1, __ATOMIC_SEQ_CST) & 1;
+
+    for(i=0;i<CFE_SB_ROUTE_READERS;i++){
+        while(__atomic_load_n(&CFE_SB.RouteReaders[i].Count[OldEpoch], __ATOMIC_SEQ_CST) != 0){
+            if(Spins < CFE_SB_ROUTE_SYNC_SPINS){
+                Spins++;
+                OS_TaskDelay(0);
+            }else{
+                OS_TaskDelay(1);
+            }/* end if */
+        }/* end while */
+    }/* end for */
+
+}/* CFE_SB_RouteSync */
+
+
+
+/******************************************************************************
+**  Function:  CFE_SB_PublishRoute()
+**
+**  Purpose:
+**      Copy the destination list of a routing table entry into its spare
+**      snapshot and make that the one senders use.  Returns once no sender
+**      can still be using the previous snapshot, so destination blocks that
+**      were removed from the list may then be freed.
+**
+**      Must be called with the shared data lock held.
+**
+**  Arguments:
+**      RtgTblIdx - Routing table index
+**
+**  Return:
+**      None
+*/
+void CFE_SB_PublishRoute(uint16 RtgTblIdx){
+
+    CFE_SB_RouteEntry_t   *RtgTblPtr = &CFE_SB.RoutingTbl[RtgTblIdx];
+    CFE_SB_RouteSnap_t    *Snap;
+    CFE_SB_DestinationD_t *DestPtr;
+    uint16                 Count = 0;
+
+    Snap = (RtgTblPtr->SnapPtr == &RtgTblPtr->Snap[0]) ? &RtgTblPtr->Snap[1] : &RtgTblPtr->Snap[0];
+
+    DestPtr = RtgTblPtr->ListHeadPtr;
+    while((DestPtr != NULL)&&(Count < CFE_SB_MAX_DEST_PER_PKT)){
+        Snap->Dest[Count++] = DestPtr;
+        DestPtr = DestPtr->Next;
+    }/* end while */
+
+    Snap->MsgId        = RtgTblPtr->MsgId;
+    Snap->Destinations = Count;
+
+    __atomic_store_n(&RtgTblPtr->SnapPtr, Snap, __ATOMIC_SEQ_CST);
+
+    CFE_SB_RouteSync();
+
+}/* CFE_SB_PublishRoute */
+
+
+
+/******************************************************************************
+**  Function:  CFE_SB_RouteReadBegin()
+**
+**  Purpose:
+**      Enter a route snapshot.  Snapshots and the destination blocks they
+**      point to stay valid until CFE_SB_RouteReadEnd.  May be nested, and
+**      must not be held across anything that takes the shared data lock.
+**
+**  Arguments:
+**      TaskId - Task ID of the caller
+**
+**  Return:
+**      Token to pass to CFE_SB_RouteReadEnd
+*/
+uint32 CFE_SB_RouteReadBegin(uint32 TaskId){
+
+    uint32 Slot;
+    uint32 Epoch;
+
+    OS_ConvertToArrayIndex(TaskId, &Slot);
+    Slot %= CFE_SB_ROUTE_READERS;
+
+    /* retry if a writer moved to the other epoch before we were counted */
+    for(;;){
+        Epoch = __atomic_load_n(&CFE_SB.RouteEpoch, __ATOMIC_SEQ_CST) & 1;
+        __atomic_add_fetch(&CFE_SB.RouteReaders[Slot].Count[Epoch], 1, __ATOMIC_SEQ_CST);
+
+        if((__atomic_load_n(&CFE_SB.RouteEpoch, __ATOMIC_SEQ_CST) & 1) == Epoch){
+            break;
+        }/* end if */
+
+        __atomic_sub_fetch(&CFE_SB.RouteReaders[Slot].Count[Epoch], 1, __ATOMIC_SEQ_CST);
+    }/* end for */
+
+    return (Slot << 1) | Epoch;
+
+}/* CFE_SB_RouteReadBegin */
+
+
+
+/******************************************************************************
+**  Function:  CFE_SB_RouteReadEnd()
+**
+**  Purpose:
+**      Leave a route snapshot entered with CFE_SB_RouteReadBegin.
+**
+**  Arguments:
+**      Token - Value returned by CFE_SB_RouteReadBegin
+**
+**  Return:
+**      None
+*/
+void CFE_SB_RouteReadEnd(uint32 Token){
+
+    __atomic_sub_fetch(&CFE_SB.RouteReaders[Token >> 1].Count[Token & 1], 1, __ATOMIC_SEQ_CST);
+
+}/* CFE_SB_RouteReadEnd */
+
+
+
+/******************************************************************************
+**  Function:  CFE_SB_GetRouteSnap()
+**
+**  Purpose:
+**      Get the route snapshot of a message ID.  Call between
+**      CFE_SB_RouteReadBegin and CFE_SB_RouteReadEnd.
+**
+**  Arguments:
+**      MsgId - ID of the message
+**
+**  Return:
+**      The snapshot, or NULL if there are no subscriptions to the message
+*/
+CFE_SB_RouteSnap_t *CFE_SB_GetRouteSnap(CFE_SB_MsgId_t MsgId){
+
+    CFE_SB_RouteSnap_t *Snap;
+    uint16              Idx;
+
+    Idx = CFE_SB_GetRoutingTblIdx(MsgId);
+    if(Idx >= CFE_SB_MAX_MSG_IDS){
+        return NULL;
+    }/* end if */
+
+    Snap = __atomic_load_n(&CFE_SB.RoutingTbl[Idx].SnapPtr, __ATOMIC_SEQ_CST);
+
+    /* the entry may have been given to another message since the map was read */
+    if((Snap == NULL)||(Snap->MsgId != MsgId)||(Snap->Destinations == 0)){
+        return NULL;
+    }/* end if */
+
+    return Snap;
+
+}/* CFE_SB_GetRouteSnap */
+
+
+
+/******************************************************************************
+**  Function:  CFE_SB_GetRouteDest()
+**
+**  Purpose:
+**      Like CFE_SB_GetDestPtr, but searches the route snapshot.  Call between
+**      CFE_SB_RouteReadBegin and CFE_SB_RouteReadEnd.
+**
+**  Arguments:
+**      MsgId  - ID of the message
+**      PipeId - Pipe ID for the destination
+**
+**  Return:
+**      The destination block, or NULL if the pipe is not subscribed
+*/
+CFE_SB_DestinationD_t *CFE_SB_GetRouteDest(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId){
+
+    CFE_SB_RouteSnap_t *Snap;
+    uint16              i;
+
+    Snap = CFE_SB_GetRouteSnap(MsgId);
+    if(Snap == NULL){
+        return NULL;
+    }/* end if */
+
+    for(i=0;i<Snap->Destinations;i++){
+        if(Snap->Dest[i]->PipeId == PipeId){
+            return Snap->Dest[i];
+        }/* end if */
+    }/* end for */
+
+    return NULL;
+
+}/* CFE_SB_GetRouteDest */
+
+
 /******************************************************************************
 ** Name:    CFE_SB_ZeroCopyReleaseAppId
 **
@@ -152,6 +152,26 @@
 #define CFE_SB_Q_FULL_ERR_EID_BIT       3
 #define CFE_SB_Q_WR_ERR_EID_BIT         4
 
+/* route snapshot readers, one slot per task */
+#define CFE_SB_ROUTE_READERS            OS_MAX_TASKS
+/* yields before CFE_SB_RouteSync sleeps, so lower priority readers get to run */
+#define CFE_SB_ROUTE_SYNC_SPINS         8
+#define CFE_SB_CACHE_LINE_SIZE          64
+
+/*
+** SB buffer cache: freed message buffers are kept for reuse in per-task
+** magazines and in a shared depot per size class.  A class buffer is a pool
+** block of CFE_SB_BUF_CLASS_BLOCK bytes with the descriptor at its first cache
+** line boundary, leaving CFE_SB_BUF_CLASS_SIZE bytes for descriptor and
+** message.  SizeClass in a descriptor is the class plus one, zero for a
+** buffer sized exactly to its message.
+*/
+#define CFE_SB_BUF_CLASSES              5
+#define CFE_SB_BUF_CLASS_BLOCK(c)       (256U << (c))
+#define CFE_SB_BUF_CLASS_SIZE(c)        (CFE_SB_BUF_CLASS_BLOCK(c) - CFE_SB_CACHE_LINE_SIZE)
+#define CFE_SB_BUF_MAG_SIZE             8
+#define CFE_SB_BUF_MAGAZINES            OS_MAX_TASKS
+
 /*
 ** Type Definitions
 */
@@ -173,6 +193,8 @@ typedef struct {
      uint32            Size;
      void              *Buffer;
      CFE_SB_SenderId_t Sender;
+     uint16            SizeClass;
+     void              *Block;
 } CFE_SB_BufferD_t;
 
 
@@ -220,11 +242,30 @@ typedef struct {
 } CFE_SB_ZeroCopyD_t;
 
 
+/******************************************************************************
+**  Typedef:  CFE_SB_RouteSnap_t
+**
+**  Purpose:
+**     This structure holds a copy of the destinations of a routing table entry,
+**     in list order, for senders to use without taking the shared data lock.
+*/
+
+typedef struct {
+     CFE_SB_MsgId_t        MsgId;
+     uint16                Destinations;
+     CFE_SB_DestinationD_t *Dest[CFE_SB_MAX_DEST_PER_PKT];
+} CFE_SB_RouteSnap_t;
+
+
 /******************************************************************************
 **  Typedef:  CFE_SB_RouteEntry_t
 **
 **  Purpose:
 **     This structure defines an entry in the routing table
+**
+**     Senders do not walk the destination list, they walk the snapshot of it
+**     SnapPtr points to.  Subscribe and unsubscribe rebuild the other snapshot
+**     under the shared data lock and swap it in, see CFE_SB_PublishRoute.
 */
 
 typedef struct {
@@ -232,9 +273,80 @@ typedef struct {
      uint16                Destinations;
      uint32                SeqCnt;
      CFE_SB_DestinationD_t *ListHeadPtr;
+     CFE_SB_RouteSnap_t    *SnapPtr;
+     CFE_SB_RouteSnap_t    Snap[2];
 } CFE_SB_RouteEntry_t;
 
 
+/******************************************************************************
+**  Typedef:  CFE_SB_RouteReader_t
+**
+**  Purpose:
+**     Tasks inside a route snapshot, counted per epoch.  Each slot has a
+**     cache line of its own so senders on different tasks do not share one.
+*/
+
+typedef struct {
+     uint32                Count[2];
+} __attribute__((aligned(CFE_SB_CACHE_LINE_SIZE))) CFE_SB_RouteReader_t;
+
+
+/******************************************************************************
+**  Typedef:  CFE_SB_SenderRec_t
+**
+**  Purpose:
+**     The sender information of one task, filled in when the task registers
+**     with ES, or at its first send if it did not, so that a send only
+**     copies it into the buffer descriptor.
+*/
+
+typedef struct {
+     boolean              Valid;
+     uint32               TaskId;
+     uint32               AppId;
+     CFE_SB_SenderId_t    Sender;
+} CFE_SB_SenderRec_t;
+
+
+/******************************************************************************
+**  Typedef:  CFE_SB_BufDepot_t
+**
+**  Purpose:
+**     Free buffers of one size class shared by all tasks, a bounded queue
+**     taken from and added to without a lock.  Each cell's Seq tells whose
+**     turn it is, a putter's at Seq == position, a getter's at position + 1.
+*/
+
+typedef struct {
+     uint32                Seq;
+     CFE_SB_BufferD_t     *Buff;
+} CFE_SB_BufDepotCell_t;
+
+typedef struct {
+     uint32                Head __attribute__((aligned(CFE_SB_CACHE_LINE_SIZE)));
+     uint32                Tail __attribute__((aligned(CFE_SB_CACHE_LINE_SIZE)));
+     CFE_SB_BufDepotCell_t Cell[CFE_SB_BUF_CACHE_DEPTH];
+} CFE_SB_BufDepot_t;
+
+
+/******************************************************************************
+**  Typedef:  CFE_SB_BufMagazine_t
+**
+**  Purpose:
+**     Free buffers of each size class kept by one task, with the task's
+**     cache hit and miss counts.  Owner is set while a task uses it, which
+**     only matters when two callers share an OSAL task ID.
+*/
+
+typedef struct {
+     uint32                Owner;
+     uint32                Hits;
+     uint32                Misses;
+     uint16                Count[CFE_SB_BUF_CLASSES];
+     CFE_SB_BufferD_t     *Buff[CFE_SB_BUF_CLASSES][CFE_SB_BUF_MAG_SIZE];
+} __attribute__((aligned(CFE_SB_CACHE_LINE_SIZE))) CFE_SB_BufMagazine_t;
+
+
 /******************************************************************************
 **  Typedef:  CFE_SB_PipeD_t
 **
@@ -259,6 +371,21 @@ typedef struct {
 } CFE_SB_PipeD_t;
 
 
+/******************************************************************************
+**  Typedef:  CFE_SB_PipeBatch_t
+**
+**  Purpose:
+**     The buffers of the last batch read from a pipe by CFE_SB_RcvMsgBatch,
+**     less the last one which is the pipe's CurrentBuff.  Kept apart from the
+**     pipe descriptor so the pipe info file keeps its layout.
+*/
+
+typedef struct {
+     uint32             Count;
+     CFE_SB_BufferD_t  *Buff[CFE_SB_MAX_RCV_BATCH];
+} CFE_SB_PipeBatch_t;
+
+
 
 /******************************************************************************
 **  Typedef:  CFE_SB_BufParams_t
@@ -298,6 +425,15 @@ typedef struct {
     CFE_SB_PrevSubMsg_t PrevSubMsg;
     CFE_SB_SubRprtMsg_t SubRprtMsg;
     CFE_EVS_BinFilter_t EventFilters[CFE_SB_MAX_CFG_FILE_EVENTS_TO_FILTER];
+    uint32              RouteEpoch;
+    CFE_SB_RouteReader_t RouteReaders[CFE_SB_ROUTE_READERS];
+    CFE_SB_PipeBatch_t  PipeBatch[CFE_SB_MAX_PIPES];
+    CFE_SB_BufDepot_t   BufDepot[CFE_SB_BUF_CLASSES];
+    CFE_SB_BufMagazine_t BufMag[CFE_SB_BUF_MAGAZINES];
+    uint32              BufSpillHits;
+    uint32              BufSpillMisses;
+    CFE_SB_SenderRec_t  SenderRec[OS_MAX_TASKS];
+    CFE_SB_SenderId_t   NoSender;
 }cfe_sb_t;
 
 
@@ -358,6 +494,7 @@ void   CFE_SB_SendStats(void);
 void   CFE_SB_EnableRoute(CFE_SB_MsgPayloadPtr_t Payload);
 void   CFE_SB_DisableRoute(CFE_SB_MsgPayloadPtr_t Payload);
 char   *CFE_SB_GetAppTskName(uint32 TaskId, char* FullName);
+CFE_SB_SenderId_t *CFE_SB_GetSenderId(uint32 TaskId);
 CFE_SB_BufferD_t *CFE_SB_GetBufferFromPool(CFE_SB_MsgId_t MsgId, uint16 size);
 CFE_SB_BufferD_t *CFE_SB_GetBufferFromCaller(CFE_SB_MsgId_t MsgId, void *Address);
 CFE_SB_PipeD_t   *CFE_SB_GetPipePtr(CFE_SB_PipeId_t PipeId);
@@ -383,6 +520,10 @@ int32 CFE_SB_SendMapInfo(const char *Filename);
 int32 CFE_SB_ZeroCopyReleaseDesc(CFE_SB_Msg_t *Ptr2Release, CFE_SB_ZeroCopyHandle_t BufferHandle);
 int32 CFE_SB_ZeroCopyReleaseAppId(uint32         AppId);
 int32 CFE_SB_DecrBufUseCnt(CFE_SB_BufferD_t *bd);
+void  CFE_SB_DecrBufUseCnts(CFE_SB_BufferD_t **bd, uint32 Count);
+void  CFE_SB_InitBufCache(void);
+uint32 CFE_SB_ReclaimBufCache(void);
+void  CFE_SB_GetBufCacheStats(void);
 int32 CFE_SB_ValidateMsgId(CFE_SB_MsgId_t MsgId);
 int32 CFE_SB_ValidatePipeId(CFE_SB_PipeId_t PipeId);
 int32 CFE_SB_GetPktType(CFE_SB_MsgId_t MsgId);
@@ -400,6 +541,65 @@ CFE_SB_DestinationD_t *CFE_SB_GetDestinationBlk(void);
 int32 CFE_SB_PutDestinationBlk(CFE_SB_DestinationD_t *Dest);
 int32 CFE_SB_AddDest(uint16 RtgTblIdx, CFE_SB_DestinationD_t *Dest);
 int32 CFE_SB_RemoveDest(uint16 RtgTblIdx, CFE_SB_DestinationD_t *Dest);
+void  CFE_SB_PublishRoute(uint16 RtgTblIdx);
+uint32 CFE_SB_RouteReadBegin(uint32 TaskId);
+void  CFE_SB_RouteReadEnd(uint32 Token);
+CFE_SB_RouteSnap_t *CFE_SB_GetRouteSnap(CFE_SB_MsgId_t MsgId);
+CFE_SB_DestinationD_t *CFE_SB_GetRouteDest(CFE_SB_MsgId_t MsgId, CFE_SB_PipeId_t PipeId);
+
+/*
+** Counters shared by the send and receive paths are updated with the GCC
+** __atomic builtins, those paths do not hold the shared data lock.
+*/
+#define CFE_SB_ATOMIC_INC(Cnt)      __atomic_add_fetch(&(Cnt), 1, __ATOMIC_RELAXED)
+#define CFE_SB_ATOMIC_DEC(Cnt)      __atomic_sub_fetch(&(Cnt), 1, __ATOMIC_RELAXED)
+#define CFE_SB_ATOMIC_ADD(Cnt,N)    __atomic_add_fetch(&(Cnt), (N), __ATOMIC_RELAXED)
+#define CFE_SB_ATOMIC_SUB(Cnt,N)    __atomic_sub_fetch(&(Cnt), (N), __ATOMIC_RELAXED)
+
+/* Raise a high water mark to Value */
+static inline void CFE_SB_RaisePeak32(uint32 *Peak, uint32 Value)
+{
+    uint32 Old = __atomic_load_n(Peak, __ATOMIC_RELAXED);
+
+    while((Value > Old) &&
+          !__atomic_compare_exchange_n(Peak, &Old, Value, FALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+static inline void CFE_SB_RaisePeak16(uint16 *Peak, uint16 Value)
+{
+    uint16 Old = __atomic_load_n(Peak, __ATOMIC_RELAXED);
+
+    while((Value > Old) &&
+          !__atomic_compare_exchange_n(Peak, &Old, Value, FALSE, __ATOMIC_RELAXED, __ATOMIC_RELAXED));
+}
+
+/* Increment Cnt unless it has reached Limit, returns FALSE if it had */
+static inline boolean CFE_SB_IncrBelowLimit(uint16 *Cnt, uint16 Limit)
+{
+    uint16 Old = __atomic_load_n(Cnt, __ATOMIC_RELAXED);
+
+    do{
+        if(Old >= Limit){
+            return FALSE;
+        }
+    }while(!__atomic_compare_exchange_n(Cnt, &Old, Old + 1, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    return TRUE;
+}
+
+/* Decrement Cnt unless it is zero, returns the value it had */
+static inline uint16 CFE_SB_DecrNonZero(uint16 *Cnt)
+{
+    uint16 Old = __atomic_load_n(Cnt, __ATOMIC_RELAXED);
+
+    do{
+        if(Old == 0){
+            return 0;
+        }
+    }while(!__atomic_compare_exchange_n(Cnt, &Old, Old - 1, FALSE, __ATOMIC_ACQ_REL, __ATOMIC_RELAXED));
+
+    return Old;
+}
 
 /*
  * External variables private to the software bus module
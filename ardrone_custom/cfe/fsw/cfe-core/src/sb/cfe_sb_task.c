@@ -626,6 +626,8 @@ void CFE_SB_DisableRoute(CFE_SB_MsgPayloadPtr_t Payload){
 */
 void CFE_SB_SendStats(void){
 
+    CFE_SB_GetBufCacheStats();
+
     CFE_SB_SendMsg((CFE_SB_Msg_t *)&CFE_SB.StatTlmMsg);
 
     CFE_EVS_SendEvent(CFE_SB_SND_STATS_EID,CFE_EVS_DEBUG,
@@ -97,6 +97,30 @@
     #error CFE_SB_MAX_PIPE_DEPTH cannot be set greater than 65535!
 #endif
 
+#if (CFE_SB_DEFAULT_PIPE_QUEUE != CFE_SB_PIPE_QUEUE_OS) && (CFE_SB_DEFAULT_PIPE_QUEUE != CFE_SB_PIPE_QUEUE_RING)
+    #error CFE_SB_DEFAULT_PIPE_QUEUE must be CFE_SB_PIPE_QUEUE_OS or CFE_SB_PIPE_QUEUE_RING!
+#endif
+
+#if CFE_SB_MAX_RCV_BATCH < 1
+    #error CFE_SB_MAX_RCV_BATCH cannot be less than 1!
+#endif
+
+#if CFE_SB_MAX_RCV_BATCH > 65535
+    #error CFE_SB_MAX_RCV_BATCH cannot be set greater than 65535!
+#endif
+
+#if CFE_SB_BUF_CACHE_DEPTH < 2
+    #error CFE_SB_BUF_CACHE_DEPTH cannot be less than 2!
+#endif
+
+#if CFE_SB_BUF_CACHE_DEPTH > 4096
+    #error CFE_SB_BUF_CACHE_DEPTH cannot be set greater than 4096!
+#endif
+
+#if (CFE_SB_BUF_CACHE_DEPTH & (CFE_SB_BUF_CACHE_DEPTH - 1)) != 0
+    #error CFE_SB_BUF_CACHE_DEPTH must be a power of two!
+#endif
+
 #if CFE_SB_HIGHEST_VALID_MSGID < 1
   #error CFE_SB_HIGHEST_VALID_MSGID cannot be less than 1!
 #endif
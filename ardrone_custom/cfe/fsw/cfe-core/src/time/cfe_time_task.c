@@ -155,11 +155,26 @@ void CFE_TIME_1HzAdjCmd(CFE_SB_MsgPayloadPtr_t PayloadPtr, int16 Direction);
 
 int32 CFE_TIME_EarlyInit(void)
 {
+    int32 Status;
+
     /*
     ** Initialize global Time Services data...
     */
     CFE_TIME_InitData();
 
+    /*
+    ** Updates to the reference may come from the 1Hz ISR before the
+    **    Time Services task starts...
+    */
+    Status = OS_MutSemCreate(&CFE_TIME_TaskData.ReferenceMutex,
+                              CFE_TIME_REF_MUTEX_NAME,
+                              CFE_TIME_REF_MUTEX_OPTIONS);
+    if(Status != OS_SUCCESS)
+    {
+      CFE_ES_WriteToSysLog("TIME:Error creating reference mutex:RC=0x%08X\n",(unsigned int)Status);
+      return Status;
+    }/* end if */
+
     return ( CFE_SUCCESS);
 
 } /* End of CFE_TIME_EarlyInit() */
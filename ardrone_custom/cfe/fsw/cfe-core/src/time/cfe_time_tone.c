@@ -815,6 +815,7 @@ void CFE_TIME_ToneUpdate(void)
     ** Ensure that the change is made without interruption...
     */
     IntFlags = OS_IntLock();
+    CFE_TIME_BeginReferenceUpdate();
 
     #if (CFE_TIME_CFG_SERVER == TRUE)
     /*
@@ -967,7 +968,7 @@ void CFE_TIME_ToneUpdate(void)
     /*
     ** Time has changed, force anyone reading time to retry...
     */
-    CFE_TIME_TaskData.VersionCount++;
+    CFE_TIME_EndReferenceUpdate();
 
     OS_IntUnlock(IntFlags);
 
@@ -1193,6 +1194,8 @@ void CFE_TIME_Local1HzISR(void)
     {
         CFE_TIME_SysTime_t NewSTCF;
 
+        CFE_TIME_BeginReferenceUpdate();
+
         if (CFE_TIME_TaskData.OneHzDirection == CFE_TIME_ADD_ADJUST)
         {
             NewSTCF = CFE_TIME_Add(CFE_TIME_TaskData.AtToneSTCF,
@@ -1209,7 +1212,7 @@ void CFE_TIME_Local1HzISR(void)
         /*
         ** Time has changed, force anyone reading time to retry...
         */
-        CFE_TIME_TaskData.VersionCount++;
+        CFE_TIME_EndReferenceUpdate();
     }
     #endif /* CFE_TIME_CFG_SERVER */
 
@@ -1229,6 +1232,7 @@ void CFE_TIME_Local1HzISR(void)
             /*
             ** Change current state to "fly-wheel"...
             */
+            CFE_TIME_BeginReferenceUpdate();
             CFE_TIME_TaskData.ClockFlyState = CFE_TIME_IS_FLY;
             #if (CFE_TIME_CFG_SERVER == TRUE)
             CFE_TIME_TaskData.ServerFlyState = CFE_TIME_IS_FLY;
@@ -1239,7 +1243,7 @@ void CFE_TIME_Local1HzISR(void)
             /*
             ** Force anyone currently reading time to retry...
             */
-            CFE_TIME_TaskData.VersionCount++;
+            CFE_TIME_EndReferenceUpdate();
         }
     }
 
@@ -1264,13 +1268,14 @@ void CFE_TIME_Local1HzISR(void)
             **    the local clock from completely wrapping around the
             **    time latched at the tone.
             */
+            CFE_TIME_BeginReferenceUpdate();
             CFE_TIME_TaskData.AtToneMET    = Reference.CurrentMET;
             CFE_TIME_TaskData.AtToneLatch  = Reference.CurrentLatch;
 
             /*
             ** Force anyone currently reading time to retry...
             */
-            CFE_TIME_TaskData.VersionCount++;
+            CFE_TIME_EndReferenceUpdate();
         }
     }
 
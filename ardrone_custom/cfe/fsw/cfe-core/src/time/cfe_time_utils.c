@@ -92,6 +92,23 @@ CFE_TIME_SysTime_t CFE_TIME_LatchClock(void)
 {
     CFE_TIME_SysTime_t LatchTime;
     OS_time_t LocalTime;
+    uint32 Upper32;
+    uint32 Lower32;
+
+    /*
+    ** Use the PSP timebase (seconds : ticks) when it has one, it is
+    **    much cheaper to read and convert than the O/S time...
+    */
+    if ((CFE_TIME_TaskData.LatchScale != 0) || (CFE_TIME_TaskData.LatchFraction != 0))
+    {
+        CFE_PSP_Get_Timebase(&Upper32, &Lower32);
+
+        LatchTime.Seconds = Upper32;
+        LatchTime.Subseconds = (Lower32 * CFE_TIME_TaskData.LatchScale) +
+            (uint32) (((uint64) Lower32 * CFE_TIME_TaskData.LatchFraction) >> 32);
+
+        return(LatchTime);
+    }
 
     /*
     ** Get time in O/S format (seconds : microseconds)...
@@ -109,6 +126,43 @@ CFE_TIME_SysTime_t CFE_TIME_LatchClock(void)
 } /* End of CFE_TIME_LatchClock() */
 
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* CFE_TIME_InitLatch() -- select local clock and conversion       */
+/*                                                                 */
+/* A timebase whose lower 32 bits roll over once a second counts   */
+/*    seconds : ticks, so the local clock is latched from it with  */
+/*    the ticks to subseconds factor (2^32 / ticks per second)     */
+/*    computed here, once.  Any other timebase leaves the local    */
+/*    clock to CFE_PSP_GetTime.                                    */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+void CFE_TIME_InitLatch(uint32 TicksPerSecond, uint32 Low32Rollover)
+{
+    uint64 OneSecond = (uint64) 1 << 32;
+
+    /*
+    ** The fraction is rounded up so that exact parts of a second, such
+    **    as a quarter second, convert exactly...
+    */
+    if ((TicksPerSecond > 1) && (Low32Rollover == TicksPerSecond))
+    {
+        CFE_TIME_TaskData.LatchScale    = (uint32) (OneSecond / TicksPerSecond);
+        CFE_TIME_TaskData.LatchFraction =
+            (uint32) ((((OneSecond % TicksPerSecond) << 32) + TicksPerSecond - 1) / TicksPerSecond);
+    }
+    else
+    {
+        CFE_TIME_TaskData.LatchScale    = 0;
+        CFE_TIME_TaskData.LatchFraction = 0;
+    }
+
+    return;
+
+} /* End of CFE_TIME_InitLatch() */
+
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                 */
 /* CFE_TIME_QueryResetVars() -- query contents of Reset Variables  */
@@ -270,6 +324,8 @@ void CFE_TIME_InitData(void)
     /*
     ** Remaining data values used to compute time...
     */
+    CFE_TIME_InitLatch(CFE_PSP_GetTimerTicksPerSecond(), CFE_PSP_GetTimerLow32Rollover());
+    CFE_TIME_TaskData.ReferenceSequence = 0;
     CFE_TIME_TaskData.AtToneLatch = CFE_TIME_LatchClock();
 
     /*
@@ -713,27 +769,51 @@ void CFE_TIME_GetReference(CFE_TIME_Reference_t *Reference)
 {
     CFE_TIME_SysTime_t TimeSinceTone;
     CFE_TIME_SysTime_t CurrentMET;
-    uint32 VersionCount;
+    const CFE_TIME_ToneReference_t *Prior = &CFE_TIME_TaskData.PriorReference;
+    uint32 Sequence;
 
     /*
-    ** VersionCount is incremented when reference data is modified...
+    ** ReferenceSequence is odd while reference data is being modified,
+    **    when the values from before the change are read instead, and
+    **    changes once the modification is done.  Retry only if it
+    **    changed while copying, never wait for the update to finish...
     */
     do
     {
-        VersionCount = CFE_TIME_TaskData.VersionCount;
+        Sequence = __atomic_load_n(&CFE_TIME_TaskData.ReferenceSequence, __ATOMIC_ACQUIRE);
 
         Reference->CurrentLatch = CFE_TIME_LatchClock();
 
-        Reference->AtToneMET    = CFE_TIME_TaskData.AtToneMET;
-        Reference->AtToneSTCF   = CFE_TIME_TaskData.AtToneSTCF;
-        Reference->AtToneLeaps  = CFE_TIME_TaskData.AtToneLeaps;
-        Reference->AtToneDelay  = CFE_TIME_TaskData.AtToneDelay;
-        Reference->AtToneLatch  = CFE_TIME_TaskData.AtToneLatch;
+        if ((Sequence & 1) == 0)
+        {
+            Reference->AtToneMET    = CFE_TIME_TaskData.AtToneMET;
+            Reference->AtToneSTCF   = CFE_TIME_TaskData.AtToneSTCF;
+            Reference->AtToneLeaps  = CFE_TIME_TaskData.AtToneLeaps;
+            Reference->AtToneDelay  = CFE_TIME_TaskData.AtToneDelay;
+            Reference->AtToneLatch  = CFE_TIME_TaskData.AtToneLatch;
+
+            Reference->ClockSetState  = CFE_TIME_TaskData.ClockSetState;
+            Reference->ClockFlyState  = CFE_TIME_TaskData.ClockFlyState;
+
+            Reference->DelayDirection = CFE_TIME_TaskData.DelayDirection;
+        }
+        else
+        {
+            Reference->AtToneMET    = Prior->AtToneMET;
+            Reference->AtToneSTCF   = Prior->AtToneSTCF;
+            Reference->AtToneLeaps  = Prior->AtToneLeaps;
+            Reference->AtToneDelay  = Prior->AtToneDelay;
+            Reference->AtToneLatch  = Prior->AtToneLatch;
+
+            Reference->ClockSetState  = Prior->ClockSetState;
+            Reference->ClockFlyState  = Prior->ClockFlyState;
+
+            Reference->DelayDirection = Prior->DelayDirection;
+        }
 
-        Reference->ClockSetState  = CFE_TIME_TaskData.ClockSetState;
-        Reference->ClockFlyState  = CFE_TIME_TaskData.ClockFlyState;
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
 
-    } while (VersionCount != CFE_TIME_TaskData.VersionCount);
+    } while (Sequence != __atomic_load_n(&CFE_TIME_TaskData.ReferenceSequence, __ATOMIC_RELAXED));
 
     /*
     ** Compute the amount of time "since" the tone...
@@ -766,7 +846,7 @@ void CFE_TIME_GetReference(CFE_TIME_Reference_t *Reference)
     ** Synchronize "this" time client to the time server...
     */
     #if (CFE_TIME_CFG_CLIENT == TRUE)
-    if (CFE_TIME_TaskData.DelayDirection == CFE_TIME_ADD_ADJUST)
+    if (Reference->DelayDirection == CFE_TIME_ADD_ADJUST)
     {
         CurrentMET = CFE_TIME_Add(CurrentMET, Reference->AtToneDelay);
     }
@@ -783,6 +863,72 @@ void CFE_TIME_GetReference(CFE_TIME_Reference_t *Reference)
 } /* End of CFE_TIME_GetReference() */
 
 
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* CFE_TIME_BeginReferenceUpdate() -- start changing "AtTone" data */
+/*                                                                 */
+/* Keeps a copy of the reference data for readers to use until     */
+/*    CFE_TIME_EndReferenceUpdate().  Updates are made one at a    */
+/*    time.  Callers hold OS_IntLock, or are the 1Hz ISR, which    */
+/*    keeps out other writers when the ISR is a real interrupt.    */
+/*    With OSAL_THREAD_TIMERS the 1Hz ISR runs on the OSAL timer   */
+/*    thread instead, so the reference mutex is taken as well.     */
+/*    It is never taken in interrupt context.                      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+void CFE_TIME_BeginReferenceUpdate(void)
+{
+    CFE_TIME_ToneReference_t *Prior = &CFE_TIME_TaskData.PriorReference;
+
+    #ifdef OSAL_THREAD_TIMERS
+    OS_MutSemTake(CFE_TIME_TaskData.ReferenceMutex);
+    #endif
+
+    Prior->AtToneMET      = CFE_TIME_TaskData.AtToneMET;
+    Prior->AtToneSTCF     = CFE_TIME_TaskData.AtToneSTCF;
+    Prior->AtToneLeaps    = CFE_TIME_TaskData.AtToneLeaps;
+    Prior->AtToneDelay    = CFE_TIME_TaskData.AtToneDelay;
+    Prior->AtToneLatch    = CFE_TIME_TaskData.AtToneLatch;
+    Prior->ClockSetState  = CFE_TIME_TaskData.ClockSetState;
+    Prior->ClockFlyState  = CFE_TIME_TaskData.ClockFlyState;
+    Prior->DelayDirection = CFE_TIME_TaskData.DelayDirection;
+
+    /*
+    ** Copy is complete before readers are sent to it, and readers are
+    **    sent to it before the reference data starts changing...
+    */
+    __atomic_store_n(&CFE_TIME_TaskData.ReferenceSequence,
+                     CFE_TIME_TaskData.ReferenceSequence | 1, __ATOMIC_RELEASE);
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    return;
+
+} /* End of CFE_TIME_BeginReferenceUpdate() */
+
+
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+/*                                                                 */
+/* CFE_TIME_EndReferenceUpdate() -- publish new "AtTone" data      */
+/*                                                                 */
+/* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
+
+void CFE_TIME_EndReferenceUpdate(void)
+{
+    CFE_TIME_TaskData.VersionCount++;
+
+    __atomic_store_n(&CFE_TIME_TaskData.ReferenceSequence,
+                     CFE_TIME_TaskData.ReferenceSequence + 1, __ATOMIC_RELEASE);
+
+    #ifdef OSAL_THREAD_TIMERS
+    OS_MutSemGive(CFE_TIME_TaskData.ReferenceMutex);
+    #endif
+
+    return;
+
+} /* End of CFE_TIME_EndReferenceUpdate() */
+
+
 /* * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * * */
 /*                                                                 */
 /* CFE_TIME_CalculateTAI() -- calculate TAI from reference data    */
@@ -887,6 +1033,7 @@ void CFE_TIME_SetState(int16 NewState)
     int32 IntFlags;
 
     IntFlags = OS_IntLock();
+    CFE_TIME_BeginReferenceUpdate();
 
     /*
     ** If we get a command to set the clock to "flywheel" mode, then
@@ -915,7 +1062,7 @@ void CFE_TIME_SetState(int16 NewState)
     /*
     ** Time has changed, force anyone reading time to retry...
     */
-    CFE_TIME_TaskData.VersionCount++;
+    CFE_TIME_EndReferenceUpdate();
     OS_IntUnlock(IntFlags);
 
     return;
@@ -937,13 +1084,14 @@ void CFE_TIME_SetSource(int16 NewSource)
     ** Ensure that change is made without interruption...
     */
     IntFlags = OS_IntLock();
+    CFE_TIME_BeginReferenceUpdate();
 
     CFE_TIME_TaskData.ClockSource = NewSource;
 
     /*
     ** Time has changed, force anyone reading time to retry...
     */
-    CFE_TIME_TaskData.VersionCount++;
+    CFE_TIME_EndReferenceUpdate();
     OS_IntUnlock(IntFlags);
 
     return;
@@ -971,6 +1119,7 @@ void CFE_TIME_SetSignal(int16 NewSignal)
     ** Ensure that change is made without interruption...
     */
     IntFlags = OS_IntLock();
+    CFE_TIME_BeginReferenceUpdate();
 
     /*
     ** Maintain current tone signal selection for telemetry...
@@ -980,7 +1129,7 @@ void CFE_TIME_SetSignal(int16 NewSignal)
     /*
     ** Time has changed, force anyone reading time to retry...
     */
-    CFE_TIME_TaskData.VersionCount++;
+    CFE_TIME_EndReferenceUpdate();
     OS_IntUnlock(IntFlags);
 
     return;
@@ -1003,6 +1152,7 @@ void CFE_TIME_SetDelay(CFE_TIME_SysTime_t NewDelay, int16 Direction)
     ** Ensure that change is made without interruption...
     */
     IntFlags = OS_IntLock();
+    CFE_TIME_BeginReferenceUpdate();
 
     CFE_TIME_TaskData.AtToneDelay = NewDelay;
     CFE_TIME_TaskData.DelayDirection = Direction;
@@ -1010,7 +1160,7 @@ void CFE_TIME_SetDelay(CFE_TIME_SysTime_t NewDelay, int16 Direction)
     /*
     ** Time has changed, force anyone reading time to retry...
     */
-    CFE_TIME_TaskData.VersionCount++;
+    CFE_TIME_EndReferenceUpdate();
     OS_IntUnlock(IntFlags);
 
     return;
@@ -1058,13 +1208,14 @@ void CFE_TIME_SetTime(CFE_TIME_SysTime_t NewTime)
     ** Ensure that change is made without interruption...
     */
     IntFlags = OS_IntLock();
+    CFE_TIME_BeginReferenceUpdate();
 
     CFE_TIME_TaskData.AtToneSTCF = NewSTCF;
 
     /*
     ** Time has changed, force anyone reading time to retry...
     */
-    CFE_TIME_TaskData.VersionCount++;
+    CFE_TIME_EndReferenceUpdate();
     OS_IntUnlock(IntFlags);
 
     return;
@@ -1092,6 +1243,7 @@ void CFE_TIME_SetMET(CFE_TIME_SysTime_t NewMET)
     ** Ensure that change is made without interruption...
     */
     IntFlags = OS_IntLock();
+    CFE_TIME_BeginReferenceUpdate();
 
     /*
     ** Update reference values used to compute current time...
@@ -1110,7 +1262,7 @@ void CFE_TIME_SetMET(CFE_TIME_SysTime_t NewMET)
     /*
     ** Time has changed, force anyone reading time to retry...
     */
-    CFE_TIME_TaskData.VersionCount++;
+    CFE_TIME_EndReferenceUpdate();
     OS_IntUnlock(IntFlags);
 
     return;
@@ -1133,13 +1285,14 @@ void CFE_TIME_SetSTCF(CFE_TIME_SysTime_t NewSTCF)
     ** Ensure that change is made without interruption...
     */
     IntFlags = OS_IntLock();
+    CFE_TIME_BeginReferenceUpdate();
 
     CFE_TIME_TaskData.AtToneSTCF = NewSTCF;
 
     /*
     ** Time has changed, force anyone reading time to retry...
     */
-    CFE_TIME_TaskData.VersionCount++;
+    CFE_TIME_EndReferenceUpdate();
     OS_IntUnlock(IntFlags);
 
     return;
@@ -1162,13 +1315,14 @@ void CFE_TIME_SetLeaps(int16 NewLeaps)
     ** Ensure that change is made without interruption...
     */
     IntFlags = OS_IntLock();
+    CFE_TIME_BeginReferenceUpdate();
 
     CFE_TIME_TaskData.AtToneLeaps = NewLeaps;
 
     /*
     ** Time has changed, force anyone reading time to retry...
     */
-    CFE_TIME_TaskData.VersionCount++;
+    CFE_TIME_EndReferenceUpdate();
     OS_IntUnlock(IntFlags);
 
     return;
@@ -1193,6 +1347,7 @@ void CFE_TIME_SetAdjust(CFE_TIME_SysTime_t NewAdjust, int16 Direction)
     ** Ensure that change is made without interruption...
     */
     IntFlags = OS_IntLock();
+    CFE_TIME_BeginReferenceUpdate();
 
     CFE_TIME_TaskData.OneTimeAdjust    = NewAdjust;
     CFE_TIME_TaskData.OneTimeDirection = Direction;
@@ -1211,7 +1366,7 @@ void CFE_TIME_SetAdjust(CFE_TIME_SysTime_t NewAdjust, int16 Direction)
     /*
     ** Time has changed, force anyone reading time to retry...
     */
-    CFE_TIME_TaskData.VersionCount++;
+    CFE_TIME_EndReferenceUpdate();
     OS_IntUnlock(IntFlags);
 
     return;
@@ -1234,6 +1389,7 @@ void CFE_TIME_Set1HzAdj(CFE_TIME_SysTime_t NewAdjust, int16 Direction)
     ** Ensure that change is made without interruption...
     */
     IntFlags = OS_IntLock();
+    CFE_TIME_BeginReferenceUpdate();
 
     /*
     ** Store values for 1Hz adjustment...
@@ -1244,7 +1400,7 @@ void CFE_TIME_Set1HzAdj(CFE_TIME_SysTime_t NewAdjust, int16 Direction)
     /*
     ** Time has changed, force anyone reading time to retry...
     */
-    CFE_TIME_TaskData.VersionCount++;
+    CFE_TIME_EndReferenceUpdate();
     OS_IntUnlock(IntFlags);
 
     return;
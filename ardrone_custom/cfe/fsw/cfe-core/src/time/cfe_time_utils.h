@@ -101,6 +101,12 @@
 #define CFE_TIME_SEM_VALUE       0
 #define CFE_TIME_SEM_OPTIONS     0
 
+/*
+** Reference update mutex definitions...
+*/
+#define CFE_TIME_REF_MUTEX_NAME    "TIME_REF_MUTEX"
+#define CFE_TIME_REF_MUTEX_OPTIONS 0
+
 /*
 ** Main Task Pipe definitions...
 */
@@ -130,6 +136,7 @@ typedef struct
   int16                 AtToneLeaps;    /* Leap Seconds at time of tone */
   int16                 ClockSetState;  /* Time has been "set" */
   int16                 ClockFlyState;  /* Current fly-wheel state */
+  int16                 DelayDirection; /* Add or subtract the tone delay */
   CFE_TIME_SysTime_t    AtToneDelay;    /* Adjustment for slow tone detection */
   CFE_TIME_SysTime_t    AtToneLatch;    /* Local clock latched at time of tone */
   CFE_TIME_SysTime_t    CurrentLatch;   /* Local clock latched just "now" */
@@ -138,6 +145,23 @@ typedef struct
 
 } CFE_TIME_Reference_t;
 
+/*
+** Type definition (copy of the "AtTone" values kept while they change)...
+*/
+typedef struct
+{
+
+  CFE_TIME_SysTime_t    AtToneMET;      /* MET at time of tone */
+  CFE_TIME_SysTime_t    AtToneSTCF;     /* STCF at time of tone */
+  int16                 AtToneLeaps;    /* Leap Seconds at time of tone */
+  int16                 ClockSetState;  /* Time has been "set" */
+  int16                 ClockFlyState;  /* Current fly-wheel state */
+  int16                 DelayDirection; /* Add or subtract the tone delay */
+  CFE_TIME_SysTime_t    AtToneDelay;    /* Adjustment for slow tone detection */
+  CFE_TIME_SysTime_t    AtToneLatch;    /* Local clock latched at time of tone */
+
+} CFE_TIME_ToneReference_t;
+
 /*
 ** Time Synchronization Callback Registry Information
 */
@@ -253,6 +277,23 @@ typedef struct
   */
   CFE_TIME_SysTime_t    MaxLocalClock;
 
+  /*
+  ** Reference sequence, odd while the "AtTone" values are being changed,
+  **    and the copy of the values from before the change that readers
+  **    use meanwhile.  The mutex keeps the changes one at a time...
+  */
+  uint32                   ReferenceSequence;
+  CFE_TIME_ToneReference_t PriorReference;
+  uint32                   ReferenceMutex;
+
+  /*
+  ** Local clock latched from the PSP timebase (seconds : ticks) as
+  **    ticks * (LatchScale + LatchFraction / 2^32) subseconds, or
+  **    from CFE_PSP_GetTime when both are zero...
+  */
+  uint32                LatchScale;
+  uint32                LatchFraction;
+
   /*
   ** Clock state has been commanded into (CFE_TIME_FLYWHEEL)...
   */
@@ -339,6 +380,7 @@ extern CFE_TIME_TaskData_t CFE_TIME_TaskData;
 ** Function prototypes (get local clock)...
 */
 CFE_TIME_SysTime_t CFE_TIME_LatchClock(void);
+void CFE_TIME_InitLatch(uint32 TicksPerSecond, uint32 Low32Rollover);
 
 /*
 ** Function prototypes (Time Services utilities data)...
@@ -356,6 +398,8 @@ void CFE_TIME_GetHkData(const CFE_TIME_Reference_t *Reference);
 ** Function prototypes (reference)...
 */
 void CFE_TIME_GetReference(CFE_TIME_Reference_t *Reference);
+void CFE_TIME_BeginReferenceUpdate(void);
+void CFE_TIME_EndReferenceUpdate(void);
 
 /*
 ** Function prototypes (calculate TAI/UTC)...
@@ -208,6 +208,27 @@ void ES_ResetUnitTest(void)
     }
 } /* end ES_ResetUnitTest() */
 
+/*
+** Start a new performance log collection with every ring already holding
+** TriggerCount entries added after the trigger
+*/
+void ES_UT_SetPerfRings(uint32 TriggerCount)
+{
+    int j;
+
+    Perf->Generation++;
+
+    for (j = 0; j < CFE_ES_PERF_DATA_RINGS; j++)
+    {
+        Perf->Ring[j].Owner = 0;
+        Perf->Ring[j].Generation = Perf->Generation;
+        Perf->Ring[j].Next = 0;
+        Perf->Ring[j].Count = 0;
+        Perf->Ring[j].TriggerCount = TriggerCount;
+        Perf->Ring[j].Added = 0;
+    }
+} /* end ES_UT_SetPerfRings() */
+
 void TestInit(void)
 {
 #ifdef UT_VERBOSE
@@ -3228,7 +3249,7 @@ void TestTask(void)
 
     /* Test the command pipe message process with an invalid command */
     ES_ResetUnitTest();
-    UT_SendMsg(msgptr, CFE_ES_CMD_MID, CFE_ES_DUMP_CDS_REG_CC + 2);
+    UT_SendMsg(msgptr, CFE_ES_CMD_MID, CFE_ES_PERF_SETLATMARKER_CC + 1);
     UT_Report(__FILE__, __LINE__,
               SendMsgEventIDRtn.value == CFE_ES_CC1_ERR_EID,
               "CFE_ES_TaskPipe",
@@ -3527,6 +3548,7 @@ void TestTask(void)
 
 void TestPerf(void)
 {
+    uint32 i;
     uint32 Id;
     uint32 TestObjId;
     CFE_SB_MsgPtr_t msgptr;
@@ -3534,6 +3556,8 @@ void TestPerf(void)
     CFE_ES_PerfStopCmd_t PerfStopCmd;
     CFE_ES_PerfSetFilterMaskCmd_t PerfSetFilterMaskCmd;
     CFE_ES_PerfSetTrigMaskCmd_t PerfSetTrigMaskCmd;
+    CFE_ES_PerfSetLatMarkerCmd_t PerfSetLatMarkerCmd;
+    CFE_ES_PerfLatency_t Latency[CFE_ES_PERF_LATENCY_SLOTS];
 
     extern CFE_ES_PerfLogDump_t CFE_ES_PerfLogDumpStatus;
 
@@ -3597,7 +3621,7 @@ void TestPerf(void)
      * (too high)
      */
     ES_ResetUnitTest();
-    PerfStartCmd.Payload.TriggerMode = (CFE_ES_PERF_TRIGGER_END + 1);
+    PerfStartCmd.Payload.TriggerMode = CFE_ES_PERF_MAX_MODES;
     UT_SetSBTotalMsgLen(sizeof(CFE_ES_PerfStartCmd_t));
     msgptr = (CFE_SB_MsgPtr_t) &PerfStartCmd;
     UT_SendMsg(msgptr, CFE_ES_CMD_MID, CFE_ES_PERF_STARTDATA_CC);
@@ -3619,6 +3643,52 @@ void TestPerf(void)
               "CFE_ES_PerfStartDataCmd",
               "Trigger mode out of range (low)");
 
+    /* Test successful performance data collection start in STREAM mode */
+    ES_ResetUnitTest();
+    OS_TaskCreate(&TestObjId, "UT", NULL, NULL, 0, 0, 0);
+    Id = ES_UT_OSALID_TO_ARRAYIDX(TestObjId);
+    CFE_ES_Global.TaskTable[Id].RecordUsed = TRUE;
+    CFE_ES_Global.AppTable[Id].TaskInfo.MainTaskId = TestObjId;
+    CFE_ES_Global.AppTable[Id].RecordUsed = TRUE;
+    CFE_ES_Global.TaskTable[Id].AppId = Id;
+    CFE_ES_PerfStreamStatus.Running = 0;
+    PerfStartCmd.Payload.TriggerMode = CFE_ES_PERF_STREAM;
+    UT_SetSBTotalMsgLen(sizeof(CFE_ES_PerfStartCmd_t));
+    msgptr = (CFE_SB_MsgPtr_t) &PerfStartCmd;
+    UT_SendMsg(msgptr, CFE_ES_CMD_MID, CFE_ES_PERF_STARTDATA_CC);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == CFE_ES_PERF_STARTCMD_EID &&
+              CFE_ES_PerfStreamStatus.Running == 1 &&
+              Perf->MetaData.State == CFE_ES_PERF_WAITING_FOR_TRIGGER,
+              "CFE_ES_PerfStartDataCmd",
+              "Collect performance data; mode STREAM");
+
+    /* Test performance data collection start in STREAM mode with the
+     * streaming child task still running
+     */
+    ES_ResetUnitTest();
+    UT_SetOSFail(OS_TASKCREATE_FAIL);
+    UT_SendMsg(msgptr, CFE_ES_CMD_MID, CFE_ES_PERF_STARTDATA_CC);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == CFE_ES_PERF_STARTCMD_EID &&
+              CFE_ES_PerfStreamStatus.Running == 1,
+              "CFE_ES_PerfStartDataCmd",
+              "Mode STREAM; streaming child task already running");
+
+    /* Test performance data collection start in STREAM mode with an OS task
+     * create failure
+     */
+    ES_ResetUnitTest();
+    CFE_ES_PerfStreamStatus.Running = 0;
+    UT_SetOSFail(OS_TASKCREATE_FAIL);
+    UT_SendMsg(msgptr, CFE_ES_CMD_MID, CFE_ES_PERF_STARTDATA_CC);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == CFE_ES_PERF_STREAM_ERR_EID &&
+              CFE_ES_PerfStreamStatus.Running == 0 &&
+              Perf->MetaData.State == CFE_ES_PERF_IDLE,
+              "CFE_ES_PerfStartDataCmd",
+              "Mode STREAM; OS task create fail");
+
     /* Test performance data collection start with a file write in progress */
     ES_ResetUnitTest();
     CFE_ES_PerfLogDumpStatus.DataToWrite = 1;
@@ -3773,7 +3843,9 @@ void TestPerf(void)
     /* Test performance log dump with a cFE header write failure */
     ES_ResetUnitTest();
     CFE_ES_PerfLogDumpStatus.DataFileDescriptor = OS_open(NULL, 0, 0);
-    Perf->MetaData.DataCount = 7;
+    Perf->Ring[0].Generation = Perf->Generation;
+    Perf->Ring[0].Next = 7;
+    Perf->Ring[0].Count = 7;
     UT_SetRtnCode(&FileWriteRtn, sizeof(CFE_ES_PerfDataEntry_t), 4);
     UT_SetRtnCode(&FSWriteHdrRtn, -1, 1);
     CFE_ES_PerfLogDump();
@@ -3788,7 +3860,9 @@ void TestPerf(void)
     /* Test performance log dump with a metadata write failure */
     ES_ResetUnitTest();
     CFE_ES_PerfLogDumpStatus.DataFileDescriptor = OS_open(NULL, 0, 0);
-    Perf->MetaData.DataCount = 7;
+    Perf->Ring[0].Generation = Perf->Generation;
+    Perf->Ring[0].Next = 7;
+    Perf->Ring[0].Count = 7;
     UT_SetOSFail(OS_CREAT_FAIL | OS_WRITE_FAIL);
     CFE_ES_PerfLogDump();
     UT_GetStubRetcodeAndCount(UT_KEY(OS_close), &OSCloseRtn.value,
@@ -3802,7 +3876,9 @@ void TestPerf(void)
     /* Test performance log dump with a data write failure */
     ES_ResetUnitTest();
     CFE_ES_PerfLogDumpStatus.DataFileDescriptor = OS_open(NULL, 0, 0);
-    Perf->MetaData.DataCount = 7;
+    Perf->Ring[0].Generation = Perf->Generation;
+    Perf->Ring[0].Next = 7;
+    Perf->Ring[0].Count = 7;
     UT_SetRtnCode(&FileWriteRtn, sizeof(CFE_ES_PerfDataEntry_t) + 1, 4);
     CFE_ES_PerfLogDump();
     UT_GetStubRetcodeAndCount(UT_KEY(OS_close), &OSCloseRtn.value,
@@ -3831,8 +3907,8 @@ void TestPerf(void)
     ES_ResetUnitTest();
     Perf->MetaData.InvalidMarkerReported = TRUE;
     Perf->MetaData.Mode = CFE_ES_PERF_TRIGGER_START;
-    Perf->MetaData.DataCount = CFE_ES_PERF_DATA_BUFFER_SIZE + 1;
     Perf->MetaData.TriggerMask[0] = 0xFFFF;
+    ES_UT_SetPerfRings(CFE_ES_PERF_RING_SIZE - 1);
     CFE_ES_PerfLogAdd(1, 0);
     UT_Report(__FILE__, __LINE__,
               Perf->MetaData.Mode == CFE_ES_PERF_TRIGGER_START &&
@@ -3846,7 +3922,7 @@ void TestPerf(void)
     ES_ResetUnitTest();
     Perf->MetaData.State = CFE_ES_PERF_TRIGGERED;
     Perf->MetaData.Mode = CFE_ES_PERF_TRIGGER_CENTER;
-    Perf->MetaData.TriggerCount = CFE_ES_PERF_DATA_BUFFER_SIZE / 2 + 1 ;
+    ES_UT_SetPerfRings(CFE_ES_PERF_RING_SIZE / 2 - 1);
     CFE_ES_PerfLogAdd(1, 0);
     UT_Report(__FILE__, __LINE__,
               Perf->MetaData.Mode == CFE_ES_PERF_TRIGGER_CENTER &&
@@ -3897,9 +3973,10 @@ void TestPerf(void)
      */
     ES_ResetUnitTest();
     Perf->MetaData.State = CFE_ES_PERF_WAITING_FOR_TRIGGER;
-    Perf->MetaData.DataCount = 0;
     Perf->MetaData.FilterMask[0] = 0xffff;
+    Perf->Generation++;
     CFE_ES_PerfLogAdd(0x1, 0);
+    CFE_ES_PerfLogTally();
     UT_Report(__FILE__, __LINE__,
               Perf->MetaData.DataCount == 1,
               "CFE_ES_PerfLogAdd",
@@ -3921,11 +3998,12 @@ void TestPerf(void)
      * trigger mode and the trigger count is less the buffer size
      */
     ES_ResetUnitTest();
-    Perf->MetaData.TriggerCount = 0;
     Perf->MetaData.State = CFE_ES_PERF_TRIGGERED;
     Perf->MetaData.Mode = CFE_ES_PERF_TRIGGER_START;
     Perf->MetaData.TriggerMask[0] = 0xffff;
+    Perf->Generation++;
     CFE_ES_PerfLogAdd(0x1, 0);
+    CFE_ES_PerfLogTally();
     UT_Report(__FILE__, __LINE__,
               Perf->MetaData.TriggerCount == 1,
               "CFE_ES_PerfLogAdd",
@@ -3935,9 +4013,9 @@ void TestPerf(void)
      * trigger mode and the trigger count is less than half the buffer size
      */
     ES_ResetUnitTest();
-    Perf->MetaData.TriggerCount = CFE_ES_PERF_DATA_BUFFER_SIZE / 2 - 2;
     Perf->MetaData.State = CFE_ES_PERF_TRIGGERED;
     Perf->MetaData.Mode = CFE_ES_PERF_TRIGGER_CENTER;
+    ES_UT_SetPerfRings(CFE_ES_PERF_RING_SIZE / 2 - 2);
     CFE_ES_PerfLogAdd(0x1, 0);
     UT_Report(__FILE__, __LINE__,
               Perf->MetaData.State != CFE_ES_PERF_IDLE,
@@ -3958,6 +4036,229 @@ void TestPerf(void)
               "CFE_ES_PerfLogAdd",
               "Invalid trigger mode");
 
+    /* Test addition of a new entry to the performance log while another
+     * task is adding to the calling task's ring
+     */
+    ES_ResetUnitTest();
+    Perf->MetaData.State = CFE_ES_PERF_WAITING_FOR_TRIGGER;
+    Perf->MetaData.TriggerMask[0] = 0x0;
+    ES_UT_SetPerfRings(0);
+    Perf->Ring[OS_TaskGetId() % CFE_ES_PERF_DATA_RINGS].Owner = 1;
+    CFE_ES_PerfLogAdd(0x1, 0);
+    UT_Report(__FILE__, __LINE__,
+              Perf->Ring[OS_TaskGetId() % CFE_ES_PERF_DATA_RINGS].Count == 0 &&
+              Perf->Ring[(OS_TaskGetId() + 1) % CFE_ES_PERF_DATA_RINGS].Count == 1 &&
+              Perf->Ring[(OS_TaskGetId() + 1) % CFE_ES_PERF_DATA_RINGS].Owner == 0,
+              "CFE_ES_PerfLogAdd",
+              "Busy ring skipped");
+
+    /* Test addition of a new entry to the performance log while every ring
+     * is busy
+     */
+    ES_ResetUnitTest();
+    Perf->MetaData.State = CFE_ES_PERF_WAITING_FOR_TRIGGER;
+    ES_UT_SetPerfRings(0);
+    Perf->LostCount = 0;
+
+    for (i = 0; i < CFE_ES_PERF_DATA_RINGS; i++)
+    {
+        Perf->Ring[i].Owner = 1;
+    }
+
+    CFE_ES_PerfLogAdd(0x1, 0);
+    CFE_ES_PerfLogTally();
+    UT_Report(__FILE__, __LINE__,
+              Perf->LostCount == 1 && Perf->MetaData.DataCount == 0,
+              "CFE_ES_PerfLogAdd",
+              "Every ring busy");
+
+    /* Test addition of a new entry to a performance log ring left over from
+     * an earlier collection
+     */
+    ES_ResetUnitTest();
+    Perf->MetaData.State = CFE_ES_PERF_WAITING_FOR_TRIGGER;
+    ES_UT_SetPerfRings(0);
+    Perf->Ring[OS_TaskGetId() % CFE_ES_PERF_DATA_RINGS].Generation--;
+    Perf->Ring[OS_TaskGetId() % CFE_ES_PERF_DATA_RINGS].Next = 5;
+    Perf->Ring[OS_TaskGetId() % CFE_ES_PERF_DATA_RINGS].Count = 5;
+    CFE_ES_PerfLogAdd(0x1, 0);
+    UT_Report(__FILE__, __LINE__,
+              Perf->Ring[OS_TaskGetId() % CFE_ES_PERF_DATA_RINGS].Generation == Perf->Generation &&
+              Perf->Ring[OS_TaskGetId() % CFE_ES_PERF_DATA_RINGS].Next == 1 &&
+              Perf->Ring[OS_TaskGetId() % CFE_ES_PERF_DATA_RINGS].Count == 1,
+              "CFE_ES_PerfLogAdd",
+              "Ring from an earlier collection emptied");
+
+    /* Test addition of a new entry to a full performance log ring */
+    ES_ResetUnitTest();
+    Perf->MetaData.State = CFE_ES_PERF_WAITING_FOR_TRIGGER;
+    ES_UT_SetPerfRings(0);
+    Perf->Ring[OS_TaskGetId() % CFE_ES_PERF_DATA_RINGS].Next = CFE_ES_PERF_RING_SIZE - 1;
+    Perf->Ring[OS_TaskGetId() % CFE_ES_PERF_DATA_RINGS].Count = CFE_ES_PERF_RING_SIZE;
+    CFE_ES_PerfLogAdd(0x1, 0);
+    UT_Report(__FILE__, __LINE__,
+              Perf->Ring[OS_TaskGetId() % CFE_ES_PERF_DATA_RINGS].Next == 0 &&
+              Perf->Ring[OS_TaskGetId() % CFE_ES_PERF_DATA_RINGS].Count == CFE_ES_PERF_RING_SIZE,
+              "CFE_ES_PerfLogAdd",
+              "Full ring wraps");
+
+    /* Test the performance log metadata counts with rings from this and an
+     * earlier collection
+     */
+    ES_ResetUnitTest();
+    ES_UT_SetPerfRings(0);
+    Perf->Ring[0].Generation--;
+    Perf->Ring[0].Count = 5;
+    Perf->Ring[1].Count = 3;
+    Perf->Ring[1].TriggerCount = 2;
+    CFE_ES_PerfLogTally();
+    UT_Report(__FILE__, __LINE__,
+              Perf->MetaData.DataCount == 3 && Perf->MetaData.DataStart == 0 &&
+              Perf->MetaData.DataEnd == 3 && Perf->MetaData.TriggerCount == 2,
+              "CFE_ES_PerfLogTally",
+              "Earlier collection not counted");
+
+    /* Test streaming the performance log, more entries than fit in a
+     * packet
+     */
+    ES_ResetUnitTest();
+    ES_UT_SetPerfRings(0);
+    CFE_ES_PerfStreamStatus.PacketCount = 0;
+    Perf->Ring[0].Added = CFE_ES_PERF_STREAM_PKT_ENTRIES + 3;
+    CFE_ES_PerfStreamDrain();
+    UT_Report(__FILE__, __LINE__,
+              CFE_ES_PerfStreamStatus.PacketCount == 2 &&
+              CFE_ES_PerfStreamStatus.Sent[0] == CFE_ES_PERF_STREAM_PKT_ENTRIES + 3 &&
+              CFE_ES_PerfStreamStatus.Packet.Payload.FirstEntry == CFE_ES_PERF_STREAM_PKT_ENTRIES &&
+              CFE_ES_PerfStreamStatus.Packet.Payload.EntryCount == 3 &&
+              CFE_ES_PerfStreamStatus.LostCount == 0,
+              "CFE_ES_PerfStreamDrain",
+              "Entries sent in two packets");
+
+    /* Test streaming the performance log again with nothing added */
+    CFE_ES_PerfStreamDrain();
+    UT_Report(__FILE__, __LINE__,
+              CFE_ES_PerfStreamStatus.PacketCount == 2,
+              "CFE_ES_PerfStreamDrain",
+              "Nothing added; nothing sent");
+
+    /* Test streaming a performance log ring that overwrote entries before
+     * they were sent
+     */
+    ES_ResetUnitTest();
+    ES_UT_SetPerfRings(0);
+    Perf->Ring[1].Added = CFE_ES_PERF_RING_SIZE + 10;
+    CFE_ES_PerfStreamDrain();
+    UT_Report(__FILE__, __LINE__,
+              CFE_ES_PerfStreamStatus.Sent[1] == CFE_ES_PERF_RING_SIZE + 10 &&
+              CFE_ES_PerfStreamStatus.SentPos[1] == 10 &&
+              CFE_ES_PerfStreamStatus.Lost[1] == 11 &&
+              CFE_ES_PerfStreamStatus.LostCount == 11 &&
+              CFE_ES_PerfStreamStatus.Packet.Payload.Lost == 11,
+              "CFE_ES_PerfStreamDrain",
+              "Overwritten entries lost");
+
+    /* Test the latency of a performance marker measured from the stream */
+    ES_ResetUnitTest();
+    ES_UT_SetPerfRings(0);
+    Perf->MetaData.TimerTicksPerSecond = 1000000000;
+    Perf->MetaData.TimerLow32Rollover = 1000000000;
+    CFE_ES_PerfStreamStatus.Latency[0].Marker = 5;
+    CFE_ES_PerfStreamStatus.Latency[1].Marker = CFE_ES_PERF_NO_MARKER;
+    Perf->DataBuffer[0].Data = 5 | (1 << CFE_ES_PERF_EXIT_BIT);
+    Perf->DataBuffer[1].Data = 5;
+    Perf->DataBuffer[1].TimerUpper32 = 1;
+    Perf->DataBuffer[1].TimerLower32 = 999750000;
+    Perf->DataBuffer[2].Data = 5 | (1 << CFE_ES_PERF_EXIT_BIT);
+    Perf->DataBuffer[2].TimerUpper32 = 2;
+    Perf->DataBuffer[2].TimerLower32 = 0;
+    Perf->DataBuffer[3].Data = 5;
+    Perf->DataBuffer[3].TimerUpper32 = 3;
+    Perf->DataBuffer[3].TimerLower32 = 0;
+    Perf->DataBuffer[4].Data = 5 | (1 << CFE_ES_PERF_EXIT_BIT);
+    Perf->DataBuffer[4].TimerUpper32 = 3;
+    Perf->DataBuffer[4].TimerLower32 = 1000000;
+    Perf->Ring[0].Added = 5;
+    CFE_ES_PerfStreamDrain();
+    CFE_ES_PerfLatencyReport(Latency);
+    UT_Report(__FILE__, __LINE__,
+              Latency[0].Marker == 5 && Latency[0].Count == 2 &&
+              Latency[0].MinTime == 250 && Latency[0].MaxTime == 1000 &&
+              Latency[0].MeanTime == 625 && Latency[0].P99Time == 1000 &&
+              Latency[1].Marker == CFE_ES_PERF_NO_MARKER && Latency[1].Count == 0,
+              "CFE_ES_PerfLatencyReport",
+              "Latency of the streamed entries");
+
+    /* Test the last pass of the streaming child task once collection
+     * stopped
+     */
+    ES_ResetUnitTest();
+    Perf->MetaData.State = CFE_ES_PERF_IDLE;
+    Perf->MetaData.Mode = CFE_ES_PERF_STREAM;
+    CFE_ES_PerfStreamStatus.Running = 1;
+    Perf->Ring[0].Added = 7;
+    CFE_ES_PerfStreamer();
+    UT_Report(__FILE__, __LINE__,
+              CFE_ES_PerfStreamStatus.Running == 0 &&
+              CFE_ES_PerfStreamStatus.Sent[0] == 7,
+              "CFE_ES_PerfStreamer",
+              "Last pass after collection stopped");
+
+    /* Test successful performance latency marker command */
+    ES_ResetUnitTest();
+    PerfSetLatMarkerCmd.Payload.LatencySlot = CFE_ES_PERF_LATENCY_SLOTS - 1;
+    PerfSetLatMarkerCmd.Payload.Marker = CFE_ES_PERF_MAX_IDS - 1;
+    UT_SetSBTotalMsgLen(sizeof(CFE_ES_PerfSetLatMarkerCmd_t));
+    msgptr = (CFE_SB_MsgPtr_t) &PerfSetLatMarkerCmd;
+    UT_SendMsg(msgptr, CFE_ES_CMD_MID, CFE_ES_PERF_SETLATMARKER_CC);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == CFE_ES_PERF_LATMRKCMD_EID &&
+              CFE_ES_PerfStreamStatus.Latency[CFE_ES_PERF_LATENCY_SLOTS - 1].Marker == CFE_ES_PERF_MAX_IDS - 1 &&
+              CFE_ES_PerfStreamStatus.Latency[CFE_ES_PERF_LATENCY_SLOTS - 1].Measured == CFE_ES_PERF_NO_MARKER,
+              "CFE_ES_PerfSetLatMarkerCmd",
+              "Set performance latency marker command received");
+
+    /* Test performance latency marker command leaving a slot unused */
+    ES_ResetUnitTest();
+    PerfSetLatMarkerCmd.Payload.Marker = CFE_ES_PERF_NO_MARKER;
+    UT_SendMsg(msgptr, CFE_ES_CMD_MID, CFE_ES_PERF_SETLATMARKER_CC);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == CFE_ES_PERF_LATMRKCMD_EID &&
+              CFE_ES_PerfStreamStatus.Latency[CFE_ES_PERF_LATENCY_SLOTS - 1].Marker == CFE_ES_PERF_NO_MARKER,
+              "CFE_ES_PerfSetLatMarkerCmd",
+              "Set performance latency slot unused");
+
+    /* Test performance latency marker command with an out of range slot */
+    ES_ResetUnitTest();
+    PerfSetLatMarkerCmd.Payload.LatencySlot = CFE_ES_PERF_LATENCY_SLOTS;
+    PerfSetLatMarkerCmd.Payload.Marker = 1;
+    UT_SendMsg(msgptr, CFE_ES_CMD_MID, CFE_ES_PERF_SETLATMARKER_CC);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == CFE_ES_PERF_LATMRKERR_EID,
+              "CFE_ES_PerfSetLatMarkerCmd",
+              "Performance latency marker command error; slot out of range");
+
+    /* Test performance latency marker command with an out of range marker */
+    ES_ResetUnitTest();
+    PerfSetLatMarkerCmd.Payload.LatencySlot = 0;
+    PerfSetLatMarkerCmd.Payload.Marker = CFE_ES_PERF_MAX_IDS;
+    UT_SendMsg(msgptr, CFE_ES_CMD_MID, CFE_ES_PERF_SETLATMARKER_CC);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == CFE_ES_PERF_LATMRKERR_EID,
+              "CFE_ES_PerfSetLatMarkerCmd",
+              "Performance latency marker command error; marker out of range");
+
+    /* Test performance latency marker command with an invalid message
+     * length
+     */
+    ES_ResetUnitTest();
+    UT_SetSBTotalMsgLen(sizeof(CFE_ES_PerfSetLatMarkerCmd_t) + 1);
+    UT_SendMsg(msgptr, CFE_ES_CMD_MID, CFE_ES_PERF_SETLATMARKER_CC);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value != CFE_ES_PERF_LATMRKCMD_EID,
+              "CFE_ES_PerfSetLatMarkerCmd",
+              "Invalid message length");
+
     /* Test performance data collection start with an invalid message length */
     ES_ResetUnitTest();
     UT_SetSBTotalMsgLen(sizeof(CFE_ES_PerfStartCmd_t) + 1);
@@ -63,6 +63,7 @@ void OS_Application_Startup(void)
     UT_ADD_TEST(Test_Format);
     UT_ADD_TEST(Test_Ports);
     UT_ADD_TEST(Test_Logging);
+    UT_ADD_TEST(Test_Deferred);
     UT_ADD_TEST(Test_WriteApp);
     UT_ADD_TEST(Test_BadAppCmd);
     UT_ADD_TEST(Test_EventCmd);
@@ -942,6 +943,10 @@ void Test_Logging(void)
     CFE_EVS_LogFileCmd_t logfilecmd;
     cpuaddr              TempAddr;
     CFE_ES_ResetData_t   *CFE_EVS_ResetDataPtr;
+    CFE_EVS_Log_t        *LogPtr;
+    uint32               Ticket;
+    uint32               Entry;
+    uint16               Overflow;
 
 #ifdef UT_VERBOSE
     UT_Text("Begin Test Logging\n");
@@ -1020,6 +1025,74 @@ void Test_Logging(void)
               "CFE_EVS_SetLoggingModeCmd",
               "Log overfill event (overwrite mode)");
 
+    /* Test adding an event to an entry another task is still writing */
+    UT_InitData();
+    LogPtr = CFE_EVS_GlobalData.EVS_LogPtr;
+    Ticket = LogPtr->Ticket;
+    Entry = (Ticket >> 1) % CFE_EVS_LOG_MAX;
+    LogPtr->EntryTicket[Entry] = Ticket - (2 * CFE_EVS_LOG_MAX) + 1;
+    Overflow = LogPtr->LogOverflowCounter;
+    CFE_EVS_SendEvent(0, CFE_EVS_INFORMATION, "Log entry being written");
+    UT_Report(__FILE__, __LINE__,
+              LogPtr->Ticket == Ticket + 2 &&
+              LogPtr->EntryTicket[Entry] == Ticket - (2 * CFE_EVS_LOG_MAX) + 1 &&
+              LogPtr->LogOverflowCounter == Overflow + 2,
+              "EVS_AddLog",
+              "Log entry still being written, event counted as overflow");
+
+    /* Test adding an event to an entry a later ticket already has */
+    UT_InitData();
+    LogPtr->EntryTicket[Entry] = Ticket + (2 * CFE_EVS_LOG_MAX) + 4;
+    LogPtr->Ticket = Ticket;
+    CFE_EVS_SendEvent(0, CFE_EVS_INFORMATION, "Log entry already taken");
+    UT_Report(__FILE__, __LINE__,
+              LogPtr->EntryTicket[Entry] == Ticket + (2 * CFE_EVS_LOG_MAX) + 4 &&
+              LogPtr->LogOverflowCounter == Overflow + 4,
+              "EVS_AddLog",
+              "Log entry taken by a later ticket, event counted as overflow");
+
+    /* Test adding an event once the entry is free again */
+    UT_InitData();
+    LogPtr->EntryTicket[Entry] = Ticket - (2 * CFE_EVS_LOG_MAX) + 2;
+    LogPtr->Ticket = Ticket;
+    CFE_EVS_SendEvent(0, CFE_EVS_INFORMATION, "Log entry free");
+    UT_Report(__FILE__, __LINE__,
+              LogPtr->EntryTicket[Entry] == Ticket + 2 &&
+              LogPtr->Next == (Entry + 1) % CFE_EVS_LOG_MAX &&
+              LogPtr->LogCount == CFE_EVS_LOG_MAX &&
+              LogPtr->LogOverflowCounter == Overflow + 5,
+              "EVS_AddLog",
+              "Log entry added with the next ticket");
+
+    /* Test writing the log skips an entry still being written */
+    UT_InitData();
+    UT_SetRtnCode(&MutSemCreateRtn, OS_SUCCESS, 1);
+    LogPtr->EntryTicket[Entry] = Ticket + 1;
+    logfilecmd.Payload.LogFilename[0] = '\0';
+    UT_Report(__FILE__, __LINE__,
+              CFE_EVS_WriteLogFileCmd((CFE_SB_MsgPayloadPtr_t) &logfilecmd.Payload) == TRUE &&
+              SendMsgEventIDRtn.value == CFE_EVS_WRLOG_EID,
+              "CFE_EVS_WriteLogFileCmd",
+              "Write event log with an entry being written");
+
+    /* Test restoring the log drops an entry being written at the reset */
+    UT_InitData();
+    UT_Report(__FILE__, __LINE__,
+              EVS_RestoreLog() == TRUE &&
+              LogPtr->EntryTicket[Entry] == LogPtr->FirstTicket &&
+              LogPtr->LogFullFlag == TRUE,
+              "EVS_RestoreLog",
+              "Entry being written at reset dropped");
+
+    /* Test restoring the log with tickets that are not valid */
+    UT_InitData();
+    LogPtr->Ticket++;
+    UT_Report(__FILE__, __LINE__,
+              EVS_RestoreLog() == FALSE,
+              "EVS_RestoreLog",
+              "Event log tickets not valid");
+    LogPtr->Ticket--;
+
     /* Test writing to the log while it is disabled */
     UT_InitData();
     CFE_EVS_GlobalData.EVS_TlmPkt.Payload.LogEnabled = FALSE;
@@ -1140,6 +1213,244 @@ void Test_Logging(void)
               "Write single event log entry - write header failed");
 }
 
+/*
+** Test deferred format events
+*/
+void Test_Deferred(void)
+{
+    int                      i;
+    int                      Count;
+    uint32                   Hash;
+    uint32                   Entry;
+    char                     long_msg[CFE_EVS_MAX_MESSAGE_LENGTH + 2];
+    char                     spec[32];
+    CFE_TIME_SysTime_t       time = {0, 0};
+    CFE_EVS_ModeCmd_t        modecmd;
+    CFE_EVS_LogFileCmd_t     logfilecmd;
+    CFE_EVS_DeferredPacket_t DeferredPacket;
+    CFE_EVS_Packet_t         TextPacket;
+
+#ifdef UT_VERBOSE
+    UT_Text("Begin Test Deferred\n");
+#endif
+
+    /* Test set event format mode command using the first invalid mode */
+    UT_InitData();
+    modecmd.Payload.Mode = CFE_EVS_DEFERRED_FORMAT + 1;
+    UT_SetSBTotalMsgLen(sizeof(CFE_EVS_ModeCmd_t));
+    UT_SendMsg((CFE_SB_MsgPtr_t) &modecmd, CFE_EVS_CMD_MID,
+               CFE_EVS_SET_EVENT_FORMAT_MODE_CC);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == CFE_EVS_ERR_ILLEGALFMTMOD_EID,
+              "CFE_EVS_SetEventFormatModeCmd",
+              "Set event format mode command: invalid event format mode = 3");
+
+    /* Test set event format mode command using a valid command to set
+     * deferred format
+     */
+    UT_InitData();
+    modecmd.Payload.Mode = CFE_EVS_DEFERRED_FORMAT;
+    UT_SendMsg((CFE_SB_MsgPtr_t) &modecmd, CFE_EVS_CMD_MID,
+               CFE_EVS_SET_EVENT_FORMAT_MODE_CC);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == CFE_EVS_SETEVTFMTMOD_EID &&
+              CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageFormatMode ==
+                  CFE_EVS_DEFERRED_FORMAT,
+              "CFE_EVS_SetEventFormatModeCmd",
+              "Set event format mode command: deferred format");
+
+    /* Test sending an event in deferred format; the arguments are packed
+     * and the packet is logged as it is
+     */
+    UT_InitData();
+    CFE_EVS_GlobalData.EVS_LogPtr->LogMode = CFE_EVS_LOG_OVERWRITE;
+    CFE_EVS_SendEvent(7, CFE_EVS_INFORMATION, "Deferred %d %s %5.2f %%",
+                      42, "abc", 1.5);
+    Entry = (CFE_EVS_GlobalData.EVS_LogPtr->Next + CFE_EVS_LOG_MAX - 1) %
+            CFE_EVS_LOG_MAX;
+    CFE_PSP_MemCpy(&DeferredPacket,
+                   &CFE_EVS_GlobalData.EVS_LogPtr->LogEntry[Entry],
+                   sizeof(DeferredPacket));
+    EVS_DeferSpec(0, "Deferred %d %s %5.2f %%", &Hash);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == 7 &&
+              SendMsgEventIDRtn.count == 1 &&
+              CFE_SB_GetMsgId((CFE_SB_Msg_t *) &DeferredPacket) ==
+                  CFE_EVS_DEFERRED_EVENT_MSG_MID &&
+              DeferredPacket.Payload.SpecHash == Hash &&
+              DeferredPacket.Payload.ArgLength == 8 + 4 + 8 &&
+              DeferredPacket.Payload.Flags == 0,
+              "CFE_EVS_SendEvent",
+              "Deferred format event packed and logged");
+
+    /* Test formatting the deferred event matches the text format */
+    UT_InitData();
+    UT_Report(__FILE__, __LINE__,
+              EVS_FormatDeferredPacket(&DeferredPacket, &TextPacket) == TRUE &&
+              CFE_SB_GetMsgId((CFE_SB_Msg_t *) &TextPacket) ==
+                  CFE_EVS_EVENT_MSG_MID &&
+              TextPacket.Payload.PacketID.EventID == 7 &&
+              strcmp(TextPacket.Payload.Message, "Deferred 42 abc  1.50 %") == 0,
+              "EVS_FormatDeferredPacket",
+              "Deferred format event formatted");
+
+    /* Test '*' width and precision arguments and long long arguments */
+    UT_InitData();
+    CFE_EVS_SendEventWithAppID(8, CFE_EVS_INFORMATION, 0,
+                               "%*d|%-*s|%.*f|%llx", 4, 7, 3, "ab", 1, 2.25,
+                               0x123456789ULL);
+    Entry = (CFE_EVS_GlobalData.EVS_LogPtr->Next + CFE_EVS_LOG_MAX - 1) %
+            CFE_EVS_LOG_MAX;
+    CFE_PSP_MemCpy(&DeferredPacket,
+                   &CFE_EVS_GlobalData.EVS_LogPtr->LogEntry[Entry],
+                   sizeof(DeferredPacket));
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == 8 &&
+              DeferredPacket.Payload.ArgLength == 8 + 8 + 8 + 3 + 8 + 8 + 8 &&
+              EVS_FormatDeferredPacket(&DeferredPacket, &TextPacket) == TRUE &&
+              strcmp(TextPacket.Payload.Message,
+                     "   7|ab |2.2|123456789") == 0,
+              "CFE_EVS_SendEventWithAppID",
+              "Deferred format event with '*' arguments");
+
+    /* Test string arguments that do not fit are truncated */
+    UT_InitData();
+
+    for (i = 0; i <= CFE_EVS_MAX_MESSAGE_LENGTH; i++)
+    {
+        long_msg[i] = (char)(i % 10 + 48);
+    }
+
+    long_msg[CFE_EVS_MAX_MESSAGE_LENGTH + 1] = '\0';
+    Count = CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageTruncCounter;
+    CFE_EVS_SendTimedEvent(time, 9, CFE_EVS_INFORMATION, "%d %s", 1,
+                           long_msg);
+    Entry = (CFE_EVS_GlobalData.EVS_LogPtr->Next + CFE_EVS_LOG_MAX - 1) %
+            CFE_EVS_LOG_MAX;
+    CFE_PSP_MemCpy(&DeferredPacket,
+                   &CFE_EVS_GlobalData.EVS_LogPtr->LogEntry[Entry],
+                   sizeof(DeferredPacket));
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == 9 &&
+              CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageTruncCounter ==
+                  Count + 1 &&
+              DeferredPacket.Payload.Flags == CFE_EVS_DEFERRED_TRUNCATED &&
+              DeferredPacket.Payload.ArgLength == CFE_EVS_DEFERRED_ARG_LENGTH &&
+              EVS_FormatDeferredPacket(&DeferredPacket, &TextPacket) == TRUE &&
+              TextPacket.Payload.Message[strlen(TextPacket.Payload.Message) - 1] ==
+                  CFE_EVS_MSG_TRUNCATED,
+              "CFE_EVS_SendTimedEvent",
+              "Deferred format event with truncated arguments");
+
+    /* Test an event whose format string cannot be deferred is sent as
+     * text
+     */
+    UT_InitData();
+    CFE_EVS_SendEvent(10, CFE_EVS_INFORMATION, "Not deferred %ls", L"x");
+    Entry = (CFE_EVS_GlobalData.EVS_LogPtr->Next + CFE_EVS_LOG_MAX - 1) %
+            CFE_EVS_LOG_MAX;
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == 10 &&
+              CFE_SB_GetMsgId((CFE_SB_Msg_t *)
+                  &CFE_EVS_GlobalData.EVS_LogPtr->LogEntry[Entry]) ==
+                  CFE_EVS_EVENT_MSG_MID &&
+              EVS_DeferSpec(0, "Not deferred %ls", &Hash) == FALSE,
+              "CFE_EVS_SendEvent",
+              "Format string not deferred sent as text");
+
+    /* Test formatting a deferred event whose format string is not known */
+    UT_InitData();
+    DeferredPacket.Payload.SpecHash = Hash + 1;
+    UT_Report(__FILE__, __LINE__,
+              EVS_FormatDeferredPacket(&DeferredPacket, &TextPacket) == FALSE &&
+              strncmp(TextPacket.Payload.Message, "Deferred event format", 21) == 0,
+              "EVS_FormatDeferredPacket",
+              "Deferred format event with unknown format string");
+
+    /* Test deferred format events are formatted for the output ports */
+    UT_InitData();
+    UT_SetRtnCode(&OSPrintRtn, 0, 0);
+    CFE_EVS_GlobalData.EVS_TlmPkt.Payload.OutputPort = CFE_EVS_PORT1_BIT;
+    CFE_EVS_SendEvent(11, CFE_EVS_INFORMATION, "Deferred port %u", 5);
+    CFE_EVS_GlobalData.EVS_TlmPkt.Payload.OutputPort = 0;
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == 11 &&
+              OSPrintRtn.value == OS_PRINT_INCR &&
+              OSPrintRtn.count == 1,
+              "CFE_EVS_SendEvent",
+              "Deferred format event output via port");
+
+    /* Test writing the event log with known and unknown deferred entries */
+    UT_InitData();
+    UT_SetRtnCode(&MutSemCreateRtn, OS_SUCCESS, 1);
+    CFE_PSP_MemCpy(&CFE_EVS_GlobalData.EVS_LogPtr->LogEntry[Entry],
+                   &DeferredPacket, sizeof(DeferredPacket));
+    logfilecmd.Payload.LogFilename[0] = '\0';
+    UT_Report(__FILE__, __LINE__,
+              CFE_EVS_WriteLogFileCmd((CFE_SB_MsgPayloadPtr_t) &logfilecmd.Payload) == TRUE,
+              "CFE_EVS_WriteLogFileCmd",
+              "Write event log with deferred format entries");
+
+    /* Test the format strings of an app are removed when it is cleaned up,
+     * so another format string at the same address is not taken for one
+     */
+    UT_InitData();
+    strcpy(spec, "Removed %d");
+    CFE_EVS_SendEvent(12, CFE_EVS_INFORMATION, spec, 1);
+    Entry = (CFE_EVS_GlobalData.EVS_LogPtr->Next + CFE_EVS_LOG_MAX - 1) %
+            CFE_EVS_LOG_MAX;
+    CFE_PSP_MemCpy(&DeferredPacket,
+                   &CFE_EVS_GlobalData.EVS_LogPtr->LogEntry[Entry],
+                   sizeof(DeferredPacket));
+    Hash = DeferredPacket.Payload.SpecHash;
+    CFE_EVS_CleanUpApp(0);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == 12 &&
+              EVS_FindSpec(Hash) == NULL &&
+              EVS_FormatDeferredPacket(&DeferredPacket, &TextPacket) == FALSE,
+              "CFE_EVS_CleanUpApp",
+              "Deferred format strings of app removed");
+
+    UT_InitData();
+    CFE_EVS_Register(NULL, 0, CFE_EVS_BINARY_FILTER);
+    CFE_EVS_GlobalData.AppData[0].EventTypesActiveFlag |= CFE_EVS_DEBUG_BIT;
+    strcpy(spec, "Reused %s");
+    CFE_EVS_SendEvent(13, CFE_EVS_INFORMATION, spec, "abc");
+    Entry = (CFE_EVS_GlobalData.EVS_LogPtr->Next + CFE_EVS_LOG_MAX - 1) %
+            CFE_EVS_LOG_MAX;
+    CFE_PSP_MemCpy(&DeferredPacket,
+                   &CFE_EVS_GlobalData.EVS_LogPtr->LogEntry[Entry],
+                   sizeof(DeferredPacket));
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == 13 &&
+              DeferredPacket.Payload.SpecHash != Hash &&
+              DeferredPacket.Payload.ArgLength == 4 &&
+              EVS_FormatDeferredPacket(&DeferredPacket, &TextPacket) == TRUE &&
+              strcmp(TextPacket.Payload.Message, "Reused abc") == 0,
+              "CFE_EVS_SendEvent",
+              "Deferred format string at the address of a removed one");
+
+    /* Test a removed format string is filled in again when it is sent */
+    UT_InitData();
+    strcpy(long_msg, "Removed %d");
+    CFE_EVS_SendEvent(14, CFE_EVS_INFORMATION, long_msg, 2);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == 14 &&
+              EVS_FindSpec(Hash) == long_msg,
+              "CFE_EVS_SendEvent",
+              "Removed deferred format string filled in again");
+
+    /* Return to long format */
+    UT_InitData();
+    modecmd.Payload.Mode = CFE_EVS_LONG_FORMAT;
+    UT_SendMsg((CFE_SB_MsgPtr_t) &modecmd, CFE_EVS_CMD_MID,
+               CFE_EVS_SET_EVENT_FORMAT_MODE_CC);
+    UT_Report(__FILE__, __LINE__,
+              SendMsgEventIDRtn.value == CFE_EVS_SETEVTFMTMOD_EID,
+              "CFE_EVS_SetEventFormatModeCmd",
+              "Set event format mode command: long format");
+}
+
 /*
 ** Test writing application data
 */
@@ -1835,6 +2146,10 @@ void Test_EventCmd(void)
 void Test_FilterCmd(void)
 {
     int                             i;
+    uint32                          AppID;
+    uint32                          Sequence;
+    EVS_AppData_t                   *AppDataPtr;
+    CFE_EVS_BinFilter_t             filter[4];
     CFE_EVS_AppNameCmd_t            appnamecmd;
     CFE_EVS_AppNameEventIDMaskCmd_t appmaskcmd;
     CFE_EVS_AppNameEventIDCmd_t     appcmdcmd;
@@ -2028,8 +2343,12 @@ void Test_FilterCmd(void)
     UT_SetSBTotalMsgLen(sizeof(CFE_EVS_AppNameEventIDMaskCmd_t));
     UT_SendMsg((CFE_SB_MsgPtr_t) &appcmdcmd, CFE_EVS_CMD_MID,
                CFE_EVS_ADD_EVENT_FILTER_CC);
+    CFE_ES_GetAppID(&AppID);
+    AppDataPtr = &CFE_EVS_GlobalData.AppData[AppID];
     UT_Report(__FILE__, __LINE__,
-              SendMsgEventIDRtn.value == CFE_EVS_ADDFILTER_EID,
+              SendMsgEventIDRtn.value == CFE_EVS_ADDFILTER_EID &&
+              AppDataPtr->FilterIndex[AppDataPtr->FilterSequence & 1].Count == 1 &&
+              EVS_FindFilter(AppDataPtr, 0) != NULL,
               "CFE_EVS_AddEventFilterCmd",
               "Add event filter - successful");
 
@@ -2048,10 +2367,81 @@ void Test_FilterCmd(void)
     UT_SendMsg((CFE_SB_MsgPtr_t) &appcmdcmd, CFE_EVS_CMD_MID,
                CFE_EVS_DELETE_EVENT_FILTER_CC);
     UT_Report(__FILE__, __LINE__,
-              SendMsgEventIDRtn.value == CFE_EVS_DELFILTER_EID,
+              SendMsgEventIDRtn.value == CFE_EVS_DELFILTER_EID &&
+              AppDataPtr->FilterIndex[AppDataPtr->FilterSequence & 1].Count == 0 &&
+              EVS_FindFilter(AppDataPtr, 0) == NULL,
               "CFE_EVS_DeleteEventFilterCmd",
               "Delete filter - successful");
 
+    /* Test the filter index finds filters registered out of event ID order,
+     * the first of two filters for the same event ID, and no others
+     */
+    UT_InitData();
+    filter[0].EventID = 30;
+    filter[0].Mask = CFE_EVS_EVERY_OTHER_ONE;
+    filter[1].EventID = -5;
+    filter[1].Mask = CFE_EVS_NO_FILTER;
+    filter[2].EventID = 10;
+    filter[2].Mask = CFE_EVS_FIRST_ONE_STOP;
+    filter[3].EventID = 30;
+    filter[3].Mask = CFE_EVS_NO_FILTER;
+    CFE_EVS_Register(filter, 4, CFE_EVS_BINARY_FILTER);
+    UT_Report(__FILE__, __LINE__,
+              AppDataPtr->FilterIndex[AppDataPtr->FilterSequence & 1].Count == 4 &&
+              EVS_FindFilter(AppDataPtr, -5) == &AppDataPtr->BinFilters[1] &&
+              EVS_FindFilter(AppDataPtr, 10) == &AppDataPtr->BinFilters[2] &&
+              EVS_FindFilter(AppDataPtr, 30) == &AppDataPtr->BinFilters[0] &&
+              EVS_FindFilter(AppDataPtr, 20) == NULL &&
+              EVS_FindFilter(AppDataPtr, 31) == NULL &&
+              EVS_FindFilter(AppDataPtr, CFE_EVS_FREE_SLOT) == NULL,
+              "EVS_FindFilter",
+              "Filters found by event ID");
+
+    /* Test the filter index is rebuilt aside, leaving the one in use as is
+     * until the new one is published
+     */
+    UT_InitData();
+    Sequence = AppDataPtr->FilterSequence;
+    AppDataPtr->BinFilters[1].EventID = CFE_EVS_FREE_SLOT;
+    EVS_IndexFilters(AppDataPtr);
+    UT_Report(__FILE__, __LINE__,
+              AppDataPtr->FilterSequence == Sequence + 1 &&
+              AppDataPtr->FilterIndex[Sequence & 1].Count == 4 &&
+              AppDataPtr->FilterIndex[Sequence & 1].EventID[0] == -5 &&
+              AppDataPtr->FilterIndex[(Sequence + 1) & 1].Count == 3 &&
+              EVS_FindFilter(AppDataPtr, -5) == NULL &&
+              EVS_FindFilter(AppDataPtr, 10) == &AppDataPtr->BinFilters[2],
+              "EVS_IndexFilters",
+              "Rebuilt index published");
+
+    AppDataPtr->BinFilters[1].EventID = -5;
+    EVS_IndexFilters(AppDataPtr);
+
+    /* Test events are filtered through the index */
+    UT_InitData();
+    UT_Report(__FILE__, __LINE__,
+              EVS_IsFiltered(AppID, 10, CFE_EVS_INFORMATION) == FALSE &&
+              EVS_IsFiltered(AppID, 10, CFE_EVS_INFORMATION) == TRUE &&
+              EVS_IsFiltered(AppID, 30, CFE_EVS_INFORMATION) == FALSE &&
+              EVS_IsFiltered(AppID, 30, CFE_EVS_INFORMATION) == TRUE &&
+              EVS_IsFiltered(AppID, 20, CFE_EVS_INFORMATION) == FALSE &&
+              EVS_IsFiltered(AppID, 20, CFE_EVS_INFORMATION) == FALSE,
+              "EVS_IsFiltered",
+              "Events filtered by indexed filters");
+
+    /* Test events of disabled and invalid event types are filtered */
+    UT_InitData();
+    EVS_DisableTypes(CFE_EVS_DEBUG_BIT, AppID);
+    UT_Report(__FILE__, __LINE__,
+              EVS_IsFiltered(AppID, 20, CFE_EVS_DEBUG) == TRUE &&
+              EVS_IsFiltered(AppID, 20, CFE_EVS_CRITICAL) == FALSE &&
+              EVS_IsFiltered(AppID, 20, 0) == TRUE &&
+              EVS_IsFiltered(AppID, 20, CFE_EVS_CRITICAL + 1) == TRUE &&
+              EVS_IsFiltered(AppID, 20, 0xFFFF) == TRUE,
+              "EVS_IsFiltered",
+              "Disabled and invalid event types filtered");
+    EVS_EnableTypes(CFE_EVS_DEBUG_BIT, AppID);
+
     /* Return application to original state, re-register application */
     UT_InitData();
     UT_Report(__FILE__, __LINE__,
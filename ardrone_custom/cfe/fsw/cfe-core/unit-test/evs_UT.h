@@ -216,6 +216,28 @@ void Test_Ports(void);
 ******************************************************************************/
 void Test_Logging(void);
 
+/*****************************************************************************/
+/**
+** \brief Test deferred format events
+**
+** \par Description
+**        This function tests sending events in the deferred format, and
+**        formatting them for output ports and the event log file.
+**
+** \par Assumptions, External Events, and Notes:
+**        The event log must be set up by #Test_Logging first.
+**
+** \returns
+**        This function does not return a value.
+**
+** \sa #UT_Text, #UT_InitData, #UT_SetSBTotalMsgLen, #UT_SendMsg
+** \sa #UT_Report, #UT_SetRtnCode, #CFE_EVS_SendEvent
+** \sa #CFE_EVS_SendTimedEvent, #CFE_EVS_SendEventWithAppID
+** \sa #EVS_DeferSpec, #EVS_FormatDeferredPacket, #CFE_EVS_WriteLogFileCmd
+**
+******************************************************************************/
+void Test_Deferred(void);
+
 /*****************************************************************************/
 /**
 ** \brief Test writing application data
@@ -0,0 +1,632 @@
+/*
+** File:
+**   es_perflog_perf.c
+**
+** Purpose:
+**   ES performance log bench.  1, 2, 4 and 8 tasks add performance log
+**   entries as fast as they can, either
+**
+**   - shared, into one circular buffer for every task, the way
+**     CFE_ES_PerfLogAdd kept the log before the rings (copied below)
+**   - rings, through CFE_ES_PerfLogAdd with a ring per task
+**
+**   and reports ns per entry.  Then a stress run has 8 tasks add entries in
+**   each trigger mode, one of them the trigger, and checks the file
+**   CFE_ES_PerfLogDump writes: entries in time order, each task's entries in
+**   the order it added them, the trigger entry kept and nothing lost.
+**
+**   Last, 8 tasks add entries in streaming mode, paced and flat out, and the
+**   stream packets are checked: each ring's entries in order, every entry
+**   either streamed or counted lost, none lost when paced, and the latency
+**   of task 0's marker measured.
+**
+** Notes:
+**   Built on the real ES performance log, PSP timebase and OSAL, see
+**   perf_stubs.c.  The file is caught in memory by wrapping OS_write, and
+**   the dump's pauses between writes are skipped by wrapping OS_TaskDelay.
+**   OSAL tasks are SCHED_FIFO, so the tasks give the processor up every
+**   ES_PERFLOG_PERF_ROUNDS entries.  The packets are caught by standing in
+**   for CFE_SB_SendMsg.
+**
+**   Usage: es_perflog_perf [seconds per run]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+#include "cfe.h"
+#include "private/cfe_private.h"
+#include "cfe_es_global.h"
+#include "cfe_es_perf.h"
+#include "cfe_es_log.h"
+#include "cfe_es_start.h"
+#include "cfe_es_task.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define ES_PERFLOG_PERF_MAX_TASKS      8
+#define ES_PERFLOG_PERF_MARKERS        8      /* markers per task, task N uses N * 8 on */
+#define ES_PERFLOG_PERF_TRIGGER        (CFE_ES_PERF_MAX_IDS - 1)
+#define ES_PERFLOG_PERF_ROUNDS         64
+#define ES_PERFLOG_PERF_STRESS         20000  /* entries per task in a stress run */
+#define ES_PERFLOG_PERF_PACED          200    /* entry/exit pairs per task in a paced stream run */
+#define ES_PERFLOG_PERF_STACK_SIZE     16384
+#define ES_PERFLOG_PERF_PRIORITY       100
+
+/*
+** Bench state, shared with the tasks
+*/
+typedef struct
+{
+    volatile uint32  Running;
+    boolean          UseRings;
+    double           Seconds;
+    uint32           Entries[ES_PERFLOG_PERF_MAX_TASKS];
+    volatile uint32  Next;
+
+    boolean          Dumping;
+    uint32           FileBytes;
+    uint8            File[sizeof(CFE_ES_PerfMetaData_t) +
+                          sizeof(CFE_ES_PerfDataEntry_t) * CFE_ES_PERF_DATA_BUFFER_SIZE];
+
+    uint32           Packets;
+    uint32           Streamed[CFE_ES_PERF_DATA_RINGS];
+    uint32           StreamNext[CFE_ES_PERF_DATA_RINGS];
+    boolean          StreamOrderOk;
+} ES_PerfLogPerf_t;
+
+static ES_PerfLogPerf_t ES_PerfLogPerf;
+
+/*
+** ES data the performance log uses
+*/
+CFE_ES_ResetData_t  ES_PerfLogPerfResetData;
+CFE_ES_ResetData_t *CFE_ES_ResetDataPtr = &ES_PerfLogPerfResetData;
+CFE_ES_TaskData_t   CFE_ES_TaskData;
+
+extern CFE_ES_PerfData_t *Perf;
+
+int32 __real_OS_write(int32 filedes, void *buffer, uint32 nbytes);
+int32 __real_OS_close(int32 filedes);
+int32 __real_OS_TaskDelay(uint32 millisecond);
+
+
+/*
+** Stand-ins for the rest of ES, as much as the performance log uses
+*/
+boolean CFE_ES_VerifyCmdLength(CFE_SB_MsgPtr_t Msg, uint16 ExpectedLength)
+{
+    return TRUE;
+}
+
+/* Only the streaming child task runs, the file writer is called directly */
+int32 CFE_ES_CreateChildTask(uint32 *TaskIdPtr, const char *TaskName,
+                             CFE_ES_ChildTaskMainFuncPtr_t FunctionPtr, uint32 *StackPtr,
+                             uint32 StackSize, uint32 Priority, uint32 Flags)
+{
+    if (FunctionPtr != CFE_ES_PerfStreamer)
+    {
+        return CFE_SUCCESS;
+    }
+
+    return OS_TaskCreate(TaskIdPtr, TaskName, FunctionPtr, NULL, ES_PERFLOG_PERF_STACK_SIZE,
+                         Priority, 0) == OS_SUCCESS ? CFE_SUCCESS : CFE_ES_ERR_CHILD_TASK_CREATE;
+}
+
+int32 CFE_ES_RegisterChildTask(void)
+{
+    return CFE_SUCCESS;
+}
+
+/* The file writer runs on the bench's own thread, the streamer on its own task */
+void CFE_ES_ExitChildTask(void)
+{
+    if (!ES_PerfLogPerf.Dumping)
+    {
+        OS_TaskExit();
+    }
+}
+
+/* Checks each stream packet follows on from the ring's last one */
+int32 CFE_SB_SendMsg(CFE_SB_Msg_t *MsgPtr)
+{
+    CFE_ES_PerfStreamPacket_t *Packet = (CFE_ES_PerfStreamPacket_t *) MsgPtr;
+    uint32                     Ring = Packet->Payload.Ring;
+
+    if (Ring >= CFE_ES_PERF_DATA_RINGS ||
+        CFE_SB_GetTotalMsgLength(MsgPtr) != sizeof(CFE_ES_PerfStreamPacket_t) -
+                                            sizeof(Packet->Payload.Entry) +
+                                            Packet->Payload.EntryCount * sizeof(CFE_ES_PerfStreamEntry_t) ||
+        (int32) (Packet->Payload.FirstEntry - ES_PerfLogPerf.StreamNext[Ring]) < 0)
+    {
+        ES_PerfLogPerf.StreamOrderOk = FALSE;
+        return CFE_SUCCESS;
+    }
+
+    ES_PerfLogPerf.Packets++;
+    ES_PerfLogPerf.Streamed[Ring] += Packet->Payload.EntryCount;
+    ES_PerfLogPerf.StreamNext[Ring] = Packet->Payload.FirstEntry + Packet->Payload.EntryCount;
+
+    return CFE_SUCCESS;
+}
+
+void CFE_ES_FileWriteByteCntErr(const char *Filename, uint32 Requested, uint32 Actual)
+{
+    fprintf(stderr, "perf log write of %u bytes wrote %d\n", (unsigned int) Requested, (int) Actual);
+    exit(1);
+}
+
+/* The file CFE_ES_PerfLogDump writes, after the cFE header */
+int32 __wrap_OS_write(int32 filedes, void *buffer, uint32 nbytes)
+{
+    if (!ES_PerfLogPerf.Dumping)
+    {
+        return __real_OS_write(filedes, buffer, nbytes);
+    }
+
+    if (ES_PerfLogPerf.FileBytes + nbytes > sizeof(ES_PerfLogPerf.File))
+    {
+        return OS_FS_ERROR;
+    }
+
+    memcpy(&ES_PerfLogPerf.File[ES_PerfLogPerf.FileBytes], buffer, nbytes);
+    ES_PerfLogPerf.FileBytes += nbytes;
+
+    return nbytes;
+}
+
+int32 __wrap_OS_close(int32 filedes)
+{
+    return ES_PerfLogPerf.Dumping ? OS_FS_SUCCESS : __real_OS_close(filedes);
+}
+
+int32 __wrap_OS_TaskDelay(uint32 millisecond)
+{
+    return ES_PerfLogPerf.Dumping ? OS_SUCCESS : __real_OS_TaskDelay(millisecond);
+}
+
+
+/*
+** CFE_ES_PerfLogAdd before the rings, every task on one circular buffer
+** with OS_IntLock, which does nothing on POSIX
+*/
+static void ES_PerfLogPerfAddShared(uint32 Marker, uint32 EntryExit)
+{
+    int32         IntFlags;
+
+    if (Perf->MetaData.State != CFE_ES_PERF_IDLE) {
+
+        if (CFE_ES_TEST_LONG_MASK(Perf->MetaData.FilterMask, Marker)) {
+
+            IntFlags = OS_IntLock();
+
+            Perf->DataBuffer[Perf->MetaData.DataEnd].Data = (Marker | (EntryExit << CFE_ES_PERF_EXIT_BIT));
+            CFE_PSP_Get_Timebase((uint32*)&Perf->DataBuffer[Perf->MetaData.DataEnd].TimerUpper32,(uint32*)&Perf->DataBuffer[Perf->MetaData.DataEnd].TimerLower32);
+
+            Perf->MetaData.DataEnd++;
+            if (Perf->MetaData.DataEnd >= CFE_ES_PERF_DATA_BUFFER_SIZE) {
+                Perf->MetaData.DataEnd = 0;
+            }
+
+            Perf->MetaData.DataCount++;
+            if (Perf->MetaData.DataCount > CFE_ES_PERF_DATA_BUFFER_SIZE) {
+                Perf->MetaData.DataCount = CFE_ES_PERF_DATA_BUFFER_SIZE;
+                Perf->MetaData.DataStart = Perf->MetaData.DataEnd;
+            }
+
+            if (Perf->MetaData.State == CFE_ES_PERF_WAITING_FOR_TRIGGER) {
+                if (CFE_ES_TEST_LONG_MASK(Perf->MetaData.TriggerMask, Marker)) {
+                    Perf->MetaData.State = CFE_ES_PERF_TRIGGERED;
+                }
+            }
+
+            OS_IntUnlock(IntFlags);
+        }
+    }
+}
+
+
+/* Start collecting in the given trigger mode, the way the ground does */
+static void ES_PerfLogPerfStart(uint32 Mode)
+{
+    CFE_ES_PerfStartCmd_t Cmd;
+
+    memset(&Cmd, 0, sizeof(Cmd));
+    Cmd.Payload.TriggerMode = Mode;
+    CFE_ES_PerfStartDataCmd((CFE_SB_MsgPtr_t) &Cmd);
+
+    if (Perf->MetaData.State != CFE_ES_PERF_WAITING_FOR_TRIGGER)
+    {
+        fprintf(stderr, "cannot start collecting in mode %u\n", (unsigned int) Mode);
+        exit(1);
+    }
+}
+
+
+/* Adds entries until the run is over, cycling through the task's markers */
+static void ES_PerfLogPerfTask(void)
+{
+    uint32  Index;
+    uint32  Base;
+    uint32  Entries = 0;
+    double  End;
+
+    OS_TaskRegister();
+    Index = __atomic_fetch_add(&ES_PerfLogPerf.Next, 1, __ATOMIC_RELAXED);
+    Base = Index * ES_PERFLOG_PERF_MARKERS;
+    End = Perf_Now() + ES_PerfLogPerf.Seconds;
+
+    do
+    {
+        if (ES_PerfLogPerf.UseRings)
+        {
+            CFE_ES_PerfLogAdd(Base + (Entries % ES_PERFLOG_PERF_MARKERS), Entries & 1);
+        }
+        else
+        {
+            ES_PerfLogPerfAddShared(Base + (Entries % ES_PERFLOG_PERF_MARKERS), Entries & 1);
+        }
+
+        if ((++Entries % ES_PERFLOG_PERF_ROUNDS) == 0)
+        {
+            sched_yield();
+        }
+
+    } while ((Entries % ES_PERFLOG_PERF_ROUNDS) != 0 || Perf_Now() < End);
+
+    ES_PerfLogPerf.Entries[Index] = Entries;
+    Perf_TaskDone(&ES_PerfLogPerf.Running);
+}
+
+
+/* Adds ES_PERFLOG_PERF_PACED entry/exit pairs, a tick apart */
+static void ES_PerfLogPerfPacedTask(void)
+{
+    uint32  Index;
+    uint32  Base;
+    uint32  i;
+
+    OS_TaskRegister();
+    Index = __atomic_fetch_add(&ES_PerfLogPerf.Next, 1, __ATOMIC_RELAXED);
+    Base = Index * ES_PERFLOG_PERF_MARKERS;
+
+    for (i = 0; i < ES_PERFLOG_PERF_PACED; i++)
+    {
+        CFE_ES_PerfLogAdd(Base, 0);
+        CFE_ES_PerfLogAdd(Base, 1);
+        OS_TaskDelay(1);
+    }
+
+    ES_PerfLogPerf.Entries[Index] = i * 2;
+    Perf_TaskDone(&ES_PerfLogPerf.Running);
+}
+
+
+/* Adds ES_PERFLOG_PERF_STRESS entries, task 0 adds the trigger half way */
+static void ES_PerfLogPerfStressTask(void)
+{
+    uint32  Index;
+    uint32  Base;
+    uint32  i;
+
+    OS_TaskRegister();
+    Index = __atomic_fetch_add(&ES_PerfLogPerf.Next, 1, __ATOMIC_RELAXED);
+    Base = Index * ES_PERFLOG_PERF_MARKERS;
+
+    for (i = 0; i < ES_PERFLOG_PERF_STRESS; i++)
+    {
+        if (Index == 0 && i == ES_PERFLOG_PERF_STRESS / 2)
+        {
+            CFE_ES_PerfLogAdd(ES_PERFLOG_PERF_TRIGGER, 0);
+        }
+
+        CFE_ES_PerfLogAdd(Base + (i % ES_PERFLOG_PERF_MARKERS), i & 1);
+
+        if (((i + 1) % ES_PERFLOG_PERF_ROUNDS) == 0)
+        {
+            sched_yield();
+        }
+    }
+
+    ES_PerfLogPerf.Entries[Index] = i;
+    Perf_TaskDone(&ES_PerfLogPerf.Running);
+}
+
+
+static void ES_PerfLogPerfStartTasks(uint32 Tasks, osal_task_entry Entry)
+{
+    char   Name[OS_MAX_API_NAME];
+    uint32 TaskId;
+    uint32 i;
+    int32  Status;
+
+    for (i = 0; i < Tasks; i++)
+    {
+        __atomic_add_fetch(&ES_PerfLogPerf.Running, 1, __ATOMIC_RELAXED);
+        snprintf(Name, sizeof(Name), "PERFLOG_PERF_%u", (unsigned int) i);
+
+        Status = OS_TaskCreate(&TaskId, Name, Entry, NULL, ES_PERFLOG_PERF_STACK_SIZE,
+                               ES_PERFLOG_PERF_PRIORITY, 0);
+        if (Status != OS_SUCCESS)
+        {
+            fprintf(stderr, "cannot create task %s, error %d\n", Name, (int) Status);
+            exit(1);
+        }
+    }
+
+    Perf_WaitTasks(&ES_PerfLogPerf.Running);
+}
+
+
+static void ES_PerfLogPerfRun(boolean UseRings, uint32 Tasks, double Seconds)
+{
+    uint32 Entries = 0;
+    uint32 i;
+    double Start;
+    double Elapsed;
+
+    ES_PerfLogPerf.UseRings = UseRings;
+    ES_PerfLogPerf.Seconds = Seconds;
+    ES_PerfLogPerf.Next = 0;
+
+    /* no trigger, so the buffer keeps wrapping */
+    ES_PerfLogPerfStart(CFE_ES_PERF_TRIGGER_START);
+    memset(Perf->MetaData.TriggerMask, 0, sizeof(Perf->MetaData.TriggerMask));
+
+    Start = Perf_Now();
+    ES_PerfLogPerfStartTasks(Tasks, ES_PerfLogPerfTask);
+    Elapsed = Perf_Now() - Start;
+
+    Perf->MetaData.State = CFE_ES_PERF_IDLE;
+
+    for (i = 0; i < Tasks; i++)
+    {
+        Entries += ES_PerfLogPerf.Entries[i];
+    }
+
+    printf("%-6s %6u %12.0f %10.1f\n", UseRings ? "rings" : "shared", (unsigned int) Tasks,
+           Entries / Elapsed, Elapsed * 1e9 / Entries);
+}
+
+
+/* Collect with 8 tasks in the given mode, dump, and check the file */
+static boolean ES_PerfLogPerfStress(uint32 Mode, const char *ModeName)
+{
+    CFE_ES_PerfMetaData_t  *MetaData;
+    CFE_ES_PerfDataEntry_t *Entry;
+    uint32                  Count;
+    uint32                  Expect[ES_PERFLOG_PERF_MAX_TASKS];
+    boolean                 Seen[ES_PERFLOG_PERF_MAX_TASKS];
+    uint32                  Triggers = 0;
+    uint32                  Marker;
+    uint32                  Task;
+    uint32                  i;
+    boolean                 Stopped;
+    boolean                 Ok = TRUE;
+
+    ES_PerfLogPerf.Next = 0;
+
+    ES_PerfLogPerfStart(Mode);
+    memset(Perf->MetaData.TriggerMask, 0, sizeof(Perf->MetaData.TriggerMask));
+    Perf->MetaData.TriggerMask[ES_PERFLOG_PERF_TRIGGER / 32] = CFE_ES_DBIT(ES_PERFLOG_PERF_TRIGGER % 32);
+
+    ES_PerfLogPerfStartTasks(ES_PERFLOG_PERF_MAX_TASKS, ES_PerfLogPerfStressTask);
+
+    Stopped = (Perf->MetaData.State == CFE_ES_PERF_IDLE);
+    Perf->MetaData.State = CFE_ES_PERF_IDLE;
+
+    ES_PerfLogPerf.FileBytes = 0;
+    ES_PerfLogPerf.Dumping = TRUE;
+    CFE_ES_PerfLogDump();
+    ES_PerfLogPerf.Dumping = FALSE;
+
+    MetaData = (CFE_ES_PerfMetaData_t *) ES_PerfLogPerf.File;
+    Entry = (CFE_ES_PerfDataEntry_t *) &ES_PerfLogPerf.File[sizeof(CFE_ES_PerfMetaData_t)];
+    Count = (ES_PerfLogPerf.FileBytes - sizeof(CFE_ES_PerfMetaData_t)) / sizeof(CFE_ES_PerfDataEntry_t);
+
+    if (Count != MetaData->DataCount || Count == 0)
+    {
+        printf("  %s: %u entries written, metadata says %u\n", ModeName,
+               (unsigned int) Count, (unsigned int) MetaData->DataCount);
+        Ok = FALSE;
+    }
+
+    memset(Seen, 0, sizeof(Seen));
+
+    for (i = 0; i < Count && Ok; i++)
+    {
+        if (i > 0 && (Entry[i].TimerUpper32 < Entry[i - 1].TimerUpper32 ||
+                      (Entry[i].TimerUpper32 == Entry[i - 1].TimerUpper32 &&
+                       Entry[i].TimerLower32 < Entry[i - 1].TimerLower32)))
+        {
+            printf("  %s: entry %u is out of time order\n", ModeName, (unsigned int) i);
+            Ok = FALSE;
+        }
+
+        Marker = Entry[i].Data & ~(1 << CFE_ES_PERF_EXIT_BIT);
+
+        if (Marker == ES_PERFLOG_PERF_TRIGGER)
+        {
+            Triggers++;
+            continue;
+        }
+
+        /* each task's entries follow on from each other */
+        Task = Marker / ES_PERFLOG_PERF_MARKERS;
+        if (Task >= ES_PERFLOG_PERF_MAX_TASKS ||
+            (Seen[Task] && Marker != Expect[Task]))
+        {
+            printf("  %s: entry %u has marker %u out of order\n", ModeName,
+                   (unsigned int) i, (unsigned int) Marker);
+            Ok = FALSE;
+        }
+        else
+        {
+            Seen[Task] = TRUE;
+            Expect[Task] = (Task * ES_PERFLOG_PERF_MARKERS) +
+                           (((Marker % ES_PERFLOG_PERF_MARKERS) + 1) % ES_PERFLOG_PERF_MARKERS);
+        }
+    }
+
+    if (Ok && Triggers != 1)
+    {
+        printf("  %s: trigger entry written %u times\n", ModeName, (unsigned int) Triggers);
+        Ok = FALSE;
+    }
+
+    if (Ok && !Stopped)
+    {
+        printf("  %s: collection did not stop\n", ModeName);
+        Ok = FALSE;
+    }
+
+    if (Ok && Perf->LostCount != 0)
+    {
+        printf("  %s: %u entries lost\n", ModeName, (unsigned int) Perf->LostCount);
+        Ok = FALSE;
+    }
+
+    printf("%-6s %6u %8u %8u  %s\n", ModeName, (unsigned int) ES_PERFLOG_PERF_MAX_TASKS,
+           (unsigned int) Count, (unsigned int) MetaData->TriggerCount, Ok ? "ok" : "FAILED");
+
+    return Ok;
+}
+
+
+/* Stream with 8 tasks, then stop and check the packets */
+static boolean ES_PerfLogPerfStream(boolean Paced, const char *ModeName)
+{
+    CFE_ES_PerfSetLatMarkerCmd_t Cmd;
+    CFE_ES_PerfLatency_t         Latency[CFE_ES_PERF_LATENCY_SLOTS];
+    uint32                       Added = 0;
+    uint32                       Streamed = 0;
+    uint32                       i;
+    boolean                      Ok = TRUE;
+
+    ES_PerfLogPerf.Next = 0;
+    ES_PerfLogPerf.Packets = 0;
+    ES_PerfLogPerf.StreamOrderOk = TRUE;
+    memset(ES_PerfLogPerf.Streamed, 0, sizeof(ES_PerfLogPerf.Streamed));
+    memset(ES_PerfLogPerf.StreamNext, 0, sizeof(ES_PerfLogPerf.StreamNext));
+
+    /* task 0's marker, the way the ground sets it */
+    memset(&Cmd, 0, sizeof(Cmd));
+    Cmd.Payload.LatencySlot = 0;
+    Cmd.Payload.Marker = 0;
+    CFE_ES_PerfSetLatMarkerCmd((CFE_SB_MsgPtr_t) &Cmd);
+
+    ES_PerfLogPerfStart(CFE_ES_PERF_STREAM);
+    memset(Perf->MetaData.TriggerMask, 0, sizeof(Perf->MetaData.TriggerMask));
+
+    ES_PerfLogPerfStartTasks(ES_PERFLOG_PERF_MAX_TASKS,
+                             Paced ? ES_PerfLogPerfPacedTask : ES_PerfLogPerfStressTask);
+
+    /* the streamer's last pass sends the rest */
+    Perf->MetaData.State = CFE_ES_PERF_IDLE;
+    while (__atomic_load_n(&CFE_ES_PerfStreamStatus.Running, __ATOMIC_SEQ_CST) != 0)
+    {
+        OS_TaskDelay(10);
+    }
+
+    for (i = 0; i < CFE_ES_PERF_DATA_RINGS; i++)
+    {
+        if (Perf->Ring[i].Generation != Perf->Generation)
+        {
+            continue;
+        }
+
+        Added += Perf->Ring[i].Added;
+        Streamed += ES_PerfLogPerf.Streamed[i];
+
+        if (ES_PerfLogPerf.Streamed[i] + CFE_ES_PerfStreamStatus.Lost[i] != Perf->Ring[i].Added)
+        {
+            printf("  %s: ring %u streamed %u and lost %u of %u entries\n", ModeName, (unsigned int) i,
+                   (unsigned int) ES_PerfLogPerf.Streamed[i], (unsigned int) CFE_ES_PerfStreamStatus.Lost[i],
+                   (unsigned int) Perf->Ring[i].Added);
+            Ok = FALSE;
+        }
+    }
+
+    if (!ES_PerfLogPerf.StreamOrderOk)
+    {
+        printf("  %s: stream packets out of order\n", ModeName);
+        Ok = FALSE;
+    }
+
+    CFE_ES_PerfLatencyReport(Latency);
+
+    if (Paced && CFE_ES_PerfStreamStatus.LostCount != 0)
+    {
+        printf("  %s: %u entries lost\n", ModeName, (unsigned int) CFE_ES_PerfStreamStatus.LostCount);
+        Ok = FALSE;
+    }
+
+    if (Paced && Latency[0].Count != ES_PERFLOG_PERF_PACED)
+    {
+        printf("  %s: %u of %u latencies measured\n", ModeName, (unsigned int) Latency[0].Count,
+               (unsigned int) ES_PERFLOG_PERF_PACED);
+        Ok = FALSE;
+    }
+
+    printf("%-6s %6u %8u %8u %8u %8u %8u  %s\n", ModeName, (unsigned int) ES_PERFLOG_PERF_MAX_TASKS,
+           (unsigned int) Added, (unsigned int) Streamed, (unsigned int) CFE_ES_PerfStreamStatus.LostCount,
+           (unsigned int) ES_PerfLogPerf.Packets, (unsigned int) Latency[0].P99Time, Ok ? "ok" : "FAILED");
+
+    return Ok;
+}
+
+
+int main(int argc, char *argv[])
+{
+    double  Seconds = 0.5;
+    uint32  Tasks;
+    boolean Ok = TRUE;
+
+    if (argc > 1)
+    {
+        Seconds = strtod(argv[1], NULL);
+    }
+
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        fprintf(stderr, "initialization failed\n");
+        return 1;
+    }
+
+    CFE_ES_SetupPerfVariables(CFE_PSP_RST_TYPE_POWERON);
+    CFE_SB_InitMsg(&CFE_ES_PerfStreamStatus.Packet, CFE_ES_PERF_STREAM_TLM_MID,
+                   sizeof(CFE_ES_PerfStreamPacket_t), TRUE);
+
+    printf("ES performance log, %u entries in %u rings, %.2f s per run\n",
+           (unsigned int) CFE_ES_PERF_DATA_BUFFER_SIZE, (unsigned int) CFE_ES_PERF_DATA_RINGS, Seconds);
+    printf("log     tasks    entries/s   ns/entry\n");
+
+    for (Tasks = 1; Tasks <= ES_PERFLOG_PERF_MAX_TASKS; Tasks *= 2)
+    {
+        ES_PerfLogPerfRun(FALSE, Tasks, Seconds);
+        ES_PerfLogPerfRun(TRUE, Tasks, Seconds);
+    }
+
+    printf("mode    tasks  written  trigger  check\n");
+
+    Ok &= ES_PerfLogPerfStress(CFE_ES_PERF_TRIGGER_START, "start");
+    Ok &= ES_PerfLogPerfStress(CFE_ES_PERF_TRIGGER_CENTER, "center");
+    Ok &= ES_PerfLogPerfStress(CFE_ES_PERF_TRIGGER_END, "end");
+
+    printf("stream  tasks    added streamed     lost  packets  p99(us)  check\n");
+
+    Ok &= ES_PerfLogPerfStream(TRUE, "paced");
+    Ok &= ES_PerfLogPerfStream(FALSE, "flood");
+
+    printf("%u events, %u system log messages\n",
+           (unsigned int) Perf_EventCount, (unsigned int) Perf_SysLogCount);
+
+    return Ok ? 0 : 1;
+}
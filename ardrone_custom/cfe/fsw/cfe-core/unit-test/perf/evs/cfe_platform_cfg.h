@@ -0,0 +1,21 @@
+/*
+** File:
+**   cfe_platform_cfg.h
+**
+** Purpose:
+**   cFE platform configuration for evs_filter_perf, found ahead of the
+**   mission build's.  It is the mission build's, with room for
+**   EVS_PERF_MAX_FILTERS event filters per application so the bench can
+**   register more filters than the platform allows.
+*/
+#ifndef _evs_perf_platform_cfg_
+#define _evs_perf_platform_cfg_
+
+#include_next "cfe_platform_cfg.h"
+
+#ifdef EVS_PERF_MAX_FILTERS
+#undef  CFE_EVS_MAX_EVENT_FILTERS
+#define CFE_EVS_MAX_EVENT_FILTERS       EVS_PERF_MAX_FILTERS
+#endif
+
+#endif /* _evs_perf_platform_cfg_ */
@@ -0,0 +1,229 @@
+/*
+** File:
+**   evs_filter_perf.c
+**
+** Purpose:
+**   Event Services filter lookup bench.  Registers an application with 8,
+**   16, 32 and 64 binary filters, in no particular event ID order, and
+**   times looking up event IDs of which half have a filter:
+**
+**   - scan, EVS_FindEventID going through the whole filter table, what
+**     EVS_IsFiltered did before the filter index
+**   - index, EVS_FindFilter's binary search of the filter index
+**   - filtered, all of EVS_IsFiltered for an enabled event type
+**   - disabled, EVS_IsFiltered for an event type the application has
+**     disabled
+**
+**   The bench checks that scan and index find the same filters.
+**
+** Notes:
+**   Built on the real EVS code, less cfe_evs_task.c, with room for
+**   EVS_PERF_MAX_FILTERS filters per application (perf/evs).
+**
+**   Usage: evs_filter_perf [seconds per measurement]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cfe.h"
+#include "cfe_evs_task.h"
+#include "cfe_evs_utils.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define EVS_FILTER_PERF_LOOKUPS     1024
+#define EVS_FILTER_PERF_SCAN        0
+#define EVS_FILTER_PERF_INDEX       1
+#define EVS_FILTER_PERF_FILTERED    2
+#define EVS_FILTER_PERF_DISABLED    3
+
+/*
+** EVS global data, cfe_evs_task.c is not part of the bench
+*/
+CFE_EVS_GlobalData_t CFE_EVS_GlobalData;
+
+static CFE_EVS_Log_t EVS_FilterPerfLog;
+
+/*
+** Bench state
+*/
+static double  EVS_FilterPerfMeasure = 0.5;
+static int16   EVS_FilterPerfIDs [EVS_FILTER_PERF_LOOKUPS];
+static uint32  EVS_FilterPerfSends;
+static uint32  EVS_FilterPerfFound;
+
+static const char *EVS_FilterPerfNames [] = {"scan", "index", "filtered", "disabled"};
+
+
+/* Software Bus stand-in for the filter locked events */
+int32 CFE_SB_SendMsg(CFE_SB_Msg_t *MsgPtr)
+{
+    EVS_FilterPerfSends++;
+    return CFE_SUCCESS;
+}
+
+
+/* Registers NumFilters filters for event IDs 3 apart, in shuffled order */
+static void EVS_FilterPerfRegister(uint32 NumFilters)
+{
+    CFE_EVS_BinFilter_t Filters [CFE_EVS_MAX_EVENT_FILTERS];
+    CFE_EVS_BinFilter_t Swap;
+    uint32              Seed = 12345;
+    uint32              i;
+    uint32              j;
+
+    for (i = 0; i < NumFilters; i++)
+    {
+        Filters[i].EventID = (uint16) (3 * i + 1);
+        Filters[i].Mask = CFE_EVS_NO_FILTER;
+    }
+
+    for (i = NumFilters - 1; i > 0; i--)
+    {
+        Seed = Seed * 1103515245 + 12345;
+        j = (Seed >> 16) % (i + 1);
+        Swap = Filters[i];
+        Filters[i] = Filters[j];
+        Filters[j] = Swap;
+    }
+
+    if (CFE_EVS_Register(Filters, NumFilters, CFE_EVS_BINARY_FILTER) != CFE_SUCCESS)
+    {
+        fprintf(stderr, "CFE_EVS_Register failed\n");
+        exit(1);
+    }
+
+    /* Half the event IDs looked up have a filter */
+    for (i = 0; i < EVS_FILTER_PERF_LOOKUPS; i++)
+    {
+        Seed = Seed * 1103515245 + 12345;
+        j = (Seed >> 16) % NumFilters;
+        EVS_FilterPerfIDs[i] = (int16) (3 * j + 1 + (i & 1));
+    }
+
+    for (i = 0; i < EVS_FILTER_PERF_LOOKUPS; i++)
+    {
+        if (EVS_FindEventID(EVS_FilterPerfIDs[i], CFE_EVS_GlobalData.AppData[0].BinFilters) !=
+            EVS_FindFilter(&CFE_EVS_GlobalData.AppData[0], EVS_FilterPerfIDs[i]))
+        {
+            fprintf(stderr, "scan and index find different filters for event ID %d\n",
+                    (int) EVS_FilterPerfIDs[i]);
+            exit(1);
+        }
+    }
+}
+
+
+/* Looks up every event ID once, the way Method says */
+static void EVS_FilterPerfLookups(uint32 Method)
+{
+    EVS_AppData_t *AppDataPtr = &CFE_EVS_GlobalData.AppData[0];
+    uint32         Found = 0;
+    uint32         i;
+
+    switch (Method)
+    {
+        case EVS_FILTER_PERF_SCAN:
+            for (i = 0; i < EVS_FILTER_PERF_LOOKUPS; i++)
+            {
+                Found += (EVS_FindEventID(EVS_FilterPerfIDs[i], AppDataPtr->BinFilters) != NULL);
+            }
+            break;
+
+        case EVS_FILTER_PERF_INDEX:
+            for (i = 0; i < EVS_FILTER_PERF_LOOKUPS; i++)
+            {
+                Found += (EVS_FindFilter(AppDataPtr, EVS_FilterPerfIDs[i]) != NULL);
+            }
+            break;
+
+        case EVS_FILTER_PERF_FILTERED:
+            for (i = 0; i < EVS_FILTER_PERF_LOOKUPS; i++)
+            {
+                Found += EVS_IsFiltered(0, EVS_FilterPerfIDs[i], CFE_EVS_INFORMATION);
+            }
+            break;
+
+        default:
+            for (i = 0; i < EVS_FILTER_PERF_LOOKUPS; i++)
+            {
+                Found += EVS_IsFiltered(0, EVS_FilterPerfIDs[i], CFE_EVS_DEBUG);
+            }
+            break;
+    }
+
+    EVS_FilterPerfFound += Found;
+}
+
+
+/* Runs rounds of lookups until EVS_FilterPerfMeasure seconds have gone by */
+static void EVS_FilterPerfRun(uint32 NumFilters, uint32 Method)
+{
+    double Start;
+    double Seconds = 0;
+    uint32 Lookups = 0;
+
+    while (Seconds < EVS_FilterPerfMeasure)
+    {
+        /* Keep the filter counts from locking */
+        CFE_EVS_ResetAllFilters();
+
+        Start = Perf_Now();
+        EVS_FilterPerfLookups(Method);
+        Seconds += Perf_Now() - Start;
+        Lookups += EVS_FILTER_PERF_LOOKUPS;
+    }
+
+    printf("%-9s %7u %12.1f\n", EVS_FilterPerfNames[Method], (unsigned int) NumFilters,
+           Seconds * 1e9 / Lookups);
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32 NumFilters;
+    uint32 Method;
+
+    if (argc > 1)
+    {
+        EVS_FilterPerfMeasure = strtod(argv[1], NULL);
+    }
+
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        fprintf(stderr, "OS_API_Init failed\n");
+        return 1;
+    }
+
+    CFE_EVS_GlobalData.EVS_AppID = 0;
+    CFE_EVS_GlobalData.EVS_LogPtr = &EVS_FilterPerfLog;
+    CFE_EVS_GlobalData.EVS_TlmPkt.Payload.LogEnabled = FALSE;
+
+    printf("EVS filter lookup, %u event IDs, half with a filter, filter table of %u\n",
+           (unsigned int) EVS_FILTER_PERF_LOOKUPS, (unsigned int) CFE_EVS_MAX_EVENT_FILTERS);
+    printf("lookup    filters   ns/lookup\n");
+
+    for (NumFilters = 8; NumFilters <= CFE_EVS_MAX_EVENT_FILTERS; NumFilters *= 2)
+    {
+        EVS_FilterPerfRegister(NumFilters);
+        EVS_DisableTypes(CFE_EVS_DEBUG_BIT, 0);
+
+        for (Method = EVS_FILTER_PERF_SCAN; Method <= EVS_FILTER_PERF_DISABLED; Method++)
+        {
+            EVS_FilterPerfRun(NumFilters, Method);
+        }
+    }
+
+    printf("%u filters found, %u events, %u system log messages\n",
+           (unsigned int) EVS_FilterPerfFound, (unsigned int) EVS_FilterPerfSends,
+           (unsigned int) Perf_SysLogCount);
+
+    return 0;
+}
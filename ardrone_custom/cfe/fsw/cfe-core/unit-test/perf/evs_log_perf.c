@@ -0,0 +1,477 @@
+/*
+** File:
+**   evs_log_perf.c
+**
+** Purpose:
+**   EVS local event log bench.  1, 2, 4 and 8 tasks add event packets to
+**   the local event log as fast as they can, either
+**
+**   - mutex, under the EVS shared data mutex, the way EVS_AddLog kept the
+**     log before it went lock-free (copied below)
+**   - ticket, through EVS_AddLog
+**
+**   and reports ns per event.  Then an event storm has 8 tasks send events
+**   through CFE_EVS_SendEvent while another task writes the log file over
+**   and over, in each log mode, and checks every file: each entry whole,
+**   each task's events in the order it sent them, and the tickets, entries
+**   and overflow counter adding up to the events sent.
+**
+** Notes:
+**   Built on the real EVS code, less cfe_evs_task.c, and the real OSAL.
+**   The log file is caught in memory by wrapping OS_creat, OS_write and
+**   OS_close.  OSAL tasks are SCHED_FIFO, so the tasks give the processor
+**   up every EVS_LOG_PERF_ROUNDS events.
+**
+**   Usage: evs_log_perf [seconds per run]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+#include "cfe.h"
+#include "cfe_evs_task.h"
+#include "cfe_evs_log.h"
+#include "cfe_evs_utils.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define EVS_LOG_PERF_MAX_TASKS      8
+#define EVS_LOG_PERF_ROUNDS         64
+#define EVS_LOG_PERF_STORM          20000  /* events per task in a storm */
+#define EVS_LOG_PERF_STACK_SIZE     16384
+#define EVS_LOG_PERF_PRIORITY       100
+#define EVS_LOG_PERF_FD             7
+
+/*
+** EVS global data, cfe_evs_task.c is not part of the bench
+*/
+CFE_EVS_GlobalData_t CFE_EVS_GlobalData;
+
+static CFE_EVS_Log_t EVS_LogPerfLog;
+
+/*
+** Bench state, shared with the tasks
+*/
+typedef struct
+{
+    volatile uint32  Running;
+    volatile uint32  Sending;
+    boolean          UseTickets;
+    double           Seconds;
+    uint32           Events[EVS_LOG_PERF_MAX_TASKS];
+    volatile uint32  Next;
+
+    uint32           Sends;
+    uint32           Files;
+    uint32           FileEntries;
+    boolean          FileOk;
+    uint32           FileBytes;
+    CFE_EVS_Packet_t File[CFE_EVS_LOG_MAX];
+} EVS_LogPerf_t;
+
+static EVS_LogPerf_t EVS_LogPerf;
+
+static CFE_EVS_Packet_t EVS_LogPerfPackets[EVS_LOG_PERF_MAX_TASKS];
+
+
+/* Software Bus stand-in, counts the event packets */
+int32 CFE_SB_SendMsg(CFE_SB_Msg_t *MsgPtr)
+{
+    __atomic_fetch_add(&EVS_LogPerf.Sends, 1, __ATOMIC_RELAXED);
+    return CFE_SUCCESS;
+}
+
+/* The log file CFE_EVS_WriteLogFileCmd writes, after the cFE header */
+int32 __wrap_OS_creat(const char *path, int32 access)
+{
+    EVS_LogPerf.FileBytes = 0;
+    return EVS_LOG_PERF_FD;
+}
+
+int32 __wrap_OS_write(int32 filedes, void *buffer, uint32 nbytes)
+{
+    if (EVS_LogPerf.FileBytes + nbytes > sizeof(EVS_LogPerf.File))
+    {
+        return OS_FS_ERROR;
+    }
+
+    memcpy((uint8 *) EVS_LogPerf.File + EVS_LogPerf.FileBytes, buffer, nbytes);
+    EVS_LogPerf.FileBytes += nbytes;
+
+    return nbytes;
+}
+
+int32 __wrap_OS_close(int32 filedes)
+{
+    return OS_FS_SUCCESS;
+}
+
+
+/*
+** EVS_AddLog before the log went lock-free, every task under the EVS
+** shared data mutex
+*/
+static void EVS_LogPerfAddMutex(CFE_EVS_Packet_t *EVS_PktPtr)
+{
+    CFE_EVS_Log_t *LogPtr = CFE_EVS_GlobalData.EVS_LogPtr;
+
+    OS_MutSemTake(CFE_EVS_GlobalData.EVS_SharedDataMutexID);
+
+    if ((LogPtr->LogFullFlag == TRUE) && (LogPtr->LogMode == CFE_EVS_LOG_DISCARD))
+    {
+        LogPtr->LogOverflowCounter++;
+    }
+    else
+    {
+        if (LogPtr->LogFullFlag == TRUE)
+        {
+            LogPtr->LogOverflowCounter++;
+        }
+
+        CFE_PSP_MemCpy(&LogPtr->LogEntry[LogPtr->Next], EVS_PktPtr, sizeof(CFE_EVS_Packet_t));
+
+        LogPtr->Next++;
+
+        if (LogPtr->Next >= CFE_EVS_LOG_MAX)
+        {
+            LogPtr->Next = 0;
+        }
+
+        if (LogPtr->LogCount < CFE_EVS_LOG_MAX)
+        {
+            LogPtr->LogCount++;
+
+            if (LogPtr->LogCount == CFE_EVS_LOG_MAX)
+            {
+                LogPtr->LogFullFlag = TRUE;
+            }
+        }
+    }
+
+    OS_MutSemGive(CFE_EVS_GlobalData.EVS_SharedDataMutexID);
+}
+
+
+/* Adds the task's event packet until the run is over */
+static void EVS_LogPerfTask(void)
+{
+    CFE_EVS_Packet_t *Packet;
+    uint32            Index;
+    uint32            Events = 0;
+    double            End;
+
+    OS_TaskRegister();
+    Index = __atomic_fetch_add(&EVS_LogPerf.Next, 1, __ATOMIC_RELAXED);
+    Packet = &EVS_LogPerfPackets[Index];
+    End = Perf_Now() + EVS_LogPerf.Seconds;
+
+    do
+    {
+        if (EVS_LogPerf.UseTickets)
+        {
+            EVS_AddLog(Packet);
+        }
+        else
+        {
+            EVS_LogPerfAddMutex(Packet);
+        }
+
+        if ((++Events % EVS_LOG_PERF_ROUNDS) == 0)
+        {
+            sched_yield();
+        }
+
+    } while ((Events % EVS_LOG_PERF_ROUNDS) != 0 || Perf_Now() < End);
+
+    EVS_LogPerf.Events[Index] = Events;
+    Perf_TaskDone(&EVS_LogPerf.Running);
+}
+
+
+/* Sends EVS_LOG_PERF_STORM events, the task number and a count in each */
+static void EVS_LogPerfStormTask(void)
+{
+    uint32 Index;
+    uint32 i;
+
+    OS_TaskRegister();
+    Index = __atomic_fetch_add(&EVS_LogPerf.Next, 1, __ATOMIC_RELAXED);
+
+    for (i = 0; i < EVS_LOG_PERF_STORM; i++)
+    {
+        CFE_EVS_SendEvent((uint16) Index, CFE_EVS_INFORMATION, "Storm task %u event %u",
+                          (unsigned int) Index, (unsigned int) i);
+
+        if (((i + 1) % EVS_LOG_PERF_ROUNDS) == 0)
+        {
+            sched_yield();
+        }
+    }
+
+    EVS_LogPerf.Events[Index] = i;
+    __atomic_sub_fetch(&EVS_LogPerf.Sending, 1, __ATOMIC_RELEASE);
+    Perf_TaskDone(&EVS_LogPerf.Running);
+}
+
+
+/* Writes the log file and checks it: entries whole, each task's in order */
+static void EVS_LogPerfWriteFile(void)
+{
+    CFE_EVS_LogFileCmd_t Cmd;
+    int32                Last[EVS_LOG_PERF_MAX_TASKS];
+    unsigned int         Task;
+    unsigned int         Event;
+    uint32               Count;
+    uint32               i;
+
+    memset(&Cmd, 0, sizeof(Cmd));
+
+    if (CFE_EVS_WriteLogFileCmd((CFE_SB_MsgPayloadPtr_t) &Cmd.Payload) != TRUE)
+    {
+        printf("  writing the log file failed\n");
+        EVS_LogPerf.FileOk = FALSE;
+        return;
+    }
+
+    Count = EVS_LogPerf.FileBytes / sizeof(CFE_EVS_Packet_t);
+    memset(Last, 0xFF, sizeof(Last));
+
+    for (i = 0; i < Count; i++)
+    {
+        if (sscanf(EVS_LogPerf.File[i].Payload.Message, "Storm task %u event %u", &Task, &Event) != 2 ||
+            Task >= EVS_LOG_PERF_MAX_TASKS ||
+            Task != EVS_LogPerf.File[i].Payload.PacketID.EventID ||
+            (int32) Event <= Last[Task])
+        {
+            printf("  file %u entry %u, event %u \"%s\", is torn or out of order\n",
+                   (unsigned int) EVS_LogPerf.Files, (unsigned int) i,
+                   (unsigned int) EVS_LogPerf.File[i].Payload.PacketID.EventID,
+                   EVS_LogPerf.File[i].Payload.Message);
+            EVS_LogPerf.FileOk = FALSE;
+            return;
+        }
+
+        Last[Task] = (int32) Event;
+    }
+
+    EVS_LogPerf.Files++;
+    EVS_LogPerf.FileEntries = Count;
+}
+
+
+/* Writes the log file until the storm is over */
+static void EVS_LogPerfReaderTask(void)
+{
+    OS_TaskRegister();
+
+    while (__atomic_load_n(&EVS_LogPerf.Sending, __ATOMIC_ACQUIRE) != 0 && EVS_LogPerf.FileOk)
+    {
+        EVS_LogPerfWriteFile();
+        sched_yield();
+    }
+
+    Perf_TaskDone(&EVS_LogPerf.Running);
+}
+
+
+static void EVS_LogPerfStartTask(const char *Name, osal_task_entry Entry)
+{
+    uint32 TaskId;
+    int32  Status;
+
+    __atomic_add_fetch(&EVS_LogPerf.Running, 1, __ATOMIC_RELAXED);
+
+    Status = OS_TaskCreate(&TaskId, Name, Entry, NULL, EVS_LOG_PERF_STACK_SIZE,
+                           EVS_LOG_PERF_PRIORITY, 0);
+    if (Status != OS_SUCCESS)
+    {
+        fprintf(stderr, "cannot create task %s, error %d\n", Name, (int) Status);
+        exit(1);
+    }
+}
+
+
+static void EVS_LogPerfStartTasks(uint32 Tasks, osal_task_entry Entry)
+{
+    char   Name[OS_MAX_API_NAME];
+    uint32 i;
+
+    for (i = 0; i < Tasks; i++)
+    {
+        snprintf(Name, sizeof(Name), "EVS_LOG_PERF_%u", (unsigned int) i);
+        EVS_LogPerfStartTask(Name, Entry);
+    }
+}
+
+
+static void EVS_LogPerfRun(boolean UseTickets, uint32 Tasks, double Seconds)
+{
+    uint32 Events = 0;
+    uint32 i;
+    double Start;
+    double Elapsed;
+
+    EVS_LogPerf.UseTickets = UseTickets;
+    EVS_LogPerf.Seconds = Seconds;
+    EVS_LogPerf.Next = 0;
+
+    EVS_ClearLog();
+
+    Start = Perf_Now();
+    EVS_LogPerfStartTasks(Tasks, EVS_LogPerfTask);
+    Perf_WaitTasks(&EVS_LogPerf.Running);
+    Elapsed = Perf_Now() - Start;
+
+    for (i = 0; i < Tasks; i++)
+    {
+        Events += EVS_LogPerf.Events[i];
+    }
+
+    printf("%-6s %6u %12.0f %10.1f\n", UseTickets ? "ticket" : "mutex", (unsigned int) Tasks,
+           Events / Elapsed, Elapsed * 1e9 / Events);
+}
+
+
+/* Storm the log in the given mode while writing the log file, and check */
+static boolean EVS_LogPerfStorm(uint8 Mode, const char *ModeName)
+{
+    CFE_EVS_Log_t *LogPtr = CFE_EVS_GlobalData.EVS_LogPtr;
+    uint32         Sent = EVS_LOG_PERF_MAX_TASKS * EVS_LOG_PERF_STORM;
+    uint32         Tickets;
+    uint16         Lost;
+    boolean        Ok;
+
+    LogPtr->LogMode = Mode;
+    EVS_ClearLog();
+
+    EVS_LogPerf.Next = 0;
+    EVS_LogPerf.Files = 0;
+    EVS_LogPerf.FileOk = TRUE;
+    EVS_LogPerf.Sending = EVS_LOG_PERF_MAX_TASKS;
+
+    EVS_LogPerfStartTasks(EVS_LOG_PERF_MAX_TASKS, EVS_LogPerfStormTask);
+    EVS_LogPerfStartTask("EVS_LOG_PERF_RD", EVS_LogPerfReaderTask);
+    Perf_WaitTasks(&EVS_LogPerf.Running);
+
+    /* The file written once the storm is over has the whole log */
+    EVS_LogPerfWriteFile();
+    Ok = EVS_LogPerf.FileOk;
+
+    Tickets = (LogPtr->Ticket - LogPtr->FirstTicket) / 2;
+
+    if (Mode == CFE_EVS_LOG_DISCARD)
+    {
+        /* Only the first log full of events takes a ticket, the rest overflow */
+        Lost = (uint16) (LogPtr->LogOverflowCounter - (uint16) (Sent - CFE_EVS_LOG_MAX));
+
+        if (Ok && (Tickets != CFE_EVS_LOG_MAX || Lost != 0))
+        {
+            printf("  %s: %u tickets, overflow counter %u\n", ModeName, (unsigned int) Tickets,
+                   (unsigned int) LogPtr->LogOverflowCounter);
+            Ok = FALSE;
+        }
+    }
+    else
+    {
+        /* Every event takes a ticket; events lost to an entry still being
+           written a log full later are counted as overflows too */
+        Lost = (uint16) (LogPtr->LogOverflowCounter - (uint16) (Sent - CFE_EVS_LOG_MAX));
+
+        if (Ok && Tickets != Sent)
+        {
+            printf("  %s: %u tickets for %u events\n", ModeName, (unsigned int) Tickets,
+                   (unsigned int) Sent);
+            Ok = FALSE;
+        }
+    }
+
+    /* Only events lost out of the last log full are missing from the file */
+    if (Ok && (LogPtr->LogCount != CFE_EVS_LOG_MAX ||
+               EVS_LogPerf.FileEntries > CFE_EVS_LOG_MAX ||
+               EVS_LogPerf.FileEntries + Lost < CFE_EVS_LOG_MAX))
+    {
+        printf("  %s: %u entries in the log file, log count %u, %u lost\n", ModeName,
+               (unsigned int) EVS_LogPerf.FileEntries, (unsigned int) LogPtr->LogCount,
+               (unsigned int) Lost);
+        Ok = FALSE;
+    }
+
+    printf("%-9s %6u %8u %8u %8u %8u  %s\n", ModeName, (unsigned int) EVS_LOG_PERF_MAX_TASKS,
+           (unsigned int) Sent, (unsigned int) EVS_LogPerf.Files, (unsigned int) EVS_LogPerf.FileEntries,
+           (unsigned int) Lost, Ok ? "ok" : "FAILED");
+
+    return Ok;
+}
+
+
+int main(int argc, char *argv[])
+{
+    double  Seconds = 0.5;
+    uint32  Tasks;
+    uint32  i;
+    boolean Ok = TRUE;
+
+    if (argc > 1)
+    {
+        Seconds = strtod(argv[1], NULL);
+    }
+
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        fprintf(stderr, "OS_API_Init failed\n");
+        return 1;
+    }
+
+    CFE_EVS_GlobalData.EVS_AppID = CFE_EVS_UNDEF_APPID;
+    CFE_EVS_GlobalData.EVS_LogPtr = &EVS_LogPerfLog;
+    CFE_EVS_GlobalData.EVS_LogPtr->LogMode = CFE_EVS_LOG_OVERWRITE;
+    CFE_EVS_GlobalData.EVS_TlmPkt.Payload.OutputPort = 0;
+    CFE_EVS_GlobalData.EVS_TlmPkt.Payload.LogEnabled = TRUE;
+
+    if (OS_MutSemCreate(&CFE_EVS_GlobalData.EVS_SharedDataMutexID, "EVS_LOG_PERF", 0) != OS_SUCCESS)
+    {
+        fprintf(stderr, "OS_MutSemCreate failed\n");
+        return 1;
+    }
+
+    if (CFE_EVS_Register(NULL, 0, CFE_EVS_BINARY_FILTER) != CFE_SUCCESS)
+    {
+        fprintf(stderr, "CFE_EVS_Register failed\n");
+        return 1;
+    }
+
+    for (i = 0; i < EVS_LOG_PERF_MAX_TASKS; i++)
+    {
+        CFE_SB_InitMsg(&EVS_LogPerfPackets[i], CFE_EVS_EVENT_MSG_MID, sizeof(CFE_EVS_Packet_t), TRUE);
+        EVS_LogPerfPackets[i].Payload.PacketID.EventID = (uint16) i;
+        snprintf(EVS_LogPerfPackets[i].Payload.Message, CFE_EVS_MAX_MESSAGE_LENGTH,
+                 "Contention task %u", (unsigned int) i);
+    }
+
+    printf("EVS local event log, %u entries, %.2f s per run\n",
+           (unsigned int) CFE_EVS_LOG_MAX, Seconds);
+    printf("log     tasks     events/s   ns/event\n");
+
+    for (Tasks = 1; Tasks <= EVS_LOG_PERF_MAX_TASKS; Tasks *= 2)
+    {
+        EVS_LogPerfRun(FALSE, Tasks, Seconds);
+        EVS_LogPerfRun(TRUE, Tasks, Seconds);
+    }
+
+    printf("storm      tasks     sent    files  entries     lost  check\n");
+
+    Ok &= EVS_LogPerfStorm(CFE_EVS_LOG_OVERWRITE, "overwrite");
+    Ok &= EVS_LogPerfStorm(CFE_EVS_LOG_DISCARD, "discard");
+
+    printf("%u events, %u system log messages\n",
+           (unsigned int) EVS_LogPerf.Sends, (unsigned int) Perf_SysLogCount);
+
+    return Ok ? 0 : 1;
+}
@@ -0,0 +1,219 @@
+/*
+** File:
+**   evs_perf.c
+**
+** Purpose:
+**   Event Services send bench.  Sends the same event, with a few integer
+**   and string arguments, as fast as it can and reports events per second
+**   in each event format mode, with the local event log enabled and
+**   disabled and the output ports off:
+**
+**   - long, the event text formatted by vsnprintf when it is sent
+**   - deferred, the arguments packed and the text formatted only by
+**     whoever reads the event
+**
+**   The bench checks that a deferred event formats to the same text as
+**   the long format event.
+**
+** Notes:
+**   Built on the real EVS code, less cfe_evs_task.c, so the bench holds the
+**   EVS global data and the event log.  The event packets go to a
+**   CFE_SB_SendMsg stand-in that counts them.
+**
+**   Usage: evs_perf [seconds per measurement]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cfe.h"
+#include "cfe_evs_task.h"
+#include "cfe_evs_utils.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define EVS_PERF_EVENT_ID       42
+#define EVS_PERF_BATCH          1000
+#define EVS_PERF_SPEC           "Pipe %s overflow: MsgId 0x%04X, %u messages dropped, last %d.%03d s ago"
+
+/*
+** EVS global data, cfe_evs_task.c is not part of the bench
+*/
+CFE_EVS_GlobalData_t CFE_EVS_GlobalData;
+
+static CFE_EVS_Log_t EVS_PerfLog;
+
+/*
+** Bench state
+*/
+typedef struct
+{
+    uint32  Sends;          /* event packets sent on the software bus */
+    uint32  Bytes;          /* event packet bytes sent */
+    uint32  Deferred;       /* of which deferred */
+} EVS_Perf_t;
+
+static EVS_Perf_t EVS_Perf;
+static double     EVS_PerfMeasure = 1.0;
+
+static CFE_EVS_Packet_t         EVS_PerfLongPacket;
+static CFE_EVS_DeferredPacket_t EVS_PerfDeferredPacket;
+
+
+/*
+** Software Bus stand-in: counts the event packets and keeps the last one
+** of each kind
+*/
+int32 CFE_SB_SendMsg(CFE_SB_Msg_t *MsgPtr)
+{
+    EVS_Perf.Sends++;
+    EVS_Perf.Bytes += CFE_SB_GetTotalMsgLength(MsgPtr);
+
+    if (CFE_SB_GetMsgId(MsgPtr) == CFE_EVS_DEFERRED_EVENT_MSG_MID)
+    {
+        EVS_Perf.Deferred++;
+        memcpy(&EVS_PerfDeferredPacket, MsgPtr, sizeof(EVS_PerfDeferredPacket));
+    }
+    else
+    {
+        memcpy(&EVS_PerfLongPacket, MsgPtr, sizeof(EVS_PerfLongPacket));
+    }
+
+    return CFE_SUCCESS;
+}
+
+
+/* Sends a batch of events, their arguments changing from one to the next */
+static void EVS_PerfBatch(uint32 Base)
+{
+    uint32 i;
+
+    for (i = 0; i < EVS_PERF_BATCH; i++)
+    {
+        CFE_EVS_SendEvent(EVS_PERF_EVENT_ID, CFE_EVS_ERROR, EVS_PERF_SPEC,
+                          "SC_CMD_PIPE", (unsigned int) (0x1800 + (i & 0xFF)),
+                          (unsigned int) (Base + i), (int) (i / 1000), (int) (i % 1000));
+    }
+}
+
+
+/* Sends events in the given mode until EVS_PerfMeasure seconds have gone by */
+static double EVS_PerfRun(uint8 Mode, boolean Log)
+{
+    double Start;
+    double Seconds;
+    uint32 Events = 0;
+
+    CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageFormatMode = Mode;
+    CFE_EVS_GlobalData.EVS_TlmPkt.Payload.LogEnabled = Log;
+    memset(&EVS_Perf, 0, sizeof(EVS_Perf));
+
+    /* Warm up, which also remembers the deferred format string */
+    EVS_PerfBatch(0);
+    memset(&EVS_Perf, 0, sizeof(EVS_Perf));
+
+    Start = Perf_Now();
+    do
+    {
+        EVS_PerfBatch(Events);
+        Events += EVS_PERF_BATCH;
+        Seconds = Perf_Now() - Start;
+    } while (Seconds < EVS_PerfMeasure);
+
+    if ((EVS_Perf.Sends != Events) ||
+        ((Mode == CFE_EVS_DEFERRED_FORMAT) && (EVS_Perf.Deferred != Events)))
+    {
+        fprintf(stderr, "%u events sent, %u packets\n", (unsigned int) Events,
+                (unsigned int) EVS_Perf.Sends);
+        exit(1);
+    }
+
+    printf("%-9s %-4s %12.0f %10.0f %12.1f\n",
+           (Mode == CFE_EVS_DEFERRED_FORMAT) ? "deferred" : "long", Log ? "on" : "off",
+           Events / Seconds, Seconds * 1e9 / Events, (double) EVS_Perf.Bytes / Events);
+
+    return Events / Seconds;
+}
+
+
+/* Checks a deferred event formats to the text of the same long format event */
+static void EVS_PerfCheck(void)
+{
+    CFE_EVS_Packet_t TextPacket;
+
+    CFE_EVS_GlobalData.EVS_TlmPkt.Payload.LogEnabled = FALSE;
+
+    CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageFormatMode = CFE_EVS_LONG_FORMAT;
+    CFE_EVS_SendEvent(EVS_PERF_EVENT_ID, CFE_EVS_ERROR, EVS_PERF_SPEC,
+                      "SC_CMD_PIPE", 0x18A5U, 123456U, -3, 7);
+
+    CFE_EVS_GlobalData.EVS_TlmPkt.Payload.MessageFormatMode = CFE_EVS_DEFERRED_FORMAT;
+    CFE_EVS_SendEvent(EVS_PERF_EVENT_ID, CFE_EVS_ERROR, EVS_PERF_SPEC,
+                      "SC_CMD_PIPE", 0x18A5U, 123456U, -3, 7);
+
+    if ((EVS_FormatDeferredPacket(&EVS_PerfDeferredPacket, &TextPacket) != TRUE) ||
+        (strcmp(TextPacket.Payload.Message, EVS_PerfLongPacket.Payload.Message) != 0))
+    {
+        fprintf(stderr, "deferred event text \"%s\" is not \"%s\"\n",
+                TextPacket.Payload.Message, EVS_PerfLongPacket.Payload.Message);
+        exit(1);
+    }
+}
+
+
+int main(int argc, char *argv[])
+{
+    double Long;
+    double Deferred;
+
+    if (argc > 1)
+    {
+        EVS_PerfMeasure = strtod(argv[1], NULL);
+    }
+
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        fprintf(stderr, "OS_API_Init failed\n");
+        return 1;
+    }
+
+    CFE_EVS_GlobalData.EVS_AppID = CFE_EVS_UNDEF_APPID;
+    CFE_EVS_GlobalData.EVS_LogPtr = &EVS_PerfLog;
+    CFE_EVS_GlobalData.EVS_LogPtr->LogMode = CFE_EVS_LOG_OVERWRITE;
+    CFE_EVS_GlobalData.EVS_TlmPkt.Payload.OutputPort = 0;
+
+    if (OS_MutSemCreate(&CFE_EVS_GlobalData.EVS_SharedDataMutexID, "EVS_PERF", 0) != OS_SUCCESS)
+    {
+        fprintf(stderr, "OS_MutSemCreate failed\n");
+        return 1;
+    }
+
+    if (CFE_EVS_Register(NULL, 0, CFE_EVS_BINARY_FILTER) != CFE_SUCCESS)
+    {
+        fprintf(stderr, "CFE_EVS_Register failed\n");
+        return 1;
+    }
+
+    EVS_PerfCheck();
+
+    printf("EVS send, \"%s\", output ports off\n", EVS_PERF_SPEC);
+    printf("format    log    events/sec   ns/event  bytes/event\n");
+
+    Long = EVS_PerfRun(CFE_EVS_LONG_FORMAT, FALSE);
+    Deferred = EVS_PerfRun(CFE_EVS_DEFERRED_FORMAT, FALSE);
+    printf("deferred/long, log off: %.2fx\n", Deferred / Long);
+
+    Long = EVS_PerfRun(CFE_EVS_LONG_FORMAT, TRUE);
+    Deferred = EVS_PerfRun(CFE_EVS_DEFERRED_FORMAT, TRUE);
+    printf("deferred/long, log on:  %.2fx\n", Deferred / Long);
+
+    printf("%u system log messages\n", (unsigned int) Perf_SysLogCount);
+
+    return 0;
+}
@@ -0,0 +1,221 @@
+/*
+** File:
+**   perf_stubs.c
+**
+** Purpose:
+**   Stand-ins for the cFE services around the subsystem under measurement,
+**   for the performance benches in this directory.
+**
+** Notes:
+**   Unlike the unit test stubs these keep no state and may be called from
+**   any number of tasks at once.  The benches link the real subsystem, the
+**   real ES memory pool and the real OSAL, so only what is outside of those
+**   is stubbed here.  Events and system log messages are counted and dropped.
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <string.h>
+#include <stdarg.h>
+#include <time.h>
+
+#include "cfe.h"
+#include "common_types.h"
+#include "perf_stubs.h"
+
+/*
+** Global data
+*/
+uint32 Perf_EventCount;
+uint32 Perf_SysLogCount;
+
+/* Normally from the PSP, OS_API_Init looks through it */
+OS_VolumeInfo_t OS_VolumeTable[NUM_TABLE_ENTRIES] =
+{
+    {"unused", "unused", FS_BASED, TRUE, TRUE, FALSE, " ", " ", 0}
+};
+
+
+/*
+** Executive Services
+*/
+void CFE_ES_ExitApp(uint32 ExitStatus)
+{
+}
+
+int32 CFE_ES_RegisterApp(void)
+{
+    return CFE_SUCCESS;
+}
+
+void CFE_ES_WaitForStartupSync(uint32 TimeOutMilliseconds)
+{
+}
+
+void CFE_ES_IncrementTaskCounter(void)
+{
+}
+
+int32 CFE_ES_GetAppID(uint32 *AppIdPtr)
+{
+    *AppIdPtr = 0;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_ES_GetAppIDByName(uint32 *AppIdPtr, const char *AppName)
+{
+    *AppIdPtr = 0;
+    return CFE_SUCCESS;
+}
+
+int32 CFE_ES_GetAppName(char *AppName, uint32 AppId, uint32 BufferLength)
+{
+    strncpy(AppName, "PERF", BufferLength);
+    AppName[BufferLength - 1] = '\0';
+    return CFE_SUCCESS;
+}
+
+int32 CFE_ES_GetTaskInfo(CFE_ES_TaskInfo_t *TaskInfo, uint32 TaskId)
+{
+    OS_task_prop_t TaskProp;
+
+    memset(TaskInfo, 0, sizeof(*TaskInfo));
+
+    TaskInfo->TaskId = TaskId;
+    strncpy((char *) TaskInfo->AppName, "PERF", OS_MAX_API_NAME - 1);
+
+    if (OS_TaskGetInfo(TaskId, &TaskProp) == OS_SUCCESS)
+    {
+        strncpy((char *) TaskInfo->TaskName, TaskProp.name, OS_MAX_API_NAME - 1);
+    }
+
+    return CFE_SUCCESS;
+}
+
+int32 CFE_ES_WriteToSysLog(const char *SpecStringPtr, ...)
+{
+    __atomic_add_fetch(&Perf_SysLogCount, 1, __ATOMIC_RELAXED);
+    return CFE_SUCCESS;
+}
+
+/* Weak so the performance log bench can link the real one */
+__attribute__((weak)) void CFE_ES_PerfLogAdd(uint32 Marker, uint32 EntryExit)
+{
+}
+
+
+/*
+** Event Services, weak so the event bench can link the real ones
+*/
+__attribute__((weak)) int32 CFE_EVS_Register(void *Filters, uint16 NumFilteredEvents, uint16 FilterScheme)
+{
+    return CFE_SUCCESS;
+}
+
+__attribute__((weak)) int32 CFE_EVS_SendEvent(uint16 EventID, uint16 EventType, const char *Spec, ...)
+{
+    __atomic_add_fetch(&Perf_EventCount, 1, __ATOMIC_RELAXED);
+    return CFE_SUCCESS;
+}
+
+__attribute__((weak)) int32 CFE_EVS_SendEventWithAppID(uint16 EventID, uint16 EventType, uint32 AppID,
+                                 const char *Spec, ...)
+{
+    __atomic_add_fetch(&Perf_EventCount, 1, __ATOMIC_RELAXED);
+    return CFE_SUCCESS;
+}
+
+
+/*
+** File Services
+*/
+void CFE_FS_InitHeader(CFE_FS_Header_t *Hdr, const char *Description, uint32 SubType)
+{
+    memset(Hdr, 0, sizeof(*Hdr));
+}
+
+int32 CFE_FS_WriteHeader(int32 FileDes, CFE_FS_Header_t *Hdr)
+{
+    return sizeof(CFE_FS_Header_t);
+}
+
+
+/*
+** Time Services, weak so the time bench can link the real ones
+*/
+__attribute__((weak)) CFE_TIME_SysTime_t CFE_TIME_GetTime(void)
+{
+    CFE_TIME_SysTime_t Time;
+    struct timespec    ts;
+
+    clock_gettime(CLOCK_REALTIME, &ts);
+
+    Time.Seconds    = (uint32) ts.tv_sec;
+    Time.Subseconds = (uint32) (((uint64) ts.tv_nsec << 32) / 1000000000);
+
+    return Time;
+}
+
+
+/*
+** Platform Support Package
+*/
+uint32 CFE_PSP_GetProcessorId(void)
+{
+    return 1;
+}
+
+uint32 CFE_PSP_GetSpacecraftId(void)
+{
+    return 0x42;
+}
+
+int32 CFE_PSP_MemCpy(void *dest, void *src, uint32 n)
+{
+    memcpy(dest, src, n);
+    return CFE_PSP_SUCCESS;
+}
+
+int32 CFE_PSP_MemSet(void *dest, uint8 value, uint32 n)
+{
+    memset(dest, value, n);
+    return CFE_PSP_SUCCESS;
+}
+
+int32 CFE_PSP_MemValidateRange(cpuaddr Address, uint32 Size, uint32 MemoryType)
+{
+    return CFE_PSP_SUCCESS;
+}
+
+
+/*
+** Bench helpers
+*/
+
+/* Monotonic time in seconds */
+double Perf_Now(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+
+    return ts.tv_sec + ts.tv_nsec / 1e9;
+}
+
+/* Wait for every task started for a run to call Perf_TaskDone */
+void Perf_WaitTasks(volatile uint32 *Running)
+{
+    while (__atomic_load_n(Running, __ATOMIC_ACQUIRE) != 0)
+    {
+        OS_TaskDelay(1);
+    }
+}
+
+/* Called by a bench task as its last act */
+void Perf_TaskDone(volatile uint32 *Running)
+{
+    __atomic_sub_fetch(Running, 1, __ATOMIC_RELEASE);
+    OS_TaskExit();
+}
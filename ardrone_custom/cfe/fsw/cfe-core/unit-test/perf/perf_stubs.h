@@ -0,0 +1,21 @@
+/*
+** File:
+**   perf_stubs.h
+**
+** Purpose:
+**   Helpers shared by the performance benches, see perf_stubs.c
+*/
+#ifndef _perf_stubs_
+#define _perf_stubs_
+
+#include "common_types.h"
+
+/* Events and system log messages the code under measurement produced */
+extern uint32 Perf_EventCount;
+extern uint32 Perf_SysLogCount;
+
+double Perf_Now(void);
+void   Perf_WaitTasks(volatile uint32 *Running);
+void   Perf_TaskDone(volatile uint32 *Running);
+
+#endif /* _perf_stubs_ */
@@ -0,0 +1,235 @@
+/*
+** File:
+**   sb_buf_perf.c
+**
+** Purpose:
+**   Software Bus buffer allocation bench.  Each of 1, 2, 4 and 8 tasks takes
+**   a few message buffers and gives them back, over and over, either
+**   straight from the SB memory pool or through the SB buffer cache:
+**
+**   - pool, CFE_ES_GetPoolBuf and CFE_ES_PutPoolBuf on the SB pool, the
+**     way SB allocated every message before the cache
+**   - cache, CFE_SB_GetBufferFromPool and CFE_SB_ReturnBufferToPool
+**
+**   and reports allocations per second and, for the cache, its hit rate.
+**
+** Notes:
+**   Built on the real SB, ES memory pool and OSAL, see perf_stubs.c.  OSAL
+**   tasks are SCHED_FIFO, so the tasks time themselves and give the
+**   processor up every SB_BUF_PERF_ROUNDS rounds.
+**
+**   Usage: sb_buf_perf [seconds per run]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+#include "cfe.h"
+#include "private/cfe_private.h"
+#include "cfe_sb_priv.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define SB_BUF_PERF_MID             0x0884
+#define SB_BUF_PERF_MAX_TASKS       8
+#define SB_BUF_PERF_HELD            4
+#define SB_BUF_PERF_ROUNDS          64
+#define SB_BUF_PERF_STACK_SIZE      16384
+#define SB_BUF_PERF_PRIORITY        100
+
+/*
+** Bench state, shared with the tasks
+*/
+typedef struct
+{
+    volatile uint32  Running;
+    boolean          UseCache;
+    uint16           Size;
+    double           Seconds;
+    uint32           Allocs[SB_BUF_PERF_MAX_TASKS];
+    uint32           Failed[SB_BUF_PERF_MAX_TASKS];
+    volatile uint32  Next;
+} SB_BufPerf_t;
+
+static SB_BufPerf_t SB_BufPerf;
+
+static const uint16 SB_BufPerfSizes[] = { 32, 200, 900, 1800 };
+
+
+/* Takes and gives back SB_BUF_PERF_HELD buffers until the run is over */
+static void SB_BufPerfTask(void)
+{
+    CFE_SB_BufferD_t *Held[SB_BUF_PERF_HELD];
+    uint32           *Block;
+    uint32            Index;
+    uint32            Allocs = 0;
+    uint32            Failed = 0;
+    uint32            Rounds = 0;
+    uint32            i;
+    double            End;
+
+    OS_TaskRegister();
+    Index = __atomic_fetch_add(&SB_BufPerf.Next, 1, __ATOMIC_RELAXED);
+    End = Perf_Now() + SB_BufPerf.Seconds;
+
+    do
+    {
+        for (i = 0; i < SB_BUF_PERF_HELD; i++)
+        {
+            if (SB_BufPerf.UseCache)
+            {
+                Held[i] = CFE_SB_GetBufferFromPool(SB_BUF_PERF_MID, SB_BufPerf.Size);
+            }
+            else if (CFE_ES_GetPoolBuf(&Block, CFE_SB.Mem.PoolHdl,
+                         SB_BufPerf.Size + sizeof(CFE_SB_BufferD_t)) >= 0)
+            {
+                Held[i] = (CFE_SB_BufferD_t *) Block;
+            }
+            else
+            {
+                Held[i] = NULL;
+            }
+
+            if (Held[i] == NULL)
+            {
+                Failed++;
+            }
+        }
+
+        for (i = 0; i < SB_BUF_PERF_HELD; i++)
+        {
+            if (Held[i] == NULL)
+            {
+                continue;
+            }
+
+            if (SB_BufPerf.UseCache)
+            {
+                CFE_SB_ReturnBufferToPool(Held[i]);
+            }
+            else
+            {
+                CFE_ES_PutPoolBuf(CFE_SB.Mem.PoolHdl, (uint32 *) Held[i]);
+            }
+
+            Allocs++;
+        }
+
+        if ((++Rounds % SB_BUF_PERF_ROUNDS) == 0)
+        {
+            sched_yield();
+        }
+
+    } while ((Rounds % SB_BUF_PERF_ROUNDS) != 0 || Perf_Now() < End);
+
+    SB_BufPerf.Allocs[Index] = Allocs;
+    SB_BufPerf.Failed[Index] = Failed;
+    Perf_TaskDone(&SB_BufPerf.Running);
+}
+
+
+static void SB_BufPerfRun(boolean UseCache, uint16 Size, uint32 Tasks, double Seconds)
+{
+    char   Name[OS_MAX_API_NAME];
+    uint32 TaskId;
+    uint32 Allocs = 0;
+    uint32 Failed = 0;
+    uint32 Hits;
+    uint32 Misses;
+    uint32 i;
+    int32  Status;
+
+    memset(&SB_BufPerf, 0, sizeof(SB_BufPerf));
+    SB_BufPerf.UseCache = UseCache;
+    SB_BufPerf.Size = Size;
+    SB_BufPerf.Seconds = Seconds;
+
+    CFE_SB_ReclaimBufCache();
+    CFE_SB_InitBufCache();
+    CFE_SB.StatTlmMsg.Payload.PeakBufCacheInUse = 0;
+
+    for (i = 0; i < Tasks; i++)
+    {
+        __atomic_add_fetch(&SB_BufPerf.Running, 1, __ATOMIC_RELAXED);
+        snprintf(Name, sizeof(Name), "BUF_PERF_%u", (unsigned int) i);
+
+        Status = OS_TaskCreate(&TaskId, Name, SB_BufPerfTask, NULL, SB_BUF_PERF_STACK_SIZE,
+                               SB_BUF_PERF_PRIORITY, 0);
+        if (Status != OS_SUCCESS)
+        {
+            fprintf(stderr, "cannot create task %s, error %d\n", Name, (int) Status);
+            exit(1);
+        }
+    }
+
+    Perf_WaitTasks(&SB_BufPerf.Running);
+
+    for (i = 0; i < Tasks; i++)
+    {
+        Allocs += SB_BufPerf.Allocs[i];
+        Failed += SB_BufPerf.Failed[i];
+    }
+
+    printf("%-6s %5u %6u %12.0f", UseCache ? "cache" : "pool", (unsigned int) Size,
+           (unsigned int) Tasks, Allocs / Seconds);
+
+    if (UseCache)
+    {
+        CFE_SB_GetBufCacheStats();
+        Hits = CFE_SB.StatTlmMsg.Payload.BufCacheHits;
+        Misses = CFE_SB.StatTlmMsg.Payload.BufCacheMisses;
+        printf(" %8.2f%% %6u", (Hits + Misses) ? 100.0 * Hits / (Hits + Misses) : 0.0,
+               (unsigned int) CFE_SB.StatTlmMsg.Payload.PeakBufCacheInUse);
+    }
+
+    if (Failed != 0)
+    {
+        printf("  %u failed", (unsigned int) Failed);
+    }
+
+    printf("\n");
+}
+
+
+int main(int argc, char *argv[])
+{
+    double Seconds = 0.5;
+    uint32 s;
+    uint32 Tasks;
+
+    if (argc > 1)
+    {
+        Seconds = strtod(argv[1], NULL);
+    }
+
+    if (OS_API_Init() != OS_SUCCESS || CFE_SB_EarlyInit() != CFE_SUCCESS)
+    {
+        fprintf(stderr, "initialization failed\n");
+        return 1;
+    }
+
+    printf("SB buffer allocation, %u buffers held per round, %.2f s per run\n",
+           (unsigned int) SB_BUF_PERF_HELD, Seconds);
+    printf("source  size  tasks     allocs/s  hit rate   peak\n");
+
+    for (s = 0; s < sizeof(SB_BufPerfSizes) / sizeof(SB_BufPerfSizes[0]); s++)
+    {
+        for (Tasks = 1; Tasks <= SB_BUF_PERF_MAX_TASKS; Tasks *= 2)
+        {
+            SB_BufPerfRun(FALSE, SB_BufPerfSizes[s], Tasks, Seconds);
+            SB_BufPerfRun(TRUE, SB_BufPerfSizes[s], Tasks, Seconds);
+        }
+    }
+
+    printf("%u events, %u system log messages\n",
+           (unsigned int) Perf_EventCount, (unsigned int) Perf_SysLogCount);
+
+    return 0;
+}
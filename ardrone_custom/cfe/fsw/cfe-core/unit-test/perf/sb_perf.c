@@ -0,0 +1,248 @@
+/*
+** File:
+**   sb_perf.c
+**
+** Purpose:
+**   Software Bus fan-out bench.  Several tasks send the same message at
+**   once, as fast as they can, to a message ID subscribed to by many pipes,
+**   each drained by a task of its own.  Runs every combination of 1 to 8
+**   senders and 1 to 16 pipes and reports what was sent and delivered.
+**
+** Notes:
+**   Built on the real SB, ES memory pool and OSAL, see perf_stubs.c.
+**   Messages a pipe had no room for are counted as dropped; with more
+**   senders than the receivers can keep up with that is expected.
+**
+**   Usage: sb_perf [seconds per run]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+#include "cfe.h"
+#include "private/cfe_private.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define SB_PERF_MID             0x0880
+#define SB_PERF_MSG_SIZE        64
+#define SB_PERF_MAX_SENDERS     8
+#define SB_PERF_MAX_PIPES       16
+#define SB_PERF_PIPE_DEPTH      64
+#define SB_PERF_STACK_SIZE      16384
+#define SB_PERF_SEND_PRIORITY   110
+#define SB_PERF_RCV_PRIORITY    100
+
+/*
+** Bench state, shared with the tasks
+*/
+typedef struct
+{
+    volatile uint32  Stop;
+    volatile uint32  Running;
+    uint32           NextTask;
+    uint32           Run;
+    CFE_SB_PipeId_t  Pipe[SB_PERF_MAX_PIPES];
+    uint32           Sent[SB_PERF_MAX_SENDERS];
+    uint32           Delivered[SB_PERF_MAX_PIPES];
+} SB_Perf_t;
+
+static SB_Perf_t SB_Perf;
+
+
+static void SB_PerfSender(void)
+{
+    uint32 Idx;
+    uint32 Sent = 0;
+    uint32 Tries = 0;
+    uint8  Msg[SB_PERF_MSG_SIZE];
+
+    OS_TaskRegister();
+    Idx = __atomic_fetch_add(&SB_Perf.NextTask, 1, __ATOMIC_RELAXED);
+
+    CFE_SB_InitMsg(Msg, SB_PERF_MID, sizeof(Msg), TRUE);
+
+    while (__atomic_load_n(&SB_Perf.Stop, __ATOMIC_RELAXED) == 0)
+    {
+        if (CFE_SB_SendMsg((CFE_SB_Msg_t *) Msg) == CFE_SUCCESS)
+        {
+            Sent++;
+        }
+
+        /*
+        ** OSAL tasks are SCHED_FIFO, without this a sender never gives the
+        ** processor up to another at its priority on a uniprocessor
+        */
+        if ((++Tries % SB_PERF_PIPE_DEPTH) == 0)
+        {
+            sched_yield();
+        }
+    }
+
+    SB_Perf.Sent[Idx] = Sent;
+    Perf_TaskDone(&SB_Perf.Running);
+}
+
+
+static void SB_PerfReceiver(void)
+{
+    uint32          Idx;
+    uint32          Delivered = 0;
+    CFE_SB_MsgPtr_t MsgPtr;
+
+    OS_TaskRegister();
+    Idx = __atomic_fetch_add(&SB_Perf.NextTask, 1, __ATOMIC_RELAXED);
+
+    while (__atomic_load_n(&SB_Perf.Stop, __ATOMIC_RELAXED) == 0)
+    {
+        if (CFE_SB_RcvMsg(&MsgPtr, SB_Perf.Pipe[Idx], 10) == CFE_SUCCESS)
+        {
+            Delivered++;
+        }
+    }
+
+    SB_Perf.Delivered[Idx] = Delivered;
+    Perf_TaskDone(&SB_Perf.Running);
+}
+
+
+/*
+** Start Count tasks running Entry, numbered from 0 in the order they start.
+** Names carry the run number, a task of the last run may not have left the
+** OSAL task table yet.
+*/
+static void SB_PerfStart(const char *Name, osal_task_entry Entry, uint32 Count,
+                         uint32 Priority)
+{
+    char   TaskName[OS_MAX_API_NAME];
+    uint32 TaskId;
+    int32  Status;
+    uint32 i;
+
+    SB_Perf.NextTask = 0;
+
+    for (i = 0; i < Count; i++)
+    {
+        snprintf(TaskName, sizeof(TaskName), "%s%u_%u", Name,
+                 (unsigned int) SB_Perf.Run, (unsigned int) i);
+        __atomic_add_fetch(&SB_Perf.Running, 1, __ATOMIC_RELAXED);
+
+        Status = OS_TaskCreate(&TaskId, TaskName, Entry, NULL, SB_PERF_STACK_SIZE,
+                               Priority, 0);
+        if (Status != OS_SUCCESS)
+        {
+            fprintf(stderr, "cannot create task %s, error %d\n", TaskName, (int) Status);
+            exit(1);
+        }
+    }
+
+    /* the tasks take their numbers before the next group starts */
+    while (__atomic_load_n(&SB_Perf.NextTask, __ATOMIC_RELAXED) < Count)
+    {
+        OS_TaskDelay(1);
+    }
+}
+
+
+static void SB_PerfRun(uint32 Run, uint32 Senders, uint32 Pipes, double Seconds)
+{
+    char   PipeName[OS_MAX_API_NAME];
+    uint64 Sent = 0;
+    uint64 Delivered = 0;
+    double Start;
+    double Elapsed;
+    uint32 i;
+
+    memset(&SB_Perf, 0, sizeof(SB_Perf));
+    SB_Perf.Run = Run;
+
+    for (i = 0; i < Pipes; i++)
+    {
+        snprintf(PipeName, sizeof(PipeName), "PERF_PIPE%u", (unsigned int) i);
+
+        if (CFE_SB_CreatePipe(&SB_Perf.Pipe[i], SB_PERF_PIPE_DEPTH, PipeName) != CFE_SUCCESS ||
+            CFE_SB_SubscribeEx(SB_PERF_MID, SB_Perf.Pipe[i], CFE_SB_Default_Qos,
+                               SB_PERF_PIPE_DEPTH) != CFE_SUCCESS)
+        {
+            fprintf(stderr, "cannot set up pipe %s\n", PipeName);
+            exit(1);
+        }
+    }
+
+    /*
+    ** Receivers run above the senders so a sender busy in SendMsg cannot
+    ** starve them when there are fewer processors than tasks
+    */
+    SB_PerfStart("RCV", SB_PerfReceiver, Pipes, SB_PERF_RCV_PRIORITY);
+
+    Start = Perf_Now();
+    SB_PerfStart("SND", SB_PerfSender, Senders, SB_PERF_SEND_PRIORITY);
+
+    OS_TaskDelay((uint32) (Seconds * 1000));
+    __atomic_store_n(&SB_Perf.Stop, 1, __ATOMIC_RELAXED);
+
+    Perf_WaitTasks(&SB_Perf.Running);
+    Elapsed = Perf_Now() - Start;
+
+    for (i = 0; i < Senders; i++)
+    {
+        Sent += SB_Perf.Sent[i];
+    }
+
+    for (i = 0; i < Pipes; i++)
+    {
+        Delivered += SB_Perf.Delivered[i];
+        CFE_SB_DeletePipe(SB_Perf.Pipe[i]);
+    }
+
+    printf("%7u %6u %12.0f %12.0f %11.1f%%\n",
+           (unsigned int) Senders, (unsigned int) Pipes,
+           Sent / Elapsed, Delivered / Elapsed,
+           Sent ? 100.0 * (Sent * Pipes - Delivered) / (Sent * Pipes) : 0.0);
+}
+
+
+int main(int argc, char *argv[])
+{
+    static const uint32 Senders[] = {1, 2, 4, 8};
+    static const uint32 Pipes[]   = {1, 2, 4, 8, 16};
+    double Seconds = 0.5;
+    uint32 Run = 0;
+    uint32 s;
+    uint32 p;
+
+    if (argc > 1)
+    {
+        Seconds = strtod(argv[1], NULL);
+    }
+
+    if (OS_API_Init() != OS_SUCCESS || CFE_SB_EarlyInit() != CFE_SUCCESS)
+    {
+        fprintf(stderr, "initialization failed\n");
+        return 1;
+    }
+
+    printf("SB fan-out, %u byte messages, %.2f s per run\n",
+           (unsigned int) SB_PERF_MSG_SIZE, Seconds);
+    printf("senders  pipes       sent/s  delivered/s     dropped\n");
+
+    for (s = 0; s < sizeof(Senders) / sizeof(Senders[0]); s++)
+    {
+        for (p = 0; p < sizeof(Pipes) / sizeof(Pipes[0]); p++)
+        {
+            SB_PerfRun(Run++, Senders[s], Pipes[p], Seconds);
+        }
+    }
+
+    printf("%u events, %u system log messages\n",
+           (unsigned int) Perf_EventCount, (unsigned int) Perf_SysLogCount);
+
+    return 0;
+}
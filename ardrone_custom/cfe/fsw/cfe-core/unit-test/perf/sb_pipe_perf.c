@@ -0,0 +1,315 @@
+/*
+** File:
+**   sb_pipe_perf.c
+**
+** Purpose:
+**   Software Bus pipe bench.  Compares pipes on the OS queue with pipes on
+**   the in-process queue, CFE_SB_PIPE_QUEUE_OS against CFE_SB_PIPE_QUEUE_RING:
+**
+**   - ping-pong, one message bounced between two tasks through two pipes,
+**     gives the round trip time of a send and a pending receive
+**   - throughput, one task sending as fast as it can to a pipe another
+**     task drains, gives messages per second through one pipe
+**
+** Notes:
+**   Built on the real SB, ES memory pool and OSAL, see perf_stubs.c.  The
+**   OS queue is the one the OSAL was built for, sockets or POSIX message
+**   queues; sb_pipe_perf_mq is this bench on an OSAL built for the latter.
+**   Its pipes are 64 deep, more than the POSIX queue limit many Linux
+**   systems ship with, see /proc/sys/fs/mqueue/msg_max.
+**
+**   Usage: sb_pipe_perf [round trips] [seconds of throughput]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+#include "cfe.h"
+#include "private/cfe_private.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define SB_PIPE_PERF_PING_MID       0x0881
+#define SB_PIPE_PERF_PONG_MID       0x0882
+#define SB_PIPE_PERF_DATA_MID       0x0883
+#define SB_PIPE_PERF_MSG_SIZE       64
+#define SB_PIPE_PERF_PIPE_DEPTH     64
+#define SB_PIPE_PERF_STACK_SIZE     16384
+#define SB_PIPE_PERF_PRIORITY       100
+#define SB_PIPE_PERF_MAX_TRIPS      1000000
+
+#ifdef OSAL_SOCKET_QUEUE
+#define SB_PIPE_PERF_OS_QUEUE       "socket"
+#else
+#define SB_PIPE_PERF_OS_QUEUE       "mq"
+#endif
+
+/*
+** Bench state, shared with the tasks
+*/
+typedef struct
+{
+    volatile uint32  Stop;
+    volatile uint32  Running;
+    CFE_SB_PipeId_t  Pipe;
+    uint32           Sent;
+    uint32           Delivered;
+} SB_PipePerf_t;
+
+static SB_PipePerf_t SB_PipePerf;
+static double        SB_PipePerfTrip[SB_PIPE_PERF_MAX_TRIPS];
+
+
+static int SB_PipePerfCompare(const void *a, const void *b)
+{
+    double x = *(const double *) a;
+    double y = *(const double *) b;
+
+    return (x > y) - (x < y);
+}
+
+
+/* Answers every ping on SB_PipePerf.Pipe with a pong */
+static void SB_PipePerfPong(void)
+{
+    CFE_SB_MsgPtr_t MsgPtr;
+    uint8           Pong[SB_PIPE_PERF_MSG_SIZE];
+
+    OS_TaskRegister();
+    CFE_SB_InitMsg(Pong, SB_PIPE_PERF_PONG_MID, sizeof(Pong), TRUE);
+
+    while (__atomic_load_n(&SB_PipePerf.Stop, __ATOMIC_RELAXED) == 0)
+    {
+        if (CFE_SB_RcvMsg(&MsgPtr, SB_PipePerf.Pipe, 10) == CFE_SUCCESS)
+        {
+            CFE_SB_SendMsg((CFE_SB_Msg_t *) Pong);
+        }
+    }
+
+    Perf_TaskDone(&SB_PipePerf.Running);
+}
+
+
+/*
+** Sends to SB_PipePerf.Pipe as fast as it can.  OSAL tasks are SCHED_FIFO,
+** so the sender gives the processor up each time it has sent a pipe full,
+** and on a uniprocessor the receiver takes them in batches.
+*/
+static void SB_PipePerfSender(void)
+{
+    uint8  Msg[SB_PIPE_PERF_MSG_SIZE];
+    uint32 Sent = 0;
+    uint32 Tries = 0;
+
+    OS_TaskRegister();
+    CFE_SB_InitMsg(Msg, SB_PIPE_PERF_DATA_MID, sizeof(Msg), TRUE);
+
+    while (__atomic_load_n(&SB_PipePerf.Stop, __ATOMIC_RELAXED) == 0)
+    {
+        if (CFE_SB_SendMsg((CFE_SB_Msg_t *) Msg) == CFE_SUCCESS)
+        {
+            Sent++;
+        }
+
+        if ((++Tries % SB_PIPE_PERF_PIPE_DEPTH) == 0)
+        {
+            sched_yield();
+        }
+    }
+
+    SB_PipePerf.Sent = Sent;
+    Perf_TaskDone(&SB_PipePerf.Running);
+}
+
+
+/* Drains SB_PipePerf.Pipe */
+static void SB_PipePerfReceiver(void)
+{
+    CFE_SB_MsgPtr_t MsgPtr;
+    uint32          Delivered = 0;
+
+    OS_TaskRegister();
+
+    while (__atomic_load_n(&SB_PipePerf.Stop, __ATOMIC_RELAXED) == 0)
+    {
+        if (CFE_SB_RcvMsg(&MsgPtr, SB_PipePerf.Pipe, 10) == CFE_SUCCESS)
+        {
+            Delivered++;
+        }
+    }
+
+    SB_PipePerf.Delivered = Delivered;
+    Perf_TaskDone(&SB_PipePerf.Running);
+}
+
+
+static void SB_PipePerfStart(const char *Name, osal_task_entry Entry)
+{
+    uint32 TaskId;
+    int32  Status;
+
+    __atomic_add_fetch(&SB_PipePerf.Running, 1, __ATOMIC_RELAXED);
+
+    Status = OS_TaskCreate(&TaskId, Name, Entry, NULL, SB_PIPE_PERF_STACK_SIZE,
+                           SB_PIPE_PERF_PRIORITY, 0);
+    if (Status != OS_SUCCESS)
+    {
+        fprintf(stderr, "cannot create task %s, error %d\n", Name, (int) Status);
+        exit(1);
+    }
+}
+
+
+static CFE_SB_PipeId_t SB_PipePerfPipe(const char *Name, uint8 QueueType, CFE_SB_MsgId_t MsgId)
+{
+    CFE_SB_PipeId_t PipeId;
+
+    if (CFE_SB_CreatePipeEx(&PipeId, SB_PIPE_PERF_PIPE_DEPTH, Name, QueueType) != CFE_SUCCESS ||
+        CFE_SB_SubscribeEx(MsgId, PipeId, CFE_SB_Default_Qos,
+                           SB_PIPE_PERF_PIPE_DEPTH) != CFE_SUCCESS)
+    {
+        fprintf(stderr, "cannot set up pipe %s\n", Name);
+        exit(1);
+    }
+
+    return PipeId;
+}
+
+
+/*
+** The calling task pings, another task pongs.  Each waits in CFE_SB_RcvMsg
+** for the other's message, so every trip is two wake-ups.
+*/
+static void SB_PipePerfPingPong(const char *Label, uint8 QueueType, uint32 Trips)
+{
+    CFE_SB_PipeId_t ReplyPipe;
+    CFE_SB_MsgPtr_t MsgPtr;
+    uint8           Ping[SB_PIPE_PERF_MSG_SIZE];
+    double          Start;
+    double          Sum = 0.0;
+    uint32          Done = 0;
+    uint32          i;
+
+    memset(&SB_PipePerf, 0, sizeof(SB_PipePerf));
+    SB_PipePerf.Pipe = SB_PipePerfPipe("PERF_PING", QueueType, SB_PIPE_PERF_PING_MID);
+    ReplyPipe = SB_PipePerfPipe("PERF_PONG", QueueType, SB_PIPE_PERF_PONG_MID);
+
+    CFE_SB_InitMsg(Ping, SB_PIPE_PERF_PING_MID, sizeof(Ping), TRUE);
+    SB_PipePerfStart(QueueType == CFE_SB_PIPE_QUEUE_RING ? "PONG_RING" : "PONG_OS",
+                     SB_PipePerfPong);
+
+    for (i = 0; i < Trips; i++)
+    {
+        Start = Perf_Now();
+        CFE_SB_SendMsg((CFE_SB_Msg_t *) Ping);
+
+        if (CFE_SB_RcvMsg(&MsgPtr, ReplyPipe, 1000) != CFE_SUCCESS)
+        {
+            break;
+        }
+
+        SB_PipePerfTrip[Done] = (Perf_Now() - Start) * 1e6;
+        Sum += SB_PipePerfTrip[Done];
+        Done++;
+    }
+
+    __atomic_store_n(&SB_PipePerf.Stop, 1, __ATOMIC_RELAXED);
+    Perf_WaitTasks(&SB_PipePerf.Running);
+
+    CFE_SB_DeletePipe(SB_PipePerf.Pipe);
+    CFE_SB_DeletePipe(ReplyPipe);
+
+    if (Done == 0)
+    {
+        printf("%-8s  no replies\n", Label);
+        return;
+    }
+
+    qsort(SB_PipePerfTrip, Done, sizeof(SB_PipePerfTrip[0]), SB_PipePerfCompare);
+
+    printf("%-8s %8u %9.2f %9.2f %9.2f %9.2f\n", Label, (unsigned int) Done,
+           Sum / Done, SB_PipePerfTrip[Done / 2], SB_PipePerfTrip[(Done * 99) / 100],
+           SB_PipePerfTrip[Done - 1]);
+}
+
+
+/* One task sends, another drains the pipe */
+static void SB_PipePerfThroughput(const char *Label, uint8 QueueType, double Seconds)
+{
+    double Start;
+    double Elapsed;
+
+    memset(&SB_PipePerf, 0, sizeof(SB_PipePerf));
+    SB_PipePerf.Pipe = SB_PipePerfPipe("PERF_DATA", QueueType, SB_PIPE_PERF_DATA_MID);
+
+    SB_PipePerfStart(QueueType == CFE_SB_PIPE_QUEUE_RING ? "RCV_RING" : "RCV_OS",
+                     SB_PipePerfReceiver);
+
+    Start = Perf_Now();
+    SB_PipePerfStart(QueueType == CFE_SB_PIPE_QUEUE_RING ? "SND_RING" : "SND_OS",
+                     SB_PipePerfSender);
+
+    OS_TaskDelay((uint32) (Seconds * 1000));
+    __atomic_store_n(&SB_PipePerf.Stop, 1, __ATOMIC_RELAXED);
+
+    Perf_WaitTasks(&SB_PipePerf.Running);
+    Elapsed = Perf_Now() - Start;
+
+    CFE_SB_DeletePipe(SB_PipePerf.Pipe);
+
+    printf("%-8s %12.0f %12.0f %11.1f%%\n", Label, SB_PipePerf.Sent / Elapsed,
+           SB_PipePerf.Delivered / Elapsed,
+           SB_PipePerf.Sent ?
+               100.0 * (SB_PipePerf.Sent - SB_PipePerf.Delivered) / SB_PipePerf.Sent : 0.0);
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32 Trips = 20000;
+    double Seconds = 1.0;
+
+    if (argc > 1)
+    {
+        Trips = strtoul(argv[1], NULL, 0);
+        if (Trips > SB_PIPE_PERF_MAX_TRIPS)
+        {
+            Trips = SB_PIPE_PERF_MAX_TRIPS;
+        }
+    }
+
+    if (argc > 2)
+    {
+        Seconds = strtod(argv[2], NULL);
+    }
+
+    if (OS_API_Init() != OS_SUCCESS || CFE_SB_EarlyInit() != CFE_SUCCESS)
+    {
+        fprintf(stderr, "initialization failed\n");
+        return 1;
+    }
+
+    printf("SB pipe ping-pong, %u byte messages, round trip in us\n",
+           (unsigned int) SB_PIPE_PERF_MSG_SIZE);
+    printf("queue       trips      mean    median       p99       max\n");
+    SB_PipePerfPingPong(SB_PIPE_PERF_OS_QUEUE, CFE_SB_PIPE_QUEUE_OS, Trips);
+    SB_PipePerfPingPong("ring", CFE_SB_PIPE_QUEUE_RING, Trips);
+
+    printf("\nSB pipe throughput, %u byte messages, %.2f s per run\n",
+           (unsigned int) SB_PIPE_PERF_MSG_SIZE, Seconds);
+    printf("queue          sent/s  delivered/s     dropped\n");
+    SB_PipePerfThroughput(SB_PIPE_PERF_OS_QUEUE, CFE_SB_PIPE_QUEUE_OS, Seconds);
+    SB_PipePerfThroughput("ring", CFE_SB_PIPE_QUEUE_RING, Seconds);
+
+    printf("%u events, %u system log messages\n",
+           (unsigned int) Perf_EventCount, (unsigned int) Perf_SysLogCount);
+
+    return 0;
+}
@@ -0,0 +1,165 @@
+/*
+** File:
+**   sb_send_perf.c
+**
+** Purpose:
+**   Software Bus send cost bench.  One task sends a pipe full of messages,
+**   drains the pipe and does it again, timing only the sends, with sender
+**   reporting off and on.  A third run does with reporting on what SB did
+**   before the sender information was cached, looking the app.tsk name up
+**   and copying it for every message, to show what the cache saves.
+**
+** Notes:
+**   Built on the real SB, ES memory pool and OSAL, see perf_stubs.c.  The
+**   CFE_ES_GetTaskInfo stand-in does not take the ES lock the real one
+**   does, so the per-send lookup costs less here than on a running system.
+**
+**   Usage: sb_send_perf [sends per run]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "cfe.h"
+#include "private/cfe_private.h"
+#include "cfe_sb_priv.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define SB_SEND_PERF_MID            0x0885
+#define SB_SEND_PERF_MSG_SIZE       64
+#define SB_SEND_PERF_PIPE_DEPTH     64
+#define SB_SEND_PERF_STACK_SIZE     16384
+#define SB_SEND_PERF_PRIORITY       100
+
+/*
+** Bench state, shared with the task
+*/
+typedef struct
+{
+    volatile uint32  Running;
+    uint32           Sends;
+    uint32           Reporting;
+    boolean          LookUp;
+    double           Seconds;
+} SB_SendPerf_t;
+
+static SB_SendPerf_t SB_SendPerf;
+
+
+/* Sends SB_SendPerf.Sends messages a pipe full at a time */
+static void SB_SendPerfTask(void)
+{
+    CFE_SB_PipeId_t   PipeId;
+    CFE_SB_MsgPtr_t   MsgPtr;
+    CFE_SB_SenderId_t Sender;
+    char              FullName[(OS_MAX_API_NAME * 2)];
+    uint8             Msg[SB_SEND_PERF_MSG_SIZE];
+    uint32            TskId;
+    uint32            Sent = 0;
+    uint32            i;
+    double            Start;
+
+    OS_TaskRegister();
+    CFE_SB_RegisterSender();
+    TskId = OS_TaskGetId();
+
+    if (CFE_SB_CreatePipe(&PipeId, SB_SEND_PERF_PIPE_DEPTH, "PERF_SEND") != CFE_SUCCESS ||
+        CFE_SB_SubscribeEx(SB_SEND_PERF_MID, PipeId, CFE_SB_Default_Qos,
+                           SB_SEND_PERF_PIPE_DEPTH) != CFE_SUCCESS)
+    {
+        fprintf(stderr, "cannot set up pipe PERF_SEND\n");
+        exit(1);
+    }
+
+    CFE_SB_InitMsg(Msg, SB_SEND_PERF_MID, sizeof(Msg), TRUE);
+    CFE_SB.SenderReporting = SB_SendPerf.Reporting;
+
+    while (Sent < SB_SendPerf.Sends)
+    {
+        Start = Perf_Now();
+
+        for (i = 0; i < SB_SEND_PERF_PIPE_DEPTH; i++)
+        {
+            CFE_SB_SendMsg((CFE_SB_Msg_t *) Msg);
+
+            if (SB_SendPerf.LookUp)
+            {
+                Sender.ProcessorId = CFE_PSP_GetProcessorId();
+                strncpy(&Sender.AppName[0], CFE_SB_GetAppTskName(TskId, FullName),
+                        OS_MAX_API_NAME - 1);
+            }
+        }
+
+        SB_SendPerf.Seconds += Perf_Now() - Start;
+        Sent += SB_SEND_PERF_PIPE_DEPTH;
+
+        while (CFE_SB_RcvMsg(&MsgPtr, PipeId, CFE_SB_POLL) == CFE_SUCCESS)
+        {
+        }
+    }
+
+    CFE_SB_DeletePipe(PipeId);
+    Perf_TaskDone(&SB_SendPerf.Running);
+}
+
+
+static void SB_SendPerfRun(const char *Label, uint32 Reporting, boolean LookUp, uint32 Sends)
+{
+    uint32 TaskId;
+    int32  Status;
+
+    memset(&SB_SendPerf, 0, sizeof(SB_SendPerf));
+    SB_SendPerf.Sends = Sends;
+    SB_SendPerf.Reporting = Reporting;
+    SB_SendPerf.LookUp = LookUp;
+    SB_SendPerf.Running = 1;
+
+    Status = OS_TaskCreate(&TaskId, "SEND_PERF", SB_SendPerfTask, NULL,
+                           SB_SEND_PERF_STACK_SIZE, SB_SEND_PERF_PRIORITY, 0);
+    if (Status != OS_SUCCESS)
+    {
+        fprintf(stderr, "cannot create task SEND_PERF, error %d\n", (int) Status);
+        exit(1);
+    }
+
+    Perf_WaitTasks(&SB_SendPerf.Running);
+
+    printf("%-20s %10u %10.1f %12.0f\n", Label, (unsigned int) Sends,
+           SB_SendPerf.Seconds * 1e9 / Sends, Sends / SB_SendPerf.Seconds);
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32 Sends = 1000000;
+
+    if (argc > 1)
+    {
+        Sends = strtoul(argv[1], NULL, 0);
+    }
+
+    if (OS_API_Init() != OS_SUCCESS || CFE_SB_EarlyInit() != CFE_SUCCESS)
+    {
+        fprintf(stderr, "initialization failed\n");
+        return 1;
+    }
+
+    printf("SB send cost, %u byte messages, one subscriber\n",
+           (unsigned int) SB_SEND_PERF_MSG_SIZE);
+    printf("sender reporting          sends    ns/send       sends/s\n");
+    SB_SendPerfRun("off", 0, FALSE, Sends);
+    SB_SendPerfRun("on", 1, FALSE, Sends);
+    SB_SendPerfRun("on, lookup per send", 0, TRUE, Sends);
+
+    printf("%u events, %u system log messages\n",
+           (unsigned int) Perf_EventCount, (unsigned int) Perf_SysLogCount);
+
+    return 0;
+}
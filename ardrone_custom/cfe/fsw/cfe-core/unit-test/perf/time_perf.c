@@ -0,0 +1,339 @@
+/*
+** File:
+**   time_perf.c
+**
+** Purpose:
+**   Time Services read bench.  Reports ns per CFE_TIME_GetTime with the
+**   local clock latched either
+**
+**   - time, from CFE_PSP_GetTime converted from microseconds, the way
+**     CFE_TIME_LatchClock always did
+**   - timebase, from the PSP timebase with the conversion worked out once
+**
+**   then has 1, 2 and 4 tasks read the time while another task updates
+**   the time at the tone over and over, reading the reference either
+**
+**   - version, retried on VersionCount, the way CFE_TIME_GetReference did
+**     before the reference sequence (copied below)
+**   - sequence, through CFE_TIME_GetTime
+**
+**   Each update moves the MET at the tone one way and the STCF the other,
+**   so the time never changes, and gives the processor up half way through
+**   the way an update with interrupts not really locked can be preempted.
+**   Every time a task reads is checked against the one before, a jump of
+**   more than TIME_PERF_SLACK seconds is a torn reference.
+**
+** Notes:
+**   Built on the real TIME code, less cfe_time_task.c, so the bench holds
+**   the TIME global data.  OSAL tasks are SCHED_FIFO, so the readers give
+**   the processor up every TIME_PERF_ROUNDS reads.
+**
+**   Usage: time_perf [seconds per run]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sched.h>
+
+#include "cfe.h"
+#include "cfe_time_utils.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define TIME_PERF_MAX_TASKS     4
+#define TIME_PERF_ROUNDS        64
+#define TIME_PERF_STEP          1000   /* seconds moved between MET and STCF */
+#define TIME_PERF_SLACK         10     /* seconds a read may move on by */
+#define TIME_PERF_STACK_SIZE    16384
+#define TIME_PERF_PRIORITY      100
+
+/*
+** TIME global data, cfe_time_task.c is not part of the bench
+*/
+CFE_TIME_TaskData_t CFE_TIME_TaskData;
+
+/*
+** Bench state, shared with the tasks
+*/
+typedef struct
+{
+    volatile uint32  Running;
+    volatile uint32  Reading;
+    boolean          UseSequence;
+    double           Seconds;
+    uint32           Reads[TIME_PERF_MAX_TASKS];
+    uint32           Jumps[TIME_PERF_MAX_TASKS];
+    uint32           Updates;
+    volatile uint32  Next;
+} TIME_Perf_t;
+
+static TIME_Perf_t TIME_Perf;
+static double      TIME_PerfMeasure = 1.0;
+
+
+/*
+** Stand-ins for what the tone and reset area code, unused here, needs
+*/
+int32 CFE_SB_SendMsg(CFE_SB_Msg_t *MsgPtr)
+{
+    return CFE_SUCCESS;
+}
+
+int32 CFE_ES_RegisterChildTask(void)
+{
+    return CFE_SUCCESS;
+}
+
+int32 CFE_PSP_GetResetArea(cpuaddr *PtrToResetArea, uint32 *SizeOfResetArea)
+{
+    return CFE_PSP_ERROR;
+}
+
+
+/*
+** CFE_TIME_GetReference before the reference sequence, retried only when
+** VersionCount changed, which an update does at its end
+*/
+static void TIME_PerfGetReferenceVersion(CFE_TIME_Reference_t *Reference)
+{
+    uint32 VersionCount;
+
+    do
+    {
+        VersionCount = CFE_TIME_TaskData.VersionCount;
+
+        Reference->CurrentLatch = CFE_TIME_LatchClock();
+
+        Reference->AtToneMET    = CFE_TIME_TaskData.AtToneMET;
+        Reference->AtToneSTCF   = CFE_TIME_TaskData.AtToneSTCF;
+        Reference->AtToneLeaps  = CFE_TIME_TaskData.AtToneLeaps;
+        Reference->AtToneDelay  = CFE_TIME_TaskData.AtToneDelay;
+        Reference->AtToneLatch  = CFE_TIME_TaskData.AtToneLatch;
+
+        Reference->ClockSetState  = CFE_TIME_TaskData.ClockSetState;
+        Reference->ClockFlyState  = CFE_TIME_TaskData.ClockFlyState;
+
+    } while (VersionCount != CFE_TIME_TaskData.VersionCount);
+
+    Reference->TimeSinceTone = CFE_TIME_Subtract(Reference->CurrentLatch, Reference->AtToneLatch);
+    Reference->CurrentMET = CFE_TIME_Add(Reference->TimeSinceTone, Reference->AtToneMET);
+}
+
+
+/* CFE_TIME_GetTime on the old reference */
+static CFE_TIME_SysTime_t TIME_PerfGetTimeVersion(void)
+{
+    CFE_TIME_Reference_t Reference;
+
+    TIME_PerfGetReferenceVersion(&Reference);
+
+#if (CFE_TIME_CFG_DEFAULT_TAI == TRUE)
+    return CFE_TIME_CalculateTAI(&Reference);
+#else
+    return CFE_TIME_CalculateUTC(&Reference);
+#endif
+}
+
+
+/* Reads the time until the run is over, checking each read against the last */
+static void TIME_PerfReaderTask(void)
+{
+    CFE_TIME_SysTime_t Last;
+    CFE_TIME_SysTime_t Time;
+    CFE_TIME_SysTime_t Moved;
+    uint32             Index;
+    uint32             Reads = 0;
+    uint32             Jumps = 0;
+    double             End;
+
+    OS_TaskRegister();
+    Index = __atomic_fetch_add(&TIME_Perf.Next, 1, __ATOMIC_RELAXED);
+    End = Perf_Now() + TIME_Perf.Seconds;
+    Last = CFE_TIME_GetTime();
+
+    do
+    {
+        Time = TIME_Perf.UseSequence ? CFE_TIME_GetTime() : TIME_PerfGetTimeVersion();
+
+        Moved = CFE_TIME_Subtract(Time, Last);
+        if (Moved.Seconds >= TIME_PERF_SLACK)
+        {
+            Jumps++;
+        }
+        Last = Time;
+
+        if ((++Reads % TIME_PERF_ROUNDS) == 0)
+        {
+            sched_yield();
+        }
+
+    } while ((Reads % TIME_PERF_ROUNDS) != 0 || Perf_Now() < End);
+
+    TIME_Perf.Reads[Index] = Reads;
+    TIME_Perf.Jumps[Index] = Jumps;
+    __atomic_sub_fetch(&TIME_Perf.Reading, 1, __ATOMIC_RELEASE);
+    Perf_TaskDone(&TIME_Perf.Running);
+}
+
+
+/*
+** Moves TIME_PERF_STEP seconds between the MET and the STCF at the tone
+** until the readers are done, preempted half way through every update
+*/
+static void TIME_PerfWriterTask(void)
+{
+    int32 Step = TIME_PERF_STEP;
+
+    OS_TaskRegister();
+
+    while (__atomic_load_n(&TIME_Perf.Reading, __ATOMIC_ACQUIRE) != 0)
+    {
+        CFE_TIME_BeginReferenceUpdate();
+        CFE_TIME_TaskData.AtToneMET.Seconds += Step;
+        sched_yield();
+        CFE_TIME_TaskData.AtToneSTCF.Seconds -= Step;
+        CFE_TIME_EndReferenceUpdate();
+
+        Step = -Step;
+        TIME_Perf.Updates++;
+        sched_yield();
+    }
+
+    Perf_TaskDone(&TIME_Perf.Running);
+}
+
+
+static void TIME_PerfStartTask(const char *Name, osal_task_entry Entry)
+{
+    uint32 TaskId;
+    int32  Status;
+
+    __atomic_add_fetch(&TIME_Perf.Running, 1, __ATOMIC_RELAXED);
+
+    Status = OS_TaskCreate(&TaskId, Name, Entry, NULL, TIME_PERF_STACK_SIZE,
+                           TIME_PERF_PRIORITY, 0);
+    if (Status != OS_SUCCESS)
+    {
+        fprintf(stderr, "cannot create task %s, error %d\n", Name, (int) Status);
+        exit(1);
+    }
+}
+
+
+/* Sets the time at the tone up for a run, latching the local clock as Timebase says */
+static void TIME_PerfReset(boolean Timebase)
+{
+    if (Timebase)
+    {
+        CFE_TIME_InitLatch(CFE_PSP_GetTimerTicksPerSecond(), CFE_PSP_GetTimerLow32Rollover());
+    }
+    else
+    {
+        CFE_TIME_InitLatch(0, 0);
+    }
+
+    CFE_TIME_TaskData.AtToneMET.Seconds = 1000000;
+    CFE_TIME_TaskData.AtToneMET.Subseconds = 0;
+    CFE_TIME_TaskData.AtToneSTCF.Seconds = 100000;
+    CFE_TIME_TaskData.AtToneSTCF.Subseconds = 0;
+    CFE_TIME_TaskData.AtToneLeaps = 37;
+    CFE_TIME_TaskData.AtToneLatch = CFE_TIME_LatchClock();
+}
+
+
+/* Reads the time with Readers tasks, updating it meanwhile if Writer */
+static uint32 TIME_PerfRun(boolean Timebase, boolean UseSequence, uint32 Readers, boolean Writer)
+{
+    char   Name[OS_MAX_API_NAME];
+    uint32 Reads = 0;
+    uint32 Jumps = 0;
+    uint32 i;
+    double Start;
+    double Elapsed;
+
+    TIME_PerfReset(Timebase);
+
+    TIME_Perf.UseSequence = UseSequence;
+    TIME_Perf.Seconds = TIME_PerfMeasure;
+    TIME_Perf.Next = 0;
+    TIME_Perf.Updates = 0;
+    TIME_Perf.Reading = Readers;
+
+    Start = Perf_Now();
+
+    for (i = 0; i < Readers; i++)
+    {
+        snprintf(Name, sizeof(Name), "TIME_PERF_%u", (unsigned int) i);
+        TIME_PerfStartTask(Name, TIME_PerfReaderTask);
+    }
+
+    if (Writer)
+    {
+        TIME_PerfStartTask("TIME_PERF_WR", TIME_PerfWriterTask);
+    }
+
+    Perf_WaitTasks(&TIME_Perf.Running);
+    Elapsed = Perf_Now() - Start;
+
+    for (i = 0; i < Readers; i++)
+    {
+        Reads += TIME_Perf.Reads[i];
+        Jumps += TIME_Perf.Jumps[i];
+    }
+
+    printf("%-9s %-8s %7u %10u %10.1f %10u\n", UseSequence ? "sequence" : "version",
+           Timebase ? "timebase" : "time", (unsigned int) Readers, (unsigned int) TIME_Perf.Updates,
+           Elapsed * 1e9 / Reads, (unsigned int) Jumps);
+
+    return Jumps;
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32 Readers;
+    uint32 Jumps = 0;
+
+    if (argc > 1)
+    {
+        TIME_PerfMeasure = strtod(argv[1], NULL);
+    }
+
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        fprintf(stderr, "OS_API_Init failed\n");
+        return 1;
+    }
+
+    OS_MutSemCreate(&CFE_TIME_TaskData.ReferenceMutex, "TIME_PERF_REF", 0);
+
+    CFE_TIME_TaskData.MaxLocalClock.Seconds = CFE_TIME_MAX_LOCAL_SECS;
+    CFE_TIME_TaskData.MaxLocalClock.Subseconds = CFE_TIME_MAX_LOCAL_SUBS;
+    CFE_TIME_TaskData.ClockSetState = CFE_TIME_WAS_SET;
+    CFE_TIME_TaskData.ClockFlyState = CFE_TIME_NO_FLY;
+    CFE_TIME_TaskData.DelayDirection = CFE_TIME_ADD_ADJUST;
+
+    printf("TIME read, %u s moved between MET and STCF at the tone by each update\n",
+           (unsigned int) TIME_PERF_STEP);
+    printf("reference latch    readers    updates    ns/read      jumps\n");
+
+    TIME_PerfRun(FALSE, TRUE, 1, FALSE);
+    TIME_PerfRun(TRUE, TRUE, 1, FALSE);
+
+    for (Readers = 1; Readers <= TIME_PERF_MAX_TASKS; Readers *= 2)
+    {
+        TIME_PerfRun(TRUE, FALSE, Readers, TRUE);
+        Jumps += TIME_PerfRun(TRUE, TRUE, Readers, TRUE);
+    }
+
+    printf("%u torn reads through CFE_TIME_GetTime, %u events, %u system log messages\n",
+           (unsigned int) Jumps, (unsigned int) Perf_EventCount, (unsigned int) Perf_SysLogCount);
+
+    return (Jumps == 0) ? 0 : 1;
+}
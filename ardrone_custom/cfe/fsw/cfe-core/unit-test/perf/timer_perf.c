@@ -0,0 +1,269 @@
+/*
+** File:
+**   timer_perf.c
+**
+** Purpose:
+**   OSAL timer jitter bench.  Runs periodic OSAL timers and reports how
+**   late each callback is past the deadline it was due at, for
+**
+**   - 1 timer at 100 Hz and at 1 kHz, with the processor idle
+**   - the same with a task spinning meanwhile, that the timers have to
+**     preempt
+**   - TIMER_PERF_MANY timers at 100 Hz, as many as OS_MAX_TIMERS allows
+**
+**   The deadlines of a timer are those of its period from when it was set,
+**   so a timer that drifts gets later and later.  A deadline a callback was
+**   more than a period late for counts as missed.
+**
+** Notes:
+**   Built twice on the OSAL timers (ostimer.c):
+**
+**   - timer_perf, the timer thread (OSAL_THREAD_TIMERS)
+**   - timer_perf_sig, a signal per timer (OSAL_POSIX_SIGNAL_TIMERS)
+**
+**   OSAL tasks block all signals, so the main thread waits out a run with
+**   signals unblocked, as the cFE main thread does in OS_IdleLoop, to take
+**   the timer signals.
+**
+**   Usage: timer_perf [seconds per run]
+*/
+
+/*
+** Includes
+*/
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <signal.h>
+
+#include "cfe.h"
+#include "perf_stubs.h"
+
+/*
+** Defines
+*/
+#define TIMER_PERF_MAX_SAMPLES  65536
+#define TIMER_PERF_STACK_SIZE   16384
+#define TIMER_PERF_PRIORITY     100
+
+#if (OS_MAX_TIMERS >= 200)
+#define TIMER_PERF_MANY         200
+#else
+#define TIMER_PERF_MANY         OS_MAX_TIMERS
+#endif
+
+#ifdef OSAL_THREAD_TIMERS
+#define TIMER_PERF_BACKEND      "timer thread"
+#else
+#define TIMER_PERF_BACKEND      "signal per timer"
+#endif
+
+/*
+** Bench state, shared with the callbacks and the spinning task
+*/
+typedef struct
+{
+    uint64           Start[OS_MAX_TIMERS];      /* ns the timer was set at */
+    uint64           Period;                    /* ns */
+    uint32           Callbacks[OS_MAX_TIMERS];
+    uint32           Late[TIMER_PERF_MAX_SAMPLES];
+    uint32           Samples;
+    volatile uint32  Spinning;
+    volatile uint32  Running;
+} TIMER_Perf_t;
+
+static TIMER_Perf_t TIMER_Perf;
+static double       TIMER_PerfMeasure = 1.0;
+
+
+/* CLOCK_MONOTONIC in nanoseconds, safe in a signal handler */
+static uint64 TIMER_PerfNow(void)
+{
+    struct timespec Now;
+
+    clock_gettime(CLOCK_MONOTONIC, &Now);
+
+    return ((uint64) Now.tv_sec * 1000000000) + Now.tv_nsec;
+}
+
+
+/* Records how late the callback is past the last deadline of its timer */
+static void TIMER_PerfCallback(uint32 TimerId)
+{
+    uint64 Since = TIMER_PerfNow() - TIMER_Perf.Start[TimerId];
+    uint32 Sample;
+
+    __atomic_add_fetch(&TIMER_Perf.Callbacks[TimerId], 1, __ATOMIC_RELAXED);
+
+    Sample = __atomic_fetch_add(&TIMER_Perf.Samples, 1, __ATOMIC_RELAXED);
+    if (Sample < TIMER_PERF_MAX_SAMPLES)
+    {
+        TIMER_Perf.Late[Sample] = (uint32) (Since % TIMER_Perf.Period);
+    }
+}
+
+
+/* Keeps the processor busy until the run is over */
+static void TIMER_PerfSpinTask(void)
+{
+    OS_TaskRegister();
+    __atomic_store_n(&TIMER_Perf.Spinning, 2, __ATOMIC_RELEASE);
+
+    while (TIMER_Perf.Spinning == 2)
+    {
+        ;
+    }
+
+    Perf_TaskDone(&TIMER_Perf.Running);
+}
+
+
+static int TIMER_PerfCompare(const void *a, const void *b)
+{
+    uint32 x = *(const uint32 *) a;
+    uint32 y = *(const uint32 *) b;
+
+    return (x > y) - (x < y);
+}
+
+
+/*
+** Runs NumTimers timers of the given period for TIMER_PerfMeasure seconds,
+** with a task spinning meanwhile if Spin, and prints the lateness of the
+** callbacks in microseconds.  Returns the number of failures.
+*/
+static uint32 TIMER_PerfRun(uint32 Hz, uint32 NumTimers, boolean Spin)
+{
+    uint32   TimerId[OS_MAX_TIMERS];
+    uint32   Accuracy;
+    char     Name[OS_MAX_API_NAME];
+    uint32   TaskId;
+    uint32   Callbacks = 0;
+    uint32   Expected = 0;
+    uint32   Samples;
+    uint64   Elapsed;
+    uint64   End;
+    double   Sum = 0;
+    int32    Status;
+    uint32   i;
+    sigset_t Mask;
+    sigset_t Previous;
+
+    memset(&TIMER_Perf, 0, sizeof(TIMER_Perf));
+    TIMER_Perf.Period = 1000000000 / Hz;
+
+    if (Spin)
+    {
+        TIMER_Perf.Spinning = 1;
+        TIMER_Perf.Running = 1;
+        Status = OS_TaskCreate(&TaskId, "TIMER_PERF_SPIN", TIMER_PerfSpinTask, NULL,
+                               TIMER_PERF_STACK_SIZE, TIMER_PERF_PRIORITY, 0);
+        if (Status != OS_SUCCESS)
+        {
+            fprintf(stderr, "cannot create task TIMER_PERF_SPIN, error %d\n", (int) Status);
+            exit(1);
+        }
+        while (__atomic_load_n(&TIMER_Perf.Spinning, __ATOMIC_ACQUIRE) != 2)
+        {
+            OS_TaskDelay(1);
+        }
+    }
+
+    for (i = 0; i < NumTimers; i++)
+    {
+        snprintf(Name, sizeof(Name), "TIMER_PERF_%u", (unsigned int) i);
+        Status = OS_TimerCreate(&TimerId[i], Name, &Accuracy, TIMER_PerfCallback);
+        if (Status != OS_SUCCESS)
+        {
+            fprintf(stderr, "cannot create timer %s, error %d\n", Name, (int) Status);
+            exit(1);
+        }
+    }
+
+    for (i = 0; i < NumTimers; i++)
+    {
+        TIMER_Perf.Start[TimerId[i]] = TIMER_PerfNow();
+        OS_TimerSet(TimerId[i], 1000000 / Hz, 1000000 / Hz);
+    }
+
+    sigemptyset(&Mask);
+    pthread_sigmask(SIG_SETMASK, &Mask, &Previous);
+
+    End = TIMER_PerfNow() + (uint64) (TIMER_PerfMeasure * 1e9);
+    while (TIMER_PerfNow() < End)
+    {
+        OS_TaskDelay(10);
+    }
+
+    pthread_sigmask(SIG_SETMASK, &Previous, NULL);
+
+    for (i = 0; i < NumTimers; i++)
+    {
+        Elapsed = TIMER_PerfNow() - TIMER_Perf.Start[TimerId[i]];
+        OS_TimerDelete(TimerId[i]);
+        Expected += Elapsed / TIMER_Perf.Period;
+        Callbacks += __atomic_load_n(&TIMER_Perf.Callbacks[TimerId[i]], __ATOMIC_RELAXED);
+    }
+
+    if (Spin)
+    {
+        TIMER_Perf.Spinning = 0;
+        Perf_WaitTasks(&TIMER_Perf.Running);
+    }
+
+    Samples = TIMER_Perf.Samples;
+    if (Samples > TIMER_PERF_MAX_SAMPLES)
+    {
+        Samples = TIMER_PERF_MAX_SAMPLES;
+    }
+    if (Samples == 0)
+    {
+        fprintf(stderr, "no callbacks from %u timers at %u Hz\n", (unsigned int) NumTimers,
+                (unsigned int) Hz);
+        return 1;
+    }
+
+    qsort(TIMER_Perf.Late, Samples, sizeof(TIMER_Perf.Late[0]), TIMER_PerfCompare);
+    for (i = 0; i < Samples; i++)
+    {
+        Sum += TIMER_Perf.Late[i];
+    }
+
+    printf("%5u %6u %-4s %9u %7u %9.1f %9.1f %9.1f %9.1f\n", (unsigned int) Hz,
+           (unsigned int) NumTimers, Spin ? "spin" : "idle", (unsigned int) Callbacks,
+           (unsigned int) ((Expected > Callbacks) ? Expected - Callbacks : 0),
+           Sum / Samples / 1000, TIMER_Perf.Late[Samples / 2] / 1000.0,
+           TIMER_Perf.Late[(Samples * 99) / 100] / 1000.0, TIMER_Perf.Late[Samples - 1] / 1000.0);
+
+    return 0;
+}
+
+
+int main(int argc, char *argv[])
+{
+    uint32 Failures = 0;
+
+    if (argc > 1)
+    {
+        TIMER_PerfMeasure = strtod(argv[1], NULL);
+    }
+
+    if (OS_API_Init() != OS_SUCCESS)
+    {
+        fprintf(stderr, "OS_API_Init failed\n");
+        return 1;
+    }
+
+    printf("OSAL timer lateness, %s, OS_MAX_TIMERS %u, microseconds past the deadline\n",
+           TIMER_PERF_BACKEND, (unsigned int) OS_MAX_TIMERS);
+    printf("   Hz timers load callbacks  missed      mean    median       p99       max\n");
+
+    Failures += TIMER_PerfRun(100, 1, FALSE);
+    Failures += TIMER_PerfRun(100, 1, TRUE);
+    Failures += TIMER_PerfRun(1000, 1, FALSE);
+    Failures += TIMER_PerfRun(1000, 1, TRUE);
+    Failures += TIMER_PerfRun(100, TIMER_PERF_MANY, FALSE);
+
+    return (Failures == 0) ? 0 : 1;
+}
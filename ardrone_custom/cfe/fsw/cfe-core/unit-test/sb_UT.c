@@ -2638,6 +2638,7 @@ void Test_CreatePipe_API(void)
     Test_CreatePipe_NullPtr();
     Test_CreatePipe_ValPipeDepth();
     Test_CreatePipe_InvalPipeDepth();
+    Test_CreatePipe_QueueType();
     Test_CreatePipe_MaxPipes();
 
 #ifdef UT_VERBOSE
@@ -2830,6 +2831,72 @@ void Test_CreatePipe_InvalPipeDepth(void)
               "Invalid pipe depth test");
 } /* end Test_CreatePipe_InvalPipeDepth */
 
+/*
+** Test create pipe response to valid and invalid queue types
+*/
+void Test_CreatePipe_QueueType(void)
+{
+    CFE_SB_PipeId_t PipeIdReturned[3];
+    int32           Rtn[3];
+    int32           ExpRtn;
+    int32           ActRtn;
+    int32           TestStat = CFE_PASS;
+
+#ifdef UT_VERBOSE
+    UT_Text("Begin Test for Pipe Queue Type");
+#endif
+
+    SB_ResetUnitTest();
+    Rtn[0] = CFE_SB_CreatePipeEx(&PipeIdReturned[0], 4, "TestPipeOs",
+                                 CFE_SB_PIPE_QUEUE_OS);
+    Rtn[1] = CFE_SB_CreatePipeEx(&PipeIdReturned[1], 4, "TestPipeRing",
+                                 CFE_SB_PIPE_QUEUE_RING);
+    UT_SetRtnCode(&QueueCreateRtn, OS_SUCCESS, 1); /* Avoid creating socket */
+    Rtn[2] = CFE_SB_CreatePipeEx(&PipeIdReturned[2], 4, "TestPipeBadQueue", 2);
+
+    if (Rtn[0] != CFE_SUCCESS ||
+        Rtn[1] != CFE_SUCCESS ||
+        Rtn[2] != CFE_SB_BAD_ARGUMENT)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected return in pipe queue type test\n "
+                   "Os, Rtn1=0x%lx, act=0x%lx\n "
+                   "Ring, Rtn2=0x%lx, act=0x%lx\n "
+                   "Val=2, Rtn3=0x%lx, Expected Rtn3=0x%lx",
+                 (unsigned long) Rtn[0], (unsigned long) CFE_SUCCESS,
+                 (unsigned long) Rtn[1], (unsigned long) CFE_SUCCESS,
+                 (unsigned long) Rtn[2], (unsigned long) CFE_SB_BAD_ARGUMENT);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    ExpRtn = 3;
+    ActRtn = UT_GetNumEventsSent();
+
+    if (ActRtn != ExpRtn)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected rtn from UT_GetNumEventsSent, exp=%ld, act=%ld",
+                 (long) ExpRtn, (long) ActRtn);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    if (UT_EventIsInHistory(CFE_SB_PIPE_ADDED_EID) == FALSE ||
+        UT_EventIsInHistory(CFE_SB_CR_PIPE_BAD_ARG_EID) == FALSE)
+    {
+        UT_Text("CFE_SB_PIPE_ADDED_EID or CFE_SB_CR_PIPE_BAD_ARG_EID not sent");
+        TestStat = CFE_FAIL;
+    }
+
+    CFE_SB_DeletePipe(PipeIdReturned[0]);
+    CFE_SB_DeletePipe(PipeIdReturned[1]);
+
+    UT_Report(__FILE__, __LINE__,
+              TestStat, "Test_CreatePipe_API",
+              "Pipe queue type test");
+} /* end Test_CreatePipe_QueueType */
+
 /*
 ** Test create pipe response to too many pipes
 */
@@ -5696,8 +5763,7 @@ void Test_SendMsg_ZeroCopyGetPtr(void)
     /* Increase the peak memory and buffers in use above the expected values in
      * order to exercise branch paths
      */
-    CFE_SB.StatTlmMsg.Payload.PeakMemInUse = (MsgSize +
-                                              sizeof(CFE_SB_BufferD_t)) * 5;
+    CFE_SB.StatTlmMsg.Payload.PeakMemInUse = CFE_SB_BUF_CLASS_BLOCK(0) * 5;
     CFE_SB.StatTlmMsg.Payload.PeakSBBuffersInUse =
       CFE_SB.StatTlmMsg.Payload.SBBuffersInUse + 2;
     ActRtn = (cpuaddr) CFE_SB_ZeroCopyGetPtr(MsgSize, &ZeroCpyBufHndl);
@@ -5713,7 +5779,7 @@ void Test_SendMsg_ZeroCopyGetPtr(void)
         TestStat = CFE_FAIL;
     }
 
-    ExpRtn = (MsgSize + sizeof(CFE_SB_BufferD_t)) * 5;
+    ExpRtn = CFE_SB_BUF_CLASS_BLOCK(0) * 5;
     ActRtn = CFE_SB.StatTlmMsg.Payload.PeakMemInUse;
 
     if (ActRtn != ExpRtn)
@@ -6498,10 +6564,13 @@ void Test_RcvMsg_API(void)
     Test_RcvMsg_GetLastSenderInvalidPipe();
     Test_RcvMsg_GetLastSenderInvalidCaller();
     Test_RcvMsg_GetLastSenderSuccess();
+    Test_RcvMsg_GetLastSenderCached();
     Test_RcvMsg_Timeout();
     Test_RcvMsg_PipeReadError();
     Test_RcvMsg_PendForever();
     Test_RcvMsg_InvalidBufferPtr();
+    Test_RcvMsgBatch_InvalidArgs();
+    Test_RcvMsgBatch_Partial();
 
 #ifdef UT_VERBOSE
     UT_Text("End Test_RcvMsg_API\n");
@@ -6891,6 +6960,99 @@ void Test_RcvMsg_GetLastSenderSuccess(void)
               "GetLastSenderId Success Test");
 } /* end Test_RcvMsg_GetLastSenderSuccess */
 
+/*
+** Test that the sender information is looked up once per task and points
+** to the same record for every message the task sends
+*/
+void Test_RcvMsg_GetLastSenderCached(void)
+{
+    CFE_SB_PipeId_t   PipeId;
+    CFE_SB_MsgId_t    MsgId = 0x0809;
+    SB_UT_Test_Tlm_t  TlmPkt;
+    CFE_SB_MsgPtr_t   TlmPktPtr = (CFE_SB_MsgPtr_t) &TlmPkt;
+    CFE_SB_MsgPtr_t   PtrToMsg;
+    CFE_SB_SenderId_t *GLSPtr;
+    char              FullName[(OS_MAX_API_NAME * 2)];
+    uint32            TskId = OS_TaskGetId();
+    uint32            Slot;
+    uint32            i;
+    int32             TestStat = CFE_PASS;
+
+#ifdef UT_VERBOSE
+    UT_Text("Begin Test for GetLastSender Cached");
+#endif
+
+    SB_ResetUnitTest();
+    CFE_SB.SenderReporting = 1;
+    CFE_SB_CreatePipe(&PipeId, 10, "RcvMsgTestPipe");
+    CFE_SB_Subscribe(MsgId, PipeId);
+    CFE_SB_InitMsg(&TlmPkt, MsgId, sizeof(SB_UT_Test_Tlm_t), TRUE);
+    CFE_SB_GetAppTskName(TskId, FullName);
+    FullName[OS_MAX_API_NAME - 1] = '\0';
+
+    for (i = 0; i < 2; i++)
+    {
+        CFE_SB_SendMsg(TlmPktPtr);
+        CFE_SB_RcvMsg(&PtrToMsg, PipeId, CFE_SB_PEND_FOREVER);
+        CFE_SB_GetLastSenderId(&GLSPtr, PipeId);
+
+        if (strcmp(GLSPtr->AppName, FullName) != 0)
+        {
+            snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                     "Unexpected sender info, send %lu, exp=%s, act=%s",
+                     (unsigned long) i, FullName, GLSPtr->AppName);
+            UT_Text(cMsg);
+            TestStat = CFE_FAIL;
+        }
+    }
+
+    /* Cleaning up the app forgets the record, sending fills it in again */
+    OS_ConvertToArrayIndex(TskId, &Slot);
+    Slot %= OS_MAX_TASKS;
+    CFE_SB.SenderRec[Slot].AppId = 0;
+    CFE_SB.SenderRec[Slot].Valid = TRUE;
+    CFE_SB_CleanUpApp(0);
+
+    if (CFE_SB.SenderRec[Slot].Valid != FALSE)
+    {
+        UT_Text("Sender info not forgotten at app clean up");
+        TestStat = CFE_FAIL;
+    }
+
+    /* A task reusing the id rewrites the record, the message received */
+    /* before still reports its own sender                              */
+    strncpy(CFE_SB.SenderRec[Slot].Sender.AppName, "REUSED.TASK", OS_MAX_API_NAME);
+
+    if (strcmp(GLSPtr->AppName, FullName) != 0)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Sender info changed by task id reuse, exp=%s, act=%s",
+                 FullName, GLSPtr->AppName);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    /* With sender reporting off no name is reported */
+    SB_ResetUnitTest();
+    CFE_SB.SenderReporting = 0;
+    CFE_SB_CreatePipe(&PipeId, 10, "RcvMsgTestPipe");
+    CFE_SB_Subscribe(MsgId, PipeId);
+    CFE_SB_SendMsg(TlmPktPtr);
+    CFE_SB_RcvMsg(&PtrToMsg, PipeId, CFE_SB_PEND_FOREVER);
+    CFE_SB_GetLastSenderId(&GLSPtr, PipeId);
+
+    if (GLSPtr->AppName[0] != '\0')
+    {
+        UT_Text("Unexpected sender info with sender reporting off");
+        TestStat = CFE_FAIL;
+    }
+
+    CFE_SB_DeletePipe(PipeId);
+    UT_Report(__FILE__, __LINE__,
+              TestStat, "Test_RcvMsg_API",
+              "GetLastSenderId cached sender test");
+} /* end Test_RcvMsg_GetLastSenderCached */
+
 /*
 ** Test receiving a message response to a timeout
 */
@@ -7216,6 +7378,168 @@ void Test_RcvMsg_InvalidBufferPtr(void)
               TestStat, "Test_RcvMsg_API", "Invalid buffer pointer test");
 } /* end Test_RcvMsg_InvalidBufferPtr */
 
+/*
+** Test batch receive response to a null count pointer and a zero count
+*/
+void Test_RcvMsgBatch_InvalidArgs(void)
+{
+    CFE_SB_MsgPtr_t PtrToMsg[4];
+    CFE_SB_PipeId_t PipeId;
+    uint32          Count = 1;
+    uint32          PipeDepth = 10;
+    int32           ExpRtn;
+    int32           ActRtn;
+    int32           TestStat = CFE_PASS;
+
+#ifdef UT_VERBOSE
+    UT_Text("Begin Test for Batch Rcv - Invalid Arguments");
+#endif
+
+    SB_ResetUnitTest();
+    CFE_SB_CreatePipe(&PipeId, PipeDepth, "RcvMsgTestPipe");
+    ExpRtn = CFE_SB_BAD_ARGUMENT;
+    ActRtn = CFE_SB_RcvMsgBatch(PtrToMsg, 4, NULL, PipeId, CFE_SB_POLL);
+
+    if (ActRtn != ExpRtn)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected return in batch null count test, "
+                   "exp=0x%lx, act=0x%lx",
+                 (unsigned long) ExpRtn, (unsigned long) ActRtn);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    ActRtn = CFE_SB_RcvMsgBatch(PtrToMsg, 0, &Count, PipeId, CFE_SB_POLL);
+
+    if (ActRtn != ExpRtn || Count != 0)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected return in batch zero max test, "
+                   "exp=0x%lx, act=0x%lx, count=%lu",
+                 (unsigned long) ExpRtn, (unsigned long) ActRtn,
+                 (unsigned long) Count);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    ExpRtn = 3;
+    ActRtn = UT_GetNumEventsSent();
+
+    if (ActRtn != ExpRtn)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected rtn from UT_GetNumEventsSent, exp=%ld, act=%ld",
+                 (long) ExpRtn, (long) ActRtn);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    if (UT_EventIsInHistory(CFE_SB_RCV_BATCH_BAD_ARG_EID) == FALSE)
+    {
+        UT_Text("CFE_SB_RCV_BATCH_BAD_ARG_EID not sent");
+        TestStat = CFE_FAIL;
+    }
+
+    CFE_SB_DeletePipe(PipeId);
+    UT_Report(__FILE__, __LINE__,
+              TestStat, "Test_RcvMsg_API", "Batch invalid arguments test");
+} /* end Test_RcvMsgBatch_InvalidArgs */
+
+/*
+** Test batch receive of more messages than one batch holds, and that each
+** batch is released by the next receive
+*/
+void Test_RcvMsgBatch_Partial(void)
+{
+    CFE_SB_MsgPtr_t  PtrToMsg[2];
+    CFE_SB_MsgId_t   MsgId = 0x0809;
+    CFE_SB_PipeId_t  PipeId;
+    SB_UT_Test_Tlm_t TlmPkt;
+    CFE_SB_MsgPtr_t  TlmPktPtr = (CFE_SB_MsgPtr_t) &TlmPkt;
+    uint32           Count;
+    uint32           PipeDepth = 10;
+    int32            ExpRtn;
+    int32            ActRtn;
+    int32            TestStat = CFE_PASS;
+
+#ifdef UT_VERBOSE
+    UT_Text("Begin Test for Batch Rcv - Partial");
+#endif
+
+    SB_ResetUnitTest();
+    CFE_SB_CreatePipe(&PipeId, PipeDepth, "RcvMsgTestPipe");
+    CFE_SB_InitMsg(&TlmPkt, MsgId, sizeof(SB_UT_Test_Tlm_t), TRUE);
+    CFE_SB_Subscribe(MsgId, PipeId);
+    CFE_SB_SendMsg(TlmPktPtr);
+    CFE_SB_SendMsg(TlmPktPtr);
+    CFE_SB_SendMsg(TlmPktPtr);
+
+    /* Two of the three, then the last one */
+    ExpRtn = CFE_SUCCESS;
+    ActRtn = CFE_SB_RcvMsgBatch(PtrToMsg, 2, &Count, PipeId, CFE_SB_POLL);
+
+    if (ActRtn != ExpRtn || Count != 2 ||
+        CFE_SB_GetMsgId(PtrToMsg[0]) != MsgId ||
+        CFE_SB_GetMsgId(PtrToMsg[1]) != MsgId)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected return from first batch, "
+                   "exp=0x%lx, act=0x%lx, count=%lu",
+                 (unsigned long) ExpRtn, (unsigned long) ActRtn,
+                 (unsigned long) Count);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    ActRtn = CFE_SB_RcvMsgBatch(PtrToMsg, 2, &Count, PipeId, CFE_SB_POLL);
+
+    if (ActRtn != ExpRtn || Count != 1 ||
+        CFE_SB.StatTlmMsg.Payload.SBBuffersInUse != 1)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected return from second batch, "
+                   "exp=0x%lx, act=0x%lx, count=%lu, buffers=%lu",
+                 (unsigned long) ExpRtn, (unsigned long) ActRtn,
+                 (unsigned long) Count,
+                 (unsigned long) CFE_SB.StatTlmMsg.Payload.SBBuffersInUse);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    ExpRtn = CFE_SB_NO_MESSAGE;
+    ActRtn = CFE_SB_RcvMsgBatch(PtrToMsg, 2, &Count, PipeId, CFE_SB_POLL);
+
+    if (ActRtn != ExpRtn || Count != 0 ||
+        CFE_SB.StatTlmMsg.Payload.SBBuffersInUse != 0)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected return from empty batch, "
+                   "exp=0x%lx, act=0x%lx, count=%lu, buffers=%lu",
+                 (unsigned long) ExpRtn, (unsigned long) ActRtn,
+                 (unsigned long) Count,
+                 (unsigned long) CFE_SB.StatTlmMsg.Payload.SBBuffersInUse);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    ExpRtn = 2;
+    ActRtn = UT_GetNumEventsSent();
+
+    if (ActRtn != ExpRtn)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected rtn from UT_GetNumEventsSent, exp=%ld, act=%ld",
+                 (long) ExpRtn, (long) ActRtn);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    CFE_SB_DeletePipe(PipeId);
+    UT_Report(__FILE__, __LINE__,
+              TestStat, "Test_RcvMsg_API", "Batch partial receive test");
+} /* end Test_RcvMsgBatch_Partial */
+
 /*
 ** Test SB Utility APIs
 */
@@ -8493,6 +8817,7 @@ void Test_SB_SpecialCases(void)
     Test_PutDestBlk_ErrLogic();
     Test_CFE_SB_GetPipeIdx();
     Test_CFE_SB_Buffers();
+    Test_CFE_SB_BufCache();
     Test_CFE_SB_BadPipeInfo();
     Test_SB_SendMsgPaths();
     Test_RcvMsg_UnsubResubPath();
@@ -8762,7 +9087,7 @@ void Test_CFE_SB_GetPipeIdx(void)
 */
 void Test_CFE_SB_Buffers(void)
 {
-    int32 ExpRtn = sizeof(CFE_SB_BufferD_t) * 4;
+    int32 ExpRtn = CFE_SB_BUF_CLASS_BLOCK(0) * 4;
     int32 ActRtn;
     int32 TestStat = CFE_PASS;
     CFE_SB_BufferD_t *bd;
@@ -8805,6 +9130,9 @@ void Test_CFE_SB_Buffers(void)
     TestStat = CFE_PASS;
     ExpRtn = CFE_SB.StatTlmMsg.Payload.SBBuffersInUse;
     UT_SetRtnCode(&PutPoolRtn, -1, 1);
+
+    /* Only a buffer outside the buffer cache goes back to the pool */
+    bd->SizeClass = 0;
     CFE_SB_ReturnBufferToPool(bd);
     ActRtn = CFE_SB.StatTlmMsg.Payload.SBBuffersInUse;
 
@@ -8897,6 +9225,135 @@ void Test_CFE_SB_Buffers(void)
               "PutDestinationBlk branch path coverage test");
 } /* end Test_CFE_SB_Buffers */
 
+/*
+** Test reuse of SB message buffers through the buffer cache
+*/
+void Test_CFE_SB_BufCache(void)
+{
+    int32 ExpRtn;
+    int32 ActRtn;
+    int32 TestStat = CFE_PASS;
+    uint32 i;
+    CFE_SB_BufferD_t *bd;
+    CFE_SB_BufferD_t *bd2;
+    CFE_SB_BufferD_t *Spill[CFE_SB_BUF_MAG_SIZE + 1];
+
+#ifdef UT_VERBOSE
+    UT_Text("Begin Test Buffer Cache");
+#endif
+
+    SB_ResetUnitTest();
+    bd = CFE_SB_GetBufferFromPool(0, 10);
+    CFE_SB_ReturnBufferToPool(bd);
+    bd2 = CFE_SB_GetBufferFromPool(0, 10);
+
+    if (bd2 != bd || bd->SizeClass != 1 ||
+        ((cpuaddr) bd & (CFE_SB_CACHE_LINE_SIZE - 1)) != 0)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected cached buffer, exp=%p, act=%p, class=%u",
+                 (void *) bd, (void *) bd2, (unsigned int) bd2->SizeClass);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    CFE_SB_ReturnBufferToPool(bd2);
+    CFE_SB_GetBufCacheStats();
+
+    if (CFE_SB.StatTlmMsg.Payload.BufCacheHits != 1 ||
+        CFE_SB.StatTlmMsg.Payload.BufCacheMisses != 1 ||
+        CFE_SB.StatTlmMsg.Payload.BufCacheInUse != 1 ||
+        CFE_SB.StatTlmMsg.Payload.PeakBufCacheInUse != 1 ||
+        CFE_SB.StatTlmMsg.Payload.SBBuffersInUse != 0)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected cache stats, hits=%lu, misses=%lu, held=%lu, "
+                   "peak=%lu, in use=%lu",
+                 (unsigned long) CFE_SB.StatTlmMsg.Payload.BufCacheHits,
+                 (unsigned long) CFE_SB.StatTlmMsg.Payload.BufCacheMisses,
+                 (unsigned long) CFE_SB.StatTlmMsg.Payload.BufCacheInUse,
+                 (unsigned long) CFE_SB.StatTlmMsg.Payload.PeakBufCacheInUse,
+                 (unsigned long) CFE_SB.StatTlmMsg.Payload.SBBuffersInUse);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    /* A buffer too big for every size class is not cached */
+    bd = CFE_SB_GetBufferFromPool(0,
+           CFE_SB_BUF_CLASS_SIZE(CFE_SB_BUF_CLASSES - 1));
+
+    if (bd == NULL || bd->SizeClass != 0)
+    {
+        UT_Text("Unexpected size class for an uncached buffer");
+        TestStat = CFE_FAIL;
+    }
+    else
+    {
+        CFE_SB_ReturnBufferToPool(bd);
+    }
+
+    UT_Report(__FILE__, __LINE__,
+              TestStat, "CFE_SB_GetBufferFromPool",
+              "Buffer cache reuse test");
+
+    /* Overflowing the magazine moves half of it to the depot, and the
+     * depot is drained back into the pool when the pool runs short
+     */
+    TestStat = CFE_PASS;
+    SB_ResetUnitTest();
+
+    for (i = 0; i <= CFE_SB_BUF_MAG_SIZE; i++)
+    {
+        Spill[i] = CFE_SB_GetBufferFromPool(0, 10);
+    }
+
+    for (i = 0; i <= CFE_SB_BUF_MAG_SIZE; i++)
+    {
+        CFE_SB_ReturnBufferToPool(Spill[i]);
+    }
+
+    ExpRtn = CFE_SB_BUF_MAG_SIZE / 2;
+    ActRtn = CFE_SB.BufDepot[0].Tail - CFE_SB.BufDepot[0].Head;
+
+    if (ActRtn != ExpRtn)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected depot count, exp=%ld, act=%ld",
+                 (long) ExpRtn, (long) ActRtn);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    ExpRtn = CFE_SB_BUF_MAG_SIZE + 1;
+    ActRtn = CFE_SB_ReclaimBufCache();
+
+    if (ActRtn != ExpRtn)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected reclaim count, exp=%ld, act=%ld",
+                 (long) ExpRtn, (long) ActRtn);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    ExpRtn = 0;
+    CFE_SB_GetBufCacheStats();
+    ActRtn = CFE_SB.StatTlmMsg.Payload.BufCacheInUse;
+
+    if (ActRtn != ExpRtn)
+    {
+        snprintf(cMsg, UT_MAX_MESSAGE_LENGTH,
+                 "Unexpected BufCacheInUse value, exp=%ld, act=%ld",
+                 (long) ExpRtn, (long) ActRtn);
+        UT_Text(cMsg);
+        TestStat = CFE_FAIL;
+    }
+
+    UT_Report(__FILE__, __LINE__,
+              TestStat, "CFE_SB_ReclaimBufCache",
+              "Buffer cache spill and reclaim test");
+} /* end Test_CFE_SB_BufCache */
+
 /*
 ** Test internal function to get the pipe table index for the given pipe ID
 */
@@ -1240,7 +1240,8 @@ void Test_SB_APIs(void);
 **        This function does not return a value.
 **
 ** \sa #UT_Text, #Test_CreatePipe_NullPtr, #Test_CreatePipe_ValPipeDepth,
-** \sa #Test_CreatePipe_InvalPipeDepth, #Test_CreatePipe_EmptyPipeName,
+** \sa #Test_CreatePipe_InvalPipeDepth, #Test_CreatePipe_QueueType,
+** \sa #Test_CreatePipe_EmptyPipeName,
 ** \sa #Test_CreatePipe_LongPipeName, #Test_CreatePipe_SamePipeName,
 ** \sa #Test_CreatePipe_MaxPipes
 **
@@ -1305,6 +1306,26 @@ void Test_CreatePipe_ValPipeDepth(void);
 ******************************************************************************/
 void Test_CreatePipe_InvalPipeDepth(void);
 
+/*****************************************************************************/
+/**
+** \brief Test create pipe response to valid and invalid queue types
+**
+** \par Description
+**        This function tests the create pipe response to each queue type
+**        and to one that does not exist.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        This function does not return a value.
+**
+** \sa #UT_Text, #SB_ResetUnitTest, #UT_SetRtnCode, #CFE_SB_CreatePipeEx,
+** \sa #UT_GetNumEventsSent, #UT_EventIsInHistory, #UT_Report
+**
+******************************************************************************/
+void Test_CreatePipe_QueueType(void);
+
 /*****************************************************************************/
 /**
 ** \brief Test create pipe response to an empty pipe name
@@ -2630,6 +2651,28 @@ void Test_RcvMsg_GetLastSenderInvalidCaller(void);
 ******************************************************************************/
 void Test_RcvMsg_GetLastSenderSuccess(void);
 
+/*****************************************************************************/
+/**
+** \brief Test that the sender information is cached per task
+**
+** \par Description
+**        This function tests that every message a task sends points to the
+**        same sender record, that app clean up forgets the record and that
+**        no name is reported with sender reporting off.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        This function does not return a value.
+**
+** \sa #UT_Text, #SB_ResetUnitTest, #CFE_SB_CreatePipe, #CFE_SB_Subscribe,
+** \sa #CFE_SB_SendMsg, #CFE_SB_RcvMsg, #CFE_SB_GetLastSenderId,
+** \sa #CFE_SB_CleanUpApp, #CFE_SB_DeletePipe, #UT_Report
+**
+******************************************************************************/
+void Test_RcvMsg_GetLastSenderCached(void);
+
 /*****************************************************************************/
 /**
 ** \brief Test receiving a message response to a timeout
@@ -2714,6 +2757,49 @@ void Test_RcvMsg_PendForever(void);
 ******************************************************************************/
 void Test_RcvMsg_InvalidBufferPtr(void);
 
+/*****************************************************************************/
+/**
+** \brief Test batch receive response to invalid arguments
+**
+** \par Description
+**        This function tests the batch receive response to a null count
+**        pointer and to a maximum count of zero.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        This function does not return a value.
+**
+** \sa #UT_Text, #SB_ResetUnitTest, #CFE_SB_CreatePipe, #CFE_SB_RcvMsgBatch,
+** \sa #UT_GetNumEventsSent, #UT_EventIsInHistory, #CFE_SB_DeletePipe,
+** \sa #UT_Report
+**
+******************************************************************************/
+void Test_RcvMsgBatch_InvalidArgs(void);
+
+/*****************************************************************************/
+/**
+** \brief Test batch receive of more messages than fit in one batch
+**
+** \par Description
+**        This function tests that a batch receive returns no more than the
+**        maximum count, that the rest are returned by the next call, and
+**        that the buffers of each batch are released by the next receive.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        This function does not return a value.
+**
+** \sa #UT_Text, #SB_ResetUnitTest, #CFE_SB_CreatePipe, #CFE_SB_InitMsg,
+** \sa #CFE_SB_Subscribe, #CFE_SB_SendMsg, #CFE_SB_RcvMsgBatch,
+** \sa #UT_GetNumEventsSent, #CFE_SB_DeletePipe, #UT_Report
+**
+******************************************************************************/
+void Test_RcvMsgBatch_Partial(void);
+
 /*****************************************************************************/
 /**
 ** \brief Test releasing zero copy buffers for all pipes owned by a
@@ -3135,6 +3221,28 @@ void Test_CFE_SB_GetPipeIdx(void);
 ******************************************************************************/
 void Test_CFE_SB_Buffers(void);
 
+/*****************************************************************************/
+/**
+** \brief Test the SB buffer cache
+**
+** \par Description
+**        This function tests that freed buffers are reused from the buffer
+**        cache, that a full magazine spills into the depot and that the
+**        cache can be reclaimed into the pool.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        This function does not return a value.
+**
+** \sa #UT_Text, #SB_ResetUnitTest, #CFE_SB_GetBufferFromPool,
+** \sa #CFE_SB_ReturnBufferToPool, #CFE_SB_GetBufCacheStats,
+** \sa #CFE_SB_ReclaimBufCache, #UT_Report
+**
+******************************************************************************/
+void Test_CFE_SB_BufCache(void);
+
 /*****************************************************************************/
 /**
 ** \brief Test functions that involve bad pipe information
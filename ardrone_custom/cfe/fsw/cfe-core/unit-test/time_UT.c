@@ -85,6 +85,7 @@ extern UT_SetRtn_t SB_SubscribeRtn;
 extern UT_SetRtn_t SB_SubscribeLocalRtn;
 extern UT_SetRtn_t SB_CreatePipeRtn;
 extern UT_SetRtn_t OS_BinSemCreateRtn;
+extern UT_SetRtn_t MutSemCreateRtn;
 extern UT_SetRtn_t EVS_SendEventRtn;
 extern UT_SetRtn_t EVS_RegisterRtn;
 extern UT_SetRtn_t SendMsgEventIDRtn;
@@ -210,6 +211,14 @@ void Test_Init(void)
               "CFE_TIME_EarlyInit",
               "Successful");
 
+    /* Test response to a failure creating the reference mutex */
+    UT_InitData();
+    UT_SetRtnCode(&MutSemCreateRtn, OS_ERROR, 1);
+    UT_Report(__FILE__, __LINE__,
+              CFE_TIME_EarlyInit() == OS_ERROR,
+              "CFE_TIME_EarlyInit",
+              "Reference mutex create failure");
+
     /* Test successful time task initialization */
     UT_InitData();
     UT_Report(__FILE__, __LINE__,
@@ -2559,6 +2568,58 @@ void Test_GetReference(void)
               Reference.CurrentMET.Subseconds == 0,
               "CFE_TIME_GetReference",
               "Local clock > latch at tone time");
+
+    /* Test reading reference data while it is being changed */
+    UT_InitData();
+    CFE_TIME_TaskData.AtToneMET.Seconds = 20;
+    CFE_TIME_TaskData.AtToneMET.Subseconds = 0;
+    CFE_TIME_TaskData.AtToneLatch.Seconds = 10;
+    CFE_TIME_TaskData.AtToneLatch.Subseconds = 0;
+    CFE_TIME_BeginReferenceUpdate();
+    CFE_TIME_TaskData.AtToneMET.Seconds = 40;
+    UT_SetBSP_Time(15, 0);
+    CFE_TIME_GetReference(&Reference);
+    UT_Report(__FILE__, __LINE__,
+              Reference.CurrentMET.Seconds == 25 &&
+              Reference.AtToneMET.Seconds == 20 &&
+              (CFE_TIME_TaskData.ReferenceSequence & 1) == 1,
+              "CFE_TIME_GetReference",
+              "Reference data being changed");
+
+    /* Test reading reference data once the change is done */
+    UT_InitData();
+    CFE_TIME_EndReferenceUpdate();
+    CFE_TIME_GetReference(&Reference);
+    UT_Report(__FILE__, __LINE__,
+              Reference.CurrentMET.Seconds == 45 &&
+              Reference.AtToneMET.Seconds == 40 &&
+              (CFE_TIME_TaskData.ReferenceSequence & 1) == 0,
+              "CFE_TIME_GetReference",
+              "Reference data changed");
+
+    /* Test latching the local clock from a seconds : ticks timebase */
+    UT_InitData();
+    CFE_TIME_InitLatch(1000000, 1000000);
+    UT_SetBSP_Time(15, 250000);
+    CFE_TIME_GetReference(&Reference);
+    UT_Report(__FILE__, __LINE__,
+              Reference.CurrentLatch.Seconds == 15 &&
+              Reference.CurrentLatch.Subseconds == 0x40000000 &&
+              Reference.CurrentMET.Seconds == 45 &&
+              Reference.CurrentMET.Subseconds == 0x40000000,
+              "CFE_TIME_GetReference",
+              "Local clock latched from timebase");
+
+    /* Test latching the local clock from the time, timebase not in seconds */
+    UT_InitData();
+    CFE_TIME_InitLatch(1000000, 0);
+    UT_Report(__FILE__, __LINE__,
+              CFE_TIME_TaskData.LatchScale == 0 &&
+              CFE_TIME_TaskData.LatchFraction == 0 &&
+              CFE_TIME_LatchClock().Subseconds ==
+                  CFE_TIME_Micro2SubSecs(250000),
+              "CFE_TIME_InitLatch",
+              "Timebase not in seconds : ticks");
 }
 
 /*
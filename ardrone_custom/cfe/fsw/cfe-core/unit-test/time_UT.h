@@ -396,7 +396,9 @@ void Test_State(void);
 **        This function does not return a value.
 **
 ** \sa #UT_Text, #UT_InitData, #UT_SetBSP_Time, #CFE_TIME_GetReference,
-** \sa #UT_Report
+** \sa #UT_Report, #CFE_TIME_BeginReferenceUpdate,
+** \sa #CFE_TIME_EndReferenceUpdate, #CFE_TIME_InitLatch,
+** \sa #CFE_TIME_LatchClock
 **
 ******************************************************************************/
 void Test_GetReference(void);
@@ -528,7 +528,8 @@ void CFE_PSP_Restart(uint32 reset_type)
 **
 ** \par Description
 **        This function is used as a placeholder for the PSP function
-**        CFE_PSP_Get_Timebase.
+**        CFE_PSP_Get_Timebase.  The timebase is the user-defined values in
+**        BSP_Time, seconds and microseconds.
 **
 ** \par Assumptions, External Events, and Notes:
 **        None
@@ -542,6 +543,8 @@ void CFE_PSP_Get_Timebase(uint32 *Tbu, uint32* Tbl)
 #ifdef UT_VERBOSE
     UT_Text("  CFE_PSP_Get_Timebase called");
 #endif
+    *Tbu = BSP_Time.seconds;
+    *Tbl = BSP_Time.microsecs;
 }
 
 /*****************************************************************************/
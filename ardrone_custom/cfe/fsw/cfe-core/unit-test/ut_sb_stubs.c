@@ -388,6 +388,13 @@ int32 CFE_SB_SendMsg(CFE_SB_Msg_t *MsgPtr)
 
                 break;
 
+            case CFE_EVS_DEFERRED_EVENT_MSG_MID:
+
+                SendMsgEventIDRtn.value =
+                    ((CFE_EVS_DeferredPacket_t *) MsgPtr)->Payload.PacketID.EventID;
+                SendMsgEventIDRtn.count++;
+                break;
+
             case CFE_EVS_HK_TLM_MID:
 
                 SendMsgEventIDRtn.value = CFE_EVS_HK_TLM_MID;
@@ -751,6 +758,29 @@ uint16 CFE_SB_GetTotalMsgLength(CFE_SB_MsgPtr_t MsgPtr)
     return UT_SB_TotalMsgLen;
 }
 
+/*****************************************************************************/
+/**
+** \brief CFE_SB_SetTotalMsgLength stub function
+**
+** \par Description
+**        This function is used as a placeholder for the cFE SB function
+**        CFE_SB_SetTotalMsgLength.  It writes the length into the header
+**        the way the real function does.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        This function does not return a value.
+**
+******************************************************************************/
+void CFE_SB_SetTotalMsgLength(CFE_SB_MsgPtr_t MsgPtr, uint16 TotalLength)
+{
+#ifdef MESSAGE_FORMAT_IS_CCSDS
+    CCSDS_WR_LEN(MsgPtr->Hdr, TotalLength);
+#endif
+}
+
 /*****************************************************************************/
 /**
 ** \brief CFE_SB_CleanUpApp stub function
@@ -783,6 +813,25 @@ int32 CFE_SB_CleanUpApp(uint32 AppId)
     return status;
 }
 
+/*****************************************************************************/
+/**
+** \brief CFE_SB_RegisterSender stub function
+**
+** \par Description
+**        This function is used as a placeholder for the cFE SB function
+**        CFE_SB_RegisterSender.
+**
+** \par Assumptions, External Events, and Notes:
+**        None
+**
+** \returns
+**        This function does not return a value.
+**
+******************************************************************************/
+void CFE_SB_RegisterSender(void)
+{
+}
+
 /******************************************************************************
 **  Function:  CFE_SB_MessageStringGet()
 **
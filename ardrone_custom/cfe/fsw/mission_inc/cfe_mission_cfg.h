@@ -473,5 +473,7 @@
 #define CFE_SB_ONESUB_TLM_MSG   14
 #define CFE_ES_SHELL_TLM_MSG    15
 #define CFE_ES_MEMSTATS_TLM_MSG 16
+#define CFE_ES_PERF_STREAM_TLM_MSG 17
+#define CFE_EVS_DEFERRED_EVENT_MSG_MSG 18
 
 #endif
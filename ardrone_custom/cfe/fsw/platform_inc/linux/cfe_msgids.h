@@ -106,5 +106,7 @@
 #define CFE_SB_ONESUB_TLM_MID   CFE_TLM_MID_BASE_CPU1 + CFE_SB_ONESUB_TLM_MSG   /* 0x080E */
 #define CFE_ES_SHELL_TLM_MID    CFE_TLM_MID_BASE_CPU1 + CFE_ES_SHELL_TLM_MSG    /* 0x080F */
 #define CFE_ES_MEMSTATS_TLM_MID CFE_TLM_MID_BASE_CPU1 + CFE_ES_MEMSTATS_TLM_MSG /* 0x0810 */
+#define CFE_ES_PERF_STREAM_TLM_MID CFE_TLM_MID_BASE_CPU1 + CFE_ES_PERF_STREAM_TLM_MSG /* 0x0811 */
+#define CFE_EVS_DEFERRED_EVENT_MSG_MID CFE_TLM_MID_BASE_CPU1 + CFE_EVS_DEFERRED_EVENT_MSG_MSG /* 0x0812 */
 
 #endif
@@ -47,6 +47,13 @@
 /* #define for enabling floating point operations on a task*/
 #define OS_FP_ENABLED 1
 
+/* 
+** #define for OS_QueueCreate flags, asks for a queue that lives in the calling
+** process and needs no system call while it neither fills nor empties.
+** Ports without one ignore it and create their usual queue.
+*/
+#define OS_QUEUE_RING 0x0001
+
 /*  tables for the properties of objects */
 
 /*tasks */
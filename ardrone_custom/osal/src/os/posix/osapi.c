@@ -117,6 +117,9 @@
 #include <fcntl.h>
 #include <errno.h>
 #include <limits.h>
+#include <stdlib.h>
+#include <sys/syscall.h>
+#include <linux/futex.h>
 
 /*
 ** The __USE_UNIX98 is for advanced pthread features on linux
@@ -155,6 +158,8 @@
 
 #define OS_SHUTDOWN_MAGIC_NUMBER    0xABADC0DE
 
+#define OS_RING_CACHE_LINE          64
+
 /*
 ** Global data for the API
 */
@@ -174,6 +179,30 @@ typedef struct
     uint32    priority;
     osal_task_entry  delete_hook_pointer;
 }OS_task_internal_record_t;
+
+/*
+** In-process queues, see OS_RingQueueCreate.  Each cell holds its sequence
+** number and the size of its message, the message follows.  The indices
+** and the futex word sit on cache lines of their own so that the receiver
+** and the senders do not pass a line back and forth on every message.
+*/
+typedef struct
+{
+    uint32 seq;
+    uint32 size;
+}OS_ring_cell_t;
+
+typedef struct
+{
+    uint32 head     __attribute__ ((aligned (OS_RING_CACHE_LINE)));
+    uint32 tail     __attribute__ ((aligned (OS_RING_CACHE_LINE)));
+    uint32 futex    __attribute__ ((aligned (OS_RING_CACHE_LINE)));
+    uint32 waiters;
+    uint32 depth    __attribute__ ((aligned (OS_RING_CACHE_LINE)));
+    uint32 mask;
+    uint32 stride;
+    uint8  *cells;
+}OS_ring_queue_t;
     
 #ifdef OSAL_SOCKET_QUEUE
 /* queues */
@@ -184,6 +213,7 @@ typedef struct
     uint32 max_size;
     char   name [OS_MAX_API_NAME];
     int    creator;
+    OS_ring_queue_t *ring;
 }OS_queue_internal_record_t;
 #else
 /* queues */
@@ -194,6 +224,7 @@ typedef struct
     uint32 max_size;
     char   name [OS_MAX_API_NAME];
     int    creator;
+    OS_ring_queue_t *ring;
 }OS_queue_internal_record_t;
 #endif
 
@@ -258,6 +289,13 @@ void    OS_CompAbsDelayTime( uint32 milli_second , struct timespec * tm);
 void    OS_ThreadKillHandler(int sig );
 uint32  OS_FindCreator(void);
 int32   OS_PriorityRemap(uint32 InputPri);
+int32   OS_RingQueueCreate(uint32 queue_id, const char *queue_name, uint32 queue_depth,
+                           uint32 data_size);
+int32   OS_RingQueueDelete(uint32 queue_id);
+int32   OS_RingQueueTryGet(OS_ring_queue_t *ring, void *data, uint32 *size_copied);
+int32   OS_RingQueueGet(uint32 queue_id, void *data, uint32 size, uint32 *size_copied,
+                        int32 timeout);
+int32   OS_RingQueuePut(uint32 queue_id, const void *data, uint32 size);
 int     OS_InterruptSafeLock(pthread_mutex_t *lock, sigset_t *set, sigset_t *previous);
 void    OS_InterruptSafeUnlock(pthread_mutex_t *lock, sigset_t *previous);
 
@@ -347,6 +385,7 @@ int32 OS_API_Init(void)
         OS_queue_table[i].free        = TRUE;
         OS_queue_table[i].id          = UNINITIALIZED;
         OS_queue_table[i].creator     = UNINITIALIZED;
+        OS_queue_table[i].ring        = NULL;
         strcpy(OS_queue_table[i].name,""); 
     }
 
@@ -1309,7 +1348,7 @@ int32 OS_TaskInstallDeleteHandler(osal_task_entry function_pointer)
             OS_ERROR if the OS create call fails
             OS_SUCCESS if success
 
-   Notes: the flags parameter is unused.
+   Notes: flags may be OS_QUEUE_RING, for an in-process queue, see OS_RingQueueCreate.
 ---------------------------------------------------------------------------------------*/
 int32 OS_QueueCreate (uint32 *queue_id, const char *queue_name, uint32 queue_depth,
                        uint32 data_size, uint32 flags)
@@ -1367,6 +1406,17 @@ int32 OS_QueueCreate (uint32 *queue_id, const char *queue_name, uint32 queue_dep
     OS_queue_table[possible_qid].free = FALSE;
     
     OS_InterruptSafeUnlock(&OS_queue_table_mut, &previous); 
+
+    if (flags & OS_QUEUE_RING)
+    {
+        if (OS_RingQueueCreate(possible_qid, queue_name, queue_depth, data_size) != OS_SUCCESS)
+        {
+            return OS_ERROR;
+        }
+
+        *queue_id = possible_qid;
+        return OS_SUCCESS;
+    }
     
     tmpSkt = socket(AF_INET, SOCK_DGRAM, 0);
     if ( tmpSkt == -1 )
@@ -1448,6 +1498,11 @@ int32 OS_QueueDelete (uint32 queue_id)
         return OS_ERR_INVALID_ID;
     }
 
+    if (OS_queue_table[queue_id].ring != NULL)
+    {
+        return OS_RingQueueDelete(queue_id);
+    }
+
     /* Try to delete the queue */
 
     if(close(OS_queue_table[queue_id].id) !=0)   
@@ -1512,6 +1567,11 @@ int32 OS_QueueGet (uint32 queue_id, void *data, uint32 size, uint32 *size_copied
       *size_copied = 0;
       return(OS_QUEUE_INVALID_SIZE);
    }
+
+   if (OS_queue_table[queue_id].ring != NULL)
+   {
+      return OS_RingQueueGet(queue_id, data, size, size_copied, timeout);
+   }
     
    /*
    ** Read the socket for data
@@ -1667,6 +1727,11 @@ int32 OS_QueuePut (uint32 queue_id, const void *data, uint32 size, uint32 flags)
        return OS_INVALID_POINTER;
    }
 
+   if (OS_queue_table[queue_id].ring != NULL)
+   {
+       return OS_RingQueuePut(queue_id, data, size);
+   }
+
    /* 
    ** specify the IP addres and port number of destination
    */
@@ -1721,7 +1786,7 @@ int32 OS_QueuePut (uint32 queue_id, const void *data, uint32 size, uint32 flags)
  OS_ERROR if the OS create call fails
  OS_SUCCESS if success
  
- Notes: the flags parameter is unused.
+ Notes: flags may be OS_QUEUE_RING, for an in-process queue, see OS_RingQueueCreate.
  ---------------------------------------------------------------------------------------*/
 int32 OS_QueueCreate (uint32 *queue_id, const char *queue_name, uint32 queue_depth,
                       uint32 data_size, uint32 flags)
@@ -1783,6 +1848,17 @@ int32 OS_QueueCreate (uint32 *queue_id, const char *queue_name, uint32 queue_dep
     OS_queue_table[possible_qid].free = FALSE;
     
     OS_InterruptSafeUnlock(&OS_queue_table_mut, &previous); 
+
+    if (flags & OS_QUEUE_RING)
+    {
+        if (OS_RingQueueCreate(possible_qid, queue_name, queue_depth, data_size) != OS_SUCCESS)
+        {
+            return OS_ERROR;
+        }
+
+        *queue_id = possible_qid;
+        return OS_SUCCESS;
+    }
     
     /* set queue attributes */
     queueAttr.mq_maxmsg  = queue_depth;
@@ -1879,6 +1955,11 @@ int32 OS_QueueDelete (uint32 queue_id)
     {
        return OS_ERR_INVALID_ID;
     }
+
+    if (OS_queue_table[queue_id].ring != NULL)
+    {
+        return OS_RingQueueDelete(queue_id);
+    }
     
     /*
     ** Construct the queue name:
@@ -1961,6 +2042,11 @@ int32 OS_QueueGet (uint32 queue_id, void *data, uint32 size, uint32 *size_copied
         return(OS_QUEUE_INVALID_SIZE);
     }
 
+    if (OS_queue_table[queue_id].ring != NULL)
+    {
+        return OS_RingQueueGet(queue_id, data, size, size_copied, timeout);
+    }
+
     /*
     ** Read the message queue for data
     */
@@ -2082,6 +2168,11 @@ int32 OS_QueuePut (uint32 queue_id, const void *data, uint32 size, uint32 flags)
     {
        return OS_INVALID_POINTER;
     }
+
+    if (OS_queue_table[queue_id].ring != NULL)
+    {
+       return OS_RingQueuePut(queue_id, data, size);
+    }
     
     /* get queue attributes */
     if(mq_getattr(OS_queue_table[queue_id].id, &queueAttr))
@@ -2109,6 +2200,332 @@ int32 OS_QueuePut (uint32 queue_id, const void *data, uint32 size, uint32 flags)
 /* --------------------- END POSIX MESSAGE QUEUE IMPLEMENTATION ---------------------- */
 #endif
 
+/* ------------------------- IN-PROCESS QUEUE IMPLEMENTATION ------------------------- */
+/*---------------------------------------------------------------------------------------
+   Name: OS_RingQueueCreate
+
+   Purpose: Set up the in-process queue behind a queue table entry that OS_QueueCreate
+            has already claimed, for a queue created with OS_QUEUE_RING.
+
+   Returns: OS_ERROR if the memory for the queue could not be had
+            OS_SUCCESS if success
+
+   Notes: The queue is a bounded ring of cells, each stamped with a sequence number
+          that says whether a put or a get may have it next.  Any number of tasks may
+          put, a put claims a cell by moving the tail on and fills it in without a
+          lock.  A get that finds the ring empty sleeps on a futex, which a put only
+          touches when some task is waiting.  So neither side makes a system call
+          unless the receiver has run dry.  The ring is rounded up to a power of two
+          cells, but no more than queue_depth messages are let in.
+---------------------------------------------------------------------------------------*/
+int32 OS_RingQueueCreate(uint32 queue_id, const char *queue_name, uint32 queue_depth,
+                         uint32 data_size)
+{
+    OS_ring_queue_t *ring = NULL;
+    OS_ring_cell_t  *cell;
+    uint32           capacity = 1;
+    uint32           i;
+    sigset_t         previous;
+    sigset_t         mask;
+
+    while (capacity < queue_depth)
+    {
+        capacity <<= 1;
+    }
+
+    if (posix_memalign((void **) &ring, OS_RING_CACHE_LINE, sizeof(OS_ring_queue_t)) == 0)
+    {
+        memset(ring, 0, sizeof(OS_ring_queue_t));
+        ring->depth  = queue_depth;
+        ring->mask   = capacity - 1;
+        ring->stride = (sizeof(OS_ring_cell_t) + data_size + 7) & ~7;
+        ring->cells  = malloc(capacity * ring->stride);
+    }
+
+    if (ring == NULL || ring->cells == NULL)
+    {
+        free(ring);
+
+        OS_InterruptSafeLock(&OS_queue_table_mut, &mask, &previous); 
+        OS_queue_table[queue_id].free = TRUE;
+        OS_InterruptSafeUnlock(&OS_queue_table_mut, &previous); 
+
+        #ifdef OS_DEBUG_PRINTF
+           printf("OS_QueueCreate could not allocate a ring of %d cells\n", (int)capacity);
+        #endif
+        return OS_ERROR;
+    }
+
+    for (i = 0; i < capacity; i++)
+    {
+        cell = (OS_ring_cell_t *) (ring->cells + i * ring->stride);
+        cell->seq  = i;
+        cell->size = 0;
+    }
+
+    OS_InterruptSafeLock(&OS_queue_table_mut, &mask, &previous); 
+
+    OS_queue_table[queue_id].id = UNINITIALIZED;
+    OS_queue_table[queue_id].ring = ring;
+    OS_queue_table[queue_id].free = FALSE;
+    OS_queue_table[queue_id].max_size = data_size;
+    strcpy( OS_queue_table[queue_id].name, (char*) queue_name);
+    OS_queue_table[queue_id].creator = OS_FindCreator();
+
+    OS_InterruptSafeUnlock(&OS_queue_table_mut, &previous); 
+
+    return OS_SUCCESS;
+
+}/* end OS_RingQueueCreate */
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_RingQueueDelete
+
+   Purpose: Free an in-process queue and its queue table entry.
+
+   Returns: OS_SUCCESS
+
+   Notes: As with the other queues, no task may be using the queue while it goes.
+---------------------------------------------------------------------------------------*/
+int32 OS_RingQueueDelete(uint32 queue_id)
+{
+    OS_ring_queue_t *ring;
+    sigset_t         previous;
+    sigset_t         mask;
+
+    OS_InterruptSafeLock(&OS_queue_table_mut, &mask, &previous); 
+
+    ring = OS_queue_table[queue_id].ring;
+
+    OS_queue_table[queue_id].free = TRUE;
+    strcpy(OS_queue_table[queue_id].name, "");
+    OS_queue_table[queue_id].creator = UNINITIALIZED;
+    OS_queue_table[queue_id].max_size = 0;
+    OS_queue_table[queue_id].id = UNINITIALIZED;
+    OS_queue_table[queue_id].ring = NULL;
+
+    OS_InterruptSafeUnlock(&OS_queue_table_mut, &previous); 
+
+    free(ring->cells);
+    free(ring);
+
+    return OS_SUCCESS;
+
+}/* end OS_RingQueueDelete */
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_RingQueueTryGet
+
+   Purpose: Take the oldest message off an in-process queue, if there is one.
+
+   Returns: OS_QUEUE_EMPTY if there is no message
+            OS_SUCCESS if success
+---------------------------------------------------------------------------------------*/
+int32 OS_RingQueueTryGet(OS_ring_queue_t *ring, void *data, uint32 *size_copied)
+{
+    OS_ring_cell_t *cell;
+    uint32          pos;
+    int32           diff;
+
+    pos = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        cell = (OS_ring_cell_t *) (ring->cells + (pos & ring->mask) * ring->stride);
+        diff = (int32) (__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) - (pos + 1));
+
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&ring->head, &pos, pos + 1, TRUE,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            /* the cell has not been filled in yet */
+            return OS_QUEUE_EMPTY;
+        }
+        else
+        {
+            pos = __atomic_load_n(&ring->head, __ATOMIC_RELAXED);
+        }
+    }
+
+    *size_copied = cell->size;
+    memcpy(data, cell + 1, cell->size);
+
+    /* hand the cell back to the puts, one time round the ring on */
+    __atomic_store_n(&cell->seq, pos + ring->mask + 1, __ATOMIC_RELEASE);
+
+    return OS_SUCCESS;
+
+}/* end OS_RingQueueTryGet */
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_RingQueueGet
+
+   Purpose: OS_QueueGet for an in-process queue.  Will pend or timeout on the receive.
+
+   Returns: OS_QUEUE_EMPTY if the Queue has no messages on it to be recieved
+            OS_QUEUE_TIMEOUT if the timeout expired
+            OS_SUCCESS if success
+
+   Notes: A waiting task counts itself in waiters before it looks at the ring a last
+          time, and a put looks at waiters after its message is in, each behind a full
+          barrier.  So either the get sees the message or the put sees the waiter and
+          bumps the futex word, which stops the get from sleeping on its old value.
+---------------------------------------------------------------------------------------*/
+int32 OS_RingQueueGet(uint32 queue_id, void *data, uint32 size, uint32 *size_copied,
+                      int32 timeout)
+{
+    OS_ring_queue_t *ring = OS_queue_table[queue_id].ring;
+    struct timespec  deadline;
+    struct timespec  now;
+    struct timespec  remaining;
+    uint32           value;
+    int32            status;
+
+    status = OS_RingQueueTryGet(ring, data, size_copied);
+
+    if (status == OS_SUCCESS || timeout == OS_CHECK)
+    {
+        if (status != OS_SUCCESS)
+        {
+            *size_copied = 0;
+        }
+        return status;
+    }
+
+    if (timeout != OS_PEND)
+    {
+        clock_gettime(CLOCK_MONOTONIC, &deadline);
+        deadline.tv_sec  += timeout / 1000;
+        deadline.tv_nsec += (timeout % 1000) * 1000000;
+        if (deadline.tv_nsec >= 1000000000)
+        {
+            deadline.tv_sec++;
+            deadline.tv_nsec -= 1000000000;
+        }
+    }
+
+    for (;;)
+    {
+        value = __atomic_load_n(&ring->futex, __ATOMIC_RELAXED);
+
+        __atomic_add_fetch(&ring->waiters, 1, __ATOMIC_SEQ_CST);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+        status = OS_RingQueueTryGet(ring, data, size_copied);
+        if (status == OS_SUCCESS)
+        {
+            __atomic_sub_fetch(&ring->waiters, 1, __ATOMIC_RELAXED);
+            return OS_SUCCESS;
+        }
+
+        if (timeout == OS_PEND)
+        {
+            syscall(SYS_futex, &ring->futex, FUTEX_WAIT_PRIVATE, value, NULL, NULL, 0);
+        }
+        else
+        {
+            clock_gettime(CLOCK_MONOTONIC, &now);
+            remaining.tv_sec  = deadline.tv_sec - now.tv_sec;
+            remaining.tv_nsec = deadline.tv_nsec - now.tv_nsec;
+            if (remaining.tv_nsec < 0)
+            {
+                remaining.tv_sec--;
+                remaining.tv_nsec += 1000000000;
+            }
+
+            if (remaining.tv_sec < 0)
+            {
+                __atomic_sub_fetch(&ring->waiters, 1, __ATOMIC_RELAXED);
+                *size_copied = 0;
+                return OS_QUEUE_TIMEOUT;
+            }
+
+            syscall(SYS_futex, &ring->futex, FUTEX_WAIT_PRIVATE, value, &remaining, NULL, 0);
+        }
+
+        __atomic_sub_fetch(&ring->waiters, 1, __ATOMIC_RELAXED);
+    }
+
+}/* end OS_RingQueueGet */
+
+/*---------------------------------------------------------------------------------------
+   Name: OS_RingQueuePut
+
+   Purpose: OS_QueuePut for an in-process queue.
+
+   Returns: OS_QUEUE_INVALID_SIZE if the message is bigger than the queue was made for
+            OS_QUEUE_FULL if the queue cannot accept another message
+            OS_SUCCESS if SUCCESS
+---------------------------------------------------------------------------------------*/
+int32 OS_RingQueuePut(uint32 queue_id, const void *data, uint32 size)
+{
+    OS_ring_queue_t *ring = OS_queue_table[queue_id].ring;
+    OS_ring_cell_t  *cell;
+    uint32           pos;
+    int32            diff;
+
+    if (size > OS_queue_table[queue_id].max_size)
+    {
+        return OS_QUEUE_INVALID_SIZE;
+    }
+
+    pos = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+
+    for (;;)
+    {
+        cell = (OS_ring_cell_t *) (ring->cells + (pos & ring->mask) * ring->stride);
+        diff = (int32) (__atomic_load_n(&cell->seq, __ATOMIC_ACQUIRE) - pos);
+
+        if (diff == 0)
+        {
+            /* a stale pos reads as negative here and fails the exchange below */
+            if ((int32) (pos - __atomic_load_n(&ring->head, __ATOMIC_RELAXED)) >= (int32) ring->depth)
+            {
+                return OS_QUEUE_FULL;
+            }
+
+            if (__atomic_compare_exchange_n(&ring->tail, &pos, pos + 1, TRUE,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            /* the get from one time round the ring has not finished with the cell */
+            return OS_QUEUE_FULL;
+        }
+        else
+        {
+            pos = __atomic_load_n(&ring->tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    cell->size = size;
+    memcpy(cell + 1, data, size);
+    __atomic_store_n(&cell->seq, pos + 1, __ATOMIC_RELEASE);
+
+    /* pairs with the barrier in OS_RingQueueGet */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+
+    if (__atomic_load_n(&ring->waiters, __ATOMIC_RELAXED) != 0)
+    {
+        __atomic_add_fetch(&ring->futex, 1, __ATOMIC_RELAXED);
+        syscall(SYS_futex, &ring->futex, FUTEX_WAKE_PRIVATE, 1, NULL, NULL, 0);
+    }
+
+    return OS_SUCCESS;
+
+}/* end OS_RingQueuePut */
+
+/* ----------------------- END IN-PROCESS QUEUE IMPLEMENTATION ----------------------- */
+
 /*--------------------------------------------------------------------------------------
     Name: OS_QueueGetIdByName
 
@@ -16,6 +16,13 @@
 **          This implementation depends on the POSIX Timer API which may not be available
 **          in older versions of the Linux kernel. It was developed and tested on
 **          RHEL 5 ./ CentOS 5 with Linux kernel 2.6.18
+**
+**          With OSAL_THREAD_TIMERS defined (see osconfig.h) the timers do not use
+**          signals.  One timer thread, at the highest real time priority, sleeps on a
+**          timerfd set to the earliest deadline of a heap of the armed timers, and calls
+**          the callbacks of the timers that are due.  The callbacks then run in a thread
+**          instead of interrupting whichever thread the signal was delivered to, and
+**          the number of timers is not limited by the RT signals.
 */
 
 /****************************************************************************************
@@ -34,6 +41,11 @@
 #include <sys/signal.h>
 #include <sys/errno.h>
 #include <pthread.h>
+#include <sched.h>
+
+#ifdef OSAL_THREAD_TIMERS
+#include <sys/timerfd.h>
+#endif
 
 /****************************************************************************************
                                 EXTERNAL FUNCTION PROTOTYPES
@@ -54,12 +66,14 @@ void  OS_UsecToTimespec(uint32 usecs, struct timespec *time_spec);
                                      DEFINES
 ****************************************************************************************/
 
+#ifndef OSAL_THREAD_TIMERS
 /*
 ** The timers use the RT Signals. The system that this code was developed
 ** and tested on has 32 available RT signals ( SIGRTMIN -> SIGRTMAX ).
 ** OS_MAX_TIMERS should not be set to more than this number.
 */
 #define OS_STARTING_SIGNAL  (SIGRTMAX-1)
+#endif
 
 /*
 ** Since the API is storing the timer values in a 32 bit integer as Microseconds, 
@@ -82,7 +96,12 @@ typedef struct
    uint32              interval_time;
    uint32              accuracy;
    OS_TimerCallback_t  callback_ptr;
+#ifdef OSAL_THREAD_TIMERS
+   uint64              deadline;       /* next expiry, nanoseconds of CLOCK_MONOTONIC */
+   uint32              heap_index;     /* place in OS_timer_heap, OS_MAX_TIMERS when not armed */
+#else
    timer_t              host_timerid;
+#endif
 
 } OS_timer_internal_record_t;
 
@@ -98,6 +117,18 @@ uint32           os_clock_accuracy;
 */
 pthread_mutex_t    OS_timer_table_mut;
 
+#ifdef OSAL_THREAD_TIMERS
+/*
+** The armed timers, a heap on the deadline so that OS_timer_heap[0] is the
+** next timer due, and the timerfd and thread that wait for it.
+** All of these are protected by OS_timer_table_mut.
+*/
+uint32             OS_timer_heap[OS_MAX_TIMERS];
+uint32             OS_timer_heap_size;
+int                OS_timer_fd = -1;
+pthread_t          OS_timer_thread;
+#endif
+
 /****************************************************************************************
                                 INITIALIZATION FUNCTION
 ****************************************************************************************/
@@ -116,6 +147,9 @@ int32  OS_TimerAPIInit ( void )
       OS_timer_table[i].free      = TRUE;
       OS_timer_table[i].creator   = UNINITIALIZED;
       strcpy(OS_timer_table[i].name,"");
+#ifdef OSAL_THREAD_TIMERS
+      OS_timer_table[i].heap_index = OS_MAX_TIMERS;
+#endif
 
    }
 
@@ -151,6 +185,266 @@ int32  OS_TimerAPIInit ( void )
                                 INTERNAL FUNCTIONS
 ****************************************************************************************/
 
+#ifdef OSAL_THREAD_TIMERS
+
+/******************************************************************************
+ **  Function:  OS_TimerNow
+ **
+ **  Purpose:  Return the CLOCK_MONOTONIC time in nanoseconds, the clock the
+ **            deadlines are kept on so that setting the time does not move them.
+ */
+static uint64 OS_TimerNow(void)
+{
+   struct timespec now;
+
+   clock_gettime(CLOCK_MONOTONIC, &now);
+
+   return ((uint64) now.tv_sec * 1000000000) + now.tv_nsec;
+}
+
+/******************************************************************************
+ **  Function:  OS_TimerHeapSwap
+ **
+ **  Purpose:  Swap two places of the timer heap.  Called with the table locked.
+ */
+static void OS_TimerHeapSwap(uint32 a, uint32 b)
+{
+   uint32 timer_id = OS_timer_heap[a];
+
+   OS_timer_heap[a] = OS_timer_heap[b];
+   OS_timer_heap[b] = timer_id;
+
+   OS_timer_table[OS_timer_heap[a]].heap_index = a;
+   OS_timer_table[OS_timer_heap[b]].heap_index = b;
+}
+
+/******************************************************************************
+ **  Function:  OS_TimerHeapFix
+ **
+ **  Purpose:  Move the timer at a place of the heap up or down to where its
+ **            deadline belongs.  Called with the table locked.
+ */
+static void OS_TimerHeapFix(uint32 index)
+{
+   uint32 parent;
+   uint32 child;
+
+   while (index > 0)
+   {
+      parent = (index - 1) / 2;
+      if (OS_timer_table[OS_timer_heap[parent]].deadline <= OS_timer_table[OS_timer_heap[index]].deadline)
+      {
+         break;
+      }
+      OS_TimerHeapSwap(parent, index);
+      index = parent;
+   }
+
+   while ((child = (2 * index) + 1) < OS_timer_heap_size)
+   {
+      if ((child + 1 < OS_timer_heap_size) &&
+          (OS_timer_table[OS_timer_heap[child + 1]].deadline < OS_timer_table[OS_timer_heap[child]].deadline))
+      {
+         child++;
+      }
+      if (OS_timer_table[OS_timer_heap[index]].deadline <= OS_timer_table[OS_timer_heap[child]].deadline)
+      {
+         break;
+      }
+      OS_TimerHeapSwap(index, child);
+      index = child;
+   }
+}
+
+/******************************************************************************
+ **  Function:  OS_TimerHeapRemove
+ **
+ **  Purpose:  Take a timer out of the heap, if it is armed.  Called with the
+ **            table locked.
+ */
+static void OS_TimerHeapRemove(uint32 timer_id)
+{
+   uint32 index = OS_timer_table[timer_id].heap_index;
+
+   if (index >= OS_timer_heap_size)
+   {
+      return;
+   }
+
+   OS_timer_heap_size--;
+   if (index != OS_timer_heap_size)
+   {
+      OS_TimerHeapSwap(index, OS_timer_heap_size);
+      OS_TimerHeapFix(index);
+   }
+   OS_timer_table[timer_id].heap_index = OS_MAX_TIMERS;
+}
+
+/******************************************************************************
+ **  Function:  OS_TimerHeapPlace
+ **
+ **  Purpose:  Put a timer in the heap for its deadline, or move it there if
+ **            it is already armed.  Called with the table locked.
+ */
+static void OS_TimerHeapPlace(uint32 timer_id)
+{
+   uint32 index = OS_timer_table[timer_id].heap_index;
+
+   if (index >= OS_timer_heap_size)
+   {
+      index = OS_timer_heap_size++;
+      OS_timer_heap[index] = timer_id;
+      OS_timer_table[timer_id].heap_index = index;
+   }
+   OS_TimerHeapFix(index);
+}
+
+/******************************************************************************
+ **  Function:  OS_TimerArm
+ **
+ **  Purpose:  Set the timerfd to the deadline at the top of the heap, or
+ **            disarm it when no timer is armed.  Called with the table locked.
+ */
+static int OS_TimerArm(void)
+{
+   struct itimerspec timeout;
+   uint64            deadline;
+
+   memset(&timeout, 0, sizeof(timeout));
+   if (OS_timer_heap_size > 0)
+   {
+      deadline = OS_timer_table[OS_timer_heap[0]].deadline;
+      timeout.it_value.tv_sec = deadline / 1000000000;
+      timeout.it_value.tv_nsec = deadline % 1000000000;
+   }
+
+   return timerfd_settime(OS_timer_fd, TFD_TIMER_ABSTIME, &timeout, NULL);
+}
+
+/******************************************************************************
+ **  Function:  OS_TimerThread
+ **
+ **  Purpose:  The timer thread.  Waits on the timerfd for the earliest deadline,
+ **            takes the timers that are due off the heap, putting the periodic
+ **            ones back for their next interval, and calls their callbacks with
+ **            the table unlocked.
+ **
+ **            A periodic deadline moves on by whole intervals from the one before,
+ **            so the timer does not drift; intervals the thread was too late for
+ **            are skipped rather than called back to back.
+ */
+static void *OS_TimerThread(void *arg)
+{
+   struct sched_param  param;
+   int                 sched_policy;
+   int                 ret;
+   uint64              expirations;
+   uint64              now;
+   uint64              interval;
+   uint32              due_id[OS_MAX_TIMERS];
+   OS_TimerCallback_t  due_callback[OS_MAX_TIMERS];
+   uint32              due;
+   uint32              timer_id;
+   uint32              i;
+   sigset_t            previous;
+   sigset_t            mask;
+
+   /*
+   ** Run ahead of every task, as the signal handlers did.  As for the main
+   ** thread in OS_API_Init, the default priority is kept without permission.
+   */
+   sched_policy = SCHED_FIFO;
+   param.sched_priority = sched_get_priority_max(sched_policy);
+   ret = pthread_setschedparam(pthread_self(), sched_policy, &param);
+   if (ret != 0)
+   {
+#ifdef OS_DEBUG_PRINTF
+      printf("OS_TimerThread: Could not set scheduleparam, error=%d\n",ret);
+#endif
+   }
+
+   while (1)
+   {
+      /*
+      ** Woken when the deadline the timerfd is set to goes by; OS_TimerSet
+      ** and OS_TimerDelete set it again, so there may be nothing due.
+      */
+      if (read(OS_timer_fd, &expirations, sizeof(expirations)) < 0 && errno != EINTR)
+      {
+         break;
+      }
+
+      due = 0;
+      OS_InterruptSafeLock(&OS_timer_table_mut, &mask, &previous);
+
+      now = OS_TimerNow();
+      while (OS_timer_heap_size > 0 && OS_timer_table[OS_timer_heap[0]].deadline <= now)
+      {
+         timer_id = OS_timer_heap[0];
+         due_id[due] = timer_id;
+         due_callback[due] = OS_timer_table[timer_id].callback_ptr;
+         due++;
+
+         interval = (uint64) OS_timer_table[timer_id].interval_time * 1000;
+         if (interval > 0)
+         {
+            OS_timer_table[timer_id].deadline +=
+               (((now - OS_timer_table[timer_id].deadline) / interval) + 1) * interval;
+            OS_TimerHeapFix(0);
+         }
+         else
+         {
+            OS_TimerHeapRemove(timer_id);
+         }
+      }
+
+      OS_TimerArm();
+      OS_InterruptSafeUnlock(&OS_timer_table_mut, &previous);
+
+      for (i = 0; i < due; i++)
+      {
+         (due_callback[i])(due_id[i]);
+      }
+   }
+
+   return NULL;
+}
+
+/******************************************************************************
+ **  Function:  OS_TimerThreadStart
+ **
+ **  Purpose:  Create the timerfd and the timer thread when the first timer is
+ **            created, so a process without timers has neither.  Called with
+ **            the table locked, and so with all signals blocked, which the
+ **            thread keeps.
+ */
+static int32 OS_TimerThreadStart(void)
+{
+   if (OS_timer_fd >= 0)
+   {
+      return OS_SUCCESS;
+   }
+
+   OS_timer_fd = timerfd_create(CLOCK_MONOTONIC, 0);
+   if (OS_timer_fd < 0)
+   {
+      return OS_TIMER_ERR_UNAVAILABLE;
+   }
+
+   if (pthread_create(&OS_timer_thread, NULL, OS_TimerThread, NULL) != 0)
+   {
+      close(OS_timer_fd);
+      OS_timer_fd = -1;
+      return OS_TIMER_ERR_UNAVAILABLE;
+   }
+
+   pthread_detach(OS_timer_thread);
+
+   return OS_SUCCESS;
+}
+
+#else
+
 /*
 ** Timer Signal Handler.
 ** The purpose of this function is to convert the POSIX signal number to the 
@@ -172,6 +466,8 @@ void OS_TimerSignalHandler(int signum)
 
 }
  
+#endif
+
 /******************************************************************************
  **  Function:  OS_UsecToTimespec
  **
@@ -235,9 +531,11 @@ int32 OS_TimerCreate(uint32 *timer_id, const char *timer_name, uint32 *clock_acc
    sigset_t  previous;
    sigset_t  mask;
 
+#ifndef OSAL_THREAD_TIMERS
    int                status;
    struct  sigaction  sig_act;
    struct  sigevent   evp;
+#endif
 
    if ( timer_id == NULL || timer_name == NULL || clock_accuracy == NULL)
    {
@@ -258,6 +556,14 @@ int32 OS_TimerCreate(uint32 *timer_id, const char *timer_name, uint32 *clock_acc
    */
    OS_InterruptSafeLock(&OS_timer_table_mut, &mask, &previous);
     
+#ifdef OSAL_THREAD_TIMERS
+   if (OS_TimerThreadStart() != OS_SUCCESS)
+   {
+      OS_InterruptSafeUnlock(&OS_timer_table_mut, &previous);
+      return OS_TIMER_ERR_UNAVAILABLE;
+   }
+#endif
+
    for(possible_tid = 0; possible_tid < OS_MAX_TIMERS; possible_tid++)
    {
       if (OS_timer_table[possible_tid].free == TRUE)
@@ -307,6 +613,7 @@ int32 OS_TimerCreate(uint32 *timer_id, const char *timer_name, uint32 *clock_acc
     
    OS_timer_table[possible_tid].callback_ptr = callback_ptr;
 
+#ifndef OSAL_THREAD_TIMERS
    /*
    **  Initialize the sigaction and sigevent structures for the handler.
    */
@@ -333,6 +640,7 @@ int32 OS_TimerCreate(uint32 *timer_id, const char *timer_name, uint32 *clock_acc
    ** Set the signal action for the timer
    */
    sigaction(OS_STARTING_SIGNAL - possible_tid, &(sig_act), 0); 
+#endif
 
    /*
    ** Return the clock accuracy to the user
@@ -361,7 +669,13 @@ int32 OS_TimerCreate(uint32 *timer_id, const char *timer_name, uint32 *clock_acc
 int32 OS_TimerSet(uint32 timer_id, uint32 start_time, uint32 interval_time)
 {
    int    status;
+#ifdef OSAL_THREAD_TIMERS
+   uint32    next_id;
+   sigset_t  previous;
+   sigset_t  mask;
+#else
    struct itimerspec timeout;
+#endif
 
    /* 
    ** Check to see if the timer_id given is valid 
@@ -384,6 +698,37 @@ int32 OS_TimerSet(uint32 timer_id, uint32 start_time, uint32 interval_time)
       interval_time = os_clock_accuracy;
    }
 
+#ifdef OSAL_THREAD_TIMERS
+   /*
+   ** Save the start and interval times and arm the timer for its first
+   ** deadline, or disarm it for a start time of 0.  The timerfd only has
+   ** to be set again when the next timer due has changed.
+   */
+   OS_InterruptSafeLock(&OS_timer_table_mut, &mask, &previous);
+
+   OS_timer_table[timer_id].start_time = start_time;
+   OS_timer_table[timer_id].interval_time = interval_time;
+
+   next_id = (OS_timer_heap_size > 0) ? OS_timer_heap[0] : OS_MAX_TIMERS;
+
+   if (start_time > 0)
+   {
+      OS_timer_table[timer_id].deadline = OS_TimerNow() + ((uint64) start_time * 1000);
+      OS_TimerHeapPlace(timer_id);
+   }
+   else
+   {
+      OS_TimerHeapRemove(timer_id);
+   }
+
+   status = 0;
+   if (next_id == timer_id || next_id != ((OS_timer_heap_size > 0) ? OS_timer_heap[0] : OS_MAX_TIMERS))
+   {
+      status = OS_TimerArm();
+   }
+
+   OS_InterruptSafeUnlock(&OS_timer_table_mut, &previous);
+#else
    /*
    ** Save the start and interval times 
    */
@@ -403,6 +748,7 @@ int32 OS_TimerSet(uint32 timer_id, uint32 start_time, uint32 interval_time)
                              0,              /* Flags field can be zero */
                              &timeout,       /* struct itimerspec */
 		             NULL);         /* Oldvalue */
+#endif
    if (status < 0) 
    {
       return ( OS_TIMER_ERR_INTERNAL);
@@ -426,6 +772,10 @@ int32 OS_TimerSet(uint32 timer_id, uint32 start_time, uint32 interval_time)
 int32 OS_TimerDelete(uint32 timer_id)
 {
    int status;
+#ifdef OSAL_THREAD_TIMERS
+   sigset_t  previous;
+   sigset_t  mask;
+#endif
 
    /* 
    ** Check to see if the timer_id given is valid 
@@ -438,8 +788,26 @@ int32 OS_TimerDelete(uint32 timer_id)
    /*
    ** Delete the timer 
    */
+#ifdef OSAL_THREAD_TIMERS
+   OS_InterruptSafeLock(&OS_timer_table_mut, &mask, &previous);
+
+   status = 0;
+   if (OS_timer_table[timer_id].heap_index == 0)
+   {
+      OS_TimerHeapRemove(timer_id);
+      status = OS_TimerArm();
+   }
+   else
+   {
+      OS_TimerHeapRemove(timer_id);
+   }
+   OS_timer_table[timer_id].free = TRUE;
+
+   OS_InterruptSafeUnlock(&OS_timer_table_mut, &previous);
+#else
    status = timer_delete((timer_t)(OS_timer_table[timer_id].host_timerid));
    OS_timer_table[timer_id].free = TRUE;
+#endif
    if (status < 0)
    {
       return ( OS_TIMER_ERR_INTERNAL);
@@ -128,6 +128,9 @@ typedef struct
 */
 void CFE_PSP_SigintHandler (int signal);
 void CFE_PSP_TimerHandler (int signum);
+#ifdef OSAL_THREAD_TIMERS
+void CFE_PSP_TimerCallback (uint32 timer_id);
+#endif
 void CFE_PSP_DisplayUsage(char *Name );
 void CFE_PSP_ProcessArgumentDefaults(CFE_PSP_CommandData_t *CommandData);
 
@@ -140,6 +143,9 @@ extern void CFE_PSP_DeleteProcessorReservedMemory(void);
 ** Global variables
 */
 uint32              TimerCounter;
+#ifdef OSAL_THREAD_TIMERS
+uint32              TimerId;
+#endif
 CFE_PSP_CommandData_t CommandData;
 uint32              CFE_PSP_SpacecraftId;
 uint32              CFE_PSP_CpuId;
@@ -180,8 +186,12 @@ int main(int argc, char *argv[])
 {
    uint32             reset_type;
    uint32             reset_subtype;
+#ifdef OSAL_THREAD_TIMERS
+   uint32             timer_accuracy;
+#else
    struct             sigaction sa;
    struct             itimerval timer;
+#endif
    int                opt = 0;
    int                longIndex = 0;
 
@@ -294,6 +304,7 @@ int main(int argc, char *argv[])
    */
    signal(SIGINT, CFE_PSP_SigintHandler);
 
+#ifndef OSAL_THREAD_TIMERS
    /*
    ** Init timer counter
    */
@@ -317,6 +328,7 @@ int main(int argc, char *argv[])
    */
    timer.it_interval.tv_sec  = 0;
    timer.it_interval.tv_usec = 250000;
+#endif
 
    /*
    ** Initialize the OS API data structures
@@ -338,10 +350,23 @@ int main(int argc, char *argv[])
    CFE_PSP_InitProcessorReservedMemory(reset_type);
 
 
+#ifdef OSAL_THREAD_TIMERS
+   /*
+   ** Start the timer, an OSAL timer so that the 1hz "isr" runs in the OSAL
+   ** timer thread instead of a signal handler: after 250ms, as the first of
+   ** the 250ms signals did, and every second after that.
+   */
+   if ((OS_TimerCreate(&TimerId, "PSP_1HZ", &timer_accuracy, CFE_PSP_TimerCallback) != OS_SUCCESS) ||
+       (OS_TimerSet(TimerId, 250000, 1000000) != OS_SUCCESS))
+   {
+      printf("CFE_PSP: Could not start the 1hz timer\n");
+   }
+#else
    /*
    ** Start the timer
    */
    setitimer (ITIMER_REAL, &timer, NULL);
+#endif
 
 
    /*
@@ -417,6 +442,29 @@ void CFE_PSP_TimerHandler (int signum)
 	  TimerCounter++;
 }
 
+#ifdef OSAL_THREAD_TIMERS
+/******************************************************************************
+**  Function:  CFE_PSP_TimerCallback()
+**
+**  Purpose:
+**    1hz "isr" routine for linux/OSX with the OSAL timer thread.
+**    This OSAL timer callback will execute once a second.
+**
+**  Arguments:
+**    timer_id - OSAL timer id
+**
+**  Return:
+**    (none)
+*/
+void CFE_PSP_TimerCallback (uint32 timer_id)
+{
+      /*
+      ** call the CFE_TIME 1hz ISR
+      */
+      CFE_TIME_1HZ_FUNCTION();
+}
+#endif
+
 /******************************************************************************
 **  Function:  CFE_PSP_DisplayUsage
 **
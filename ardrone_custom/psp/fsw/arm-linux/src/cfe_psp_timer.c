@@ -36,6 +36,7 @@
 */
 #include <stdio.h>
 #include <stdlib.h>
+#include <time.h>
 
 /*
 ** Types and prototypes for this module
@@ -45,11 +46,11 @@
 
 /******************* Macro Definitions ***********************/
 
-#define CFE_PSP_TIMER_TICKS_PER_SECOND       1000000     /* Resolution of the least significant 32 bits of the 64 bit
+#define CFE_PSP_TIMER_TICKS_PER_SECOND       1000000000  /* Resolution of the least significant 32 bits of the 64 bit
                                                            time stamp returned by OS_BSPGet_Timebase in timer ticks per second.
                                                            The timer resolution for accuracy should not be any slower than 1000000
                                                            ticks per second or 1 us per tick */
-#define CFE_PSP_TIMER_LOW32_ROLLOVER         1000000     /* The number that the least significant 32 bits of the 64 bit
+#define CFE_PSP_TIMER_LOW32_ROLLOVER         1000000000  /* The number that the least significant 32 bits of the 64 bit
                                                            time stamp returned by OS_BSPGet_Timebase rolls over.  If the lower 32
                                                            bits rolls at 1 second, then the OS_BSP_TIMER_LOW32_ROLLOVER will be 1000000.
                                                            if the lower 32 bits rolls at its maximum value (2^32) then
@@ -143,6 +144,10 @@ uint32 CFE_PSP_GetTimerLow32Rollover(void)
 **    is in the BSP because it is sometimes implemented in hardware and
 **    sometimes taken care of by the RTOS.
 **
+**    Seconds and nanoseconds of the monotonic clock, which is read through
+**    the vDSO without a system call and does not step when the time of day
+**    is set.
+**
 **  Arguments:
 **
 **  Return:
@@ -150,11 +155,11 @@ uint32 CFE_PSP_GetTimerLow32Rollover(void)
 */
 void CFE_PSP_Get_Timebase(uint32 *Tbu, uint32* Tbl)
 {
-   OS_time_t        time;
+   struct timespec  now;
 
-   OS_GetLocalTime(&time);
-   *Tbu = time.seconds;
-   *Tbl = time.microsecs;
+   clock_gettime(CLOCK_MONOTONIC, &now);
+   *Tbu = now.tv_sec;
+   *Tbl = now.tv_nsec;
 }
 
 /******************************************************************************
@@ -73,6 +73,7 @@ typedef enum
     UT_CFE_SB_GENERATECHECKSUM_INDEX,
     UT_CFE_SB_VALIDATECHECKSUM_INDEX,
     UT_CFE_SB_CLEANUPAPP_INDEX,
+    UT_CFE_SB_RCVMSGBATCH_INDEX,
     UT_CFE_SB_MAX_INDEX
 } Ut_CFE_SB_INDEX_t;
 
@@ -111,6 +112,7 @@ typedef struct
     int32 (*CFE_SB_GenerateChecksum)(CFE_SB_MsgPtr_t MsgPtr);
     int32 (*CFE_SB_ValidateChecksum)(CFE_SB_MsgPtr_t MsgPtr);
     int32 (*CFE_SB_CleanUpApp)(uint32 AppId);
+    int32 (*CFE_SB_RcvMsgBatch)(CFE_SB_MsgPtr_t *BufPtrs, uint32 MaxCount, uint32 *CountPtr, CFE_SB_PipeId_t PipeId, int32 TimeOut);
 } Ut_CFE_SB_HookTable_t;
 
 typedef struct
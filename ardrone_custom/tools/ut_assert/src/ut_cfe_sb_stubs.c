@@ -116,6 +116,7 @@ void Ut_CFE_SB_SetFunctionHook(uint32 Index, void *FunPtr)
     else if (Index == UT_CFE_SB_GENERATECHECKSUM_INDEX)   { Ut_CFE_SB_HookTable.CFE_SB_GenerateChecksum = FunPtr; }
     else if (Index == UT_CFE_SB_VALIDATECHECKSUM_INDEX)   { Ut_CFE_SB_HookTable.CFE_SB_ValidateChecksum = FunPtr; }
     else if (Index == UT_CFE_SB_CLEANUPAPP_INDEX)         { Ut_CFE_SB_HookTable.CFE_SB_CleanUpApp = FunPtr; }
+    else if (Index == UT_CFE_SB_RCVMSGBATCH_INDEX)        { Ut_CFE_SB_HookTable.CFE_SB_RcvMsgBatch = FunPtr; }
     else
     {
         printf("Unsupported SB Index In SetFunctionHook Call %lu\n", Index);
@@ -289,6 +290,22 @@ int32 CFE_SB_RcvMsg (CFE_SB_MsgPtr_t *BufPtr, CFE_SB_PipeId_t PipeId,
     return CFE_SUCCESS;
 }
 
+int32 CFE_SB_RcvMsgBatch (CFE_SB_MsgPtr_t *BufPtrs, uint32 MaxCount, uint32 *CountPtr,
+                          CFE_SB_PipeId_t PipeId, int32 TimeOut)
+{
+    *CountPtr = 0;
+
+    /* Check for specified return */
+    if (Ut_CFE_SB_UseReturnCode(UT_CFE_SB_RCVMSGBATCH_INDEX))
+        return Ut_CFE_SB_ReturnCodeTable[UT_CFE_SB_RCVMSGBATCH_INDEX].Value;
+
+    /* Check for Function Hook */
+    if (Ut_CFE_SB_HookTable.CFE_SB_RcvMsgBatch)
+        return Ut_CFE_SB_HookTable.CFE_SB_RcvMsgBatch(BufPtrs,MaxCount,CountPtr,PipeId,TimeOut);
+    
+    return CFE_SUCCESS;
+}
+
 uint32  CFE_SB_GetLastSenderId(CFE_SB_SenderId_t **Ptr,CFE_SB_PipeId_t  PipeId)
 {
     /* Check for specified return */
@@ -621,6 +621,56 @@ int32  CFE_SB_RcvMsg(CFE_SB_MsgPtr_t  *BufPtr,
     }
 } /* end CFE_SB_RcvMsg */
 
+/******************************************************************************
+** Name:    CFE_SB_RcvMsgBatch
+**
+** Purpose: Simulates the API used to receive several messages from the
+**          software bus at once.
+**
+** Assumptions, External Events, and Notes:
+**          Returns one message per call, the next one in the test script, so
+**          a test script sees the same packets and return codes as it would
+**          through CFE_SB_RcvMsg.
+**
+** Routines Called:
+**          CFE_SB_RcvMsg
+**
+** Date Written:
+**          10/17/2026
+**
+** Input Arguments:
+**          BufPtrs
+**          MaxCount
+**          CountPtr
+**          PipeId
+**          timeOut - CFE_SB_PEND, CFE_SB_POLL or millisecond timeout
+**
+** Output Arguments:
+**          None
+**
+** Return Values:
+**          Status
+**
+******************************************************************************/
+int32  CFE_SB_RcvMsgBatch(CFE_SB_MsgPtr_t  *BufPtrs,
+                          uint32           MaxCount,
+                          uint32           *CountPtr,
+                          CFE_SB_PipeId_t  PipeId,
+                          int32            TimeOut)
+{
+    int32 Status;
+
+    *CountPtr = 0;
+
+    Status = CFE_SB_RcvMsg(&BufPtrs[0], PipeId, TimeOut);
+    if (Status == CFE_SUCCESS)
+    {
+        *CountPtr = 1;
+    }
+
+    return Status;
+} /* end CFE_SB_RcvMsgBatch */
+
 /******************************************************************************
 ** Name:    CFE_SB_GetLastSenderId
 **
@@ -17,6 +17,15 @@ cfe_ut_clean:: cfs_clean_build_mission_incs cfs_clean_build_platform_incs
 cfe_ut_run::
 	$(MAKE) -C cfe/unit-test gcov
 
+cfe_perf_build:: cfs_prebuild
+	$(MAKE) -C cfe/unit-test/perf
+
+cfe_perf_clean:: cfs_clean_build_mission_incs cfs_clean_build_platform_incs
+	$(MAKE) -C cfe/unit-test/perf clean
+
+cfe_perf_run::
+	$(MAKE) -C cfe/unit-test/perf run
+
 cfe_ut_build_es:: cfs_prebuild
 	$(MAKE) -C cfe/unit-test/es
 
@@ -206,6 +206,50 @@
 #define CFE_SB_MAX_PIPE_DEPTH           256
 
 
+/**
+**  \cfesbcfg Queue behind SB pipes
+**
+**  \par Description:
+**       Selects the kind of OS queue that backs the pipes made by #CFE_SB_CreatePipe.
+**       #CFE_SB_PIPE_QUEUE_OS is an OS message queue, which costs a system call to
+**       send and another to receive every message.  #CFE_SB_PIPE_QUEUE_RING is a
+**       queue in the cFE's own memory, which only calls on the OS to wake a pipe
+**       owner that is waiting for a message.  A pipe can choose for itself with
+**       #CFE_SB_CreatePipeEx.
+**
+**  \par Limits
+**       #CFE_SB_PIPE_QUEUE_OS or #CFE_SB_PIPE_QUEUE_RING.  An OSAL without an
+**       in-process queue uses its OS queue for both.
+*/
+#define CFE_SB_DEFAULT_PIPE_QUEUE       CFE_SB_PIPE_QUEUE_RING
+
+/**
+**  \cfesbcfg Maximum Messages in a Batch Receive
+**
+**  \par Description:
+**       The most messages one call to #CFE_SB_RcvMsgBatch can return.  Every pipe
+**       keeps room for this many buffer pointers, so the messages of a batch stay
+**       valid until the pipe owner's next receive.
+**
+**  \par Limits
+**       This parameter has a lower limit of 1 and an upper limit of 65535.
+*/
+#define CFE_SB_MAX_RCV_BATCH            32
+
+/**
+**  \cfesbcfg Depth of the SB Buffer Cache Depots
+**
+**  \par Description:
+**       The number of free message buffers of each size class the buffer cache
+**       shares between tasks, on top of the few each task keeps for itself.
+**       Buffers freed past this go back to the SB memory pool.
+**
+**  \par Limits
+**       This parameter must be a power of two between 2 and 4096.
+*/
+#define CFE_SB_BUF_CACHE_DEPTH          64
+
+
 /**
 **  \cfesbcfg Highest Valid Message Id
 **
@@ -1069,6 +1113,23 @@
 #define CFE_ES_PERF_DATA_BUFFER_SIZE           10000
 
 
+/**
+**  \cfeescfg Define Number of Performance Data Rings
+**
+**  \par Description:
+**       The performance data buffer is split into this many rings of equal size.
+**       A task adds its performance entries to the ring picked by its OSAL task
+**       id, moving on to the next ring if another task is adding to that one at
+**       the same moment.  The rings are merged in time order when the data is
+**       written to a file.
+**
+**  \par Limits
+**       There is a lower limit of 1 and an upper limit of 64 on this
+**       configuration paramater.
+*/
+#define CFE_ES_PERF_DATA_RINGS                 8
+
+
 /**
 **  \cfeescfg Define Filter Mask Setting for Disabling All Performance Entries
 **
@@ -1188,6 +1249,61 @@
 */
 #define CFE_ES_PERF_ENTRIES_BTWN_DLYS             50
 
+/**
+**  \cfeescfg Define Performance Analyzer Streaming Delay
+**
+**  \par Description:
+**       This parameter defines the delay time (in milliseconds) between the
+**       passes the Executive Services streaming child task makes over the
+**       performance data rings while collecting in streaming mode.  Each pass
+**       sends the entries added since the last one.  A ring holds
+**       #CFE_ES_PERF_DATA_BUFFER_SIZE / #CFE_ES_PERF_DATA_RINGS entries, and
+**       entries a task adds faster than that per pass are lost.
+**
+**  \par Limits
+**       There is a lower limit of 1 and an upper limit of 10000 on this
+**       configuration paramater.
+*/
+#define CFE_ES_PERF_STREAM_MS_DELAY               100
+
+/**
+**  \cfeescfg Define Performance Analyzer Streaming Packet Size
+**
+**  \par Description:
+**       This parameter defines the most performance data entries sent in one
+**       performance data stream packet.
+**
+**  \par Limits
+**       There is a lower limit of 1 on this configuration paramater.  The
+**       packet must fit in #CFE_SB_MAX_SB_MSG_SIZE, 12 bytes per entry.
+*/
+#define CFE_ES_PERF_STREAM_PKT_ENTRIES            64
+
+/**
+**  \cfeescfg Define Number of Performance Latency Slots
+**
+**  \par Description:
+**       This parameter defines how many performance markers have their entry
+**       to exit latency measured while collecting in streaming mode.  The
+**       latency of each is reported in Executive Services housekeeping.
+**
+**  \par Limits
+**       There is a lower limit of 1 and an upper limit of 16 on this
+**       configuration paramater.
+*/
+#define CFE_ES_PERF_LATENCY_SLOTS                 4
+
+/**
+**  \cfeescfg Define Default Performance Latency Markers
+**
+**  \par Description:
+**       Defines the performance markers measured by each latency slot at
+**       startup, one per slot.  #CFE_ES_PERF_NO_MARKER leaves a slot unused.
+**       The defaults are the ARDrone2 telemetry task loop (0x41) and the TO
+**       telemetry socket send (23).
+*/
+#define CFE_ES_PERF_LATENCY_MARKERS_INIT          { 0x41, 23, CFE_ES_PERF_NO_MARKER, CFE_ES_PERF_NO_MARKER }
+
 /**
 **  \cfeescfg Define Default Stack Size for an Application
 **
@@ -1556,16 +1672,33 @@
 **  \cfeevscfg Default EVS Message Format Mode
 **
 **  \par Description:
-**       Defines the default message format (long or short) for event messages being
-**       sent to the ground. Choose between #CFE_EVS_LONG_FORMAT or
-**       #CFE_EVS_SHORT_FORMAT.
+**       Defines the default message format (long, short or deferred) for event
+**       messages being sent to the ground. Choose between #CFE_EVS_LONG_FORMAT,
+**       #CFE_EVS_SHORT_FORMAT or #CFE_EVS_DEFERRED_FORMAT.
 **
 **  \par Limits
-**       The valid settings are #CFE_EVS_LONG_FORMAT or #CFE_EVS_SHORT_FORMAT
+**       The valid settings are #CFE_EVS_LONG_FORMAT, #CFE_EVS_SHORT_FORMAT or
+**       #CFE_EVS_DEFERRED_FORMAT
 */
 #define CFE_EVS_DEFAULT_MSG_FORMAT_MODE CFE_EVS_LONG_FORMAT
 
 
+/**
+**  \cfeevscfg Maximum Number of Deferred Format Strings
+**
+**  \par Description:
+**       In the deferred message format mode events carry a hash of their
+**       format string rather than the text.  EVS remembers this many format
+**       strings by hash so the event can be formatted when the text is needed,
+**       for the output ports or the event log file.  Events whose format
+**       string does not fit are sent as text.
+**
+**  \par Limits
+**       The value must be greater than zero and no greater than 65535.
+*/
+#define CFE_EVS_DEFERRED_SPEC_MAX     256
+
+
 
 /* Platform Configuration Parameters for Table Service (TBL) */
 
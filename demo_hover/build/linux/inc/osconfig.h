@@ -130,9 +130,22 @@
 
 /* 
 ** This define sets the queue implentation of the Linux port to use sockets 
-** commenting this out makes the Linux port use the POSIX message queues.
+** commenting this out makes the Linux port use the POSIX message queues,
+** as does building with OSAL_POSIX_MQUEUE defined.
 */
+#ifndef OSAL_POSIX_MQUEUE
 #define OSAL_SOCKET_QUEUE
+#endif
+
+/*
+** This define sets the timer implementation of the Linux port to run the timer
+** callbacks in one timer thread waiting on a timerfd, rather than in the handler
+** of a signal per timer.  Building with OSAL_POSIX_SIGNAL_TIMERS defined uses
+** the signals, which limits OS_MAX_TIMERS to the RT signals available.
+*/
+#ifndef OSAL_POSIX_SIGNAL_TIMERS
+#define OSAL_THREAD_TIMERS
+#endif
 
 /*
 ** Module loader/symbol table is optional
@@ -179,8 +192,15 @@
 ** for a timer object; in the case of the newer "posix-ng" and "rtems-ng" variants,
 ** the "timebase" allocates the OS resources and the timer does not use any additional
 ** OS resources. Therefore this limit can be higher.
+**
+** The timers of the Linux port with OSAL_THREAD_TIMERS use no OS resources of
+** their own either.
 */
+#ifdef OSAL_THREAD_TIMERS
+#define OS_MAX_TIMERS         256
+#else
 #define OS_MAX_TIMERS         5
+#endif
 
 /*
 ** This define sets the maximum number of open directories